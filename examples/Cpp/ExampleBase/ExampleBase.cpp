@@ -212,12 +212,15 @@ void ExampleBase::Run()
         // Update profiler (if debugging is enabled)
         if (debuggerObj_)
         {
+            LLGL::FrameProfile frameProfile;
+            profilerObj_->NextProfile(&frameProfile);
+
             if (showTimeRecords)
             {
                 std::cout << "\n";
                 std::cout << "FRAME TIME RECORDS:\n";
                 std::cout << "-------------------\n";
-                for (const auto& rec : profilerObj_->frameProfile.timeRecords)
+                for (const auto& rec : frameProfile.timeRecords)
                     std::cout << rec.annotation << ": " << rec.elapsedTime << " ns\n";
 
                 profilerObj_->timeRecordingEnabled = false;
@@ -228,7 +231,6 @@ void ExampleBase::Run()
                 profilerObj_->timeRecordingEnabled = true;
                 showTimeRecords = true;
             }
-            profilerObj_->NextProfile();
         }
 
         // Check to switch to fullscreen
@@ -71,8 +71,13 @@ struct BufferDescriptor
     /**
     \brief CPU read/write access flags. By default 0.
     \remarks If this is 0 the buffer cannot be mapped from GPU memory space into CPU memory space and vice versa.
+    \remarks If this is CPUAccessFlags::Read and \c bindFlags contains no other flags than BindFlags::CopySrc and BindFlags::CopyDst,
+    the buffer is a \e readback buffer that is allocated in host memory.
+    Copy commands into such a buffer (e.g. CommandBuffer::CopyBufferFromTexture) can be read with RenderSystem::MapBuffer without stalling the GPU,
+    once a fence that was submitted after the copy command has been signaled.
     \see CPUAccessFlags
     \see RenderSystem::MapBuffer
+    \see CommandQueue::QueryFence
     */
     long                            cpuAccessFlags  = 0;
 
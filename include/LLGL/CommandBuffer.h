@@ -381,7 +381,7 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         myCmdBuffer->SetResource(*myTexture,        2, LLGL::BindFlags::Sampled,        LLGL::StageFlags::FragmentStage);
         \endcode
         \remarks If direct resource binding is not supported by the render system, this function has no effect.
-        \note Only supported with: OpenGL, Direct3D 11, Metal.
+        \note Only supported with: OpenGL, Vulkan, Direct3D 11, Metal.
         \see RenderingFeatures::hasDirectResourceBinding
         \see SetResourceHeap
         */
@@ -405,7 +405,7 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \param[in] stageFlags Specifies which shader stages are affected.
         This can be a bitwise OR combination of the StageFlags entries. By default StageFlags::AllStages.
         \remarks If direct resource binding is not supported by the render system, this function has no effect.
-        \note Only supported with: OpenGL, Direct3D 11, Metal.
+        \note Only supported with: OpenGL, Vulkan, Direct3D 11, Metal.
         \see BindFlags
         \see StageFlags
         \see RenderingFeatures::hasDirectResourceBinding
@@ -596,6 +596,7 @@ class LLGL_EXPORT CommandBuffer : public RenderSystemChild
         \param[in] dataSize Specifies the size (in bytes) of the input buffer \c data. This must be a multiple of 4.
         \remarks This function must only be called after a graphics or compute pipeline has been set.
         The order of uniforms that come after the first one can be determined by the ShaderReflection::uniform container returned by ShaderProgram::Reflect.
+        \remarks For the Vulkan backend, \c location specifies the byte offset into the push constant range (128 bytes) that is shared by all shader stages.
         \note Only supported with: OpenGL, Vulkan, Direct3D 12.
         \see ShaderProgram::FindUniformLocation
         \see ShaderProgram::Reflect
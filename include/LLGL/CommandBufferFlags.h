@@ -9,7 +9,9 @@
 #define LLGL_COMMAND_BUFFER_FLAGS_H
 
 
+#include "Export.h"
 #include "ColorRGBA.h"
+#include <cstdint>
 
 
 namespace LLGL
@@ -93,6 +95,9 @@ struct CommandBufferFlags
         /**
         \brief Specifies that the encoded command buffer can be submitted multiple times.
         \remarks If this is not specified, the command buffer must be encoded again after it has been submitted to the command queue.
+        \remarks For the OpenGL backend, redundant state changes are removed from the recorded commands of such a command buffer in CommandBuffer::End.
+        Merging consecutive indexed draw commands without any state change in between into a single multi-draw command
+        is done for all command buffers of the OpenGL backend, regardless of this flag.
         \remakrs This cannot be used in combination with the \c ImmediateSubmit flag.
         \see CommandQueue::Submit(CommandBuffer&)
         */
@@ -297,6 +302,47 @@ struct CommandBufferDescriptor
     std::uint32_t   numNativeBuffers    = 2;
 };
 
+/**
+\brief Memory statistics of the chunk pool that is shared by all deferred command buffers.
+\remarks Deferred command buffers (such as the OpenGL command buffers that are not created with CommandBufferFlags::ImmediateSubmit)
+record their commands into memory chunks that are recycled through a process-wide pool.
+Once all threads have reached a steady state of recording, \c numHeapAllocations should no longer increase.
+\see GetCommandBufferMemoryStatistics
+*/
+struct CommandBufferMemoryStatistics
+{
+    //! Total number of memory chunks that have been allocated from the heap.
+    std::uint64_t numHeapAllocations   = 0;
+
+    //! Total number of memory chunks that have been returned to the heap.
+    std::uint64_t numHeapDeallocations = 0;
+
+    //! Total number of memory chunks that have been recycled from the pool instead of being allocated from the heap.
+    std::uint64_t numPoolAllocations   = 0;
+
+    //! Number of bytes that are currently allocated from the heap, i.e. the sum of \c usedMemory and the memory held by the pool.
+    std::uint64_t reservedMemory       = 0;
+
+    //! Number of bytes that are currently used by deferred command buffers.
+    std::uint64_t usedMemory           = 0;
+};
+
+
+/* ----- Functions ----- */
+
+/**
+\brief Returns the memory statistics of the chunk pool that is shared by all deferred command buffers.
+\remarks The statistics are process-wide and updated concurrently, so the individual members are not necessarily consistent with each other.
+*/
+LLGL_EXPORT CommandBufferMemoryStatistics GetCommandBufferMemoryStatistics();
+
+/**
+\brief Returns all unused memory chunks of the shared command buffer pool to the heap.
+\remarks Only the chunks that are not cached by other threads are released.
+The chunks cached by the calling thread are released as well.
+*/
+LLGL_EXPORT void TrimCommandBufferMemoryPool();
+
 
 } // /namespace LLGL
 
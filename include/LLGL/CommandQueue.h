@@ -111,6 +111,35 @@ class LLGL_EXPORT CommandQueue : public RenderSystemChild
         */
         virtual bool WaitFence(Fence& fence, std::uint64_t timeout) = 0;
 
+        /**
+        \brief Returns true if the specified fence has been signaled, without blocking the CPU execution.
+        \param[in] fence Specifies the fence whose status is to be queried.
+        \return True if the fence has been signaled, or false if the GPU has not reached the fence yet or the fence has never been submitted.
+        \remarks This is equivalent to calling \c WaitFence with a timeout of zero.
+        It can be used to poll for the completion of asynchronous readbacks once per frame, e.g. after a texture has been copied into a readback buffer:
+        \code
+        // Record copy into readback buffer and submit fence right after the command buffer
+        myCmdBuffer->CopyBufferFromTexture(*myReadbackBuffer, 0, *myTexture, myRegion);
+        myCmdBuffer->End();
+        myCmdQueue->Submit(*myCmdBuffer);
+        myCmdQueue->Submit(*myReadbackFence);
+
+        // One or more frames later: map readback buffer only when the fence has been signaled
+        if (myCmdQueue->QueryFence(*myReadbackFence))
+        {
+            auto data = myRenderer->MapBuffer(*myReadbackBuffer, LLGL::CPUAccess::ReadOnly);
+            // Process data ...
+            myRenderer->UnmapBuffer(*myReadbackBuffer);
+        }
+        \endcode
+        \note For OpenGL, this function blocks until the command queue is idle if fences are not supported (i.e. \c GL_ARB_sync is not available).
+        \note For Direct3D 11, this function does not flush the command queue, so the fence is only signaled after the submitted commands have been flushed,
+        e.g. by presenting the swap-chain.
+        \see WaitFence
+        \see BufferDescriptor::cpuAccessFlags
+        */
+        bool QueryFence(Fence& fence);
+
         /**
         \brief Blocks the CPU execution until the entire GPU command queue has been completed.
         \remarks To wait for a specific point in the command queue, use fences.
@@ -81,6 +81,12 @@ class LLGL_EXPORT Image
         */
         void Convert(const ImageFormat format, const DataType dataType, std::size_t threadCount = 0);
 
+        /**
+        \brief Converts the image format and data type by distributing the work over the specified thread pool.
+        \see ConvertImageBuffer(const SrcImageDescriptor&, ImageFormat, DataType, ThreadPool&)
+        */
+        void Convert(const ImageFormat format, const DataType dataType, ThreadPool& threadPool);
+
         /**
         \brief Resizes the image and resets the image buffer.
         \param[in] extent Specifies the new image size.
@@ -108,12 +114,28 @@ class LLGL_EXPORT Image
         /**
         \brief Resizes the image and resamples the pixels from the previous image buffer.
         \param[in] extent Specifies the new image size.
-        \param[in] filter Specifies the sampling filter.
-        \brief GenerateImageBuffer
-        \todo Not implemented yet.
+        \param[in] filter Specifies the sampling filter. SamplerFilter::Linear is mapped to ResampleFilter::Linear and SamplerFilter::Nearest to ResampleFilter::Nearest.
+        \see Resize(const Extent3D&, const ResampleFilter, std::size_t)
         */
         void Resize(const Extent3D& extent, const SamplerFilter filter);
 
+        /**
+        \brief Resizes the image and resamples the pixels from the previous image buffer.
+        \param[in] extent Specifies the new image size. If any of its components is zero, the image buffer is released.
+        \param[in] filter Specifies the resampling filter.
+        \param[in] threadCount Specifies the number of threads to use for resampling (see ConvertImageBuffer for more details). By default 0.
+        \throw std::invalid_argument If the image has a compressed format, or a depth-stencil format with a filter other than ResampleFilter::Nearest.
+        \see ResampleImageBuffer
+        */
+        void Resize(const Extent3D& extent, const ResampleFilter filter, std::size_t threadCount = 0);
+
+        /**
+        \brief Resizes the image and resamples the pixels from the previous image buffer by distributing the work over the specified thread pool.
+        \see Resize(const Extent3D&, const ResampleFilter, std::size_t)
+        \see ResampleImageBuffer(const SrcImageDescriptor&, const Extent3D&, const DstImageDescriptor&, const Extent3D&, ResampleFilter, ThreadPool&)
+        */
+        void Resize(const Extent3D& extent, const ResampleFilter filter, ThreadPool& threadPool);
+
         //! Swaps all attributes with the specified image.
         void Swap(Image& rhs);
 
@@ -178,6 +200,13 @@ class LLGL_EXPORT Image
         */
         void ReadPixels(const Offset3D& offset, const Extent3D& extent, const DstImageDescriptor& imageDesc, std::size_t threadCount = 0) const;
 
+        /**
+        \brief Reads a region of pixels from this image into the destination image buffer specified by 'imageDesc'.
+        \remarks Same as the other overload, but if the data needs to be converted, the work is distributed over the specified thread pool.
+        \see ReadPixels(const Offset3D&, const Extent3D&, const DstImageDescriptor&, std::size_t) const
+        */
+        void ReadPixels(const Offset3D& offset, const Extent3D& extent, const DstImageDescriptor& imageDesc, ThreadPool& threadPool) const;
+
         /**
         \brief Writes a region of pixels to this image from the source image buffer specified by 'imageDesc'.
         \param[in] offset Specifies the region offset within this image to write to.
@@ -190,6 +219,32 @@ class LLGL_EXPORT Image
         */
         void WritePixels(const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc, std::size_t threadCount = 0);
 
+        /**
+        \brief Writes a region of pixels to this image from the source image buffer specified by 'imageDesc'.
+        \remarks Same as the other overload, but if the data needs to be converted, the work is distributed over the specified thread pool.
+        \see WritePixels(const Offset3D&, const Extent3D&, const SrcImageDescriptor&, std::size_t)
+        */
+        void WritePixels(const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc, ThreadPool& threadPool);
+
+        /**
+        \brief Generates the MIP-map chain of this image and returns it in a new image buffer.
+        \param[in] mipGenDesc Specifies the MIP-map generation descriptor. Use the \c sRGB member for images in sRGB color space.
+        \param[in] threadCount Specifies the number of threads to use (see ConvertImageBuffer for more details). By default 0.
+        \return New image buffer with all MIP-map levels, beginning with a copy of this image, or null if this image is empty.
+        The size of this buffer is determined by GetMipChainSize.
+        \remarks This image is not modified. The returned buffer has the same format and data type as this image.
+        \throw std::invalid_argument If the image has a compressed format, or a depth-stencil format with a filter other than ResampleFilter::Nearest.
+        \see GenerateMipChain
+        \see GetMipChainSize
+        */
+        ByteBuffer GenerateMips(const MipGenerationDescriptor& mipGenDesc = {}, std::size_t threadCount = 0) const;
+
+        /**
+        \brief Generates the MIP-map chain of this image by distributing the work over the specified thread pool.
+        \see GenerateMips(const MipGenerationDescriptor&, std::size_t) const
+        */
+        ByteBuffer GenerateMips(const MipGenerationDescriptor& mipGenDesc, ThreadPool& threadPool) const;
+
         /**
         \brief Mirrors the image at the YZ plane.
         \todo Not implemented yet
@@ -290,6 +345,11 @@ class LLGL_EXPORT Image
 
         void ClampRegion(Offset3D& offset, Extent3D& extent) const;
 
+        void ReadPixelsWithThreadPool(const Offset3D& offset, const Extent3D& extent, const DstImageDescriptor& imageDesc, ThreadPool* threadPool, std::size_t threadCount) const;
+        void WritePixelsWithThreadPool(const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc, ThreadPool* threadPool, std::size_t threadCount);
+        void ResizeWithThreadPool(const Extent3D& extent, const ResampleFilter filter, ThreadPool* threadPool, std::size_t threadCount);
+        ByteBuffer GenerateMipsWithThreadPool(const MipGenerationDescriptor& mipGenDesc, ThreadPool* threadPool, std::size_t threadCount) const;
+
     private:
 
         Extent3D    extent_;
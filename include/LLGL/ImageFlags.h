@@ -15,6 +15,7 @@
 #include "RenderSystemFlags.h"
 #include "TextureFlags.h"
 #include "ColorRGBA.h"
+#include "ThreadPool.h"
 #include <memory>
 #include <cstdint>
 
@@ -35,6 +36,42 @@ Therefore, the byte buffer type is an std::unique_ptr<char[]>.
 using ByteBuffer = std::unique_ptr<char[]>;
 
 
+/* ----- Enumerations ----- */
+
+/**
+\brief Image resampling filter enumeration.
+\remarks For minification, all filters except ResampleFilter::Nearest are widened by the scaling factor, so that every source pixel contributes to the result.
+\see ResampleImageBuffer
+\see Image::Resize(const Extent3D&, const ResampleFilter, std::size_t)
+*/
+enum class ResampleFilter
+{
+    Nearest,    //!< Nearest neighbor sampling. This is the only filter that supports depth-stencil images.
+    Linear,     //!< Linear interpolation for magnification and a triangle filter for minification.
+    Box,        //!< Box filter that averages all source pixels covered by a destination pixel. Well suited for minification by integral factors.
+    Lanczos,    //!< Lanczos filter with a radius of 3 pixels. Highest quality for minification, but the slowest filter and it may cause slight ringing at sharp edges.
+};
+
+/**
+\brief Quality enumeration for encoding images into block compressed formats.
+\see CompressImageBuffer
+*/
+enum class BlockCompressionQuality
+{
+    /**
+    \brief Fast encoding with endpoints along the principal axis of each block.
+    \remarks BC7 blocks are only encoded with a single subset in this mode.
+    */
+    Fast,
+
+    /**
+    \brief High quality encoding with iteratively refined endpoints.
+    \remarks BC7 blocks are additionally encoded with the most promising two-subset partitions. This is considerably slower than the fast mode.
+    */
+    High,
+};
+
+
 /* ----- Structures ----- */
 
 /**
@@ -107,6 +144,39 @@ struct DstImageDescriptor
     std::size_t dataSize    = 0;
 };
 
+/**
+\brief Descriptor structure for the generation of a MIP-map chain on the CPU.
+\see GenerateMipChain
+\see Image::GenerateMips
+*/
+struct MipGenerationDescriptor
+{
+    /**
+    \brief Specifies the texture type that determines which image dimensions are reduced for each MIP-map level. By default TextureType::Texture2D.
+    \remarks For array textures, the dimension after the last texture dimension specifies the array layers, which are not reduced,
+    e.g. the image height for TextureType::Texture1DArray and the image depth for TextureType::Texture2DArray and cube textures.
+    Multi-sampled texture types are not allowed.
+    */
+    TextureType     type            = TextureType::Texture2D;
+
+    /**
+    \brief Specifies the number of MIP-map levels including the base level. By default 0.
+    \remarks If this is zero or greater than the number of levels of the full MIP-map chain, the full MIP-map chain is generated.
+    */
+    std::uint32_t   numMipLevels    = 0;
+
+    //! Specifies the filter to reduce each MIP-map level from the previous one. By default ResampleFilter::Box.
+    ResampleFilter  filter          = ResampleFilter::Box;
+
+    /**
+    \brief Specifies whether the color components are in non-linear sRGB color space. By default false.
+    \remarks If this is true, all color components except alpha are converted into linear color space before filtering
+    and back into sRGB color space afterwards, so the MIP-map levels do not become darker than the base level.
+    This should be enabled for images that are uploaded to textures with a \c _sRGB format, e.g. Format::RGBA8UNorm_sRGB.
+    */
+    bool            sRGB            = false;
+};
+
 
 /* ----- Functions ----- */
 
@@ -123,8 +193,10 @@ struct DstImageDescriptor
 \param[in] threadCount Specifies the number of threads to use for conversion.
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+The worker threads are taken from an internal thread pool that persists across all calls.
 \return True if any conversion was necessary. Otherwise, no conversion was necessary and the destination buffer is not modified!
 \note Compressed images and depth-stencil images cannot be converted.
+Compressed images can only be converted with the overload that also specifies the image extent.
 \throw std::invalid_argument If a compressed image format is specified either as source or destination.
 \throw std::invalid_argument If a depth-stencil format is specified either as source or destination.
 \throw std::invalid_argument If the source buffer size is not a multiple of the source data type size times the image format size.
@@ -141,6 +213,21 @@ LLGL_EXPORT bool ConvertImageBuffer(
     std::size_t                 threadCount = 0
 );
 
+/**
+\brief Converts the image format and data type of the source image (only uncompressed color formats) by distributing the work over the specified thread pool.
+\param[in] srcImageDesc Specifies the source image descriptor.
+\param[out] dstImageDesc Specifies the destination image descriptor.
+\param[in] threadPool Specifies the thread pool whose worker threads are used for conversion. This can also be a custom implementation of the ThreadPool interface.
+\remarks The other overload of this function with a thread count uses an internal thread pool that is shared across all calls.
+\see ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, std::size_t)
+\see ThreadPool::Create
+*/
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    ThreadPool&                 threadPool
+);
+
 /**
 \brief Converst the image format and data type of the source image (only uncompressed color formats) and returns the new generated image buffer.
 \param[in] srcImageDesc Specifies the source image descriptor.
@@ -149,9 +236,11 @@ LLGL_EXPORT bool ConvertImageBuffer(
 \param[in] threadCount Specifies the number of threads to use for conversion.
 If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
 the maximal count of threads the system supports will be used (e.g. 4 on a quad-core processor). By default 0.
+The worker threads are taken from an internal thread pool that persists across all calls.
 \return Byte buffer with the converted image data or null if no conversion is necessary.
 This can be casted to the respective target data type (e.g. <code>unsigned char</code>, <code>int</code>, <code>float</code> etc.).
 \note Compressed images and depth-stencil images cannot be converted.
+Compressed images can only be converted with the overload that also specifies the image extent.
 \throw std::invalid_argument If a compressed image format is specified either as source or destination.
 \throw std::invalid_argument If a depth-stencil format is specified either as source or destination.
 \throw std::invalid_argument If the source buffer size is not a multiple of the source data type size times the image format size.
@@ -168,6 +257,208 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     std::size_t                 threadCount = 0
 );
 
+/**
+\brief Converts the image format and data type of the source image (only uncompressed color formats) by distributing the work over the specified thread pool
+and returns the new generated image buffer.
+\param[in] srcImageDesc Specifies the source image descriptor.
+\param[in] dstFormat Specifies the destination image format.
+\param[in] dstDataType Specifies the destination image data type.
+\param[in] threadPool Specifies the thread pool whose worker threads are used for conversion. This can also be a custom implementation of the ThreadPool interface.
+\return Byte buffer with the converted image data or null if no conversion is necessary.
+\see ConvertImageBuffer(const SrcImageDescriptor&, ImageFormat, DataType, std::size_t)
+\see ThreadPool::Create
+*/
+LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    ThreadPool&                 threadPool
+);
+
+/**
+\brief Returns the size (in bytes) of an image buffer with the specified format, data type, and extent.
+\remarks For compressed image formats, this is the size of all 4x4 blocks that cover the extent (where partial blocks are rounded up),
+and the data type only specifies whether the components are unsigned (DataType::UInt8) or signed (DataType::Int8).
+\see GetMemoryFootprint(const ImageFormat, const DataType, std::uint32_t)
+*/
+LLGL_EXPORT std::size_t GetImageBufferSize(ImageFormat format, DataType dataType, const Extent3D& extent);
+
+/**
+\brief Converts the image format and data type of the source image with the specified extent, including block compressed formats.
+\param[in] srcImageDesc Specifies the source image descriptor.
+\param[out] dstImageDesc Specifies the destination image descriptor.
+\param[in] extent Specifies the image extent. For compressed formats, the depth specifies the number of slices of 4x4 blocks.
+\param[in] threadCount Specifies the number of threads to use for conversion (see ConvertImageBuffer for more details). By default 0.
+\return True if any conversion was necessary. Otherwise, no conversion was necessary and the destination buffer is not modified!
+\remarks Compressed images (ImageFormat::BC1 to ImageFormat::BC7) are decoded into ImageFormat::RGBA, except for ImageFormat::BC4 and ImageFormat::BC5,
+which are decoded into ImageFormat::R and ImageFormat::RG respectively, before they are converted into the destination format.
+Images are encoded into compressed formats with BlockCompressionQuality::Fast; use CompressImageBuffer to specify the quality.
+The data type of a compressed image must be DataType::UInt8, or DataType::Int8 for the signed variants of BC4 and BC5.
+Uncompressed images are converted the same way as with the other overloads of this function.
+\throw std::invalid_argument If a depth-stencil format is specified either as source or destination.
+\throw std::invalid_argument If a compressed image format is specified with an invalid data type.
+\throw std::invalid_argument If the source or destination buffer size is too small for the specified extent (see GetImageBufferSize).
+\throw std::invalid_argument If the source or destination buffer is a null pointer.
+\see GetImageBufferSize
+*/
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    std::size_t                 threadCount = 0
+);
+
+/**
+\brief Converts the image format and data type of the source image with the specified extent, including block compressed formats, by distributing the work over the specified thread pool.
+\param[in] threadPool Specifies the thread pool whose worker threads are used for conversion. This can also be a custom implementation of the ThreadPool interface.
+\see ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, const Extent3D&, std::size_t)
+\see ThreadPool::Create
+*/
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    ThreadPool&                 threadPool
+);
+
+/**
+\brief Encodes the source image into the block compressed format of the destination image.
+\param[in] srcImageDesc Specifies the source image descriptor. This can be any color format, including another compressed format.
+\param[in] extent Specifies the image extent. Partial 4x4 blocks at the right and bottom border are padded by replicating the edge pixels.
+\param[out] dstImageDesc Specifies the destination image descriptor. This must have a compressed image format.
+\param[in] quality Specifies the encoding quality.
+\param[in] threadCount Specifies the number of threads to use (see ConvertImageBuffer for more details). By default 0.
+\remarks The source image is first converted into the image format and data type the compressed format is decoded into
+(see ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, const Extent3D&, std::size_t)).
+The rows of 4x4 blocks are distributed over the worker threads.
+\throw std::invalid_argument If the destination image format is not a compressed format.
+\throw std::invalid_argument Under the same conditions as ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, const Extent3D&, std::size_t).
+\see BlockCompressionQuality
+*/
+LLGL_EXPORT void CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    const DstImageDescriptor&   dstImageDesc,
+    BlockCompressionQuality     quality,
+    std::size_t                 threadCount = 0
+);
+
+/**
+\brief Encodes the source image into the block compressed format of the destination image by distributing the work over the specified thread pool.
+\param[in] threadPool Specifies the thread pool whose worker threads are used for encoding. This can also be a custom implementation of the ThreadPool interface.
+\see CompressImageBuffer(const SrcImageDescriptor&, const Extent3D&, const DstImageDescriptor&, BlockCompressionQuality, std::size_t)
+\see ThreadPool::Create
+*/
+LLGL_EXPORT void CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    const DstImageDescriptor&   dstImageDesc,
+    BlockCompressionQuality     quality,
+    ThreadPool&                 threadPool
+);
+
+/**
+\brief Resamples the source image into the destination image with a different extent.
+\param[in] srcImageDesc Specifies the source image descriptor.
+\param[in] srcExtent Specifies the extent of the source image.
+\param[out] dstImageDesc Specifies the destination image descriptor. This must have the same format and data type as the source image.
+\param[in] dstExtent Specifies the extent of the destination image.
+\param[in] filter Specifies the resampling filter.
+\param[in] threadCount Specifies the number of threads to use for resampling (see ConvertImageBuffer for more details). By default 0.
+\remarks The image is resampled with separable filter passes along the X, Y, and Z axes; axes whose size does not change are skipped.
+All filters except ResampleFilter::Nearest operate on 32-bit floating-point values, where integral data types are normalized to the range [0, 1].
+The filtered values of integral data types are clamped and rounded to the nearest integer.
+Hence, 32-bit integral and 64-bit floating-point data types are filtered with the precision of 32-bit floating-point values.
+Pixels outside the source image are clamped to the edge.
+\throw std::invalid_argument If a compressed image format is specified.
+\throw std::invalid_argument If source and destination image descriptors do not have the same format and data type.
+\throw std::invalid_argument If a depth-stencil image is resampled with a filter other than ResampleFilter::Nearest.
+\throw std::invalid_argument If the source or destination buffer size is too small for the respective image extent.
+\throw std::invalid_argument If the source or destination buffer is a null pointer.
+\see ResampleFilter
+*/
+LLGL_EXPORT void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResampleFilter              filter,
+    std::size_t                 threadCount = 0
+);
+
+/**
+\brief Resamples the source image into the destination image with a different extent by distributing the work over the specified thread pool.
+\param[in] threadPool Specifies the thread pool whose worker threads are used for resampling. This can also be a custom implementation of the ThreadPool interface.
+\see ResampleImageBuffer(const SrcImageDescriptor&, const Extent3D&, const DstImageDescriptor&, const Extent3D&, ResampleFilter, std::size_t)
+\see ThreadPool::Create
+*/
+LLGL_EXPORT void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResampleFilter              filter,
+    ThreadPool&                 threadPool
+);
+
+/**
+\brief Returns the size (in bytes) of the entire MIP-map chain that is generated by GenerateMipChain for the specified image attributes.
+\param[in] format Specifies the image format.
+\param[in] dataType Specifies the image data type.
+\param[in] extent Specifies the extent of the base MIP-map level including array layers.
+\param[in] mipGenDesc Specifies the texture type and number of MIP-map levels.
+\return Sum of the sizes of all MIP-map levels, or zero if the format is compressed or the texture type is multi-sampled.
+\see GenerateMipChain
+*/
+LLGL_EXPORT std::size_t GetMipChainSize(
+    ImageFormat                     format,
+    DataType                        dataType,
+    const Extent3D&                 extent,
+    const MipGenerationDescriptor&  mipGenDesc
+);
+
+/**
+\brief Generates the MIP-map chain of the source image on the CPU.
+\param[in] srcImageDesc Specifies the source image descriptor of the base MIP-map level.
+\param[in] extent Specifies the extent of the base MIP-map level including array layers.
+\param[out] dstImageDesc Specifies the destination image descriptor for the entire MIP-map chain. This must have the same format and data type as the source image,
+and its size must be at least the value returned by GetMipChainSize.
+\param[in] mipGenDesc Specifies the MIP-map generation descriptor.
+\param[in] threadCount Specifies the number of threads to use (see ConvertImageBuffer for more details). By default 0.
+\remarks All MIP-map levels are tightly packed into the destination buffer, beginning with a copy of the base level.
+Each level directly follows the previous one and consists of all its array layers, i.e. the rows, layers, and size of each level
+correspond to the row stride, layer stride, and data size that are determined for that level by the render systems when a texture is uploaded.
+Each MIP-map level is resampled from the previous one, where all rows and array layers of a level are distributed over the worker threads.
+\throw std::invalid_argument If a compressed image format or a multi-sampled texture type is specified.
+\throw std::invalid_argument If source and destination image descriptors do not have the same format and data type.
+\throw std::invalid_argument If a depth-stencil image is specified with a filter other than ResampleFilter::Nearest.
+\throw std::invalid_argument If the source or destination buffer size is too small.
+\throw std::invalid_argument If the source or destination buffer is a null pointer.
+\see GetMipChainSize
+\see MipGenerationDescriptor
+*/
+LLGL_EXPORT void GenerateMipChain(
+    const SrcImageDescriptor&       srcImageDesc,
+    const Extent3D&                 extent,
+    const DstImageDescriptor&       dstImageDesc,
+    const MipGenerationDescriptor&  mipGenDesc,
+    std::size_t                     threadCount = 0
+);
+
+/**
+\brief Generates the MIP-map chain of the source image on the CPU by distributing the work over the specified thread pool.
+\param[in] threadPool Specifies the thread pool whose worker threads are used. This can also be a custom implementation of the ThreadPool interface.
+\see GenerateMipChain(const SrcImageDescriptor&, const Extent3D&, const DstImageDescriptor&, const MipGenerationDescriptor&, std::size_t)
+\see ThreadPool::Create
+*/
+LLGL_EXPORT void GenerateMipChain(
+    const SrcImageDescriptor&       srcImageDesc,
+    const Extent3D&                 extent,
+    const DstImageDescriptor&       dstImageDesc,
+    const MipGenerationDescriptor&  mipGenDesc,
+    ThreadPool&                     threadPool
+);
+
 /**
 \brief Copies an image buffer region from the source buffer to the destination buffer.
 \param[out] dstImageDesc Specifies the destination image descriptor.
@@ -35,6 +35,7 @@ struct InterfaceID
         Window_EventListener,   //!< Extends Interface. \see Window::EventListener
         Input,                  //!< Extends Interface. \see Input
         Timer,                  //!< Extends Interface. \see Timer
+        ThreadPool,             //!< Extends Interface. \see ThreadPool
         RenderSystem,           //!< Extends Interface. \see RenderSystem
         RenderSystemChild,      //!< Extends Interface. \see RenderSystemChild
         Buffer,                 //!< Extends RenderSystemChild. \see Buffer
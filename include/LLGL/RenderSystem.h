@@ -414,6 +414,26 @@ class LLGL_EXPORT RenderSystem : public Interface
         */
         virtual ShaderProgram* CreateShaderProgram(const ShaderProgramDescriptor& desc) = 0;
 
+        /**
+        \brief Creates one shader for each macro permutation of the same shader source.
+        \param[in] desc Specifies the shader source and the macro definitions of all permutations.
+        \return List of shaders in the same order as the permutations in ShaderPermutationDescriptor::permutations.
+        \remarks Each permutation is preprocessed into a canonical list of macro definitions first: Macros are sorted by name,
+        redefinitions replace earlier definitions, and macros whose names do not appear anywhere in the shader source are removed
+        (unless the source contains \c include directives). Permutations with identical macro definitions are compiled only once,
+        so the returned list may contain the same Shader object multiple times and each distinct object must be released only once.
+        The unique variants are passed to CreateShader in the order of their first occurrence.
+        For OpenGL, the variants are compiled concurrently by the driver if \c GL_ARB_parallel_shader_compile is supported,
+        since each shader starts compiling when it is created and its compile status is only queried by Shader::HasErrors, Shader::GetReport, or when it is linked.
+        \note The Direct3D 11 and Direct3D 12 backends compile the variants one after another on the calling thread, including the \c D3DCompile step.
+        Distributing the compilation over the worker threads (see ShaderPermutationDescriptor::threadCount) is not supported by any backend;
+        to compile HLSL permutations in parallel, compile them offline and create the shaders from byte code.
+        \throws std::invalid_argument If the source type of ShaderPermutationDescriptor::shaderDesc does not refer to source code.
+        \see ShaderPermutationDescriptor
+        \see CreateShader
+        */
+        std::vector<Shader*> CreateShaderPermutations(const ShaderPermutationDescriptor& desc);
+
         //! Releases the specified Shader object. After this call, the specified object must no longer be used.
         virtual void Release(Shader& shader) = 0;
 
@@ -470,6 +490,14 @@ class LLGL_EXPORT RenderSystem : public Interface
             );
         }
         \endcode
+        \remarks For the Vulkan renderer, the serialized cache only contains the device-wide pipeline cache, because a Vulkan pipeline cannot be restored without its descriptor.
+        In that case, this function merges the cache into the pipeline cache of the render system and returns null.
+        Subsequent PSOs with the same descriptors are then created from the cache. Caches from a different device or driver version are ignored.
+        \remarks For the OpenGL renderer, the serialized cache contains the native binary of the shader program (if \c GL_ARB_get_program_binary is supported).
+        This function stores that binary in the render system and returns null. Subsequently created shader programs with the same shaders are then loaded from the binary instead of being linked.
+        If the driver rejects the binary, the shader program is linked from its shaders as usual.
+        \remarks If the debug layer is enabled, the serialized cache is passed to the renderer as described above, but this function always returns null,
+        because the debug layer cannot validate a pipeline state without its descriptor.
         \see CreatePipelineState(const GraphicsPipelineDescriptor&, std::unique_ptr<Blob>*)
         \see CreatePipelineState(const ComputePipelineDescriptor&, std::unique_ptr<Blob>*)
         */
@@ -225,6 +225,7 @@ struct RendererID
     static const int Direct3D12 = 0x00000008; //!< ID number for a Direct3D 12 renderer.
     static const int Vulkan     = 0x00000009; //!< ID number for a Vulkan renderer.
     static const int Metal      = 0x0000000a; //!< ID number for a Metal renderer.
+    static const int Null       = 0x0000000b; //!< ID number for the headless Null renderer, which does not communicate with any GPU.
 
     static const int Reserved   = 0x000000ff; //!< Highest ID number for reserved future renderers. Value is 0x000000ff.
 };
@@ -98,6 +98,14 @@ struct RendererConfigurationVulkan
     \todo Remove this as soon as Vulkan memory manage has been improved.
     */
     bool                        reduceDeviceMemoryFragmentation = false;
+
+    /**
+    \brief Size (in bytes) of the staging ring buffer for resource uploads. By default 16*1024*1024, i.e. 16 MB of host-visible memory.
+    \remarks Buffer and texture uploads are recorded into a shared transfer command buffer and their data is copied into this ring buffer.
+    The uploads are submitted as a single batch with the next command buffer submission or whenever the ring buffer is full.
+    Uploads that are larger than this ring buffer use a temporary staging buffer.
+    */
+    std::uint64_t               stagingBufferSize               = 16*1024*1024;
 };
 
 /**
@@ -11,6 +11,7 @@
 
 #include "Export.h"
 #include <map>
+#include <memory>
 #include <string>
 
 
@@ -18,6 +19,9 @@ namespace LLGL
 {
 
 
+class CaptureWriter;
+class CaptureObjectSource;
+
 //! Rendering debugger error types enumeration.
 enum class ErrorType
 {
@@ -46,7 +50,11 @@ class LLGL_EXPORT RenderingDebugger
 
     public:
 
-        virtual ~RenderingDebugger() = default;
+        RenderingDebugger();
+        virtual ~RenderingDebugger();
+
+        RenderingDebugger(const RenderingDebugger&) = delete;
+        RenderingDebugger& operator = (const RenderingDebugger&) = delete;
 
         /**
         \brief Sets the new source function name.
@@ -76,6 +84,30 @@ class LLGL_EXPORT RenderingDebugger
         */
         void PostWarning(const WarningType type, const std::string& message);
 
+        /**
+        \brief Starts a capture that serializes resource creation, uploads, and command streams into a compact binary file.
+        \param[in] filename Specifies the output filename. The capture can be re-executed with the \c LLGLReplay tool against any render system.
+        \return True if the capture file could be opened. A previous capture is ended in any case.
+        \remarks Calls are only captured by the debug layer, i.e. this debugger must be passed to RenderSystem::Load.
+        Swap-chains, command buffers, buffers, textures, render targets, shaders, pipelines, and resource heaps that are alive when the capture begins
+        are written at the beginning of the capture, but without the content of buffers and textures.
+        Samplers, render passes, and query heaps that were created before the capture began cannot be referenced by it,
+        so a complete capture must begin before the render system is loaded.
+        \remarks Queries, render conditions, stream-outputs, copies between textures and buffers, read-backs, and API dependent states are not captured.
+        \see EndCapture
+        */
+        bool BeginCapture(const char* filename);
+
+        /**
+        \brief Ends the current capture and closes its file.
+        \remarks This must not be called while the render system is used by another thread.
+        \see BeginCapture
+        */
+        void EndCapture();
+
+        //! Returns true if a capture is currently running.
+        bool IsCaptureEnabled() const;
+
     protected:
 
         /**
@@ -181,12 +213,19 @@ class LLGL_EXPORT RenderingDebugger
         */
         virtual void OnWarning(WarningType type, Message& message);
 
+    private:
+
+        // Grants the debug layer access to the capture state.
+        friend struct DbgCaptureAccess;
+
     private:
 
         std::map<std::string, Message>  errors_;
         std::map<std::string, Message>  warnings_;
         const char*                     source_     = "";
         const char*                     groupName_  = "";
+        std::unique_ptr<CaptureWriter>  captureWriter_;
+        CaptureObjectSource*            captureObjectSource_    = nullptr;
 
 };
 
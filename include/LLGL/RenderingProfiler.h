@@ -13,6 +13,9 @@
 #include "SwapChainFlags.h"
 #include "PipelineStateFlags.h"
 #include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
 #include <string.h>
 
 
@@ -20,6 +23,8 @@ namespace LLGL
 {
 
 
+class ProfilerTraceWriter;
+
 /**
 \brief Structure with annotation and elapsed time for a timer profile.
 \see FrameProfile::timeRecords
@@ -33,6 +38,46 @@ struct ProfileTimeRecord
     std::uint64_t   elapsedTime = 0;
 };
 
+/**
+\brief Enumeration of the counters of a frame profile that can be incremented individually.
+\remarks The entries are declared in the same order as the counters in FrameProfile.
+\see RenderingProfiler::Increment
+*/
+enum class ProfileCounter
+{
+    MipMapsGenerations,       //!< Refers to FrameProfile::mipMapsGenerations.
+    VertexBufferBindings,     //!< Refers to FrameProfile::vertexBufferBindings.
+    IndexBufferBindings,      //!< Refers to FrameProfile::indexBufferBindings.
+    ConstantBufferBindings,   //!< Refers to FrameProfile::constantBufferBindings.
+    SampledBufferBindings,    //!< Refers to FrameProfile::sampledBufferBindings.
+    StorageBufferBindings,    //!< Refers to FrameProfile::storageBufferBindings.
+    SampledTextureBindings,   //!< Refers to FrameProfile::sampledTextureBindings.
+    StorageTextureBindings,   //!< Refers to FrameProfile::storageTextureBindings.
+    SamplerBindings,          //!< Refers to FrameProfile::samplerBindings.
+    ResourceHeapBindings,     //!< Refers to FrameProfile::resourceHeapBindings.
+    GraphicsPipelineBindings, //!< Refers to FrameProfile::graphicsPipelineBindings.
+    ComputePipelineBindings,  //!< Refers to FrameProfile::computePipelineBindings.
+    AttachmentClears,         //!< Refers to FrameProfile::attachmentClears.
+    BufferUpdates,            //!< Refers to FrameProfile::bufferUpdates.
+    BufferCopies,             //!< Refers to FrameProfile::bufferCopies.
+    BufferFills,              //!< Refers to FrameProfile::bufferFills.
+    BufferWrites,             //!< Refers to FrameProfile::bufferWrites.
+    BufferReads,              //!< Refers to FrameProfile::bufferReads.
+    BufferMappings,           //!< Refers to FrameProfile::bufferMappings.
+    TextureCopies,            //!< Refers to FrameProfile::textureCopies.
+    TextureWrites,            //!< Refers to FrameProfile::textureWrites.
+    TextureReads,             //!< Refers to FrameProfile::textureReads.
+    RenderPassSections,       //!< Refers to FrameProfile::renderPassSections.
+    StreamOutputSections,     //!< Refers to FrameProfile::streamOutputSections.
+    QuerySections,            //!< Refers to FrameProfile::querySections.
+    RenderConditionSections,  //!< Refers to FrameProfile::renderConditionSections.
+    DrawCommands,             //!< Refers to FrameProfile::drawCommands.
+    DispatchCommands,         //!< Refers to FrameProfile::dispatchCommands.
+    CommandBufferSubmittions, //!< Refers to FrameProfile::commandBufferSubmittions.
+    CommandBufferEncodings,   //!< Refers to FrameProfile::commandBufferEncodings.
+    FenceSubmissions,         //!< Refers to FrameProfile::fenceSubmissions.
+};
+
 /**
 \brief Profile of a rendered frame.
 \see RenderingProfiler::NextFrame
@@ -287,22 +332,70 @@ class LLGL_EXPORT RenderingProfiler
 
     public:
 
+        RenderingProfiler();
+        ~RenderingProfiler();
+
+        RenderingProfiler(const RenderingProfiler&) = delete;
+        RenderingProfiler& operator = (const RenderingProfiler&) = delete;
+
         /**
         \brief Returns the current frame profile and resets the counters for the next frame.
         \param[out] outputProfile Optional pointer to an output profile to retrieve the current values. By default null.
+        \remarks This merges the counters of all threads into \c frameProfile before it is copied to the output and cleared.
+        It must not be called by multiple threads at the same time, but other threads can continue to accumulate values during this call.
         */
         void NextProfile(FrameProfile* outputProfile = nullptr);
 
         /**
         \brief Accumulates the specified profile with the current values.
         \param[in] profile Specifies the input profile whose values are to be merged with the current values.
+        \remarks This function is thread-safe. The counters are added to a set of counters that is owned by the calling thread,
+        so no locks are required. Only the time records are merged under a lock if there are any.
         \see FrameProfile::Accumulate
         */
         void Accumulate(const FrameProfile& profile);
 
+        /**
+        \brief Increments a single counter of the current frame profile.
+        \param[in] counter Specifies the counter that is to be incremented, e.g. ProfileCounter::BufferWrites.
+        \param[in] value Specifies the value that is added to the counter. By default 1.
+        \remarks This function is thread-safe and lock-free. Like Accumulate, it modifies the counters of the calling thread only.
+        */
+        void Increment(const ProfileCounter counter, std::uint32_t value = 1);
+
+        /**
+        \brief Starts a trace capture that streams timelines to the specified file in the Chrome Trace Event Format (JSON).
+        \param[in] filename Specifies the output filename. The file can be opened with \c chrome://tracing or \c ui.perfetto.dev.
+        \param[in] maxBufferedEvents Specifies the maximum number of events that are held in memory before they are written to the file. By default 4096.
+        \return True if the trace file could be opened. A previous trace capture is ended in any case.
+        \remarks The trace contains the CPU time of command buffer encoding per thread, the nested debug groups (see CommandBuffer::PushDebugGroup),
+        and the GPU time of each command on a separate GPU timeline. Trace events are only recorded by the debug layer,
+        i.e. this profiler must be passed to RenderSystem::Load.
+        \remarks Only elapsed times are known for GPU commands, so the GPU timeline places them back to back, starting at the encoding time of their command buffer.
+        \see EndTraceCapture
+        */
+        bool BeginTraceCapture(const char* filename, std::size_t maxBufferedEvents = 4096);
+
+        /**
+        \brief Ends the current trace capture and closes its file.
+        \remarks This must not be called while a command buffer is being encoded, i.e. between CommandBuffer::Begin and CommandBuffer::End.
+        \see BeginTraceCapture
+        */
+        void EndTraceCapture();
+
+        //! Returns true if a trace capture is currently running.
+        bool IsTraceCaptureEnabled() const;
+
+        //! Returns the trace writer of the current trace capture or null if there is none. This is used internally by the debug layer.
+        ProfilerTraceWriter* GetTraceWriter() const;
+
     public:
 
-        //! Current frame profile with all counter values.
+        /**
+        \brief Current frame profile with all counter values.
+        \remarks The counters of other threads are only merged into this profile by NextProfile.
+        Modifying this profile directly is not thread-safe; use Accumulate or Increment instead.
+        */
         FrameProfile    frameProfile;
 
         /**
@@ -311,6 +404,15 @@ class LLGL_EXPORT RenderingProfiler
         */
         bool            timeRecordingEnabled    = false;
 
+    private:
+
+        struct Pimpl;
+
+    private:
+
+        std::unique_ptr<ProfilerTraceWriter>    traceWriter_;
+        std::unique_ptr<Pimpl>                  pimpl_;
+
 };
 
 
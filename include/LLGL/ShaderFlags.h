@@ -377,6 +377,34 @@ struct ShaderDescriptor
     ComputeShaderAttributes     compute;
 };
 
+/**
+\brief Descriptor structure for a set of shader permutations that are created from the same shader source.
+\see RenderSystem::CreateShaderPermutations
+*/
+struct ShaderPermutationDescriptor
+{
+    /**
+    \brief Shader descriptor that is shared by all permutations.
+    \remarks The source type must refer to source code, i.e. ShaderSourceType::CodeString or ShaderSourceType::CodeFile.
+    The macros of ShaderDescriptor::defines are defined for all permutations, before the macros of the respective permutation.
+    */
+    ShaderDescriptor                shaderDesc;
+
+    /**
+    \brief Array of macro definitions for each permutation.
+    \remarks Each entry must either be null or a null-terminated array of ShaderMacro entries (see ShaderDescriptor::defines).
+    */
+    std::vector<const ShaderMacro*> permutations;
+
+    /**
+    \brief Specifies the number of threads that are used to preprocess the permutations. By default 0.
+    \remarks If this is less than 2, no multi-threading is used. If this is 'Constants::maxThreadCount',
+    the maximal count of threads the system supports will be used. The worker threads are taken from the same internal thread pool as for image conversions.
+    \note The worker threads only preprocess the macro definitions; the shaders are always compiled on the calling thread.
+    */
+    std::size_t                     threadCount     = 0;
+};
+
 
 /* ----- Functions ----- */
 
@@ -0,0 +1,80 @@
+/*
+ * ThreadPool.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_THREAD_POOL_H
+#define LLGL_THREAD_POOL_H
+
+
+#include "Interface.h"
+#include "Constants.h"
+#include <functional>
+#include <memory>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/**
+\brief Interface for a pool of persistent worker threads that is used by the image utility functions.
+\remarks The default implementation is a work-stealing job system that can be created with ThreadPool::Create.
+Clients can also implement this interface to let LLGL distribute its work over their own job system.
+\see ConvertImageBuffer(const SrcImageDescriptor&, const DstImageDescriptor&, ThreadPool&)
+*/
+class LLGL_EXPORT ThreadPool : public Interface
+{
+
+        LLGL_DECLARE_INTERFACE( InterfaceID::ThreadPool );
+
+    public:
+
+        /**
+        \brief Function type for a task that processes all elements in the half-open range <code>[begin, end)</code>.
+        \see ParallelFor
+        */
+        using Task = std::function<void(std::size_t begin, std::size_t end)>;
+
+    public:
+
+        /**
+        \brief Creates the default work-stealing thread pool.
+        \param[in] threadCount Specifies the number of worker threads. If this is 'Constants::maxThreadCount',
+        one worker thread less than the system supports will be created, because the calling thread always participates in the work.
+        If this is 0, all tasks are executed on the calling thread. By default Constants::maxThreadCount.
+        \see Constants::maxThreadCount
+        */
+        static std::unique_ptr<ThreadPool> Create(std::size_t threadCount = Constants::maxThreadCount);
+
+        /**
+        \brief Returns the number of worker threads of this pool.
+        \remarks This does not include the calling thread which also participates in the work of ParallelFor.
+        */
+        virtual std::size_t GetThreadCount() const = 0;
+
+        /**
+        \brief Splits the range <code>[0, count)</code> into chunks and executes the specified task for each chunk in parallel.
+        \param[in] count Specifies the number of elements to process.
+        \param[in] chunkSize Specifies the maximum number of elements per chunk. If this is 0, the range is processed as a single chunk.
+        \param[in] task Specifies the task that is called for each chunk.
+        \remarks This function blocks until all chunks have been processed. The calling thread participates in the work,
+        so this function can also be called recursively from within a task.
+        If any task throws an exception, the first exception is re-thrown on the calling thread after all chunks have been processed.
+        */
+        virtual void ParallelFor(std::size_t count, std::size_t chunkSize, const Task& task) = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,1581 @@
+/*
+ * BlockCompression.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BlockCompression.h"
+#include "ImageUtils.h"
+#include "SIMDMacros.h"
+#include <LLGL/Format.h>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/*
+All blocks are decoded into and encoded from 4x4 pixels with 8-bit RGBA components.
+Signed BC4 and BC5 blocks store their components as two's complement bytes; the codecs operate on values biased by +127,
+so the signed range [-127, 127] maps to [0, 254] and the same integer interpolation can be used for both variants.
+*/
+using BlockRGBA = std::uint8_t[16][4];
+
+// Pixel mask with all 16 pixels of a block
+static const std::uint16_t g_blockMaskAll = 0xFFFF;
+
+
+/* ----- Palette index selection ----- */
+
+/*
+Selects the nearest palette entry (by squared RGBA distance) for each pixel and stores its squared error in 'errors'.
+Ties are resolved in favor of the lower palette index.
+*/
+static void SelectPaletteIndices(
+    const BlockRGBA&        pixels,
+    const std::uint8_t      (*palette)[4],
+    int                     numEntries,
+    std::uint8_t            (&indices)[16],
+    std::uint32_t           (&errors)[16])
+{
+    #if defined LLGL_SIMD_SSE2
+
+    /* Unpack four pixels per register into two 16-bit halves */
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i pixelsLo[4], pixelsHi[4], bestError[4], bestIndex[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels[i*4]));
+        pixelsLo[i]     = _mm_unpacklo_epi8(p, zero);
+        pixelsHi[i]     = _mm_unpackhi_epi8(p, zero);
+        bestError[i]    = _mm_set1_epi32(INT_MAX);
+        bestIndex[i]    = zero;
+    }
+
+    for (int entry = 0; entry < numEntries; ++entry)
+    {
+        std::int32_t color;
+        ::memcpy(&color, palette[entry], sizeof(color));
+
+        const __m128i color16   = _mm_unpacklo_epi8(_mm_set1_epi32(color), zero);
+        const __m128i index     = _mm_set1_epi32(entry);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            /* Sum squared differences of (R, G) and (B, A) pairs, then combine the pairs of each pixel */
+            const __m128i diffLo    = _mm_sub_epi16(pixelsLo[i], color16);
+            const __m128i diffHi    = _mm_sub_epi16(pixelsHi[i], color16);
+            const __m128  sqLo      = _mm_castsi128_ps(_mm_madd_epi16(diffLo, diffLo));
+            const __m128  sqHi      = _mm_castsi128_ps(_mm_madd_epi16(diffHi, diffHi));
+            const __m128i error     = _mm_add_epi32(
+                _mm_castps_si128(_mm_shuffle_ps(sqLo, sqHi, _MM_SHUFFLE(2, 0, 2, 0))),
+                _mm_castps_si128(_mm_shuffle_ps(sqLo, sqHi, _MM_SHUFFLE(3, 1, 3, 1)))
+            );
+
+            /* Keep entry if its error is strictly less */
+            const __m128i less  = _mm_cmplt_epi32(error, bestError[i]);
+            bestError[i]        = _mm_or_si128(_mm_and_si128(less, error), _mm_andnot_si128(less, bestError[i]));
+            bestIndex[i]        = _mm_or_si128(_mm_and_si128(less, index), _mm_andnot_si128(less, bestIndex[i]));
+        }
+    }
+
+    std::int32_t indices32[16];
+    for (int i = 0; i < 4; ++i)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&errors[i*4]), bestError[i]);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&indices32[i*4]), bestIndex[i]);
+    }
+    for (int i = 0; i < 16; ++i)
+        indices[i] = static_cast<std::uint8_t>(indices32[i]);
+
+    #else
+
+    for (int i = 0; i < 16; ++i)
+    {
+        std::uint32_t bestError = UINT_MAX;
+        int bestIndex = 0;
+
+        for (int entry = 0; entry < numEntries; ++entry)
+        {
+            std::uint32_t error = 0;
+            for (int c = 0; c < 4; ++c)
+            {
+                const int diff = static_cast<int>(pixels[i][c]) - static_cast<int>(palette[entry][c]);
+                error += static_cast<std::uint32_t>(diff * diff);
+            }
+            if (error < bestError)
+            {
+                bestError = error;
+                bestIndex = entry;
+            }
+        }
+
+        indices[i]  = static_cast<std::uint8_t>(bestIndex);
+        errors[i]   = bestError;
+    }
+
+    #endif
+}
+
+// Returns the sum of the errors of all pixels in the specified mask.
+static std::uint32_t SumMaskedErrors(const std::uint32_t (&errors)[16], std::uint16_t mask)
+{
+    std::uint32_t sum = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((mask & (1u << i)) != 0)
+            sum += errors[i];
+    }
+    return sum;
+}
+
+
+/* ----- Endpoint estimation ----- */
+
+// Raw moments of a set of pixels, i.e. the sum of the components and their pairwise products.
+struct PixelMoments
+{
+    float count;
+    float sum[4];
+    float products[4][4];
+};
+
+static void AccumulatePixelMoments(const BlockRGBA& pixels, std::uint16_t mask, int numChannels, PixelMoments& moments)
+{
+    ::memset(&moments, 0, sizeof(moments));
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((mask & (1u << i)) != 0)
+        {
+            float p[4];
+            for (int c = 0; c < numChannels; ++c)
+            {
+                p[c] = static_cast<float>(pixels[i][c]);
+                moments.sum[c] += p[c];
+            }
+            for (int r = 0; r < numChannels; ++r)
+            {
+                for (int c = r; c < numChannels; ++c)
+                    moments.products[r][c] += p[r] * p[c];
+            }
+            moments.count += 1.0f;
+        }
+    }
+}
+
+// Adds the moments 'rhs' scaled by 'scale' (1 or -1) to the moments 'lhs'.
+static void AddPixelMoments(PixelMoments& lhs, const PixelMoments& rhs, float scale)
+{
+    lhs.count += rhs.count * scale;
+    for (int r = 0; r < 4; ++r)
+    {
+        lhs.sum[r] += rhs.sum[r] * scale;
+        for (int c = 0; c < 4; ++c)
+            lhs.products[r][c] += rhs.products[r][c] * scale;
+    }
+}
+
+/*
+Computes the principal axis of the moments by power iterations over their covariance matrix (without division by pixel count),
+and returns the sum of squared distances of the pixels to that axis. The axis is zero if all pixels are equal.
+*/
+static float ComputeMomentsPrincipalAxis(const PixelMoments& moments, int numChannels, int numIterations, float (&axis)[4])
+{
+    for (int c = 0; c < 4; ++c)
+        axis[c] = 0.0f;
+
+    if (moments.count == 0.0f)
+        return 0.0f;
+
+    const float invCount = 1.0f / moments.count;
+
+    float cov[4][4];
+    float trace = 0.0f;
+    for (int r = 0; r < numChannels; ++r)
+    {
+        for (int c = r; c < numChannels; ++c)
+            cov[r][c] = cov[c][r] = moments.products[r][c] - moments.sum[r] * moments.sum[c] * invCount;
+        trace += cov[r][r];
+    }
+
+    if (trace <= 0.0f)
+        return 0.0f;
+
+    /* Start power iterations with the channel of largest variance */
+    int maxChannel = 0;
+    for (int c = 1; c < numChannels; ++c)
+    {
+        if (cov[c][c] > cov[maxChannel][maxChannel])
+            maxChannel = c;
+    }
+
+    float v[4] = {};
+    for (int c = 0; c < numChannels; ++c)
+        v[c] = cov[maxChannel][c];
+
+    float lambda = 0.0f;
+    for (int iteration = 0; iteration < numIterations; ++iteration)
+    {
+        float w[4] = {};
+        for (int r = 0; r < numChannels; ++r)
+        {
+            for (int c = 0; c < numChannels; ++c)
+                w[r] += cov[r][c] * v[c];
+        }
+
+        float lengthSq = 0.0f;
+        for (int c = 0; c < numChannels; ++c)
+            lengthSq += w[c] * w[c];
+
+        if (lengthSq < 1.0e-12f)
+            return trace;
+
+        const float invLength = 1.0f / std::sqrt(lengthSq);
+        for (int c = 0; c < numChannels; ++c)
+            v[c] = w[c] * invLength;
+
+        lambda = std::sqrt(lengthSq);
+    }
+
+    for (int c = 0; c < numChannels; ++c)
+        axis[c] = v[c];
+
+    return std::max(0.0f, trace - lambda);
+}
+
+/*
+Computes the mean and principal axis of the masked pixels in the first 'numChannels' components (3 or 4),
+and returns the sum of squared distances of the pixels to that axis. The axis is zero if all pixels are equal.
+*/
+static float ComputePrincipalAxis(
+    const BlockRGBA&    pixels,
+    std::uint16_t       mask,
+    int                 numChannels,
+    float               (&mean)[4],
+    float               (&axis)[4])
+{
+    PixelMoments moments;
+    AccumulatePixelMoments(pixels, mask, numChannels, moments);
+
+    for (int c = 0; c < 4; ++c)
+        mean[c] = (moments.count > 0.0f && c < numChannels ? moments.sum[c] / moments.count : 0.0f);
+
+    return ComputeMomentsPrincipalAxis(moments, numChannels, 8, axis);
+}
+
+// Estimates two endpoints by projecting the masked pixels onto their principal axis.
+static void EstimateEndpoints(
+    const BlockRGBA&    pixels,
+    std::uint16_t       mask,
+    int                 numChannels,
+    float               (&endpoint0)[4],
+    float               (&endpoint1)[4])
+{
+    float mean[4], axis[4];
+    ComputePrincipalAxis(pixels, mask, numChannels, mean, axis);
+
+    float minT = 0.0f, maxT = 0.0f;
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((mask & (1u << i)) != 0)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < numChannels; ++c)
+                t += (static_cast<float>(pixels[i][c]) - mean[c]) * axis[c];
+            minT = std::min(minT, t);
+            maxT = std::max(maxT, t);
+        }
+    }
+
+    for (int c = 0; c < 4; ++c)
+    {
+        if (c < numChannels)
+        {
+            endpoint0[c] = std::max(0.0f, std::min(mean[c] + axis[c] * minT, 255.0f));
+            endpoint1[c] = std::max(0.0f, std::min(mean[c] + axis[c] * maxT, 255.0f));
+        }
+        else
+            endpoint0[c] = endpoint1[c] = 255.0f;
+    }
+}
+
+/*
+Solves the endpoints that minimize the squared error of the masked pixels for their interpolation weights in the range [0, 1].
+Returns false if the system is singular, i.e. all pixels have the same weight.
+*/
+static bool RefineEndpoints(
+    const BlockRGBA&    pixels,
+    std::uint16_t       mask,
+    int                 numChannels,
+    const float         (&weights)[16],
+    float               (&endpoint0)[4],
+    float               (&endpoint1)[4])
+{
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ap[4] = {}, bp[4] = {};
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((mask & (1u << i)) != 0)
+        {
+            const float b = weights[i];
+            const float a = 1.0f - b;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (int c = 0; c < numChannels; ++c)
+            {
+                ap[c] += a * static_cast<float>(pixels[i][c]);
+                bp[c] += b * static_cast<float>(pixels[i][c]);
+            }
+        }
+    }
+
+    const float det = aa * bb - ab * ab;
+    if (std::abs(det) < 1.0e-6f)
+        return false;
+
+    const float invDet = 1.0f / det;
+    for (int c = 0; c < numChannels; ++c)
+    {
+        endpoint0[c] = std::max(0.0f, std::min((ap[c] * bb - bp[c] * ab) * invDet, 255.0f));
+        endpoint1[c] = std::max(0.0f, std::min((bp[c] * aa - ap[c] * ab) * invDet, 255.0f));
+    }
+
+    return true;
+}
+
+
+/* ----- BC1 color blocks (also used by BC2 and BC3) ----- */
+
+static std::uint16_t PackRGB565(const float (&color)[4])
+{
+    const auto r = static_cast<std::uint16_t>(color[0] * (31.0f / 255.0f) + 0.5f);
+    const auto g = static_cast<std::uint16_t>(color[1] * (63.0f / 255.0f) + 0.5f);
+    const auto b = static_cast<std::uint16_t>(color[2] * (31.0f / 255.0f) + 0.5f);
+    return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void UnpackRGB565(std::uint16_t value, std::uint8_t (&color)[4])
+{
+    const int r = (value >> 11) & 0x1F;
+    const int g = (value >>  5) & 0x3F;
+    const int b = (value      ) & 0x1F;
+    color[0] = static_cast<std::uint8_t>((r << 3) | (r >> 2));
+    color[1] = static_cast<std::uint8_t>((g << 2) | (g >> 4));
+    color[2] = static_cast<std::uint8_t>((b << 3) | (b >> 2));
+    color[3] = 255;
+}
+
+// Builds the color palette of a BC1 block; the 3-color mode has transparent black as fourth entry.
+static void BuildColorPalette(std::uint16_t color0, std::uint16_t color1, bool fourColorMode, std::uint8_t (&palette)[4][4])
+{
+    UnpackRGB565(color0, palette[0]);
+    UnpackRGB565(color1, palette[1]);
+
+    for (int c = 0; c < 3; ++c)
+    {
+        const int c0 = palette[0][c];
+        const int c1 = palette[1][c];
+        if (fourColorMode)
+        {
+            palette[2][c] = static_cast<std::uint8_t>((2*c0 + c1 + 1) / 3);
+            palette[3][c] = static_cast<std::uint8_t>((c0 + 2*c1 + 1) / 3);
+        }
+        else
+        {
+            palette[2][c] = static_cast<std::uint8_t>((c0 + c1 + 1) / 2);
+            palette[3][c] = 0;
+        }
+    }
+
+    palette[2][3] = 255;
+    palette[3][3] = (fourColorMode ? 255 : 0);
+}
+
+static void DecodeColorBlock(const std::uint8_t* src, bool forceFourColorMode, BlockRGBA& pixels)
+{
+    const auto color0 = static_cast<std::uint16_t>(src[0] | (src[1] << 8));
+    const auto color1 = static_cast<std::uint16_t>(src[2] | (src[3] << 8));
+
+    std::uint8_t palette[4][4];
+    BuildColorPalette(color0, color1, (forceFourColorMode || color0 > color1), palette);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int index = (src[4 + i/4] >> ((i % 4) * 2)) & 0x3;
+        ::memcpy(pixels[i], palette[index], 4);
+    }
+}
+
+/*
+Encodes the RGB components of a block into a BC1 color block. If 'allowPunchThrough' is true (only for BC1),
+pixels with alpha less than 128 are encoded as transparent black in the 3-color mode. Otherwise, the 4-color mode is always used,
+which is how BC2 and BC3 decode their color blocks.
+*/
+static void EncodeColorBlock(const BlockRGBA& pixels, bool allowPunchThrough, BlockCompressionQuality quality, std::uint8_t* dst)
+{
+    /* Copy pixels with alpha set to zero, so only RGB components contribute to the error */
+    BlockRGBA colors;
+    std::uint16_t opaqueMask = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        colors[i][0] = pixels[i][0];
+        colors[i][1] = pixels[i][1];
+        colors[i][2] = pixels[i][2];
+        colors[i][3] = 0;
+        if (!allowPunchThrough || pixels[i][3] >= 128)
+            opaqueMask |= static_cast<std::uint16_t>(1u << i);
+    }
+
+    const bool fourColorMode = (opaqueMask == g_blockMaskAll);
+
+    std::uint16_t   bestColor0  = 0;
+    std::uint16_t   bestColor1  = 0;
+    std::uint8_t    bestIndices[16] = {};
+
+    if (opaqueMask != 0)
+    {
+        float endpoint0[4], endpoint1[4];
+        EstimateEndpoints(colors, opaqueMask, 3, endpoint0, endpoint1);
+
+        std::uint32_t bestError = UINT_MAX;
+
+        const int numIterations = (quality == BlockCompressionQuality::High ? 3 : 1);
+        for (int iteration = 0; iteration < numIterations; ++iteration)
+        {
+            /* Quantize endpoints and select nearest palette entries */
+            const auto color0 = PackRGB565(endpoint0);
+            const auto color1 = PackRGB565(endpoint1);
+
+            std::uint8_t palette[4][4];
+            BuildColorPalette(color0, color1, fourColorMode, palette);
+            for (auto& entry : palette)
+                entry[3] = 0;
+
+            std::uint8_t    indices[16];
+            std::uint32_t   errors[16];
+            SelectPaletteIndices(colors, palette, (fourColorMode ? 4 : 3), indices, errors);
+
+            const auto error = SumMaskedErrors(errors, opaqueMask);
+            if (error < bestError)
+            {
+                bestError   = error;
+                bestColor0  = color0;
+                bestColor1  = color1;
+                ::memcpy(bestIndices, indices, sizeof(indices));
+            }
+
+            if (error == 0 || iteration + 1 == numIterations)
+                break;
+
+            /* Refine endpoints with least squares for the selected indices */
+            static const float g_weights4[4] = { 0.0f, 1.0f, 1.0f/3.0f, 2.0f/3.0f };
+            static const float g_weights3[4] = { 0.0f, 1.0f, 0.5f,      0.0f      };
+
+            float weights[16];
+            for (int i = 0; i < 16; ++i)
+                weights[i] = (fourColorMode ? g_weights4[indices[i]] : g_weights3[indices[i]]);
+
+            if (!RefineEndpoints(colors, opaqueMask, 3, weights, endpoint0, endpoint1))
+                break;
+        }
+    }
+
+    /* Transparent pixels always refer to the fourth palette entry */
+    for (int i = 0; i < 16; ++i)
+    {
+        if ((opaqueMask & (1u << i)) == 0)
+            bestIndices[i] = 3;
+    }
+
+    /* Order endpoints to select the palette mode: 4-color mode requires color0 > color1, 3-color mode requires color0 <= color1 */
+    if (fourColorMode)
+    {
+        if (bestColor0 < bestColor1)
+        {
+            std::swap(bestColor0, bestColor1);
+            for (auto& index : bestIndices)
+                index ^= 0x1;
+        }
+        else if (bestColor0 == bestColor1)
+        {
+            /* All palette entries are equal, but only the first one is valid in 3-color mode */
+            for (auto& index : bestIndices)
+                index = 0;
+        }
+    }
+    else if (bestColor0 > bestColor1)
+    {
+        std::swap(bestColor0, bestColor1);
+        for (auto& index : bestIndices)
+        {
+            if (index < 2)
+                index ^= 0x1;
+        }
+    }
+
+    dst[0] = static_cast<std::uint8_t>(bestColor0 & 0xFF);
+    dst[1] = static_cast<std::uint8_t>(bestColor0 >> 8);
+    dst[2] = static_cast<std::uint8_t>(bestColor1 & 0xFF);
+    dst[3] = static_cast<std::uint8_t>(bestColor1 >> 8);
+
+    for (int row = 0; row < 4; ++row)
+    {
+        dst[4 + row] = static_cast<std::uint8_t>(
+            (bestIndices[row*4    ]     ) |
+            (bestIndices[row*4 + 1] << 2) |
+            (bestIndices[row*4 + 2] << 4) |
+            (bestIndices[row*4 + 3] << 6)
+        );
+    }
+}
+
+
+/* ----- BC2 explicit alpha blocks ----- */
+
+static void DecodeExplicitAlphaBlock(const std::uint8_t* src, BlockRGBA& pixels)
+{
+    for (int i = 0; i < 16; ++i)
+    {
+        const int alpha = (src[i/2] >> ((i % 2) * 4)) & 0xF;
+        pixels[i][3] = static_cast<std::uint8_t>(alpha * 17);
+    }
+}
+
+static void EncodeExplicitAlphaBlock(const BlockRGBA& pixels, std::uint8_t* dst)
+{
+    for (int i = 0; i < 8; ++i)
+    {
+        const int alpha0 = (pixels[i*2    ][3] * 15 + 127) / 255;
+        const int alpha1 = (pixels[i*2 + 1][3] * 15 + 127) / 255;
+        dst[i] = static_cast<std::uint8_t>(alpha0 | (alpha1 << 4));
+    }
+}
+
+
+/* ----- BC4 channel blocks (also used by BC3 and BC5) ----- */
+
+/*
+Builds the palette of a single channel block from two endpoints in the biased range [lo, hi]:
+If 'endpoint0 > endpoint1', six values are interpolated, otherwise four values are interpolated and the range limits are appended.
+*/
+static void BuildChannelPalette(int endpoint0, int endpoint1, int lo, int hi, int (&palette)[8])
+{
+    palette[0] = endpoint0;
+    palette[1] = endpoint1;
+
+    if (endpoint0 > endpoint1)
+    {
+        for (int i = 1; i < 7; ++i)
+            palette[i + 1] = ((7 - i) * endpoint0 + i * endpoint1 + 3) / 7;
+    }
+    else
+    {
+        for (int i = 1; i < 5; ++i)
+            palette[i + 1] = ((5 - i) * endpoint0 + i * endpoint1 + 2) / 5;
+        palette[6] = lo;
+        palette[7] = hi;
+    }
+}
+
+static int DecodeChannelEndpoint(std::uint8_t value, bool isSigned)
+{
+    if (isSigned)
+        return std::max(-127, static_cast<int>(static_cast<std::int8_t>(value))) + 127;
+    else
+        return value;
+}
+
+static std::uint8_t EncodeChannelEndpoint(int value, bool isSigned)
+{
+    if (isSigned)
+        return static_cast<std::uint8_t>(static_cast<std::int8_t>(value - 127));
+    else
+        return static_cast<std::uint8_t>(value);
+}
+
+// Decodes a single channel block into the specified component; signed values are stored as two's complement bytes.
+static void DecodeChannelBlock(const std::uint8_t* src, bool isSigned, int component, BlockRGBA& pixels)
+{
+    const int endpoint0 = DecodeChannelEndpoint(src[0], isSigned);
+    const int endpoint1 = DecodeChannelEndpoint(src[1], isSigned);
+
+    int palette[8];
+    BuildChannelPalette(endpoint0, endpoint1, 0, (isSigned ? 254 : 255), palette);
+
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 6; ++i)
+        bits |= static_cast<std::uint64_t>(src[2 + i]) << (i * 8);
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int value = palette[(bits >> (i * 3)) & 0x7];
+        pixels[i][component] = EncodeChannelEndpoint(value, isSigned);
+    }
+}
+
+// Selects the nearest palette entry for each value and returns the sum of squared errors.
+static std::uint32_t SelectChannelIndices(const int (&values)[16], const int (&palette)[8], std::uint8_t (&indices)[16])
+{
+    std::uint32_t sum = 0;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        int bestError = INT_MAX;
+        for (int entry = 0; entry < 8; ++entry)
+        {
+            const int diff  = values[i] - palette[entry];
+            const int error = diff * diff;
+            if (error < bestError)
+            {
+                bestError   = error;
+                indices[i]  = static_cast<std::uint8_t>(entry);
+            }
+        }
+        sum += static_cast<std::uint32_t>(bestError);
+    }
+
+    return sum;
+}
+
+// Encodes a single component of the block into a BC4 block; used for BC4, BC5, and the alpha block of BC3.
+static void EncodeChannelBlock(const BlockRGBA& pixels, int component, bool isSigned, BlockCompressionQuality quality, std::uint8_t* dst)
+{
+    const int lo = 0;
+    const int hi = (isSigned ? 254 : 255);
+
+    int values[16];
+    int minValue = hi, maxValue = lo;
+    for (int i = 0; i < 16; ++i)
+    {
+        values[i]   = DecodeChannelEndpoint(pixels[i][component], isSigned);
+        minValue    = std::min(minValue, values[i]);
+        maxValue    = std::max(maxValue, values[i]);
+    }
+
+    int             bestEndpoint0   = maxValue;
+    int             bestEndpoint1   = minValue;
+    std::uint8_t    bestIndices[16] = {};
+
+    if (minValue < maxValue)
+    {
+        /* Encode with 6 interpolated values between the value range */
+        int palette[8];
+        BuildChannelPalette(maxValue, minValue, lo, hi, palette);
+        auto bestError = SelectChannelIndices(values, palette, bestIndices);
+
+        if (quality == BlockCompressionQuality::High)
+        {
+            /* Refine endpoints of the 6-value mode with least squares */
+            std::uint8_t indices[16];
+            ::memcpy(indices, bestIndices, sizeof(indices));
+
+            for (int iteration = 0; iteration < 2 && bestError > 0; ++iteration)
+            {
+                float aa = 0.0f, ab = 0.0f, bb = 0.0f, ap = 0.0f, bp = 0.0f;
+                for (int i = 0; i < 16; ++i)
+                {
+                    const float b = (indices[i] < 2 ? static_cast<float>(indices[i]) : static_cast<float>(indices[i] - 1) / 7.0f);
+                    const float a = 1.0f - b;
+                    aa += a * a;
+                    ab += a * b;
+                    bb += b * b;
+                    ap += a * static_cast<float>(values[i]);
+                    bp += b * static_cast<float>(values[i]);
+                }
+
+                const float det = aa * bb - ab * ab;
+                if (std::abs(det) < 1.0e-6f)
+                    break;
+
+                int endpoint0 = static_cast<int>(std::lround((ap * bb - bp * ab) / det));
+                int endpoint1 = static_cast<int>(std::lround((bp * aa - ap * ab) / det));
+                endpoint0 = std::max(lo, std::min(endpoint0, hi));
+                endpoint1 = std::max(lo, std::min(endpoint1, hi));
+
+                if (endpoint0 < endpoint1)
+                    std::swap(endpoint0, endpoint1);
+                else if (endpoint0 == endpoint1)
+                    break;
+
+                BuildChannelPalette(endpoint0, endpoint1, lo, hi, palette);
+                const auto error = SelectChannelIndices(values, palette, indices);
+                if (error >= bestError)
+                    break;
+
+                bestError       = error;
+                bestEndpoint0   = endpoint0;
+                bestEndpoint1   = endpoint1;
+                ::memcpy(bestIndices, indices, sizeof(indices));
+            }
+
+            /* Try 4 interpolated values between the inner value range with explicit range limits */
+            int innerMin = hi, innerMax = lo;
+            for (int value : values)
+            {
+                if (value > lo && value < hi)
+                {
+                    innerMin = std::min(innerMin, value);
+                    innerMax = std::max(innerMax, value);
+                }
+            }
+
+            if (innerMin <= innerMax)
+            {
+                BuildChannelPalette(innerMin, innerMax, lo, hi, palette);
+                const auto error = SelectChannelIndices(values, palette, indices);
+                if (error < bestError)
+                {
+                    bestEndpoint0   = innerMin;
+                    bestEndpoint1   = innerMax;
+                    ::memcpy(bestIndices, indices, sizeof(indices));
+                }
+            }
+        }
+    }
+
+    dst[0] = EncodeChannelEndpoint(bestEndpoint0, isSigned);
+    dst[1] = EncodeChannelEndpoint(bestEndpoint1, isSigned);
+
+    std::uint64_t bits = 0;
+    for (int i = 0; i < 16; ++i)
+        bits |= static_cast<std::uint64_t>(bestIndices[i]) << (i * 3);
+
+    for (int i = 0; i < 6; ++i)
+        dst[2 + i] = static_cast<std::uint8_t>(bits >> (i * 8));
+}
+
+
+/* ----- BC7 blocks ----- */
+
+struct BC7ModeInfo
+{
+    int numSubsets;
+    int partitionBits;
+    int rotationBits;
+    int indexSelectionBits;
+    int colorBits;
+    int alphaBits;
+    int endpointPBits;  // One P-bit per endpoint
+    int sharedPBits;    // One P-bit per subset
+    int indexBits;
+    int index2Bits;
+};
+
+static const BC7ModeInfo g_bc7Modes[8] =
+{
+//    sub part rot sel col alp epb spb idx idx2
+    {  3,  4,  0,  0,  4,  0,  1,  0,  3,  0 }, // Mode 0
+    {  2,  6,  0,  0,  6,  0,  0,  1,  3,  0 }, // Mode 1
+    {  3,  6,  0,  0,  5,  0,  0,  0,  2,  0 }, // Mode 2
+    {  2,  6,  0,  0,  7,  0,  1,  0,  2,  0 }, // Mode 3
+    {  1,  0,  2,  1,  5,  6,  0,  0,  2,  3 }, // Mode 4
+    {  1,  0,  2,  0,  7,  8,  0,  0,  2,  2 }, // Mode 5
+    {  1,  0,  0,  0,  7,  7,  1,  0,  4,  0 }, // Mode 6
+    {  2,  6,  0,  0,  5,  5,  1,  0,  2,  0 }, // Mode 7
+};
+
+// Partitions for two subsets; bit i specifies the subset of pixel i
+static const std::uint16_t g_bc7Partitions2[64] =
+{
+    0xCCCC, 0x8888, 0xEEEE, 0xECC8, 0xC880, 0xFEEC, 0xFEC8, 0xEC80,
+    0xC800, 0xFFEC, 0xFE80, 0xE800, 0xFFE8, 0xFF00, 0xFFF0, 0xF000,
+    0xF710, 0x008E, 0x7100, 0x08CE, 0x008C, 0x7310, 0x3100, 0x8CCE,
+    0x088C, 0x3110, 0x6666, 0x366C, 0x17E8, 0x0FF0, 0x718E, 0x399C,
+    0xAAAA, 0xF0F0, 0x5A5A, 0x33CC, 0x3C3C, 0x55AA, 0x9696, 0xA55A,
+    0x73CE, 0x13C8, 0x324C, 0x3BDC, 0x6996, 0xC33C, 0x9966, 0x0660,
+    0x0272, 0x04E4, 0x4E40, 0x2720, 0xC936, 0x936C, 0x39C6, 0x639C,
+    0x9336, 0x9CC6, 0x817E, 0xE718, 0xCCF0, 0x0FCC, 0x7744, 0xEE22,
+};
+
+// Partitions for three subsets; bits [2*i, 2*i+1] specify the subset of pixel i
+static const std::uint32_t g_bc7Partitions3[64] =
+{
+    0xAA685050, 0x6A5A5040, 0x5A5A4200, 0x5450A0A8, 0xA5A50000, 0xA0A05050, 0x5555A0A0, 0x5A5A5050,
+    0xAA550000, 0xAA555500, 0xAAAA5500, 0x90909090, 0x94949494, 0xA4A4A4A4, 0xA9A59450, 0x2A0A4250,
+    0xA5945040, 0x0A425054, 0xA5A5A500, 0x55A0A0A0, 0xA8A85454, 0x6A6A4040, 0xA4A45000, 0x1A1A0500,
+    0x0050A4A4, 0xAAA59090, 0x14696914, 0x69691400, 0xA08585A0, 0xAA821414, 0x50A4A450, 0x6A5A0200,
+    0xA9A58000, 0x5090A0A8, 0xA8A09050, 0x24242424, 0x00AA5500, 0x24924924, 0x24499224, 0x50A50A50,
+    0x500AA550, 0xAAAA4444, 0x66660000, 0xA5A0A5A0, 0x50A050A0, 0x69286928, 0x44AAAA44, 0x66666600,
+    0xAA444444, 0x54A854A8, 0x95809580, 0x96969600, 0xA85454A8, 0x80959580, 0xAA141414, 0x96960000,
+    0xAAAA1414, 0xA05050A0, 0xA0A5A5A0, 0x96000000, 0x40804080, 0xA9A8A9A8, 0xAAAAAA44, 0x2A4A5254,
+};
+
+// Anchor pixel of the second subset for two subsets
+static const std::uint8_t g_bc7Anchors2[64] =
+{
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15,  2,  8,  2,  2,  8,  8, 15,  2,  8,  2,  2,  8,  8,  2,  2,
+    15, 15,  6,  8,  2,  8, 15, 15,  2,  8,  2,  2,  2, 15, 15,  6,
+     6,  2,  6,  8, 15, 15,  2,  2, 15, 15, 15, 15, 15,  2,  2, 15,
+};
+
+// Anchor pixels of the second and third subset for three subsets
+static const std::uint8_t g_bc7Anchors3[2][64] =
+{
+    {
+         3,  3, 15, 15,  8,  3, 15, 15,  8,  8,  6,  6,  6,  5,  3,  3,
+         3,  3,  8, 15,  3,  3,  6, 10,  5,  8,  8,  6,  8,  5, 15, 15,
+         8, 15,  3,  5,  6, 10,  8, 15, 15,  3, 15,  5, 15, 15, 15, 15,
+         3, 15,  5,  5,  5,  8,  5, 10,  5, 10,  8, 13, 15, 12,  3,  3,
+    },
+    {
+        15,  8,  8,  3, 15, 15,  3,  8, 15, 15, 15, 15, 15, 15, 15,  8,
+        15,  8, 15,  3, 15,  8, 15,  8,  3, 15,  6, 10, 15, 15, 10,  8,
+        15,  3, 15, 10, 10,  8,  9, 10,  6, 15,  8, 15,  3,  6,  6,  8,
+        15,  3, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,  3, 15, 15,  8,
+    },
+};
+
+static const int g_bc7Weights2[4]   = { 0, 21, 43, 64 };
+static const int g_bc7Weights3[8]   = { 0, 9, 18, 27, 37, 46, 55, 64 };
+static const int g_bc7Weights4[16]  = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+static const int* GetBC7Weights(int indexBits)
+{
+    switch (indexBits)
+    {
+        case 2:     return g_bc7Weights2;
+        case 3:     return g_bc7Weights3;
+        default:    return g_bc7Weights4;
+    }
+}
+
+static int GetBC7Subset(int numSubsets, int partition, int pixel)
+{
+    switch (numSubsets)
+    {
+        case 2:     return (g_bc7Partitions2[partition] >> pixel) & 0x1;
+        case 3:     return (g_bc7Partitions3[partition] >> (pixel * 2)) & 0x3;
+        default:    return 0;
+    }
+}
+
+static int GetBC7AnchorPixel(int numSubsets, int partition, int subset)
+{
+    if (subset == 0)
+        return 0;
+    else if (numSubsets == 2)
+        return g_bc7Anchors2[partition];
+    else
+        return g_bc7Anchors3[subset - 1][partition];
+}
+
+static bool IsBC7AnchorPixel(int numSubsets, int partition, int pixel)
+{
+    for (int subset = 0; subset < numSubsets; ++subset)
+    {
+        if (GetBC7AnchorPixel(numSubsets, partition, subset) == pixel)
+            return true;
+    }
+    return false;
+}
+
+// Returns the mask of all pixels in the specified subset.
+static std::uint16_t GetBC7SubsetMask(int numSubsets, int partition, int subset)
+{
+    std::uint16_t mask = 0;
+    for (int i = 0; i < 16; ++i)
+    {
+        if (GetBC7Subset(numSubsets, partition, i) == subset)
+            mask |= static_cast<std::uint16_t>(1u << i);
+    }
+    return mask;
+}
+
+// Expands a quantized endpoint component with the specified number of bits (including P-bit) to 8 bits.
+static int ExpandBC7Component(int value, int bits)
+{
+    value <<= (8 - bits);
+    return (value | (value >> bits));
+}
+
+static std::uint8_t InterpolateBC7(int endpoint0, int endpoint1, int weight)
+{
+    return static_cast<std::uint8_t>(((64 - weight) * endpoint0 + weight * endpoint1 + 32) >> 6);
+}
+
+// Reads the bits of a 128-bit block in LSB-first order.
+class BC7BitReader
+{
+
+    public:
+
+        BC7BitReader(const std::uint8_t* data) :
+            data_ { data }
+        {
+        }
+
+        int Read(int numBits)
+        {
+            int value = 0;
+            for (int i = 0; i < numBits; ++i, ++pos_)
+                value |= ((data_[pos_ / 8] >> (pos_ % 8)) & 0x1) << i;
+            return value;
+        }
+
+    private:
+
+        const std::uint8_t* data_   = nullptr;
+        int                 pos_    = 0;
+
+};
+
+// Writes the bits of a 128-bit block in LSB-first order.
+class BC7BitWriter
+{
+
+    public:
+
+        BC7BitWriter(std::uint8_t* data) :
+            data_ { data }
+        {
+            ::memset(data_, 0, 16);
+        }
+
+        void Write(int value, int numBits)
+        {
+            for (int i = 0; i < numBits; ++i, ++pos_)
+                data_[pos_ / 8] |= static_cast<std::uint8_t>(((value >> i) & 0x1) << (pos_ % 8));
+        }
+
+    private:
+
+        std::uint8_t*   data_   = nullptr;
+        int             pos_    = 0;
+
+};
+
+static void DecodeBC7Block(const std::uint8_t* src, BlockRGBA& pixels)
+{
+    /* Determine mode by the number of leading zero bits; reserved modes decode to transparent black */
+    int mode = 0;
+    while (mode < 8 && (src[0] & (1 << mode)) == 0)
+        ++mode;
+
+    if (mode == 8)
+    {
+        ::memset(pixels, 0, sizeof(BlockRGBA));
+        return;
+    }
+
+    const auto& info = g_bc7Modes[mode];
+
+    BC7BitReader reader{ src };
+    reader.Read(mode + 1);
+
+    const int partition         = reader.Read(info.partitionBits);
+    const int rotation          = reader.Read(info.rotationBits);
+    const int indexSelection    = reader.Read(info.indexSelectionBits);
+
+    /* Read endpoints: all red components first, then green, blue, and alpha */
+    const int numEndpoints = info.numSubsets * 2;
+
+    int endpoints[6][4];
+    for (int c = 0; c < 3; ++c)
+    {
+        for (int e = 0; e < numEndpoints; ++e)
+            endpoints[e][c] = reader.Read(info.colorBits);
+    }
+
+    for (int e = 0; e < numEndpoints; ++e)
+        endpoints[e][3] = (info.alphaBits > 0 ? reader.Read(info.alphaBits) : 255);
+
+    /* Append P-bits and expand endpoints to 8 bits */
+    const int numPBits = (info.endpointPBits > 0 || info.sharedPBits > 0 ? 1 : 0);
+
+    int pbits[6] = {};
+    if (info.endpointPBits > 0)
+    {
+        for (int e = 0; e < numEndpoints; ++e)
+            pbits[e] = reader.Read(1);
+    }
+    else if (info.sharedPBits > 0)
+    {
+        for (int s = 0; s < info.numSubsets; ++s)
+            pbits[s*2] = pbits[s*2 + 1] = reader.Read(1);
+    }
+
+    for (int e = 0; e < numEndpoints; ++e)
+    {
+        for (int c = 0; c < 3; ++c)
+            endpoints[e][c] = ExpandBC7Component((endpoints[e][c] << numPBits) | (pbits[e] & numPBits), info.colorBits + numPBits);
+        if (info.alphaBits > 0)
+            endpoints[e][3] = ExpandBC7Component((endpoints[e][3] << numPBits) | (pbits[e] & numPBits), info.alphaBits + numPBits);
+    }
+
+    /* Read primary and secondary indices; anchor pixels have their most significant bit omitted */
+    int indices[16], indices2[16] = {};
+    for (int i = 0; i < 16; ++i)
+        indices[i] = reader.Read(info.indexBits - (IsBC7AnchorPixel(info.numSubsets, partition, i) ? 1 : 0));
+
+    if (info.index2Bits > 0)
+    {
+        for (int i = 0; i < 16; ++i)
+            indices2[i] = reader.Read(info.index2Bits - (i == 0 ? 1 : 0));
+    }
+
+    /* Interpolate colors; modes with secondary indices use them for alpha unless the index selection swaps them */
+    const int* colorWeights = GetBC7Weights(info.indexBits);
+    const int* alphaWeights = colorWeights;
+    const int* colorIndices = indices;
+    const int* alphaIndices = indices;
+
+    if (info.index2Bits > 0)
+    {
+        alphaWeights = GetBC7Weights(info.index2Bits);
+        alphaIndices = indices2;
+        if (indexSelection != 0)
+        {
+            std::swap(colorWeights, alphaWeights);
+            std::swap(colorIndices, alphaIndices);
+        }
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        const int subset    = GetBC7Subset(info.numSubsets, partition, i);
+        const auto& e0      = endpoints[subset*2];
+        const auto& e1      = endpoints[subset*2 + 1];
+
+        for (int c = 0; c < 3; ++c)
+            pixels[i][c] = InterpolateBC7(e0[c], e1[c], colorWeights[colorIndices[i]]);
+        pixels[i][3] = InterpolateBC7(e0[3], e1[3], alphaWeights[alphaIndices[i]]);
+
+        if (rotation > 0)
+            std::swap(pixels[i][rotation - 1], pixels[i][3]);
+    }
+}
+
+/*
+Quantizes a pair of endpoints to the precision of the specified mode and stores the quantized components and P-bits.
+The P-bits are chosen to minimize the error of the expanded endpoints.
+*/
+static void QuantizeBC7Endpoints(
+    const BC7ModeInfo&  info,
+    const float         (&endpoint0)[4],
+    const float         (&endpoint1)[4],
+    int                 (&quantized)[2][4],
+    int                 (&pbits)[2],
+    std::uint8_t        (&expanded)[2][4])
+{
+    const int numChannels   = (info.alphaBits > 0 ? 4 : 3);
+    const int numPBits      = (info.endpointPBits > 0 || info.sharedPBits > 0 ? 1 : 0);
+    const float* endpoints[2] = { endpoint0, endpoint1 };
+
+    // Quantizes a single component for a P-bit and returns the squared error of its expanded value
+    auto QuantizeComponent = [numPBits](float value, int bits, int pbit, int& quantizedValue, int& expandedValue) -> float
+    {
+        const int   maxValue    = (1 << bits) - 1;
+        const float scaled      = value * static_cast<float>((1 << (bits + numPBits)) - 1) / 255.0f;
+        const int   estimate    = static_cast<int>(std::lround((scaled - static_cast<float>(pbit)) / static_cast<float>(1 << numPBits)));
+
+        float bestError = 1.0e30f;
+        for (int q = std::max(0, estimate - 1); q <= std::min(estimate + 1, maxValue); ++q)
+        {
+            const int   x       = ExpandBC7Component((q << numPBits) | pbit, bits + numPBits);
+            const float diff    = static_cast<float>(x) - value;
+            if (diff * diff < bestError)
+            {
+                bestError       = diff * diff;
+                quantizedValue  = q;
+                expandedValue   = x;
+            }
+        }
+
+        return bestError;
+    };
+
+    // Quantizes all components of an endpoint for a P-bit and returns the squared error
+    auto QuantizeEndpoint = [&](int e, int pbit, int (&q)[4], std::uint8_t (&x)[4]) -> float
+    {
+        float error = 0.0f;
+        for (int c = 0; c < 4; ++c)
+        {
+            if (c < numChannels)
+            {
+                int expandedValue = 0;
+                error += QuantizeComponent(endpoints[e][c], (c < 3 ? info.colorBits : info.alphaBits), pbit, q[c], expandedValue);
+                x[c] = static_cast<std::uint8_t>(expandedValue);
+            }
+            else
+            {
+                q[c] = 0;
+                x[c] = 255;
+            }
+        }
+        return error;
+    };
+
+    int             q[2][4];
+    std::uint8_t    x[2][4];
+
+    if (info.endpointPBits > 0)
+    {
+        /* Select P-bit for each endpoint individually */
+        for (int e = 0; e < 2; ++e)
+        {
+            const float error0 = QuantizeEndpoint(e, 0, q[0], x[0]);
+            const float error1 = QuantizeEndpoint(e, 1, q[1], x[1]);
+            pbits[e] = (error1 < error0 ? 1 : 0);
+            ::memcpy(quantized[e], q[pbits[e]], sizeof(q[0]));
+            ::memcpy(expanded[e], x[pbits[e]], sizeof(x[0]));
+        }
+    }
+    else if (info.sharedPBits > 0)
+    {
+        /* Select one P-bit for both endpoints */
+        float bestError = 1.0e30f;
+        for (int pbit = 0; pbit < 2; ++pbit)
+        {
+            int             qs[2][4];
+            std::uint8_t    xs[2][4];
+            const float error = QuantizeEndpoint(0, pbit, qs[0], xs[0]) + QuantizeEndpoint(1, pbit, qs[1], xs[1]);
+            if (error < bestError)
+            {
+                bestError = error;
+                pbits[0] = pbits[1] = pbit;
+                ::memcpy(quantized, qs, sizeof(qs));
+                ::memcpy(expanded, xs, sizeof(xs));
+            }
+        }
+    }
+    else
+    {
+        pbits[0] = pbits[1] = 0;
+        QuantizeEndpoint(0, 0, quantized[0], expanded[0]);
+        QuantizeEndpoint(1, 0, quantized[1], expanded[1]);
+    }
+}
+
+/*
+Encodes the block with the specified BC7 mode without rotation or index selection (modes 0, 1, 2, 3, 6, and 7) and partition,
+and returns the sum of squared errors. If 'refine' is true, the endpoints of each subset are refined with least squares.
+*/
+static std::uint32_t EncodeBC7BlockMode(const BlockRGBA& pixels, int mode, int partition, bool refine, std::uint8_t* dst)
+{
+    const auto& info        = g_bc7Modes[mode];
+    const int numChannels   = (info.alphaBits > 0 ? 4 : 3);
+    const int numIndices    = (1 << info.indexBits);
+    const int* weights      = GetBC7Weights(info.indexBits);
+
+    int             quantized[6][4];
+    int             pbits[6];
+    std::uint8_t    indices[16] = {};
+    std::uint32_t   totalError  = 0;
+
+    for (int subset = 0; subset < info.numSubsets; ++subset)
+    {
+        const auto mask = GetBC7SubsetMask(info.numSubsets, partition, subset);
+
+        float endpoint0[4], endpoint1[4];
+        EstimateEndpoints(pixels, mask, numChannels, endpoint0, endpoint1);
+
+        std::uint32_t bestError = UINT_MAX;
+
+        const int numIterations = (refine ? 3 : 1);
+        for (int iteration = 0; iteration < numIterations; ++iteration)
+        {
+            /* Quantize endpoints and build palette of interpolated colors */
+            int             q[2][4];
+            int             p[2];
+            std::uint8_t    x[2][4];
+            QuantizeBC7Endpoints(info, endpoint0, endpoint1, q, p, x);
+
+            std::uint8_t palette[16][4];
+            for (int i = 0; i < numIndices; ++i)
+            {
+                for (int c = 0; c < 4; ++c)
+                    palette[i][c] = InterpolateBC7(x[0][c], x[1][c], weights[i]);
+            }
+
+            std::uint8_t    subsetIndices[16];
+            std::uint32_t   errors[16];
+            SelectPaletteIndices(pixels, palette, numIndices, subsetIndices, errors);
+
+            const auto error = SumMaskedErrors(errors, mask);
+            if (error < bestError)
+            {
+                bestError = error;
+                ::memcpy(quantized[subset*2], q, sizeof(q));
+                pbits[subset*2    ] = p[0];
+                pbits[subset*2 + 1] = p[1];
+                for (int i = 0; i < 16; ++i)
+                {
+                    if ((mask & (1u << i)) != 0)
+                        indices[i] = subsetIndices[i];
+                }
+            }
+
+            if (error == 0 || iteration + 1 == numIterations)
+                break;
+
+            /* Refine endpoints with least squares for the selected indices */
+            float pixelWeights[16];
+            for (int i = 0; i < 16; ++i)
+                pixelWeights[i] = static_cast<float>(weights[subsetIndices[i]]) / 64.0f;
+
+            if (!RefineEndpoints(pixels, mask, numChannels, pixelWeights, endpoint0, endpoint1))
+                break;
+        }
+
+        totalError += bestError;
+
+        /* Swap endpoints if the most significant index bit of the anchor pixel is set, because it is not stored */
+        const int anchor = GetBC7AnchorPixel(info.numSubsets, partition, subset);
+        if (indices[anchor] >= numIndices / 2)
+        {
+            std::swap(quantized[subset*2], quantized[subset*2 + 1]);
+            std::swap(pbits[subset*2], pbits[subset*2 + 1]);
+            for (int i = 0; i < 16; ++i)
+            {
+                if ((mask & (1u << i)) != 0)
+                    indices[i] = static_cast<std::uint8_t>(numIndices - 1 - indices[i]);
+            }
+        }
+    }
+
+    /* Write block */
+    const int numEndpoints = info.numSubsets * 2;
+
+    BC7BitWriter writer{ dst };
+    writer.Write(1 << mode, mode + 1);
+    writer.Write(partition, info.partitionBits);
+
+    for (int c = 0; c < 3; ++c)
+    {
+        for (int e = 0; e < numEndpoints; ++e)
+            writer.Write(quantized[e][c], info.colorBits);
+    }
+
+    if (info.alphaBits > 0)
+    {
+        for (int e = 0; e < numEndpoints; ++e)
+            writer.Write(quantized[e][3], info.alphaBits);
+    }
+
+    if (info.endpointPBits > 0)
+    {
+        for (int e = 0; e < numEndpoints; ++e)
+            writer.Write(pbits[e], 1);
+    }
+    else if (info.sharedPBits > 0)
+    {
+        for (int s = 0; s < info.numSubsets; ++s)
+            writer.Write(pbits[s*2], 1);
+    }
+
+    for (int i = 0; i < 16; ++i)
+        writer.Write(indices[i], info.indexBits - (IsBC7AnchorPixel(info.numSubsets, partition, i) ? 1 : 0));
+
+    return totalError;
+}
+
+// Number of two-subset partitions that are fully encoded in high quality mode
+static const int g_bc7NumPartitionCandidates = 4;
+
+// Number of power iterations to estimate the line-fit error of each partition for ranking
+static const int g_bc7RankingIterations = 3;
+
+/*
+Encodes a BC7 block: The fast mode only uses mode 6 (a single subset with RGBA endpoints).
+The high quality mode additionally refines the endpoints and tries the best two-subset partitions
+with mode 1 and 3 for opaque blocks, or mode 7 for blocks with alpha.
+*/
+static void EncodeBC7Block(const BlockRGBA& pixels, BlockCompressionQuality quality, std::uint8_t* dst)
+{
+    const bool refine = (quality == BlockCompressionQuality::High);
+
+    auto bestError = EncodeBC7BlockMode(pixels, 6, 0, refine, dst);
+    if (quality != BlockCompressionQuality::High || bestError == 0)
+        return;
+
+    bool isOpaque = true;
+    for (int i = 0; i < 16 && isOpaque; ++i)
+        isOpaque = (pixels[i][3] == 255);
+
+    /*
+    Rank partitions by the error that remains after fitting a line through each subset: The moments of the first subset
+    are summed up from precomputed moments of each pixel, and the moments of the second subset are derived from those of the entire block.
+    Alpha is always included since it does not contribute to the covariance of opaque blocks
+    */
+    PixelMoments pixelMoments[16];
+    PixelMoments blockMoments;
+    ::memset(&blockMoments, 0, sizeof(blockMoments));
+
+    for (int i = 0; i < 16; ++i)
+    {
+        AccumulatePixelMoments(pixels, static_cast<std::uint16_t>(1u << i), 4, pixelMoments[i]);
+        AddPixelMoments(blockMoments, pixelMoments[i], 1.0f);
+    }
+
+    std::pair<float, int> ranking[64];
+    for (int partition = 0; partition < 64; ++partition)
+    {
+        PixelMoments subsetMoments[2];
+        ::memset(&subsetMoments[0], 0, sizeof(subsetMoments[0]));
+
+        const auto mask = GetBC7SubsetMask(2, partition, 0);
+        for (int i = 0; i < 16; ++i)
+        {
+            if ((mask & (1u << i)) != 0)
+                AddPixelMoments(subsetMoments[0], pixelMoments[i], 1.0f);
+        }
+
+        subsetMoments[1] = blockMoments;
+        AddPixelMoments(subsetMoments[1], subsetMoments[0], -1.0f);
+
+        float axis[4];
+        const float error = (
+            ComputeMomentsPrincipalAxis(subsetMoments[0], 4, g_bc7RankingIterations, axis) +
+            ComputeMomentsPrincipalAxis(subsetMoments[1], 4, g_bc7RankingIterations, axis)
+        );
+        ranking[partition] = { error, partition };
+    }
+
+    std::partial_sort(ranking, ranking + g_bc7NumPartitionCandidates, ranking + 64);
+
+    /* Encode best partitions and keep block with the least error */
+    static const int g_opaqueModes[]        = { 1, 3 };
+    static const int g_translucentModes[]   = { 7 };
+
+    const int*  modes       = (isOpaque ? g_opaqueModes : g_translucentModes);
+    const int   numModes    = (isOpaque ? 2 : 1);
+
+    for (int candidate = 0; candidate < g_bc7NumPartitionCandidates; ++candidate)
+    {
+        /* Stop when the line-fit error without quantization already exceeds the best error */
+        if (ranking[candidate].first >= static_cast<float>(bestError))
+            break;
+
+        for (int i = 0; i < numModes; ++i)
+        {
+            std::uint8_t block[16];
+            const auto error = EncodeBC7BlockMode(pixels, modes[i], ranking[candidate].second, refine, block);
+            if (error < bestError)
+            {
+                bestError = error;
+                ::memcpy(dst, block, sizeof(block));
+            }
+        }
+    }
+}
+
+
+/* ----- Block dispatch ----- */
+
+static void DecodeBlock(const ImageFormat format, bool isSigned, const std::uint8_t* src, BlockRGBA& pixels)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            DecodeColorBlock(src, false, pixels);
+            break;
+        case ImageFormat::BC2:
+            DecodeColorBlock(src + 8, true, pixels);
+            DecodeExplicitAlphaBlock(src, pixels);
+            break;
+        case ImageFormat::BC3:
+            DecodeColorBlock(src + 8, true, pixels);
+            DecodeChannelBlock(src, false, 3, pixels);
+            break;
+        case ImageFormat::BC4:
+            DecodeChannelBlock(src, isSigned, 0, pixels);
+            break;
+        case ImageFormat::BC5:
+            DecodeChannelBlock(src, isSigned, 0, pixels);
+            DecodeChannelBlock(src + 8, isSigned, 1, pixels);
+            break;
+        case ImageFormat::BC7:
+            DecodeBC7Block(src, pixels);
+            break;
+        default:
+            break;
+    }
+}
+
+static void EncodeBlock(const ImageFormat format, bool isSigned, const BlockRGBA& pixels, BlockCompressionQuality quality, std::uint8_t* dst)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:
+            EncodeColorBlock(pixels, true, quality, dst);
+            break;
+        case ImageFormat::BC2:
+            EncodeExplicitAlphaBlock(pixels, dst);
+            EncodeColorBlock(pixels, false, quality, dst + 8);
+            break;
+        case ImageFormat::BC3:
+            EncodeChannelBlock(pixels, 3, false, quality, dst);
+            EncodeColorBlock(pixels, false, quality, dst + 8);
+            break;
+        case ImageFormat::BC4:
+            EncodeChannelBlock(pixels, 0, isSigned, quality, dst);
+            break;
+        case ImageFormat::BC5:
+            EncodeChannelBlock(pixels, 0, isSigned, quality, dst);
+            EncodeChannelBlock(pixels, 1, isSigned, quality, dst + 8);
+            break;
+        case ImageFormat::BC7:
+            EncodeBC7Block(pixels, quality, dst);
+            break;
+        default:
+            break;
+    }
+}
+
+
+/* ----- Functions ----- */
+
+std::uint32_t GetCompressedBlockSize(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::BC1:  return 8;
+        case ImageFormat::BC2:  return 16;
+        case ImageFormat::BC3:  return 16;
+        case ImageFormat::BC4:  return 8;
+        case ImageFormat::BC5:  return 16;
+        case ImageFormat::BC7:  return 16;
+        default:                return 0;
+    }
+}
+
+ImageFormat GetDecompressedImageFormat(const ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::BC4:  return ImageFormat::R;
+        case ImageFormat::BC5:  return ImageFormat::RG;
+        default:                return ImageFormat::RGBA;
+    }
+}
+
+bool IsCompressedImageDataTypeValid(const ImageFormat format, const DataType dataType)
+{
+    if (dataType == DataType::UInt8)
+        return true;
+    if (dataType == DataType::Int8)
+        return (format == ImageFormat::BC4 || format == ImageFormat::BC5);
+    return false;
+}
+
+void DecompressImageBlocks(
+    const ImageFormat   format,
+    const DataType      dataType,
+    const void*         src,
+    const Extent3D&     extent,
+    void*               dst,
+    ThreadPool*         threadPool,
+    std::size_t         maxChunks)
+{
+    const auto blockSize        = GetCompressedBlockSize(format);
+    const auto bpp              = ImageFormatSize(GetDecompressedImageFormat(format));
+    const auto numBlocksX       = (extent.width  + 3) / 4;
+    const auto numBlocksY       = (extent.height + 3) / 4;
+    const auto numBlockRows     = static_cast<std::size_t>(numBlocksY) * extent.depth;
+    const bool isSigned         = (dataType == DataType::Int8);
+
+    auto srcBlocks = reinterpret_cast<const std::uint8_t*>(src);
+    auto dstPixels = reinterpret_cast<std::uint8_t*>(dst);
+
+    ParallelForImageRange(
+        threadPool,
+        maxChunks,
+        numBlockRows,
+        1,
+        [=](std::size_t begin, std::size_t end)
+        {
+            for (auto blockRow = begin; blockRow < end; ++blockRow)
+            {
+                const auto z        = static_cast<std::uint32_t>(blockRow / numBlocksY);
+                const auto blockY   = static_cast<std::uint32_t>(blockRow % numBlocksY);
+                const auto height   = std::min(4u, extent.height - blockY * 4);
+
+                for (std::uint32_t blockX = 0; blockX < numBlocksX; ++blockX)
+                {
+                    BlockRGBA pixels;
+                    DecodeBlock(format, isSigned, srcBlocks + (blockRow * numBlocksX + blockX) * blockSize, pixels);
+
+                    /* Write pixels inside the image extent */
+                    const auto width = std::min(4u, extent.width - blockX * 4);
+                    for (std::uint32_t y = 0; y < height; ++y)
+                    {
+                        const auto row = (static_cast<std::size_t>(z) * extent.height + blockY * 4 + y) * extent.width + blockX * 4;
+                        for (std::uint32_t x = 0; x < width; ++x)
+                            ::memcpy(dstPixels + (row + x) * bpp, pixels[y*4 + x], bpp);
+                    }
+                }
+            }
+        }
+    );
+}
+
+void CompressImageBlocks(
+    const ImageFormat       format,
+    const DataType          dataType,
+    const void*             src,
+    const Extent3D&         extent,
+    void*                   dst,
+    BlockCompressionQuality quality,
+    ThreadPool*             threadPool,
+    std::size_t             maxChunks)
+{
+    const auto blockSize        = GetCompressedBlockSize(format);
+    const auto bpp              = ImageFormatSize(GetDecompressedImageFormat(format));
+    const auto numBlocksX       = (extent.width  + 3) / 4;
+    const auto numBlocksY       = (extent.height + 3) / 4;
+    const auto numBlockRows     = static_cast<std::size_t>(numBlocksY) * extent.depth;
+    const bool isSigned         = (dataType == DataType::Int8);
+
+    auto srcPixels = reinterpret_cast<const std::uint8_t*>(src);
+    auto dstBlocks = reinterpret_cast<std::uint8_t*>(dst);
+
+    ParallelForImageRange(
+        threadPool,
+        maxChunks,
+        numBlockRows,
+        1,
+        [=](std::size_t begin, std::size_t end)
+        {
+            for (auto blockRow = begin; blockRow < end; ++blockRow)
+            {
+                const auto z        = static_cast<std::uint32_t>(blockRow / numBlocksY);
+                const auto blockY   = static_cast<std::uint32_t>(blockRow % numBlocksY);
+
+                for (std::uint32_t blockX = 0; blockX < numBlocksX; ++blockX)
+                {
+                    /* Read pixels and replicate the edge pixels of partial blocks; missing components are zero */
+                    BlockRGBA pixels = {};
+                    for (std::uint32_t y = 0; y < 4; ++y)
+                    {
+                        const auto srcY = std::min(blockY * 4 + y, extent.height - 1);
+                        const auto row  = (static_cast<std::size_t>(z) * extent.height + srcY) * extent.width;
+                        for (std::uint32_t x = 0; x < 4; ++x)
+                        {
+                            const auto srcX = std::min(blockX * 4 + x, extent.width - 1);
+                            ::memcpy(pixels[y*4 + x], srcPixels + (row + srcX) * bpp, bpp);
+                        }
+                    }
+
+                    EncodeBlock(format, isSigned, pixels, quality, dstBlocks + (blockRow * numBlocksX + blockX) * blockSize);
+                }
+            }
+        }
+    );
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
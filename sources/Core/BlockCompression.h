@@ -0,0 +1,75 @@
+/*
+ * BlockCompression.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BLOCK_COMPRESSION_H
+#define LLGL_BLOCK_COMPRESSION_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/ThreadPool.h>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+// Returns the size (in bytes) of a single 4x4 block of the specified compressed image format, or 0 if the format is not compressed.
+std::uint32_t GetCompressedBlockSize(const ImageFormat format);
+
+/*
+Returns the uncompressed image format a compressed image format is decoded into,
+i.e. ImageFormat::R for BC4, ImageFormat::RG for BC5, and ImageFormat::RGBA for all other formats.
+*/
+ImageFormat GetDecompressedImageFormat(const ImageFormat format);
+
+/*
+Returns true if the data type is valid for the compressed image format: DataType::UInt8 for unsigned normalized formats,
+or DataType::Int8 for the signed normalized variants of BC4 and BC5.
+*/
+bool IsCompressedImageDataTypeValid(const ImageFormat format, const DataType dataType);
+
+/*
+Decodes all 4x4 blocks of the compressed source image into the destination buffer of the respective decompressed image format
+(see GetDecompressedImageFormat) with the same data type. Pixels of partial blocks outside the image extent are discarded.
+The buffer sizes must have already been validated.
+*/
+void DecompressImageBlocks(
+    const ImageFormat   format,
+    const DataType      dataType,
+    const void*         src,
+    const Extent3D&     extent,
+    void*               dst,
+    ThreadPool*         threadPool,
+    std::size_t         maxChunks
+);
+
+/*
+Encodes the source image of the respective decompressed image format (see GetDecompressedImageFormat) into 4x4 blocks of the compressed destination image.
+Partial blocks at the image border are padded by replicating the edge pixels. The buffer sizes must have already been validated.
+*/
+void CompressImageBlocks(
+    const ImageFormat       format,
+    const DataType          dataType,
+    const void*             src,
+    const Extent3D&         extent,
+    void*                   dst,
+    BlockCompressionQuality quality,
+    ThreadPool*             threadPool,
+    std::size_t             maxChunks
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
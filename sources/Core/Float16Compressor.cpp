@@ -6,6 +6,7 @@
  */
 
 #include "Float16Compressor.h"
+#include "SIMDMacros.h"
 
 
 namespace LLGL
@@ -93,6 +94,177 @@ class Float16Compressor
 };
 
 
+/* ----- SIMD helper functions ----- */
+
+/*
+The hardware conversions (F16C and FCVT) produce the same results as Float16Compressor, except for NaN payloads
+and values that exceed the range of 16-bit floats. Vectors with such elements are converted with the generic code path instead.
+*/
+
+#if defined LLGL_SIMD_SSE2
+
+// Returns (a ^ ((b ^ a) & mask)), which selects 'b' for all lanes where 'mask' is set.
+static inline __m128i SelectMasked(__m128i a, __m128i b, __m128i mask)
+{
+    return _mm_xor_si128(a, _mm_and_si128(_mm_xor_si128(b, a), mask));
+}
+
+// Packs the lower 16 bits of each 32-bit lane into 8 words.
+static inline __m128i PackLowWords(__m128i a, __m128i b)
+{
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+    return _mm_packs_epi32(a, b);
+}
+
+// Vectorized version of Float16Compressor::Compress; results are stored in the lower 16 bits of each 32-bit lane.
+static inline __m128i CompressFloat16x4(__m128 value)
+{
+    const __m128i infN = _mm_set1_epi32(0x7f800000);
+    const __m128i maxN = _mm_set1_epi32(0x477fe000);
+    const __m128i minN = _mm_set1_epi32(0x38800000);
+    const __m128i nanN = _mm_set1_epi32(0x7f802000);
+    const __m128i maxC = _mm_set1_epi32(0x00023bff);
+    const __m128i subC = _mm_set1_epi32(0x000003ff);
+    const __m128i maxD = _mm_set1_epi32(0x0001c000);
+    const __m128i minD = _mm_set1_epi32(0x0001c000);
+
+    __m128i v       = _mm_castps_si128(value);
+    __m128i sign    = _mm_and_si128(v, _mm_set1_epi32(static_cast<int>(0x80000000u)));
+    v               = _mm_xor_si128(v, sign);
+    sign            = _mm_srli_epi32(sign, 16);
+
+    __m128i s       = _mm_cvttps_epi32(_mm_mul_ps(_mm_castsi128_ps(_mm_set1_epi32(0x52000000)), _mm_castsi128_ps(v)));
+
+    v = SelectMasked(v, s, _mm_cmpgt_epi32(minN, v));
+    v = SelectMasked(v, infN, _mm_and_si128(_mm_cmpgt_epi32(infN, v), _mm_cmpgt_epi32(v, maxN)));
+    v = SelectMasked(v, nanN, _mm_and_si128(_mm_cmpgt_epi32(nanN, v), _mm_cmpgt_epi32(v, infN)));
+    v = _mm_srli_epi32(v, 13);
+    v = SelectMasked(v, _mm_sub_epi32(v, maxD), _mm_cmpgt_epi32(v, maxC));
+    v = SelectMasked(v, _mm_sub_epi32(v, minD), _mm_cmpgt_epi32(v, subC));
+
+    return _mm_or_si128(v, sign);
+}
+
+// Vectorized version of Float16Compressor::Decompress; input values are stored in the lower 16 bits of each 32-bit lane.
+static inline __m128 DecompressFloat16x4(__m128i value)
+{
+    const __m128i maxC = _mm_set1_epi32(0x00023bff);
+    const __m128i subC = _mm_set1_epi32(0x000003ff);
+    const __m128i norC = _mm_set1_epi32(0x00000400);
+    const __m128i maxD = _mm_set1_epi32(0x0001c000);
+    const __m128i minD = _mm_set1_epi32(0x0001c000);
+
+    __m128i v       = value;
+    __m128i sign    = _mm_and_si128(v, _mm_set1_epi32(0x00008000));
+    v               = _mm_xor_si128(v, sign);
+    sign            = _mm_slli_epi32(sign, 16);
+
+    v = SelectMasked(v, _mm_add_epi32(v, minD), _mm_cmpgt_epi32(v, subC));
+    v = SelectMasked(v, _mm_add_epi32(v, maxD), _mm_cmpgt_epi32(v, maxC));
+
+    __m128  s       = _mm_mul_ps(_mm_castsi128_ps(_mm_set1_epi32(0x33800000)), _mm_cvtepi32_ps(v));
+    __m128i mask    = _mm_cmpgt_epi32(norC, v);
+
+    v = _mm_slli_epi32(v, 13);
+    v = SelectMasked(v, _mm_castps_si128(s), mask);
+
+    return _mm_castsi128_ps(_mm_or_si128(v, sign));
+}
+
+static inline void CompressFloat16x8(const float* src, std::uint16_t* dst)
+{
+    __m128 x0 = _mm_loadu_ps(src    );
+    __m128 x1 = _mm_loadu_ps(src + 4);
+
+    #if defined LLGL_SIMD_F16C
+
+    /* Use hardware conversion with truncation unless the absolute value of any element exceeds the largest 16-bit float */
+    const __m128i absMask   = _mm_set1_epi32(0x7fffffff);
+    const __m128i maxN      = _mm_set1_epi32(0x477fe000);
+    __m128i overflow        = _mm_or_si128(
+        _mm_cmpgt_epi32(_mm_and_si128(_mm_castps_si128(x0), absMask), maxN),
+        _mm_cmpgt_epi32(_mm_and_si128(_mm_castps_si128(x1), absMask), maxN)
+    );
+
+    if (_mm_movemask_epi8(overflow) == 0)
+    {
+        __m128i y0 = _mm_cvtps_ph(x0, _MM_FROUND_TO_ZERO);
+        __m128i y1 = _mm_cvtps_ph(x1, _MM_FROUND_TO_ZERO);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi64(y0, y1));
+        return;
+    }
+
+    #endif // /LLGL_SIMD_F16C
+
+    __m128i y0 = CompressFloat16x4(x0);
+    __m128i y1 = CompressFloat16x4(x1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), PackLowWords(y0, y1));
+}
+
+static inline void DecompressFloat16x8(const std::uint16_t* src, float* dst)
+{
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+
+    #if defined LLGL_SIMD_F16C
+
+    /* Use hardware conversion unless any element is NaN */
+    __m128i nan = _mm_cmpgt_epi16(_mm_and_si128(x, _mm_set1_epi16(0x7fff)), _mm_set1_epi16(0x7c00));
+
+    if (_mm_movemask_epi8(nan) == 0)
+    {
+        _mm_storeu_ps(dst    , _mm_cvtph_ps(x));
+        _mm_storeu_ps(dst + 4, _mm_cvtph_ps(_mm_srli_si128(x, 8)));
+        return;
+    }
+
+    #endif // /LLGL_SIMD_F16C
+
+    const __m128i zero = _mm_setzero_si128();
+    _mm_storeu_ps(dst    , DecompressFloat16x4(_mm_unpacklo_epi16(x, zero)));
+    _mm_storeu_ps(dst + 4, DecompressFloat16x4(_mm_unpackhi_epi16(x, zero)));
+}
+
+#elif defined LLGL_SIMD_NEON
+
+// Converts 4 elements with FCVT and returns false if the generic code path must be used instead.
+static inline bool CompressFloat16x4(const float* src, std::uint16_t* dst)
+{
+    float32x4_t x = vld1q_f32(src);
+
+    /* Reject elements whose absolute value exceeds the largest 16-bit float */
+    uint32x4_t overflow = vcgtq_u32(vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(0x7fffffff)), vdupq_n_u32(0x477fe000));
+    if (vmaxvq_u32(overflow) != 0)
+        return false;
+
+    /* FCVT rounds to nearest, so decrement the magnitude of all elements that have been rounded away from zero */
+    float16x4_t y       = vcvt_f16_f32(x);
+    uint32x4_t  roundUp = vcagtq_f32(vcvt_f32_f16(y), x);
+    uint16x4_t  result  = vadd_u16(vreinterpret_u16_f16(y), vmovn_u32(roundUp));
+
+    vst1_u16(dst, result);
+    return true;
+}
+
+// Converts 4 elements with FCVT and returns false if the generic code path must be used instead.
+static inline bool DecompressFloat16x4(const std::uint16_t* src, float* dst)
+{
+    uint16x4_t x = vld1_u16(src);
+
+    /* Reject NaN elements */
+    uint16x4_t nan = vcgt_u16(vand_u16(x, vdup_n_u16(0x7fff)), vdup_n_u16(0x7c00));
+    if (vmaxv_u16(nan) != 0)
+        return false;
+
+    vst1q_f32(dst, vcvt_f32_f16(vreinterpret_f16_u16(x)));
+    return true;
+}
+
+#endif // /LLGL_SIMD_NEON
+
+
+/* ----- Functions ----- */
+
 LLGL_EXPORT std::uint16_t CompressFloat16(float value)
 {
     return Float16Compressor::Compress(value);
@@ -103,6 +275,58 @@ LLGL_EXPORT float DecompressFloat16(std::uint16_t value)
     return Float16Compressor::Decompress(value);
 }
 
+LLGL_EXPORT void CompressFloat16Array(const float* src, std::uint16_t* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SIMD_SSE2
+
+    for (; i + 8 <= count; i += 8)
+        CompressFloat16x8(src + i, dst + i);
+
+    #elif defined LLGL_SIMD_NEON
+
+    for (; i + 4 <= count; i += 4)
+    {
+        if (!CompressFloat16x4(src + i, dst + i))
+        {
+            for (std::size_t j = i; j < i + 4; ++j)
+                dst[j] = Float16Compressor::Compress(src[j]);
+        }
+    }
+
+    #endif
+
+    for (; i < count; ++i)
+        dst[i] = Float16Compressor::Compress(src[i]);
+}
+
+LLGL_EXPORT void DecompressFloat16Array(const std::uint16_t* src, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SIMD_SSE2
+
+    for (; i + 8 <= count; i += 8)
+        DecompressFloat16x8(src + i, dst + i);
+
+    #elif defined LLGL_SIMD_NEON
+
+    for (; i + 4 <= count; i += 4)
+    {
+        if (!DecompressFloat16x4(src + i, dst + i))
+        {
+            for (std::size_t j = i; j < i + 4; ++j)
+                dst[j] = Float16Compressor::Decompress(src[j]);
+        }
+    }
+
+    #endif
+
+    for (; i < count; ++i)
+        dst[i] = Float16Compressor::Decompress(src[i]);
+}
+
 
 } // /namespace LLGL
 
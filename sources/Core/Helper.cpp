@@ -66,6 +66,17 @@ LLGL_EXPORT std::wstring ToUTF16String(const char* utf8)
     return std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>>{}.from_bytes(utf8);
 }
 
+LLGL_EXPORT std::uint64_t HashFNV1a(const void* data, std::size_t size, std::uint64_t hash)
+{
+    auto bytes = reinterpret_cast<const std::uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x00000100000001B3ull;
+    }
+    return hash;
+}
+
 
 } // /namespace LLGL
 
@@ -298,6 +298,9 @@ LLGL_EXPORT std::string ToUTF8String(const wchar_t* utf16);
 LLGL_EXPORT std::wstring ToUTF16String(const std::string& utf8);
 LLGL_EXPORT std::wstring ToUTF16String(const char* utf8);
 
+// Returns the 64-bit FNV-1a hash of the specified data. Pass the result of a previous call as 'hash' to combine multiple data blocks.
+LLGL_EXPORT std::uint64_t HashFNV1a(const void* data, std::size_t size, std::uint64_t hash = 0xCBF29CE484222325ull);
+
 
 } // /namespace LLGL
 
@@ -91,6 +91,20 @@ void Image::Convert(const ImageFormat format, const DataType dataType, std::size
     dataType_   = dataType;
 }
 
+void Image::Convert(const ImageFormat format, const DataType dataType, ThreadPool& threadPool)
+{
+    /* Convert image buffer (if necessary) */
+    if (data_)
+    {
+        if (auto convertedData = ConvertImageBuffer(GetSrcDesc(), format, dataType, threadPool))
+            data_ = std::move(convertedData);
+    }
+
+    /* Store new attributes */
+    format_     = format;
+    dataType_   = dataType;
+}
+
 void Image::Resize(const Extent3D& extent)
 {
     /* Allocate new image buffer or release it if the extent is zero */
@@ -150,7 +164,17 @@ void Image::Resize(const Extent3D& extent, const ColorRGBAd& fillColor, const Of
 
 void Image::Resize(const Extent3D& extent, const SamplerFilter filter)
 {
-    //todo
+    ResizeWithThreadPool(extent, (filter == SamplerFilter::Linear ? ResampleFilter::Linear : ResampleFilter::Nearest), nullptr, 0);
+}
+
+void Image::Resize(const Extent3D& extent, const ResampleFilter filter, std::size_t threadCount)
+{
+    ResizeWithThreadPool(extent, filter, nullptr, threadCount);
+}
+
+void Image::Resize(const Extent3D& extent, const ResampleFilter filter, ThreadPool& threadPool)
+{
+    ResizeWithThreadPool(extent, filter, &threadPool, 0);
 }
 
 void Image::Swap(Image& rhs)
@@ -321,95 +345,32 @@ static void ValidateImageDataSize(const Extent3D& extent, const SrcImageDescript
 
 void Image::ReadPixels(const Offset3D& offset, const Extent3D& extent, const DstImageDescriptor& imageDesc, std::size_t threadCount) const
 {
-    if (imageDesc.data && IsRegionInside(offset, extent))
-    {
-        /* Validate required size */
-        ValidateImageDataSize(extent, imageDesc);
-
-        /* Get source image parameters */
-        const auto  bpp             = GetBytesPerPixel();
-        const auto  srcRowStride    = bpp * GetExtent().width;
-        const auto  srcDepthStride  = srcRowStride * GetExtent().height;
-        auto        src             = data_.get() + GetDataPtrOffset(offset);
-
-        if (GetFormat() == imageDesc.format && GetDataType() == imageDesc.dataType)
-        {
-            /* Get destination image parameters */
-            const auto  dstRowStride    = bpp * extent.width;
-            const auto  dstDepthStride  = dstRowStride * extent.height;
-            auto        dst             = reinterpret_cast<char*>(imageDesc.data);
-
-            /* Blit region into destination image */
-            BitBlit(
-                extent, bpp,
-                dst, dstRowStride, dstDepthStride,
-                src, srcRowStride, srcDepthStride
-            );
-        }
-        else
-        {
-            /* Copy region into temporary sub-image */
-            Image subImage { extent, GetFormat(), GetDataType() };
-
-            BitBlit(
-                extent, bpp,
-                reinterpret_cast<char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride(),
-                src, srcRowStride, srcDepthStride
-            );
-
-            /* Convert sub-image */
-            subImage.Convert(imageDesc.format, imageDesc.dataType, threadCount);
+    ReadPixelsWithThreadPool(offset, extent, imageDesc, nullptr, threadCount);
+}
 
-            /* Copy sub-image into output data */
-            ::memcpy(imageDesc.data, subImage.GetData(), imageDesc.dataSize);
-        }
-    }
+void Image::ReadPixels(const Offset3D& offset, const Extent3D& extent, const DstImageDescriptor& imageDesc, ThreadPool& threadPool) const
+{
+    ReadPixelsWithThreadPool(offset, extent, imageDesc, &threadPool, 0);
 }
 
 void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc, std::size_t threadCount)
 {
-    if (imageDesc.data && IsRegionInside(offset, extent))
-    {
-        /* Validate required size */
-        ValidateImageDataSize(extent, imageDesc);
-
-        /* Get destination image parameters */
-        const auto  bpp             = GetBytesPerPixel();
-        const auto  dstRowStride    = bpp * GetExtent().width;
-        const auto  dstDepthStride  = dstRowStride * GetExtent().height;
-        auto        dst             = data_.get() + GetDataPtrOffset(offset);
-
-        if (GetFormat() == imageDesc.format && GetDataType() == imageDesc.dataType)
-        {
-            /* Get source image parameters */
-            const auto  srcRowStride    = bpp * extent.width;
-            const auto  srcDepthStride  = srcRowStride * extent.height;
-            auto        src             = reinterpret_cast<const char*>(imageDesc.data);
+    WritePixelsWithThreadPool(offset, extent, imageDesc, nullptr, threadCount);
+}
 
-            /* Blit source image into region */
-            BitBlit(
-                extent, bpp,
-                dst, dstRowStride, dstDepthStride,
-                src, srcRowStride, srcDepthStride
-            );
-        }
-        else
-        {
-            /* Copy input data into sub-image into */
-            Image subImage { extent, imageDesc.format, imageDesc.dataType };
-            ::memcpy(subImage.GetData(), imageDesc.data, imageDesc.dataSize);
+void Image::WritePixels(const Offset3D& offset, const Extent3D& extent, const SrcImageDescriptor& imageDesc, ThreadPool& threadPool)
+{
+    WritePixelsWithThreadPool(offset, extent, imageDesc, &threadPool, 0);
+}
 
-            /* Convert sub-image */
-            subImage.Convert(GetFormat(), GetDataType(), threadCount);
+ByteBuffer Image::GenerateMips(const MipGenerationDescriptor& mipGenDesc, std::size_t threadCount) const
+{
+    return GenerateMipsWithThreadPool(mipGenDesc, nullptr, threadCount);
+}
 
-            /* Copy temporary sub-image into region */
-            BitBlit(
-                extent, bpp,
-                dst, dstRowStride, dstDepthStride,
-                reinterpret_cast<const char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride()
-            );
-        }
-    }
+ByteBuffer Image::GenerateMips(const MipGenerationDescriptor& mipGenDesc, ThreadPool& threadPool) const
+{
+    return GenerateMipsWithThreadPool(mipGenDesc, &threadPool, 0);
 }
 
 void Image::MirrorYZPlane()
@@ -527,6 +488,161 @@ void Image::ClampRegion(Offset3D& offset, Extent3D& extent) const
     extent.depth    = std::min(extent.depth, GetExtent().depth);
 }
 
+void Image::ReadPixelsWithThreadPool(
+    const Offset3D&             offset,
+    const Extent3D&             extent,
+    const DstImageDescriptor&   imageDesc,
+    ThreadPool*                 threadPool,
+    std::size_t                 threadCount) const
+{
+    if (imageDesc.data && IsRegionInside(offset, extent))
+    {
+        /* Validate required size */
+        ValidateImageDataSize(extent, imageDesc);
+
+        /* Get source image parameters */
+        const auto  bpp             = GetBytesPerPixel();
+        const auto  srcRowStride    = bpp * GetExtent().width;
+        const auto  srcDepthStride  = srcRowStride * GetExtent().height;
+        auto        src             = data_.get() + GetDataPtrOffset(offset);
+
+        if (GetFormat() == imageDesc.format && GetDataType() == imageDesc.dataType)
+        {
+            /* Get destination image parameters */
+            const auto  dstRowStride    = bpp * extent.width;
+            const auto  dstDepthStride  = dstRowStride * extent.height;
+            auto        dst             = reinterpret_cast<char*>(imageDesc.data);
+
+            /* Blit region into destination image */
+            BitBlit(
+                extent, bpp,
+                dst, dstRowStride, dstDepthStride,
+                src, srcRowStride, srcDepthStride
+            );
+        }
+        else
+        {
+            /* Copy region into temporary sub-image */
+            Image subImage { extent, GetFormat(), GetDataType() };
+
+            BitBlit(
+                extent, bpp,
+                reinterpret_cast<char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride(),
+                src, srcRowStride, srcDepthStride
+            );
+
+            /* Convert sub-image */
+            if (threadPool != nullptr)
+                subImage.Convert(imageDesc.format, imageDesc.dataType, *threadPool);
+            else
+                subImage.Convert(imageDesc.format, imageDesc.dataType, threadCount);
+
+            /* Copy sub-image into output data */
+            ::memcpy(imageDesc.data, subImage.GetData(), imageDesc.dataSize);
+        }
+    }
+}
+
+void Image::WritePixelsWithThreadPool(
+    const Offset3D&             offset,
+    const Extent3D&             extent,
+    const SrcImageDescriptor&   imageDesc,
+    ThreadPool*                 threadPool,
+    std::size_t                 threadCount)
+{
+    if (imageDesc.data && IsRegionInside(offset, extent))
+    {
+        /* Validate required size */
+        ValidateImageDataSize(extent, imageDesc);
+
+        /* Get destination image parameters */
+        const auto  bpp             = GetBytesPerPixel();
+        const auto  dstRowStride    = bpp * GetExtent().width;
+        const auto  dstDepthStride  = dstRowStride * GetExtent().height;
+        auto        dst             = data_.get() + GetDataPtrOffset(offset);
+
+        if (GetFormat() == imageDesc.format && GetDataType() == imageDesc.dataType)
+        {
+            /* Get source image parameters */
+            const auto  srcRowStride    = bpp * extent.width;
+            const auto  srcDepthStride  = srcRowStride * extent.height;
+            auto        src             = reinterpret_cast<const char*>(imageDesc.data);
+
+            /* Blit source image into region */
+            BitBlit(
+                extent, bpp,
+                dst, dstRowStride, dstDepthStride,
+                src, srcRowStride, srcDepthStride
+            );
+        }
+        else
+        {
+            /* Copy input data into sub-image into */
+            Image subImage { extent, imageDesc.format, imageDesc.dataType };
+            ::memcpy(subImage.GetData(), imageDesc.data, imageDesc.dataSize);
+
+            /* Convert sub-image */
+            if (threadPool != nullptr)
+                subImage.Convert(GetFormat(), GetDataType(), *threadPool);
+            else
+                subImage.Convert(GetFormat(), GetDataType(), threadCount);
+
+            /* Copy temporary sub-image into region */
+            BitBlit(
+                extent, bpp,
+                dst, dstRowStride, dstDepthStride,
+                reinterpret_cast<const char*>(subImage.GetData()), subImage.GetRowStride(), subImage.GetDepthStride()
+            );
+        }
+    }
+}
+
+void Image::ResizeWithThreadPool(const Extent3D& extent, const ResampleFilter filter, ThreadPool* threadPool, std::size_t threadCount)
+{
+    if (extent != GetExtent())
+    {
+        if (data_ && extent.width > 0 && extent.height > 0 && extent.depth > 0)
+        {
+            /* Resample previous image buffer into new image buffer */
+            const auto          dataSize    = GetMemoryFootprint(GetFormat(), GetDataType(), extent.width * extent.height * extent.depth);
+            auto                data        = AllocateByteBuffer(dataSize, UninitializeTag{});
+            DstImageDescriptor  dstImageDesc{ GetFormat(), GetDataType(), data.get(), dataSize };
+
+            if (threadPool != nullptr)
+                ResampleImageBuffer(GetSrcDesc(), GetExtent(), dstImageDesc, extent, filter, *threadPool);
+            else
+                ResampleImageBuffer(GetSrcDesc(), GetExtent(), dstImageDesc, extent, filter, threadCount);
+
+            /* Store new attributes */
+            extent_ = extent;
+            data_   = std::move(data);
+        }
+        else
+        {
+            /* Allocate new image buffer or release it */
+            Resize(extent);
+        }
+    }
+}
+
+ByteBuffer Image::GenerateMipsWithThreadPool(const MipGenerationDescriptor& mipGenDesc, ThreadPool* threadPool, std::size_t threadCount) const
+{
+    if (!data_)
+        return nullptr;
+
+    /* Generate MIP-map chain into new image buffer */
+    const auto          dataSize    = GetMipChainSize(GetFormat(), GetDataType(), GetExtent(), mipGenDesc);
+    auto                data        = AllocateByteBuffer(dataSize, UninitializeTag{});
+    DstImageDescriptor  dstImageDesc{ GetFormat(), GetDataType(), data.get(), dataSize };
+
+    if (threadPool != nullptr)
+        GenerateMipChain(GetSrcDesc(), GetExtent(), dstImageDesc, mipGenDesc, *threadPool);
+    else
+        GenerateMipChain(GetSrcDesc(), GetExtent(), dstImageDesc, mipGenDesc, threadCount);
+
+    return data;
+}
+
 
 } // /namespace LLGL
 
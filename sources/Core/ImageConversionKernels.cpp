@@ -0,0 +1,257 @@
+/*
+ * ImageConversionKernels.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageConversionKernels.h"
+#include "Float16Compressor.h"
+#include "SIMDMacros.h"
+#include <algorithm>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+The scalar conversions below must match the generic conversion in "ImageFlags.cpp" exactly,
+i.e. normalized integers are read as (x / max) and written as trunc(x * max) in double precision.
+*/
+
+static inline float UInt8ToFloat32(std::uint8_t value)
+{
+    return static_cast<float>(static_cast<double>(value) / 255.0);
+}
+
+static inline std::uint8_t Float32ToUInt8(float value)
+{
+    return static_cast<std::uint8_t>(static_cast<double>(value) * 255.0);
+}
+
+
+/* ----- SIMD helper functions ----- */
+
+#if defined LLGL_SIMD_SSE2
+
+// Converts the UInt8 values in the lower 4 bytes to Float32 in the range [0, 1].
+static inline __m128 UInt8x4ToFloat32x4(__m128i value)
+{
+    /*
+    Single precision division yields the same result as rounding the double precision quotient to single precision,
+    which has been verified exhaustively for all 256 input values.
+    */
+    return _mm_div_ps(_mm_cvtepi32_ps(value), _mm_set1_ps(255.0f));
+}
+
+// Converts 4 Float32 values to UInt8 values that are stored in 32-bit lanes; multiplication must be in double precision.
+static inline __m128i Float32x4ToUInt8x4(__m128 value)
+{
+    #if defined LLGL_SIMD_AVX2
+    return _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtps_pd(value), _mm256_set1_pd(255.0)));
+    #else
+    const __m128d scale = _mm_set1_pd(255.0);
+    __m128i lo = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(value), scale));
+    __m128i hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(value, value)), scale));
+    return _mm_unpacklo_epi64(lo, hi);
+    #endif
+}
+
+// Packs the lower byte of each 32-bit lane into 16 bytes (same as the implicit truncation of a scalar integer cast).
+static inline __m128i PackLowBytes(__m128i a, __m128i b, __m128i c, __m128i d)
+{
+    const __m128i mask = _mm_set1_epi32(0xFF);
+    __m128i ab = _mm_packs_epi32(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+    __m128i cd = _mm_packs_epi32(_mm_and_si128(c, mask), _mm_and_si128(d, mask));
+    return _mm_packus_epi16(ab, cd);
+}
+
+#endif // /LLGL_SIMD_SSE2
+
+
+/* ----- Conversion kernels ----- */
+
+static void ConvertUInt8ToFloat32(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint8_t*>(src);
+    auto dstBuf = reinterpret_cast<float*>(dst);
+    auto i      = idxBegin;
+
+    #if defined LLGL_SIMD_AVX2
+
+    const __m256 scale = _mm256_set1_ps(255.0f);
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        __m256i x = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(srcBuf + i)));
+        _mm256_storeu_ps(dstBuf + i, _mm256_div_ps(_mm256_cvtepi32_ps(x), scale));
+    }
+
+    #elif defined LLGL_SIMD_SSE2
+
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        __m128i x  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(srcBuf + i));
+        __m128i lo = _mm_unpacklo_epi8(x, zero);
+        __m128i hi = _mm_unpackhi_epi8(x, zero);
+        _mm_storeu_ps(dstBuf + i     , UInt8x4ToFloat32x4(_mm_unpacklo_epi16(lo, zero)));
+        _mm_storeu_ps(dstBuf + i +  4, UInt8x4ToFloat32x4(_mm_unpackhi_epi16(lo, zero)));
+        _mm_storeu_ps(dstBuf + i +  8, UInt8x4ToFloat32x4(_mm_unpacklo_epi16(hi, zero)));
+        _mm_storeu_ps(dstBuf + i + 12, UInt8x4ToFloat32x4(_mm_unpackhi_epi16(hi, zero)));
+    }
+
+    #elif defined LLGL_SIMD_NEON
+
+    const float32x4_t scale = vdupq_n_f32(255.0f);
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        uint8x16_t x  = vld1q_u8(srcBuf + i);
+        uint16x8_t lo = vmovl_u8(vget_low_u8(x));
+        uint16x8_t hi = vmovl_high_u8(x);
+        vst1q_f32(dstBuf + i     , vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), scale));
+        vst1q_f32(dstBuf + i +  4, vdivq_f32(vcvtq_f32_u32(vmovl_high_u16(lo)), scale));
+        vst1q_f32(dstBuf + i +  8, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), scale));
+        vst1q_f32(dstBuf + i + 12, vdivq_f32(vcvtq_f32_u32(vmovl_high_u16(hi)), scale));
+    }
+
+    #endif
+
+    for (; i < idxEnd; ++i)
+        dstBuf[i] = UInt8ToFloat32(srcBuf[i]);
+}
+
+static void ConvertFloat32ToUInt8(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const float*>(src);
+    auto dstBuf = reinterpret_cast<std::uint8_t*>(dst);
+    auto i      = idxBegin;
+
+    #if defined LLGL_SIMD_SSE2
+
+    for (; i + 16 <= idxEnd; i += 16)
+    {
+        __m128i x0 = Float32x4ToUInt8x4(_mm_loadu_ps(srcBuf + i     ));
+        __m128i x1 = Float32x4ToUInt8x4(_mm_loadu_ps(srcBuf + i +  4));
+        __m128i x2 = Float32x4ToUInt8x4(_mm_loadu_ps(srcBuf + i +  8));
+        __m128i x3 = Float32x4ToUInt8x4(_mm_loadu_ps(srcBuf + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dstBuf + i), PackLowBytes(x0, x1, x2, x3));
+    }
+
+    #elif defined LLGL_SIMD_NEON
+
+    const float64x2_t scale = vdupq_n_f64(255.0);
+    for (; i + 8 <= idxEnd; i += 8)
+    {
+        float32x4_t x0 = vld1q_f32(srcBuf + i    );
+        float32x4_t x1 = vld1q_f32(srcBuf + i + 4);
+        int32x4_t   y0 = vcombine_s32(
+            vmovn_s64(vcvtq_s64_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(x0)), scale))),
+            vmovn_s64(vcvtq_s64_f64(vmulq_f64(vcvt_high_f64_f32(x0), scale)))
+        );
+        int32x4_t   y1 = vcombine_s32(
+            vmovn_s64(vcvtq_s64_f64(vmulq_f64(vcvt_f64_f32(vget_low_f32(x1)), scale))),
+            vmovn_s64(vcvtq_s64_f64(vmulq_f64(vcvt_high_f64_f32(x1), scale)))
+        );
+        int16x8_t   y  = vcombine_s16(vmovn_s32(y0), vmovn_s32(y1));
+        vst1_u8(dstBuf + i, vmovn_u16(vreinterpretq_u16_s16(y)));
+    }
+
+    #endif
+
+    for (; i < idxEnd; ++i)
+        dstBuf[i] = Float32ToUInt8(srcBuf[i]);
+}
+
+// Number of elements that are converted through an intermediate buffer on the stack at once.
+static const std::size_t g_float16ChunkSize = 256;
+
+static void ConvertFloat16ToFloat32(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint16_t*>(src);
+    auto dstBuf = reinterpret_cast<float*>(dst);
+    DecompressFloat16Array(srcBuf + idxBegin, dstBuf + idxBegin, idxEnd - idxBegin);
+}
+
+static void ConvertFloat32ToFloat16(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const float*>(src);
+    auto dstBuf = reinterpret_cast<std::uint16_t*>(dst);
+    CompressFloat16Array(srcBuf + idxBegin, dstBuf + idxBegin, idxEnd - idxBegin);
+}
+
+static void ConvertUInt8ToFloat16(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint8_t*>(src);
+    auto dstBuf = reinterpret_cast<std::uint16_t*>(dst);
+
+    float intermediate[g_float16ChunkSize];
+    for (auto i = idxBegin; i < idxEnd; i += g_float16ChunkSize)
+    {
+        const auto count = std::min(g_float16ChunkSize, idxEnd - i);
+        ConvertUInt8ToFloat32(srcBuf + i, intermediate, 0, count);
+        CompressFloat16Array(intermediate, dstBuf + i, count);
+    }
+}
+
+static void ConvertFloat16ToUInt8(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd)
+{
+    auto srcBuf = reinterpret_cast<const std::uint16_t*>(src);
+    auto dstBuf = reinterpret_cast<std::uint8_t*>(dst);
+
+    float intermediate[g_float16ChunkSize];
+    for (auto i = idxBegin; i < idxEnd; i += g_float16ChunkSize)
+    {
+        const auto count = std::min(g_float16ChunkSize, idxEnd - i);
+        DecompressFloat16Array(srcBuf + i, intermediate, count);
+        ConvertFloat32ToUInt8(intermediate, dstBuf + i, 0, count);
+    }
+}
+
+
+/* ----- Functions ----- */
+
+DataTypeConversionKernel FindDataTypeConversionKernel(DataType srcDataType, DataType dstDataType)
+{
+    switch (srcDataType)
+    {
+        case DataType::UInt8:
+            switch (dstDataType)
+            {
+                case DataType::Float16: return ConvertUInt8ToFloat16;
+                case DataType::Float32: return ConvertUInt8ToFloat32;
+                default:                break;
+            }
+            break;
+
+        case DataType::Float16:
+            switch (dstDataType)
+            {
+                case DataType::UInt8:   return ConvertFloat16ToUInt8;
+                case DataType::Float32: return ConvertFloat16ToFloat32;
+                default:                break;
+            }
+            break;
+
+        case DataType::Float32:
+            switch (dstDataType)
+            {
+                case DataType::UInt8:   return ConvertFloat32ToUInt8;
+                case DataType::Float16: return ConvertFloat32ToFloat16;
+                default:                break;
+            }
+            break;
+
+        default:
+            break;
+    }
+    return nullptr;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
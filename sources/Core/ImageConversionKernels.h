@@ -0,0 +1,42 @@
+/*
+ * ImageConversionKernels.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_CONVERSION_KERNELS_H
+#define LLGL_IMAGE_CONVERSION_KERNELS_H
+
+
+#include <LLGL/Format.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/* ----- Types ----- */
+
+// Function pointer type of a kernel that converts all image elements in the range [idxBegin, idxEnd) from one data type to another.
+using DataTypeConversionKernel = void (*)(const void* src, void* dst, std::size_t idxBegin, std::size_t idxEnd);
+
+
+/* ----- Functions ----- */
+
+/*
+Returns the specialized conversion kernel for the specified pair of data types, or null if there is none.
+All kernels produce bit-identical results to the generic conversion via normalized double precision values.
+*/
+DataTypeConversionKernel FindDataTypeConversionKernel(DataType srcDataType, DataType dstDataType);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
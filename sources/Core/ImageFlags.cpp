@@ -16,6 +16,9 @@
 #include "../Core/Helper.h"
 #include "../Core/Assertion.h"
 #include "Float16Compressor.h"
+#include "ImageConversionKernels.h"
+#include "ImageResampler.h"
+#include "BlockCompression.h"
 
 
 namespace LLGL
@@ -170,6 +173,7 @@ static void WriteNormalizedTypedVariant(DataType dstDataType, VariantBuffer& dst
 
 // Worker thread procedure for the "ConvertImageBufferDataType" function
 static void ConvertImageBufferDataTypeWorker(
+    DataTypeConversionKernel    kernel,
     DataType                    srcDataType,
     const VariantConstBuffer&   srcBuffer,
     DataType                    dstDataType,
@@ -177,13 +181,21 @@ static void ConvertImageBufferDataTypeWorker(
     std::size_t                 idxBegin,
     std::size_t                 idxEnd)
 {
-    for (auto i = idxBegin; i < idxEnd; ++i)
+    if (kernel != nullptr)
+    {
+        /* Convert entire range with specialized kernel */
+        kernel(srcBuffer.raw, dstBuffer.raw, idxBegin, idxEnd);
+    }
+    else
     {
-        /* Read normalized variant from source buffer */
-        double value = ReadNormalizedTypedVariant(srcDataType, srcBuffer, i);
+        for (auto i = idxBegin; i < idxEnd; ++i)
+        {
+            /* Read normalized variant from source buffer */
+            double value = ReadNormalizedTypedVariant(srcDataType, srcBuffer, i);
 
-        /* Write normalized variant to destination buffer */
-        WriteNormalizedTypedVariant(dstDataType, dstBuffer, i, value);
+            /* Write normalized variant to destination buffer */
+            WriteNormalizedTypedVariant(dstDataType, dstBuffer, i, value);
+        }
     }
 }
 
@@ -197,7 +209,8 @@ static void ConvertImageBufferDataType(
     DataType    dstDataType,
     void*       dstBuffer,
     std::size_t dstBufferSize,
-    std::size_t threadCount)
+    ThreadPool* threadPool,
+    std::size_t maxChunks)
 {
     /* Validate destination buffer size */
     auto imageSize              = srcBufferSize / DataTypeSize(srcDataType);
@@ -210,45 +223,19 @@ static void ConvertImageBufferDataType(
     VariantConstBuffer src { srcBuffer };
     VariantBuffer dst { dstBuffer };
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
-
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
+    /* Select specialized conversion kernel once for the entire buffer */
+    auto kernel = FindDataTypeConversionKernel(srcDataType, dstDataType);
 
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
+    ParallelForImageRange(
+        threadPool,
+        maxChunks,
+        imageSize,
+        g_threadMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
         {
-            workers[i] = std::thread(
-                ConvertImageBufferDataTypeWorker,
-                srcDataType,
-                std::ref(src),
-                dstDataType,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
+            ConvertImageBufferDataTypeWorker(kernel, srcDataType, src, dstDataType, dst, begin, end);
         }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
-            ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, offset, offset + workSizeRemain);
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
-    }
-    else
-    {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferDataTypeWorker(srcDataType, src, dstDataType, dst, 0, imageSize);
-    }
+    );
 }
 
 static void SetVariantMinMax(DataType dataType, Variant& var, bool setMin)
@@ -460,7 +447,8 @@ static void ConvertImageBufferFormatWorker(
 static void ConvertImageBufferFormat(
     const SrcImageDescriptor&   srcImageDesc,
     const DstImageDescriptor&   dstImageDesc,
-    std::size_t                 threadCount)
+    ThreadPool*                 threadPool,
+    std::size_t                 maxChunks)
 {
     /* Get image parameters */
     auto dataTypeSize   = DataTypeSize(srcImageDesc.dataType);
@@ -481,35 +469,12 @@ static void ConvertImageBufferFormat(
     VariantConstBuffer src { srcImageDesc.data };
     VariantBuffer dst { dstImageDesc.data };
 
-    threadCount = std::min(threadCount, imageSize / g_threadMinWorkSize);
-
-    if (threadCount > 1)
-    {
-        /* Create worker threads */
-        std::vector<std::thread> workers(threadCount);
-
-        auto workSize       = imageSize / threadCount;
-        auto workSizeRemain = imageSize % threadCount;
-
-        std::size_t offset = 0;
-
-        for (std::size_t i = 0; i < threadCount; ++i)
-        {
-            workers[i] = std::thread(
-                ConvertImageBufferFormatWorker,
-                srcImageDesc.format,
-                srcImageDesc.dataType,
-                std::ref(src),
-                dstImageDesc.format,
-                std::ref(dst),
-                offset,
-                offset + workSize
-            );
-            offset += workSize;
-        }
-
-        /* Execute conversion of remaining work on main thread */
-        if (workSizeRemain > 0)
+    ParallelForImageRange(
+        threadPool,
+        maxChunks,
+        imageSize,
+        g_threadMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
         {
             ConvertImageBufferFormatWorker(
                 srcImageDesc.format,
@@ -517,28 +482,11 @@ static void ConvertImageBufferFormat(
                 src,
                 dstImageDesc.format,
                 dst,
-                offset,
-                offset + workSizeRemain
+                begin,
+                end
             );
         }
-
-        /* Join worker threads */
-        for (auto& w : workers)
-            w.join();
-    }
-    else
-    {
-        /* Execute conversion only on main thread */
-        ConvertImageBufferFormatWorker(
-            srcImageDesc.format,
-            srcImageDesc.dataType,
-            src,
-            dstImageDesc.format,
-            dst,
-            0,
-            imageSize
-        );
-    }
+    );
 }
 
 static void ValidateSourceImageDesc(const SrcImageDescriptor& imageDesc)
@@ -555,10 +503,7 @@ static void ValidateDestinationImageDesc(const DstImageDescriptor& imageDesc)
         throw std::invalid_argument("destination image data size is not a multiple of the destination data type size");
 }
 
-static void ValidateImageConversionParams(
-    const SrcImageDescriptor&   srcImageDesc,
-    ImageFormat                 dstFormat,
-    DataType                    dstDataType)
+static void ValidateImageConversionParams(const SrcImageDescriptor& srcImageDesc, ImageFormat dstFormat)
 {
     if (IsCompressedFormat(srcImageDesc.format) || IsCompressedFormat(dstFormat))
         throw std::invalid_argument("cannot convert compressed image formats");
@@ -566,21 +511,16 @@ static void ValidateImageConversionParams(
         throw std::invalid_argument("cannot convert depth-stencil image formats");
 }
 
-
-/* ----- Public functions ----- */
-
-LLGL_EXPORT bool ConvertImageBuffer(
+static bool ConvertImageBufferWithThreadPool(
     const SrcImageDescriptor&   srcImageDesc,
     const DstImageDescriptor&   dstImageDesc,
-    std::size_t                 threadCount)
+    ThreadPool*                 threadPool,
+    std::size_t                 maxChunks)
 {
     /* Validate input parameters */
+    ValidateImageConversionParams(srcImageDesc, dstImageDesc.format);
     ValidateSourceImageDesc(srcImageDesc);
     ValidateDestinationImageDesc(dstImageDesc);
-    ValidateImageConversionParams(srcImageDesc, dstImageDesc.format, dstImageDesc.dataType);
-
-    if (threadCount >= Constants::maxThreadCount)
-        threadCount = std::thread::hardware_concurrency();
 
     if (srcImageDesc.dataType != dstImageDesc.dataType && srcImageDesc.format != dstImageDesc.format)
     {
@@ -595,7 +535,8 @@ LLGL_EXPORT bool ConvertImageBuffer(
             dstImageDesc.dataType,
             intermediateBuffer.get(),
             intermediateBufferSize,
-            threadCount
+            threadPool,
+            maxChunks
         );
 
         /* Set new source buffer and source data type */
@@ -608,7 +549,7 @@ LLGL_EXPORT bool ConvertImageBuffer(
         };
 
         /* Convert image format */
-        ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
+        ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadPool, maxChunks);
 
         return true;
     }
@@ -622,32 +563,31 @@ LLGL_EXPORT bool ConvertImageBuffer(
             dstImageDesc.dataType,
             dstImageDesc.data,
             dstImageDesc.dataSize,
-            threadCount
+            threadPool,
+            maxChunks
         );
         return true;
     }
     else if (srcImageDesc.format != dstImageDesc.format)
     {
         /* Convert image format */
-        ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadCount);
+        ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadPool, maxChunks);
         return true;
     }
 
     return false;
 }
 
-LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+static ByteBuffer ConvertImageBufferWithThreadPool(
     const SrcImageDescriptor&   srcImageDesc,
     ImageFormat                 dstFormat,
     DataType                    dstDataType,
-    std::size_t                 threadCount)
+    ThreadPool*                 threadPool,
+    std::size_t                 maxChunks)
 {
     /* Validate input parameters */
+    ValidateImageConversionParams(srcImageDesc, dstFormat);
     ValidateSourceImageDesc(srcImageDesc);
-    ValidateImageConversionParams(srcImageDesc, dstFormat, dstDataType);
-
-    if (threadCount >= Constants::maxThreadCount)
-        threadCount = std::thread::hardware_concurrency();
 
     /* Initialize destination image descriptor */
     auto srcNumPixels = srcImageDesc.dataSize / (DataTypeSize(srcImageDesc.dataType) * ImageFormatSize(srcImageDesc.format));
@@ -675,7 +615,8 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
                 dstDataType,
                 intermediateBuffer.get(),
                 intermediateBufferSize,
-                threadCount
+                threadPool,
+                maxChunks
             );
 
             /* Set new source buffer and source data type */
@@ -689,7 +630,7 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
 
             /* Convert image format */
             dstImageDesc.data = dstImage.get();
-            ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadCount);
+            ConvertImageBufferFormat(intermediateImageDesc, dstImageDesc, threadPool, maxChunks);
         }
         return dstImage;
     }
@@ -706,7 +647,8 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
                 dstDataType,
                 dstImageDesc.data,
                 dstImageDesc.dataSize,
-                threadCount
+                threadPool,
+                maxChunks
             );
         }
         return dstImage;
@@ -717,7 +659,7 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
         auto dstImage = MakeUniqueArray<char>(dstImageDesc.dataSize);
         {
             dstImageDesc.data = dstImage.get();
-            ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadCount);
+            ConvertImageBufferFormat(srcImageDesc, dstImageDesc, threadPool, maxChunks);
         }
         return dstImage;
     }
@@ -725,6 +667,439 @@ LLGL_EXPORT ByteBuffer ConvertImageBuffer(
     return nullptr;
 }
 
+
+/* ----- Public functions ----- */
+
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    std::size_t                 threadCount)
+{
+    auto threadPool = GetThreadPoolForThreadCount(threadCount);
+    return ConvertImageBufferWithThreadPool(srcImageDesc, dstImageDesc, threadPool, threadCount);
+}
+
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    ThreadPool&                 threadPool)
+{
+    return ConvertImageBufferWithThreadPool(srcImageDesc, dstImageDesc, &threadPool, GetMaxChunksForThreadPool(threadPool));
+}
+
+LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    std::size_t                 threadCount)
+{
+    auto threadPool = GetThreadPoolForThreadCount(threadCount);
+    return ConvertImageBufferWithThreadPool(srcImageDesc, dstFormat, dstDataType, threadPool, threadCount);
+}
+
+LLGL_EXPORT ByteBuffer ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    ImageFormat                 dstFormat,
+    DataType                    dstDataType,
+    ThreadPool&                 threadPool)
+{
+    return ConvertImageBufferWithThreadPool(srcImageDesc, dstFormat, dstDataType, &threadPool, GetMaxChunksForThreadPool(threadPool));
+}
+
+LLGL_EXPORT std::size_t GetImageBufferSize(ImageFormat format, DataType dataType, const Extent3D& extent)
+{
+    if (IsCompressedFormat(format))
+    {
+        const auto numBlocksX = (static_cast<std::size_t>(extent.width ) + 3) / 4;
+        const auto numBlocksY = (static_cast<std::size_t>(extent.height) + 3) / 4;
+        return (numBlocksX * numBlocksY * extent.depth * GetCompressedBlockSize(format));
+    }
+    return GetMemoryFootprint(format, dataType, extent.width * extent.height * extent.depth);
+}
+
+static void ValidateCompressedImageConversionParams(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent)
+{
+    if (IsDepthStencilFormat(srcImageDesc.format) || IsDepthStencilFormat(dstImageDesc.format))
+        throw std::invalid_argument("cannot convert depth-stencil image formats");
+    if (IsCompressedFormat(srcImageDesc.format) && !IsCompressedImageDataTypeValid(srcImageDesc.format, srcImageDesc.dataType))
+        throw std::invalid_argument("invalid data type for compressed source image format");
+    if (IsCompressedFormat(dstImageDesc.format) && !IsCompressedImageDataTypeValid(dstImageDesc.format, dstImageDesc.dataType))
+        throw std::invalid_argument("invalid data type for compressed destination image format");
+
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+    LLGL_ASSERT_PTR(dstImageDesc.data);
+
+    if (srcImageDesc.dataSize < GetImageBufferSize(srcImageDesc.format, srcImageDesc.dataType, extent))
+        throw std::invalid_argument("source image data size is too small for the specified extent");
+    if (dstImageDesc.dataSize < GetImageBufferSize(dstImageDesc.format, dstImageDesc.dataType, extent))
+        throw std::invalid_argument("destination image data size is too small for the specified extent");
+}
+
+static bool ConvertCompressedImageBufferWithThreadPool(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    BlockCompressionQuality     quality,
+    ThreadPool*                 threadPool,
+    std::size_t                 maxChunks)
+{
+    /* Ignore empty images and images that need no conversion */
+    if (extent.width == 0 || extent.height == 0 || extent.depth == 0)
+        return false;
+    if (srcImageDesc.format == dstImageDesc.format && srcImageDesc.dataType == dstImageDesc.dataType)
+        return false;
+
+    ValidateCompressedImageConversionParams(srcImageDesc, dstImageDesc, extent);
+
+    /* Uncompressed buffers are converted with the exact size of the image extent */
+    SrcImageDescriptor uncompressedImageDesc
+    {
+        srcImageDesc.format,
+        srcImageDesc.dataType,
+        srcImageDesc.data,
+        GetImageBufferSize(srcImageDesc.format, srcImageDesc.dataType, extent)
+    };
+
+    const DstImageDescriptor dstExtentImageDesc
+    {
+        dstImageDesc.format,
+        dstImageDesc.dataType,
+        dstImageDesc.data,
+        GetImageBufferSize(dstImageDesc.format, dstImageDesc.dataType, extent)
+    };
+
+    ByteBuffer decompressedBuffer;
+
+    if (IsCompressedFormat(srcImageDesc.format))
+    {
+        const auto decompressedFormat = GetDecompressedImageFormat(srcImageDesc.format);
+        if (dstImageDesc.format == decompressedFormat && dstImageDesc.dataType == srcImageDesc.dataType)
+        {
+            /* Decompress source image directly into destination buffer */
+            DecompressImageBlocks(srcImageDesc.format, srcImageDesc.dataType, srcImageDesc.data, extent, dstImageDesc.data, threadPool, maxChunks);
+            return true;
+        }
+
+        /* Decompress source image into intermediate buffer */
+        const auto decompressedSize = GetImageBufferSize(decompressedFormat, srcImageDesc.dataType, extent);
+        decompressedBuffer = AllocateByteBuffer(decompressedSize, UninitializeTag{});
+        DecompressImageBlocks(srcImageDesc.format, srcImageDesc.dataType, srcImageDesc.data, extent, decompressedBuffer.get(), threadPool, maxChunks);
+
+        uncompressedImageDesc = SrcImageDescriptor{ decompressedFormat, srcImageDesc.dataType, decompressedBuffer.get(), decompressedSize };
+    }
+
+    if (!IsCompressedFormat(dstImageDesc.format))
+    {
+        /* Convert decompressed image into destination format */
+        ConvertImageBufferWithThreadPool(uncompressedImageDesc, dstExtentImageDesc, threadPool, maxChunks);
+        return true;
+    }
+
+    /* Convert source image into the format that is encoded by the destination format */
+    const auto encodedFormat = GetDecompressedImageFormat(dstImageDesc.format);
+
+    ByteBuffer encodedBuffer;
+    if (uncompressedImageDesc.format != encodedFormat || uncompressedImageDesc.dataType != dstImageDesc.dataType)
+    {
+        const auto encodedSize = GetImageBufferSize(encodedFormat, dstImageDesc.dataType, extent);
+        encodedBuffer = AllocateByteBuffer(encodedSize, UninitializeTag{});
+
+        const DstImageDescriptor encodedImageDesc{ encodedFormat, dstImageDesc.dataType, encodedBuffer.get(), encodedSize };
+        ConvertImageBufferWithThreadPool(uncompressedImageDesc, encodedImageDesc, threadPool, maxChunks);
+
+        uncompressedImageDesc = SrcImageDescriptor{ encodedFormat, dstImageDesc.dataType, encodedBuffer.get(), encodedSize };
+    }
+
+    /* Compress image into destination buffer */
+    CompressImageBlocks(dstImageDesc.format, dstImageDesc.dataType, uncompressedImageDesc.data, extent, dstImageDesc.data, quality, threadPool, maxChunks);
+
+    return true;
+}
+
+static bool ConvertImageBufferWithExtent(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    ThreadPool*                 threadPool,
+    std::size_t                 maxChunks)
+{
+    if (IsCompressedFormat(srcImageDesc.format) || IsCompressedFormat(dstImageDesc.format))
+        return ConvertCompressedImageBufferWithThreadPool(srcImageDesc, dstImageDesc, extent, BlockCompressionQuality::Fast, threadPool, maxChunks);
+    else
+        return ConvertImageBufferWithThreadPool(srcImageDesc, dstImageDesc, threadPool, maxChunks);
+}
+
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    std::size_t                 threadCount)
+{
+    auto threadPool = GetThreadPoolForThreadCount(threadCount);
+    return ConvertImageBufferWithExtent(srcImageDesc, dstImageDesc, extent, threadPool, threadCount);
+}
+
+LLGL_EXPORT bool ConvertImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             extent,
+    ThreadPool&                 threadPool)
+{
+    return ConvertImageBufferWithExtent(srcImageDesc, dstImageDesc, extent, &threadPool, GetMaxChunksForThreadPool(threadPool));
+}
+
+static void CompressImageBufferWithThreadPool(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    const DstImageDescriptor&   dstImageDesc,
+    BlockCompressionQuality     quality,
+    ThreadPool*                 threadPool,
+    std::size_t                 maxChunks)
+{
+    if (!IsCompressedFormat(dstImageDesc.format))
+        throw std::invalid_argument("cannot compress image into uncompressed destination image format");
+
+    if (srcImageDesc.format == dstImageDesc.format && srcImageDesc.dataType == dstImageDesc.dataType)
+    {
+        /* Copy blocks that are already in the destination format */
+        if (extent.width > 0 && extent.height > 0 && extent.depth > 0)
+        {
+            ValidateCompressedImageConversionParams(srcImageDesc, dstImageDesc, extent);
+            ::memcpy(dstImageDesc.data, srcImageDesc.data, GetImageBufferSize(dstImageDesc.format, dstImageDesc.dataType, extent));
+        }
+    }
+    else
+        ConvertCompressedImageBufferWithThreadPool(srcImageDesc, dstImageDesc, extent, quality, threadPool, maxChunks);
+}
+
+LLGL_EXPORT void CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    const DstImageDescriptor&   dstImageDesc,
+    BlockCompressionQuality     quality,
+    std::size_t                 threadCount)
+{
+    auto threadPool = GetThreadPoolForThreadCount(threadCount);
+    CompressImageBufferWithThreadPool(srcImageDesc, extent, dstImageDesc, quality, threadPool, threadCount);
+}
+
+LLGL_EXPORT void CompressImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             extent,
+    const DstImageDescriptor&   dstImageDesc,
+    BlockCompressionQuality     quality,
+    ThreadPool&                 threadPool)
+{
+    CompressImageBufferWithThreadPool(srcImageDesc, extent, dstImageDesc, quality, &threadPool, GetMaxChunksForThreadPool(threadPool));
+}
+
+static void ValidateImageResampleParams(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResampleFilter              filter)
+{
+    if (IsCompressedFormat(srcImageDesc.format) || IsCompressedFormat(dstImageDesc.format))
+        throw std::invalid_argument("cannot resample compressed image formats");
+    if (srcImageDesc.format != dstImageDesc.format || srcImageDesc.dataType != dstImageDesc.dataType)
+        throw std::invalid_argument("cannot resample image with mismatch between source and destination format or data type");
+    if (srcImageDesc.format == ImageFormat::DepthStencil && filter != ResampleFilter::Nearest)
+        throw std::invalid_argument("cannot resample depth-stencil image with a filter other than nearest neighbor sampling");
+
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+    LLGL_ASSERT_PTR(dstImageDesc.data);
+
+    if (srcImageDesc.dataSize < GetMemoryFootprint(srcImageDesc.format, srcImageDesc.dataType, srcExtent.width * srcExtent.height * srcExtent.depth))
+        throw std::invalid_argument("source image data size is too small for the specified extent");
+    if (dstImageDesc.dataSize < GetMemoryFootprint(dstImageDesc.format, dstImageDesc.dataType, dstExtent.width * dstExtent.height * dstExtent.depth))
+        throw std::invalid_argument("destination image data size is too small for the specified extent");
+}
+
+static void ResampleImageBufferWithThreadPool(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResampleFilter              filter,
+    ThreadPool*                 threadPool,
+    std::size_t                 maxChunks)
+{
+    /* Ignore empty images */
+    if (srcExtent.width == 0 || srcExtent.height == 0 || srcExtent.depth == 0 ||
+        dstExtent.width == 0 || dstExtent.height == 0 || dstExtent.depth == 0)
+    {
+        return;
+    }
+
+    ValidateImageResampleParams(srcImageDesc, srcExtent, dstImageDesc, dstExtent, filter);
+    ResampleImage(srcImageDesc, srcExtent, dstImageDesc, dstExtent, filter, false, threadPool, maxChunks);
+}
+
+LLGL_EXPORT void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResampleFilter              filter,
+    std::size_t                 threadCount)
+{
+    auto threadPool = GetThreadPoolForThreadCount(threadCount);
+    ResampleImageBufferWithThreadPool(srcImageDesc, srcExtent, dstImageDesc, dstExtent, filter, threadPool, threadCount);
+}
+
+LLGL_EXPORT void ResampleImageBuffer(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResampleFilter              filter,
+    ThreadPool&                 threadPool)
+{
+    ResampleImageBufferWithThreadPool(srcImageDesc, srcExtent, dstImageDesc, dstExtent, filter, &threadPool, GetMaxChunksForThreadPool(threadPool));
+}
+
+// Returns the number of MIP-map levels that are generated for the specified base extent
+static std::uint32_t GetMipChainNumLevels(const Extent3D& extent, const MipGenerationDescriptor& mipGenDesc)
+{
+    if (extent.width == 0 || extent.height == 0 || extent.depth == 0)
+        return 0;
+
+    /* Only reduce the texture dimensions, array layers are stored in the image dimension after the last texture dimension */
+    const auto numDims      = NumTextureDimensions(mipGenDesc.type);
+    const auto numLevels    = NumMipLevels(
+        extent.width,
+        (numDims >= 2 ? extent.height : 1u),
+        (numDims >= 3 ? extent.depth  : 1u)
+    );
+
+    if (mipGenDesc.numMipLevels == 0)
+        return numLevels;
+    else
+        return std::min(mipGenDesc.numMipLevels, numLevels);
+}
+
+// Returns the extent (including array layers) of the specified MIP-map level
+static Extent3D GetMipChainLevelExtent(const Extent3D& extent, const MipGenerationDescriptor& mipGenDesc, std::uint32_t mipLevel)
+{
+    const auto numDims = NumTextureDimensions(mipGenDesc.type);
+    return Extent3D
+    {
+        std::max(1u, extent.width >> mipLevel),
+        (numDims >= 2 ? std::max(1u, extent.height >> mipLevel) : extent.height),
+        (numDims >= 3 ? std::max(1u, extent.depth  >> mipLevel) : extent.depth ),
+    };
+}
+
+static std::size_t GetMipChainLevelSize(ImageFormat format, DataType dataType, const Extent3D& extent)
+{
+    return GetMemoryFootprint(format, dataType, extent.width * extent.height * extent.depth);
+}
+
+LLGL_EXPORT std::size_t GetMipChainSize(
+    ImageFormat                     format,
+    DataType                        dataType,
+    const Extent3D&                 extent,
+    const MipGenerationDescriptor&  mipGenDesc)
+{
+    if (IsCompressedFormat(format) || IsMultiSampleTexture(mipGenDesc.type))
+        return 0;
+
+    std::size_t dataSize = 0;
+
+    const auto numLevels = GetMipChainNumLevels(extent, mipGenDesc);
+    for (std::uint32_t mipLevel = 0; mipLevel < numLevels; ++mipLevel)
+        dataSize += GetMipChainLevelSize(format, dataType, GetMipChainLevelExtent(extent, mipGenDesc, mipLevel));
+
+    return dataSize;
+}
+
+static void GenerateMipChainWithThreadPool(
+    const SrcImageDescriptor&       srcImageDesc,
+    const Extent3D&                 extent,
+    const DstImageDescriptor&       dstImageDesc,
+    const MipGenerationDescriptor&  mipGenDesc,
+    ThreadPool*                     threadPool,
+    std::size_t                     maxChunks)
+{
+    /* Validate input parameters */
+    if (IsCompressedFormat(srcImageDesc.format) || IsCompressedFormat(dstImageDesc.format))
+        throw std::invalid_argument("cannot generate MIP-map chain for compressed image formats");
+    if (IsMultiSampleTexture(mipGenDesc.type))
+        throw std::invalid_argument("cannot generate MIP-map chain for multi-sampled texture type");
+    if (srcImageDesc.format != dstImageDesc.format || srcImageDesc.dataType != dstImageDesc.dataType)
+        throw std::invalid_argument("cannot generate MIP-map chain with mismatch between source and destination format or data type");
+    if (srcImageDesc.format == ImageFormat::DepthStencil && mipGenDesc.filter != ResampleFilter::Nearest)
+        throw std::invalid_argument("cannot generate MIP-map chain for depth-stencil image with a filter other than nearest neighbor sampling");
+
+    /* Ignore empty images */
+    const auto numLevels = GetMipChainNumLevels(extent, mipGenDesc);
+    if (numLevels == 0)
+        return;
+
+    LLGL_ASSERT_PTR(srcImageDesc.data);
+    LLGL_ASSERT_PTR(dstImageDesc.data);
+
+    const auto format   = srcImageDesc.format;
+    const auto dataType = srcImageDesc.dataType;
+
+    auto baseLevelSize = GetMipChainLevelSize(format, dataType, extent);
+    if (srcImageDesc.dataSize < baseLevelSize)
+        throw std::invalid_argument("source image data size is too small for the specified extent");
+    if (dstImageDesc.dataSize < GetMipChainSize(format, dataType, extent, mipGenDesc))
+        throw std::invalid_argument("destination image data size is too small for the MIP-map chain");
+
+    /* Copy base level into destination buffer */
+    auto dst = reinterpret_cast<char*>(dstImageDesc.data);
+    ::memcpy(dst, srcImageDesc.data, baseLevelSize);
+
+    /*
+    Resample each MIP-map level from the previous one; the levels must be generated in order,
+    so only the rows and array layers within each level are distributed over the worker threads
+    */
+    SrcImageDescriptor prevLevelDesc{ format, dataType, dst, baseLevelSize };
+    Extent3D prevLevelExtent = extent;
+    dst += baseLevelSize;
+
+    for (std::uint32_t mipLevel = 1; mipLevel < numLevels; ++mipLevel)
+    {
+        const auto levelExtent  = GetMipChainLevelExtent(extent, mipGenDesc, mipLevel);
+        const auto levelSize    = GetMipChainLevelSize(format, dataType, levelExtent);
+
+        DstImageDescriptor levelDesc{ format, dataType, dst, levelSize };
+        ResampleImage(prevLevelDesc, prevLevelExtent, levelDesc, levelExtent, mipGenDesc.filter, mipGenDesc.sRGB, threadPool, maxChunks);
+
+        prevLevelDesc.data      = dst;
+        prevLevelDesc.dataSize  = levelSize;
+        prevLevelExtent         = levelExtent;
+        dst += levelSize;
+    }
+}
+
+LLGL_EXPORT void GenerateMipChain(
+    const SrcImageDescriptor&       srcImageDesc,
+    const Extent3D&                 extent,
+    const DstImageDescriptor&       dstImageDesc,
+    const MipGenerationDescriptor&  mipGenDesc,
+    std::size_t                     threadCount)
+{
+    auto threadPool = GetThreadPoolForThreadCount(threadCount);
+    GenerateMipChainWithThreadPool(srcImageDesc, extent, dstImageDesc, mipGenDesc, threadPool, threadCount);
+}
+
+LLGL_EXPORT void GenerateMipChain(
+    const SrcImageDescriptor&       srcImageDesc,
+    const Extent3D&                 extent,
+    const DstImageDescriptor&       dstImageDesc,
+    const MipGenerationDescriptor&  mipGenDesc,
+    ThreadPool&                     threadPool)
+{
+    GenerateMipChainWithThreadPool(srcImageDesc, extent, dstImageDesc, mipGenDesc, &threadPool, GetMaxChunksForThreadPool(threadPool));
+}
+
 // Returns the 1D flattened buffer position for a 3D image coordinate ('bpp' denotes the bytes per pixel)
 static std::size_t GetFlattenedImageBufferPos(
     std::uint32_t x,
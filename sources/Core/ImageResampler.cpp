@@ -0,0 +1,872 @@
+/*
+ * ImageResampler.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ImageResampler.h"
+#include "ImageUtils.h"
+#include "ImageConversionKernels.h"
+#include "Float16Compressor.h"
+#include "Helper.h"
+#include "SIMDMacros.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+/* ----- Internal structures ----- */
+
+/*
+Filter taps of a single axis: each destination coordinate has 'numTaps' normalized weights for a contiguous window of source pixels,
+that begins at the respective entry in 'firsts'. Windows are always inside the source image; weights outside the image are folded into the edge pixels.
+*/
+struct ResampleAxis
+{
+    std::uint32_t               srcSize = 0;
+    std::uint32_t               dstSize = 0;
+    std::uint32_t               numTaps = 0;
+    std::vector<std::uint32_t>  firsts;
+    std::vector<float>          weights;
+};
+
+
+// Attributes to convert image data from and to 32-bit floats.
+struct FloatConversion
+{
+    DataType                    dataType        = DataType::Undefined;
+    DataTypeConversionKernel    readKernel      = nullptr;
+    std::uint32_t               numComponents   = 0;
+    std::uint32_t               sRGBMask        = 0; // Bit mask of all components in non-linear sRGB color space
+};
+
+// Lookup tables for the sRGB transfer functions of 8-bit normalized values.
+struct SRGBTables8
+{
+    SRGBTables8();
+
+    float decode[256];      // Linear values for all 8-bit sRGB values
+    float thresholds[255];  // Linear values half way between two 8-bit sRGB values
+};
+
+
+/* ----- Internal constants ----- */
+
+// Number of floats per row segment in the vertical passes, so the segments of all filter taps stay in the cache
+static const std::size_t g_resampleTileSize     = 1024;
+
+// Minimal number of multiply-add operations each chunk of a parallel pass shall process
+static const std::size_t g_resampleMinWorkSize  = 16384;
+
+// Radius of the Lanczos filter kernel (in source pixels before minification scaling)
+static const double      g_lanczosRadius        = 3.0;
+
+
+/* ----- Filter functions ----- */
+
+static double Sinc(double x)
+{
+    if (std::abs(x) < 1.0e-8)
+        return 1.0;
+    x *= 3.14159265358979323846;
+    return std::sin(x) / x;
+}
+
+static double GetFilterRadius(ResampleFilter filter)
+{
+    switch (filter)
+    {
+        case ResampleFilter::Nearest:   return 0.5;
+        case ResampleFilter::Linear:    return 1.0;
+        case ResampleFilter::Box:       return 0.5;
+        case ResampleFilter::Lanczos:   return g_lanczosRadius;
+    }
+    return 0.5;
+}
+
+// Returns the weight of a source pixel at distance 'x' (in filter space) to the sample position.
+static double EvalFilter(ResampleFilter filter, double x)
+{
+    x = std::abs(x);
+    switch (filter)
+    {
+        case ResampleFilter::Nearest:
+        case ResampleFilter::Box:
+            return (x <= 0.5 ? 1.0 : 0.0);
+        case ResampleFilter::Linear:
+            return std::max(0.0, 1.0 - x);
+        case ResampleFilter::Lanczos:
+            return (x < g_lanczosRadius ? Sinc(x) * Sinc(x / g_lanczosRadius) : 0.0);
+    }
+    return 0.0;
+}
+
+// Returns the length of the overlap between the intervals [a0, a1) and [b0, b1).
+static double GetIntervalOverlap(double a0, double a1, double b0, double b1)
+{
+    return std::max(0.0, std::min(a1, b1) - std::max(a0, b0));
+}
+
+static void BuildResampleAxis(ResampleAxis& axis, std::uint32_t srcSize, std::uint32_t dstSize, ResampleFilter filter)
+{
+    /* Widen filter by the scaling factor for minification to avoid aliasing */
+    const double scale          = static_cast<double>(srcSize) / static_cast<double>(dstSize);
+    const double filterScale    = std::max(1.0, scale);
+    const double support        = GetFilterRadius(filter) * filterScale;
+
+    /* Get number of taps that covers the filter support, but at most the entire source axis */
+    const auto numFilterTaps = (filter == ResampleFilter::Nearest ? 1u : static_cast<std::uint32_t>(std::ceil(support * 2.0)) + 1u);
+
+    axis.srcSize = srcSize;
+    axis.dstSize = dstSize;
+    axis.numTaps = std::min(numFilterTaps, srcSize);
+    axis.firsts.resize(dstSize);
+    axis.weights.resize(static_cast<std::size_t>(axis.numTaps) * dstSize);
+
+    const auto maxIndex = static_cast<std::int64_t>(srcSize) - 1;
+    const auto maxFirst = static_cast<std::int64_t>(srcSize - axis.numTaps);
+
+    for (std::uint32_t i = 0; i < dstSize; ++i)
+    {
+        auto weights = &(axis.weights[i * axis.numTaps]);
+        std::fill(weights, weights + axis.numTaps, 0.0f);
+
+        /* Get sample position in source image with pixel edges at integral coordinates */
+        const double center = (static_cast<double>(i) + 0.5) * scale;
+
+        if (filter == ResampleFilter::Nearest)
+        {
+            axis.firsts[i]  = static_cast<std::uint32_t>(std::min(static_cast<std::int64_t>(center), maxIndex));
+            weights[0]      = 1.0f;
+            continue;
+        }
+
+        /* Move window of taps inside the source image */
+        const auto filterFirst  = static_cast<std::int64_t>(std::floor(center - support));
+        const auto first        = std::max<std::int64_t>(0, std::min(filterFirst, maxFirst));
+        axis.firsts[i] = static_cast<std::uint32_t>(first);
+
+        /* Accumulate weights of all source pixels within the filter support; pixels outside the image are clamped to the edge */
+        double weightSum = 0.0;
+        for (std::uint32_t t = 0; t < numFilterTaps; ++t)
+        {
+            const auto j = filterFirst + t;
+
+            double weight = 0.0;
+            if (filter == ResampleFilter::Box)
+                weight = GetIntervalOverlap(static_cast<double>(j), static_cast<double>(j + 1), center - support, center + support);
+            else
+                weight = EvalFilter(filter, (static_cast<double>(j) + 0.5 - center) / filterScale);
+
+            const auto tap = std::max<std::int64_t>(0, std::min(j, maxIndex)) - first;
+            weights[tap] += static_cast<float>(weight);
+            weightSum += weight;
+        }
+
+        /* Normalize weights so that constant colors are preserved */
+        if (weightSum != 0.0)
+        {
+            for (std::uint32_t t = 0; t < axis.numTaps; ++t)
+                weights[t] = static_cast<float>(weights[t] / weightSum);
+        }
+        else
+        {
+            std::fill(weights, weights + axis.numTaps, 0.0f);
+            weights[std::min(static_cast<std::int64_t>(center), maxIndex) - first] = 1.0f;
+        }
+    }
+}
+
+// Returns the minimal number of items per chunk for the specified amount of work per item.
+static std::size_t GetMinChunkSize(std::size_t workPerItem)
+{
+    return std::max<std::size_t>(1, g_resampleMinWorkSize / std::max<std::size_t>(1, workPerItem));
+}
+
+
+/* ----- SIMD kernels ----- */
+
+/*
+Multiplication and addition are never fused, so all instruction sets produce bit-identical results to the scalar code.
+*/
+
+// Computes 'dst[i] = src[i] * weight' for all elements in the range [0, count).
+static void MultiplyLine(float* dst, const float* src, float weight, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SIMD_AVX2
+    const __m256 w8 = _mm256_set1_ps(weight);
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_loadu_ps(src + i), w8));
+    #endif
+
+    #if defined LLGL_SIMD_SSE2
+    const __m128 w4 = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(src + i), w4));
+    #elif defined LLGL_SIMD_NEON
+    const float32x4_t w4 = vdupq_n_f32(weight);
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vmulq_f32(vld1q_f32(src + i), w4));
+    #endif
+
+    for (; i < count; ++i)
+        dst[i] = src[i] * weight;
+}
+
+// Computes 'dst[i] += src[i] * weight' for all elements in the range [0, count).
+static void MultiplyAddLine(float* dst, const float* src, float weight, std::size_t count)
+{
+    std::size_t i = 0;
+
+    #if defined LLGL_SIMD_AVX2
+    const __m256 w8 = _mm256_set1_ps(weight);
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), w8)));
+    #endif
+
+    #if defined LLGL_SIMD_SSE2
+    const __m128 w4 = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), w4)));
+    #elif defined LLGL_SIMD_NEON
+    const float32x4_t w4 = vdupq_n_f32(weight);
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vmulq_f32(vld1q_f32(src + i), w4)));
+    #endif
+
+    for (; i < count; ++i)
+        dst[i] += src[i] * weight;
+}
+
+// Computes the weighted sum of 'numTaps' contiguous RGBA pixels.
+static void WeightedSumRGBA(float* dst, const float* src, const float* weights, std::uint32_t numTaps)
+{
+    #if defined LLGL_SIMD_SSE2
+
+    __m128 sum = _mm_setzero_ps();
+    for (std::uint32_t t = 0; t < numTaps; ++t, src += 4)
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[t]), _mm_loadu_ps(src)));
+    _mm_storeu_ps(dst, sum);
+
+    #elif defined LLGL_SIMD_NEON
+
+    float32x4_t sum = vdupq_n_f32(0.0f);
+    for (std::uint32_t t = 0; t < numTaps; ++t, src += 4)
+        sum = vaddq_f32(sum, vmulq_f32(vdupq_n_f32(weights[t]), vld1q_f32(src)));
+    vst1q_f32(dst, sum);
+
+    #else
+
+    float sum[4] = {};
+    for (std::uint32_t t = 0; t < numTaps; ++t, src += 4)
+    {
+        for (std::uint32_t c = 0; c < 4; ++c)
+            sum[c] += weights[t] * src[c];
+    }
+    for (std::uint32_t c = 0; c < 4; ++c)
+        dst[c] = sum[c];
+
+    #endif
+}
+
+
+/* ----- sRGB color space ----- */
+
+static float DecodeSRGB(float value)
+{
+    if (value <= 0.04045f)
+        return value / 12.92f;
+    else
+        return std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float EncodeSRGB(float value)
+{
+    if (value <= 0.0031308f)
+        return value * 12.92f;
+    else
+        return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+SRGBTables8::SRGBTables8()
+{
+    for (int i = 0; i < 256; ++i)
+        decode[i] = DecodeSRGB(static_cast<float>(i) / 255.0f);
+    for (int i = 0; i < 255; ++i)
+        thresholds[i] = DecodeSRGB((static_cast<float>(i) + 0.5f) / 255.0f);
+}
+
+static const SRGBTables8& GetSRGBTables8()
+{
+    static const SRGBTables8 tables;
+    return tables;
+}
+
+// Returns the bit mask of all color components of the specified format that are affected by the sRGB transfer function, i.e. all except alpha.
+static std::uint32_t GetSRGBComponentMask(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::R:    return 0x1;
+        case ImageFormat::RG:   return 0x3;
+        case ImageFormat::RGB:
+        case ImageFormat::BGR:
+        case ImageFormat::RGBA:
+        case ImageFormat::BGRA: return 0x7;
+        case ImageFormat::ARGB:
+        case ImageFormat::ABGR: return 0xE;
+        default:                return 0x0;
+    }
+}
+
+// Converts all sRGB components in the range [begin, end) into linear color space in place.
+static void LinearizeRange(const FloatConversion& conv, float* data, std::size_t begin, std::size_t end)
+{
+    if (conv.dataType == DataType::UInt8)
+    {
+        /* Decode 8-bit values with lookup table */
+        const auto& tables = GetSRGBTables8();
+        for (auto i = begin; i < end; ++i)
+        {
+            if ((conv.sRGBMask & (1u << (i % conv.numComponents))) != 0)
+                data[i] = tables.decode[static_cast<int>(data[i] * 255.0f + 0.5f)];
+        }
+    }
+    else
+    {
+        for (auto i = begin; i < end; ++i)
+        {
+            if ((conv.sRGBMask & (1u << (i % conv.numComponents))) != 0)
+                data[i] = DecodeSRGB(std::max(0.0f, std::min(data[i], 1.0f)));
+        }
+    }
+}
+
+// Writes all elements in the range [begin, end) to 8-bit normalized values and encodes the sRGB components with a binary search in the lookup table.
+static void WriteSRGB8Range(const FloatConversion& conv, const float* src, std::uint8_t* dst, std::size_t begin, std::size_t end)
+{
+    const auto& tables = GetSRGBTables8();
+    for (auto i = begin; i < end; ++i)
+    {
+        if ((conv.sRGBMask & (1u << (i % conv.numComponents))) != 0)
+            dst[i] = static_cast<std::uint8_t>(std::upper_bound(tables.thresholds, tables.thresholds + 255, src[i]) - tables.thresholds);
+        else
+            dst[i] = static_cast<std::uint8_t>(std::max(0.0f, std::min(src[i], 1.0f)) * 255.0f + 0.5f);
+    }
+}
+
+
+/* ----- Data type conversion ----- */
+
+// Reads the specified values and maps them from their numeric limits to the range [0, 1], equivalent to ConvertImageBuffer.
+template <typename T>
+void ReadNormalizedRange(const T* src, float* dst, std::size_t begin, std::size_t end)
+{
+    const auto min = static_cast<double>(std::numeric_limits<T>::min());
+    const auto max = static_cast<double>(std::numeric_limits<T>::max());
+    for (auto i = begin; i < end; ++i)
+        dst[i] = static_cast<float>((static_cast<double>(src[i]) - min) / (max - min));
+}
+
+// Writes the specified values from the range [0, 1] into their numeric limits. Unlike ConvertImageBuffer, the values are clamped and rounded to nearest.
+template <typename T>
+void WriteNormalizedRange(const float* src, T* dst, std::size_t begin, std::size_t end)
+{
+    const auto min = static_cast<double>(std::numeric_limits<T>::min());
+    const auto max = static_cast<double>(std::numeric_limits<T>::max());
+    for (auto i = begin; i < end; ++i)
+    {
+        const auto value = std::max(0.0, std::min(static_cast<double>(src[i]), 1.0));
+        dst[i] = static_cast<T>(std::floor(value * (max - min) + min + 0.5));
+    }
+}
+
+static void ReadFloatRange(DataType dataType, const void* src, float* dst, std::size_t begin, std::size_t end)
+{
+    switch (dataType)
+    {
+        case DataType::Undefined:
+            break;
+        case DataType::Int8:
+            ReadNormalizedRange(reinterpret_cast<const std::int8_t*>(src), dst, begin, end);
+            break;
+        case DataType::UInt8:
+            ReadNormalizedRange(reinterpret_cast<const std::uint8_t*>(src), dst, begin, end);
+            break;
+        case DataType::Int16:
+            ReadNormalizedRange(reinterpret_cast<const std::int16_t*>(src), dst, begin, end);
+            break;
+        case DataType::UInt16:
+            ReadNormalizedRange(reinterpret_cast<const std::uint16_t*>(src), dst, begin, end);
+            break;
+        case DataType::Int32:
+            ReadNormalizedRange(reinterpret_cast<const std::int32_t*>(src), dst, begin, end);
+            break;
+        case DataType::UInt32:
+            ReadNormalizedRange(reinterpret_cast<const std::uint32_t*>(src), dst, begin, end);
+            break;
+        case DataType::Float16:
+            DecompressFloat16Array(reinterpret_cast<const std::uint16_t*>(src) + begin, dst + begin, end - begin);
+            break;
+        case DataType::Float32:
+            ::memcpy(dst + begin, reinterpret_cast<const float*>(src) + begin, (end - begin) * sizeof(float));
+            break;
+        case DataType::Float64:
+            for (auto i = begin; i < end; ++i)
+                dst[i] = static_cast<float>(reinterpret_cast<const double*>(src)[i]);
+            break;
+    }
+}
+
+static void WriteFloatRange(DataType dataType, const float* src, void* dst, std::size_t begin, std::size_t end)
+{
+    switch (dataType)
+    {
+        case DataType::Undefined:
+            break;
+        case DataType::Int8:
+            WriteNormalizedRange(src, reinterpret_cast<std::int8_t*>(dst), begin, end);
+            break;
+        case DataType::UInt8:
+            WriteNormalizedRange(src, reinterpret_cast<std::uint8_t*>(dst), begin, end);
+            break;
+        case DataType::Int16:
+            WriteNormalizedRange(src, reinterpret_cast<std::int16_t*>(dst), begin, end);
+            break;
+        case DataType::UInt16:
+            WriteNormalizedRange(src, reinterpret_cast<std::uint16_t*>(dst), begin, end);
+            break;
+        case DataType::Int32:
+            WriteNormalizedRange(src, reinterpret_cast<std::int32_t*>(dst), begin, end);
+            break;
+        case DataType::UInt32:
+            WriteNormalizedRange(src, reinterpret_cast<std::uint32_t*>(dst), begin, end);
+            break;
+        case DataType::Float16:
+            CompressFloat16Array(src + begin, reinterpret_cast<std::uint16_t*>(dst) + begin, end - begin);
+            break;
+        case DataType::Float32:
+            if (dst != src)
+                ::memcpy(reinterpret_cast<float*>(dst) + begin, src + begin, (end - begin) * sizeof(float));
+            break;
+        case DataType::Float64:
+            for (auto i = begin; i < end; ++i)
+                reinterpret_cast<double*>(dst)[i] = static_cast<double>(src[i]);
+            break;
+    }
+}
+
+// Converts the source elements in the range [begin, end) into 32-bit floats in linear color space.
+static void ReadFloats(const FloatConversion& conv, const void* src, float* dst, std::size_t begin, std::size_t end)
+{
+    if (conv.readKernel != nullptr)
+        conv.readKernel(src, dst, begin, end);
+    else
+        ReadFloatRange(conv.dataType, src, dst, begin, end);
+
+    if (conv.sRGBMask != 0)
+        LinearizeRange(conv, dst, begin, end);
+}
+
+// Converts the 32-bit floats in linear color space in the range [begin, end) into the destination data type. The source may be modified.
+static void WriteFloats(const FloatConversion& conv, float* src, void* dst, std::size_t begin, std::size_t end)
+{
+    if (conv.sRGBMask != 0)
+    {
+        if (conv.dataType == DataType::UInt8)
+        {
+            WriteSRGB8Range(conv, src, reinterpret_cast<std::uint8_t*>(dst), begin, end);
+            return;
+        }
+
+        /* Encode sRGB components in place */
+        for (auto i = begin; i < end; ++i)
+        {
+            if ((conv.sRGBMask & (1u << (i % conv.numComponents))) != 0)
+                src[i] = EncodeSRGB(std::max(0.0f, std::min(src[i], 1.0f)));
+        }
+    }
+    WriteFloatRange(conv.dataType, src, dst, begin, end);
+}
+
+static void ReadFloatImage(const FloatConversion& conv, const void* src, float* dst, std::size_t count, ThreadPool* threadPool, std::size_t maxChunks)
+{
+    ParallelForImageRange(
+        threadPool,
+        maxChunks,
+        count,
+        g_resampleMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            ReadFloats(conv, src, dst, begin, end);
+        }
+    );
+}
+
+static void WriteFloatImage(const FloatConversion& conv, float* src, void* dst, std::size_t count, ThreadPool* threadPool, std::size_t maxChunks)
+{
+    ParallelForImageRange(
+        threadPool,
+        maxChunks,
+        count,
+        g_resampleMinWorkSize,
+        [&](std::size_t begin, std::size_t end)
+        {
+            WriteFloats(conv, src, dst, begin, end);
+        }
+    );
+}
+
+
+/* ----- Resampling passes ----- */
+
+// Resamples a single row along the X axis for a fixed number of interleaved components, so the inner loops can be unrolled and vectorized.
+template <std::uint32_t N>
+void ResampleRowX(const float* srcRow, float* dstRow, const ResampleAxis& axis)
+{
+    for (std::uint32_t x = 0; x < axis.dstSize; ++x)
+    {
+        auto src        = srcRow + axis.firsts[x] * N;
+        auto weights    = &(axis.weights[x * axis.numTaps]);
+
+        float sum[N] = {};
+        for (std::uint32_t t = 0; t < axis.numTaps; ++t, src += N)
+        {
+            for (std::uint32_t c = 0; c < N; ++c)
+                sum[c] += weights[t] * src[c];
+        }
+
+        for (std::uint32_t c = 0; c < N; ++c)
+            dstRow[x * N + c] = sum[c];
+    }
+}
+
+template <>
+void ResampleRowX<4>(const float* srcRow, float* dstRow, const ResampleAxis& axis)
+{
+    for (std::uint32_t x = 0; x < axis.dstSize; ++x)
+        WeightedSumRGBA(dstRow + x * 4, srcRow + axis.firsts[x] * 4, &(axis.weights[x * axis.numTaps]), axis.numTaps);
+}
+
+static void ResampleRowX(const float* srcRow, float* dstRow, std::uint32_t numComponents, const ResampleAxis& axis)
+{
+    switch (numComponents)
+    {
+        case 1: ResampleRowX<1>(srcRow, dstRow, axis); break;
+        case 2: ResampleRowX<2>(srcRow, dstRow, axis); break;
+        case 3: ResampleRowX<3>(srcRow, dstRow, axis); break;
+        case 4: ResampleRowX<4>(srcRow, dstRow, axis); break;
+    }
+}
+
+/*
+Resamples all rows of the source image along the X axis, where each pixel has 'numComponents' interleaved components.
+If a source conversion is specified, each row is converted into a scratch buffer first,
+so the source image never has to be converted entirely. Otherwise, the source must consist of 32-bit floats.
+*/
+static void ResampleAxisX(
+    const void*             src,
+    const FloatConversion*  srcConv,
+    float*                  dst,
+    std::size_t             numRows,
+    std::uint32_t           numComponents,
+    const ResampleAxis&     axis,
+    ThreadPool*             threadPool,
+    std::size_t             maxChunks)
+{
+    const auto srcRowLength = static_cast<std::size_t>(axis.srcSize) * numComponents;
+    const auto dstRowLength = static_cast<std::size_t>(axis.dstSize) * numComponents;
+    const auto srcRowStride = srcRowLength * (srcConv != nullptr ? DataTypeSize(srcConv->dataType) : sizeof(float));
+
+    ParallelForImageRange(
+        threadPool,
+        maxChunks,
+        numRows,
+        GetMinChunkSize(dstRowLength * axis.numTaps),
+        [&](std::size_t begin, std::size_t end)
+        {
+            std::unique_ptr<float[]> scratch;
+            if (srcConv != nullptr)
+                scratch = MakeUniqueArray<float>(srcRowLength);
+
+            for (auto row = begin; row < end; ++row)
+            {
+                auto srcRow = reinterpret_cast<const char*>(src) + row * srcRowStride;
+                if (scratch)
+                {
+                    ReadFloats(*srcConv, srcRow, scratch.get(), 0, srcRowLength);
+                    ResampleRowX(scratch.get(), dst + row * dstRowLength, numComponents, axis);
+                }
+                else
+                    ResampleRowX(reinterpret_cast<const float*>(srcRow), dst + row * dstRowLength, numComponents, axis);
+            }
+        }
+    );
+}
+
+/*
+Resamples the source image along an outer axis, i.e. the Y axis with rows as lines or the Z axis with slices as lines.
+Each destination line is a weighted sum of entire source lines, so all memory accesses are contiguous.
+The lines are split into tiles that are processed for all destination lines in turn, so that the source tiles are reused from the cache.
+*/
+static void ResampleOuterAxis(
+    const float*        src,
+    float*              dst,
+    std::size_t         numBlocks,
+    std::size_t         lineLength,
+    const ResampleAxis& axis,
+    ThreadPool*         threadPool,
+    std::size_t         maxChunks)
+{
+    const auto numTiles = (lineLength + g_resampleTileSize - 1) / g_resampleTileSize;
+    const auto numItems = numBlocks * numTiles * axis.dstSize;
+
+    ParallelForImageRange(
+        threadPool,
+        maxChunks,
+        numItems,
+        GetMinChunkSize(std::min(lineLength, g_resampleTileSize) * axis.numTaps),
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto item = begin; item < end; ++item)
+            {
+                /* Destination line varies fastest, then the tile, then the block */
+                const auto i        = item % axis.dstSize;
+                const auto tile     = (item / axis.dstSize) % numTiles;
+                const auto block    = item / (static_cast<std::size_t>(axis.dstSize) * numTiles);
+                const auto offset   = tile * g_resampleTileSize;
+                const auto length   = std::min(g_resampleTileSize, lineLength - offset);
+
+                auto srcLine    = src + (block * axis.srcSize + axis.firsts[i]) * lineLength + offset;
+                auto dstLine    = dst + (block * axis.dstSize + i) * lineLength + offset;
+                auto weights    = &(axis.weights[i * axis.numTaps]);
+
+                /* Initialize destination with first tap and accumulate the remaining taps */
+                MultiplyLine(dstLine, srcLine, weights[0], length);
+
+                for (std::uint32_t t = 1; t < axis.numTaps; ++t)
+                {
+                    srcLine += lineLength;
+                    if (weights[t] != 0.0f)
+                        MultiplyAddLine(dstLine, srcLine, weights[t], length);
+                }
+            }
+        }
+    );
+}
+
+// Resamples the image with nearest neighbor sampling by copying entire pixels, so no data type conversion is required.
+static void ResampleNearest(
+    const char*     src,
+    const Extent3D& srcExtent,
+    char*           dst,
+    const Extent3D& dstExtent,
+    std::size_t     bpp,
+    ThreadPool*     threadPool,
+    std::size_t     maxChunks)
+{
+    ResampleAxis axisX, axisY, axisZ;
+    BuildResampleAxis(axisX, srcExtent.width,  dstExtent.width,  ResampleFilter::Nearest);
+    BuildResampleAxis(axisY, srcExtent.height, dstExtent.height, ResampleFilter::Nearest);
+    BuildResampleAxis(axisZ, srcExtent.depth,  dstExtent.depth,  ResampleFilter::Nearest);
+
+    const auto srcRowStride = bpp * srcExtent.width;
+    const auto dstRowStride = bpp * dstExtent.width;
+
+    ParallelForImageRange(
+        threadPool,
+        maxChunks,
+        static_cast<std::size_t>(dstExtent.height) * dstExtent.depth,
+        GetMinChunkSize(dstRowStride),
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto row = begin; row < end; ++row)
+            {
+                const auto y = axisY.firsts[row % dstExtent.height];
+                const auto z = axisZ.firsts[row / dstExtent.height];
+
+                auto srcRow = src + (static_cast<std::size_t>(z) * srcExtent.height + y) * srcRowStride;
+                auto dstRow = dst + row * dstRowStride;
+
+                for (std::uint32_t x = 0; x < dstExtent.width; ++x)
+                    ::memcpy(dstRow + x * bpp, srcRow + axisX.firsts[x] * bpp, bpp);
+            }
+        }
+    );
+}
+
+
+/* ----- Functions ----- */
+
+void ResampleImage(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResampleFilter              filter,
+    bool                        sRGB,
+    ThreadPool*                 threadPool,
+    std::size_t                 maxChunks)
+{
+    const auto numComponents    = ImageFormatSize(srcImageDesc.format);
+    const auto dataType         = srcImageDesc.dataType;
+    const auto srcNumPixels     = static_cast<std::size_t>(srcExtent.width) * srcExtent.height * srcExtent.depth;
+    const auto dstNumPixels     = static_cast<std::size_t>(dstExtent.width) * dstExtent.height * dstExtent.depth;
+
+    if (srcExtent == dstExtent)
+    {
+        /* Copy image without resampling */
+        ::memcpy(dstImageDesc.data, srcImageDesc.data, GetMemoryFootprint(srcImageDesc.format, dataType, static_cast<std::uint32_t>(srcNumPixels)));
+        return;
+    }
+
+    if (filter == ResampleFilter::Nearest)
+    {
+        ResampleNearest(
+            reinterpret_cast<const char*>(srcImageDesc.data),
+            srcExtent,
+            reinterpret_cast<char*>(dstImageDesc.data),
+            dstExtent,
+            GetMemoryFootprint(srcImageDesc.format, dataType, 1),
+            threadPool,
+            maxChunks
+        );
+        return;
+    }
+
+    /* Build filter taps for all axes that change in size */
+    ResampleAxis axisX, axisY, axisZ;
+    const bool resampleX = (srcExtent.width  != dstExtent.width );
+    const bool resampleY = (srcExtent.height != dstExtent.height);
+    const bool resampleZ = (srcExtent.depth  != dstExtent.depth );
+
+    if (resampleX)
+        BuildResampleAxis(axisX, srcExtent.width, dstExtent.width, filter);
+    if (resampleY)
+        BuildResampleAxis(axisY, srcExtent.height, dstExtent.height, filter);
+    if (resampleZ)
+        BuildResampleAxis(axisZ, srcExtent.depth, dstExtent.depth, filter);
+
+    /* Get conversion from and to 32-bit floats in linear color space */
+    FloatConversion conv;
+    {
+        conv.dataType       = dataType;
+        conv.readKernel     = FindDataTypeConversionKernel(dataType, DataType::Float32);
+        conv.numComponents  = numComponents;
+        conv.sRGBMask       = (sRGB ? GetSRGBComponentMask(srcImageDesc.format) : 0u);
+    }
+    const bool convertSource = (dataType != DataType::Float32 || conv.sRGBMask != 0);
+
+    /*
+    Select the order of the X and Y passes for 32-bit float images with fewer multiply-add operations. The X pass is weighted twice,
+    because the Y pass operates on entire rows and vectorizes better. All other images always begin with the X pass,
+    since it converts the source rows on the fly.
+    */
+    const auto costX = [&](std::uint32_t height) { return 2.0 * height * dstExtent.width * axisX.numTaps; };
+    const auto costY = [&](std::uint32_t width) { return static_cast<double>(width) * dstExtent.height * axisY.numTaps; };
+
+    const bool passYFirst =
+    (
+        !convertSource && resampleX && resampleY &&
+        costY(srcExtent.width) + costX(dstExtent.height) < costX(srcExtent.height) + costY(dstExtent.width)
+    );
+
+    /* Get input of first pass; the source image is only converted entirely if there is no X pass */
+    std::unique_ptr<float[]> srcBuffer;
+    const float* input = nullptr;
+
+    if (!convertSource)
+        input = reinterpret_cast<const float*>(srcImageDesc.data);
+    else if (!resampleX)
+    {
+        srcBuffer = MakeUniqueArray<float>(srcNumPixels * numComponents);
+        ReadFloatImage(conv, srcImageDesc.data, srcBuffer.get(), srcNumPixels * numComponents, threadPool, maxChunks);
+        input = srcBuffer.get();
+    }
+
+    /* Returns the output buffer of the next pass; the last pass of a 32-bit float image writes directly into the destination */
+    std::unique_ptr<float[]> passBuffers[2];
+    std::size_t passIndex = 0;
+    float* lastOutput = nullptr;
+    const int numPasses = (resampleX ? 1 : 0) + (resampleY ? 1 : 0) + (resampleZ ? 1 : 0);
+
+    auto NextOutput = [&](std::size_t numElements) -> float*
+    {
+        const bool isLastPass = (static_cast<int>(++passIndex) == numPasses);
+        if (isLastPass && dataType == DataType::Float32)
+            lastOutput = reinterpret_cast<float*>(dstImageDesc.data);
+        else
+        {
+            auto& buffer = passBuffers[passIndex % 2];
+            buffer = MakeUniqueArray<float>(numElements);
+            lastOutput = buffer.get();
+        }
+        return lastOutput;
+    };
+
+    Extent3D extent = srcExtent;
+
+    auto ResamplePassX = [&]()
+    {
+        /* Resample rows along X axis; read from the source image directly if this is the first pass */
+        auto output = NextOutput(static_cast<std::size_t>(dstExtent.width) * extent.height * extent.depth * numComponents);
+        const auto numRows = static_cast<std::size_t>(extent.height) * extent.depth;
+        if (input != nullptr)
+            ResampleAxisX(input, nullptr, output, numRows, numComponents, axisX, threadPool, maxChunks);
+        else
+            ResampleAxisX(srcImageDesc.data, &conv, output, numRows, numComponents, axisX, threadPool, maxChunks);
+        input = output;
+        extent.width = dstExtent.width;
+    };
+
+    auto ResamplePassY = [&]()
+    {
+        /* Resample columns along Y axis with rows as lines and slices as blocks */
+        auto output = NextOutput(static_cast<std::size_t>(extent.width) * dstExtent.height * extent.depth * numComponents);
+        ResampleOuterAxis(input, output, extent.depth, static_cast<std::size_t>(extent.width) * numComponents, axisY, threadPool, maxChunks);
+        input = output;
+        extent.height = dstExtent.height;
+    };
+
+    if (passYFirst)
+    {
+        ResamplePassY();
+        ResamplePassX();
+    }
+    else
+    {
+        if (resampleX)
+            ResamplePassX();
+        if (resampleY)
+            ResamplePassY();
+    }
+
+    if (resampleZ)
+    {
+        /* Resample along Z axis with slices as lines */
+        auto output = NextOutput(static_cast<std::size_t>(extent.width) * extent.height * dstExtent.depth * numComponents);
+        ResampleOuterAxis(input, output, 1, static_cast<std::size_t>(extent.width) * extent.height * numComponents, axisZ, threadPool, maxChunks);
+        input = output;
+    }
+
+    /* Convert floats back into destination data type; 32-bit float images are written directly and only need the sRGB encoding */
+    if (dataType != DataType::Float32 || conv.sRGBMask != 0)
+        WriteFloatImage(conv, lastOutput, dstImageDesc.data, dstNumPixels * numComponents, threadPool, maxChunks);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,46 @@
+/*
+ * ImageResampler.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_IMAGE_RESAMPLER_H
+#define LLGL_IMAGE_RESAMPLER_H
+
+
+#include <LLGL/ImageFlags.h>
+#include <LLGL/ThreadPool.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Resamples the source image into the destination image with separable filter passes along the X, Y, and Z axes.
+Source and destination must have the same image format and data type, and the buffer sizes must have already been validated.
+Filtering is done on 32-bit floating-point values; integral data types are normalized to the range [0, 1].
+If 'sRGB' is true, all color components except alpha are converted into linear color space before filtering and back afterwards.
+*/
+void ResampleImage(
+    const SrcImageDescriptor&   srcImageDesc,
+    const Extent3D&             srcExtent,
+    const DstImageDescriptor&   dstImageDesc,
+    const Extent3D&             dstExtent,
+    ResampleFilter              filter,
+    bool                        sRGB,
+    ThreadPool*                 threadPool,
+    std::size_t                 maxChunks
+);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
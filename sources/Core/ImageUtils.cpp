@@ -6,7 +6,10 @@
  */
 
 #include "ImageUtils.h"
+#include "WorkStealingThreadPool.h"
 #include <LLGL/Types.h>
+#include <algorithm>
+#include <thread>
 #include <cstdint>
 #include <cstring>
 
@@ -74,6 +77,37 @@ void BitBlit(
     }
 }
 
+// Number of chunks per thread when a thread pool is specified, so that idle threads can steal work from others
+static const std::size_t g_threadChunksPerThread = 4;
+
+ThreadPool* GetThreadPoolForThreadCount(std::size_t& threadCount)
+{
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = std::thread::hardware_concurrency();
+    return (threadCount > 1 ? &GetSharedThreadPool() : nullptr);
+}
+
+std::size_t GetMaxChunksForThreadPool(const ThreadPool& threadPool)
+{
+    return (threadPool.GetThreadCount() + 1) * g_threadChunksPerThread;
+}
+
+void ParallelForImageRange(
+    ThreadPool*             threadPool,
+    std::size_t             maxChunks,
+    std::size_t             count,
+    std::size_t             minChunkSize,
+    const ThreadPool::Task& task)
+{
+    if (minChunkSize > 0)
+        maxChunks = std::min(maxChunks, count / minChunkSize);
+
+    if (threadPool != nullptr && maxChunks > 1)
+        threadPool->ParallelFor(count, (count + maxChunks - 1) / maxChunks, task);
+    else
+        task(0, count);
+}
+
 
 } // /namespace LLGL
 
@@ -9,7 +9,10 @@
 #define LLGL_IMAGE_UTILS_H
 
 
+#include <LLGL/Export.h>
+#include <LLGL/ThreadPool.h>
 #include <cstdint>
+#include <cstddef>
 
 
 namespace LLGL
@@ -21,7 +24,7 @@ struct Extent3D;
 /* ----- Functions ----- */
 
 // Copies the specified extent from the source image to the destination image buffer.
-void BitBlit(
+LLGL_EXPORT void BitBlit(
     const Extent3D& extent,
     std::uint32_t   bpp,
     char*           dst,
@@ -32,6 +35,21 @@ void BitBlit(
     std::uint32_t   srcDepthStride
 );
 
+// Returns the shared thread pool if the specified number of threads requires multi-threading; 'Constants::maxThreadCount' is resolved to the number of hardware threads.
+ThreadPool* GetThreadPoolForThreadCount(std::size_t& threadCount);
+
+// Returns the maximum number of chunks image operations shall be split into for the specified thread pool.
+std::size_t GetMaxChunksForThreadPool(const ThreadPool& threadPool);
+
+// Distributes the range [0, count) over the thread pool with at most 'maxChunks' chunks of at least 'minChunkSize' elements, or processes it on the calling thread only.
+void ParallelForImageRange(
+    ThreadPool*             threadPool,
+    std::size_t             maxChunks,
+    std::size_t             count,
+    std::size_t             minChunkSize,
+    const ThreadPool::Task& task
+);
+
 
 } // /namespace LLGL
 
@@ -11,6 +11,7 @@
 #include <LLGL/Canvas.h>
 #include <LLGL/Input.h>
 #include <LLGL/Timer.h>
+#include <LLGL/ThreadPool.h>
 #include <LLGL/Display.h>
 
 
@@ -39,6 +40,7 @@ LLGL_IMPLEMENT_INTERFACE( Input,                    Interface         )
 LLGL_IMPLEMENT_INTERFACE( Canvas,                   Surface           )
 LLGL_IMPLEMENT_INTERFACE( Canvas::EventListener,    Interface         )
 LLGL_IMPLEMENT_INTERFACE( Timer,                    Interface         )
+LLGL_IMPLEMENT_INTERFACE( ThreadPool,               Interface         )
 LLGL_IMPLEMENT_INTERFACE( Display,                  Interface         )
 LLGL_IMPLEMENT_INTERFACE( ResourceHeap,             RenderSystemChild )
 LLGL_IMPLEMENT_INTERFACE( Resource,                 RenderSystemChild )
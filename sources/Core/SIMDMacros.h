@@ -0,0 +1,50 @@
+/*
+ * SIMDMacros.h
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SIMD_MACROS_H
+#define LLGL_SIMD_MACROS_H
+
+
+/*
+SIMD instruction sets are selected at compile time from the predefined macros of the target architecture.
+SSE2 is always available on AMD64 and AVX2 requires the respective compiler flag (e.g. "-mavx2" or "/arch:AVX2").
+F16C requires the respective compiler flag as well (e.g. "-mf16c"); MSVC has no such flag but all AVX2 processors support F16C.
+NEON is only used on AArch64 where double precision vector lanes are available.
+*/
+
+#if defined __AVX2__
+#   define LLGL_SIMD_AVX2
+#endif
+
+#if defined __F16C__ || ( defined _MSC_VER && defined __AVX2__ )
+#   define LLGL_SIMD_F16C
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || defined _M_AMD64 || ( defined _M_IX86_FP && _M_IX86_FP >= 2 )
+#   define LLGL_SIMD_SSE2
+#endif
+
+#if ( defined __ARM_NEON && defined __aarch64__ ) || defined _M_ARM64
+#   define LLGL_SIMD_NEON
+#endif
+
+#if defined LLGL_SIMD_AVX2 || defined LLGL_SIMD_F16C
+#   include <immintrin.h>
+#elif defined LLGL_SIMD_SSE2
+#   include <emmintrin.h>
+#endif
+
+#if defined LLGL_SIMD_NEON
+#   include <arm_neon.h>
+#endif
+
+
+#endif
+
+
+
+// ================================================================================
@@ -226,6 +226,8 @@ LLGL_EXPORT const char* ToString(const Format t)
         case T::BC4SNorm:           return "BC4SNorm";
         case T::BC5UNorm:           return "BC5UNorm";
         case T::BC5SNorm:           return "BC5SNorm";
+        case T::BC7UNorm:           return "BC7UNorm";
+        case T::BC7UNorm_sRGB:      return "BC7UNorm_sRGB";
     }
 
     return nullptr;
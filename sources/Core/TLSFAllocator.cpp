@@ -0,0 +1,453 @@
+/*
+ * TLSFAllocator.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "TLSFAllocator.h"
+
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
+
+namespace LLGL
+{
+
+
+/*
+ * Internal functions
+ */
+
+// Returns the index of the least significant bit that is set; 'x' must not be zero.
+static std::uint32_t BitScanForward64(std::uint64_t x)
+{
+    #ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64(&index, x);
+    return static_cast<std::uint32_t>(index);
+    #else
+    return static_cast<std::uint32_t>(__builtin_ctzll(x));
+    #endif
+}
+
+// Returns the index of the most significant bit that is set; 'x' must not be zero.
+static std::uint32_t BitScanReverse64(std::uint64_t x)
+{
+    #ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanReverse64(&index, x);
+    return static_cast<std::uint32_t>(index);
+    #else
+    return static_cast<std::uint32_t>(63 - __builtin_clzll(x));
+    #endif
+}
+
+static std::uint64_t AlignOffset(std::uint64_t offset, std::uint64_t alignment)
+{
+    return ((offset + alignment - 1) & ~(alignment - 1));
+}
+
+/*
+Maps the specified size to its first- and second-level index:
+Sizes below 'slIndexCount' are mapped linearly into the first class,
+all other sizes are mapped to the class of their most significant bit and subdivided by the next 'slIndexCountLog2' bits.
+*/
+static void MapSizeToIndices(std::uint64_t size, std::uint32_t slIndexCountLog2, std::uint32_t& fl, std::uint32_t& sl)
+{
+    const std::uint64_t slIndexCount = (1ull << slIndexCountLog2);
+    if (size < slIndexCount)
+    {
+        fl = 0;
+        sl = static_cast<std::uint32_t>(size);
+    }
+    else
+    {
+        const auto msb = BitScanReverse64(size);
+        fl = msb - slIndexCountLog2 + 1;
+        sl = static_cast<std::uint32_t>((size >> (msb - slIndexCountLog2)) ^ slIndexCount);
+    }
+}
+
+
+/*
+ * TLSFAllocator class
+ */
+
+const std::uint32_t TLSFAllocator::invalidBlock;
+const std::uint32_t TLSFAllocator::slIndexCountLog2;
+const std::uint32_t TLSFAllocator::slIndexCount;
+const std::uint32_t TLSFAllocator::flIndexCount;
+
+TLSFAllocator::TLSFAllocator(std::uint64_t size) :
+    totalSize_ { size }
+{
+    for (auto& lists : freeLists_)
+    {
+        for (auto& head : lists)
+            head = invalidBlock;
+    }
+
+    if (size > 0)
+    {
+        /* Start with a single free range that covers the entire address range */
+        headBlock_ = MakeBlock(0, size);
+        tailBlock_ = headBlock_;
+        InsertFreeRange(headBlock_);
+    }
+}
+
+std::uint32_t TLSFAllocator::Allocate(std::uint64_t size, std::uint64_t alignment, bool bestFit)
+{
+    /* Reject empty requests and alignments that are not a power of two */
+    if (size == 0 || size > totalSize_ || alignment == 0 || (alignment & (alignment - 1)) != 0)
+        return invalidBlock;
+
+    /* Search size class of the request for the smallest range that fits */
+    if (bestFit)
+    {
+        auto block = FindBestFit(size, size, alignment);
+        if (block != invalidBlock)
+            return AllocateFrom(block, size, alignment);
+    }
+
+    /* Search for any range of the next larger size class; its offset is usually aligned already */
+    auto block = FindGoodFit(size);
+    if (block != invalidBlock && CanHold(blocks_[block], size, alignment))
+        return AllocateFrom(block, size, alignment);
+
+    /* Search for a range that can hold the request with the worst case alignment padding */
+    if (alignment > 1)
+    {
+        block = FindGoodFit(size + alignment - 1);
+        if (block != invalidBlock)
+            return AllocateFrom(block, size, alignment);
+    }
+
+    /* Search the remaining ranges of the size class of the request */
+    if (!bestFit)
+    {
+        block = FindBestFit(size, size, alignment);
+        if (block != invalidBlock)
+            return AllocateFrom(block, size, alignment);
+    }
+
+    /* Search the size class of the worst case request, which the good-fit search skips */
+    if (alignment > 1)
+    {
+        block = FindBestFit(size + alignment - 1, size, alignment);
+        if (block != invalidBlock)
+            return AllocateFrom(block, size, alignment);
+    }
+
+    return invalidBlock;
+}
+
+void TLSFAllocator::Release(std::uint32_t block)
+{
+    if (block >= blocks_.size() || blocks_[block].free || blocks_[block].size == 0)
+        return;
+
+    numAllocatedBlocks_ -= 1;
+    allocatedSize_      -= blocks_[block].size;
+
+    /* Merge with upper neighbor: [BLOCK][UPPER] --> [++BLOCK+++] */
+    auto next = blocks_[block].nextPhys;
+    if (next != invalidBlock && blocks_[next].free)
+    {
+        RemoveFreeRange(next);
+        MergeWithNext(block);
+    }
+
+    /* Merge with lower neighbor: [LOWER][BLOCK] --> [++LOWER+++] */
+    auto prev = blocks_[block].prevPhys;
+    if (prev != invalidBlock && blocks_[prev].free)
+    {
+        RemoveFreeRange(prev);
+        MergeWithNext(prev);
+        block = prev;
+    }
+
+    InsertFreeRange(block);
+}
+
+std::uint64_t TLSFAllocator::GetMaxFreeRangeSize() const
+{
+    if (flBitmap_ == 0)
+        return 0;
+
+    /* The largest range must be in the highest non-empty size class */
+    const auto fl = BitScanReverse64(flBitmap_);
+    const auto sl = BitScanReverse64(slBitmaps_[fl]);
+
+    std::uint64_t maxSize = 0;
+    for (auto block = freeLists_[fl][sl]; block != invalidBlock; block = blocks_[block].nextFree)
+    {
+        if (maxSize < blocks_[block].size)
+            maxSize = blocks_[block].size;
+    }
+
+    return maxSize;
+}
+
+std::uint64_t TLSFAllocator::GetTailFreeRangeSize() const
+{
+    if (tailBlock_ != invalidBlock && blocks_[tailBlock_].free)
+        return blocks_[tailBlock_].size;
+    else
+        return 0;
+}
+
+std::uint32_t TLSFAllocator::GetFirstBlock() const
+{
+    return headBlock_;
+}
+
+std::uint32_t TLSFAllocator::GetNextBlock(std::uint32_t block) const
+{
+    return blocks_[block].nextPhys;
+}
+
+bool TLSFAllocator::IsFree(std::uint32_t block) const
+{
+    return blocks_[block].free;
+}
+
+std::uint64_t TLSFAllocator::GetOffset(std::uint32_t block) const
+{
+    return blocks_[block].offset;
+}
+
+std::uint64_t TLSFAllocator::GetSize(std::uint32_t block) const
+{
+    return blocks_[block].size;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+std::uint32_t TLSFAllocator::MakeBlock(std::uint64_t offset, std::uint64_t size)
+{
+    std::uint32_t block = unusedBlocks_;
+
+    if (block != invalidBlock)
+    {
+        /* Reuse node from the list of unused nodes */
+        unusedBlocks_ = blocks_[block].nextFree;
+        blocks_[block] = Block{};
+    }
+    else
+    {
+        /* Append new node */
+        block = static_cast<std::uint32_t>(blocks_.size());
+        blocks_.push_back(Block{});
+    }
+
+    blocks_[block].offset   = offset;
+    blocks_[block].size     = size;
+
+    return block;
+}
+
+void TLSFAllocator::DeleteBlock(std::uint32_t block)
+{
+    blocks_[block]          = Block{};
+    blocks_[block].nextFree = unusedBlocks_;
+    unusedBlocks_           = block;
+}
+
+void TLSFAllocator::InsertFreeRange(std::uint32_t block)
+{
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeToIndices(blocks_[block].size, slIndexCountLog2, fl, sl);
+
+    /* Push block to the front of its free list */
+    auto& head = freeLists_[fl][sl];
+
+    blocks_[block].free     = true;
+    blocks_[block].prevFree = invalidBlock;
+    blocks_[block].nextFree = head;
+
+    if (head != invalidBlock)
+        blocks_[head].prevFree = block;
+
+    head = block;
+
+    flBitmap_       |= (1ull << fl);
+    slBitmaps_[fl]  |= (1u << sl);
+
+    numFreeRanges_ += 1;
+}
+
+void TLSFAllocator::RemoveFreeRange(std::uint32_t block)
+{
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeToIndices(blocks_[block].size, slIndexCountLog2, fl, sl);
+
+    /* Unlink block from its free list */
+    auto& entry = blocks_[block];
+
+    if (entry.prevFree != invalidBlock)
+        blocks_[entry.prevFree].nextFree = entry.nextFree;
+    else
+        freeLists_[fl][sl] = entry.nextFree;
+
+    if (entry.nextFree != invalidBlock)
+        blocks_[entry.nextFree].prevFree = entry.prevFree;
+
+    entry.free      = false;
+    entry.prevFree  = invalidBlock;
+    entry.nextFree  = invalidBlock;
+
+    /* Clear bits of empty lists */
+    if (freeLists_[fl][sl] == invalidBlock)
+    {
+        slBitmaps_[fl] &= ~(1u << sl);
+        if (slBitmaps_[fl] == 0)
+            flBitmap_ &= ~(1ull << fl);
+    }
+
+    numFreeRanges_ -= 1;
+}
+
+std::uint32_t TLSFAllocator::FindGoodFit(std::uint64_t size) const
+{
+    /* Round size up to the next size class, so that every range in that class can hold the request */
+    if (size >= slIndexCount)
+    {
+        const auto round = (1ull << (BitScanReverse64(size) - slIndexCountLog2)) - 1;
+        if (size + round < size)
+            return invalidBlock;
+        size += round;
+    }
+
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeToIndices(size, slIndexCountLog2, fl, sl);
+
+    if (fl >= flIndexCount)
+        return invalidBlock;
+
+    /* Search the current first-level class for a non-empty list at or above the second-level index */
+    auto slMap = slBitmaps_[fl] & (~0u << sl);
+    if (slMap == 0)
+    {
+        /* Search the next larger first-level class */
+        if (fl + 1 >= flIndexCount)
+            return invalidBlock;
+
+        const auto flMap = flBitmap_ & (~0ull << (fl + 1));
+        if (flMap == 0)
+            return invalidBlock;
+
+        fl      = BitScanForward64(flMap);
+        slMap   = slBitmaps_[fl];
+    }
+
+    sl = BitScanForward64(slMap);
+
+    return freeLists_[fl][sl];
+}
+
+std::uint32_t TLSFAllocator::FindBestFit(std::uint64_t classSize, std::uint64_t size, std::uint64_t alignment) const
+{
+    std::uint32_t fl = 0, sl = 0;
+    MapSizeToIndices(classSize, slIndexCountLog2, fl, sl);
+
+    if (fl >= flIndexCount)
+        return invalidBlock;
+
+    std::uint32_t bestBlock = invalidBlock;
+
+    for (auto block = freeLists_[fl][sl]; block != invalidBlock; block = blocks_[block].nextFree)
+    {
+        const auto& entry = blocks_[block];
+        if (CanHold(entry, size, alignment) && (bestBlock == invalidBlock || entry.size < blocks_[bestBlock].size))
+        {
+            bestBlock = block;
+            if (entry.size == size)
+                break;
+        }
+    }
+
+    return bestBlock;
+}
+
+std::uint32_t TLSFAllocator::AllocateFrom(std::uint32_t block, std::uint64_t size, std::uint64_t alignment)
+{
+    RemoveFreeRange(block);
+
+    /* Split off the alignment padding at the lower part: [PADDING][BLOCK.....] */
+    const auto offset   = blocks_[block].offset;
+    const auto padding  = AlignOffset(offset, alignment) - offset;
+
+    if (padding > 0)
+    {
+        auto alignedBlock = SplitBlock(block, padding);
+        InsertFreeRange(block);
+        block = alignedBlock;
+    }
+
+    /* Split off the remainder at the upper part: [BLOCK][REMAINDER] */
+    if (blocks_[block].size > size)
+    {
+        auto remainder = SplitBlock(block, size);
+        InsertFreeRange(remainder);
+    }
+
+    numAllocatedBlocks_ += 1;
+    allocatedSize_      += size;
+
+    return block;
+}
+
+std::uint32_t TLSFAllocator::SplitBlock(std::uint32_t block, std::uint64_t frontSize)
+{
+    auto upper = MakeBlock(blocks_[block].offset + frontSize, blocks_[block].size - frontSize);
+
+    /* Link new block into the physical order */
+    auto next = blocks_[block].nextPhys;
+
+    blocks_[upper].prevPhys = block;
+    blocks_[upper].nextPhys = next;
+
+    if (next != invalidBlock)
+        blocks_[next].prevPhys = upper;
+    else
+        tailBlock_ = upper;
+
+    blocks_[block].nextPhys = upper;
+    blocks_[block].size     = frontSize;
+
+    return upper;
+}
+
+void TLSFAllocator::MergeWithNext(std::uint32_t block)
+{
+    auto next       = blocks_[block].nextPhys;
+    auto nextNext   = blocks_[next].nextPhys;
+
+    blocks_[block].size     += blocks_[next].size;
+    blocks_[block].nextPhys = nextNext;
+
+    if (nextNext != invalidBlock)
+        blocks_[nextNext].prevPhys = block;
+    else
+        tailBlock_ = block;
+
+    DeleteBlock(next);
+}
+
+bool TLSFAllocator::CanHold(const Block& block, std::uint64_t size, std::uint64_t alignment) const
+{
+    return (AlignOffset(block.offset, alignment) - block.offset + size <= block.size);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
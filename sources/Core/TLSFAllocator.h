@@ -0,0 +1,170 @@
+/*
+ * TLSFAllocator.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_TLSF_ALLOCATOR_H
+#define LLGL_TLSF_ALLOCATOR_H
+
+
+#include <cstdint>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+/*
+Two-Level Segregated Fit (TLSF) allocator for sub-ranges of a contiguous address range of fixed size.
+This class only manages offsets and sizes, i.e. it never touches the memory itself, so it can be used for GPU heaps.
+Free ranges are kept in segregated free lists that are indexed by a two-level bitmap,
+so allocating and releasing a range takes constant time and adjacent free ranges are merged immediately.
+*/
+class TLSFAllocator
+{
+
+    public:
+
+        // Block handle that denotes an invalid block.
+        static const std::uint32_t invalidBlock = ~0u;
+
+    public:
+
+        TLSFAllocator(std::uint64_t size);
+
+        TLSFAllocator(const TLSFAllocator&) = default;
+        TLSFAllocator& operator = (const TLSFAllocator&) = default;
+
+        TLSFAllocator(TLSFAllocator&&) = default;
+        TLSFAllocator& operator = (TLSFAllocator&&) = default;
+
+        /*
+        Allocates a range of the specified size whose offset is a multiple of the specified alignment (must be a power of two).
+        If 'bestFit' is true, the size class of the request is searched for the smallest range that fits before the constant time good-fit search is used.
+        Returns the handle of the new block or 'invalidBlock' if there is no free range that can hold the request.
+        */
+        std::uint32_t Allocate(std::uint64_t size, std::uint64_t alignment = 1, bool bestFit = false);
+
+        // Releases the specified block and merges it with its adjacent free ranges.
+        void Release(std::uint32_t block);
+
+        // Returns the size of the largest free range.
+        std::uint64_t GetMaxFreeRangeSize() const;
+
+        // Returns the size of the free range at the end of the address range, or 0 if the last range is allocated.
+        std::uint64_t GetTailFreeRangeSize() const;
+
+        // Returns the first block in address order. The entire address range is covered by allocated blocks and free ranges.
+        std::uint32_t GetFirstBlock() const;
+
+        // Returns the next block in address order or 'invalidBlock' if the specified block is the last one.
+        std::uint32_t GetNextBlock(std::uint32_t block) const;
+
+        // Returns true if the specified block is a free range.
+        bool IsFree(std::uint32_t block) const;
+
+        // Returns the offset of the specified block.
+        std::uint64_t GetOffset(std::uint32_t block) const;
+
+        // Returns the size of the specified block.
+        std::uint64_t GetSize(std::uint32_t block) const;
+
+        // Returns the size of the entire address range.
+        inline std::uint64_t GetTotalSize() const
+        {
+            return totalSize_;
+        }
+
+        // Returns the number of allocated blocks.
+        inline std::size_t GetNumAllocatedBlocks() const
+        {
+            return numAllocatedBlocks_;
+        }
+
+        // Returns the number of free ranges.
+        inline std::size_t GetNumFreeRanges() const
+        {
+            return numFreeRanges_;
+        }
+
+        // Returns the number of allocated bytes (not including alignment padding).
+        inline std::uint64_t GetAllocatedSize() const
+        {
+            return allocatedSize_;
+        }
+
+    private:
+
+        // Number of second-level subdivisions per first-level class (log2).
+        static const std::uint32_t slIndexCountLog2 = 5;
+        static const std::uint32_t slIndexCount     = (1u << slIndexCountLog2);
+
+        // Number of first-level classes; sizes below 'slIndexCount' share the first class.
+        static const std::uint32_t flIndexCount     = 64 - slIndexCountLog2 + 1;
+
+        struct Block
+        {
+            std::uint64_t   offset      = 0;
+            std::uint64_t   size        = 0;
+            std::uint32_t   prevPhys    = invalidBlock;
+            std::uint32_t   nextPhys    = invalidBlock;
+            std::uint32_t   prevFree    = invalidBlock;
+            std::uint32_t   nextFree    = invalidBlock; // Also used as link in the list of unused nodes
+            bool            free        = false;
+        };
+
+    private:
+
+        std::uint32_t MakeBlock(std::uint64_t offset, std::uint64_t size);
+        void DeleteBlock(std::uint32_t block);
+
+        void InsertFreeRange(std::uint32_t block);
+        void RemoveFreeRange(std::uint32_t block);
+
+        // Finds a free range of at least the specified size in constant time.
+        std::uint32_t FindGoodFit(std::uint64_t size) const;
+
+        // Finds the smallest free range in the size class of 'classSize' that can hold the request.
+        std::uint32_t FindBestFit(std::uint64_t classSize, std::uint64_t size, std::uint64_t alignment) const;
+
+        // Splits the specified free range so that a block of the specified size and alignment is allocated.
+        std::uint32_t AllocateFrom(std::uint32_t block, std::uint64_t size, std::uint64_t alignment);
+
+        // Splits the specified block after 'frontSize' bytes and returns the new upper block.
+        std::uint32_t SplitBlock(std::uint32_t block, std::uint64_t frontSize);
+
+        // Merges the physical successor into the specified block.
+        void MergeWithNext(std::uint32_t block);
+
+        bool CanHold(const Block& block, std::uint64_t size, std::uint64_t alignment) const;
+
+    private:
+
+        std::vector<Block>  blocks_;
+        std::uint32_t       unusedBlocks_                               = invalidBlock;
+        std::uint32_t       headBlock_                                  = invalidBlock;
+        std::uint32_t       tailBlock_                                  = invalidBlock;
+
+        std::uint64_t       flBitmap_                                   = 0;
+        std::uint32_t       slBitmaps_[flIndexCount]                    = {};
+        std::uint32_t       freeLists_[flIndexCount][slIndexCount];
+
+        std::uint64_t       totalSize_                                  = 0;
+        std::size_t         numAllocatedBlocks_                         = 0;
+        std::size_t         numFreeRanges_                              = 0;
+        std::uint64_t       allocatedSize_                              = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
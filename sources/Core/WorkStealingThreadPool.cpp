@@ -0,0 +1,262 @@
+/*
+ * WorkStealingThreadPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "WorkStealingThreadPool.h"
+#include "Helper.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Thread pool and queue index of the current thread; only set for worker threads.
+static thread_local const WorkStealingThreadPool*   g_currentThreadPool = nullptr;
+static thread_local std::size_t                     g_currentQueueIndex = 0;
+
+static std::size_t GetDefaultWorkerCount()
+{
+    /* Leave one hardware thread for the caller, since it participates in the work */
+    auto numHardwareThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+    return (numHardwareThreads > 1 ? numHardwareThreads - 1 : 0);
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(std::size_t threadCount) :
+    numQueuedJobs_ { 0 }
+{
+    if (threadCount >= Constants::maxThreadCount)
+        threadCount = GetDefaultWorkerCount();
+
+    /* Create one job queue per worker and launch all worker threads */
+    queues_ = MakeUniqueArray<JobQueue>(threadCount);
+
+    workers_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        workers_.emplace_back(&WorkStealingThreadPool::WorkerProc, this, i);
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    /* Signal all workers to quit and wait for them to finish */
+    {
+        std::lock_guard<std::mutex> lock { wakeMutex_ };
+        quit_ = true;
+    }
+    wakeVar_.notify_all();
+
+    for (auto& worker : workers_)
+        worker.join();
+}
+
+std::size_t WorkStealingThreadPool::GetThreadCount() const
+{
+    return workers_.size();
+}
+
+void WorkStealingThreadPool::ParallelFor(std::size_t count, std::size_t chunkSize, const Task& task)
+{
+    if (count == 0)
+        return;
+
+    if (chunkSize == 0 || chunkSize >= count)
+    {
+        /* Process entire range on calling thread */
+        task(0, count);
+        return;
+    }
+
+    if (workers_.empty())
+    {
+        /* Process all chunks on calling thread; the first exception is re-thrown after all chunks have been processed */
+        std::exception_ptr exception;
+        for (std::size_t begin = 0; begin < count; begin += chunkSize)
+        {
+            try
+            {
+                task(begin, std::min(begin + chunkSize, count));
+            }
+            catch (...)
+            {
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+        if (exception)
+            std::rethrow_exception(exception);
+        return;
+    }
+
+    /* Initialize batch for all chunks */
+    Batch batch;
+    batch.task      = &task;
+    batch.pending   = (count + chunkSize - 1) / chunkSize;
+
+    const auto numQueues    = workers_.size();
+    const auto queueIndex   = GetCurrentQueueIndex();
+
+    {
+        std::lock_guard<std::mutex> lock { wakeMutex_ };
+        numQueuedJobs_ += static_cast<std::ptrdiff_t>(batch.pending);
+    }
+
+    if (queueIndex < numQueues)
+    {
+        /* Push all chunks onto the queue of this worker thread, idle workers will steal them */
+        auto& queue = queues_[queueIndex];
+        std::lock_guard<std::mutex> lock { queue.mutex };
+        for (std::size_t begin = 0; begin < count; begin += chunkSize)
+            queue.jobs.push_back(Job{ &batch, begin, std::min(begin + chunkSize, count) });
+    }
+    else
+    {
+        /* Distribute chunks evenly over all worker queues */
+        std::size_t i = 0;
+        for (std::size_t begin = 0; begin < count; begin += chunkSize, ++i)
+        {
+            auto& queue = queues_[i % numQueues];
+            std::lock_guard<std::mutex> lock { queue.mutex };
+            queue.jobs.push_back(Job{ &batch, begin, std::min(begin + chunkSize, count) });
+        }
+    }
+
+    wakeVar_.notify_all();
+
+    /* Participate in the work until no more jobs are available */
+    for (Job job; batch.pending > 0 && FetchJob(queueIndex, job);)
+        RunJob(job);
+
+    /* Wait for the remaining chunks that are still processed by other threads */
+    std::unique_lock<std::mutex> lock { batch.mutex };
+    batch.finished.wait(lock, [&batch]() { return (batch.pending == 0); });
+
+    if (batch.exception)
+        std::rethrow_exception(batch.exception);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void WorkStealingThreadPool::WorkerProc(std::size_t queueIndex)
+{
+    g_currentThreadPool = this;
+    g_currentQueueIndex = queueIndex;
+
+    for (Job job;;)
+    {
+        if (FetchJob(queueIndex, job))
+            RunJob(job);
+        else
+        {
+            /* Wait until new jobs are queued or the pool is destroyed */
+            std::unique_lock<std::mutex> lock { wakeMutex_ };
+            wakeVar_.wait(lock, [this]() { return (quit_ || numQueuedJobs_ > 0); });
+            if (quit_)
+                break;
+        }
+    }
+}
+
+bool WorkStealingThreadPool::PopJob(std::size_t queueIndex, Job& job)
+{
+    if (queueIndex < workers_.size())
+    {
+        /* Pop most recent job from the back of the own queue */
+        auto& queue = queues_[queueIndex];
+        std::lock_guard<std::mutex> lock { queue.mutex };
+        if (!queue.jobs.empty())
+        {
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+            --numQueuedJobs_;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingThreadPool::StealJob(std::size_t thiefIndex, Job& job)
+{
+    const auto numQueues = workers_.size();
+    for (std::size_t i = 1; i <= numQueues; ++i)
+    {
+        /* Steal oldest job from the front of another queue */
+        auto& queue = queues_[(thiefIndex + i) % numQueues];
+        std::lock_guard<std::mutex> lock { queue.mutex };
+        if (!queue.jobs.empty())
+        {
+            job = queue.jobs.front();
+            queue.jobs.pop_front();
+            --numQueuedJobs_;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WorkStealingThreadPool::FetchJob(std::size_t queueIndex, Job& job)
+{
+    return (PopJob(queueIndex, job) || StealJob(queueIndex, job));
+}
+
+void WorkStealingThreadPool::RunJob(const Job& job)
+{
+    auto batch = job.batch;
+
+    /* Run task for the range of this job and catch exceptions for the caller of ParallelFor */
+    std::exception_ptr exception;
+    try
+    {
+        (*batch->task)(job.begin, job.end);
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    /* Finish job; the batch must not be accessed after its mutex has been released */
+    std::lock_guard<std::mutex> lock { batch->mutex };
+    if (exception && !batch->exception)
+        batch->exception = exception;
+    if (--batch->pending == 0)
+        batch->finished.notify_all();
+}
+
+std::size_t WorkStealingThreadPool::GetCurrentQueueIndex() const
+{
+    return (g_currentThreadPool == this ? g_currentQueueIndex : workers_.size());
+}
+
+
+/* ----- Functions ----- */
+
+ThreadPool& GetSharedThreadPool()
+{
+    /*
+    The shared pool is intentionally leaked: destroying it with the static objects would join the worker threads
+    while the module is being unloaded, which can deadlock under the loader lock (e.g. on Windows when LLGL is a DLL).
+    The idle workers only wait on a condition variable and are terminated with the process.
+    */
+    static WorkStealingThreadPool* sharedThreadPool = new WorkStealingThreadPool{ Constants::maxThreadCount };
+    return *sharedThreadPool;
+}
+
+
+/* ----- ThreadPool ----- */
+
+std::unique_ptr<ThreadPool> ThreadPool::Create(std::size_t threadCount)
+{
+    return MakeUnique<WorkStealingThreadPool>(threadCount);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
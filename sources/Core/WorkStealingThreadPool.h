@@ -0,0 +1,104 @@
+/*
+ * WorkStealingThreadPool.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_WORK_STEALING_THREAD_POOL_H
+#define LLGL_WORK_STEALING_THREAD_POOL_H
+
+
+#include <LLGL/ThreadPool.h>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+
+
+namespace LLGL
+{
+
+
+/*
+Default thread pool implementation: Each worker owns a job queue; it pops jobs from the back of its own queue
+and steals jobs from the front of other queues when its own queue runs empty.
+*/
+class WorkStealingThreadPool final : public ThreadPool
+{
+
+    public:
+
+        WorkStealingThreadPool(std::size_t threadCount);
+        ~WorkStealingThreadPool();
+
+        std::size_t GetThreadCount() const override;
+
+        void ParallelFor(std::size_t count, std::size_t chunkSize, const Task& task) override;
+
+    private:
+
+        // Shared state of a single ParallelFor call.
+        struct Batch
+        {
+            const Task*                 task        = nullptr;
+            std::atomic<std::size_t>    pending     { 0 };
+            std::exception_ptr          exception;
+            std::mutex                  mutex;
+            std::condition_variable     finished;
+        };
+
+        struct Job
+        {
+            Batch*      batch;
+            std::size_t begin;
+            std::size_t end;
+        };
+
+        struct JobQueue
+        {
+            std::mutex          mutex;
+            std::deque<Job>     jobs;
+        };
+
+    private:
+
+        void WorkerProc(std::size_t queueIndex);
+
+        bool PopJob(std::size_t queueIndex, Job& job);
+        bool StealJob(std::size_t thiefIndex, Job& job);
+        bool FetchJob(std::size_t queueIndex, Job& job);
+
+        void RunJob(const Job& job);
+
+        // Returns the queue index of the calling thread if it is a worker of this pool, or the number of queues otherwise.
+        std::size_t GetCurrentQueueIndex() const;
+
+    private:
+
+        std::vector<std::thread>        workers_;
+        std::unique_ptr<JobQueue[]>     queues_;
+
+        std::mutex                      wakeMutex_;
+        std::condition_variable         wakeVar_;
+        std::atomic<std::ptrdiff_t>     numQueuedJobs_;
+        bool                            quit_           = false;
+
+};
+
+
+// Returns the thread pool that is shared by all image utility functions which only specify a thread count. This pool is never destroyed.
+ThreadPool& GetSharedThreadPool();
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
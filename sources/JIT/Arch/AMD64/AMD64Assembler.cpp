@@ -7,10 +7,9 @@
 
 #include "AMD64Assembler.h"
 #include "AMD64Opcode.h"
-#include <limits.h>
-
-#include <fstream>//!!!
-#include <iomanip>
+#include "../../../Core/Helper.h"
+#include <algorithm>
+#include <string.h>
 
 
 namespace LLGL
@@ -33,39 +32,53 @@ see https://en.wikipedia.org/wiki/X86_calling_conventions#List_of_x86_calling_co
 
 /*
 Microsoft x64 calling convention (Windows)
-Preserved for caller: ???
+Preserved for caller: RBX, RBP, RDI, RSI, RSP, R12-R15, XMM6-XMM15
+Arguments are assigned to registers by their position, and the caller must reserve 32 bytes of shadow space on the stack.
 */
 static const Reg g_amd64IntParams[] = { Reg::RCX, Reg::RDX, Reg::R8, Reg::R9 };
 static const Reg g_amd64FltParams[] = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3 };
-static const Reg g_amd64TempReg     = Reg::RAX;
+static const std::uint32_t g_amd64ShadowSpace = 32;
 
 #else
 
 /*
 System V AMD64 ABI (Solaris, Linux, BSD, macOS)
-Preserved for caller: RBP, RBX, R12-R15
+Preserved for caller: RBX, RBP, RSP, R12-R15
+Integer and floating-point arguments are assigned to their registers independently of each other.
 */
 static const Reg g_amd64IntParams[] = { Reg::RDI, Reg::RSI, Reg::RDX, Reg::RCX, Reg::R8, Reg::R9 };
 static const Reg g_amd64FltParams[] = { Reg::XMM0, Reg::XMM1, Reg::XMM2, Reg::XMM3, Reg::XMM4, Reg::XMM5, Reg::XMM6, Reg::XMM7 };
-static const Reg g_amd64TempReg     = Reg::RAX;
+static const std::uint32_t g_amd64ShadowSpace = 0;
 
 #endif
 
-static const std::size_t g_amd64IntParamsCount = sizeof(g_amd64IntParams)/sizeof(g_amd64IntParams[0]);
-static const std::size_t g_amd64FltParamsCount = sizeof(g_amd64FltParams)/sizeof(g_amd64FltParams[0]);
+// Temporary register to pass arguments on the stack (not used for parameters in either calling convention)
+static const Reg g_amd64TempReg     = Reg::RAX;
+
+// Register that holds the address of called functions (not used for parameters in either calling convention)
+static const Reg g_amd64CallReg     = Reg::R11;
+
+static const std::uint32_t g_amd64IntParamsCount = sizeof(g_amd64IntParams)/sizeof(g_amd64IntParams[0]);
+static const std::uint32_t g_amd64FltParamsCount = sizeof(g_amd64FltParams)/sizeof(g_amd64FltParams[0]);
 
 
 /*
  * Internal functions
  */
 
-// Size of byte (1), word (2), dword (4), qword (8), ptr (8), stack-ptr (8), float (4), double (8)
+// Size of byte (1), word (2), dword (4), qword (8), ptr (8), stack-ptr (8), var-arg-ptr (8), float (4), double (8)
 static std::uint8_t GetArgSize(const ArgType t)
 {
-    static const std::uint8_t sizes[] = { 1, 2, 4, 8, 8, 8, 4, 8 };
+    static const std::uint8_t sizes[] = { 1, 2, 4, 8, 8, 8, 8, 4, 8 };
     return sizes[static_cast<std::uint8_t>(t)];
 }
 
+// Returns true if the specified register requires the REX.R or REX.B extension bit (i.e. R8-R15 and XMM8-XMM15).
+static bool IsExtReg(const Reg reg)
+{
+    return ((reg >= Reg::R8 && reg <= Reg::R15) || (reg >= Reg::XMM8 && reg <= Reg::XMM15));
+}
+
 
 /*
  * AMD64Assembler class
@@ -73,17 +86,14 @@ static std::uint8_t GetArgSize(const ArgType t)
 
 void AMD64Assembler::Begin()
 {
-    #if 0//TEST
-    _ForceExcep();
-    XOrReg(Reg::EAX, Reg::EAX);
-    XOrReg(Reg::EAX, Reg::EBX);
-    XOrReg(Reg::RAX, Reg::RBX);
-    XOrReg(Reg::RDI, Reg::RSI);
-    #endif
-
     /* Reset data about local stack */
-    localStackSize_ = 128;//0;
-    paramStackSize_ = 0;
+    localStackSize_     = 0;
+    argStackSize_       = 0;
+    frameSizeOffset_    = 0;
+
+    supplements_.clear();
+    varArgDisp_.clear();
+    stackChunkDisp_.clear();
 
     /* Write entry point prologue */
     WritePrologue();
@@ -92,152 +102,43 @@ void AMD64Assembler::Begin()
 
 void AMD64Assembler::End()
 {
-    /* Pop local stack */
-    if (localStackSize_ > 0)
-        AddImm32(Reg::RSP, localStackSize_);
-
     /* Write entry point epilogue and append supplement at the end of program */
     WriteEpilogue();
     ApplySupplements();
 
-    // TEST: write program to file
-    #if 0
-    {
-        std::ofstream f("JITProgram.txt");
-        DumpAssembly(f, true);
-    }
-    exit(0);
-    #endif // /TEST
+    /* Now that all function calls are known, write final size of the stack frame into the prologue */
+    WriteFrameSize();
 }
 
 void AMD64Assembler::WriteFuncCall(const void* addr, JITCallConv conv, bool farCall)
 {
     const auto& args = GetArgs();
 
-    /* Move first couple of arguments into registers */
-    std::size_t numIntRegs = 0, numFltRegs = 0;
-    std::size_t lastInt, lastFlt;
-    std::size_t num = args.size();
+    /* Write arguments that are passed on the stack first, because they are moved through the temporary register */
+    ArgLocator stackArgLocator;
 
-    lastInt = lastFlt = std::numeric_limits<std::size_t>::max();
-
-    for (std::size_t i = 0; i < num; ++i)
+    for (const auto& arg : args)
     {
-        const auto& arg = args[i];
-
-        /* Determine destination register for argument */
-        Reg dstReg = g_amd64TempReg;
-        bool isFloat = IsFloat(arg.type);
-
-        if (isFloat && numFltRegs < g_amd64FltParamsCount)
-        {
-            dstReg  = g_amd64FltParams[numFltRegs++];
-            lastFlt = i;
-        }
-        else if (!isFloat && numIntRegs < g_amd64IntParamsCount)
-        {
-            dstReg  = g_amd64IntParams[numIntRegs++];
-            lastInt = i;
-        }
-        else
-            break;
-
-        if (arg.param < 0xF)
-        {
-            if (arg.param < varArgDisp_.size())
-            {
-                /* Move parameter from local stack into destination register */
-                if (IsFltReg(dstReg))
-                    MovDQURegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
-                else
-                    MovRegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
-            }
-        }
-        else if (dstReg >= Reg::R8 && dstReg <= Reg::R15)
-        {
-            /* R8-R15 registers are only supported for 64-bit operand size */
-            MovRegImm64(dstReg, arg.value.i64);
-        }
-        else
-        {
-            /* Move value into destination register */
-            switch (arg.type)
-            {
-                case ArgType::Byte:
-                    MovRegImm32(dstReg, arg.value.i8);
-                    break;
-                case ArgType::Word:
-                    MovRegImm32(dstReg, arg.value.i16);
-                    break;
-                case ArgType::DWord:
-                    MovRegImm32(dstReg, arg.value.i32);
-                    break;
-                case ArgType::QWord:
-                    MovRegImm64(dstReg, arg.value.i64);
-                    break;
-                case ArgType::Ptr:
-                    MovRegImm64(dstReg, arg.value.i64);
-                    break;
-                case ArgType::StackPtr:
-                    MovReg(dstReg, Reg::RBP);
-                    SubImm32(dstReg, stackChunkOffsets_[arg.value.i8]);
-                    break;
-                case ArgType::Float:
-                    MovSSRegImm32(dstReg, arg.value.f32);
-                    break;
-                case ArgType::Double:
-                    MovSDRegImm64(dstReg, arg.value.f64);
-                    break;
-            }
-        }
+        auto loc = stackArgLocator.Next(arg.type);
+        if (loc.onStack)
+            WriteArgToStack(loc.stackOffset, arg);
     }
 
-    /* Push remaining arguments onto stack */
-    Displacement stackDisp;
-
-    for (std::size_t i = 0; i < num; ++i)
-    {
-        auto iRev = num - i - 1u;
-        const auto& arg = args[iRev];
+    argStackSize_ = std::max(argStackSize_, stackArgLocator.GetStackSize());
 
-        /* Check if argument has already been moved into a register */
-        bool isFloat = IsFloat(arg.type);
+    /* Move remaining arguments into their parameter registers */
+    ArgLocator regArgLocator;
 
-        if ( (  isFloat && iRev == lastFlt ) ||
-             ( !isFloat && iRev == lastInt ) )
-        {
-            break;
-        }
-
-        /* Push argument onto stack */
-        switch (arg.type)
-        {
-            case ArgType::Byte:
-            case ArgType::Word:
-            case ArgType::DWord:
-            case ArgType::Float:
-                MovMemImm32(Reg::RSP, arg.value.i32, stackDisp);
-                stackDisp.disp8 += 8;
-                break;
-            case ArgType::QWord:
-            case ArgType::Ptr:
-            case ArgType::Double:
-                MovRegImm64(g_amd64TempReg, arg.value.i64);
-                MovMemReg(Reg::RSP, g_amd64TempReg, stackDisp);
-                stackDisp.disp8 += 8;
-                break;
-            case ArgType::StackPtr:
-                MovReg(g_amd64TempReg, Reg::RBP);
-                SubImm32(g_amd64TempReg, stackChunkOffsets_[arg.value.i8]);
-                MovMemReg(Reg::RSP, g_amd64TempReg, stackDisp);
-                stackDisp.disp8 += 8;
-                break;
-        }
+    for (const auto& arg : args)
+    {
+        auto loc = regArgLocator.Next(arg.type);
+        if (!loc.onStack)
+            WriteArgToReg(loc.reg, arg);
     }
 
     /* Write 'call' instruction */
-    MovRegImm64(g_amd64TempReg, reinterpret_cast<std::uint64_t>(addr));
-    CallNear(g_amd64TempReg);
+    MovRegImm64(g_amd64CallReg, reinterpret_cast<std::uint64_t>(addr));
+    CallNear(g_amd64CallReg);
 }
 
 
@@ -250,169 +151,229 @@ bool AMD64Assembler::IsLittleEndian() const
     return true;
 }
 
-std::uint8_t AMD64Assembler::DispMod(const Displacement& disp) const
-{
-    if (disp.disp32 != 0)
-    {
-        if (disp.has32Bits)
-            return Operand_Mod10; // disp32
-        else
-            return Operand_Mod01; // disp8
-    }
-    return 0;
-}
-
-std::uint8_t AMD64Assembler::ModRM(std::uint8_t mode, Reg r0, Reg r1) const
-{
-    std::uint8_t modRM = (mode | (RegByte(r0) << 3));
-
-    if (r1 == Reg::RSP)
-        modRM |= Operand_SIB;
-    else
-        modRM |= RegByte(r1);
-
-    return modRM;
-}
-
 void AMD64Assembler::WritePrologue()
 {
     /* Store base stack pointer (RBP) */
     PushReg(Reg::RBP);
     MovReg(Reg::RBP, Reg::RSP);
 
-    #if 1
     /* Store general purpose registers */
-    //TODO: determine which registers must be stored
     PushReg(Reg::RBX);
-    #endif
 }
 
 void AMD64Assembler::WriteEpilogue()
 {
-    #if 1
-    /* Restore general purpose registers */
-    //TODO: determine which registers must be restored
+    /* Release local stack frame and restore general purpose registers */
+    LeaRegMem(Reg::RSP, Reg::RBP, -8);
     PopReg(Reg::RBX);
-    #endif
 
     /* Restore base stack pointer (RBP) */
     PopReg(Reg::RBP);
-    RetNear(paramStackSize_);
+    RetNear();
 }
 
+/*
+Stack frame layout (relative to RBP):
+  [RBP+16]          Parameters of entry point passed on the stack
+  [RBP+8]           Return address
+  [RBP]             Preserved RBP
+  [RBP-8]           Preserved RBX
+  [RBP-16] ...      Variadic arguments of entry point (8 bytes for integers, 16 bytes for SSE registers)
+  ...               Stack allocations (16-byte aligned)
+  [RSP] ...         Arguments passed on the stack for function calls
+*/
 void AMD64Assembler::WriteStackFrame(
     const std::vector<JIT::ArgType>&    varArgTypes,
     const std::vector<std::uint32_t>&   stackChunks)
 {
-    /* Determine required stack size for variadic arguments */
-    std::uint32_t varArgSize = 0;
-    for (auto type : varArgTypes)
-        varArgSize += (IsFloat(type) ? 16 : 8);
-
-    /* Determine required stack size for allocations */
-    std::uint32_t stackChunksSize = 0;
-    for (auto chunk : stackChunks)
-        stackChunksSize += chunk;
-
-    /* Allocate local stack */
-    localStackSize_ += varArgSize;
-
-    std::uint32_t chunkStackOffset = localStackSize_ + 8;
-
-    localStackSize_ += stackChunksSize;
-
-    if (localStackSize_ > 0)
-        SubImm32(Reg::RSP, localStackSize_);
+    /* Allocate local stack; the final size is written in 'End' when all function calls are known */
+    SubImm32(Reg::RSP, 0);
+    frameSizeOffset_ = GetAssembly().size() - sizeof(std::uint32_t);
 
     /* Store parameters in local stack */
-    std::size_t numIntRegs = 0, numFltRegs = 0;
-    std::int8_t paramStackOffset = 16; // first parameter at [EBP+16]
-    std::int8_t localStackOffset = -16; // local variables after preserved EBX
+    ArgLocator paramLocator;
+    std::int32_t localStackOffset = -8; // local variables after preserved RBX
 
     for (auto type : varArgTypes)
     {
-        bool isFloat = IsFloat(type);
-        Reg srcReg = g_amd64TempReg;
+        auto loc = paramLocator.Next(type);
 
-        if (isFloat && numFltRegs < g_amd64FltParamsCount)
-        {
-            /* Get parameter from floating-point register */
-            srcReg = g_amd64FltParams[numFltRegs++];
-        }
-        else if (!isFloat && numIntRegs < g_amd64IntParamsCount)
-        {
-            /* Get parameter from integer register */
-            srcReg = g_amd64IntParams[numIntRegs++];
-        }
+        if (IsFloat(type))
+            localStackOffset -= 16; // SSE2 register size of 128 bits
         else
+            localStackOffset -= 8; // x64 register size of 64 bits
+
+        if (loc.onStack)
         {
-            /* Load parameter from stack */
-            MovRegMem(srcReg, Reg::RBP, Disp8{ paramStackOffset });
-            paramStackOffset += 8;
-            paramStackSize_ += 8;
+            /* Load parameter from stack frame of the caller (after return address and preserved RBP) */
+            MovRegMem(g_amd64TempReg, Reg::RBP, 16 + loc.stackOffset);
+            MovMemReg(Reg::RBP, g_amd64TempReg, localStackOffset);
         }
-
-        /* Store parameter in local stack */
-        if (IsFltReg(srcReg))
+        else if (IsFltReg(loc.reg))
         {
-            localStackOffset -= 16; // SSE2 register size of 128 bits
-            MovDQUMemReg(Reg::RBP, srcReg, Disp8{ localStackOffset });
+            /* Store parameter from floating-point register */
+            MovDQUMemReg(Reg::RBP, loc.reg, localStackOffset);
         }
         else
         {
-            localStackOffset -= 8; // x64 register size of 64 bits
-            MovMemReg(Reg::RBP, srcReg, Disp8{ localStackOffset });
+            /* Store parameter from integer register */
+            MovMemReg(Reg::RBP, loc.reg, localStackOffset);
         }
 
         /* Store parameter offset within stack frame */
-        varArgDisp_.push_back(Disp8{ localStackOffset });
+        varArgDisp_.push_back(localStackOffset);
     }
 
-    /* Determine stack base for arguments of subsequent calls */
-    argStackBase_.disp8 = localStackOffset;
-
     /* Determine stack base for allocated stack chunks */
-    stackChunkOffsets_.reserve(stackChunks.size());
+    auto stackOffset = static_cast<std::uint32_t>(-localStackOffset);
+
+    stackChunkDisp_.reserve(stackChunks.size());
     for (auto chunk : stackChunks)
     {
-        chunkStackOffset += static_cast<std::int32_t>(chunk);
-        stackChunkOffsets_.push_back(chunkStackOffset);
+        stackOffset = GetAlignedSize(stackOffset + chunk, 16u);
+        stackChunkDisp_.push_back(-static_cast<std::int32_t>(stackOffset));
     }
+
+    localStackSize_ = stackOffset - 8;
 }
 
-void AMD64Assembler::WriteOptREX(Reg reg, bool defaultsTo64Bit)
+void AMD64Assembler::WriteFrameSize()
+{
+    /*
+    Return address, RBP, and RBX take 24 bytes on the stack,
+    so the frame size must be 8 modulo 16 to keep RSP 16-byte aligned at each call site.
+    */
+    std::uint32_t frameSize = GetAlignedSize(8u + localStackSize_ + argStackSize_, 16u) - 8u;
+    ::memcpy(&(GetAssembly()[frameSizeOffset_]), &frameSize, sizeof(frameSize));
+}
+
+void AMD64Assembler::WriteArgToReg(Reg dstReg, const Arg& arg)
 {
-    std::uint8_t prefix = 0;
+    if (arg.param < 0xF)
+    {
+        /* Move parameter from local stack into destination register */
+        if (IsFltReg(dstReg))
+            MovDQURegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
+        else
+            MovRegMem(dstReg, Reg::RBP, varArgDisp_[arg.param]);
+    }
+    else
+    {
+        /* Move value into destination register */
+        switch (arg.type)
+        {
+            case ArgType::Byte:
+            case ArgType::Word:
+            case ArgType::DWord:
+                MovRegImm32(dstReg, arg.value.i32);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+                MovRegImm64(dstReg, arg.value.i64);
+                break;
+            case ArgType::StackPtr:
+                LeaRegMem(dstReg, Reg::RBP, stackChunkDisp_[arg.value.i8]);
+                break;
+            case ArgType::VarArgPtr:
+                LeaRegMem(dstReg, Reg::RBP, varArgDisp_[arg.value.i8]);
+                break;
+            case ArgType::Float:
+                MovSSRegImm32(dstReg, arg.value.f32);
+                break;
+            case ArgType::Double:
+                MovSDRegImm64(dstReg, arg.value.f64);
+                break;
+        }
+    }
+}
 
-    if (Is64Reg(reg))
+void AMD64Assembler::WriteArgToStack(std::int32_t stackOffset, const Arg& arg)
+{
+    if (arg.param < 0xF)
+    {
+        /* Copy parameter from local stack into argument stack */
+        MovRegMem(g_amd64TempReg, Reg::RBP, varArgDisp_[arg.param]);
+        MovMemReg(Reg::RSP, g_amd64TempReg, stackOffset);
+    }
+    else
     {
-        if (!defaultsTo64Bit || reg >= Reg::R8)
+        /* Move value into argument stack */
+        switch (arg.type)
         {
-            prefix |= REX_W;
-            if (reg >= Reg::R8)
-                prefix |= REX_B;
+            case ArgType::Byte:
+            case ArgType::Word:
+            case ArgType::DWord:
+            case ArgType::Float:
+                MovMemImm32(Reg::RSP, arg.value.i32, stackOffset);
+                break;
+            case ArgType::QWord:
+            case ArgType::Ptr:
+            case ArgType::Double:
+                MovRegImm64(g_amd64TempReg, arg.value.i64);
+                MovMemReg(Reg::RSP, g_amd64TempReg, stackOffset);
+                break;
+            case ArgType::StackPtr:
+                LeaRegMem(g_amd64TempReg, Reg::RBP, stackChunkDisp_[arg.value.i8]);
+                MovMemReg(Reg::RSP, g_amd64TempReg, stackOffset);
+                break;
+            case ArgType::VarArgPtr:
+                LeaRegMem(g_amd64TempReg, Reg::RBP, varArgDisp_[arg.value.i8]);
+                MovMemReg(Reg::RSP, g_amd64TempReg, stackOffset);
+                break;
         }
     }
+}
+
+void AMD64Assembler::WriteREX(std::uint8_t rexW, Reg reg, Reg rm)
+{
+    std::uint8_t prefix = rexW;
+
+    if (IsExtReg(reg))
+        prefix |= REX_R;
+    if (IsExtReg(rm))
+        prefix |= REX_B;
 
     if (prefix != 0)
         WriteByte(REX_Prefix | prefix);
 }
 
-void AMD64Assembler::WriteOptDisp(const Displacement& disp)
+void AMD64Assembler::WriteOptREX(Reg reg, bool defaultsTo64Bit)
+{
+    WriteREX((Is64Reg(reg) && !defaultsTo64Bit ? REX_W : 0), Reg::EAX, reg);
+}
+
+void AMD64Assembler::WriteModRMMem(std::uint8_t regField, Reg memReg, std::int32_t disp)
 {
-    if (disp.disp32 != 0)
+    const auto baseByte = RegByte(memReg);
+
+    /* RBP and R13 as base register without displacement would denote RIP-relative addressing */
+    std::uint8_t mode = 0;
+    if (disp != 0 || baseByte == RegByte(Reg::RBP))
+        mode = (disp >= -128 && disp <= 127 ? Operand_Mod01 : Operand_Mod10);
+
+    /* RSP and R12 as base register require a SIB byte */
+    if (baseByte == RegByte(Reg::RSP))
     {
-        if (disp.has32Bits)
-            WriteDWord(static_cast<std::uint32_t>(disp.disp32));
-        else
-            WriteByte(static_cast<std::uint8_t>(disp.disp8));
+        WriteByte(mode | (regField << 3) | Operand_SIB);
+        WriteByte((baseByte << 3) | baseByte);
     }
+    else
+        WriteByte(mode | (regField << 3) | baseByte);
+
+    /* Write displacement */
+    if (mode == Operand_Mod01)
+        WriteByte(static_cast<std::uint8_t>(static_cast<std::int8_t>(disp)));
+    else if (mode == Operand_Mod10)
+        WriteDWord(static_cast<std::uint32_t>(disp));
 }
 
-void AMD64Assembler::WriteOptSIB(Reg reg)
+void AMD64Assembler::WriteSSEOpcode(const std::uint8_t (&opcode)[3], Reg reg, Reg rm)
 {
-    if (reg == Reg::RSP)
-        WriteByte((RegByte(reg) << 3) | RegByte(reg));
+    /* REX prefix must be written between the mandatory prefix and the escape opcode */
+    WriteByte(opcode[0]);
+    WriteREX(0, reg, rm);
+    WriteByte(opcode[1]);
+    WriteByte(opcode[2]);
 }
 
 void AMD64Assembler::BeginSupplement(const Arg& arg)
@@ -449,13 +410,6 @@ void AMD64Assembler::ApplySupplements()
     }
 }
 
-void AMD64Assembler::ErrInvalidUseOfRSP()
-{
-    #ifdef LLGL_DEBUG
-    //Error("invalid use of %RSP register in MOV instruction");
-    #endif
-}
-
 /* ----- PUSH ----- */
 
 void AMD64Assembler::PushReg(Reg srcReg)
@@ -486,7 +440,7 @@ void AMD64Assembler::Push(Reg srcReg)
     if (IsFltReg(srcReg))
     {
         SubImm32(Reg::RSP, 16);
-        MovDQUMemReg(Reg::RSP, srcReg, {});
+        MovDQUMemReg(Reg::RSP, srcReg, 0);
     }
     else
         PushReg(srcReg);
@@ -504,7 +458,7 @@ void AMD64Assembler::Pop(Reg dstReg)
 {
     if (IsFltReg(dstReg))
     {
-        MovDQURegMem(dstReg, Reg::RSP, {});
+        MovDQURegMem(dstReg, Reg::RSP, 0);
         AddImm32(Reg::RSP, 16);
     }
     else
@@ -516,15 +470,17 @@ void AMD64Assembler::Pop(Reg dstReg)
 // Opcode: 89 /r
 void AMD64Assembler::MovReg(Reg dstReg, Reg srcReg)
 {
-    WriteOptREX(dstReg);
+    WriteREX((Is64Reg(dstReg) ? REX_W : 0), srcReg, dstReg);
     WriteByte(Opcode_MovMemReg);
     WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
 }
 
+// Opcode: B8 +rd id (zero extends to 64 bits)
 void AMD64Assembler::MovRegImm32(Reg dstReg, std::uint32_t dword)
 {
     if (dword != 0)
     {
+        WriteREX(0, Reg::EAX, dstReg);
         WriteByte(Opcode_MovRegImm | RegByte(dstReg));
         WriteDWord(dword);
     }
@@ -532,6 +488,7 @@ void AMD64Assembler::MovRegImm32(Reg dstReg, std::uint32_t dword)
         XOrReg(dstReg, dstReg);
 }
 
+// Opcode: REX.W B8 +rq iq
 void AMD64Assembler::MovRegImm64(Reg dstReg, std::uint64_t qword)
 {
     if (qword != 0)
@@ -544,59 +501,48 @@ void AMD64Assembler::MovRegImm64(Reg dstReg, std::uint64_t qword)
         XOrReg(dstReg, dstReg);
 }
 
-void AMD64Assembler::MovMemImm32(Reg dstMemReg, std::uint32_t dword, const Displacement& disp)
+// Opcode: REX.W C7 /0 id
+void AMD64Assembler::MovMemImm32(Reg dstMemReg, std::uint32_t dword, std::int32_t disp)
 {
-    WriteOptREX(dstMemReg); // prefix
+    WriteREX(REX_W, Reg::EAX, dstMemReg);
     WriteByte(Opcode_MovMemImm);
-    WriteByte(DispMod(disp) | RegByte(dstMemReg));
-    WriteOptSIB(dstMemReg);
-    WriteOptDisp(disp); // displacement
+    WriteModRMMem(0, dstMemReg, disp);
     WriteDWord(dword); // immediate
 }
 
-void AMD64Assembler::MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp)
+// Opcode: 89 /r
+void AMD64Assembler::MovMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp)
 {
-    WriteOptREX(srcReg); // prefix
+    WriteREX((Is64Reg(srcReg) ? REX_W : 0), srcReg, dstMemReg);
     WriteByte(Opcode_MovMemReg);
-    WriteByte(ModRM(DispMod(disp), srcReg, dstMemReg));
-    WriteOptSIB(dstMemReg);
-    WriteOptDisp(disp); // displacement
+    WriteModRMMem(RegByte(srcReg), dstMemReg, disp);
 }
 
-void AMD64Assembler::MovRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
+// Opcode: 8B /r
+void AMD64Assembler::MovRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp)
 {
-    WriteOptREX(dstReg);
+    WriteREX((Is64Reg(dstReg) ? REX_W : 0), dstReg, srcMemReg);
     WriteByte(Opcode_MovRegMem);
-    WriteByte(ModRM(DispMod(disp), dstReg, srcMemReg));
-    WriteOptSIB(srcMemReg);
-    WriteOptDisp(disp);
+    WriteModRMMem(RegByte(dstReg), srcMemReg, disp);
 }
 
-#if 0 // UNUSED
-// dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
-void AMD64Assembler::MovSSRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
+// Opcode: REX.W 8D /r
+void AMD64Assembler::LeaRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp)
 {
-    Write(OpcodeSSE2_MovSSRegMem, 3);
-    WriteByte(DispMod(disp) | (RegByte(dstReg) << 3) | RegByte(srcMemReg));
-    WriteOptDisp(disp); // displacement
+    WriteREX(REX_W, dstReg, srcMemReg);
+    WriteByte(Opcode_LeaRegMem);
+    WriteModRMMem(RegByte(dstReg), srcMemReg, disp);
 }
 
-// dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
-void AMD64Assembler::MovSDRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
-{
-    Write(OpcodeSSE2_MovSDRegMem, 3);
-    WriteByte(DispMod(disp) | (RegByte(dstReg) << 3) | RegByte(srcMemReg));
-    WriteOptDisp(disp); // displacement
-}
-#endif // /UNUSED
-
+// Opcode: F3 0F 10 /r (RIP-relative)
 void AMD64Assembler::MovSSRegImm32(Reg dstReg, float f32)
 {
-    Write(OpcodeSSE2_MovSSRegMem, 3);
+    WriteSSEOpcode(OpcodeSSE2_MovSSRegMem, dstReg, Reg::EAX);
     WriteByte((RegByte(dstReg) << 3) | Operand_RIP);
 
     Arg arg;
     arg.type        = ArgType::Float;
+    arg.value.i64   = 0;
     arg.value.f32   = f32;
     BeginSupplement(arg);
 
@@ -605,9 +551,10 @@ void AMD64Assembler::MovSSRegImm32(Reg dstReg, float f32)
     EndSupplement();
 }
 
+// Opcode: F2 0F 10 /r (RIP-relative)
 void AMD64Assembler::MovSDRegImm64(Reg dstReg, double f64)
 {
-    Write(OpcodeSSE2_MovSDRegMem, 3);
+    WriteSSEOpcode(OpcodeSSE2_MovSDRegMem, dstReg, Reg::EAX);
     WriteByte((RegByte(dstReg) << 3) | Operand_RIP);
 
     Arg arg;
@@ -620,31 +567,28 @@ void AMD64Assembler::MovSDRegImm64(Reg dstReg, double f64)
     EndSupplement();
 }
 
-// dstReg: XMM0-XMM7, srcMemReg: RAX-RDI
-void AMD64Assembler::MovDQURegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp)
+// Opcode: F3 0F 6F /r
+void AMD64Assembler::MovDQURegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp)
 {
-    Write(OpcodeSSE2_MovDQURegMem, 3);
-    WriteByte(ModRM(DispMod(disp), dstReg, srcMemReg));
-    WriteOptSIB(srcMemReg);
-    WriteOptDisp(disp);
+    WriteSSEOpcode(OpcodeSSE2_MovDQURegMem, dstReg, srcMemReg);
+    WriteModRMMem(RegByte(dstReg), srcMemReg, disp);
 }
 
-// dstMemReg: RAX-RDI, srcReg: XMM0-XMM7
-void AMD64Assembler::MovDQUMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp)
+// Opcode: F3 0F 7F /r
+void AMD64Assembler::MovDQUMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp)
 {
-    Write(OpcodeSSE2_MovDQUMemReg, 3);
-    WriteByte(ModRM(DispMod(disp), srcReg, dstMemReg));
-    WriteOptSIB(dstMemReg);
-    WriteOptDisp(disp);
+    WriteSSEOpcode(OpcodeSSE2_MovDQUMemReg, srcReg, dstMemReg);
+    WriteModRMMem(RegByte(srcReg), dstMemReg, disp);
 }
 
 /* ----- ADD ----- */
 
-void AMD64Assembler::AddImm32(Reg dst, std::uint32_t dword)
+// Opcode: 81 /0 id
+void AMD64Assembler::AddImm32(Reg dstReg, std::uint32_t dword)
 {
-    WriteOptREX(dst);
+    WriteOptREX(dstReg);
     WriteByte(Opcode_AddImm);
-    WriteByte(Operand_Mod11 | RegByte(dst));
+    WriteByte(Operand_Mod11 | RegByte(dstReg));
     WriteDWord(dword);
 }
 
@@ -675,13 +619,14 @@ void AMD64Assembler::DivReg(Reg srcReg)
 // Opcode: 31 /r
 void AMD64Assembler::XOrReg(Reg dstReg, Reg srcReg)
 {
-    WriteOptREX(dstReg);
+    WriteREX((Is64Reg(dstReg) ? REX_W : 0), srcReg, dstReg);
     WriteByte(Opcode_XOrMemReg);
     WriteByte(Operand_Mod11 | RegByte(srcReg) << 3 | RegByte(dstReg));
 }
 
 /* ----- CALL ----- */
 
+// Opcode: FF /2
 void AMD64Assembler::CallNear(Reg reg)
 {
     WriteOptREX(reg, true);
@@ -721,37 +666,60 @@ void AMD64Assembler::Int(std::uint8_t byte)
     WriteByte(byte);
 }
 
-#if 1//TESTING
-void AMD64Assembler::_ForceExcep()
-{
-    //TEST: generate division by zero instruction to force exception
-    MovRegImm32(Reg::RAX, 0);
-    MovRegImm32(Reg::RDX, 0);
-    DivReg(Reg::RAX);
-}
-#endif
-
 
 /*
- * Displacement structure
+ * ArgLocator class
  */
 
-AMD64Assembler::Displacement::Displacement() :
-    has32Bits { false },
-    disp32    { 0     }
+AMD64Assembler::ArgLocation AMD64Assembler::ArgLocator::Next(const ArgType type)
 {
-}
+    ArgLocation loc;
+    {
+        loc.reg         = Reg::RAX;
+        loc.onStack     = false;
+        loc.stackOffset = 0;
+    }
 
-AMD64Assembler::Disp8::Disp8(std::int8_t disp)
-{
-    has32Bits   = false;
-    disp8       = disp;
+    const bool isFloat = IsFloat(type);
+
+    #ifdef _WIN32
+
+    /* Assign register by argument position, or stack slot after the shadow space */
+    if (numArgs_ < g_amd64IntParamsCount)
+        loc.reg = (isFloat ? g_amd64FltParams[numArgs_] : g_amd64IntParams[numArgs_]);
+    else
+    {
+        loc.onStack     = true;
+        loc.stackOffset = static_cast<std::int32_t>(g_amd64ShadowSpace + (numArgs_ - g_amd64IntParamsCount) * 8);
+    }
+
+    #else
+
+    /* Assign next free register of the respective class, or the next stack slot */
+    if (isFloat && numFltRegs_ < g_amd64FltParamsCount)
+        loc.reg = g_amd64FltParams[numFltRegs_++];
+    else if (!isFloat && numIntRegs_ < g_amd64IntParamsCount)
+        loc.reg = g_amd64IntParams[numIntRegs_++];
+    else
+    {
+        loc.onStack     = true;
+        loc.stackOffset = static_cast<std::int32_t>(g_amd64ShadowSpace + (numStackArgs_++) * 8);
+    }
+
+    #endif
+
+    ++numArgs_;
+
+    return loc;
 }
 
-AMD64Assembler::Disp32::Disp32(std::int32_t disp)
+std::uint32_t AMD64Assembler::ArgLocator::GetStackSize() const
 {
-    has32Bits   = true;
-    disp32      = disp;
+    #ifdef _WIN32
+    return (g_amd64ShadowSpace + (std::max(numArgs_, g_amd64IntParamsCount) - g_amd64IntParamsCount) * 8);
+    #else
+    return (g_amd64ShadowSpace + numStackArgs_ * 8);
+    #endif
 }
 
 
@@ -38,10 +38,36 @@ class AMD64Assembler final : public JITCompiler
 
     private:
 
-        struct Displacement;
+        // Location of a function argument, either in a register or on the stack.
+        struct ArgLocation
+        {
+            Reg             reg;
+            bool            onStack;
+            std::int32_t    stackOffset;    // Byte offset relative to the stack pointer of the caller (if 'onStack' is true)
+        };
+
+        // Assigns the function arguments to registers and stack slots according to the native calling convention.
+        class ArgLocator
+        {
+
+            public:
+
+                // Returns the location for the next argument of the specified type.
+                ArgLocation Next(const ArgType type);
+
+                // Returns the number of bytes the caller must reserve on the stack for the arguments that have been located so far.
+                std::uint32_t GetStackSize() const;
 
-        std::uint8_t DispMod(const Displacement& disp) const;
-        std::uint8_t ModRM(std::uint8_t mode, Reg r0, Reg r1) const;
+            private:
+
+                std::uint32_t numArgs_      = 0;
+                std::uint32_t numIntRegs_   = 0;
+                std::uint32_t numFltRegs_   = 0;
+                std::uint32_t numStackArgs_ = 0;
+
+        };
+
+    private:
 
         void WritePrologue();
         void WriteEpilogue();
@@ -51,16 +77,20 @@ class AMD64Assembler final : public JITCompiler
             const std::vector<std::uint32_t>&   stackChunks
         );
 
+        void WriteFrameSize();
+
+        void WriteArgToReg(Reg dstReg, const Arg& arg);
+        void WriteArgToStack(std::int32_t stackOffset, const Arg& arg);
+
+        void WriteREX(std::uint8_t rexW, Reg reg, Reg rm);
         void WriteOptREX(Reg reg, bool defaultsTo64Bit = false);
-        void WriteOptDisp(const Displacement& disp);
-        void WriteOptSIB(Reg reg);
+        void WriteModRMMem(std::uint8_t regField, Reg memReg, std::int32_t disp);
+        void WriteSSEOpcode(const std::uint8_t (&opcode)[3], Reg reg, Reg rm);
 
         void BeginSupplement(const Arg& arg);
         void EndSupplement();
         void ApplySupplements();
 
-        void ErrInvalidUseOfRSP();
-
     private:
 
         void PushReg(Reg srcReg);
@@ -75,20 +105,17 @@ class AMD64Assembler final : public JITCompiler
         void MovReg(Reg dstReg, Reg srcReg);
         void MovRegImm32(Reg dstReg, std::uint32_t dword);
         void MovRegImm64(Reg dstReg, std::uint64_t qword);
-        void MovMemImm32(Reg dstMemReg, std::uint32_t dword, const Displacement& disp);
-        void MovMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp);
-        void MovRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
+        void MovMemImm32(Reg dstMemReg, std::uint32_t dword, std::int32_t disp);
+        void MovMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp);
+        void MovRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp);
 
-        #if 0 // UNUSED
-        void MovSSRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
-        void MovSDRegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
-        #endif // /UNUSED
+        void LeaRegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp);
 
         void MovSSRegImm32(Reg dstReg, float f32);
         void MovSDRegImm64(Reg dstReg, double f64);
 
-        void MovDQURegMem(Reg dstReg, Reg srcMemReg, const Displacement& disp);
-        void MovDQUMemReg(Reg dstMemReg, Reg srcReg, const Displacement& disp);
+        void MovDQURegMem(Reg dstReg, Reg srcMemReg, std::int32_t disp);
+        void MovDQUMemReg(Reg dstMemReg, Reg srcReg, std::int32_t disp);
 
         void AddImm32(Reg dstReg, std::uint32_t dword);
         void SubImm32(Reg dstReg, std::uint32_t dword);
@@ -102,10 +129,6 @@ class AMD64Assembler final : public JITCompiler
 
         void Int(std::uint8_t byte);
 
-        #if 1//TESTING
-        void _ForceExcep();
-        #endif
-
     private:
 
         struct Supplement
@@ -116,44 +139,25 @@ class AMD64Assembler final : public JITCompiler
             std::size_t     dstOffset;  // Destination byte offset where the instruction must be updated
         };
 
-        struct Displacement
-        {
-            Displacement();
-            Displacement(const Displacement&) = default;
-            Displacement& operator = (const Displacement&) = default;
-
-            bool has32Bits;
-            union
-            {
-                std::int8_t     disp8;
-                std::int32_t    disp32;
-            };
-        };
-
-        struct Disp8 : public Displacement
-        {
-            Disp8(std::int8_t disp);
-        };
+    private:
 
-        struct Disp32 : public Displacement
-        {
-            Disp32(std::int32_t disp);
-        };
+        // Size of the local stack frame below the preserved RBX register (variadic arguments and stack allocations).
+        std::uint32_t               localStackSize_     = 0;
 
-    private:
+        // Maximum stack size required for the arguments of all function calls (including shadow space on Win64).
+        std::uint32_t               argStackSize_       = 0;
 
-        std::uint32_t           	localStackSize_ = 0;
-        std::uint16_t               paramStackSize_ = 0;
-        Displacement                argStackBase_;
+        // Byte offset of the immediate operand that allocates the stack frame in the prologue.
+        std::size_t                 frameSizeOffset_    = 0;
 
         // Supplement data that must be updated after encoding
         std::vector<Supplement>     supplements_;
 
-        // Displacements of parameters within stack frame
-        std::vector<Displacement>   varArgDisp_;
+        // Base pointer displacements of the variadic arguments within the stack frame
+        std::vector<std::int32_t>   varArgDisp_;
 
-        // Base pointer offsets of stack allocations
-        std::vector<std::uint32_t>  stackChunkOffsets_;
+        // Base pointer displacements of the stack allocations
+        std::vector<std::int32_t>   stackChunkDisp_;
 
 };
 
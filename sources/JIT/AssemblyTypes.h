@@ -20,7 +20,7 @@ namespace JIT
 
 
 // Argument type enumeration.
-enum class ArgType
+enum class ArgType : std::uint8_t
 {
     Byte,
     Word,
@@ -28,6 +28,7 @@ enum class ArgType
     QWord,
     Ptr,
     StackPtr,
+    VarArgPtr,
     Float,
     Double,
 };
@@ -9,6 +9,9 @@
 #include "AssemblyTypes.h"
 #include "../Core/Helper.h"
 #include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <string.h>
 
 #include <LLGL/Platform/Platform.h>
 #if defined LLGL_OS_WIN32
@@ -120,6 +123,21 @@ void JITCompiler::PushVarArg(std::uint8_t idx)
     }
 }
 
+void JITCompiler::PushVarArgPtr(std::uint8_t idx)
+{
+    if (idx < entryVarArgs_.size() && idx < 0xF)
+    {
+        Arg arg;
+        {
+            arg.type        = ArgType::VarArgPtr;
+            arg.param       = 0xF;
+            arg.value.i64   = 0;
+            arg.value.i8    = idx;
+        }
+        args_.push_back(arg);
+    }
+}
+
 void JITCompiler::PushStackPtr(std::uint8_t idx)
 {
     if (idx < stackAllocs_.size())
@@ -288,84 +306,135 @@ void JITCompiler::WritePtr(const void* data)
 
 #ifdef LLGL_DEBUG
 
-void Test1(int x, int8_t b, uint16_t h, uint64_t q, int i5, int i6, int i7, int8_t i8, uint64_t i9)
+// Arguments that are recorded by the test functions which are called from the JIT program.
+struct JITTestRecord
 {
-    std::cout << __FUNCTION__;
-    std::cout << ": x = " << x;
-    std::cout << ", b = " << (int)b;
-    std::cout << ", h = 0x" << std::hex << h << std::dec;
-    std::cout << ", q = " << q;
-    std::cout << ", i = { " << i5 << ", " << i6 << ", " << i7 << ", " << (int)i8 << ", " << i9 << " }";
-    std::cout << std::endl;
+    int             x;
+    std::uint8_t    b;
+    std::uint16_t   h;
+    std::uint64_t   q;
+    int             i[3];
+    std::uint8_t    b2;
+    std::uint64_t   q2;
+    float           f[5];
+    double          d[5];
+    int             y;
+    const void*     p;
+    const void*     varArgPtr;
+};
+
+static JITTestRecord g_jitTestRecord;
+
+// Takes more integer arguments than there are integer registers in either calling convention.
+static void JITTestIntArgs(int x, std::uint8_t b, std::uint16_t h, std::uint64_t q, int i5, int i6, int i7, std::uint8_t i8, std::uint64_t i9)
+{
+    g_jitTestRecord.x       = x;
+    g_jitTestRecord.b       = b;
+    g_jitTestRecord.h       = h;
+    g_jitTestRecord.q       = q;
+    g_jitTestRecord.i[0]    = i5;
+    g_jitTestRecord.i[1]    = i6;
+    g_jitTestRecord.i[2]    = i7;
+    g_jitTestRecord.b2      = i8;
+    g_jitTestRecord.q2      = i9;
 }
 
-void Test2(float f, double d)
+// Takes more floating-point arguments than there are SSE registers in either calling convention, interleaved with integer arguments.
+static void JITTestMixedArgs(float f0, double d0, int y, float f1, double d1, const void* p, float f2, double d2, float f3, double d3, float f4, double d4)
 {
-    std::cout << __FUNCTION__;
-    std::cout << ": f = " << f;
-    std::cout << ", d = " << d;
-    std::cout << std::endl;
+    const float f[] = { f0, f1, f2, f3, f4 };
+    const double d[] = { d0, d1, d2, d3, d4 };
+    ::memcpy(g_jitTestRecord.f, f, sizeof(f));
+    ::memcpy(g_jitTestRecord.d, d, sizeof(d));
+    g_jitTestRecord.y = y;
+    g_jitTestRecord.p = p;
 }
 
-void Call_Test1()
+// Replaces the variadic argument of the entry point, which must be visible to all subsequent calls.
+static void JITTestSwapVarArg(const void** varArg)
 {
-    Test1(1, 2, 3, 4, 5, 6, 7, 8, 9);
+    *varArg = &g_jitTestRecord;
 }
 
-LLGL_EXPORT void TestJIT1()
+static void JITTestReadVarArg(const void* varArg)
 {
-    #if 0//TEST
-    //Test2(1.23f, 4.56);
-    Call_Test1();
-    #endif
-
-    auto comp = JITCompiler::Create();
+    g_jitTestRecord.varArgPtr = varArg;
+}
 
-    comp->EntryPointVarArgs({ JIT::ArgType::DWord, JIT::ArgType::Float, JIT::ArgType::Double });
+static void JITTestExpect(bool condition, const char* what)
+{
+    if (!condition)
+        throw std::runtime_error(std::string("JIT test failed: ") + what);
+}
 
-    comp->Begin();
+LLGL_EXPORT void TestJIT1()
+{
+    auto comp = JITCompiler::Create();
+    if (!comp)
+        throw std::runtime_error("JIT compiler is not supported for this architecture");
 
-    #if 1
-    #   if 0
-    comp->PushDWord(42);
-    #   else
-    comp->PushVarArg(0);
-    #   endif
-    comp->PushByte(-3);
-    comp->PushWord(0x40);
-    comp->PushQWord(999999ull);
-    comp->PushDWord(1);
-    comp->PushDWord(2);
-    comp->PushDWord(3);
-    comp->PushByte(4);
-    comp->PushQWord(888888ull);
-    comp->FuncCall(reinterpret_cast<const void*>(Test1));
+    comp->EntryPointVarArgs({ JIT::ArgType::DWord, JIT::ArgType::Double, JIT::ArgType::Double, JIT::ArgType::Ptr });
 
     int a[] = { 1, 2, 3 };
-    int b[] = { 4, 5, 6 };
-
-    comp->PushPtr(b);
-    comp->PushPtr(a);
-    comp->PushQWord(sizeof(a));
-    comp->FuncCall(reinterpret_cast<const void*>(::memcpy));
-    #endif
-
-    #if 1
-    #   if 0
-    comp->PushFloat(-1.2345f);
-    comp->PushDouble(3.14);
-    #   else
-    comp->PushVarArg(1);
-    comp->PushVarArg(2);
-    #   endif
-    comp->FuncCall(reinterpret_cast<const void*>(Test2));
-    #endif
+    int b[] = { 0, 0, 0 };
+    auto stackIdx = comp->StackAlloc(sizeof(a));
 
+    comp->Begin();
+    {
+        /* Integer arguments that exceed the parameter registers */
+        comp->PushVarArg(0);
+        comp->PushByte(0xFD);
+        comp->PushWord(0x40);
+        comp->PushQWord(999999ull);
+        comp->PushDWord(1);
+        comp->PushDWord(2);
+        comp->PushDWord(3);
+        comp->PushByte(4);
+        comp->PushQWord(888888ull);
+        comp->FuncCall(reinterpret_cast<const void*>(JITTestIntArgs));
+
+        /* Floating-point arguments that exceed the parameter registers */
+        comp->PushFloat(1.5f);
+        comp->PushVarArg(1);
+        comp->PushDWord(static_cast<std::uint32_t>(-7));
+        comp->PushFloat(-2.25f);
+        comp->PushVarArg(2);
+        comp->PushStackPtr(stackIdx);
+        comp->PushFloat(3.75f);
+        comp->PushDouble(-0.125);
+        comp->PushFloat(4.5f);
+        comp->PushDouble(1.0e10);
+        comp->PushFloat(-5.0f);
+        comp->PushDouble(6.25);
+        comp->FuncCall(reinterpret_cast<const void*>(JITTestMixedArgs));
+
+        /* Copy array through stack allocation */
+        comp->Call(::memcpy, JITStackPtr{ stackIdx }, a, sizeof(a));
+        comp->Call(::memcpy, b, JITStackPtr{ stackIdx }, sizeof(a));
+
+        /* Modify variadic argument through its address */
+        comp->Call(JITTestSwapVarArg, JITVarArgPtr{ 3 });
+        comp->Call(JITTestReadVarArg, JITVarArg{ 3 });
+    }
     comp->End();
 
     auto prog = comp->FlushProgram();
-
-    prog->GetEntryPoint()(28, 2.3f, 4.5);
+    prog->GetEntryPoint()(28, 2.3, 4.5, static_cast<const void*>(a));
+
+    /* Verify recorded arguments */
+    const auto& rec = g_jitTestRecord;
+    JITTestExpect(rec.x == 28, "integer variadic argument");
+    JITTestExpect(rec.b == 0xFD && rec.h == 0x40 && rec.q == 999999ull, "integer register arguments");
+    JITTestExpect(rec.i[0] == 1 && rec.i[1] == 2 && rec.i[2] == 3 && rec.b2 == 4 && rec.q2 == 888888ull, "integer stack arguments");
+    JITTestExpect(rec.f[0] == 1.5f && rec.f[1] == -2.25f && rec.f[2] == 3.75f && rec.f[3] == 4.5f && rec.f[4] == -5.0f, "float arguments");
+    JITTestExpect(rec.d[0] == 2.3 && rec.d[1] == 4.5, "double variadic arguments");
+    JITTestExpect(rec.d[2] == -0.125 && rec.d[3] == 1.0e10 && rec.d[4] == 6.25, "double arguments");
+    JITTestExpect(rec.y == -7, "integer argument between floating-point arguments");
+    JITTestExpect(rec.p != nullptr && rec.p != a, "stack pointer argument");
+    JITTestExpect(b[0] == 1 && b[1] == 2 && b[2] == 3, "stack allocation");
+    JITTestExpect(rec.varArgPtr == &g_jitTestRecord, "variadic argument pointer");
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
 }
 
 #endif // /LLGL_DEBUG
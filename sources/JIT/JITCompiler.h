@@ -45,6 +45,12 @@ struct JITStackPtr
     std::uint8_t index;
 };
 
+// Structure to pass the address of a variadic argument via the 'JITCompiler::Call' template function, so the callee can modify the argument for subsequent calls.
+struct JITVarArgPtr
+{
+    std::uint8_t index;
+};
+
 // IA-32 (a.k.a. x86) assembly code generator.
 class LLGL_EXPORT JITCompiler : public NonCopyable
 {
@@ -78,6 +84,9 @@ class LLGL_EXPORT JITCompiler : public NonCopyable
         // Pushes the entry point parameter, specified by the zero-based index 'idx', to the argument list.
         void PushVarArg(std::uint8_t idx);
 
+        // Pushes the address of the entry point parameter, specified by the zero-based index 'idx', to the argument list.
+        void PushVarArgPtr(std::uint8_t idx);
+
         // Pushes the ID of the specified stack allocation, specified by the zero-based index 'idx', to the argument list.
         void PushStackPtr(std::uint8_t idx);
 
@@ -265,6 +274,13 @@ inline void JITCompiler::PushVariant<JITVarArg>(JITVarArg arg)
     PushVarArg(arg.index);
 }
 
+// Template specialization
+template <>
+inline void JITCompiler::PushVariant<JITVarArgPtr>(JITVarArgPtr arg)
+{
+    PushVarArgPtr(arg.index);
+}
+
 // Template specialization
 template <>
 inline void JITCompiler::PushVariant<JITStackPtr>(JITStackPtr arg)
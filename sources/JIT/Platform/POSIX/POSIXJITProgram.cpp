@@ -45,7 +45,7 @@ POSIXJITProgram::POSIXJITProgram(const void* code, std::size_t size) :
     SetEntryPoint(addr_);
 }
 
-POSIXJITProgram::POSIXJITProgram()
+POSIXJITProgram::~POSIXJITProgram()
 {
     munmap(addr_, size_);
 }
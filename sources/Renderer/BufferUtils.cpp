@@ -33,6 +33,16 @@ LLGL_EXPORT long GetCombinedBindFlags(std::uint32_t numBuffers, Buffer* const *
     return bindFlags;
 }
 
+LLGL_EXPORT bool IsReadbackBuffer(const BufferDescriptor& desc)
+{
+    return
+    (
+        desc.cpuAccessFlags == CPUAccessFlags::Read                         &&
+        (desc.bindFlags & ~(BindFlags::CopySrc | BindFlags::CopyDst)) == 0  &&
+        (desc.miscFlags & MiscFlags::DynamicUsage) == 0
+    );
+}
+
 
 } // /namespace LLGL
 
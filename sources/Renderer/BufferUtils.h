@@ -29,6 +29,9 @@ LLGL_EXPORT std::uint32_t GetStorageBufferStride(const BufferDescriptor& desc);
 // Returns the bitwise-OR combined binding flags of the specified array of buffers.
 LLGL_EXPORT long GetCombinedBindFlags(std::uint32_t numBuffers, Buffer* const * bufferArray);
 
+// Returns true if the specified buffer descriptor describes a readback buffer, i.e. a buffer that is only used as copy destination for CPU read access.
+LLGL_EXPORT bool IsReadbackBuffer(const BufferDescriptor& desc);
+
 // Returns true if the buffer-view in the specified resource-view descriptor is enabled.
 inline bool IsBufferViewEnabled(const BufferViewDescriptor& bufferViewDesc)
 {
@@ -0,0 +1,184 @@
+/*
+ * CaptureFormat.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAPTURE_FORMAT_H
+#define LLGL_CAPTURE_FORMAT_H
+
+
+#include "Serialization.h"
+#include <LLGL/RenderSystemFlags.h>
+#include <cstdint>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/*
+Layout of a capture file:
+
+Offset      Content
+0x00000000  CaptureFileHeader
+0x00000018  |-chunks[0].size            = <size of chunk in bytes>
+0x00000020  |-chunks[0].data[0..size-1] = <serialization blob of segments>
+...         `-chunks[N-1]
+
+Each chunk is the blob of a Serializer and contains one segment per captured call.
+Chunks are written at each frame boundary (i.e. SwapChain::Present) and when the capture ends.
+All renderer objects are referenced by a CaptureObjectID, which is unique during the entire capture; zero refers to a null pointer.
+Descriptor structures without pointers or containers are stored as they are, so captures can only be replayed with the same version of LLGL
+on a platform with the same data model, which is verified by the file header.
+*/
+
+
+/* ----- Types ----- */
+
+// Identifier of a renderer object within a capture.
+using CaptureObjectID = std::uint32_t;
+
+
+/* ----- Enumerations ----- */
+
+/*
+Segment identifiers for captured calls. The comments describe the content of each segment in the order it is written.
+Flags of type 'long' are always stored as std::int64_t and data blocks are always preceded by their size as std::uint64_t.
+*/
+enum CaptureIdent : IdentType
+{
+    CaptureIdent_ReservedCapture = (RendererID::Reserved << 8),
+
+    /* ----- Render system ----- */
+    CaptureIdent_CreateSwapChain,           // id, renderPassID, SwapChainDescriptor
+    CaptureIdent_CreateCommandBuffer,       // id, flags, numNativeBuffers
+    CaptureIdent_CreateBuffer,              // id, size, stride, format, bindFlags, cpuAccessFlags, miscFlags, numVertexAttribs, { CaptureVertexAttribute, name }[numVertexAttribs], data
+    CaptureIdent_CreateBufferArray,         // id, numBuffers, bufferIDs[numBuffers]
+    CaptureIdent_CreateTexture,             // id, TextureDescriptor, hasImage, [ ImageFormat, DataType, data ]
+    CaptureIdent_CreateSampler,             // id, SamplerDescriptor
+    CaptureIdent_CreateResourceHeap,        // id, pipelineLayoutID, numResourceViews, { resourceID, TextureViewDescriptor, BufferViewDescriptor }[numResourceViews]
+    CaptureIdent_CreateRenderPass,          // id, numColorAttachments, AttachmentFormatDescriptor[numColorAttachments], depthAttachment, stencilAttachment, samples
+    CaptureIdent_CreateRenderTarget,        // id, renderPassID, resolution, samples, customMultiSampling, numAttachments, { type, textureID, mipLevel, arrayLayer }[numAttachments]
+    CaptureIdent_CreateShader,              // id, type, sourceType, flags, source data, entryPoint, profile, numDefines, { name, definition }[numDefines], vertex/fragment attributes, workGroupSize
+    CaptureIdent_CreateShaderProgram,       // id, shaderIDs[6]
+    CaptureIdent_CreatePipelineLayout,      // id, numBindings, { name, type, bindFlags, stageFlags, slot, arraySize }[numBindings]
+    CaptureIdent_CreateGraphicsPipeline,    // id, pipelineLayoutID, shaderProgramID, renderPassID, topology, viewports, scissors, depth, stencil, rasterizer, blend, tessellation
+    CaptureIdent_CreateComputePipeline,     // id, pipelineLayoutID, shaderProgramID
+    CaptureIdent_Release,                   // id
+    CaptureIdent_WriteBuffer,               // bufferID, dstOffset, data
+    CaptureIdent_WriteTexture,              // textureID, TextureRegion, ImageFormat, DataType, data
+
+    /* ----- Command queue and swap-chain ----- */
+    CaptureIdent_Submit,                    // commandBufferID
+    CaptureIdent_Present,                   // swapChainID; marks the end of a frame
+
+    /* ----- Command buffer (each segment begins with the ID of the command buffer that encodes the command) ----- */
+    CaptureIdent_Begin,                     // commandBufferID
+    CaptureIdent_End,                       // commandBufferID
+    CaptureIdent_Execute,                   // commandBufferID, deferredCommandBufferID
+    CaptureIdent_UpdateBuffer,              // commandBufferID, bufferID, dstOffset, data
+    CaptureIdent_CopyBuffer,                // commandBufferID, dstBufferID, dstOffset, srcBufferID, srcOffset, size
+    CaptureIdent_FillBuffer,                // commandBufferID, bufferID, dstOffset, value, fillSize
+    CaptureIdent_CopyTexture,               // commandBufferID, dstTextureID, TextureLocation, srcTextureID, TextureLocation, Extent3D
+    CaptureIdent_GenerateMips,              // commandBufferID, textureID, hasSubresource, [ TextureSubresource ]
+    CaptureIdent_SetViewports,              // commandBufferID, data of Viewport[]
+    CaptureIdent_SetScissors,               // commandBufferID, data of Scissor[]
+    CaptureIdent_SetVertexBuffer,           // commandBufferID, bufferID
+    CaptureIdent_SetVertexBufferArray,      // commandBufferID, bufferArrayID
+    CaptureIdent_SetIndexBuffer,            // commandBufferID, bufferID, format (Format::Undefined for the buffer's own format), offset
+    CaptureIdent_SetResourceHeap,           // commandBufferID, resourceHeapID, firstSet, bindPoint
+    CaptureIdent_SetResource,               // commandBufferID, resourceID, slot, bindFlags, stageFlags
+    CaptureIdent_ResetResourceSlots,        // commandBufferID, resourceType, firstSlot, numSlots, bindFlags, stageFlags
+    CaptureIdent_BeginRenderPass,           // commandBufferID, renderTargetID, renderPassID, data of ClearValue[]
+    CaptureIdent_EndRenderPass,             // commandBufferID
+    CaptureIdent_Clear,                     // commandBufferID, flags, ClearValue
+    CaptureIdent_ClearAttachments,          // commandBufferID, data of AttachmentClear[]
+    CaptureIdent_SetPipelineState,          // commandBufferID, pipelineStateID
+    CaptureIdent_SetBlendFactor,            // commandBufferID, ColorRGBAf
+    CaptureIdent_SetStencilReference,       // commandBufferID, reference, stencilFace
+    CaptureIdent_SetUniforms,               // commandBufferID, location, count, data
+    CaptureIdent_Draw,                      // commandBufferID, numVertices, firstVertex, numInstances, firstInstance
+    CaptureIdent_DrawIndexed,               // commandBufferID, numIndices, firstIndex, vertexOffset, numInstances, firstInstance
+    CaptureIdent_DrawIndirect,              // commandBufferID, bufferID, offset, numCommands, stride
+    CaptureIdent_DrawIndexedIndirect,       // commandBufferID, bufferID, offset, numCommands, stride
+    CaptureIdent_Dispatch,                  // commandBufferID, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ
+    CaptureIdent_DispatchIndirect,          // commandBufferID, bufferID, offset
+    CaptureIdent_PushDebugGroup,            // commandBufferID, name
+    CaptureIdent_PopDebugGroup,             // commandBufferID
+};
+
+
+/* ----- Structures ----- */
+
+// Header at the beginning of each capture file.
+struct CaptureFileHeader
+{
+    char            magic[8];       // "LLGLCAP"
+    std::uint32_t   version;        // CaptureFileHeader::currentVersion
+    std::uint16_t   sizeOfLong;     // sizeof(long) of the platform the capture was recorded on
+    std::uint16_t   sizeOfPointer;  // sizeof(void*) of the platform the capture was recorded on
+    std::uint64_t   reserved;
+
+    static const std::uint32_t currentVersion = 1;
+};
+
+// Vertex or fragment attribute without its name. The name is stored as null terminated string after this structure.
+struct CaptureVertexAttribute
+{
+    std::uint32_t   format;
+    std::uint32_t   location;
+    std::uint32_t   semanticIndex;
+    std::uint32_t   systemValue;
+    std::uint32_t   slot;
+    std::uint32_t   offset;
+    std::uint32_t   stride;
+    std::uint32_t   instanceDivisor;
+};
+
+
+/* ----- Functions ----- */
+
+// Returns the capture file header for the current platform.
+inline CaptureFileHeader GetCaptureFileHeader()
+{
+    CaptureFileHeader header = {};
+    {
+        std::memcpy(header.magic, "LLGLCAP", sizeof(header.magic));
+        header.version          = CaptureFileHeader::currentVersion;
+        header.sizeOfLong       = static_cast<std::uint16_t>(sizeof(long));
+        header.sizeOfPointer    = static_cast<std::uint16_t>(sizeof(void*));
+        header.reserved         = 0;
+    }
+    return header;
+}
+
+// Returns true if the specified capture file header can be replayed on the current platform.
+inline bool IsCaptureFileHeaderCompatible(const CaptureFileHeader& header)
+{
+    const auto expected = GetCaptureFileHeader();
+    return
+    (
+        std::memcmp(header.magic, expected.magic, sizeof(header.magic)) == 0 &&
+        header.version          == expected.version     &&
+        header.sizeOfLong       == expected.sizeOfLong  &&
+        header.sizeOfPointer    == expected.sizeOfPointer
+    );
+}
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,463 @@
+/*
+ * CaptureWriter.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "CaptureWriter.h"
+#include "../Core/Helper.h"
+#include <LLGL/SwapChain.h>
+#include <LLGL/CommandBuffer.h>
+#include <LLGL/Buffer.h>
+#include <LLGL/BufferArray.h>
+#include <LLGL/Texture.h>
+#include <LLGL/Sampler.h>
+#include <LLGL/ResourceHeap.h>
+#include <LLGL/RenderPass.h>
+#include <LLGL/RenderTarget.h>
+#include <LLGL/Shader.h>
+#include <LLGL/ShaderProgram.h>
+#include <LLGL/PipelineLayout.h>
+#include <LLGL/PipelineState.h>
+#include <LLGL/ImageFlags.h>
+#include <LLGL/ResourceHeapFlags.h>
+#include <LLGL/RenderPassFlags.h>
+#include <cstring>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+using namespace Serialization;
+
+static CaptureVertexAttribute ToCaptureAttribute(const VertexAttribute& attrib)
+{
+    CaptureVertexAttribute dst;
+    {
+        dst.format          = static_cast<std::uint32_t>(attrib.format);
+        dst.location        = attrib.location;
+        dst.semanticIndex   = attrib.semanticIndex;
+        dst.systemValue     = static_cast<std::uint32_t>(attrib.systemValue);
+        dst.slot            = attrib.slot;
+        dst.offset          = attrib.offset;
+        dst.stride          = attrib.stride;
+        dst.instanceDivisor = attrib.instanceDivisor;
+    }
+    return dst;
+}
+
+static CaptureVertexAttribute ToCaptureAttribute(const FragmentAttribute& attrib)
+{
+    CaptureVertexAttribute dst = {};
+    {
+        dst.format          = static_cast<std::uint32_t>(attrib.format);
+        dst.location        = attrib.location;
+        dst.systemValue     = static_cast<std::uint32_t>(attrib.systemValue);
+    }
+    return dst;
+}
+
+CaptureWriter::CaptureWriter(const char* filename) :
+    file_ { filename, std::ios::out | std::ios::binary }
+{
+    if (!file_.good())
+        throw std::runtime_error("failed to open capture file: " + std::string(filename));
+
+    const auto header = GetCaptureFileHeader();
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+CaptureWriter::~CaptureWriter()
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    FlushChunk();
+}
+
+/* ----- Render system ----- */
+
+void CaptureWriter::CreateSwapChain(const SwapChain& swapChain, const SwapChainDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateSwapChain);
+    {
+        WriteArgs(RegisterObject(&swapChain), RegisterObject(swapChain.GetRenderPass()), desc);
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateCommandBuffer(const CommandBuffer& commandBuffer, const CommandBufferDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateCommandBuffer);
+    {
+        WriteArgs(RegisterObject(&commandBuffer), desc.flags, desc.numNativeBuffers);
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateBuffer(const Buffer& buffer, const BufferDescriptor& desc, const void* initialData)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateBuffer);
+    {
+        WriteArgs(RegisterObject(&buffer), desc.size, desc.stride, desc.format, desc.bindFlags, desc.cpuAccessFlags, desc.miscFlags);
+
+        WriteArg(static_cast<std::uint32_t>(desc.vertexAttribs.size()));
+        for (const auto& attrib : desc.vertexAttribs)
+            WriteArgs(ToCaptureAttribute(attrib), attrib.name.c_str());
+
+        WriteArg(CaptureDataRef{ initialData, (initialData != nullptr ? desc.size : 0) });
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateBufferArray(const BufferArray& bufferArray, std::uint32_t numBuffers, Buffer* const * buffers)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateBufferArray);
+    {
+        WriteArgs(RegisterObject(&bufferArray), numBuffers);
+        for (std::uint32_t i = 0; i < numBuffers; ++i)
+            WriteArg(CaptureObjectRef{ buffers[i] });
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateTexture(const Texture& texture, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateTexture);
+    {
+        WriteArgs(RegisterObject(&texture), desc);
+        if (imageDesc != nullptr && imageDesc->data != nullptr)
+            WriteArgs(std::uint8_t(1), imageDesc->format, imageDesc->dataType, CaptureDataRef{ imageDesc->data, imageDesc->dataSize });
+        else
+            WriteArg(std::uint8_t(0));
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateSampler(const Sampler& sampler, const SamplerDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateSampler);
+    {
+        WriteArgs(RegisterObject(&sampler), desc);
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateResourceHeap(const ResourceHeap& resourceHeap, const ResourceHeapDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateResourceHeap);
+    {
+        WriteArgs(RegisterObject(&resourceHeap), CaptureObjectRef{ desc.pipelineLayout }, static_cast<std::uint32_t>(desc.resourceViews.size()));
+        for (const auto& resourceView : desc.resourceViews)
+            WriteArgs(CaptureObjectRef{ resourceView.resource }, resourceView.textureView, resourceView.bufferView);
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateRenderPass(const RenderPass& renderPass, const RenderPassDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateRenderPass);
+    {
+        WriteArgs(RegisterObject(&renderPass), static_cast<std::uint32_t>(desc.colorAttachments.size()));
+        for (const auto& attachment : desc.colorAttachments)
+            WriteArg(attachment);
+        WriteArgs(desc.depthAttachment, desc.stencilAttachment, desc.samples);
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateRenderTarget(const RenderTarget& renderTarget, const RenderTargetDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateRenderTarget);
+    {
+        WriteArgs(
+            RegisterObject(&renderTarget),
+            CaptureObjectRef{ desc.renderPass },
+            desc.resolution,
+            desc.samples,
+            desc.customMultiSampling,
+            static_cast<std::uint32_t>(desc.attachments.size())
+        );
+        for (const auto& attachment : desc.attachments)
+            WriteArgs(attachment.type, CaptureObjectRef{ attachment.texture }, attachment.mipLevel, attachment.arrayLayer);
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateShader(const Shader& shader, const ShaderDescriptor& desc)
+{
+    /* Read source files before locking, so the capture contains the shader code instead of filenames */
+    std::string         sourceString;
+    std::vector<char>   sourceBuffer;
+    auto                sourceType  = desc.sourceType;
+    const void*         sourceData  = desc.source;
+    std::size_t         sourceSize  = desc.sourceSize;
+
+    switch (desc.sourceType)
+    {
+        case ShaderSourceType::CodeString:
+            if (sourceSize == 0 && desc.source != nullptr)
+                sourceSize = std::strlen(desc.source);
+            break;
+        case ShaderSourceType::CodeFile:
+            sourceString    = ReadFileString(desc.source);
+            sourceType      = ShaderSourceType::CodeString;
+            sourceData      = sourceString.data();
+            sourceSize      = sourceString.size();
+            break;
+        case ShaderSourceType::BinaryBuffer:
+            break;
+        case ShaderSourceType::BinaryFile:
+            sourceBuffer    = ReadFileBuffer(desc.source);
+            sourceType      = ShaderSourceType::BinaryBuffer;
+            sourceData      = sourceBuffer.data();
+            sourceSize      = sourceBuffer.size();
+            break;
+    }
+
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateShader);
+    {
+        WriteArgs(
+            RegisterObject(&shader),
+            desc.type,
+            sourceType,
+            desc.flags,
+            CaptureDataRef{ sourceData, sourceSize },
+            (desc.entryPoint != nullptr ? desc.entryPoint : ""),
+            (desc.profile != nullptr ? desc.profile : "")
+        );
+
+        /* Write macro definitions, which are terminated by an entry with a null pointer name */
+        std::uint32_t numDefines = 0;
+        if (desc.defines != nullptr)
+        {
+            while (desc.defines[numDefines].name != nullptr)
+                ++numDefines;
+        }
+
+        WriteArg(numDefines);
+        for (std::uint32_t i = 0; i < numDefines; ++i)
+        {
+            const auto& macro = desc.defines[i];
+            WriteArgs(macro.name, (macro.definition != nullptr ? macro.definition : ""));
+        }
+
+        /* Write shader reflection attributes */
+        WriteArg(static_cast<std::uint32_t>(desc.vertex.inputAttribs.size()));
+        for (const auto& attrib : desc.vertex.inputAttribs)
+            WriteArgs(ToCaptureAttribute(attrib), attrib.name.c_str());
+
+        WriteArg(static_cast<std::uint32_t>(desc.vertex.outputAttribs.size()));
+        for (const auto& attrib : desc.vertex.outputAttribs)
+            WriteArgs(ToCaptureAttribute(attrib), attrib.name.c_str());
+
+        WriteArg(static_cast<std::uint32_t>(desc.fragment.outputAttribs.size()));
+        for (const auto& attrib : desc.fragment.outputAttribs)
+            WriteArgs(ToCaptureAttribute(attrib), attrib.name.c_str());
+
+        WriteArg(desc.compute.workGroupSize);
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreateShaderProgram(const ShaderProgram& shaderProgram, const ShaderProgramDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateShaderProgram);
+    {
+        WriteArgs(
+            RegisterObject(&shaderProgram),
+            CaptureObjectRef{ desc.vertexShader },
+            CaptureObjectRef{ desc.tessControlShader },
+            CaptureObjectRef{ desc.tessEvaluationShader },
+            CaptureObjectRef{ desc.geometryShader },
+            CaptureObjectRef{ desc.fragmentShader },
+            CaptureObjectRef{ desc.computeShader }
+        );
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreatePipelineLayout(const PipelineLayout& pipelineLayout, const PipelineLayoutDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreatePipelineLayout);
+    {
+        WriteArgs(RegisterObject(&pipelineLayout), static_cast<std::uint32_t>(desc.bindings.size()));
+        for (const auto& binding : desc.bindings)
+            WriteArgs(binding.name.c_str(), binding.type, binding.bindFlags, binding.stageFlags, binding.slot, binding.arraySize);
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreatePipelineState(const PipelineState& pipelineState, const GraphicsPipelineDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateGraphicsPipeline);
+    {
+        WriteArgs(
+            RegisterObject(&pipelineState),
+            CaptureObjectRef{ desc.pipelineLayout },
+            CaptureObjectRef{ desc.shaderProgram },
+            CaptureObjectRef{ desc.renderPass },
+            desc.primitiveTopology
+        );
+
+        WriteArg(static_cast<std::uint32_t>(desc.viewports.size()));
+        for (const auto& viewport : desc.viewports)
+            WriteArg(viewport);
+
+        WriteArg(static_cast<std::uint32_t>(desc.scissors.size()));
+        for (const auto& scissor : desc.scissors)
+            WriteArg(scissor);
+
+        WriteArgs(desc.depth, desc.stencil, desc.rasterizer, desc.blend, desc.tessellation);
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::CreatePipelineState(const PipelineState& pipelineState, const ComputePipelineDescriptor& desc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_CreateComputePipeline);
+    {
+        WriteArgs(RegisterObject(&pipelineState), CaptureObjectRef{ desc.pipelineLayout }, CaptureObjectRef{ desc.shaderProgram });
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::Release(const void* object)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    auto it = objectIDs_.find(object);
+    if (it != objectIDs_.end())
+    {
+        serializer_.WriteSegment(CaptureIdent_Release, &(it->second), sizeof(it->second));
+        objectIDs_.erase(it);
+    }
+}
+
+void CaptureWriter::Release(const SwapChain& swapChain)
+{
+    Release(&swapChain);
+    std::lock_guard<std::mutex> guard { mutex_ };
+    objectIDs_.erase(swapChain.GetRenderPass());
+}
+
+void CaptureWriter::WriteBuffer(const Buffer& buffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_WriteBuffer);
+    {
+        WriteArgs(CaptureObjectRef{ &buffer }, dstOffset, CaptureDataRef{ data, dataSize });
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::WriteTexture(const Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_WriteTexture);
+    {
+        WriteArgs(CaptureObjectRef{ &texture }, textureRegion, imageDesc.format, imageDesc.dataType, CaptureDataRef{ imageDesc.data, imageDesc.dataSize });
+    }
+    serializer_.End();
+}
+
+/* ----- Command queue and swap-chain ----- */
+
+void CaptureWriter::Submit(const CommandBuffer& commandBuffer)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_Submit);
+    {
+        WriteArg(CaptureObjectRef{ &commandBuffer });
+    }
+    serializer_.End();
+}
+
+void CaptureWriter::Present(const SwapChain& swapChain)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+    serializer_.Begin(CaptureIdent_Present);
+    {
+        WriteArg(CaptureObjectRef{ &swapChain });
+    }
+    serializer_.End();
+    FlushChunk();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+CaptureObjectID CaptureWriter::RegisterObject(const void* object)
+{
+    const auto id = nextObjectID_++;
+    objectIDs_[object] = id;
+    return id;
+}
+
+CaptureObjectID CaptureWriter::GetObjectID(const void* object) const
+{
+    if (object != nullptr)
+    {
+        auto it = objectIDs_.find(object);
+        if (it != objectIDs_.end())
+            return it->second;
+    }
+    return 0;
+}
+
+void CaptureWriter::FlushChunk()
+{
+    if (auto blob = serializer_.Finalize())
+    {
+        const auto size = static_cast<std::uint64_t>(blob->GetSize());
+        file_.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        file_.write(reinterpret_cast<const char*>(blob->GetData()), static_cast<std::streamsize>(size));
+        file_.flush();
+    }
+}
+
+void CaptureWriter::WriteArg(const CaptureObjectRef& ref)
+{
+    WriteArg(GetObjectID(ref.object));
+}
+
+void CaptureWriter::WriteArg(const CaptureDataRef& ref)
+{
+    const auto size = (ref.data != nullptr ? ref.size : 0);
+    serializer_.WriteTyped(size);
+    if (size > 0)
+        serializer_.Write(ref.data, static_cast<std::size_t>(size));
+}
+
+void CaptureWriter::WriteArg(const char* str)
+{
+    serializer_.WriteCString(str);
+}
+
+void CaptureWriter::WriteArg(long value)
+{
+    serializer_.WriteTyped(static_cast<std::int64_t>(value));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
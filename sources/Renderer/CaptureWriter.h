@@ -0,0 +1,179 @@
+/*
+ * CaptureWriter.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_CAPTURE_WRITER_H
+#define LLGL_CAPTURE_WRITER_H
+
+
+#include "CaptureFormat.h"
+#include <LLGL/ForwardDecls.h>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <unordered_map>
+
+
+namespace LLGL
+{
+
+
+// Reference to an object that is written as its CaptureObjectID.
+struct CaptureObjectRef
+{
+    const void*     object;
+};
+
+// Reference to a block of data that is written with its size.
+struct CaptureDataRef
+{
+    const void*     data;
+    std::uint64_t   size;
+};
+
+class CaptureWriter;
+
+/*
+Interface for the source of all renderer objects that are alive when a capture begins, i.e. the debug layer render system.
+The objects are written as if they were created at the beginning of the capture, so the capture can reference them.
+*/
+class CaptureObjectSource
+{
+
+    public:
+
+        virtual ~CaptureObjectSource() = default;
+
+        // Writes the creation of all live objects in an order that respects their dependencies.
+        virtual void CaptureLiveObjects(CaptureWriter& capture) = 0;
+
+};
+
+/*
+Serializes resource creation, uploads, and command streams into a capture file (see CaptureFormat.h).
+Objects are identified by the addresses the client programmer sees, i.e. the debug layer objects where they exist.
+The segments are accumulated in memory and written to the file as one chunk per frame.
+All functions are thread-safe.
+*/
+class CaptureWriter
+{
+
+    public:
+
+        // Opens the capture file and writes the file header or throws std::runtime_error on failure.
+        CaptureWriter(const char* filename);
+
+        // Writes all remaining segments and closes the capture file.
+        ~CaptureWriter();
+
+        CaptureWriter(const CaptureWriter&) = delete;
+        CaptureWriter& operator = (const CaptureWriter&) = delete;
+
+        /* ----- Render system ----- */
+
+        void CreateSwapChain(const SwapChain& swapChain, const SwapChainDescriptor& desc);
+        void CreateCommandBuffer(const CommandBuffer& commandBuffer, const CommandBufferDescriptor& desc);
+        void CreateBuffer(const Buffer& buffer, const BufferDescriptor& desc, const void* initialData);
+        void CreateBufferArray(const BufferArray& bufferArray, std::uint32_t numBuffers, Buffer* const * buffers);
+        void CreateTexture(const Texture& texture, const TextureDescriptor& desc, const SrcImageDescriptor* imageDesc);
+        void CreateSampler(const Sampler& sampler, const SamplerDescriptor& desc);
+        void CreateResourceHeap(const ResourceHeap& resourceHeap, const ResourceHeapDescriptor& desc);
+        void CreateRenderPass(const RenderPass& renderPass, const RenderPassDescriptor& desc);
+        void CreateRenderTarget(const RenderTarget& renderTarget, const RenderTargetDescriptor& desc);
+        void CreateShader(const Shader& shader, const ShaderDescriptor& desc);
+        void CreateShaderProgram(const ShaderProgram& shaderProgram, const ShaderProgramDescriptor& desc);
+        void CreatePipelineLayout(const PipelineLayout& pipelineLayout, const PipelineLayoutDescriptor& desc);
+        void CreatePipelineState(const PipelineState& pipelineState, const GraphicsPipelineDescriptor& desc);
+        void CreatePipelineState(const PipelineState& pipelineState, const ComputePipelineDescriptor& desc);
+
+        // Writes the release of the specified object. This must be called before the object is destroyed, since its address might be reused afterwards.
+        void Release(const void* object);
+
+        // Writes the release of the specified swap-chain and also unregisters its render pass.
+        void Release(const SwapChain& swapChain);
+
+        void WriteBuffer(const Buffer& buffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize);
+        void WriteTexture(const Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc);
+
+        /* ----- Command queue and swap-chain ----- */
+
+        void Submit(const CommandBuffer& commandBuffer);
+
+        // Writes the end of a frame and flushes all segments of this frame to the file.
+        void Present(const SwapChain& swapChain);
+
+        /* ----- Command buffer ----- */
+
+        /*
+        Writes a command that was encoded into the specified command buffer.
+        Arguments are written in order: CaptureObjectRef as CaptureObjectID, CaptureDataRef as size and data, 'long' as std::int64_t, strings with null terminator,
+        and all other types as they are.
+        */
+        template <typename... TArgs>
+        void WriteCommand(Serialization::CaptureIdent ident, const CommandBuffer& commandBuffer, const TArgs&... args)
+        {
+            std::lock_guard<std::mutex> guard { mutex_ };
+            serializer_.Begin(ident);
+            {
+                WriteArgs(CaptureObjectRef{ &commandBuffer }, args...);
+            }
+            serializer_.End();
+        }
+
+    private:
+
+        // Registers the specified object with a new ID and returns that ID.
+        Serialization::CaptureObjectID RegisterObject(const void* object);
+
+        // Returns the ID of the specified object, or zero if the object is null or was created before the capture began.
+        Serialization::CaptureObjectID GetObjectID(const void* object) const;
+
+        // Writes the accumulated segments as a new chunk to the file.
+        void FlushChunk();
+
+        void WriteArg(const CaptureObjectRef& ref);
+        void WriteArg(const CaptureDataRef& ref);
+        void WriteArg(const char* str);
+        void WriteArg(long value);
+
+        template <typename T>
+        void WriteArg(const T& value)
+        {
+            serializer_.WriteTyped(value);
+        }
+
+        void WriteArgs()
+        {
+            // dummy
+        }
+
+        template <typename TFirst, typename... TNext>
+        void WriteArgs(const TFirst& first, const TNext&... next)
+        {
+            WriteArg(first);
+            WriteArgs(next...);
+        }
+
+    private:
+
+        std::ofstream                                                   file_;
+
+        std::mutex                                                      mutex_;
+        Serialization::Serializer                                       serializer_;
+        std::unordered_map<const void*, Serialization::CaptureObjectID> objectIDs_;
+        Serialization::CaptureObjectID                                  nextObjectID_   = 1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,25 @@
+/*
+ * CommandQueue.cpp
+ * 
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/CommandQueue.h>
+
+
+namespace LLGL
+{
+
+
+bool CommandQueue::QueryFence(Fence& fence)
+{
+    return WaitFence(fence, 0);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -340,6 +340,14 @@ void DXGetRenderingCaps(RenderingCapabilities& caps, D3D_FEATURE_LEVEL featureLe
         );
     }
 
+    if (featureLevel >= D3D_FEATURE_LEVEL_11_0)
+    {
+        caps.textureFormats.insert(
+            caps.textureFormats.end(),
+            { Format::BC7UNorm, Format::BC7UNorm_sRGB }
+        );
+    }
+
     /* Query features */
     caps.features.hasRenderTargets                  = true;
     caps.features.has3DTextures                     = true;
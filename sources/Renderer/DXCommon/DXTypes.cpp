@@ -172,6 +172,8 @@ DXGI_FORMAT Map(const Format format)
         case Format::BC4SNorm:          return DXGI_FORMAT_BC4_SNORM;
         case Format::BC5UNorm:          return DXGI_FORMAT_BC5_UNORM;
         case Format::BC5SNorm:          return DXGI_FORMAT_BC5_SNORM;
+        case Format::BC7UNorm:          return DXGI_FORMAT_BC7_UNORM;
+        case Format::BC7UNorm_sRGB:     return DXGI_FORMAT_BC7_UNORM_SRGB;
     }
     MapFailed("Format", "DXGI_FORMAT");
 }
@@ -316,6 +318,8 @@ Format Unmap(const DXGI_FORMAT format)
         case DXGI_FORMAT_BC4_SNORM:                 return Format::BC4SNorm;
         case DXGI_FORMAT_BC5_UNORM:                 return Format::BC5UNorm;
         case DXGI_FORMAT_BC5_SNORM:                 return Format::BC5SNorm;
+        case DXGI_FORMAT_BC7_UNORM:                 return Format::BC7UNorm;
+        case DXGI_FORMAT_BC7_UNORM_SRGB:            return Format::BC7UNorm_sRGB;
 
         default:                                    return Format::Undefined;
     }
@@ -9,6 +9,7 @@
 #include "DbgCore.h"
 #include "../CheckedCast.h"
 #include "../ResourceUtils.h"
+#include "../ProfilerTraceWriter.h"
 #include "../../Core/Helper.h"
 
 #include "DbgSwapChain.h"
@@ -32,6 +33,8 @@ namespace LLGL
 {
 
 
+using namespace Serialization;
+
 #define LLGL_DBG_COMMAND(NAME, CMD) \
     if (perfProfilerEnabled_)       \
     {                               \
@@ -80,15 +83,27 @@ void DbgCommandBuffer::Begin()
     ResetBindings();
     ResetStates();
 
-    /* Enable performance profiler if it was scheduled */
-    perfProfilerEnabled_ = (profiler_ != nullptr && profiler_->timeRecordingEnabled);
+    /* Enable performance profiler if it was scheduled; timer queries are also required for the GPU timeline of a trace capture */
+    traceWriter_ = (profiler_ != nullptr ? profiler_->GetTraceWriter() : nullptr);
+    perfProfilerEnabled_ = (profiler_ != nullptr && (profiler_->timeRecordingEnabled || traceWriter_ != nullptr));
     if (perfProfilerEnabled_)
         timerMngr_.Reset();
 
+    if (traceWriter_)
+    {
+        encodingStartTime_ = traceWriter_->Now();
+        traceGroups_.clear();
+    }
+
     /* Begin with command recording  */
     if (debugger_)
         EnableRecording(true);
 
+    /* Capture the entire encoding of this command buffer or nothing of it */
+    capture_ = DbgGetCaptureWriter(debugger_);
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_Begin, *this);
+
     instance.Begin();
 
     profile_.commandBufferEncodings++;
@@ -99,11 +114,23 @@ void DbgCommandBuffer::End()
     /* End with command recording */
     if (debugger_)
         EnableRecording(false);
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_End, *this);
     instance.End();
 
+    /* Write CPU time of command encoding before waiting for the timer queries */
+    if (traceWriter_)
+        traceWriter_->WriteCPUEvent("CommandBuffer", "Encoding", encodingStartTime_);
+
     /* Resolve timer query results for performance profiler */
     if (perfProfilerEnabled_)
+    {
         timerMngr_.TakeRecords(profile_.timeRecords);
+        if (traceWriter_)
+            WriteGPUTraceEvents(profile_.timeRecords);
+        if (!profiler_->timeRecordingEnabled)
+            profile_.timeRecords.clear();
+    }
 }
 
 void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
@@ -125,6 +152,9 @@ void DbgCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
         );
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_Execute, *this, CaptureObjectRef{ &commandBufferDbg });
+
     LLGL_DBG_COMMAND( "Execute", instance.Execute(commandBufferDbg.instance) );
 }
 
@@ -145,6 +175,9 @@ void DbgCommandBuffer::UpdateBuffer(
         ValidateBufferRange(dstBufferDbg, dstOffset, dataSize, "destination range");
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_UpdateBuffer, *this, CaptureObjectRef{ &dstBufferDbg }, dstOffset, CaptureDataRef{ data, dataSize });
+
     LLGL_DBG_COMMAND( "UpdateBuffer", instance.UpdateBuffer(dstBufferDbg.instance, dstOffset, data, dataSize) );
 
     profile_.bufferUpdates++;
@@ -170,6 +203,9 @@ void DbgCommandBuffer::CopyBuffer(
         ValidateBindBufferFlags(srcBufferDbg, BindFlags::CopySrc);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_CopyBuffer, *this, CaptureObjectRef{ &dstBufferDbg }, dstOffset, CaptureObjectRef{ &srcBufferDbg }, srcOffset, size);
+
     LLGL_DBG_COMMAND( "CopyBuffer", instance.CopyBuffer(dstBufferDbg.instance, dstOffset, srcBufferDbg.instance, srcOffset, size) );
 
     profile_.bufferCopies++;
@@ -230,6 +266,9 @@ void DbgCommandBuffer::FillBuffer(
         }
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_FillBuffer, *this, CaptureObjectRef{ &dstBufferDbg }, dstOffset, value, fillSize);
+
     LLGL_DBG_COMMAND( "FillBuffer", instance.FillBuffer(dstBufferDbg.instance, dstOffset, value, fillSize) );
 
     profile_.bufferFills++;
@@ -253,6 +292,9 @@ void DbgCommandBuffer::CopyTexture(
         ValidateBindTextureFlags(srcTextureDbg, BindFlags::CopySrc);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_CopyTexture, *this, CaptureObjectRef{ &dstTextureDbg }, dstLocation, CaptureObjectRef{ &srcTextureDbg }, srcLocation, extent);
+
     LLGL_DBG_COMMAND( "CopyTexture", instance.CopyTexture(dstTextureDbg.instance, dstLocation, srcTextureDbg.instance, srcLocation, extent) );
 
     profile_.textureCopies++;
@@ -297,6 +339,9 @@ void DbgCommandBuffer::GenerateMips(Texture& texture)
         ValidateGenerateMips(textureDbg);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_GenerateMips, *this, CaptureObjectRef{ &textureDbg }, std::uint8_t(0));
+
     LLGL_DBG_COMMAND( "GenerateMips", instance.GenerateMips(textureDbg.instance) );
 
     profile_.mipMapsGenerations++;
@@ -313,6 +358,9 @@ void DbgCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource&
         ValidateGenerateMips(textureDbg, &subresource);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_GenerateMips, *this, CaptureObjectRef{ &textureDbg }, std::uint8_t(1), subresource);
+
     LLGL_DBG_COMMAND( "GenerateMips", instance.GenerateMips(textureDbg.instance, subresource) );
 
     profile_.mipMapsGenerations++;
@@ -329,6 +377,9 @@ void DbgCommandBuffer::SetViewport(const Viewport& viewport)
         ValidateViewport(viewport);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetViewports, *this, CaptureDataRef{ &viewport, sizeof(viewport) });
+
     LLGL_DBG_COMMAND( "SetViewport", instance.SetViewport(viewport) );
 }
 
@@ -361,6 +412,9 @@ void DbgCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport*
         }
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetViewports, *this, CaptureDataRef{ viewports, sizeof(Viewport) * numViewports });
+
     LLGL_DBG_COMMAND( "SetViewports", instance.SetViewports(numViewports, viewports) );
 }
 
@@ -368,6 +422,9 @@ void DbgCommandBuffer::SetScissor(const Scissor& scissor)
 {
     LLGL_DBG_SOURCE;
     AssertRecording();
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetScissors, *this, CaptureDataRef{ &scissor, sizeof(scissor) });
+
     LLGL_DBG_COMMAND( "SetScissor", instance.SetScissor(scissor) );
 }
 
@@ -382,6 +439,9 @@ void DbgCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* sci
             LLGL_DBG_WARN(WarningType::PointlessOperation, "no scissor rectangles are specified");
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetScissors, *this, CaptureDataRef{ scissors, sizeof(Scissor) * numScissors });
+
     LLGL_DBG_COMMAND( "SetScissors", instance.SetScissors(numScissors, scissors) );
 }
 
@@ -403,6 +463,9 @@ void DbgCommandBuffer::SetVertexBuffer(Buffer& buffer)
         bindings_.anyNonEmptyVertexBuffer   = (bufferDbg.elements > 0);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetVertexBuffer, *this, CaptureObjectRef{ &bufferDbg });
+
     LLGL_DBG_COMMAND( "SetVertexBuffer", instance.SetVertexBuffer(bufferDbg.instance) );
 
     profile_.vertexBufferBindings++;
@@ -433,6 +496,9 @@ void DbgCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
         }
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetVertexBufferArray, *this, CaptureObjectRef{ &bufferArrayDbg });
+
     LLGL_DBG_COMMAND( "SetVertexBufferArray", instance.SetVertexBufferArray(bufferArrayDbg.instance) );
 
     profile_.vertexBufferBindings++;
@@ -455,6 +521,9 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer)
         bindings_.indexBufferOffset     = 0;
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetIndexBuffer, *this, CaptureObjectRef{ &bufferDbg }, Format::Undefined, std::uint64_t(0));
+
     LLGL_DBG_COMMAND( "SetIndexBuffer", instance.SetIndexBuffer(bufferDbg.instance) );
 
     profile_.indexBufferBindings++;
@@ -487,6 +556,9 @@ void DbgCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::
         }
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetIndexBuffer, *this, CaptureObjectRef{ &bufferDbg }, format, offset);
+
     LLGL_DBG_COMMAND( "SetIndexBuffer", instance.SetIndexBuffer(bufferDbg.instance, format, offset) );
 
     profile_.indexBufferBindings++;
@@ -509,6 +581,9 @@ void DbgCommandBuffer::SetResourceHeap(
         ValidateDescriptorSetIndex(firstSet, resourceHeapDbg.GetNumDescriptorSets(), resourceHeapDbg.label.c_str());
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetResourceHeap, *this, CaptureObjectRef{ &resourceHeapDbg }, firstSet, bindPoint);
+
     LLGL_DBG_COMMAND( "SetResourceHeap", instance.SetResourceHeap(resourceHeapDbg.instance, firstSet, bindPoint) );
 
     profile_.resourceHeapBindings++;
@@ -531,6 +606,9 @@ void DbgCommandBuffer::SetResource(
         ValidateStageFlags(stageFlags, StageFlags::AllStages);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetResource, *this, CaptureObjectRef{ &resource }, slot, bindFlags, stageFlags);
+
     if (perfProfilerEnabled_)
         StartTimer("SetResource");
 
@@ -619,6 +697,9 @@ void DbgCommandBuffer::ResetResourceSlots(
         ValidateStageFlags(stageFlags, StageFlags::AllStages);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_ResetResourceSlots, *this, resourceType, firstSlot, numSlots, bindFlags, stageFlags);
+
     LLGL_DBG_COMMAND( "ResetResourceSlots", instance.ResetResourceSlots(resourceType, firstSlot, numSlots, bindFlags, stageFlags) );
 }
 
@@ -640,6 +721,9 @@ void DbgCommandBuffer::BeginRenderPass(
         states_.insideRenderPass = true;
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_BeginRenderPass, *this, CaptureObjectRef{ &renderTarget }, CaptureObjectRef{ renderPass }, CaptureDataRef{ clearValues, sizeof(ClearValue) * numClearValues });
+
     if (LLGL::IsInstanceOf<SwapChain>(renderTarget))
     {
         auto& swapChainDbg = LLGL_CAST(DbgSwapChain&, renderTarget);
@@ -673,6 +757,9 @@ void DbgCommandBuffer::EndRenderPass()
         states_.insideRenderPass = false;
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_EndRenderPass, *this);
+
     instance.EndRenderPass();
 }
 
@@ -685,6 +772,9 @@ void DbgCommandBuffer::Clear(long flags, const ClearValue& clearValue)
         AssertInsideRenderPass();
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_Clear, *this, flags, clearValue);
+
     LLGL_DBG_COMMAND( "Clear", instance.Clear(flags, clearValue) );
 
     profile_.attachmentClears++;
@@ -701,6 +791,9 @@ void DbgCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const Atta
             ValidateAttachmentClear(attachments[i]);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_ClearAttachments, *this, CaptureDataRef{ attachments, sizeof(AttachmentClear) * numAttachments });
+
     LLGL_DBG_COMMAND( "ClearAttachments", instance.ClearAttachments(numAttachments, attachments) );
 
     profile_.attachmentClears++;
@@ -746,6 +839,8 @@ void DbgCommandBuffer::SetPipelineState(PipelineState& pipelineState)
         topology_ = pipelineStateDbg.graphicsDesc.primitiveTopology;
 
     /* Call wrapped function */
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetPipelineState, *this, CaptureObjectRef{ &pipelineStateDbg });
     LLGL_DBG_COMMAND( "SetPipelineState", instance.SetPipelineState(pipelineStateDbg.instance) );
 
     if (pipelineStateDbg.isGraphicsPSO)
@@ -767,6 +862,9 @@ void DbgCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
         }
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetBlendFactor, *this, color);
+
     LLGL_DBG_COMMAND( "SetBlendFactor", instance.SetBlendFactor(color) );
 }
 
@@ -783,6 +881,9 @@ void DbgCommandBuffer::SetStencilReference(std::uint32_t reference, const Stenci
         }
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetStencilReference, *this, reference, stencilFace);
+
     LLGL_DBG_COMMAND( "SetStencilReference", instance.SetStencilReference(reference, stencilFace) );
 }
 
@@ -791,6 +892,9 @@ void DbgCommandBuffer::SetUniform(
     const void*     data,
     std::uint32_t   dataSize)
 {
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetUniforms, *this, location, std::uint32_t(1), CaptureDataRef{ data, dataSize });
+
     LLGL_DBG_COMMAND( "SetUniform", instance.SetUniform(location, data, dataSize) );
 }
 
@@ -800,6 +904,9 @@ void DbgCommandBuffer::SetUniforms(
     const void*     data,
     std::uint32_t   dataSize)
 {
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_SetUniforms, *this, location, count, CaptureDataRef{ data, dataSize });
+
     LLGL_DBG_COMMAND( "SetUniforms", instance.SetUniforms(location, count, data, dataSize) );
 }
 
@@ -961,6 +1068,9 @@ void DbgCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex
         ValidateDrawCmd(numVertices, firstVertex, 1, 0);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_Draw, *this, numVertices, firstVertex, std::uint32_t(1), std::uint32_t(0));
+
     LLGL_DBG_COMMAND( "Draw", instance.Draw(numVertices, firstVertex) );
 
     profile_.drawCommands++;
@@ -974,6 +1084,9 @@ void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t first
         ValidateDrawIndexedCmd(numIndices, 1, firstIndex, 0, 0);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DrawIndexed, *this, numIndices, firstIndex, std::int32_t(0), std::uint32_t(1), std::uint32_t(0));
+
     LLGL_DBG_COMMAND( "DrawIndexed", instance.DrawIndexed(numIndices, firstIndex) );
 
     profile_.drawCommands++;
@@ -987,6 +1100,9 @@ void DbgCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t first
         ValidateDrawIndexedCmd(numIndices, 1, firstIndex, vertexOffset, 0);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DrawIndexed, *this, numIndices, firstIndex, vertexOffset, std::uint32_t(1), std::uint32_t(0));
+
     LLGL_DBG_COMMAND( "DrawIndexed", instance.DrawIndexed(numIndices, firstIndex, vertexOffset) );
 
     profile_.drawCommands++;
@@ -1001,6 +1117,9 @@ void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fi
         ValidateDrawCmd(numVertices, firstVertex, numInstances, 0);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_Draw, *this, numVertices, firstVertex, numInstances, std::uint32_t(0));
+
     LLGL_DBG_COMMAND( "DrawInstanced", instance.DrawInstanced(numVertices, firstVertex, numInstances) );
 
     profile_.drawCommands++;
@@ -1016,6 +1135,9 @@ void DbgCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t fi
         ValidateDrawCmd(numVertices, firstVertex, numInstances, firstInstance);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_Draw, *this, numVertices, firstVertex, numInstances, firstInstance);
+
     LLGL_DBG_COMMAND( "DrawInstanced", instance.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance) );
 
     profile_.drawCommands++;
@@ -1030,6 +1152,9 @@ void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint3
         ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, 0, 0);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DrawIndexed, *this, numIndices, firstIndex, std::int32_t(0), numInstances, std::uint32_t(0));
+
     LLGL_DBG_COMMAND( "DrawIndexedInstanced", instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex) );
 
     profile_.drawCommands++;
@@ -1044,6 +1169,9 @@ void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint3
         ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, vertexOffset, 0);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DrawIndexed, *this, numIndices, firstIndex, vertexOffset, numInstances, std::uint32_t(0));
+
     LLGL_DBG_COMMAND( "DrawIndexedInstanced", instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset) );
 
     profile_.drawCommands++;
@@ -1059,6 +1187,9 @@ void DbgCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint3
         ValidateDrawIndexedCmd(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DrawIndexed, *this, numIndices, firstIndex, vertexOffset, numInstances, firstInstance);
+
     LLGL_DBG_COMMAND( "DrawIndexedInstanced", instance.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance) );
 
     profile_.drawCommands++;
@@ -1077,6 +1208,9 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DrawIndirect, *this, CaptureObjectRef{ &bufferDbg }, offset, std::uint32_t(1), std::uint32_t(0));
+
     LLGL_DBG_COMMAND( "DrawIndirect", instance.DrawIndirect(bufferDbg.instance, offset) );
 
     profile_.drawCommands++;
@@ -1096,6 +1230,9 @@ void DbgCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::u
         ValidateAddressAlignment(stride, 4, "<stride> parameter");
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DrawIndirect, *this, CaptureObjectRef{ &bufferDbg }, offset, numCommands, stride);
+
     LLGL_DBG_COMMAND( "DrawIndirect", instance.DrawIndirect(bufferDbg.instance, offset, numCommands, stride) );
 
     profile_.drawCommands += numCommands;
@@ -1114,6 +1251,9 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DrawIndexedIndirect, *this, CaptureObjectRef{ &bufferDbg }, offset, std::uint32_t(1), std::uint32_t(0));
+
     LLGL_DBG_COMMAND( "DrawIndexedIndirect", instance.DrawIndexedIndirect(bufferDbg.instance, offset) );
 
     profile_.drawCommands++;
@@ -1133,6 +1273,9 @@ void DbgCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
         ValidateAddressAlignment(stride, 4, "<stride> parameter");
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DrawIndexedIndirect, *this, CaptureObjectRef{ &bufferDbg }, offset, numCommands, stride);
+
     LLGL_DBG_COMMAND( "DrawIndexedIndirect", instance.DrawIndexedIndirect(bufferDbg.instance, offset, numCommands, stride) );
 
     profile_.drawCommands += numCommands;
@@ -1155,6 +1298,9 @@ void DbgCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numW
         ValidateThreadGroupLimit(numWorkGroupsZ, limits_.maxComputeShaderWorkGroups[2]);
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_Dispatch, *this, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+
     LLGL_DBG_COMMAND( "Dispatch", instance.Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ) );
 
     profile_.dispatchCommands++;
@@ -1172,6 +1318,9 @@ void DbgCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
         ValidateAddressAlignment(offset, 4, "<offset> parameter");
     }
 
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_DispatchIndirect, *this, CaptureObjectRef{ &bufferDbg }, offset);
+
     LLGL_DBG_COMMAND( "DispatchIndirect", instance.DispatchIndirect(bufferDbg.instance, offset) );
 
     profile_.dispatchCommands++;
@@ -1191,13 +1340,29 @@ void DbgCommandBuffer::PushDebugGroup(const char* name)
     if (!name)
         name = "<null pointer>";
 
-    debugGroups_.push(name);
+    debugGroups_.push({ name, (traceWriter_ != nullptr ? traceWriter_->Now() : 0), timerMngr_.GetNumRecords() });
+
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_PushDebugGroup, *this, name);
+
     instance.PushDebugGroup(name);
 }
 
 void DbgCommandBuffer::PopDebugGroup()
 {
+    if (capture_)
+        capture_->WriteCommand(CaptureIdent_PopDebugGroup, *this);
+
     instance.PopDebugGroup();
+
+    if (traceWriter_ && !debugGroups_.empty())
+    {
+        /* Write CPU time of debug group and store its range of timer records for the GPU timeline */
+        const auto& group = debugGroups_.top();
+        traceWriter_->WriteCPUEvent(group.name.c_str(), "DebugGroup", group.startTime);
+        traceGroups_.push_back({ group.name, group.firstRecord, timerMngr_.GetNumRecords() });
+    }
+
     debugGroups_.pop();
 
     if (debugger_)
@@ -1205,7 +1370,7 @@ void DbgCommandBuffer::PopDebugGroup()
         if (debugGroups_.empty())
             debugger_->SetDebugGroup(nullptr);
         else
-            debugger_->SetDebugGroup(debugGroups_.top().c_str());
+            debugger_->SetDebugGroup(debugGroups_.top().name.c_str());
     }
 }
 
@@ -1976,6 +2141,47 @@ void DbgCommandBuffer::EndTimer()
     timerMngr_.Stop();
 }
 
+void DbgCommandBuffer::WriteGPUTraceEvents(const std::vector<ProfileTimeRecord>& records)
+{
+    /* Determine begin time of each record relative to the first one, since only elapsed times are known */
+    std::vector<std::uint64_t> offsets(records.size() + 1, 0);
+    for (std::size_t i = 0; i < records.size(); ++i)
+        offsets[i + 1] = offsets[i] + records[i].elapsedTime;
+
+    /* Place all records back to back on the GPU timeline, but not before this command buffer was encoded */
+    const auto baseTime = traceWriter_->AllocGPURange(encodingStartTime_, offsets.back());
+
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        ProfilerTraceEvent event;
+        {
+            event.name      = records[i].annotation;
+            event.category  = "GPU";
+            event.timestamp = baseTime + offsets[i];
+            event.duration  = records[i].elapsedTime;
+            event.threadID  = ProfilerTraceWriter::gpuThreadID;
+        }
+        traceWriter_->WriteEvent(std::move(event));
+    }
+
+    /* Write debug groups that enclose at least one record of this command buffer */
+    for (const auto& group : traceGroups_)
+    {
+        if (group.firstRecord < group.endRecord && group.endRecord <= records.size())
+        {
+            ProfilerTraceEvent event;
+            {
+                event.name      = group.name;
+                event.category  = "DebugGroup";
+                event.timestamp = baseTime + offsets[group.firstRecord];
+                event.duration  = offsets[group.endRecord] - offsets[group.firstRecord];
+                event.threadID  = ProfilerTraceWriter::gpuThreadID;
+            }
+            traceWriter_->WriteEvent(std::move(event));
+        }
+    }
+}
+
 
 } // /namespace LLGL
 
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <string>
 #include <stack>
+#include <vector>
 
 
 namespace LLGL
@@ -31,6 +32,8 @@ class DbgPipelineState;
 class DbgShaderProgram;
 class RenderingDebugger;
 class RenderingProfiler;
+class ProfilerTraceWriter;
+class CaptureWriter;
 
 class DbgCommandBuffer final : public CommandBuffer
 {
@@ -306,6 +309,25 @@ class DbgCommandBuffer final : public CommandBuffer
         void StartTimer(const char* annotation);
         void EndTimer();
 
+        void WriteGPUTraceEvents(const std::vector<ProfileTimeRecord>& records);
+
+    private:
+
+        struct DebugGroup
+        {
+            std::string             name;
+            std::uint64_t           startTime;
+            std::size_t             firstRecord;
+        };
+
+        // Range of time records that were enclosed by a debug group.
+        struct TraceGroup
+        {
+            std::string             name;
+            std::size_t             firstRecord;
+            std::size_t             endRecord;
+        };
+
     private:
 
         /* ----- Common objects ----- */
@@ -316,11 +338,16 @@ class DbgCommandBuffer final : public CommandBuffer
         const RenderingFeatures&    features_;
         const RenderingLimits&      limits_;
 
-        std::stack<std::string>     debugGroups_;
+        std::stack<DebugGroup>      debugGroups_;
 
         DbgQueryTimerManager        timerMngr_;
         bool                        perfProfilerEnabled_                    = false;
 
+        ProfilerTraceWriter*        traceWriter_                            = nullptr;
+        CaptureWriter*              capture_                                = nullptr;
+        std::uint64_t               encodingStartTime_                      = 0;
+        std::vector<TraceGroup>     traceGroups_;
+
         /* ----- Render states ----- */
 
         FrameProfile                profile_;
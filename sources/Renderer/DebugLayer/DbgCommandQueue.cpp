@@ -9,6 +9,7 @@
 #include "DbgCommandBuffer.h"
 #include "DbgCore.h"
 #include "../CheckedCast.h"
+#include "../ProfilerTraceWriter.h"
 #include <LLGL/RenderingProfiler.h>
 #include <LLGL/RenderingDebugger.h>
 
@@ -30,7 +31,18 @@ void DbgCommandQueue::Submit(CommandBuffer& commandBuffer)
 {
     auto& commandBufferDbg = LLGL_CAST(DbgCommandBuffer&, commandBuffer);
 
-    instance.Submit(commandBufferDbg.instance);
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->Submit(commandBufferDbg);
+
+    if (auto traceWriter = (profiler_ != nullptr ? profiler_->GetTraceWriter() : nullptr))
+    {
+        /* Write CPU time of submission */
+        const auto startTime = traceWriter->Now();
+        instance.Submit(commandBufferDbg.instance);
+        traceWriter->WriteCPUEvent("Submit", "Submission", startTime);
+    }
+    else
+        instance.Submit(commandBufferDbg.instance);
 
     if (profiler_)
     {
@@ -64,7 +76,7 @@ void DbgCommandQueue::Submit(Fence& fence)
 {
     instance.Submit(fence);
     if (profiler_)
-        profiler_->frameProfile.fenceSubmissions++;
+        profiler_->Increment(ProfileCounter::FenceSubmissions);
 }
 
 bool DbgCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
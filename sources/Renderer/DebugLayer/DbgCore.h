@@ -11,6 +11,7 @@
 
 #include <LLGL/RenderingProfiler.h>
 #include <LLGL/RenderingDebugger.h>
+#include "../CaptureWriter.h"
 
 
 namespace LLGL
@@ -48,6 +49,33 @@ inline void DbgPostWarning(RenderingDebugger* debugger, WarningType type, const
         debugger->PostWarning(type, message);
 }
 
+// Internal accessor to the capture state of a rendering debugger, which is not part of its public interface.
+struct DbgCaptureAccess
+{
+    static CaptureWriter* GetCaptureWriter(const RenderingDebugger& debugger)
+    {
+        return debugger.captureWriter_.get();
+    }
+
+    static void SetCaptureObjectSource(RenderingDebugger& debugger, CaptureObjectSource* source)
+    {
+        debugger.captureObjectSource_ = source;
+    }
+};
+
+// Returns the capture writer of the specified debugger or null if no capture is running.
+inline CaptureWriter* DbgGetCaptureWriter(RenderingDebugger* debugger)
+{
+    return (debugger != nullptr ? DbgCaptureAccess::GetCaptureWriter(*debugger) : nullptr);
+}
+
+// Sets the source of all objects that are alive when a capture of the specified debugger begins.
+inline void DbgSetCaptureObjectSource(RenderingDebugger* debugger, CaptureObjectSource* source)
+{
+    if (debugger)
+        DbgCaptureAccess::SetCaptureObjectSource(*debugger, source);
+}
+
 // Sets the name of the specified debug layer object.
 template <typename T>
 inline void DbgSetObjectName(T& obj, const char* name)
@@ -41,6 +41,12 @@ class DbgQueryTimerManager
         // Moves the internal records to the specified output container.
         void TakeRecords(std::vector<ProfileTimeRecord>& records);
 
+        // Returns the number of records since the last reset.
+        inline std::size_t GetNumRecords() const
+        {
+            return records_.size();
+        }
+
     private:
 
         // Resolves all timer values into the output records.
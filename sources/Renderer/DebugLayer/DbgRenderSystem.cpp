@@ -41,6 +41,12 @@ DbgRenderSystem::DbgRenderSystem(
     features_ { caps_.features     },
     limits_   { caps_.limits       }
 {
+    DbgSetCaptureObjectSource(debugger_, this);
+}
+
+DbgRenderSystem::~DbgRenderSystem()
+{
+    DbgSetCaptureObjectSource(debugger_, nullptr);
 }
 
 void DbgRenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
@@ -66,11 +72,18 @@ SwapChain* DbgRenderSystem::CreateSwapChain(const SwapChainDescriptor& desc, con
         commandQueue_ = MakeUnique<DbgCommandQueue>(*(instance_->GetCommandQueue()), profiler_, debugger_);
     }
 
-    return TakeOwnership(swapChains_, MakeUnique<DbgSwapChain>(*swapChainInstance));
+    auto swapChainDbg = TakeOwnership(swapChains_, MakeUnique<DbgSwapChain>(*swapChainInstance, debugger_, desc));
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateSwapChain(*swapChainDbg, desc);
+
+    return swapChainDbg;
 }
 
 void DbgRenderSystem::Release(SwapChain& swapChain)
 {
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->Release(swapChain);
     ReleaseDbg(swapChains_, swapChain);
 }
 
@@ -86,7 +99,7 @@ CommandQueue* DbgRenderSystem::GetCommandQueue()
 CommandBuffer* DbgRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
 {
     ValidateCommandBufferDesc(desc);
-    return TakeOwnership(
+    auto commandBufferDbg = TakeOwnership(
         commandBuffers_,
         MakeUnique<DbgCommandBuffer>(
             *instance_,
@@ -98,6 +111,11 @@ CommandBuffer* DbgRenderSystem::CreateCommandBuffer(const CommandBufferDescripto
             GetRenderingCaps()
         )
     );
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateCommandBuffer(*commandBufferDbg, desc);
+
+    return commandBufferDbg;
 }
 
 void DbgRenderSystem::Release(CommandBuffer& commandBuffer)
@@ -125,6 +143,9 @@ Buffer* DbgRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void*
     bufferDbg->elements     = (formatSize > 0 ? desc.size / formatSize : 0);
     bufferDbg->initialized  = (initialData != nullptr);
 
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateBuffer(*bufferDbg, desc, initialData);
+
     return TakeOwnership(buffers_, std::move(bufferDbg));
 }
 
@@ -147,6 +168,9 @@ BufferArray* DbgRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer
     auto bufferArrayInstance    = instance_->CreateBufferArray(numBuffers, bufferInstanceArray.data());
     auto bufferArrayDbg         = MakeUnique<DbgBufferArray>(*bufferArrayInstance, GetCombinedBindFlags(numBuffers, bufferArray), std::move(bufferDbgArray));
 
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateBufferArray(*bufferArrayDbg, numBuffers, bufferArray);
+
     return TakeOwnership(bufferArrays_, std::move(bufferArrayDbg));
 }
 
@@ -180,10 +204,13 @@ void DbgRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, co
             LLGL_DBG_ERROR(ErrorType::InvalidArgument, "illegal null pointer argument for 'data' parameter");
     }
 
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->WriteBuffer(dstBufferDbg, dstOffset, data, dataSize);
+
     instance_->WriteBuffer(dstBufferDbg.instance, dstOffset, data, dataSize);
 
     if (profiler_)
-        profiler_->frameProfile.bufferWrites++;
+        profiler_->Increment(ProfileCounter::BufferWrites);
 }
 
 void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
@@ -200,10 +227,16 @@ void* DbgRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
     auto result = instance_->MapBuffer(bufferDbg.instance, access);
 
     if (result != nullptr)
+    {
         bufferDbg.mapped = true;
 
+        /* Keep mapped memory with write access to capture its content when the buffer is unmapped */
+        if (access != CPUAccess::ReadOnly && DbgGetCaptureWriter(debugger_) != nullptr)
+            bufferDbg.mappedWriteData = result;
+    }
+
     if (profiler_)
-        profiler_->frameProfile.bufferMappings++;
+        profiler_->Increment(ProfileCounter::BufferMappings);
 
     return result;
 }
@@ -218,6 +251,13 @@ void DbgRenderSystem::UnmapBuffer(Buffer& buffer)
         ValidateBufferMapping(bufferDbg, false);
     }
 
+    if (bufferDbg.mappedWriteData != nullptr)
+    {
+        if (auto capture = DbgGetCaptureWriter(debugger_))
+            capture->WriteBuffer(bufferDbg, 0, bufferDbg.mappedWriteData, bufferDbg.desc.size);
+        bufferDbg.mappedWriteData = nullptr;
+    }
+
     instance_->UnmapBuffer(bufferDbg.instance);
 
     bufferDbg.mapped = false;
@@ -232,7 +272,12 @@ Texture* DbgRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, co
         LLGL_DBG_SOURCE;
         ValidateTextureDesc(textureDesc, imageDesc);
     }
-    return TakeOwnership(textures_, MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc));
+    auto textureDbg = TakeOwnership(textures_, MakeUnique<DbgTexture>(*instance_->CreateTexture(textureDesc, imageDesc), textureDesc));
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateTexture(*textureDbg, textureDesc, imageDesc);
+
+    return textureDbg;
 }
 
 void DbgRenderSystem::Release(Texture& texture)
@@ -251,10 +296,13 @@ void DbgRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textur
         ValidateImageDataSize(textureDbg, textureRegion, imageDesc.format, imageDesc.dataType, imageDesc.dataSize);
     }
 
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->WriteTexture(textureDbg, textureRegion, imageDesc);
+
     instance_->WriteTexture(textureDbg.instance, textureRegion, imageDesc);
 
     if (profiler_)
-        profiler_->frameProfile.textureWrites++;
+        profiler_->Increment(ProfileCounter::TextureWrites);
 }
 
 void DbgRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
@@ -271,19 +319,26 @@ void DbgRenderSystem::ReadTexture(Texture& texture, const TextureRegion& texture
     instance_->ReadTexture(textureDbg.instance, textureRegion, imageDesc);
 
     if (profiler_)
-        profiler_->frameProfile.textureReads++;
+        profiler_->Increment(ProfileCounter::TextureReads);
 }
 
 /* ----- Sampler States ---- */
 
 Sampler* DbgRenderSystem::CreateSampler(const SamplerDescriptor& desc)
 {
-    return instance_->CreateSampler(desc);
+    auto sampler = instance_->CreateSampler(desc);
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateSampler(*sampler, desc);
+
+    return sampler;
     //return TakeOwnership(samplers_, MakeUnique<DbgSampler>());
 }
 
 void DbgRenderSystem::Release(Sampler& sampler)
 {
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->Release(&sampler);
     instance_->Release(sampler);
     //ReleaseDbg(samplers_, sampler);
 }
@@ -327,14 +382,21 @@ ResourceHeap* DbgRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor&
                 LLGL_DBG_ERROR(ErrorType::InvalidArgument, "null pointer passed to <ResourceViewDescriptor>");
         }
     }
-    return TakeOwnership(
+    auto resourceHeapDbg = TakeOwnership(
         resourceHeaps_,
         MakeUnique<DbgResourceHeap>(*instance_->CreateResourceHeap(instanceDesc), desc)
     );
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateResourceHeap(*resourceHeapDbg, desc);
+
+    return resourceHeapDbg;
 }
 
 void DbgRenderSystem::Release(ResourceHeap& resourceViewHeap)
 {
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->Release(&resourceViewHeap);
     return instance_->Release(resourceViewHeap);
 }
 
@@ -342,11 +404,18 @@ void DbgRenderSystem::Release(ResourceHeap& resourceViewHeap)
 
 RenderPass* DbgRenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
 {
-    return instance_->CreateRenderPass(desc);
+    auto renderPass = instance_->CreateRenderPass(desc);
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateRenderPass(*renderPass, desc);
+
+    return renderPass;
 }
 
 void DbgRenderSystem::Release(RenderPass& renderPass)
 {
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->Release(&renderPass);
     instance_->Release(renderPass);
 }
 
@@ -369,10 +438,15 @@ RenderTarget* DbgRenderSystem::CreateRenderTarget(const RenderTargetDescriptor&
         }
     }
 
-    return TakeOwnership(
+    auto renderTargetDbg = TakeOwnership(
         renderTargets_,
         MakeUnique<DbgRenderTarget>(*instance_->CreateRenderTarget(instanceDesc), debugger_, desc)
     );
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateRenderTarget(*renderTargetDbg, desc);
+
+    return renderTargetDbg;
 }
 
 void DbgRenderSystem::Release(RenderTarget& renderTarget)
@@ -384,7 +458,12 @@ void DbgRenderSystem::Release(RenderTarget& renderTarget)
 
 Shader* DbgRenderSystem::CreateShader(const ShaderDescriptor& desc)
 {
-    return TakeOwnership(shaders_, MakeUnique<DbgShader>(*instance_->CreateShader(desc), desc));
+    auto shaderDbg = TakeOwnership(shaders_, MakeUnique<DbgShader>(*instance_->CreateShader(desc), desc));
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateShader(*shaderDbg, desc);
+
+    return shaderDbg;
 }
 
 static Shader* GetInstanceShader(Shader* shader)
@@ -408,7 +487,12 @@ ShaderProgram* DbgRenderSystem::CreateShaderProgram(const ShaderProgramDescripto
         instanceDesc.fragmentShader         = GetInstanceShader(desc.fragmentShader);
         instanceDesc.computeShader          = GetInstanceShader(desc.computeShader);
     }
-    return TakeOwnership(shaderPrograms_, MakeUnique<DbgShaderProgram>(*instance_->CreateShaderProgram(instanceDesc), debugger_, desc));
+    auto shaderProgramDbg = TakeOwnership(shaderPrograms_, MakeUnique<DbgShaderProgram>(*instance_->CreateShaderProgram(instanceDesc), debugger_, desc));
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreateShaderProgram(*shaderProgramDbg, desc);
+
+    return shaderProgramDbg;
 }
 
 void DbgRenderSystem::Release(Shader& shader)
@@ -425,7 +509,12 @@ void DbgRenderSystem::Release(ShaderProgram& shaderProgram)
 
 PipelineLayout* DbgRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& desc)
 {
-    return TakeOwnership(pipelineLayouts_, MakeUnique<DbgPipelineLayout>(*instance_->CreatePipelineLayout(desc), desc));
+    auto pipelineLayoutDbg = TakeOwnership(pipelineLayouts_, MakeUnique<DbgPipelineLayout>(*instance_->CreatePipelineLayout(desc), desc));
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->CreatePipelineLayout(*pipelineLayoutDbg, desc);
+
+    return pipelineLayoutDbg;
 }
 
 void DbgRenderSystem::Release(PipelineLayout& pipelineLayout)
@@ -437,7 +526,19 @@ void DbgRenderSystem::Release(PipelineLayout& pipelineLayout)
 
 PipelineState* DbgRenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
-    return nullptr;//TODO
+    LLGL_DBG_SOURCE;
+
+    /* Prime the pipeline cache of the instance; a restored PSO can't be validated without its descriptor, so it is not handed out */
+    if (auto pipelineState = instance_->CreatePipelineState(serializedCache))
+    {
+        LLGL_DBG_WARN(
+            WarningType::VaryingBehavior,
+            "pipeline state restored from serialized cache is discarded by the debug layer; create it from its descriptor instead"
+        );
+        instance_->Release(*pipelineState);
+    }
+
+    return nullptr;
 }
 
 PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
@@ -455,7 +556,12 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const GraphicsPipelineDescri
             if (desc.pipelineLayout != nullptr)
                 instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, desc.pipelineLayout)->instance);
         }
-        return TakeOwnership(pipelineStates_, MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), desc));
+        auto pipelineStateDbg = TakeOwnership(pipelineStates_, MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), desc));
+
+        if (auto capture = DbgGetCaptureWriter(debugger_))
+            capture->CreatePipelineState(*pipelineStateDbg, desc);
+
+        return pipelineStateDbg;
     }
     else
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "shader program must not be null");
@@ -475,7 +581,12 @@ PipelineState* DbgRenderSystem::CreatePipelineState(const ComputePipelineDescrip
             if (desc.pipelineLayout != nullptr)
                 instanceDesc.pipelineLayout = &(LLGL_CAST(const DbgPipelineLayout*, desc.pipelineLayout)->instance);
         }
-        return TakeOwnership(pipelineStates_, MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), desc));
+        auto pipelineStateDbg = TakeOwnership(pipelineStates_, MakeUnique<DbgPipelineState>(*instance_->CreatePipelineState(instanceDesc, serializedCache), desc));
+
+        if (auto capture = DbgGetCaptureWriter(debugger_))
+            capture->CreatePipelineState(*pipelineStateDbg, desc);
+
+        return pipelineStateDbg;
     }
     else
         LLGL_DBG_ERROR(ErrorType::InvalidArgument, "shader program must not be null");
@@ -1432,10 +1543,63 @@ void DbgRenderSystem::AssertMultiSampleTextures()
         LLGL_DBG_ERROR_NOT_SUPPORTED("multi-sample textures");
 }
 
+void DbgRenderSystem::CaptureLiveObjects(CaptureWriter& capture)
+{
+    /* Write objects in order of their dependencies; the content of buffers and textures is not captured */
+    for (const auto& swapChain : swapChains_)
+    {
+        auto desc = swapChain->desc;
+        desc.resolution = swapChain->GetResolution();
+        capture.CreateSwapChain(*swapChain, desc);
+    }
+
+    for (const auto& commandBuffer : commandBuffers_)
+        capture.CreateCommandBuffer(*commandBuffer, commandBuffer->desc);
+
+    for (const auto& buffer : buffers_)
+        capture.CreateBuffer(*buffer, buffer->desc, nullptr);
+
+    for (const auto& bufferArray : bufferArrays_)
+    {
+        std::vector<Buffer*> buffers(bufferArray->buffers.begin(), bufferArray->buffers.end());
+        capture.CreateBufferArray(*bufferArray, static_cast<std::uint32_t>(buffers.size()), buffers.data());
+    }
+
+    for (const auto& texture : textures_)
+        capture.CreateTexture(*texture, texture->desc, nullptr);
+
+    for (const auto& renderTarget : renderTargets_)
+        capture.CreateRenderTarget(*renderTarget, renderTarget->desc);
+
+    for (const auto& shader : shaders_)
+        capture.CreateShader(*shader, shader->desc);
+
+    for (const auto& shaderProgram : shaderPrograms_)
+        capture.CreateShaderProgram(*shaderProgram, shaderProgram->desc);
+
+    for (const auto& pipelineLayout : pipelineLayouts_)
+        capture.CreatePipelineLayout(*pipelineLayout, pipelineLayout->desc);
+
+    for (const auto& pipelineState : pipelineStates_)
+    {
+        if (pipelineState->isGraphicsPSO)
+            capture.CreatePipelineState(*pipelineState, pipelineState->graphicsDesc);
+        else
+            capture.CreatePipelineState(*pipelineState, pipelineState->computeDesc);
+    }
+
+    for (const auto& resourceHeap : resourceHeaps_)
+        capture.CreateResourceHeap(*resourceHeap, resourceHeap->desc);
+}
+
 template <typename T, typename TBase>
 void DbgRenderSystem::ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry)
 {
     auto& entryDbg = LLGL_CAST(T&, entry);
+
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->Release(&entryDbg);
+
     instance_->Release(entryDbg.instance);
     RemoveFromUniqueSet(cont, &entry);
 }
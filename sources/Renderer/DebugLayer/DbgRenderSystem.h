@@ -26,6 +26,7 @@
 #include "DbgResourceHeap.h"
 
 #include "../ContainerTypes.h"
+#include "../CaptureWriter.h"
 
 
 namespace LLGL
@@ -33,7 +34,7 @@ namespace LLGL
 
 
 //TODO: move all validation functions into spearate class to make them sharable between RenderSystem and other classes
-class DbgRenderSystem final : public RenderSystem
+class DbgRenderSystem final : public RenderSystem, private CaptureObjectSource
 {
 
     public:
@@ -41,6 +42,7 @@ class DbgRenderSystem final : public RenderSystem
         /* ----- Common ----- */
 
         DbgRenderSystem(const std::shared_ptr<RenderSystem>& instance, RenderingProfiler* profiler, RenderingDebugger* debugger);
+        ~DbgRenderSystem();
 
         void SetConfiguration(const RenderSystemConfiguration& config) override;
 
@@ -195,6 +197,8 @@ class DbgRenderSystem final : public RenderSystem
         template <typename T, typename TBase>
         void ReleaseDbg(std::set<std::unique_ptr<T>>& cont, TBase& entry);
 
+        void CaptureLiveObjects(CaptureWriter& capture) override;
+
     private:
 
         /* ----- Common objects ----- */
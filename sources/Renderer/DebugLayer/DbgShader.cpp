@@ -7,6 +7,7 @@
 
 #include "DbgShader.h"
 #include "DbgCore.h"
+#include <cstring>
 
 
 namespace LLGL
@@ -18,6 +19,7 @@ DbgShader::DbgShader(Shader& instance, const ShaderDescriptor& desc) :
     instance  { instance  },
     desc      { desc      }
 {
+    StoreDescriptorData();
 }
 
 void DbgShader::SetName(const char* name)
@@ -41,6 +43,73 @@ bool DbgShader::IsPostTessellationVertex() const
 }
 
 
+/*
+ * ======= Private: =======
+ */
+
+void DbgShader::StoreDescriptorData()
+{
+    /* Copy source code or binary; code strings and filenames are stored with a null terminator */
+    if (desc.source != nullptr)
+    {
+        if (desc.sourceType == ShaderSourceType::BinaryBuffer)
+            sourceData_.assign(desc.source, desc.source + desc.sourceSize);
+        else
+        {
+            std::size_t sourceSize = desc.sourceSize;
+            if (desc.sourceType != ShaderSourceType::CodeString || sourceSize == 0)
+                sourceSize = std::strlen(desc.source);
+            sourceData_.assign(desc.source, desc.source + sourceSize);
+            sourceData_.push_back('\0');
+        }
+        desc.source = sourceData_.data();
+    }
+
+    /* Copy entry point and profile */
+    if (desc.entryPoint != nullptr)
+    {
+        entryPoint_     = desc.entryPoint;
+        desc.entryPoint = entryPoint_.c_str();
+    }
+    if (desc.profile != nullptr)
+    {
+        profile_        = desc.profile;
+        desc.profile    = profile_.c_str();
+    }
+
+    /* Copy macro definitions, which are terminated by an entry with a null pointer name */
+    if (desc.defines != nullptr)
+    {
+        std::size_t numDefines = 0;
+        while (desc.defines[numDefines].name != nullptr)
+            ++numDefines;
+
+        /* Reserve all strings first, so their addresses remain valid */
+        defineStrings_.reserve(numDefines * 2);
+        defines_.reserve(numDefines + 1);
+
+        for (std::size_t i = 0; i < numDefines; ++i)
+        {
+            const auto& macro = desc.defines[i];
+            ShaderMacro macroCopy;
+            {
+                defineStrings_.push_back(macro.name);
+                macroCopy.name = defineStrings_.back().c_str();
+                if (macro.definition != nullptr)
+                {
+                    defineStrings_.push_back(macro.definition);
+                    macroCopy.definition = defineStrings_.back().c_str();
+                }
+            }
+            defines_.push_back(macroCopy);
+        }
+
+        defines_.push_back(ShaderMacro{});
+        desc.defines = defines_.data();
+    }
+}
+
+
 } // /namespace LLGL
 
 
@@ -12,6 +12,7 @@
 #include <LLGL/Shader.h>
 #include <LLGL/RenderingDebugger.h>
 #include <string>
+#include <vector>
 
 
 namespace LLGL
@@ -43,9 +44,22 @@ class DbgShader final : public Shader
     public:
 
         Shader&                 instance;
-        const ShaderDescriptor  desc;
+        ShaderDescriptor        desc;
         std::string             label;
 
+    private:
+
+        // Copies all data the descriptor refers to, so it remains valid for captures that begin after the shader was created.
+        void StoreDescriptorData();
+
+    private:
+
+        std::vector<char>           sourceData_;
+        std::string                 entryPoint_;
+        std::string                 profile_;
+        std::vector<std::string>    defineStrings_;
+        std::vector<ShaderMacro>    defines_;
+
 };
 
 
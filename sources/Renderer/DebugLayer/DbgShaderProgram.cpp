@@ -22,6 +22,7 @@ DbgShaderProgram::DbgShaderProgram(
     const ShaderProgramDescriptor&  desc)
 :
     instance  { instance },
+    desc      { desc     },
     debugger_ { debugger }
 {
     /* Debug all attachments and shader composition */
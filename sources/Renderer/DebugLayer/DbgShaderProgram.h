@@ -69,7 +69,8 @@ class DbgShaderProgram final : public ShaderProgram
 
     public:
 
-        ShaderProgram& instance;
+        ShaderProgram&                  instance;
+        const ShaderProgramDescriptor   desc;
 
     private:
 
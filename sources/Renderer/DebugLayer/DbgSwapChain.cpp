@@ -13,8 +13,10 @@ namespace LLGL
 {
 
 
-DbgSwapChain::DbgSwapChain(SwapChain& instance) :
-    instance { instance }
+DbgSwapChain::DbgSwapChain(SwapChain& instance, RenderingDebugger* debugger, const SwapChainDescriptor& desc) :
+    instance  { instance },
+    desc      { desc     },
+    debugger_ { debugger }
 {
     ShareSurfaceAndConfig(instance);
 }
@@ -26,6 +28,8 @@ void DbgSwapChain::SetName(const char* name)
 
 void DbgSwapChain::Present()
 {
+    if (auto capture = DbgGetCaptureWriter(debugger_))
+        capture->Present(*this);
     instance.Present();
 }
 
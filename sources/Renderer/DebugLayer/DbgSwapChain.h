@@ -17,6 +17,7 @@ namespace LLGL
 
 
 class DbgBuffer;
+class RenderingDebugger;
 
 class DbgSwapChain final : public SwapChain
 {
@@ -38,17 +39,22 @@ class DbgSwapChain final : public SwapChain
 
     public:
 
-        DbgSwapChain(SwapChain& instance);
+        DbgSwapChain(SwapChain& instance, RenderingDebugger* debugger, const SwapChainDescriptor& desc);
 
     public:
 
-        SwapChain&  instance;
-        std::string label;
+        SwapChain&                  instance;
+        const SwapChainDescriptor   desc;
+        std::string                 label;
 
     private:
 
         bool ResizeBuffersPrimary(const Extent2D& resolution) override;
 
+    private:
+
+        RenderingDebugger* debugger_ = nullptr;
+
 };
 
 
@@ -59,9 +59,14 @@ void D3D11CommandQueue::Submit(Fence& fence)
     fenceD3D.Submit(context_.Get());
 }
 
-bool D3D11CommandQueue::WaitFence(Fence& fence, std::uint64_t /*timeout*/)
+bool D3D11CommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 {
     auto& fenceD3D = LLGL_CAST(D3D11Fence&, fence);
+
+    /* Only poll the fence once for a zero timeout (see CommandQueue::QueryFence) */
+    if (timeout == 0)
+        return fenceD3D.Poll(context_.Get());
+
     fenceD3D.Wait(context_.Get());
     return true;
 }
@@ -35,6 +35,11 @@ void D3D11Fence::Wait(ID3D11DeviceContext* context)
     while (context->GetData(query_.Get(), nullptr, 0, 0) == S_FALSE) { /* dummy */ }
 }
 
+bool D3D11Fence::Poll(ID3D11DeviceContext* context)
+{
+    return (context->GetData(query_.Get(), nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK);
+}
+
 
 } // /namespace LLGL
 
@@ -29,6 +29,9 @@ class D3D11Fence final : public Fence
         void Submit(ID3D11DeviceContext* context);
         void Wait(ID3D11DeviceContext* context);
 
+        // Returns true if the fence has been signaled, without flushing the command queue and without waiting.
+        bool Poll(ID3D11DeviceContext* context);
+
     private:
 
         ComPtr<ID3D11Query> query_;
@@ -168,6 +168,8 @@ static const FormatAttributes g_formatAttribs[] =
     {  64, 4, 4, 1, ImageFormat::BC4,          DataType::Int8,      Mips | Dim2D_3D | DimCube | Compr | SNorm                  }, // BC4SNorm
     { 128, 4, 4, 2, ImageFormat::BC5,          DataType::UInt8,     Mips | Dim2D_3D | DimCube | Compr | UNorm                  }, // BC5UNorm
     { 128, 4, 4, 2, ImageFormat::BC5,          DataType::Int8,      Mips | Dim2D_3D | DimCube | Compr | SNorm                  }, // BC5SNorm
+    { 128, 4, 4, 4, ImageFormat::BC7,          DataType::UInt8,     Mips | Dim2D_3D | DimCube | Compr | UNorm                  }, // BC7UNorm
+    { 128, 4, 4, 4, ImageFormat::BC7,          DataType::UInt8,     Mips | Dim2D_3D | DimCube | Compr | UNorm | sRGB           }, // BC7UNorm_sRGB
 };
 
 
@@ -213,6 +215,7 @@ LLGL_EXPORT std::uint32_t ImageFormatSize(const ImageFormat imageFormat)
         case ImageFormat::BC3:          return 0; // no conversion supported yet
         case ImageFormat::BC4:          return 0; // no conversion supported yet
         case ImageFormat::BC5:          return 0; // no conversion supported yet
+        case ImageFormat::BC7:          return 0; // no conversion supported yet
     }
     return 0;
 }
@@ -235,7 +238,7 @@ LLGL_EXPORT bool IsCompressedFormat(const Format format)
 
 LLGL_EXPORT bool IsCompressedFormat(const ImageFormat imageFormat)
 {
-    return (imageFormat >= ImageFormat::BC1 && imageFormat <= ImageFormat::BC5);
+    return (imageFormat >= ImageFormat::BC1 && imageFormat <= ImageFormat::BC7);
 }
 
 LLGL_EXPORT bool IsDepthStencilFormat(const Format format)
@@ -61,6 +61,7 @@ static std::vector<Format> GetDefaultSupportedMTTextureFormats()
         Format::BC3UNorm,           Format::BC3UNorm_sRGB,
         Format::BC4UNorm,           Format::BC4SNorm,
         Format::BC5UNorm,           Format::BC5SNorm,
+        Format::BC7UNorm,           Format::BC7UNorm_sRGB,
     };
 }
 
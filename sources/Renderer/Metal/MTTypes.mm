@@ -169,6 +169,8 @@ MTLPixelFormat ToMTLPixelFormat(const Format format)
         case Format::BC4SNorm:          return MTLPixelFormatBC4_RSnorm;
         case Format::BC5UNorm:          return MTLPixelFormatBC5_RGUnorm;
         case Format::BC5SNorm:          return MTLPixelFormatBC5_RGSnorm;
+        case Format::BC7UNorm:          return MTLPixelFormatBC7_RGBAUnorm;
+        case Format::BC7UNorm_sRGB:     return MTLPixelFormatBC7_RGBAUnorm_sRGB;
         #endif
     }
     MapFailed("Format", "MTLPixelFormat");
@@ -578,6 +580,8 @@ Format ToFormat(const MTLPixelFormat pixelFormat)
         case MTLPixelFormatBC4_RSnorm:              return Format::BC4SNorm;
         case MTLPixelFormatBC5_RGUnorm:             return Format::BC5UNorm;
         case MTLPixelFormatBC5_RGSnorm:             return Format::BC5SNorm;
+        case MTLPixelFormatBC7_RGBAUnorm:           return Format::BC7UNorm;
+        case MTLPixelFormatBC7_RGBAUnorm_sRGB:      return Format::BC7UNorm_sRGB;
         #endif // /LLGL_OS_IOS
 
         default:                                    break;
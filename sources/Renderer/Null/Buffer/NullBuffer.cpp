@@ -0,0 +1,107 @@
+/*
+ * NullBuffer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullBuffer.h"
+#include <LLGL/Constants.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+NullBuffer::NullBuffer(const BufferDescriptor& desc, const void* initialData) :
+    Buffer { desc.bindFlags                         },
+    desc_  { desc                                   },
+    data_  ( static_cast<std::size_t>(desc.size), 0 )
+{
+    if (initialData != nullptr)
+        ::memcpy(data_.data(), initialData, data_.size());
+}
+
+BufferDescriptor NullBuffer::GetDesc() const
+{
+    BufferDescriptor bufferDesc;
+    {
+        bufferDesc.size             = GetSize();
+        bufferDesc.bindFlags        = GetBindFlags();
+        bufferDesc.cpuAccessFlags   = CPUAccessFlags::ReadWrite;
+        bufferDesc.miscFlags        = desc_.miscFlags;
+    }
+    return bufferDesc;
+}
+
+void NullBuffer::Write(std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
+{
+    AssertRange(dstOffset, dataSize);
+    ::memcpy(data_.data() + dstOffset, data, static_cast<std::size_t>(dataSize));
+}
+
+void NullBuffer::Read(std::uint64_t srcOffset, void* data, std::uint64_t dataSize) const
+{
+    AssertRange(srcOffset, dataSize);
+    ::memcpy(data, data_.data() + srcOffset, static_cast<std::size_t>(dataSize));
+}
+
+void NullBuffer::CopyFromBuffer(std::uint64_t dstOffset, const NullBuffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size)
+{
+    AssertRange(dstOffset, size);
+    srcBuffer.AssertRange(srcOffset, size);
+
+    /* Use memmove since source and destination might be the same buffer */
+    ::memmove(data_.data() + dstOffset, srcBuffer.data_.data() + srcOffset, static_cast<std::size_t>(size));
+}
+
+void NullBuffer::Fill(std::uint64_t dstOffset, std::uint32_t value, std::uint64_t fillSize)
+{
+    if (fillSize == Constants::wholeSize)
+    {
+        dstOffset   = 0;
+        fillSize    = GetSize();
+    }
+
+    AssertRange(dstOffset, fillSize);
+
+    /* Copy 32-bit value into each word of the destination range; trailing bytes are taken from the first bytes of the value */
+    auto dst = data_.data() + dstOffset;
+    for (std::uint64_t i = 0; i < fillSize; i += sizeof(value))
+        ::memcpy(dst + i, &value, static_cast<std::size_t>(std::min<std::uint64_t>(sizeof(value), fillSize - i)));
+}
+
+void* NullBuffer::Map(const CPUAccess /*access*/)
+{
+    /* Buffer can only be mapped once at a time */
+    if (mapped_)
+        return nullptr;
+    mapped_ = true;
+    return data_.data();
+}
+
+void NullBuffer::Unmap()
+{
+    mapped_ = false;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullBuffer::AssertRange(std::uint64_t offset, std::uint64_t size) const
+{
+    if (offset + size > GetSize())
+        throw std::out_of_range("buffer range exceeds size of Null buffer");
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
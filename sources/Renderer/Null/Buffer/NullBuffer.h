@@ -0,0 +1,95 @@
+/*
+ * NullBuffer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_BUFFER_H
+#define LLGL_NULL_BUFFER_H
+
+
+#include <LLGL/Buffer.h>
+#include <LLGL/BufferFlags.h>
+#include <LLGL/RenderSystemFlags.h>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+// Buffer with CPU-side storage only.
+class NullBuffer final : public Buffer
+{
+
+    public:
+
+        BufferDescriptor GetDesc() const override;
+
+    public:
+
+        NullBuffer(const BufferDescriptor& desc, const void* initialData = nullptr);
+
+        // Writes the specified data into the buffer storage or throws std::out_of_range if the range exceeds the buffer size.
+        void Write(std::uint64_t dstOffset, const void* data, std::uint64_t dataSize);
+
+        // Reads data from the buffer storage or throws std::out_of_range if the range exceeds the buffer size.
+        void Read(std::uint64_t srcOffset, void* data, std::uint64_t dataSize) const;
+
+        // Copies the specified region from the source buffer.
+        void CopyFromBuffer(std::uint64_t dstOffset, const NullBuffer& srcBuffer, std::uint64_t srcOffset, std::uint64_t size);
+
+        // Fills the specified region with copies of the 32-bit value. If 'fillSize' is Constants::wholeSize, the entire buffer is filled.
+        void Fill(std::uint64_t dstOffset, std::uint32_t value, std::uint64_t fillSize);
+
+        // Returns a pointer to the buffer storage.
+        void* Map(const CPUAccess access);
+        void Unmap();
+
+        // Returns the raw pointer to the buffer storage.
+        inline char* GetData()
+        {
+            return data_.data();
+        }
+
+        // Returns the constant raw pointer to the buffer storage.
+        inline const char* GetData() const
+        {
+            return data_.data();
+        }
+
+        // Returns the size (in bytes) of the buffer storage.
+        inline std::uint64_t GetSize() const
+        {
+            return static_cast<std::uint64_t>(data_.size());
+        }
+
+        // Returns the format of the index buffer or Format::Undefined.
+        inline Format GetIndexFormat() const
+        {
+            return desc_.format;
+        }
+
+    private:
+
+        void AssertRange(std::uint64_t offset, std::uint64_t size) const;
+
+    private:
+
+        BufferDescriptor    desc_;
+        std::vector<char>   data_;
+        bool                mapped_ = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
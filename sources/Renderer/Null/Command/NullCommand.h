@@ -0,0 +1,257 @@
+/*
+ * NullCommand.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_COMMAND_H
+#define LLGL_NULL_COMMAND_H
+
+
+#include <LLGL/CommandBufferFlags.h>
+#include <LLGL/PipelineStateFlags.h>
+#include <LLGL/ResourceFlags.h>
+#include <LLGL/ShaderProgramFlags.h>
+#include <LLGL/TextureFlags.h>
+#include <LLGL/Types.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class Resource;
+class RenderTarget;
+class RenderPass;
+class NullBuffer;
+class NullBufferArray;
+class NullTexture;
+class NullResourceHeap;
+class NullPipelineState;
+class NullQueryHeap;
+class NullCommandBuffer;
+
+
+struct NullCmdUpdateBuffer
+{
+    NullBuffer*     buffer;
+    std::uint64_t   offset;
+    std::uint16_t   size;
+//  std::int8_t     data[size];
+};
+
+struct NullCmdCopyBuffer
+{
+    NullBuffer*     dstBuffer;
+    std::uint64_t   dstOffset;
+    NullBuffer*     srcBuffer;
+    std::uint64_t   srcOffset;
+    std::uint64_t   size;
+};
+
+// Used for both NullOpcodeCopyBufferFromTexture and NullOpcodeCopyTextureFromBuffer
+struct NullCmdCopyTextureBuffer
+{
+    NullTexture*    texture;
+    TextureRegion   region;
+    NullBuffer*     buffer;
+    std::uint64_t   offset;
+    std::uint32_t   rowStride;
+    std::uint32_t   layerStride;
+};
+
+struct NullCmdFillBuffer
+{
+    NullBuffer*     buffer;
+    std::uint64_t   offset;
+    std::uint32_t   value;
+    std::uint64_t   size;
+};
+
+struct NullCmdCopyTexture
+{
+    NullTexture*    dstTexture;
+    TextureLocation dstLocation;
+    NullTexture*    srcTexture;
+    TextureLocation srcLocation;
+    Extent3D        extent;
+};
+
+struct NullCmdGenerateMips
+{
+    NullTexture*        texture;
+    TextureSubresource  subresource;
+};
+
+struct NullCmdExecute
+{
+    const NullCommandBuffer* commandBuffer;
+};
+
+// Used for both NullOpcodeSetViewports and NullOpcodeSetScissors
+struct NullCmdSetViewports
+{
+    std::uint32_t   count;
+//  Viewport        viewports[count];   // for NullOpcodeSetViewports
+//  Scissor         scissors[count];    // for NullOpcodeSetScissors
+};
+
+struct NullCmdSetVertexBuffer
+{
+    NullBuffer* buffer;
+};
+
+struct NullCmdSetVertexBufferArray
+{
+    NullBufferArray* bufferArray;
+};
+
+struct NullCmdSetIndexBuffer
+{
+    NullBuffer*     buffer;
+    Format          format;
+    std::uint64_t   offset;
+};
+
+struct NullCmdSetResourceHeap
+{
+    NullResourceHeap*   resourceHeap;
+    std::uint32_t       firstSet;
+    PipelineBindPoint   bindPoint;
+};
+
+struct NullCmdSetResource
+{
+    Resource*       resource;
+    std::uint32_t   slot;
+    long            bindFlags;
+    long            stageFlags;
+};
+
+struct NullCmdResetResourceSlots
+{
+    ResourceType    resourceType;
+    std::uint32_t   firstSlot;
+    std::uint32_t   numSlots;
+    long            bindFlags;
+    long            stageFlags;
+};
+
+struct NullCmdBeginRenderPass
+{
+    RenderTarget*       renderTarget;
+    const RenderPass*   renderPass;
+    std::uint32_t       numClearValues;
+//  ClearValue          clearValues[numClearValues];
+};
+
+struct NullCmdClear
+{
+    long        flags;
+    ClearValue  clearValue;
+};
+
+struct NullCmdClearAttachments
+{
+    std::uint32_t   numAttachments;
+//  AttachmentClear attachments[numAttachments];
+};
+
+struct NullCmdSetPipelineState
+{
+    NullPipelineState* pipelineState;
+};
+
+struct NullCmdSetBlendFactor
+{
+    ColorRGBAf color;
+};
+
+struct NullCmdSetStencilReference
+{
+    std::uint32_t   reference;
+    StencilFace     stencilFace;
+};
+
+struct NullCmdSetUniforms
+{
+    UniformLocation location;
+    std::uint32_t   count;
+    std::uint32_t   size;
+//  std::int8_t     data[size];
+};
+
+// Used for both NullOpcodeBeginQuery and NullOpcodeEndQuery
+struct NullCmdQuery
+{
+    NullQueryHeap*  queryHeap;
+    std::uint32_t   query;
+};
+
+struct NullCmdBeginRenderCondition
+{
+    NullQueryHeap*      queryHeap;
+    std::uint32_t       query;
+    RenderConditionMode mode;
+};
+
+struct NullCmdBeginStreamOutput
+{
+    std::uint32_t   numBuffers;
+//  NullBuffer*     buffers[numBuffers];
+};
+
+struct NullCmdDraw
+{
+    std::uint32_t   numVertices;
+    std::uint32_t   firstVertex;
+    std::uint32_t   numInstances;
+    std::uint32_t   firstInstance;
+};
+
+struct NullCmdDrawIndexed
+{
+    std::uint32_t   numIndices;
+    std::uint32_t   firstIndex;
+    std::uint32_t   numInstances;
+    std::int32_t    vertexOffset;
+    std::uint32_t   firstInstance;
+};
+
+// Used for both NullOpcodeDrawIndirect and NullOpcodeDrawIndexedIndirect
+struct NullCmdDrawIndirect
+{
+    NullBuffer*     buffer;
+    std::uint64_t   offset;
+    std::uint32_t   numCommands;
+    std::uint32_t   stride;
+};
+
+struct NullCmdDispatch
+{
+    std::uint32_t numWorkGroups[3];
+};
+
+struct NullCmdDispatchIndirect
+{
+    NullBuffer*     buffer;
+    std::uint64_t   offset;
+};
+
+struct NullCmdPushDebugGroup
+{
+    std::size_t length;
+//  char        name[length + 1];
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
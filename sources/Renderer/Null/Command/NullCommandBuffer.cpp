@@ -0,0 +1,599 @@
+/*
+ * NullCommandBuffer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullCommandBuffer.h"
+#include "NullCommand.h"
+#include "NullCommandExecutor.h"
+#include <LLGL/PipelineStateFlags.h>
+#include "../../CheckedCast.h"
+
+#include "../Buffer/NullBuffer.h"
+#include "../Buffer/NullBufferArray.h"
+#include "../Texture/NullTexture.h"
+#include "../RenderState/NullResourceHeap.h"
+#include "../RenderState/NullPipelineState.h"
+#include "../RenderState/NullQueryHeap.h"
+
+#include <string.h>
+#include <cstring> // std::strlen
+
+
+namespace LLGL
+{
+
+
+NullCommandBuffer::NullCommandBuffer(long flags, std::size_t initialBufferSize) :
+    flags_  { flags             },
+    buffer_ { initialBufferSize }
+{
+}
+
+/* ----- Encoding ----- */
+
+void NullCommandBuffer::Begin()
+{
+    /* Reset internal command buffer */
+    buffer_.Clear();
+}
+
+void NullCommandBuffer::End()
+{
+    if ((GetFlags() & CommandBufferFlags::ImmediateSubmit) != 0)
+    {
+        /* Execute recorded commands right away, since immediate command buffers are never submitted explicitly */
+        ExecuteNullCommandBuffer(*this);
+    }
+    else if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
+    {
+        /* Pack virtual command buffer into a single chunk if it will be submitted multiple times */
+        buffer_.Pack();
+    }
+}
+
+void NullCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
+{
+    if (IsPrimary())
+    {
+        /* Only secondary command buffers can be executed from within a primary command buffer */
+        auto& cmdBufferNull = LLGL_CAST(const NullCommandBuffer&, deferredCommandBuffer);
+        if (!cmdBufferNull.IsPrimary())
+        {
+            auto cmd = AllocCommand<NullCmdExecute>(NullOpcodeExecute);
+            cmd->commandBuffer = &cmdBufferNull;
+        }
+    }
+}
+
+/* ----- Blitting ----- */
+
+void NullCommandBuffer::UpdateBuffer(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    const void*     data,
+    std::uint16_t   dataSize)
+{
+    auto cmd = AllocCommand<NullCmdUpdateBuffer>(NullOpcodeUpdateBuffer, dataSize);
+    {
+        cmd->buffer = LLGL_CAST(NullBuffer*, &dstBuffer);
+        cmd->offset = dstOffset;
+        cmd->size   = dataSize;
+        ::memcpy(cmd + 1, data, dataSize);
+    }
+}
+
+void NullCommandBuffer::CopyBuffer(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    Buffer&         srcBuffer,
+    std::uint64_t   srcOffset,
+    std::uint64_t   size)
+{
+    auto cmd = AllocCommand<NullCmdCopyBuffer>(NullOpcodeCopyBuffer);
+    {
+        cmd->dstBuffer  = LLGL_CAST(NullBuffer*, &dstBuffer);
+        cmd->dstOffset  = dstOffset;
+        cmd->srcBuffer  = LLGL_CAST(NullBuffer*, &srcBuffer);
+        cmd->srcOffset  = srcOffset;
+        cmd->size       = size;
+    }
+}
+
+void NullCommandBuffer::CopyBufferFromTexture(
+    Buffer&                 dstBuffer,
+    std::uint64_t           dstOffset,
+    Texture&                srcTexture,
+    const TextureRegion&    srcRegion,
+    std::uint32_t           rowStride,
+    std::uint32_t           layerStride)
+{
+    auto cmd = AllocCommand<NullCmdCopyTextureBuffer>(NullOpcodeCopyBufferFromTexture);
+    {
+        cmd->texture        = LLGL_CAST(NullTexture*, &srcTexture);
+        cmd->region         = srcRegion;
+        cmd->buffer         = LLGL_CAST(NullBuffer*, &dstBuffer);
+        cmd->offset         = dstOffset;
+        cmd->rowStride      = rowStride;
+        cmd->layerStride    = layerStride;
+    }
+}
+
+void NullCommandBuffer::FillBuffer(
+    Buffer&         dstBuffer,
+    std::uint64_t   dstOffset,
+    std::uint32_t   value,
+    std::uint64_t   fillSize)
+{
+    auto cmd = AllocCommand<NullCmdFillBuffer>(NullOpcodeFillBuffer);
+    {
+        cmd->buffer = LLGL_CAST(NullBuffer*, &dstBuffer);
+        cmd->offset = dstOffset;
+        cmd->value  = value;
+        cmd->size   = fillSize;
+    }
+}
+
+void NullCommandBuffer::CopyTexture(
+    Texture&                dstTexture,
+    const TextureLocation&  dstLocation,
+    Texture&                srcTexture,
+    const TextureLocation&  srcLocation,
+    const Extent3D&         extent)
+{
+    auto cmd = AllocCommand<NullCmdCopyTexture>(NullOpcodeCopyTexture);
+    {
+        cmd->dstTexture     = LLGL_CAST(NullTexture*, &dstTexture);
+        cmd->dstLocation    = dstLocation;
+        cmd->srcTexture     = LLGL_CAST(NullTexture*, &srcTexture);
+        cmd->srcLocation    = srcLocation;
+        cmd->extent         = extent;
+    }
+}
+
+void NullCommandBuffer::CopyTextureFromBuffer(
+    Texture&                dstTexture,
+    const TextureRegion&    dstRegion,
+    Buffer&                 srcBuffer,
+    std::uint64_t           srcOffset,
+    std::uint32_t           rowStride,
+    std::uint32_t           layerStride)
+{
+    auto cmd = AllocCommand<NullCmdCopyTextureBuffer>(NullOpcodeCopyTextureFromBuffer);
+    {
+        cmd->texture        = LLGL_CAST(NullTexture*, &dstTexture);
+        cmd->region         = dstRegion;
+        cmd->buffer         = LLGL_CAST(NullBuffer*, &srcBuffer);
+        cmd->offset         = srcOffset;
+        cmd->rowStride      = rowStride;
+        cmd->layerStride    = layerStride;
+    }
+}
+
+void NullCommandBuffer::GenerateMips(Texture& texture)
+{
+    auto& textureNull = LLGL_CAST(NullTexture&, texture);
+    auto cmd = AllocCommand<NullCmdGenerateMips>(NullOpcodeGenerateMips);
+    {
+        cmd->texture                        = &textureNull;
+        cmd->subresource.baseArrayLayer     = 0;
+        cmd->subresource.numArrayLayers     = textureNull.GetDesc().arrayLayers;
+        cmd->subresource.baseMipLevel       = 0;
+        cmd->subresource.numMipLevels       = textureNull.GetDesc().mipLevels;
+    }
+}
+
+void NullCommandBuffer::GenerateMips(Texture& texture, const TextureSubresource& subresource)
+{
+    auto cmd = AllocCommand<NullCmdGenerateMips>(NullOpcodeGenerateMips);
+    {
+        cmd->texture        = LLGL_CAST(NullTexture*, &texture);
+        cmd->subresource    = subresource;
+    }
+}
+
+/* ----- Viewport and Scissor ----- */
+
+void NullCommandBuffer::SetViewport(const Viewport& viewport)
+{
+    SetViewports(1, &viewport);
+}
+
+void NullCommandBuffer::SetViewports(std::uint32_t numViewports, const Viewport* viewports)
+{
+    auto cmd = AllocCommand<NullCmdSetViewports>(NullOpcodeSetViewports, sizeof(Viewport) * numViewports);
+    {
+        cmd->count = numViewports;
+        ::memcpy(cmd + 1, viewports, sizeof(Viewport) * numViewports);
+    }
+}
+
+void NullCommandBuffer::SetScissor(const Scissor& scissor)
+{
+    SetScissors(1, &scissor);
+}
+
+void NullCommandBuffer::SetScissors(std::uint32_t numScissors, const Scissor* scissors)
+{
+    auto cmd = AllocCommand<NullCmdSetViewports>(NullOpcodeSetScissors, sizeof(Scissor) * numScissors);
+    {
+        cmd->count = numScissors;
+        ::memcpy(cmd + 1, scissors, sizeof(Scissor) * numScissors);
+    }
+}
+
+/* ----- Input Assembly ------ */
+
+void NullCommandBuffer::SetVertexBuffer(Buffer& buffer)
+{
+    auto cmd = AllocCommand<NullCmdSetVertexBuffer>(NullOpcodeSetVertexBuffer);
+    cmd->buffer = LLGL_CAST(NullBuffer*, &buffer);
+}
+
+void NullCommandBuffer::SetVertexBufferArray(BufferArray& bufferArray)
+{
+    auto cmd = AllocCommand<NullCmdSetVertexBufferArray>(NullOpcodeSetVertexBufferArray);
+    cmd->bufferArray = LLGL_CAST(NullBufferArray*, &bufferArray);
+}
+
+void NullCommandBuffer::SetIndexBuffer(Buffer& buffer)
+{
+    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    SetIndexBuffer(buffer, bufferNull.GetIndexFormat(), 0);
+}
+
+void NullCommandBuffer::SetIndexBuffer(Buffer& buffer, const Format format, std::uint64_t offset)
+{
+    auto cmd = AllocCommand<NullCmdSetIndexBuffer>(NullOpcodeSetIndexBuffer);
+    {
+        cmd->buffer = LLGL_CAST(NullBuffer*, &buffer);
+        cmd->format = format;
+        cmd->offset = offset;
+    }
+}
+
+/* ----- Resources ----- */
+
+void NullCommandBuffer::SetResourceHeap(
+    ResourceHeap&           resourceHeap,
+    std::uint32_t           firstSet,
+    const PipelineBindPoint bindPoint)
+{
+    auto cmd = AllocCommand<NullCmdSetResourceHeap>(NullOpcodeSetResourceHeap);
+    {
+        cmd->resourceHeap   = LLGL_CAST(NullResourceHeap*, &resourceHeap);
+        cmd->firstSet       = firstSet;
+        cmd->bindPoint      = bindPoint;
+    }
+}
+
+void NullCommandBuffer::SetResource(Resource& resource, std::uint32_t slot, long bindFlags, long stageFlags)
+{
+    auto cmd = AllocCommand<NullCmdSetResource>(NullOpcodeSetResource);
+    {
+        cmd->resource   = &resource;
+        cmd->slot       = slot;
+        cmd->bindFlags  = bindFlags;
+        cmd->stageFlags = stageFlags;
+    }
+}
+
+void NullCommandBuffer::ResetResourceSlots(
+    const ResourceType  resourceType,
+    std::uint32_t       firstSlot,
+    std::uint32_t       numSlots,
+    long                bindFlags,
+    long                stageFlags)
+{
+    auto cmd = AllocCommand<NullCmdResetResourceSlots>(NullOpcodeResetResourceSlots);
+    {
+        cmd->resourceType   = resourceType;
+        cmd->firstSlot      = firstSlot;
+        cmd->numSlots       = numSlots;
+        cmd->bindFlags      = bindFlags;
+        cmd->stageFlags     = stageFlags;
+    }
+}
+
+/* ----- Render Passes ----- */
+
+void NullCommandBuffer::BeginRenderPass(
+    RenderTarget&       renderTarget,
+    const RenderPass*   renderPass,
+    std::uint32_t       numClearValues,
+    const ClearValue*   clearValues)
+{
+    auto cmd = AllocCommand<NullCmdBeginRenderPass>(NullOpcodeBeginRenderPass, sizeof(ClearValue) * numClearValues);
+    {
+        cmd->renderTarget   = &renderTarget;
+        cmd->renderPass     = renderPass;
+        cmd->numClearValues = numClearValues;
+        ::memcpy(cmd + 1, clearValues, sizeof(ClearValue) * numClearValues);
+    }
+}
+
+void NullCommandBuffer::EndRenderPass()
+{
+    AllocOpcode(NullOpcodeEndRenderPass);
+}
+
+void NullCommandBuffer::Clear(long flags, const ClearValue& clearValue)
+{
+    auto cmd = AllocCommand<NullCmdClear>(NullOpcodeClear);
+    {
+        cmd->flags      = flags;
+        cmd->clearValue = clearValue;
+    }
+}
+
+void NullCommandBuffer::ClearAttachments(std::uint32_t numAttachments, const AttachmentClear* attachments)
+{
+    auto cmd = AllocCommand<NullCmdClearAttachments>(NullOpcodeClearAttachments, sizeof(AttachmentClear) * numAttachments);
+    {
+        cmd->numAttachments = numAttachments;
+        ::memcpy(cmd + 1, attachments, sizeof(AttachmentClear) * numAttachments);
+    }
+}
+
+/* ----- Pipeline States ----- */
+
+void NullCommandBuffer::SetPipelineState(PipelineState& pipelineState)
+{
+    auto cmd = AllocCommand<NullCmdSetPipelineState>(NullOpcodeSetPipelineState);
+    cmd->pipelineState = LLGL_CAST(NullPipelineState*, &pipelineState);
+}
+
+void NullCommandBuffer::SetBlendFactor(const ColorRGBAf& color)
+{
+    auto cmd = AllocCommand<NullCmdSetBlendFactor>(NullOpcodeSetBlendFactor);
+    cmd->color = color;
+}
+
+void NullCommandBuffer::SetStencilReference(std::uint32_t reference, const StencilFace stencilFace)
+{
+    auto cmd = AllocCommand<NullCmdSetStencilReference>(NullOpcodeSetStencilReference);
+    {
+        cmd->reference      = reference;
+        cmd->stencilFace    = stencilFace;
+    }
+}
+
+void NullCommandBuffer::SetUniform(
+    UniformLocation location,
+    const void*     data,
+    std::uint32_t   dataSize)
+{
+    SetUniforms(location, 1, data, dataSize);
+}
+
+void NullCommandBuffer::SetUniforms(
+    UniformLocation location,
+    std::uint32_t   count,
+    const void*     data,
+    std::uint32_t   dataSize)
+{
+    auto cmd = AllocCommand<NullCmdSetUniforms>(NullOpcodeSetUniforms, dataSize);
+    {
+        cmd->location   = location;
+        cmd->count      = count;
+        cmd->size       = dataSize;
+        ::memcpy(cmd + 1, data, dataSize);
+    }
+}
+
+/* ----- Queries ----- */
+
+void NullCommandBuffer::BeginQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeBeginQuery);
+    {
+        cmd->queryHeap  = LLGL_CAST(NullQueryHeap*, &queryHeap);
+        cmd->query      = query;
+    }
+}
+
+void NullCommandBuffer::EndQuery(QueryHeap& queryHeap, std::uint32_t query)
+{
+    auto cmd = AllocCommand<NullCmdQuery>(NullOpcodeEndQuery);
+    {
+        cmd->queryHeap  = LLGL_CAST(NullQueryHeap*, &queryHeap);
+        cmd->query      = query;
+    }
+}
+
+void NullCommandBuffer::BeginRenderCondition(QueryHeap& queryHeap, std::uint32_t query, const RenderConditionMode mode)
+{
+    auto cmd = AllocCommand<NullCmdBeginRenderCondition>(NullOpcodeBeginRenderCondition);
+    {
+        cmd->queryHeap  = LLGL_CAST(NullQueryHeap*, &queryHeap);
+        cmd->query      = query;
+        cmd->mode       = mode;
+    }
+}
+
+void NullCommandBuffer::EndRenderCondition()
+{
+    AllocOpcode(NullOpcodeEndRenderCondition);
+}
+
+/* ----- Stream Output ------ */
+
+void NullCommandBuffer::BeginStreamOutput(std::uint32_t numBuffers, Buffer* const * buffers)
+{
+    auto cmd = AllocCommand<NullCmdBeginStreamOutput>(NullOpcodeBeginStreamOutput, sizeof(NullBuffer*) * numBuffers);
+    {
+        cmd->numBuffers = numBuffers;
+        auto buffersNull = reinterpret_cast<NullBuffer**>(cmd + 1);
+        for (std::uint32_t i = 0; i < numBuffers; ++i)
+            buffersNull[i] = LLGL_CAST(NullBuffer*, buffers[i]);
+    }
+}
+
+void NullCommandBuffer::EndStreamOutput()
+{
+    AllocOpcode(NullOpcodeEndStreamOutput);
+}
+
+/* ----- Drawing ----- */
+
+void NullCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
+{
+    DrawInstanced(numVertices, firstVertex, 1, 0);
+}
+
+void NullCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
+{
+    DrawIndexedInstanced(numIndices, 1, firstIndex, 0, 0);
+}
+
+void NullCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    DrawIndexedInstanced(numIndices, 1, firstIndex, vertexOffset, 0);
+}
+
+void NullCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
+{
+    DrawInstanced(numVertices, firstVertex, numInstances, 0);
+}
+
+void NullCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
+{
+    auto cmd = AllocCommand<NullCmdDraw>(NullOpcodeDraw);
+    {
+        cmd->numVertices    = numVertices;
+        cmd->firstVertex    = firstVertex;
+        cmd->numInstances   = numInstances;
+        cmd->firstInstance  = firstInstance;
+    }
+}
+
+void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
+{
+    DrawIndexedInstanced(numIndices, numInstances, firstIndex, 0, 0);
+}
+
+void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
+{
+    DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, 0);
+}
+
+void NullCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
+{
+    auto cmd = AllocCommand<NullCmdDrawIndexed>(NullOpcodeDrawIndexed);
+    {
+        cmd->numIndices     = numIndices;
+        cmd->firstIndex     = firstIndex;
+        cmd->numInstances   = numInstances;
+        cmd->vertexOffset   = vertexOffset;
+        cmd->firstInstance  = firstInstance;
+    }
+}
+
+void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    DrawIndirect(buffer, offset, 1, 0);
+}
+
+void NullCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    auto cmd = AllocCommand<NullCmdDrawIndirect>(NullOpcodeDrawIndirect);
+    {
+        cmd->buffer         = LLGL_CAST(NullBuffer*, &buffer);
+        cmd->offset         = offset;
+        cmd->numCommands    = numCommands;
+        cmd->stride         = stride;
+    }
+}
+
+void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    DrawIndexedIndirect(buffer, offset, 1, 0);
+}
+
+void NullCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
+{
+    auto cmd = AllocCommand<NullCmdDrawIndirect>(NullOpcodeDrawIndexedIndirect);
+    {
+        cmd->buffer         = LLGL_CAST(NullBuffer*, &buffer);
+        cmd->offset         = offset;
+        cmd->numCommands    = numCommands;
+        cmd->stride         = stride;
+    }
+}
+
+/* ----- Compute ----- */
+
+void NullCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
+{
+    auto cmd = AllocCommand<NullCmdDispatch>(NullOpcodeDispatch);
+    {
+        cmd->numWorkGroups[0] = numWorkGroupsX;
+        cmd->numWorkGroups[1] = numWorkGroupsY;
+        cmd->numWorkGroups[2] = numWorkGroupsZ;
+    }
+}
+
+void NullCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
+{
+    auto cmd = AllocCommand<NullCmdDispatchIndirect>(NullOpcodeDispatchIndirect);
+    {
+        cmd->buffer = LLGL_CAST(NullBuffer*, &buffer);
+        cmd->offset = offset;
+    }
+}
+
+/* ----- Debugging ----- */
+
+void NullCommandBuffer::PushDebugGroup(const char* name)
+{
+    const auto length = std::strlen(name);
+    auto cmd = AllocCommand<NullCmdPushDebugGroup>(NullOpcodePushDebugGroup, length + 1);
+    {
+        cmd->length = length;
+        ::memcpy(cmd + 1, name, length + 1);
+    }
+}
+
+void NullCommandBuffer::PopDebugGroup()
+{
+    AllocOpcode(NullOpcodePopDebugGroup);
+}
+
+/* ----- Extensions ----- */
+
+void NullCommandBuffer::SetGraphicsAPIDependentState(const void* /*stateDesc*/, std::size_t /*stateDescSize*/)
+{
+    // dummy
+}
+
+/* ----- Internal ----- */
+
+bool NullCommandBuffer::IsPrimary() const
+{
+    return ((GetFlags() & CommandBufferFlags::Secondary) == 0);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullCommandBuffer::AllocOpcode(const NullOpcode opcode)
+{
+    buffer_.AllocOpcode(opcode);
+}
+
+template <typename TCommand>
+TCommand* NullCommandBuffer::AllocCommand(const NullOpcode opcode, std::size_t payloadSize)
+{
+    return buffer_.AllocCommand<TCommand>(opcode, payloadSize);
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,232 @@
+/*
+ * NullCommandExecutor.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullCommandExecutor.h"
+#include "NullCommandBuffer.h"
+#include "NullCommand.h"
+#include "../Buffer/NullBuffer.h"
+#include "../Texture/NullTexture.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+// Throws std::out_of_range if the texture region with the command's strides does not fit into the buffer.
+static void AssertNullCopyTextureBufferRange(const NullCmdCopyTextureBuffer& cmd)
+{
+    const auto dataSize = cmd.texture->GetRegionDataSize(cmd.region, cmd.rowStride, cmd.layerStride);
+    if (cmd.offset + dataSize > cmd.buffer->GetSize())
+        throw std::out_of_range("texture region exceeds size of Null buffer");
+}
+
+static std::size_t ExecuteNullCommand(const NullOpcode opcode, const void* pc)
+{
+    switch (opcode)
+    {
+        case NullOpcodeUpdateBuffer:
+        {
+            auto cmd = reinterpret_cast<const NullCmdUpdateBuffer*>(pc);
+            cmd->buffer->Write(cmd->offset, cmd + 1, cmd->size);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case NullOpcodeCopyBuffer:
+        {
+            auto cmd = reinterpret_cast<const NullCmdCopyBuffer*>(pc);
+            cmd->dstBuffer->CopyFromBuffer(cmd->dstOffset, *(cmd->srcBuffer), cmd->srcOffset, cmd->size);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeCopyBufferFromTexture:
+        {
+            auto cmd = reinterpret_cast<const NullCmdCopyTextureBuffer*>(pc);
+            AssertNullCopyTextureBufferRange(*cmd);
+            cmd->texture->Read(cmd->region, cmd->buffer->GetData() + cmd->offset, cmd->rowStride, cmd->layerStride);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeFillBuffer:
+        {
+            auto cmd = reinterpret_cast<const NullCmdFillBuffer*>(pc);
+            cmd->buffer->Fill(cmd->offset, cmd->value, cmd->size);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeCopyTexture:
+        {
+            auto cmd = reinterpret_cast<const NullCmdCopyTexture*>(pc);
+            cmd->dstTexture->CopyFromTexture(cmd->dstLocation, *(cmd->srcTexture), cmd->srcLocation, cmd->extent);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeCopyTextureFromBuffer:
+        {
+            auto cmd = reinterpret_cast<const NullCmdCopyTextureBuffer*>(pc);
+            AssertNullCopyTextureBufferRange(*cmd);
+            cmd->texture->Write(cmd->region, cmd->buffer->GetData() + cmd->offset, cmd->rowStride, cmd->layerStride);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeGenerateMips:
+        {
+            auto cmd = reinterpret_cast<const NullCmdGenerateMips*>(pc);
+            return sizeof(*cmd);
+        }
+        case NullOpcodeExecute:
+        {
+            auto cmd = reinterpret_cast<const NullCmdExecute*>(pc);
+            ExecuteNullCommandBuffer(*(cmd->commandBuffer));
+            return sizeof(*cmd);
+        }
+        case NullOpcodeSetViewports:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetViewports*>(pc);
+            return (sizeof(*cmd) + sizeof(Viewport) * cmd->count);
+        }
+        case NullOpcodeSetScissors:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetViewports*>(pc);
+            return (sizeof(*cmd) + sizeof(Scissor) * cmd->count);
+        }
+        case NullOpcodeSetVertexBuffer:
+        {
+            return sizeof(NullCmdSetVertexBuffer);
+        }
+        case NullOpcodeSetVertexBufferArray:
+        {
+            return sizeof(NullCmdSetVertexBufferArray);
+        }
+        case NullOpcodeSetIndexBuffer:
+        {
+            return sizeof(NullCmdSetIndexBuffer);
+        }
+        case NullOpcodeSetResourceHeap:
+        {
+            return sizeof(NullCmdSetResourceHeap);
+        }
+        case NullOpcodeSetResource:
+        {
+            return sizeof(NullCmdSetResource);
+        }
+        case NullOpcodeResetResourceSlots:
+        {
+            return sizeof(NullCmdResetResourceSlots);
+        }
+        case NullOpcodeBeginRenderPass:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginRenderPass*>(pc);
+            return (sizeof(*cmd) + sizeof(ClearValue) * cmd->numClearValues);
+        }
+        case NullOpcodeEndRenderPass:
+        {
+            return 0;
+        }
+        case NullOpcodeClear:
+        {
+            return sizeof(NullCmdClear);
+        }
+        case NullOpcodeClearAttachments:
+        {
+            auto cmd = reinterpret_cast<const NullCmdClearAttachments*>(pc);
+            return (sizeof(*cmd) + sizeof(AttachmentClear) * cmd->numAttachments);
+        }
+        case NullOpcodeSetPipelineState:
+        {
+            return sizeof(NullCmdSetPipelineState);
+        }
+        case NullOpcodeSetBlendFactor:
+        {
+            return sizeof(NullCmdSetBlendFactor);
+        }
+        case NullOpcodeSetStencilReference:
+        {
+            return sizeof(NullCmdSetStencilReference);
+        }
+        case NullOpcodeSetUniforms:
+        {
+            auto cmd = reinterpret_cast<const NullCmdSetUniforms*>(pc);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case NullOpcodeBeginQuery:
+        case NullOpcodeEndQuery:
+        {
+            return sizeof(NullCmdQuery);
+        }
+        case NullOpcodeBeginRenderCondition:
+        {
+            return sizeof(NullCmdBeginRenderCondition);
+        }
+        case NullOpcodeEndRenderCondition:
+        {
+            return 0;
+        }
+        case NullOpcodeBeginStreamOutput:
+        {
+            auto cmd = reinterpret_cast<const NullCmdBeginStreamOutput*>(pc);
+            return (sizeof(*cmd) + sizeof(NullBuffer*) * cmd->numBuffers);
+        }
+        case NullOpcodeEndStreamOutput:
+        {
+            return 0;
+        }
+        case NullOpcodeDraw:
+        {
+            return sizeof(NullCmdDraw);
+        }
+        case NullOpcodeDrawIndexed:
+        {
+            return sizeof(NullCmdDrawIndexed);
+        }
+        case NullOpcodeDrawIndirect:
+        case NullOpcodeDrawIndexedIndirect:
+        {
+            return sizeof(NullCmdDrawIndirect);
+        }
+        case NullOpcodeDispatch:
+        {
+            return sizeof(NullCmdDispatch);
+        }
+        case NullOpcodeDispatchIndirect:
+        {
+            return sizeof(NullCmdDispatchIndirect);
+        }
+        case NullOpcodePushDebugGroup:
+        {
+            auto cmd = reinterpret_cast<const NullCmdPushDebugGroup*>(pc);
+            return (sizeof(*cmd) + cmd->length + 1);
+        }
+        case NullOpcodePopDebugGroup:
+        {
+            return 0;
+        }
+        default:
+            return 0;
+    }
+}
+
+void ExecuteNullCommandBuffer(const NullCommandBuffer& cmdBuffer)
+{
+    /* Initialize program counter to execute virtual commands */
+    for (const auto& chunk : cmdBuffer.GetVirtualCommandBuffer())
+    {
+        auto pc     = chunk.data;
+        auto pcEnd  = chunk.data + chunk.size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode */
+            const NullOpcode opcode = *reinterpret_cast<const NullOpcode*>(pc);
+            pc += sizeof(NullOpcode);
+
+            /* Execute command and increment program counter */
+            pc += ExecuteNullCommand(opcode, pc);
+        }
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
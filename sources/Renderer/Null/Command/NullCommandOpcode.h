@@ -0,0 +1,69 @@
+/*
+ * NullCommandOpcode.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_COMMAND_OPCODE_H
+#define LLGL_NULL_COMMAND_OPCODE_H
+
+
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+enum NullOpcode : std::uint8_t
+{
+    NullOpcodeUpdateBuffer = 1,
+    NullOpcodeCopyBuffer,
+    NullOpcodeCopyBufferFromTexture,
+    NullOpcodeFillBuffer,
+    NullOpcodeCopyTexture,
+    NullOpcodeCopyTextureFromBuffer,
+    NullOpcodeGenerateMips,
+    NullOpcodeExecute,
+    NullOpcodeSetViewports,
+    NullOpcodeSetScissors,
+    NullOpcodeSetVertexBuffer,
+    NullOpcodeSetVertexBufferArray,
+    NullOpcodeSetIndexBuffer,
+    NullOpcodeSetResourceHeap,
+    NullOpcodeSetResource,
+    NullOpcodeResetResourceSlots,
+    NullOpcodeBeginRenderPass,
+    NullOpcodeEndRenderPass,
+    NullOpcodeClear,
+    NullOpcodeClearAttachments,
+    NullOpcodeSetPipelineState,
+    NullOpcodeSetBlendFactor,
+    NullOpcodeSetStencilReference,
+    NullOpcodeSetUniforms,
+    NullOpcodeBeginQuery,
+    NullOpcodeEndQuery,
+    NullOpcodeBeginRenderCondition,
+    NullOpcodeEndRenderCondition,
+    NullOpcodeBeginStreamOutput,
+    NullOpcodeEndStreamOutput,
+    NullOpcodeDraw,
+    NullOpcodeDrawIndexed,
+    NullOpcodeDrawIndirect,
+    NullOpcodeDrawIndexedIndirect,
+    NullOpcodeDispatch,
+    NullOpcodeDispatchIndirect,
+    NullOpcodePushDebugGroup,
+    NullOpcodePopDebugGroup,
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
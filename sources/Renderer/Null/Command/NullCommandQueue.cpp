@@ -0,0 +1,74 @@
+/*
+ * NullCommandQueue.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullCommandQueue.h"
+#include "NullCommandBuffer.h"
+#include "NullCommandExecutor.h"
+#include "../RenderState/NullQueryHeap.h"
+#include "../RenderState/NullFence.h"
+#include "../../CheckedCast.h"
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+/* ----- Command Buffers ----- */
+
+void NullCommandQueue::Submit(CommandBuffer& commandBuffer)
+{
+    /* Immediate command buffers have already been executed at the end of encoding */
+    auto& cmdBufferNull = LLGL_CAST(NullCommandBuffer&, commandBuffer);
+    if ((cmdBufferNull.GetFlags() & CommandBufferFlags::ImmediateSubmit) == 0)
+        ExecuteNullCommandBuffer(cmdBufferNull);
+}
+
+/* ----- Queries ----- */
+
+bool NullCommandQueue::QueryResult(
+    QueryHeap&      queryHeap,
+    std::uint32_t   firstQuery,
+    std::uint32_t   numQueries,
+    void*           data,
+    std::size_t     dataSize)
+{
+    auto& queryHeapNull = LLGL_CAST(NullQueryHeap&, queryHeap);
+    if (firstQuery + numQueries > queryHeapNull.GetNumQueries())
+        return false;
+
+    /* Nothing is ever rendered, so all query results are zero */
+    ::memset(data, 0, dataSize);
+    return true;
+}
+
+/* ----- Fences ----- */
+
+void NullCommandQueue::Submit(Fence& fence)
+{
+    /* All commands are executed synchronously, so fences are signaled right away */
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    fenceNull.Signal();
+}
+
+bool NullCommandQueue::WaitFence(Fence& fence, std::uint64_t /*timeout*/)
+{
+    auto& fenceNull = LLGL_CAST(NullFence&, fence);
+    return fenceNull.IsSignaled();
+}
+
+void NullCommandQueue::WaitIdle()
+{
+    // dummy
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,439 @@
+/*
+ * NullRenderSystem.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullRenderSystem.h"
+#include "../TextureUtils.h"
+#include "../CheckedCast.h"
+#include "../../Core/Helper.h"
+#include <LLGL/ImageFlags.h>
+#include <LLGL/StaticLimits.h>
+#include <limits>
+
+
+namespace LLGL
+{
+
+
+/* ----- Common ----- */
+
+NullRenderSystem::NullRenderSystem(const RenderSystemDescriptor& /*renderSystemDesc*/) :
+    commandQueue_ { MakeUnique<NullCommandQueue>() }
+{
+    /* Query renderer information and limits */
+    QueryRendererInfo();
+    QueryRenderingCaps();
+}
+
+/* ----- Swap-chain ----- */
+
+SwapChain* NullRenderSystem::CreateSwapChain(const SwapChainDescriptor& desc, const std::shared_ptr<Surface>& surface)
+{
+    return TakeOwnership(swapChains_, MakeUnique<NullSwapChain>(desc, surface));
+}
+
+void NullRenderSystem::Release(SwapChain& swapChain)
+{
+    RemoveFromUniqueSet(swapChains_, &swapChain);
+}
+
+/* ----- Command queues ----- */
+
+CommandQueue* NullRenderSystem::GetCommandQueue()
+{
+    return commandQueue_.get();
+}
+
+/* ----- Command buffers ----- */
+
+CommandBuffer* NullRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor& desc)
+{
+    return TakeOwnership(commandBuffers_, MakeUnique<NullCommandBuffer>(desc.flags));
+}
+
+void NullRenderSystem::Release(CommandBuffer& commandBuffer)
+{
+    RemoveFromUniqueSet(commandBuffers_, &commandBuffer);
+}
+
+/* ----- Buffers ------ */
+
+Buffer* NullRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* initialData)
+{
+    AssertCreateBuffer(desc, static_cast<std::uint64_t>(std::numeric_limits<std::size_t>::max()));
+    return TakeOwnership(buffers_, MakeUnique<NullBuffer>(desc, initialData));
+}
+
+BufferArray* NullRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer* const * bufferArray)
+{
+    AssertCreateBufferArray(numBuffers, bufferArray);
+    return TakeOwnership(bufferArrays_, MakeUnique<NullBufferArray>(numBuffers, bufferArray));
+}
+
+void NullRenderSystem::Release(Buffer& buffer)
+{
+    RemoveFromUniqueSet(buffers_, &buffer);
+}
+
+void NullRenderSystem::Release(BufferArray& bufferArray)
+{
+    RemoveFromUniqueSet(bufferArrays_, &bufferArray);
+}
+
+void NullRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, const void* data, std::uint64_t dataSize)
+{
+    auto& dstBufferNull = LLGL_CAST(NullBuffer&, dstBuffer);
+    dstBufferNull.Write(dstOffset, data, dataSize);
+}
+
+void* NullRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
+{
+    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    return bufferNull.Map(access);
+}
+
+void NullRenderSystem::UnmapBuffer(Buffer& buffer)
+{
+    auto& bufferNull = LLGL_CAST(NullBuffer&, buffer);
+    bufferNull.Unmap();
+}
+
+/* ----- Textures ----- */
+
+Texture* NullRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, const SrcImageDescriptor* imageDesc)
+{
+    auto textureNull = MakeUnique<NullTexture>(textureDesc);
+
+    if (imageDesc)
+    {
+        /* Write initial image data into first MIP-map level of all array layers */
+        TextureRegion region;
+        {
+            region.subresource.baseArrayLayer   = 0;
+            region.subresource.numArrayLayers   = textureDesc.arrayLayers;
+            region.subresource.baseMipLevel     = 0;
+            region.subresource.numMipLevels     = 1;
+            region.offset                       = Offset3D{ 0, 0, 0 };
+            region.extent                       = textureDesc.extent;
+        }
+        WriteNullTexture(*textureNull, region, *imageDesc);
+    }
+
+    return TakeOwnership(textures_, std::move(textureNull));
+}
+
+void NullRenderSystem::Release(Texture& texture)
+{
+    RemoveFromUniqueSet(textures_, &texture);
+}
+
+void NullRenderSystem::WriteTexture(Texture& texture, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
+{
+    auto& textureNull = LLGL_CAST(NullTexture&, texture);
+    WriteNullTexture(textureNull, textureRegion, imageDesc);
+}
+
+void NullRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
+{
+    auto& textureNull = LLGL_CAST(NullTexture&, texture);
+
+    /* Read texture region into tightly packed intermediate buffer in the texture's native format */
+    std::vector<char> intermediateData(textureNull.GetRegionDataSize(textureRegion));
+    textureNull.Read(textureRegion, intermediateData.data());
+
+    /* Copy intermediate buffer into output image and convert it if necessary */
+    const auto extent = CalcTextureExtent(textureNull.GetType(), textureRegion.extent, textureRegion.subresource.numArrayLayers);
+    CopyTextureImageData(imageDesc, extent, textureNull.GetFormat(), intermediateData.data());
+}
+
+/* ----- Sampler States ---- */
+
+Sampler* NullRenderSystem::CreateSampler(const SamplerDescriptor& desc)
+{
+    return TakeOwnership(samplers_, MakeUnique<NullSampler>(desc));
+}
+
+void NullRenderSystem::Release(Sampler& sampler)
+{
+    RemoveFromUniqueSet(samplers_, &sampler);
+}
+
+/* ----- Resource Heaps ----- */
+
+ResourceHeap* NullRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
+{
+    return TakeOwnership(resourceHeaps_, MakeUnique<NullResourceHeap>(desc));
+}
+
+void NullRenderSystem::Release(ResourceHeap& resourceHeap)
+{
+    RemoveFromUniqueSet(resourceHeaps_, &resourceHeap);
+}
+
+/* ----- Render Passes ----- */
+
+RenderPass* NullRenderSystem::CreateRenderPass(const RenderPassDescriptor& desc)
+{
+    AssertCreateRenderPass(desc);
+    return TakeOwnership(renderPasses_, MakeUnique<NullRenderPass>(desc));
+}
+
+void NullRenderSystem::Release(RenderPass& renderPass)
+{
+    RemoveFromUniqueSet(renderPasses_, &renderPass);
+}
+
+/* ----- Render Targets ----- */
+
+RenderTarget* NullRenderSystem::CreateRenderTarget(const RenderTargetDescriptor& desc)
+{
+    AssertCreateRenderTarget(desc);
+    return TakeOwnership(renderTargets_, MakeUnique<NullRenderTarget>(desc));
+}
+
+void NullRenderSystem::Release(RenderTarget& renderTarget)
+{
+    RemoveFromUniqueSet(renderTargets_, &renderTarget);
+}
+
+/* ----- Shader ----- */
+
+Shader* NullRenderSystem::CreateShader(const ShaderDescriptor& desc)
+{
+    AssertCreateShader(desc);
+    return TakeOwnership(shaders_, MakeUnique<NullShader>(desc));
+}
+
+ShaderProgram* NullRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
+{
+    AssertCreateShaderProgram(desc);
+    return TakeOwnership(shaderPrograms_, MakeUnique<NullShaderProgram>(desc));
+}
+
+void NullRenderSystem::Release(Shader& shader)
+{
+    RemoveFromUniqueSet(shaders_, &shader);
+}
+
+void NullRenderSystem::Release(ShaderProgram& shaderProgram)
+{
+    RemoveFromUniqueSet(shaderPrograms_, &shaderProgram);
+}
+
+/* ----- Pipeline Layouts ----- */
+
+PipelineLayout* NullRenderSystem::CreatePipelineLayout(const PipelineLayoutDescriptor& desc)
+{
+    return TakeOwnership(pipelineLayouts_, MakeUnique<NullPipelineLayout>(desc));
+}
+
+void NullRenderSystem::Release(PipelineLayout& pipelineLayout)
+{
+    RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
+}
+
+/* ----- Pipeline States ----- */
+
+PipelineState* NullRenderSystem::CreatePipelineState(const Blob& /*serializedCache*/)
+{
+    return nullptr; // dummy
+}
+
+PipelineState* NullRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+{
+    return TakeOwnership(pipelineStates_, MakeUnique<NullPipelineState>(desc));
+}
+
+PipelineState* NullRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+{
+    return TakeOwnership(pipelineStates_, MakeUnique<NullPipelineState>(desc));
+}
+
+void NullRenderSystem::Release(PipelineState& pipelineState)
+{
+    RemoveFromUniqueSet(pipelineStates_, &pipelineState);
+}
+
+/* ----- Queries ----- */
+
+QueryHeap* NullRenderSystem::CreateQueryHeap(const QueryHeapDescriptor& desc)
+{
+    return TakeOwnership(queryHeaps_, MakeUnique<NullQueryHeap>(desc));
+}
+
+void NullRenderSystem::Release(QueryHeap& queryHeap)
+{
+    RemoveFromUniqueSet(queryHeaps_, &queryHeap);
+}
+
+/* ----- Fences ----- */
+
+Fence* NullRenderSystem::CreateFence()
+{
+    return TakeOwnership(fences_, MakeUnique<NullFence>());
+}
+
+void NullRenderSystem::Release(Fence& fence)
+{
+    RemoveFromUniqueSet(fences_, &fence);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullRenderSystem::QueryRendererInfo()
+{
+    RendererInfo info;
+    {
+        info.rendererName           = "Null";
+        info.deviceName             = "Null Device";
+        info.vendorName             = "LLGL";
+        info.shadingLanguageName    = "None";
+    }
+    SetRendererInfo(info);
+}
+
+// Returns a list of all formats, since the Null renderer can store any texture format in CPU memory.
+static std::vector<Format> GetAllNullTextureFormats()
+{
+    std::vector<Format> formats;
+    for (auto i = static_cast<int>(Format::Undefined) + 1; i <= static_cast<int>(Format::BC7UNorm_sRGB); ++i)
+        formats.push_back(static_cast<Format>(i));
+    return formats;
+}
+
+void NullRenderSystem::QueryRenderingCaps()
+{
+    RenderingCapabilities caps;
+    {
+        /* Query common attributes */
+        caps.screenOrigin                               = ScreenOrigin::UpperLeft;
+        caps.clippingRange                              = ClippingRange::ZeroToOne;
+        caps.shadingLanguages                           =
+        {
+            ShadingLanguage::GLSL,  ShadingLanguage::GLSL_110, ShadingLanguage::GLSL_120, ShadingLanguage::GLSL_130,
+            ShadingLanguage::GLSL_140, ShadingLanguage::GLSL_150, ShadingLanguage::GLSL_330, ShadingLanguage::GLSL_400,
+            ShadingLanguage::GLSL_410, ShadingLanguage::GLSL_420, ShadingLanguage::GLSL_430, ShadingLanguage::GLSL_440,
+            ShadingLanguage::GLSL_450, ShadingLanguage::GLSL_460,
+            ShadingLanguage::ESSL,  ShadingLanguage::ESSL_100, ShadingLanguage::ESSL_300, ShadingLanguage::ESSL_310,
+            ShadingLanguage::ESSL_320,
+            ShadingLanguage::HLSL,  ShadingLanguage::HLSL_2_0, ShadingLanguage::HLSL_2_0a, ShadingLanguage::HLSL_2_0b,
+            ShadingLanguage::HLSL_3_0, ShadingLanguage::HLSL_4_0, ShadingLanguage::HLSL_4_1, ShadingLanguage::HLSL_5_0,
+            ShadingLanguage::HLSL_5_1, ShadingLanguage::HLSL_6_0, ShadingLanguage::HLSL_6_1, ShadingLanguage::HLSL_6_2,
+            ShadingLanguage::HLSL_6_3, ShadingLanguage::HLSL_6_4,
+            ShadingLanguage::Metal, ShadingLanguage::Metal_1_0, ShadingLanguage::Metal_1_1, ShadingLanguage::Metal_1_2,
+            ShadingLanguage::Metal_2_0, ShadingLanguage::Metal_2_1,
+            ShadingLanguage::SPIRV, ShadingLanguage::SPIRV_100,
+        };
+        caps.textureFormats                             = GetAllNullTextureFormats();
+
+        /* Query features, all of which are supported since commands are not executed on a GPU */
+        caps.features.hasDirectResourceBinding          = true;
+        caps.features.hasRenderTargets                  = true;
+        caps.features.has3DTextures                     = true;
+        caps.features.hasCubeTextures                   = true;
+        caps.features.hasArrayTextures                  = true;
+        caps.features.hasCubeArrayTextures              = true;
+        caps.features.hasMultiSampleTextures            = true;
+        caps.features.hasTextureViews                   = true;
+        caps.features.hasTextureViewSwizzle             = true;
+        caps.features.hasBufferViews                    = true;
+        caps.features.hasSamplers                       = true;
+        caps.features.hasConstantBuffers                = true;
+        caps.features.hasStorageBuffers                 = true;
+        caps.features.hasUniforms                       = true;
+        caps.features.hasGeometryShaders                = true;
+        caps.features.hasTessellationShaders            = true;
+        caps.features.hasTessellatorStage               = true;
+        caps.features.hasComputeShaders                 = true;
+        caps.features.hasInstancing                     = true;
+        caps.features.hasOffsetInstancing               = true;
+        caps.features.hasIndirectDrawing                = true;
+        caps.features.hasViewportArrays                 = true;
+        caps.features.hasConservativeRasterization      = true;
+        caps.features.hasStreamOutputs                  = true;
+        caps.features.hasLogicOp                        = true;
+        caps.features.hasPipelineStatistics             = true;
+        caps.features.hasRenderCondition                = true;
+
+        /* Query limits */
+        caps.limits.lineWidthRange[0]                   = 1.0f;
+        caps.limits.lineWidthRange[1]                   = 1.0f;
+        caps.limits.maxTextureArrayLayers               = 2048u;
+        caps.limits.maxColorAttachments                 = 8u;
+        caps.limits.maxPatchVertices                    = 32u;
+        caps.limits.max1DTextureSize                    = 16384u;
+        caps.limits.max2DTextureSize                    = 16384u;
+        caps.limits.max3DTextureSize                    = 2048u;
+        caps.limits.maxCubeTextureSize                  = 16384u;
+        caps.limits.maxAnisotropy                       = 16u;
+        caps.limits.maxComputeShaderWorkGroups[0]       = 65535u;
+        caps.limits.maxComputeShaderWorkGroups[1]       = 65535u;
+        caps.limits.maxComputeShaderWorkGroups[2]       = 65535u;
+        caps.limits.maxComputeShaderWorkGroupSize[0]    = 1024u;
+        caps.limits.maxComputeShaderWorkGroupSize[1]    = 1024u;
+        caps.limits.maxComputeShaderWorkGroupSize[2]    = 64u;
+        caps.limits.maxViewports                        = LLGL_MAX_NUM_VIEWPORTS_AND_SCISSORS;
+        caps.limits.maxViewportSize[0]                  = 16384u;
+        caps.limits.maxViewportSize[1]                  = 16384u;
+        caps.limits.maxBufferSize                       = std::numeric_limits<std::uint64_t>::max();
+        caps.limits.maxConstantBufferSize               = 65536u;
+        caps.limits.maxStreamOutputs                    = 4u;
+        caps.limits.maxTessFactor                       = 64u;
+        caps.limits.minConstantBufferAlignment          = 256u;
+        caps.limits.minSampledBufferAlignment           = 16u;
+        caps.limits.minStorageBufferAlignment           = 16u;
+    }
+    SetRenderingCaps(caps);
+}
+
+void NullRenderSystem::WriteNullTexture(NullTexture& textureNull, const TextureRegion& textureRegion, const SrcImageDescriptor& imageDesc)
+{
+    const auto& cfg = GetConfiguration();
+
+    /* Determine number of texels including the array layers */
+    const auto extent       = CalcTextureExtent(textureNull.GetType(), textureRegion.extent, textureRegion.subresource.numArrayLayers);
+    const auto imageSize    = extent.width * extent.height * extent.depth;
+
+    /* Check if image data must be converted */
+    ByteBuffer intermediateData;
+
+    const auto& formatAttribs = GetFormatAttribs(textureNull.GetFormat());
+    if (formatAttribs.bitSize > 0 && (formatAttribs.flags & FormatFlags::IsCompressed) == 0)
+    {
+        /* Convert image format (will be null if no conversion is necessary) */
+        intermediateData = ConvertImageBuffer(imageDesc, formatAttribs.format, formatAttribs.dataType, cfg.threadCount);
+    }
+
+    if (intermediateData)
+    {
+        /*
+        Validate that source image data was large enough so conversion is valid,
+        then use temporary image buffer as source for the texture
+        */
+        const auto srcImageDataSize = imageSize * ImageFormatSize(imageDesc.format) * DataTypeSize(imageDesc.dataType);
+        AssertImageDataSize(imageDesc.dataSize, static_cast<std::size_t>(srcImageDataSize));
+        textureNull.Write(textureRegion, intermediateData.get());
+    }
+    else
+    {
+        /*
+        Validate that image data is large enough,
+        then use input data as source for the texture
+        */
+        AssertImageDataSize(imageDesc.dataSize, textureNull.GetRegionDataSize(textureRegion));
+        textureNull.Write(textureRegion, imageDesc.data);
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
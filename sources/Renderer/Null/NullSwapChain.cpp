@@ -0,0 +1,103 @@
+/*
+ * NullSwapChain.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullSwapChain.h"
+#include "NullWindow.h"
+#include "../TextureUtils.h"
+
+
+namespace LLGL
+{
+
+
+// Returns the depth-stencil format that matches the specified number of bits.
+static Format NullPickDepthStencilFormat(int depthBits, int stencilBits)
+{
+    if (depthBits == 0 && stencilBits == 0)
+        return Format::Undefined;
+    if (depthBits == 32)
+        return (stencilBits == 8 ? Format::D32FloatS8X24UInt : Format::D32Float);
+    if (depthBits == 16 && stencilBits == 0)
+        return Format::D16UNorm;
+    return Format::D24UNormS8UInt;
+}
+
+NullSwapChain::NullSwapChain(const SwapChainDescriptor& desc, const std::shared_ptr<Surface>& surface) :
+    SwapChain           { desc                                                         },
+    depthStencilFormat_ { NullPickDepthStencilFormat(desc.depthBits, desc.stencilBits) },
+    samples_            { GetClampedSamples(desc.samples)                              }
+{
+    #ifndef LLGL_MOBILE_PLATFORM
+
+    if (surface)
+    {
+        /* Setup custom surface for the swap-chain; fullscreen mode is ignored since no display is involved */
+        SetOrCreateSurface(surface, desc.resolution, false, nullptr);
+    }
+    else
+    {
+        /* Create headless window as surface, so the swap-chain does not depend on a display server */
+        WindowDescriptor windowDesc;
+        {
+            windowDesc.size = desc.resolution;
+        }
+        SetOrCreateSurface(std::make_shared<NullWindow>(windowDesc), desc.resolution, false, nullptr);
+    }
+
+    #else
+
+    SetOrCreateSurface(surface, desc.resolution, false, nullptr);
+
+    #endif
+}
+
+void NullSwapChain::Present()
+{
+    // dummy
+}
+
+std::uint32_t NullSwapChain::GetSamples() const
+{
+    return samples_;
+}
+
+Format NullSwapChain::GetColorFormat() const
+{
+    return colorFormat_;
+}
+
+Format NullSwapChain::GetDepthStencilFormat() const
+{
+    return depthStencilFormat_;
+}
+
+const RenderPass* NullSwapChain::GetRenderPass() const
+{
+    return nullptr; // dummy
+}
+
+bool NullSwapChain::SetVsyncInterval(std::uint32_t /*vsyncInterval*/)
+{
+    return true; // dummy
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool NullSwapChain::ResizeBuffersPrimary(const Extent2D& /*resolution*/)
+{
+    return true; // dummy
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
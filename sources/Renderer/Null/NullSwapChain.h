@@ -0,0 +1,58 @@
+/*
+ * NullSwapChain.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_SWAP_CHAIN_H
+#define LLGL_NULL_SWAP_CHAIN_H
+
+
+#include <LLGL/SwapChain.h>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class NullSwapChain final : public SwapChain
+{
+
+    public:
+
+        NullSwapChain(const SwapChainDescriptor& desc, const std::shared_ptr<Surface>& surface);
+
+        void Present() override;
+
+        std::uint32_t GetSamples() const override;
+
+        Format GetColorFormat() const override;
+        Format GetDepthStencilFormat() const override;
+
+        const RenderPass* GetRenderPass() const override;
+
+        bool SetVsyncInterval(std::uint32_t vsyncInterval) override;
+
+    private:
+
+        bool ResizeBuffersPrimary(const Extent2D& resolution) override;
+
+    private:
+
+        Format          colorFormat_        = Format::RGBA8UNorm;
+        Format          depthStencilFormat_ = Format::Undefined;
+        std::uint32_t   samples_            = 1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
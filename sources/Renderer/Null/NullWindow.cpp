@@ -0,0 +1,105 @@
+/*
+ * NullWindow.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullWindow.h"
+
+
+namespace LLGL
+{
+
+
+NullWindow::NullWindow(const WindowDescriptor& desc) :
+    desc_ { desc }
+{
+}
+
+bool NullWindow::GetNativeHandle(void* /*nativeHandle*/, std::size_t /*nativeHandleSize*/) const
+{
+    return false; // no native handle available
+}
+
+void NullWindow::ResetPixelFormat()
+{
+    // dummy
+}
+
+Extent2D NullWindow::GetContentSize() const
+{
+    return desc_.size;
+}
+
+void NullWindow::SetPosition(const Offset2D& position)
+{
+    desc_.position = position;
+}
+
+Offset2D NullWindow::GetPosition() const
+{
+    return desc_.position;
+}
+
+void NullWindow::SetSize(const Extent2D& size, bool /*useClientArea*/)
+{
+    if (desc_.size != size)
+    {
+        desc_.size = size;
+        PostResize(size);
+    }
+}
+
+Extent2D NullWindow::GetSize(bool /*useClientArea*/) const
+{
+    return desc_.size;
+}
+
+void NullWindow::SetTitle(const std::wstring& title)
+{
+    desc_.title = title;
+}
+
+std::wstring NullWindow::GetTitle() const
+{
+    return desc_.title;
+}
+
+void NullWindow::Show(bool show)
+{
+    desc_.visible = show;
+}
+
+bool NullWindow::IsShown() const
+{
+    return desc_.visible;
+}
+
+void NullWindow::SetDesc(const WindowDescriptor& desc)
+{
+    SetSize(desc.size);
+    desc_ = desc;
+}
+
+WindowDescriptor NullWindow::GetDesc() const
+{
+    return desc_;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullWindow::OnProcessEvents()
+{
+    // dummy
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
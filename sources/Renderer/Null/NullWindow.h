@@ -0,0 +1,70 @@
+/*
+ * NullWindow.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_WINDOW_H
+#define LLGL_NULL_WINDOW_H
+
+
+#include <LLGL/Window.h>
+#include <LLGL/WindowFlags.h>
+
+
+namespace LLGL
+{
+
+
+/*
+Headless window that is used as surface for Null swap-chains when the client programmer does not specify a surface.
+It never opens a native window, so the Null render system can also run on machines without a display server.
+*/
+class NullWindow final : public Window
+{
+
+    public:
+
+        NullWindow(const WindowDescriptor& desc);
+
+        bool GetNativeHandle(void* nativeHandle, std::size_t nativeHandleSize) const override;
+
+        void ResetPixelFormat() override;
+
+        Extent2D GetContentSize() const override;
+
+        void SetPosition(const Offset2D& position) override;
+        Offset2D GetPosition() const override;
+
+        void SetSize(const Extent2D& size, bool useClientArea = true) override;
+        Extent2D GetSize(bool useClientArea = true) const override;
+
+        void SetTitle(const std::wstring& title) override;
+        std::wstring GetTitle() const override;
+
+        void Show(bool show = true) override;
+        bool IsShown() const override;
+
+        void SetDesc(const WindowDescriptor& desc) override;
+        WindowDescriptor GetDesc() const override;
+
+    private:
+
+        void OnProcessEvents() override;
+
+    private:
+
+        WindowDescriptor desc_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
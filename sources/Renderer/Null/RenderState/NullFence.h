@@ -0,0 +1,51 @@
+/*
+ * NullFence.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_FENCE_H
+#define LLGL_NULL_FENCE_H
+
+
+#include <LLGL/Fence.h>
+
+
+namespace LLGL
+{
+
+
+// Fence that is signaled as soon as it is submitted, since all commands are executed synchronously.
+class NullFence final : public Fence
+{
+
+    public:
+
+        // Marks this fence as signaled.
+        inline void Signal()
+        {
+            signaled_ = true;
+        }
+
+        // Returns true if this fence has been signaled.
+        inline bool IsSignaled() const
+        {
+            return signaled_;
+        }
+
+    private:
+
+        bool signaled_ = false;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
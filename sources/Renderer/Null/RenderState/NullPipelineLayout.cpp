@@ -0,0 +1,30 @@
+/*
+ * NullPipelineLayout.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullPipelineLayout.h"
+
+
+namespace LLGL
+{
+
+
+NullPipelineLayout::NullPipelineLayout(const PipelineLayoutDescriptor& desc) :
+    bindings_ { desc.bindings }
+{
+}
+
+std::uint32_t NullPipelineLayout::GetNumBindings() const
+{
+    return static_cast<std::uint32_t>(bindings_.size());
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
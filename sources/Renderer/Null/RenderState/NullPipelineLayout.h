@@ -0,0 +1,50 @@
+/*
+ * NullPipelineLayout.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_PIPELINE_LAYOUT_H
+#define LLGL_NULL_PIPELINE_LAYOUT_H
+
+
+#include <LLGL/PipelineLayout.h>
+#include <LLGL/PipelineLayoutFlags.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class NullPipelineLayout final : public PipelineLayout
+{
+
+    public:
+
+        NullPipelineLayout(const PipelineLayoutDescriptor& desc);
+
+        std::uint32_t GetNumBindings() const override;
+
+        // Returns the list of binding descriptors.
+        inline const std::vector<BindingDescriptor>& GetBindings() const
+        {
+            return bindings_;
+        }
+
+    private:
+
+        std::vector<BindingDescriptor> bindings_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
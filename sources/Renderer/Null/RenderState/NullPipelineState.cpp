@@ -0,0 +1,34 @@
+/*
+ * NullPipelineState.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullPipelineState.h"
+
+
+namespace LLGL
+{
+
+
+NullPipelineState::NullPipelineState(const GraphicsPipelineDescriptor& desc) :
+    isGraphicsPSO_  { true                  },
+    pipelineLayout_ { desc.pipelineLayout   },
+    shaderProgram_  { desc.shaderProgram    }
+{
+}
+
+NullPipelineState::NullPipelineState(const ComputePipelineDescriptor& desc) :
+    isGraphicsPSO_  { false                 },
+    pipelineLayout_ { desc.pipelineLayout   },
+    shaderProgram_  { desc.shaderProgram    }
+{
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,63 @@
+/*
+ * NullPipelineState.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_PIPELINE_STATE_H
+#define LLGL_NULL_PIPELINE_STATE_H
+
+
+#include <LLGL/PipelineState.h>
+#include <LLGL/PipelineStateFlags.h>
+
+
+namespace LLGL
+{
+
+
+// Pipeline state that only keeps references to the objects it was created with.
+class NullPipelineState final : public PipelineState
+{
+
+    public:
+
+        NullPipelineState(const GraphicsPipelineDescriptor& desc);
+        NullPipelineState(const ComputePipelineDescriptor& desc);
+
+        // Returns true if this is a graphics pipeline.
+        inline bool IsGraphicsPSO() const
+        {
+            return isGraphicsPSO_;
+        }
+
+        // Returns the pipeline layout this PSO was created with or null.
+        inline const PipelineLayout* GetPipelineLayout() const
+        {
+            return pipelineLayout_;
+        }
+
+        // Returns the shader program this PSO was created with or null.
+        inline const ShaderProgram* GetShaderProgram() const
+        {
+            return shaderProgram_;
+        }
+
+    private:
+
+        bool                    isGraphicsPSO_  = false;
+        const PipelineLayout*   pipelineLayout_ = nullptr;
+        const ShaderProgram*    shaderProgram_  = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,48 @@
+/*
+ * NullResourceHeap.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullResourceHeap.h"
+#include "NullPipelineLayout.h"
+#include "../../CheckedCast.h"
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+NullResourceHeap::NullResourceHeap(const ResourceHeapDescriptor& desc) :
+    resourceViews_ { desc.resourceViews }
+{
+    /* Validate pipeline layout */
+    auto pipelineLayoutNull = LLGL_CAST(const NullPipelineLayout*, desc.pipelineLayout);
+    if (!pipelineLayoutNull)
+        throw std::invalid_argument("failed to create resource heap due to missing pipeline layout");
+
+    /* Validate number of resource views */
+    const auto numBindings = pipelineLayoutNull->GetNumBindings();
+    if (numBindings == 0)
+        throw std::invalid_argument("cannot create resource heap without bindings in pipeline layout");
+
+    const auto numResourceViews = static_cast<std::uint32_t>(desc.resourceViews.size());
+    if (numResourceViews % numBindings != 0)
+        throw std::invalid_argument("failed to create resource heap due to mismatch between number of resources and bindings");
+
+    numDescriptorSets_ = numResourceViews / numBindings;
+}
+
+std::uint32_t NullResourceHeap::GetNumDescriptorSets() const
+{
+    return numDescriptorSets_;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,58 @@
+/*
+ * NullShader.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullShader.h"
+#include <LLGL/ShaderProgramFlags.h>
+
+
+namespace LLGL
+{
+
+
+NullShader::NullShader(const ShaderDescriptor& desc) :
+    Shader    { desc.type     },
+    vertex_   { desc.vertex   },
+    fragment_ { desc.fragment },
+    compute_  { desc.compute  }
+{
+}
+
+bool NullShader::HasErrors() const
+{
+    return false;
+}
+
+std::string NullShader::GetReport() const
+{
+    return "";
+}
+
+void NullShader::Reflect(ShaderReflection& reflection) const
+{
+    switch (GetType())
+    {
+        case ShaderType::Vertex:
+            reflection.vertex.inputAttribs.insert(reflection.vertex.inputAttribs.end(), vertex_.inputAttribs.begin(), vertex_.inputAttribs.end());
+            reflection.vertex.outputAttribs.insert(reflection.vertex.outputAttribs.end(), vertex_.outputAttribs.begin(), vertex_.outputAttribs.end());
+            break;
+        case ShaderType::Fragment:
+            reflection.fragment.outputAttribs.insert(reflection.fragment.outputAttribs.end(), fragment_.outputAttribs.begin(), fragment_.outputAttribs.end());
+            break;
+        case ShaderType::Compute:
+            reflection.compute = compute_;
+            break;
+        default:
+            break;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,53 @@
+/*
+ * NullShader.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_SHADER_H
+#define LLGL_NULL_SHADER_H
+
+
+#include <LLGL/Shader.h>
+#include <LLGL/ShaderFlags.h>
+#include <LLGL/ShaderProgramFlags.h>
+
+
+namespace LLGL
+{
+
+
+// Shader that is never compiled. Only the attributes of the shader descriptor are kept for reflection.
+class NullShader final : public Shader
+{
+
+    public:
+
+        NullShader(const ShaderDescriptor& desc);
+
+        bool HasErrors() const override;
+        std::string GetReport() const override;
+
+    public:
+
+        // Appends the attributes of this shader to the specified reflection.
+        void Reflect(ShaderReflection& reflection) const;
+
+    private:
+
+        VertexShaderAttributes      vertex_;
+        FragmentShaderAttributes    fragment_;
+        ComputeShaderAttributes     compute_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
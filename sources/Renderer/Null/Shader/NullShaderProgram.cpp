@@ -0,0 +1,88 @@
+/*
+ * NullShaderProgram.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullShaderProgram.h"
+#include "NullShader.h"
+#include "../../CheckedCast.h"
+
+
+namespace LLGL
+{
+
+
+NullShaderProgram::NullShaderProgram(const ShaderProgramDescriptor& desc)
+{
+    Attach(desc.vertexShader);
+    Attach(desc.tessControlShader);
+    Attach(desc.tessEvaluationShader);
+    Attach(desc.geometryShader);
+    Attach(desc.fragmentShader);
+    Attach(desc.computeShader);
+    LinkProgram();
+}
+
+bool NullShaderProgram::HasErrors() const
+{
+    return (linkError_ != LinkError::NoError);
+}
+
+std::string NullShaderProgram::GetReport() const
+{
+    if (auto s = ShaderProgram::LinkErrorToString(linkError_))
+        return s;
+    else
+        return "";
+}
+
+bool NullShaderProgram::Reflect(ShaderReflection& reflection) const
+{
+    /* Only the attributes from the shader descriptors can be reflected, since shaders are never compiled */
+    ShaderProgram::ClearShaderReflection(reflection);
+    for (auto shader : shaders_)
+        shader->Reflect(reflection);
+    ShaderProgram::FinalizeShaderReflection(reflection);
+    return true;
+}
+
+UniformLocation NullShaderProgram::FindUniformLocation(const char* /*name*/) const
+{
+    return -1;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void NullShaderProgram::Attach(Shader* shader)
+{
+    if (shader != nullptr)
+    {
+        auto shaderNull = LLGL_CAST(NullShader*, shader);
+        shaders_.push_back(shaderNull);
+    }
+}
+
+void NullShaderProgram::LinkProgram()
+{
+    /* Validate composition of attached shaders */
+    Shader* shaders[6] = {};
+    std::size_t numShaders = 0;
+
+    for (auto shader : shaders_)
+        shaders[numShaders++] = shader;
+
+    if (!ShaderProgram::ValidateShaderComposition(shaders, numShaders))
+        linkError_ = LinkError::InvalidComposition;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,56 @@
+/*
+ * NullShaderProgram.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_SHADER_PROGRAM_H
+#define LLGL_NULL_SHADER_PROGRAM_H
+
+
+#include <LLGL/ShaderProgram.h>
+#include <LLGL/ShaderProgramFlags.h>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+class NullShader;
+
+class NullShaderProgram final : public ShaderProgram
+{
+
+    public:
+
+        NullShaderProgram(const ShaderProgramDescriptor& desc);
+
+        bool HasErrors() const override;
+        std::string GetReport() const override;
+
+        bool Reflect(ShaderReflection& reflection) const override;
+        UniformLocation FindUniformLocation(const char* name) const override;
+
+    private:
+
+        void Attach(Shader* shader);
+        void LinkProgram();
+
+    private:
+
+        std::vector<NullShader*>    shaders_;
+        LinkError                   linkError_ = LinkError::NoError;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
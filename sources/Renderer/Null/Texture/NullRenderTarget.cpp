@@ -0,0 +1,77 @@
+/*
+ * NullRenderTarget.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullRenderTarget.h"
+#include "../../TextureUtils.h"
+
+
+namespace LLGL
+{
+
+
+NullRenderTarget::NullRenderTarget(const RenderTargetDescriptor& desc) :
+    resolution_ { desc.resolution                   },
+    samples_    { GetClampedSamples(desc.samples)   },
+    renderPass_ { desc.renderPass                   }
+{
+    for (const auto& attachment : desc.attachments)
+    {
+        switch (attachment.type)
+        {
+            case AttachmentType::Color:
+                ++numColorAttachments_;
+                break;
+            case AttachmentType::Depth:
+                hasDepthAttachment_ = true;
+                break;
+            case AttachmentType::DepthStencil:
+                hasDepthAttachment_ = true;
+                hasStencilAttachment_ = true;
+                break;
+            case AttachmentType::Stencil:
+                hasStencilAttachment_ = true;
+                break;
+        }
+    }
+}
+
+Extent2D NullRenderTarget::GetResolution() const
+{
+    return resolution_;
+}
+
+std::uint32_t NullRenderTarget::GetSamples() const
+{
+    return samples_;
+}
+
+std::uint32_t NullRenderTarget::GetNumColorAttachments() const
+{
+    return numColorAttachments_;
+}
+
+bool NullRenderTarget::HasDepthAttachment() const
+{
+    return hasDepthAttachment_;
+}
+
+bool NullRenderTarget::HasStencilAttachment() const
+{
+    return hasStencilAttachment_;
+}
+
+const RenderPass* NullRenderTarget::GetRenderPass() const
+{
+    return renderPass_;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,57 @@
+/*
+ * NullRenderTarget.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_RENDER_TARGET_H
+#define LLGL_NULL_RENDER_TARGET_H
+
+
+#include <LLGL/RenderTarget.h>
+#include <LLGL/RenderTargetFlags.h>
+
+
+namespace LLGL
+{
+
+
+class NullRenderTarget final : public RenderTarget
+{
+
+    public:
+
+        Extent2D GetResolution() const override;
+        std::uint32_t GetSamples() const override;
+        std::uint32_t GetNumColorAttachments() const override;
+
+        bool HasDepthAttachment() const override;
+        bool HasStencilAttachment() const override;
+
+        const RenderPass* GetRenderPass() const override;
+
+    public:
+
+        NullRenderTarget(const RenderTargetDescriptor& desc);
+
+    private:
+
+        Extent2D            resolution_;
+        std::uint32_t       samples_                = 1;
+        std::uint32_t       numColorAttachments_    = 0;
+        bool                hasDepthAttachment_     = false;
+        bool                hasStencilAttachment_   = false;
+        const RenderPass*   renderPass_             = nullptr;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
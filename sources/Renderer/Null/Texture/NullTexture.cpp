@@ -0,0 +1,276 @@
+/*
+ * NullTexture.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "NullTexture.h"
+#include "../../TextureUtils.h"
+#include <LLGL/Format.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+// Returns the number of blocks that are required to cover the specified number of texels.
+static std::size_t NumBlocks(std::uint32_t texels, std::uint32_t blockSize)
+{
+    return static_cast<std::size_t>((texels + blockSize - 1) / blockSize);
+}
+
+// Returns the extent of the specified MIP-map level including the array layers.
+static Extent3D GetNullTextureMipExtent(const TextureDescriptor& desc, std::uint32_t mipLevel)
+{
+    const Extent3D mipExtent
+    {
+        std::max(1u, desc.extent.width  >> mipLevel),
+        std::max(1u, desc.extent.height >> mipLevel),
+        std::max(1u, desc.extent.depth  >> mipLevel),
+    };
+    return CalcTextureExtent(desc.type, mipExtent, desc.arrayLayers);
+}
+
+NullTexture::NullTexture(const TextureDescriptor& desc) :
+    Texture { desc.type, desc.bindFlags },
+    desc_   { desc                      }
+{
+    /* Determine actual number of MIP-map levels */
+    desc_.mipLevels = NumMipLevels(desc);
+
+    /* Allocate zero initialized storage for each MIP-map level */
+    mips_.resize(desc_.mipLevels);
+    for (std::uint32_t mipLevel = 0; mipLevel < desc_.mipLevels; ++mipLevel)
+    {
+        const auto layout = GetRegionLayout(GetMipExtent(mipLevel));
+        mips_[mipLevel].resize(layout.rowSize * layout.numRows * layout.numLayers, 0);
+    }
+}
+
+Extent3D NullTexture::GetMipExtent(std::uint32_t mipLevel) const
+{
+    if (mipLevel < desc_.mipLevels)
+        return GetNullTextureMipExtent(desc_, mipLevel);
+    else
+        return {};
+}
+
+TextureDescriptor NullTexture::GetDesc() const
+{
+    return desc_;
+}
+
+Format NullTexture::GetFormat() const
+{
+    return desc_.format;
+}
+
+// Copies the rows of an image between two memory locations with their respective strides.
+static void CopyImageRows(
+    char*           dst,
+    std::size_t     dstRowStride,
+    std::size_t     dstLayerStride,
+    const char*     src,
+    std::size_t     srcRowStride,
+    std::size_t     srcLayerStride,
+    std::size_t     rowSize,
+    std::size_t     numRows,
+    std::size_t     numLayers)
+{
+    for (std::size_t layer = 0; layer < numLayers; ++layer)
+    {
+        auto dstRow = dst + layer * dstLayerStride;
+        auto srcRow = src + layer * srcLayerStride;
+        for (std::size_t row = 0; row < numRows; ++row)
+        {
+            ::memcpy(dstRow, srcRow, rowSize);
+            dstRow += dstRowStride;
+            srcRow += srcRowStride;
+        }
+    }
+}
+
+void NullTexture::Write(const TextureRegion& region, const void* data, std::size_t rowStride, std::size_t layerStride)
+{
+    Offset3D offset;
+    Extent3D extent;
+    GetTexelRegion(region, offset, extent);
+
+    const auto mipLevel = region.subresource.baseMipLevel;
+    AssertTexelRegion(mipLevel, offset, extent);
+
+    /* Determine strides of source image and destination MIP-map */
+    const auto srcLayout = GetRegionLayout(extent);
+    const auto dstLayout = GetRegionLayout(GetMipExtent(mipLevel));
+
+    if (rowStride == 0)
+        rowStride = srcLayout.rowSize;
+    if (layerStride == 0)
+        layerStride = rowStride * srcLayout.numRows;
+
+    CopyImageRows(
+        mips_[mipLevel].data() + GetTexelDataOffset(offset, GetMipExtent(mipLevel)),
+        dstLayout.rowSize,
+        dstLayout.rowSize * dstLayout.numRows,
+        reinterpret_cast<const char*>(data),
+        rowStride,
+        layerStride,
+        srcLayout.rowSize,
+        srcLayout.numRows,
+        srcLayout.numLayers
+    );
+}
+
+void NullTexture::Read(const TextureRegion& region, void* data, std::size_t rowStride, std::size_t layerStride) const
+{
+    Offset3D offset;
+    Extent3D extent;
+    GetTexelRegion(region, offset, extent);
+
+    const auto mipLevel = region.subresource.baseMipLevel;
+    AssertTexelRegion(mipLevel, offset, extent);
+
+    /* Determine strides of destination image and source MIP-map */
+    const auto dstLayout = GetRegionLayout(extent);
+    const auto srcLayout = GetRegionLayout(GetMipExtent(mipLevel));
+
+    if (rowStride == 0)
+        rowStride = dstLayout.rowSize;
+    if (layerStride == 0)
+        layerStride = rowStride * dstLayout.numRows;
+
+    CopyImageRows(
+        reinterpret_cast<char*>(data),
+        rowStride,
+        layerStride,
+        mips_[mipLevel].data() + GetTexelDataOffset(offset, GetMipExtent(mipLevel)),
+        srcLayout.rowSize,
+        srcLayout.rowSize * srcLayout.numRows,
+        dstLayout.rowSize,
+        dstLayout.numRows,
+        dstLayout.numLayers
+    );
+}
+
+void NullTexture::CopyFromTexture(const TextureLocation& dstLocation, const NullTexture& srcTexture, const TextureLocation& srcLocation, const Extent3D& extent)
+{
+    const auto dstOffset = CalcTextureOffset(GetType(), dstLocation.offset, dstLocation.arrayLayer);
+    const auto srcOffset = CalcTextureOffset(srcTexture.GetType(), srcLocation.offset, srcLocation.arrayLayer);
+
+    AssertTexelRegion(dstLocation.mipLevel, dstOffset, extent);
+    srcTexture.AssertTexelRegion(srcLocation.mipLevel, srcOffset, extent);
+
+    /* Copy through intermediate buffer, since source and destination might refer to the same MIP-map level */
+    const auto layout = srcTexture.GetRegionLayout(extent);
+    std::vector<char> intermediateData(layout.rowSize * layout.numRows * layout.numLayers);
+
+    const auto srcMipLayout = srcTexture.GetRegionLayout(srcTexture.GetMipExtent(srcLocation.mipLevel));
+    CopyImageRows(
+        intermediateData.data(),
+        layout.rowSize,
+        layout.rowSize * layout.numRows,
+        srcTexture.mips_[srcLocation.mipLevel].data() + srcTexture.GetTexelDataOffset(srcOffset, srcTexture.GetMipExtent(srcLocation.mipLevel)),
+        srcMipLayout.rowSize,
+        srcMipLayout.rowSize * srcMipLayout.numRows,
+        layout.rowSize,
+        layout.numRows,
+        layout.numLayers
+    );
+
+    /* Don't exceed the destination region if the texture formats have different sizes */
+    const auto dstMipLayout = GetRegionLayout(GetMipExtent(dstLocation.mipLevel));
+    const auto dstRowSize   = std::min(layout.rowSize, GetRegionLayout(extent).rowSize);
+
+    CopyImageRows(
+        mips_[dstLocation.mipLevel].data() + GetTexelDataOffset(dstOffset, GetMipExtent(dstLocation.mipLevel)),
+        dstMipLayout.rowSize,
+        dstMipLayout.rowSize * dstMipLayout.numRows,
+        intermediateData.data(),
+        layout.rowSize,
+        layout.rowSize * layout.numRows,
+        dstRowSize,
+        layout.numRows,
+        layout.numLayers
+    );
+}
+
+std::size_t NullTexture::GetRegionDataSize(const TextureRegion& region, std::size_t rowStride, std::size_t layerStride) const
+{
+    Offset3D offset;
+    Extent3D extent;
+    GetTexelRegion(region, offset, extent);
+    const auto layout = GetRegionLayout(extent);
+
+    if (layout.numRows == 0 || layout.numLayers == 0)
+        return 0;
+
+    if (rowStride == 0)
+        rowStride = layout.rowSize;
+    if (layerStride == 0)
+        layerStride = rowStride * layout.numRows;
+
+    /* Last row of the last layer does not need to be padded */
+    return ((layout.numLayers - 1) * layerStride + (layout.numRows - 1) * rowStride + layout.rowSize);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+NullTexture::RegionLayout NullTexture::GetRegionLayout(const Extent3D& extent) const
+{
+    const auto& formatAttribs = GetFormatAttribs(desc_.format);
+    RegionLayout layout;
+    {
+        layout.rowSize      = NumBlocks(extent.width, formatAttribs.blockWidth) * formatAttribs.bitSize / 8;
+        layout.numRows      = NumBlocks(extent.height, formatAttribs.blockHeight);
+        layout.numLayers    = static_cast<std::size_t>(extent.depth);
+    }
+    return layout;
+}
+
+std::size_t NullTexture::GetTexelDataOffset(const Offset3D& offset, const Extent3D& mipExtent) const
+{
+    const auto& formatAttribs   = GetFormatAttribs(desc_.format);
+    const auto  layout          = GetRegionLayout(mipExtent);
+    return
+    (
+        static_cast<std::size_t>(offset.z) * layout.rowSize * layout.numRows +
+        static_cast<std::size_t>(offset.y / formatAttribs.blockHeight) * layout.rowSize +
+        static_cast<std::size_t>(offset.x / formatAttribs.blockWidth) * formatAttribs.bitSize / 8
+    );
+}
+
+void NullTexture::GetTexelRegion(const TextureRegion& region, Offset3D& offset, Extent3D& extent) const
+{
+    offset = CalcTextureOffset(GetType(), region.offset, region.subresource.baseArrayLayer);
+    extent = CalcTextureExtent(GetType(), region.extent, region.subresource.numArrayLayers);
+}
+
+void NullTexture::AssertTexelRegion(std::uint32_t mipLevel, const Offset3D& offset, const Extent3D& extent) const
+{
+    if (mipLevel >= desc_.mipLevels)
+        throw std::out_of_range("MIP-map level exceeds number of MIP-map levels in Null texture");
+
+    const auto mipExtent = GetMipExtent(mipLevel);
+
+    if (offset.x < 0 || offset.y < 0 || offset.z < 0 ||
+        static_cast<std::uint32_t>(offset.x) + extent.width  > mipExtent.width  ||
+        static_cast<std::uint32_t>(offset.y) + extent.height > mipExtent.height ||
+        static_cast<std::uint32_t>(offset.z) + extent.depth  > mipExtent.depth)
+    {
+        throw std::out_of_range("texture region exceeds extent of MIP-map level in Null texture");
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,93 @@
+/*
+ * NullTexture.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_NULL_TEXTURE_H
+#define LLGL_NULL_TEXTURE_H
+
+
+#include <LLGL/Texture.h>
+#include <LLGL/TextureFlags.h>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Texture with CPU-side storage only. Each MIP-map level is stored as one tightly packed image in the texture's native format,
+where the array layers are stored like the slices of a 3D texture.
+*/
+class NullTexture final : public Texture
+{
+
+    public:
+
+        Extent3D GetMipExtent(std::uint32_t mipLevel) const override;
+        TextureDescriptor GetDesc() const override;
+        Format GetFormat() const override;
+
+    public:
+
+        NullTexture(const TextureDescriptor& desc);
+
+        /*
+        Writes the specified image data into the texture region. The image data must be in the texture's native format.
+        If 'rowStride' or 'layerStride' is zero, the image data is considered to be tightly packed.
+        */
+        void Write(const TextureRegion& region, const void* data, std::size_t rowStride = 0, std::size_t layerStride = 0);
+
+        // Reads the texture region into the specified image data in the texture's native format (see Write).
+        void Read(const TextureRegion& region, void* data, std::size_t rowStride = 0, std::size_t layerStride = 0) const;
+
+        // Copies the specified region from the source texture, where 'extent' includes the array layers.
+        void CopyFromTexture(const TextureLocation& dstLocation, const NullTexture& srcTexture, const TextureLocation& srcLocation, const Extent3D& extent);
+
+        // Returns the size (in bytes) of the specified texture region with the specified strides (see Write).
+        std::size_t GetRegionDataSize(const TextureRegion& region, std::size_t rowStride = 0, std::size_t layerStride = 0) const;
+
+    private:
+
+        // Data layout of a texture region in the texture's native format.
+        struct RegionLayout
+        {
+            std::size_t rowSize;        // Size (in bytes) of each row of texels (or row of blocks for compressed formats).
+            std::size_t numRows;        // Number of rows per layer.
+            std::size_t numLayers;      // Number of layers, i.e. depth of 3D textures or number of array layers.
+        };
+
+    private:
+
+        // Returns the data layout of the specified extent.
+        RegionLayout GetRegionLayout(const Extent3D& extent) const;
+
+        // Returns the offset (in bytes) of the specified texel offset within a MIP-map level of the specified extent.
+        std::size_t GetTexelDataOffset(const Offset3D& offset, const Extent3D& mipExtent) const;
+
+        // Converts the specified texture region into a texel offset and extent that include the array layers.
+        void GetTexelRegion(const TextureRegion& region, Offset3D& offset, Extent3D& extent) const;
+
+        // Throws std::out_of_range if the specified texel region exceeds the extent of the MIP-map level.
+        void AssertTexelRegion(std::uint32_t mipLevel, const Offset3D& offset, const Extent3D& extent) const;
+
+    private:
+
+        TextureDescriptor               desc_;
+        std::vector<std::vector<char>>  mips_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
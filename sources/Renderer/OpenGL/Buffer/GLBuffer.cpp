@@ -6,6 +6,7 @@
  */
 
 #include "GLBuffer.h"
+#include "GLStagingRingBuffer.h"
 #include "../GLProfile.h"
 #include "../GLObjectUtils.h"
 #include "../Ext/GLExtensions.h"
@@ -127,6 +128,10 @@ void GLBuffer::BufferStorage(GLsizeiptr size, const void* data, GLbitfield flags
 
 void GLBuffer::BufferSubData(GLintptr offset, GLsizeiptr size, const void* data)
 {
+    /* Stream data through the persistent mapped staging ring to avoid implicit driver copies and synchronization */
+    if (GLStagingRingBuffer::Get().WriteBuffer(*this, offset, size, data))
+        return;
+
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
     if (HasExtension(GLExt::ARB_direct_state_access))
     {
@@ -255,6 +260,28 @@ void* GLBuffer::MapBuffer(GLenum access)
     }
 }
 
+void* GLBuffer::MapBufferRange(GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
+    if (HasExtension(GLExt::ARB_direct_state_access))
+    {
+        return glMapNamedBufferRange(GetID(), offset, length, access);
+    }
+    else
+    #endif // /GL_ARB_direct_state_access
+    #ifdef GL_ARB_map_buffer_range
+    if (HasExtension(GLExt::ARB_map_buffer_range))
+    {
+        GLStateManager::Get().BindGLBuffer(*this);
+        return glMapBufferRange(GetGLTarget(), offset, length, access);
+    }
+    else
+    #endif // /GL_ARB_map_buffer_range
+    {
+        return nullptr;
+    }
+}
+
 void GLBuffer::UnmapBuffer()
 {
     #if defined GL_ARB_direct_state_access && defined LLGL_GL_ENABLE_DSA_EXT
@@ -0,0 +1,242 @@
+/*
+ * GLStagingRingBuffer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLStagingRingBuffer.h"
+#include "GLBuffer.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/ResourceFlags.h>
+#include <algorithm>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+// Size (in bytes) of each ring segment; larger updates are not streamed through the ring.
+static const GLsizeiptr g_ringSegmentSize = (1 << 20);
+
+// Alignment (in bytes) of each write into the ring.
+static const GLsizeiptr g_ringWriteAlignment = 16;
+
+GLStagingRingBuffer& GLStagingRingBuffer::Get()
+{
+    static GLStagingRingBuffer instance;
+    return instance;
+}
+
+GLStagingRingBuffer::~GLStagingRingBuffer()
+{
+    Clear();
+}
+
+void GLStagingRingBuffer::Clear()
+{
+    #if defined GL_ARB_buffer_storage && defined GL_ARB_sync
+
+    /* Delete all pending fences; a <sync> value of zero is silently ignored */
+    for (auto& fence : fences_)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+            fence = 0;
+        }
+    }
+
+    /* Release persistent mapping and ring buffer */
+    if (ringBuffer_)
+    {
+        if (mappedData_)
+            ringBuffer_->UnmapBuffer();
+        ringBuffer_.reset();
+    }
+
+    #endif // /GL_ARB_buffer_storage && GL_ARB_sync
+
+    initialized_    = false;
+    mappedData_     = nullptr;
+    segmentSize_    = 0;
+    segment_        = 0;
+    segmentOffset_  = 0;
+
+    for (auto& numWrites : pendingWrites_)
+        numWrites = 0;
+}
+
+bool GLStagingRingBuffer::WriteBuffer(GLBuffer& dstBuffer, GLintptr dstOffset, GLsizeiptr size, const void* data)
+{
+    /* Write data into coherent mapped ring, then copy it into the destination buffer on the GPU timeline */
+    const GLintptr readOffset = Reserve(size);
+    if (readOffset < 0)
+        return false;
+
+    ::memcpy(mappedData_ + readOffset, data, static_cast<std::size_t>(size));
+    dstBuffer.CopyBufferSubData(*ringBuffer_, readOffset, dstOffset, size);
+
+    return true;
+}
+
+GLBuffer* GLStagingRingBuffer::StageData(GLsizeiptr size, const void* data, GLintptr& outReadOffset, GLStagingRingReservation& reservation)
+{
+    /* Write data into coherent mapped ring now; the copy into the destination buffer is recorded by the caller */
+    const GLintptr readOffset = Reserve(size);
+    if (readOffset < 0)
+        return nullptr;
+
+    ::memcpy(mappedData_ + readOffset, data, static_cast<std::size_t>(size));
+
+    /* Hold current segment until the command buffer has been submitted */
+    ++pendingWrites_[segment_];
+    ++reservation.numWrites[segment_];
+
+    outReadOffset = readOffset;
+    return ringBuffer_.get();
+}
+
+void GLStagingRingBuffer::ReleaseReservation(GLStagingRingReservation& reservation)
+{
+    #if defined GL_ARB_buffer_storage && defined GL_ARB_sync
+
+    for (std::uint32_t i = 0; i < g_numStagingRingSegments; ++i)
+    {
+        if (auto numWrites = reservation.numWrites[i])
+        {
+            pendingWrites_[i] -= std::min(numWrites, pendingWrites_[i]);
+            reservation.numWrites[i] = 0;
+
+            /*
+            Guard segment that has been left while it was held, now that all copy commands that read from it have been submitted.
+            The current segment is guarded when the ring advances.
+            */
+            if (pendingWrites_[i] == 0 && i != segment_ && mappedData_ != nullptr && !fences_[i])
+                fences_[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        }
+    }
+
+    #endif // /GL_ARB_buffer_storage && GL_ARB_sync
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+bool GLStagingRingBuffer::CreateRingBuffer()
+{
+    #if defined GL_ARB_buffer_storage && defined GL_ARB_sync
+
+    /* Persistent mapping requires immutable buffer storage, fences to guard the segments, and a GPU side buffer copy */
+    if (!HasExtension(GLExt::ARB_buffer_storage) || !HasExtension(GLExt::ARB_sync) || !HasExtension(GLExt::ARB_copy_buffer))
+        return false;
+
+    const GLsizeiptr    ringSize    = g_ringSegmentSize * g_numStagingRingSegments;
+    const GLbitfield    accessFlags = (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT);
+
+    ringBuffer_ = MakeUnique<GLBuffer>(BindFlags::CopySrc);
+    ringBuffer_->BufferStorage(ringSize, nullptr, accessFlags, GL_STREAM_DRAW);
+
+    mappedData_ = static_cast<char*>(ringBuffer_->MapBufferRange(0, ringSize, accessFlags));
+    if (mappedData_ == nullptr)
+    {
+        ringBuffer_.reset();
+        return false;
+    }
+
+    segmentSize_ = g_ringSegmentSize;
+
+    return true;
+
+    #else
+
+    return false;
+
+    #endif // /GL_ARB_buffer_storage && GL_ARB_sync
+}
+
+GLintptr GLStagingRingBuffer::Reserve(GLsizeiptr size)
+{
+    #if defined GL_ARB_buffer_storage && defined GL_ARB_sync
+
+    /* Create ring buffer on first use */
+    if (!initialized_)
+    {
+        initialized_ = true;
+        CreateRingBuffer();
+    }
+
+    if (mappedData_ == nullptr || size <= 0 || size > segmentSize_)
+        return -1;
+
+    /* Move on to the next segment if the data does not fit into the remainder of the current one */
+    if (segmentOffset_ + size > segmentSize_)
+    {
+        if (!AdvanceSegment())
+            return -1;
+    }
+
+    const GLintptr offset = static_cast<GLintptr>(segment_) * segmentSize_ + segmentOffset_;
+    segmentOffset_ = GetAlignedSize(segmentOffset_ + size, g_ringWriteAlignment);
+
+    return offset;
+
+    #else
+
+    return -1;
+
+    #endif // /GL_ARB_buffer_storage && GL_ARB_sync
+}
+
+bool GLStagingRingBuffer::AdvanceSegment()
+{
+    #if defined GL_ARB_buffer_storage && defined GL_ARB_sync
+
+    const std::uint32_t nextSegment = (segment_ + 1) % g_numStagingRingSegments;
+
+    /* Next segment cannot be reused while a deferred command buffer still has to copy from it */
+    if (pendingWrites_[nextSegment] > 0)
+        return false;
+
+    /* Guard current segment until all copy commands that read from it have completed; held segments are guarded when they are released */
+    if (pendingWrites_[segment_] == 0)
+        fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    segment_        = nextSegment;
+    segmentOffset_  = 0;
+
+    /* Wait until the next segment has been consumed; this only blocks if the CPU is an entire ring ahead of the GPU */
+    if (auto fence = fences_[segment_])
+    {
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+        for (;;)
+        {
+            GLenum result = glClientWaitSync(fence, flags, 1000000);
+            if (result != GL_TIMEOUT_EXPIRED)
+                break;
+            flags = 0;
+        }
+        glDeleteSync(fence);
+        fences_[segment_] = 0;
+    }
+
+    return true;
+
+    #else
+
+    return false;
+
+    #endif // /GL_ARB_buffer_storage && GL_ARB_sync
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,118 @@
+/*
+ * GLStagingRingBuffer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_STAGING_RING_BUFFER_H
+#define LLGL_GL_STAGING_RING_BUFFER_H
+
+
+#include "../OpenGL.h"
+#include <memory>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class GLBuffer;
+
+// Number of segments the staging ring is divided into.
+static const std::uint32_t g_numStagingRingSegments = 4;
+
+// Number of staged writes per ring segment that are held by a deferred command buffer until it has been submitted.
+struct GLStagingRingReservation
+{
+    std::uint32_t numWrites[g_numStagingRingSegments] = {};
+};
+
+/*
+Streaming upload ring for buffer updates; used by <GLBuffer::BufferSubData> and <GLDeferredCommandBuffer::UpdateBuffer>.
+The ring is a persistent and coherent mapped buffer that is divided into segments. Each segment is guarded by a fence
+that is inserted when the ring advances to the next segment, and that is waited on before the segment is written again.
+The data is copied from the ring into the destination buffer with glCopyNamedBufferSubData or glCopyBufferSubData.
+Segments with staged writes of deferred command buffers are not reused, and their fence is not inserted, until the reservation has been released.
+*/
+class GLStagingRingBuffer
+{
+
+    public:
+
+        // Returns the instance of this singleton.
+        static GLStagingRingBuffer& Get();
+
+    public:
+
+        GLStagingRingBuffer(const GLStagingRingBuffer&) = delete;
+        GLStagingRingBuffer& operator = (const GLStagingRingBuffer&) = delete;
+
+        GLStagingRingBuffer(GLStagingRingBuffer&&) = delete;
+        GLStagingRingBuffer& operator = (GLStagingRingBuffer&&) = delete;
+
+        ~GLStagingRingBuffer();
+
+        // Releases all resources for this singleton class.
+        void Clear();
+
+        /*
+        Writes the specified data into the destination buffer via the staging ring.
+        Returns false if the data does not fit into a single segment or the required extensions are not supported,
+        in which case the caller must fall back to glBufferSubData.
+        */
+        bool WriteBuffer(GLBuffer& dstBuffer, GLintptr dstOffset, GLsizeiptr size, const void* data);
+
+        /*
+        Writes the specified data into the staging ring and returns the ring buffer and the offset to copy it from when a deferred command buffer is submitted.
+        The written segment is held by the specified reservation until it is released with <ReleaseReservation>.
+        Returns null if the data cannot be staged, in which case the caller must store the data itself.
+        */
+        GLBuffer* StageData(GLsizeiptr size, const void* data, GLintptr& outReadOffset, GLStagingRingReservation& reservation);
+
+        /*
+        Releases all segments that are held by the specified reservation and resets it.
+        This must be called after the copy commands that read the staged data have been submitted, or when they are discarded.
+        */
+        void ReleaseReservation(GLStagingRingReservation& reservation);
+
+    private:
+
+        GLStagingRingBuffer() = default;
+
+        // Creates and maps the ring buffer on first use. Returns false if it is not supported.
+        bool CreateRingBuffer();
+
+        // Reserves the specified number of bytes in the current segment and returns the ring offset, or -1 if the ring cannot be used.
+        GLintptr Reserve(GLsizeiptr size);
+
+        /*
+        Inserts a fence for the current segment and waits until the next segment is no longer in use by the GPU.
+        Returns false if the next segment is still held by a deferred command buffer.
+        */
+        bool AdvanceSegment();
+
+    private:
+
+        bool                        initialized_                                = false;
+        std::unique_ptr<GLBuffer>   ringBuffer_;
+        char*                       mappedData_                                 = nullptr;
+
+        GLsizeiptr                  segmentSize_                                = 0;
+        std::uint32_t               segment_                                    = 0;
+        GLsizeiptr                  segmentOffset_                              = 0;
+        GLsync                      fences_[g_numStagingRingSegments]           = {};
+        std::uint32_t               pendingWrites_[g_numStagingRingSegments]    = {}; // Staged writes of all deferred command buffers per segment
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
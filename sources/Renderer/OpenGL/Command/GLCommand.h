@@ -377,6 +377,16 @@ struct GLCmdMultiDrawElementsIndirect
     GLsizei         stride;
 };
 
+struct GLCmdMultiDrawElementsBaseVertex
+{
+    GLenum          mode;
+    GLenum          type;
+    GLsizei         drawcount;
+//  GLsizei         counts[drawcount];
+//  const GLvoid*   indices[drawcount];
+//  GLint           basevertices[drawcount];
+};
+
 struct GLCmdDispatchCompute
 {
     GLuint numgroups[3];
@@ -394,6 +404,14 @@ struct GLCmdBindTexture
     GLTexture*  texture;
 };
 
+struct GLCmdBindTextures
+{
+    GLuint              first;
+    GLsizei             count;
+//  GLuint              textures[count];
+//  GLTextureTarget     targets[count];
+};
+
 struct GLCmdBindImageTexture
 {
     GLuint  unit;
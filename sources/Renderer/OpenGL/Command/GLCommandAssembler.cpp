@@ -32,23 +32,32 @@
 #include "../Buffer/GLBufferArrayWithVAO.h"
 
 #include "../RenderState/GLStateManager.h"
-#include "../RenderState/GLGraphicsPSO.h"
+#include "../RenderState/GLPipelineState.h"
 #include "../RenderState/GLResourceHeap.h"
 #include "../RenderState/GLRenderPass.h"
 #include "../RenderState/GLQueryHeap.h"
 
 #include <LLGL/StaticLimits.h>
 #include <algorithm>
+#include <stdexcept>
+#include <string>
 
 
 namespace LLGL
 {
 
 
+// Binds the pipeline state; 'GLPipelineState::Bind' is virtual, so it cannot be called as raw member function pointer.
+static void GLBindPipelineState(GLPipelineState* pipelineState, GLStateManager* stateMngr)
+{
+    pipelineState->Bind(*stateMngr);
+}
+
 static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITCompiler& compiler)
 {
-    /* Declare index of variadic argument of entry point */
+    /* Declare index of variadic argument of entry point, and its address to let the callee switch the state manager */
     static const JITVarArg g_stateMngrArg{ 0 };
+    static const JITVarArgPtr g_stateMngrArgPtr{ 0 };
 
     /* Generate native CPU opcodes for emulated GLOpcode */
     switch (opcode)
@@ -176,14 +185,15 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeClearAttachmentsWithRenderPass:
         {
             auto cmd = reinterpret_cast<const GLCmdClearAttachmentsWithRenderPass*>(pc);
-            compiler.CallMember(&GLStateManager::ClearAttachmentsWithRenderPass, g_stateMngrArg, cmd->renderPass, cmd->numClearValues, (cmd + 1));
+            if (cmd->renderPass != nullptr)
+                compiler.CallMember(&GLStateManager::ClearAttachmentsWithRenderPass, g_stateMngrArg, cmd->renderPass, cmd->numClearValues, (cmd + 1));
             return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
         }
         case GLOpcodeClearBuffers:
         {
             auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
             compiler.CallMember(&GLStateManager::ClearBuffers, g_stateMngrArg, cmd->numAttachments, (cmd + 1));
-            return sizeof(*cmd);
+            return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
         }
         case GLOpcodeBindVertexArray:
         {
@@ -221,26 +231,26 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.Call(glBeginTransformFeedback, cmd->primitiveMove);
             return sizeof(*cmd);
         }
-        #ifdef GL_NV_transform_feedback
         case GLOpcodeBeginTransformFeedbackNV:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginTransformFeedbackNV*>(pc);
+            #ifdef GL_NV_transform_feedback
             compiler.Call(glBeginTransformFeedbackNV, cmd->primitiveMove);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_NV_transform_feedback
         case GLOpcodeEndTransformFeedback:
         {
             compiler.Call(glEndTransformFeedback);
             return 0;
         }
-        #ifdef GL_NV_transform_feedback
         case GLOpcodeEndTransformFeedbackNV:
         {
+            #ifdef GL_NV_transform_feedback
             compiler.Call(glEndTransformFeedbackNV);
+            #endif
             return 0;
         }
-        #endif // /GL_NV_transform_feedback
         case GLOpcodeBindResourceHeap:
         {
             auto cmd = reinterpret_cast<const GLCmdBindResourceHeap*>(pc);
@@ -249,18 +259,15 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         }
         case GLOpcodeBindRenderTarget:
         {
-            //TODO: update reference to GLStateManager
+            /* Pass address of state manager argument, so all subsequent commands use the state manager of the bound render target */
             auto cmd = reinterpret_cast<const GLCmdBindRenderTarget*>(pc);
-            compiler.CallMember(&GLStateManager::BindRenderTarget, g_stateMngrArg, cmd->renderTarget);
+            compiler.CallMember(&GLStateManager::BindRenderTarget, g_stateMngrArg, cmd->renderTarget, g_stateMngrArgPtr);
             return sizeof(*cmd);
         }
         case GLOpcodeBindPipelineState:
         {
             auto cmd = reinterpret_cast<const GLCmdBindPipelineState*>(pc);
-            if (cmd->pipelineState->IsGraphicsPSO())
-                compiler.CallMember(&GLGraphicsPSO::Bind, cmd->pipelineState, g_stateMngrArg);
-            else
-                compiler.CallMember(&GLPipelineState::Bind, cmd->pipelineState, g_stateMngrArg);
+            compiler.Call(GLBindPipelineState, cmd->pipelineState, g_stateMngrArg);
             return sizeof(*cmd);
         }
         case GLOpcodeSetBlendColor:
@@ -296,12 +303,16 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeBeginConditionalRender:
         {
             auto cmd = reinterpret_cast<const GLCmdBeginConditionalRender*>(pc);
+            #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
             compiler.Call(glBeginConditionalRender, cmd->id, cmd->mode);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeEndConditionalRender:
         {
+            #ifdef LLGL_GLEXT_CONDITIONAL_RENDER
             compiler.Call(glEndConditionalRender);
+            #endif
             return 0;
         }
         case GLOpcodeDrawArrays:
@@ -316,18 +327,19 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.Call(glDrawArraysInstanced, cmd->mode, cmd->first, cmd->count, cmd->instancecount);
             return sizeof(*cmd);
         }
-        #ifdef GL_ARB_base_instance
         case GLOpcodeDrawArraysInstancedBaseInstance:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawArraysInstancedBaseInstance*>(pc);
+            #ifdef LLGL_GLEXT_BASE_INSTANCE
             compiler.Call(glDrawArraysInstancedBaseInstance, cmd->mode, cmd->first, cmd->count, cmd->instancecount, cmd->baseinstance);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_base_instance
         case GLOpcodeDrawArraysIndirect:
         {
-            //TODO: generate loop in ASM
             auto cmd = reinterpret_cast<const GLCmdDrawArraysIndirect*>(pc);
+            #ifdef LLGL_GLEXT_DRAW_INDIRECT
+            //TODO: generate loop in ASM
             compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             GLintptr offset = cmd->indirect;
             for (std::uint32_t i = 0; i < cmd->numCommands; ++i)
@@ -335,6 +347,7 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
                 compiler.Call(glDrawArraysIndirect, cmd->mode, reinterpret_cast<const GLvoid*>(offset));
                 offset += cmd->stride;
             }
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElements:
@@ -346,7 +359,9 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeDrawElementsBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(pc);
+            #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
             compiler.Call(glDrawElementsBaseVertex, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->basevertex);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeDrawElementsInstanced:
@@ -358,20 +373,23 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
         case GLOpcodeDrawElementsInstancedBaseVertex:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(pc);
+            #ifdef LLGL_GLEXT_DRAW_ELEMENTS_BASE_VERTEX
             compiler.Call(glDrawElementsInstancedBaseVertex, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex);
+            #endif
             return sizeof(*cmd);
         }
-        #ifdef GL_ARB_base_instance
         case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(pc);
+            #ifdef LLGL_GLEXT_BASE_INSTANCE
             compiler.Call(glDrawElementsInstancedBaseVertexBaseInstance, cmd->mode, cmd->count, cmd->type, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_base_instance
         case GLOpcodeDrawElementsIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDrawElementsIndirect*>(pc);
+            #ifdef LLGL_GLEXT_DRAW_INDIRECT
             {
                 //TODO: generate loop in ASM
                 compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
@@ -382,39 +400,55 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
                     offset += cmd->stride;
                 }
             }
+            #endif
             return sizeof(*cmd);
         }
-        #ifdef GL_ARB_multi_draw_indirect
         case GLOpcodeMultiDrawArraysIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawArraysIndirect*>(pc);
+            #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
             compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             compiler.Call(glMultiDrawArraysIndirect, cmd->mode, cmd->indirect, cmd->drawcount, cmd->stride);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeMultiDrawElementsIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsIndirect*>(pc);
+            #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
             compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DRAW_INDIRECT_BUFFER, cmd->id);
             compiler.Call(glMultiDrawElementsIndirect, cmd->mode, cmd->type, cmd->indirect, cmd->drawcount, cmd->stride);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_multi_draw_indirect
-        #ifdef GL_ARB_compute_shader
+        case GLOpcodeMultiDrawElementsBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsBaseVertex*>(pc);
+            #ifdef GL_ARB_draw_elements_base_vertex
+            auto counts         = reinterpret_cast<const GLsizei*>(cmd + 1);
+            auto indices        = reinterpret_cast<const GLvoid* const*>(counts + cmd->drawcount);
+            auto basevertices   = reinterpret_cast<const GLint*>(indices + cmd->drawcount);
+            compiler.Call(glMultiDrawElementsBaseVertex, cmd->mode, counts, cmd->type, indices, cmd->drawcount, basevertices);
+            #endif
+            return (sizeof(*cmd) + (sizeof(GLsizei) + sizeof(const GLvoid*) + sizeof(GLint))*cmd->drawcount);
+        }
         case GLOpcodeDispatchCompute:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
+            #ifdef LLGL_GLEXT_COMPUTE_SHADER
             compiler.Call(glDispatchCompute, cmd->numgroups[0], cmd->numgroups[1], cmd->numgroups[2]);
+            #endif
             return sizeof(*cmd);
         }
         case GLOpcodeDispatchComputeIndirect:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchComputeIndirect*>(pc);
+            #ifdef LLGL_GLEXT_COMPUTE_SHADER
             compiler.CallMember(&GLStateManager::BindBuffer, g_stateMngrArg, GLBufferTarget::DISPATCH_INDIRECT_BUFFER, cmd->id);
             compiler.Call(glDispatchComputeIndirect, cmd->indirect);
+            #endif
             return sizeof(*cmd);
         }
-        #endif // /GL_ARB_compute_shader
         case GLOpcodeBindTexture:
         {
             auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
@@ -422,6 +456,14 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
             compiler.CallMember(&GLStateManager::BindGLTexture, g_stateMngrArg, cmd->texture);
             return sizeof(*cmd);
         }
+        case GLOpcodeBindTextures:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindTextures*>(pc);
+            auto textures = reinterpret_cast<const GLuint*>(cmd + 1);
+            auto targets = reinterpret_cast<const GLTextureTarget*>(textures + cmd->count);
+            compiler.CallMember(&GLStateManager::BindTextures, g_stateMngrArg, cmd->first, cmd->count, targets, textures);
+            return (sizeof(*cmd) + (sizeof(GLuint) + sizeof(GLTextureTarget))*cmd->count);
+        }
         case GLOpcodeBindImageTexture:
         {
             auto cmd = reinterpret_cast<const GLCmdBindImageTexture*>(pc);
@@ -457,21 +499,23 @@ static std::size_t AssembleGLCommand(const GLOpcode opcode, const void* pc, JITC
                 compiler.CallMember(&GLStateManager::UnbindSamplers, g_stateMngrArg, cmd->first, cmd->count);
             return sizeof(*cmd);
         }
-        #ifdef GL_KHR_debug
         case GLOpcodePushDebugGroup:
         {
             auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
+            #ifdef LLGL_GLEXT_DEBUG
             compiler.Call(glPushDebugGroup, cmd->source, cmd->id, cmd->length, reinterpret_cast<const GLchar*>(cmd + 1));
+            #endif
             return (sizeof(*cmd) + cmd->length + 1);
         }
         case GLOpcodePopDebugGroup:
         {
+            #ifdef LLGL_GLEXT_DEBUG
             compiler.Call(glPopDebugGroup);
+            #endif
             return 0;
         }
-        #endif // /GL_KHR_debug
         default:
-            return 0;
+            throw std::runtime_error("cannot assemble GL command with unknown opcode: " + std::to_string(static_cast<int>(opcode)));
     }
 }
 
@@ -487,7 +531,7 @@ static std::size_t RequiredLocalStackSize(const GLDeferredCommandBuffer& cmdBuff
     return maxSize;
 }
 
-std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer)
+static std::unique_ptr<JITProgram> AssembleGLVirtualCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer)
 {
     /* Try to create a JIT-compiler for the active architecture (if supported) */
     if (auto compiler = JITCompiler::Create())
@@ -530,6 +574,19 @@ std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredComm
     return nullptr;
 }
 
+std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdBuffer)
+{
+    try
+    {
+        return AssembleGLVirtualCommandBuffer(cmdBuffer);
+    }
+    catch (const std::exception&)
+    {
+        /* Return null so the command buffer falls back to the emulated execution of GL commands */
+        return nullptr;
+    }
+}
+
 
 } // /namespace LLGL
 
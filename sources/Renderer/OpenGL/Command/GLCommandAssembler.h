@@ -21,6 +21,10 @@ namespace LLGL
 class JITProgram;
 class GLDeferredCommandBuffer;
 
+/*
+Assembles the GL commands of the specified deferred command buffer into a native JIT program,
+or returns null if the architecture is not supported or the assembly failed.
+*/
 std::unique_ptr<JITProgram> AssembleGLDeferredCommandBuffer(const GLDeferredCommandBuffer& cmdbuffer);
 
 
@@ -407,6 +407,17 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             #endif
             return sizeof(*cmd);
         }
+        case GLOpcodeMultiDrawElementsBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsBaseVertex*>(pc);
+            #ifdef GL_ARB_draw_elements_base_vertex
+            auto counts         = reinterpret_cast<const GLsizei*>(cmd + 1);
+            auto indices        = reinterpret_cast<const GLvoid* const*>(counts + cmd->drawcount);
+            auto basevertices   = reinterpret_cast<const GLint*>(indices + cmd->drawcount);
+            glMultiDrawElementsBaseVertex(cmd->mode, counts, cmd->type, indices, cmd->drawcount, basevertices);
+            #endif
+            return (sizeof(*cmd) + (sizeof(GLsizei) + sizeof(const GLvoid*) + sizeof(GLint))*cmd->drawcount);
+        }
         case GLOpcodeDispatchCompute:
         {
             auto cmd = reinterpret_cast<const GLCmdDispatchCompute*>(pc);
@@ -431,6 +442,14 @@ static std::size_t ExecuteGLCommand(const GLOpcode opcode, const void* pc, GLSta
             stateMngr->BindGLTexture(*(cmd->texture));
             return sizeof(*cmd);
         }
+        case GLOpcodeBindTextures:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindTextures*>(pc);
+            auto textures = reinterpret_cast<const GLuint*>(cmd + 1);
+            auto targets = reinterpret_cast<const GLTextureTarget*>(textures + cmd->count);
+            stateMngr->BindTextures(cmd->first, cmd->count, targets, textures);
+            return (sizeof(*cmd) + (sizeof(GLuint) + sizeof(GLTextureTarget))*cmd->count);
+        }
         case GLOpcodeBindImageTexture:
         {
             auto cmd = reinterpret_cast<const GLCmdBindImageTexture*>(pc);
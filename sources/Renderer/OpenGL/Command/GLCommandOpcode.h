@@ -69,9 +69,11 @@ enum GLOpcode : std::uint8_t
     GLOpcodeDrawElementsIndirect,
     GLOpcodeMultiDrawArraysIndirect,
     GLOpcodeMultiDrawElementsIndirect,
+    GLOpcodeMultiDrawElementsBaseVertex,
     GLOpcodeDispatchCompute,
     GLOpcodeDispatchComputeIndirect,
     GLOpcodeBindTexture,
+    GLOpcodeBindTextures,
     GLOpcodeBindImageTexture,
     GLOpcodeBindSampler,
     GLOpcodeBindGL2XSampler,
@@ -0,0 +1,1183 @@
+/*
+ * GLCommandOptimizer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLCommandOptimizer.h"
+#include "GLCommand.h"
+#include "../RenderState/GLStateManager.h"
+#include "../RenderState/GLContextState.h"
+#include "../Texture/GLTexture.h"
+#include "../Buffer/GLBuffer.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/ResourceFlags.h>
+#include <LLGL/IndirectArguments.h>
+#include <vector>
+#include <algorithm>
+#include <string.h>
+
+
+namespace LLGL
+{
+
+
+/* ----- Command parsing ----- */
+
+// Parsed GL command with a reference into the input command buffer.
+struct GLCommandRecord
+{
+    GLOpcode        opcode;
+    const char*     cmd;
+    std::size_t     size;
+    bool            keep;
+};
+
+// Returns the size (in bytes) of the specified GL command excluding its opcode. This must match the size that is returned by ExecuteGLCommand.
+static std::size_t GetGLCommandSize(const GLOpcode opcode, const void* pc)
+{
+    switch (opcode)
+    {
+        case GLOpcodeBufferSubData:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBufferSubData*>(pc);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case GLOpcodeCopyBufferSubData:
+            return sizeof(GLCmdCopyBufferSubData);
+        case GLOpcodeClearBufferData:
+            return sizeof(GLCmdClearBufferData);
+        case GLOpcodeClearBufferSubData:
+            return sizeof(GLCmdClearBufferSubData);
+        case GLOpcodeCopyImageSubData:
+            return sizeof(GLCmdCopyImageSubData);
+        case GLOpcodeCopyImageToBuffer:
+        case GLOpcodeCopyImageFromBuffer:
+            return sizeof(GLCmdCopyImageBuffer);
+        case GLOpcodeGenerateMipmap:
+            return sizeof(GLCmdGenerateMipmap);
+        case GLOpcodeGenerateMipmapSubresource:
+            return sizeof(GLCmdGenerateMipmapSubresource);
+        case GLOpcodeExecute:
+            return sizeof(GLCmdExecute);
+        case GLOpcodeViewport:
+            return sizeof(GLCmdViewport);
+        case GLOpcodeViewportArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdViewportArray*>(pc);
+            return (sizeof(*cmd) + sizeof(GLViewport)*cmd->count + sizeof(GLDepthRange)*cmd->count);
+        }
+        case GLOpcodeScissor:
+            return sizeof(GLCmdScissor);
+        case GLOpcodeScissorArray:
+        {
+            auto cmd = reinterpret_cast<const GLCmdScissorArray*>(pc);
+            return (sizeof(*cmd) + sizeof(GLScissor)*cmd->count);
+        }
+        case GLOpcodeClearColor:
+            return sizeof(GLCmdClearColor);
+        case GLOpcodeClearDepth:
+            return sizeof(GLCmdClearDepth);
+        case GLOpcodeClearStencil:
+            return sizeof(GLCmdClearStencil);
+        case GLOpcodeClear:
+            return sizeof(GLCmdClear);
+        case GLOpcodeClearAttachmentsWithRenderPass:
+        {
+            auto cmd = reinterpret_cast<const GLCmdClearAttachmentsWithRenderPass*>(pc);
+            return (sizeof(*cmd) + sizeof(ClearValue)*cmd->numClearValues);
+        }
+        case GLOpcodeClearBuffers:
+        {
+            auto cmd = reinterpret_cast<const GLCmdClearBuffers*>(pc);
+            return (sizeof(*cmd) + sizeof(AttachmentClear)*cmd->numAttachments);
+        }
+        case GLOpcodeBindVertexArray:
+            return sizeof(GLCmdBindVertexArray);
+        case GLOpcodeBindGL2XVertexArray:
+            return sizeof(GLCmdBindGL2XVertexArray);
+        case GLOpcodeBindElementArrayBufferToVAO:
+            return sizeof(GLCmdBindElementArrayBufferToVAO);
+        case GLOpcodeBindBufferBase:
+            return sizeof(GLCmdBindBufferBase);
+        case GLOpcodeBindBuffersBase:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
+            return (sizeof(*cmd) + sizeof(GLuint)*cmd->count);
+        }
+        case GLOpcodeBeginTransformFeedback:
+            return sizeof(GLCmdBeginTransformFeedback);
+        case GLOpcodeBeginTransformFeedbackNV:
+            return sizeof(GLCmdBeginTransformFeedbackNV);
+        case GLOpcodeEndTransformFeedback:
+        case GLOpcodeEndTransformFeedbackNV:
+            return 0;
+        case GLOpcodeBindResourceHeap:
+            return sizeof(GLCmdBindResourceHeap);
+        case GLOpcodeBindRenderTarget:
+            return sizeof(GLCmdBindRenderTarget);
+        case GLOpcodeBindPipelineState:
+            return sizeof(GLCmdBindPipelineState);
+        case GLOpcodeSetBlendColor:
+            return sizeof(GLCmdSetBlendColor);
+        case GLOpcodeSetStencilRef:
+            return sizeof(GLCmdSetStencilRef);
+        case GLOpcodeSetUniforms:
+        {
+            auto cmd = reinterpret_cast<const GLCmdSetUniforms*>(pc);
+            return (sizeof(*cmd) + cmd->size);
+        }
+        case GLOpcodeBeginQuery:
+            return sizeof(GLCmdBeginQuery);
+        case GLOpcodeEndQuery:
+            return sizeof(GLCmdEndQuery);
+        case GLOpcodeBeginConditionalRender:
+            return sizeof(GLCmdBeginConditionalRender);
+        case GLOpcodeEndConditionalRender:
+            return 0;
+        case GLOpcodeDrawArrays:
+            return sizeof(GLCmdDrawArrays);
+        case GLOpcodeDrawArraysInstanced:
+            return sizeof(GLCmdDrawArraysInstanced);
+        case GLOpcodeDrawArraysInstancedBaseInstance:
+            return sizeof(GLCmdDrawArraysInstancedBaseInstance);
+        case GLOpcodeDrawArraysIndirect:
+            return sizeof(GLCmdDrawArraysIndirect);
+        case GLOpcodeDrawElements:
+            return sizeof(GLCmdDrawElements);
+        case GLOpcodeDrawElementsBaseVertex:
+            return sizeof(GLCmdDrawElementsBaseVertex);
+        case GLOpcodeDrawElementsInstanced:
+            return sizeof(GLCmdDrawElementsInstanced);
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+            return sizeof(GLCmdDrawElementsInstancedBaseVertex);
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+            return sizeof(GLCmdDrawElementsInstancedBaseVertexBaseInstance);
+        case GLOpcodeDrawElementsIndirect:
+            return sizeof(GLCmdDrawElementsIndirect);
+        case GLOpcodeMultiDrawArraysIndirect:
+            return sizeof(GLCmdMultiDrawArraysIndirect);
+        case GLOpcodeMultiDrawElementsIndirect:
+            return sizeof(GLCmdMultiDrawElementsIndirect);
+        case GLOpcodeMultiDrawElementsBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdMultiDrawElementsBaseVertex*>(pc);
+            return (sizeof(*cmd) + (sizeof(GLsizei) + sizeof(const GLvoid*) + sizeof(GLint))*cmd->drawcount);
+        }
+        case GLOpcodeDispatchCompute:
+            return sizeof(GLCmdDispatchCompute);
+        case GLOpcodeDispatchComputeIndirect:
+            return sizeof(GLCmdDispatchComputeIndirect);
+        case GLOpcodeBindTexture:
+            return sizeof(GLCmdBindTexture);
+        case GLOpcodeBindTextures:
+        {
+            auto cmd = reinterpret_cast<const GLCmdBindTextures*>(pc);
+            return (sizeof(*cmd) + (sizeof(GLuint) + sizeof(GLTextureTarget))*cmd->count);
+        }
+        case GLOpcodeBindImageTexture:
+            return sizeof(GLCmdBindImageTexture);
+        case GLOpcodeBindSampler:
+            return sizeof(GLCmdBindSampler);
+        case GLOpcodeBindGL2XSampler:
+            return sizeof(GLCmdBindGL2XSampler);
+        case GLOpcodeUnbindResources:
+            return sizeof(GLCmdUnbindResources);
+        case GLOpcodePushDebugGroup:
+        {
+            auto cmd = reinterpret_cast<const GLCmdPushDebugGroup*>(pc);
+            return (sizeof(*cmd) + cmd->length + 1);
+        }
+        case GLOpcodePopDebugGroup:
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+static void ParseGLCommands(const GLVirtualCommandBuffer& input, std::vector<GLCommandRecord>& records)
+{
+    for (const auto& chunk : input)
+    {
+        auto pc     = chunk.data;
+        auto pcEnd  = chunk.data + chunk.size;
+
+        while (pc < pcEnd)
+        {
+            /* Read opcode */
+            const GLOpcode opcode = *reinterpret_cast<const GLOpcode*>(pc);
+            pc += sizeof(GLOpcode);
+
+            /* Store reference to command and move to next one */
+            const std::size_t size = GetGLCommandSize(opcode, pc);
+            records.push_back({ opcode, pc, size, true });
+            pc += size;
+        }
+    }
+}
+
+
+/* ----- Binding tracker ----- */
+
+// Categories of GL states that are tracked by the optimizer.
+enum GLTrackedState : int
+{
+    GLTrackedStateBuffers       = (1 << 0), // Indexed buffer bindings.
+    GLTrackedStateTextures      = (1 << 1), // Texture, image, and sampler bindings.
+    GLTrackedStateVertexArray   = (1 << 2), // Vertex array binding.
+    GLTrackedStatePipeline      = (1 << 3), // Pipeline state binding.
+    GLTrackedStateDynamic       = (1 << 4), // Viewport, scissor, blend color, and stencil reference.
+    GLTrackedStateAll           = 0x1F,
+};
+
+// Returns the bitwise OR combination of all tracked states that are not affected by the specified command.
+static int GetPreservedGLStates(const GLOpcode opcode)
+{
+    switch (opcode)
+    {
+        /* Commands that only update the tracked states or don't change any binding */
+        case GLOpcodeBindVertexArray:
+        case GLOpcodeBindElementArrayBufferToVAO:
+        case GLOpcodeBindBufferBase:
+        case GLOpcodeBindBuffersBase:
+        case GLOpcodeBeginTransformFeedback:
+        case GLOpcodeBeginTransformFeedbackNV:
+        case GLOpcodeEndTransformFeedback:
+        case GLOpcodeEndTransformFeedbackNV:
+        case GLOpcodeBeginQuery:
+        case GLOpcodeEndQuery:
+        case GLOpcodeBeginConditionalRender:
+        case GLOpcodeEndConditionalRender:
+        case GLOpcodeDrawArrays:
+        case GLOpcodeDrawArraysInstanced:
+        case GLOpcodeDrawArraysInstancedBaseInstance:
+        case GLOpcodeDrawArraysIndirect:
+        case GLOpcodeDrawElements:
+        case GLOpcodeDrawElementsBaseVertex:
+        case GLOpcodeDrawElementsInstanced:
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+        case GLOpcodeDrawElementsIndirect:
+        case GLOpcodeMultiDrawArraysIndirect:
+        case GLOpcodeMultiDrawElementsIndirect:
+        case GLOpcodeMultiDrawElementsBaseVertex:
+        case GLOpcodeDispatchCompute:
+        case GLOpcodeDispatchComputeIndirect:
+        case GLOpcodeBindTexture:
+        case GLOpcodeBindTextures:
+        case GLOpcodeBindImageTexture:
+        case GLOpcodeBindSampler:
+        case GLOpcodePushDebugGroup:
+        case GLOpcodePopDebugGroup:
+            return GLTrackedStateAll;
+
+        /* Pipeline states might set static viewports, scissors, blend color, and stencil reference */
+        case GLOpcodeBindPipelineState:
+            return (GLTrackedStateAll & ~GLTrackedStateDynamic);
+
+        /* Dynamic states are overridden when the same pipeline state is bound again, so it must not be considered redundant */
+        case GLOpcodeViewport:
+        case GLOpcodeScissor:
+        case GLOpcodeSetBlendColor:
+        case GLOpcodeSetStencilRef:
+        case GLOpcodeSetUniforms:
+            return (GLTrackedStateAll & ~GLTrackedStatePipeline);
+
+        /* Viewport and scissor arrays are not tracked */
+        case GLOpcodeViewportArray:
+        case GLOpcodeScissorArray:
+            return (GLTrackedStateAll & ~(GLTrackedStatePipeline | GLTrackedStateDynamic));
+
+        /* Clear commands might temporarily modify the state objects of the bound pipeline */
+        case GLOpcodeClearColor:
+        case GLOpcodeClearDepth:
+        case GLOpcodeClearStencil:
+        case GLOpcodeClear:
+        case GLOpcodeClearAttachmentsWithRenderPass:
+        case GLOpcodeClearBuffers:
+            return (GLTrackedStateAll & ~GLTrackedStatePipeline);
+
+        /* All other commands might change arbitrary bindings, e.g. secondary command buffers, resource heaps, and texture uploads */
+        default:
+            return 0;
+    }
+}
+
+// Returns true if the specified command neither reads nor overrides viewports, scissors, and uniforms.
+static bool IsGLCommandStateUpdateNeutral(const GLOpcode opcode)
+{
+    switch (opcode)
+    {
+        case GLOpcodeViewport:
+        case GLOpcodeViewportArray:
+        case GLOpcodeScissor:
+        case GLOpcodeScissorArray:
+        case GLOpcodeBindVertexArray:
+        case GLOpcodeBindElementArrayBufferToVAO:
+        case GLOpcodeBindBufferBase:
+        case GLOpcodeBindBuffersBase:
+        case GLOpcodeSetBlendColor:
+        case GLOpcodeSetStencilRef:
+        case GLOpcodeSetUniforms:
+        case GLOpcodeBindTexture:
+        case GLOpcodeBindTextures:
+        case GLOpcodeBindImageTexture:
+        case GLOpcodeBindSampler:
+        case GLOpcodePushDebugGroup:
+        case GLOpcodePopDebugGroup:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Value of a tracked binding. Values are compared bitwise, so only types without padding bytes must be used.
+template <typename T>
+struct GLTrackedValue
+{
+    // Stores the new value and returns false if it is equal to the previous value.
+    bool Update(const T& newValue)
+    {
+        if (valid && ::memcmp(&value, &newValue, sizeof(T)) == 0)
+            return false;
+        value = newValue;
+        valid = true;
+        return true;
+    }
+
+    // Returns true if the specified value is equal to the previous value.
+    bool Equals(const T& otherValue) const
+    {
+        return (valid && ::memcmp(&value, &otherValue, sizeof(T)) == 0);
+    }
+
+    T       value;
+    bool    valid = false;
+};
+
+// Keeps track of all bindings within a command stream. Slots outside of the tracked ranges are never considered redundant.
+class GLBindingTracker
+{
+
+    public:
+
+        // Returns true if the specified command is redundant and updates the tracked states otherwise.
+        bool IsRedundant(const GLOpcode opcode, const void* pc)
+        {
+            if (UpdateBinding(opcode, pc))
+            {
+                Invalidate(~GetPreservedGLStates(opcode));
+                return false;
+            }
+            return true;
+        }
+
+    private:
+
+        // Updates the tracked binding of the specified command and returns false if the binding has not changed.
+        bool UpdateBinding(const GLOpcode opcode, const void* pc)
+        {
+            switch (opcode)
+            {
+                case GLOpcodeViewport:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdViewport*>(pc);
+                    return viewport_.Update(*cmd);
+                }
+                case GLOpcodeScissor:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdScissor*>(pc);
+                    return scissor_.Update(*cmd);
+                }
+                case GLOpcodeBindVertexArray:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdBindVertexArray*>(pc);
+                    return vertexArray_.Update(cmd->vao);
+                }
+                case GLOpcodeBindBufferBase:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdBindBufferBase*>(pc);
+                    if (auto entry = GetBufferEntry(cmd->target, cmd->index))
+                        return entry->Update(cmd->id);
+                    return true;
+                }
+                case GLOpcodeBindBuffersBase:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdBindBuffersBase*>(pc);
+                    auto buffers = reinterpret_cast<const GLuint*>(cmd + 1);
+                    bool changed = false;
+                    for (GLsizei i = 0; i < cmd->count; ++i)
+                    {
+                        if (auto entry = GetBufferEntry(cmd->target, cmd->first + i))
+                        {
+                            if (entry->Update(buffers[i]))
+                                changed = true;
+                        }
+                        else
+                            changed = true;
+                    }
+                    return changed;
+                }
+                case GLOpcodeBindPipelineState:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdBindPipelineState*>(pc);
+                    return pipelineState_.Update(cmd->pipelineState);
+                }
+                case GLOpcodeSetBlendColor:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdSetBlendColor*>(pc);
+                    return blendColor_.Update(*cmd);
+                }
+                case GLOpcodeSetStencilRef:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdSetStencilRef*>(pc);
+                    return stencilRef_.Update(*cmd);
+                }
+                case GLOpcodeBindTexture:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdBindTexture*>(pc);
+                    if (cmd->slot < GLContextState::numTextureLayers)
+                        return textures_[cmd->slot].Update(cmd->texture);
+                    return true;
+                }
+                case GLOpcodeBindImageTexture:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdBindImageTexture*>(pc);
+                    if (cmd->unit < GLContextState::numImageUnits)
+                        return images_[cmd->unit].Update(*cmd);
+                    return true;
+                }
+                case GLOpcodeBindSampler:
+                {
+                    auto cmd = reinterpret_cast<const GLCmdBindSampler*>(pc);
+                    if (cmd->layer < GLContextState::numTextureLayers)
+                        return samplers_[cmd->layer].Update(cmd->sampler);
+                    return true;
+                }
+                default:
+                    return true;
+            }
+        }
+
+        // Invalidates all tracked states of the specified categories (see GLTrackedState).
+        void Invalidate(int states)
+        {
+            if ((states & GLTrackedStateBuffers) != 0)
+            {
+                for (auto& target : buffers_)
+                {
+                    for (auto& entry : target)
+                        entry.valid = false;
+                }
+            }
+            if ((states & GLTrackedStateTextures) != 0)
+            {
+                for (auto& entry : textures_)
+                    entry.valid = false;
+                for (auto& entry : images_)
+                    entry.valid = false;
+                for (auto& entry : samplers_)
+                    entry.valid = false;
+            }
+            if ((states & GLTrackedStateVertexArray) != 0)
+                vertexArray_.valid = false;
+            if ((states & GLTrackedStatePipeline) != 0)
+                pipelineState_.valid = false;
+            if ((states & GLTrackedStateDynamic) != 0)
+            {
+                viewport_.valid     = false;
+                scissor_.valid      = false;
+                blendColor_.valid   = false;
+                stencilRef_.valid   = false;
+            }
+        }
+
+        GLTrackedValue<GLuint>* GetBufferEntry(GLBufferTarget target, GLuint index)
+        {
+            auto targetIdx = static_cast<GLuint>(target);
+            if (targetIdx < GLContextState::numBufferTargets && index < numBufferSlots)
+                return &(buffers_[targetIdx][index]);
+            return nullptr;
+        }
+
+    private:
+
+        static const GLuint numBufferSlots = 32;
+
+        GLTrackedValue<GLuint>                  buffers_[GLContextState::numBufferTargets][numBufferSlots];
+        GLTrackedValue<const GLTexture*>        textures_[GLContextState::numTextureLayers];
+        GLTrackedValue<GLCmdBindImageTexture>   images_[GLContextState::numImageUnits];
+        GLTrackedValue<GLuint>                  samplers_[GLContextState::numTextureLayers];
+        GLTrackedValue<GLuint>                  vertexArray_;
+        GLTrackedValue<const GLPipelineState*>  pipelineState_;
+        GLTrackedValue<GLCmdViewport>           viewport_;
+        GLTrackedValue<GLCmdScissor>            scissor_;
+        GLTrackedValue<GLCmdSetBlendColor>      blendColor_;
+        GLTrackedValue<GLCmdSetStencilRef>      stencilRef_;
+
+};
+
+
+/* ----- Optimization passes ----- */
+
+static const std::size_t g_invalidRecord = ~static_cast<std::size_t>(0);
+
+// Drops the previous command, if there is one, and makes the specified command the pending one.
+static void ReplacePendingGLCommand(std::vector<GLCommandRecord>& records, std::size_t& pending, std::size_t current)
+{
+    if (pending != g_invalidRecord)
+        records[pending].keep = false;
+    pending = current;
+}
+
+static bool IsSameGLViewportArrayRange(const GLCmdViewportArray* lhs, const GLCmdViewportArray* rhs)
+{
+    return (lhs->first == rhs->first && lhs->count == rhs->count);
+}
+
+static bool IsSameGLScissorArrayRange(const GLCmdScissorArray* lhs, const GLCmdScissorArray* rhs)
+{
+    return (lhs->first == rhs->first && lhs->count == rhs->count);
+}
+
+static bool IsSameGLUniformRange(const GLCmdSetUniforms* lhs, const GLCmdSetUniforms* rhs)
+{
+    return (lhs->program == rhs->program && lhs->location == rhs->location && lhs->count == rhs->count && lhs->size == rhs->size);
+}
+
+/*
+Removes redundant bindings and drops viewport, scissor, and uniform updates that are overwritten before they can be consumed.
+An update is overwritten if the same state is set again and only state-neutral commands are recorded in between.
+*/
+static void EliminateRedundantGLCommands(std::vector<GLCommandRecord>& records)
+{
+    GLBindingTracker    tracker;
+    std::size_t         pendingViewport         = g_invalidRecord;
+    std::size_t         pendingViewportArray    = g_invalidRecord;
+    std::size_t         pendingScissor          = g_invalidRecord;
+    std::size_t         pendingScissorArray     = g_invalidRecord;
+    std::vector<std::size_t> pendingUniforms;
+
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        auto& record = records[i];
+
+        /* Drop bindings that don't change the state */
+        if (tracker.IsRedundant(record.opcode, record.cmd))
+        {
+            record.keep = false;
+            continue;
+        }
+
+        /* Drop previous state updates that are overwritten by this command */
+        switch (record.opcode)
+        {
+            case GLOpcodeViewport:
+            {
+                ReplacePendingGLCommand(records, pendingViewport, i);
+            }
+            break;
+
+            case GLOpcodeViewportArray:
+            {
+                auto cmd = reinterpret_cast<const GLCmdViewportArray*>(record.cmd);
+                if (pendingViewportArray != g_invalidRecord &&
+                    !IsSameGLViewportArrayRange(reinterpret_cast<const GLCmdViewportArray*>(records[pendingViewportArray].cmd), cmd))
+                {
+                    pendingViewportArray = g_invalidRecord;
+                }
+                ReplacePendingGLCommand(records, pendingViewportArray, i);
+            }
+            break;
+
+            case GLOpcodeScissor:
+            {
+                ReplacePendingGLCommand(records, pendingScissor, i);
+            }
+            break;
+
+            case GLOpcodeScissorArray:
+            {
+                auto cmd = reinterpret_cast<const GLCmdScissorArray*>(record.cmd);
+                if (pendingScissorArray != g_invalidRecord &&
+                    !IsSameGLScissorArrayRange(reinterpret_cast<const GLCmdScissorArray*>(records[pendingScissorArray].cmd), cmd))
+                {
+                    pendingScissorArray = g_invalidRecord;
+                }
+                ReplacePendingGLCommand(records, pendingScissorArray, i);
+            }
+            break;
+
+            case GLOpcodeSetUniforms:
+            {
+                auto cmd = reinterpret_cast<const GLCmdSetUniforms*>(record.cmd);
+                bool replaced = false;
+                for (auto& pending : pendingUniforms)
+                {
+                    if (IsSameGLUniformRange(reinterpret_cast<const GLCmdSetUniforms*>(records[pending].cmd), cmd))
+                    {
+                        ReplacePendingGLCommand(records, pending, i);
+                        replaced = true;
+                        break;
+                    }
+                }
+                if (!replaced)
+                    pendingUniforms.push_back(i);
+            }
+            break;
+
+            default:
+            {
+                /* Commands that might consume or override the pending state updates finalize them */
+                if (!IsGLCommandStateUpdateNeutral(record.opcode))
+                {
+                    pendingViewport         = g_invalidRecord;
+                    pendingViewportArray    = g_invalidRecord;
+                    pendingScissor          = g_invalidRecord;
+                    pendingScissorArray     = g_invalidRecord;
+                    pendingUniforms.clear();
+                }
+            }
+            break;
+        }
+    }
+}
+
+// Returns the number of kept BindBufferBase commands, starting at the specified record, that bind consecutive slots of the same target.
+static std::size_t FindGLBufferBaseRun(const std::vector<GLCommandRecord>& records, std::size_t first, std::size_t& next)
+{
+    auto firstCmd = reinterpret_cast<const GLCmdBindBufferBase*>(records[first].cmd);
+    std::size_t count = 1;
+
+    for (next = first + 1; next < records.size(); ++next)
+    {
+        const auto& record = records[next];
+        if (!record.keep)
+            continue;
+        if (record.opcode != GLOpcodeBindBufferBase)
+            break;
+        auto cmd = reinterpret_cast<const GLCmdBindBufferBase*>(record.cmd);
+        if (cmd->target != firstCmd->target || cmd->index != firstCmd->index + count)
+            break;
+        ++count;
+    }
+
+    return count;
+}
+
+// Returns the number of kept BindTexture commands, starting at the specified record, that bind consecutive slots.
+static std::size_t FindGLTextureRun(const std::vector<GLCommandRecord>& records, std::size_t first, std::size_t& next)
+{
+    auto firstCmd = reinterpret_cast<const GLCmdBindTexture*>(records[first].cmd);
+    std::size_t count = 1;
+
+    for (next = first + 1; next < records.size(); ++next)
+    {
+        const auto& record = records[next];
+        if (!record.keep)
+            continue;
+        if (record.opcode != GLOpcodeBindTexture)
+            break;
+        auto cmd = reinterpret_cast<const GLCmdBindTexture*>(record.cmd);
+        if (cmd->slot != firstCmd->slot + count)
+            break;
+        ++count;
+    }
+
+    return count;
+}
+
+static void EmitGLBuffersBase(const std::vector<GLCommandRecord>& records, std::size_t first, std::size_t count, GLVirtualCommandBuffer& output)
+{
+    auto firstCmd = reinterpret_cast<const GLCmdBindBufferBase*>(records[first].cmd);
+
+    auto cmd = output.AllocCommand<GLCmdBindBuffersBase>(GLOpcodeBindBuffersBase, sizeof(GLuint)*count);
+    {
+        cmd->target = firstCmd->target;
+        cmd->first  = firstCmd->index;
+        cmd->count  = static_cast<GLsizei>(count);
+
+        auto buffers = reinterpret_cast<GLuint*>(cmd + 1);
+        for (std::size_t i = first, n = 0; n < count; ++i)
+        {
+            if (records[i].keep)
+                buffers[n++] = reinterpret_cast<const GLCmdBindBufferBase*>(records[i].cmd)->id;
+        }
+    }
+}
+
+static void EmitGLTextures(const std::vector<GLCommandRecord>& records, std::size_t first, std::size_t count, GLVirtualCommandBuffer& output)
+{
+    auto firstCmd = reinterpret_cast<const GLCmdBindTexture*>(records[first].cmd);
+
+    auto cmd = output.AllocCommand<GLCmdBindTextures>(GLOpcodeBindTextures, (sizeof(GLuint) + sizeof(GLTextureTarget))*count);
+    {
+        cmd->first  = firstCmd->slot;
+        cmd->count  = static_cast<GLsizei>(count);
+
+        auto textures   = reinterpret_cast<GLuint*>(cmd + 1);
+        auto targets    = reinterpret_cast<GLTextureTarget*>(textures + count);
+        for (std::size_t i = first, n = 0; n < count; ++i)
+        {
+            if (records[i].keep)
+            {
+                auto texture = reinterpret_cast<const GLCmdBindTexture*>(records[i].cmd)->texture;
+                textures[n] = texture->GetID();
+                targets[n]  = GLStateManager::GetTextureTarget(texture->GetType());
+                ++n;
+            }
+        }
+    }
+}
+
+
+/* ----- Draw batching ----- */
+
+/*
+Arguments of indexed draw commands that have been batched into multi-draw-indirect commands.
+The batched commands read their arguments from the buffer with the specified ID, which is filled
+with these arguments after all commands have been emitted.
+*/
+struct GLIndirectDrawBatch
+{
+    GLuint                                      bufferID    = 0;
+    std::vector<DrawIndexedIndirectArguments>   arguments;
+};
+
+// Strategies to merge consecutive indexed draw commands.
+enum class GLDrawBatchMode
+{
+    Disabled,               // Draw commands are not merged.
+    MultiDrawIndirect,      // Draw commands are merged into glMultiDrawElementsIndirect with arguments from GLIndirectDrawBatch.
+    MultiDrawBaseVertex,    // Non-instanced draw commands are merged into glMultiDrawElementsBaseVertex.
+};
+
+// Common arguments of all indexed draw commands.
+struct GLDrawElementsArgs
+{
+    GLenum          mode;
+    GLenum          type;
+    GLsizei         count;
+    const GLvoid*   indices;
+    GLsizei         instancecount;
+    GLint           basevertex;
+    GLuint          baseinstance;
+};
+
+// Returns true if the specified command is an indexed draw command and stores its arguments in the output parameter.
+static bool GetGLDrawElementsArgs(const GLCommandRecord& record, GLDrawElementsArgs& outArgs)
+{
+    switch (record.opcode)
+    {
+        case GLOpcodeDrawElements:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElements*>(record.cmd);
+            outArgs = { cmd->mode, cmd->type, cmd->count, cmd->indices, 1, 0, 0 };
+            return true;
+        }
+        case GLOpcodeDrawElementsBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsBaseVertex*>(record.cmd);
+            outArgs = { cmd->mode, cmd->type, cmd->count, cmd->indices, 1, cmd->basevertex, 0 };
+            return true;
+        }
+        case GLOpcodeDrawElementsInstanced:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstanced*>(record.cmd);
+            outArgs = { cmd->mode, cmd->type, cmd->count, cmd->indices, cmd->instancecount, 0, 0 };
+            return true;
+        }
+        case GLOpcodeDrawElementsInstancedBaseVertex:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertex*>(record.cmd);
+            outArgs = { cmd->mode, cmd->type, cmd->count, cmd->indices, cmd->instancecount, cmd->basevertex, 0 };
+            return true;
+        }
+        case GLOpcodeDrawElementsInstancedBaseVertexBaseInstance:
+        {
+            auto cmd = reinterpret_cast<const GLCmdDrawElementsInstancedBaseVertexBaseInstance*>(record.cmd);
+            outArgs = { cmd->mode, cmd->type, cmd->count, cmd->indices, cmd->instancecount, cmd->basevertex, cmd->baseinstance };
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// Returns the size (in bytes) of the specified GL index type, or 0 if the type is invalid.
+static GLintptr GetGLIndexTypeSize(GLenum type)
+{
+    switch (type)
+    {
+        case GL_UNSIGNED_BYTE:  return 1;
+        case GL_UNSIGNED_SHORT: return 2;
+        case GL_UNSIGNED_INT:   return 4;
+        default:                return 0;
+    }
+}
+
+// Returns true if the specified draw command can be merged into a batch with the specified primitive mode and index type.
+static bool IsGLDrawElementsBatchable(const GLDrawElementsArgs& args, GLenum mode, GLenum type, const GLDrawBatchMode batchMode)
+{
+    if (args.mode != mode || args.type != type)
+        return false;
+
+    switch (batchMode)
+    {
+        case GLDrawBatchMode::MultiDrawIndirect:
+        {
+            /* Indirect arguments specify the first index instead of a byte offset into the index buffer */
+            const auto indexSize = GetGLIndexTypeSize(args.type);
+            return (indexSize > 0 && reinterpret_cast<GLintptr>(args.indices) % indexSize == 0);
+        }
+        case GLDrawBatchMode::MultiDrawBaseVertex:
+        {
+            /* glMultiDrawElementsBaseVertex draws a single instance of each mesh */
+            return (args.instancecount == 1 && args.baseinstance == 0);
+        }
+        default:
+            return false;
+    }
+}
+
+// Returns the number of kept indexed draw commands, starting at the specified record, that can be merged into a single batch.
+static std::size_t FindGLDrawElementsRun(const std::vector<GLCommandRecord>& records, std::size_t first, const GLDrawBatchMode batchMode, std::size_t& next)
+{
+    GLDrawElementsArgs firstArgs, args;
+
+    next = first + 1;
+    if (!GetGLDrawElementsArgs(records[first], firstArgs) || !IsGLDrawElementsBatchable(firstArgs, firstArgs.mode, firstArgs.type, batchMode))
+        return 1;
+
+    std::size_t count = 1;
+
+    for (; next < records.size(); ++next)
+    {
+        const auto& record = records[next];
+        if (!record.keep)
+            continue;
+        if (!GetGLDrawElementsArgs(record, args) || !IsGLDrawElementsBatchable(args, firstArgs.mode, firstArgs.type, batchMode))
+            break;
+        ++count;
+    }
+
+    return count;
+}
+
+static void EmitGLMultiDrawElementsIndirect(
+    const std::vector<GLCommandRecord>& records,
+    std::size_t                         first,
+    std::size_t                         count,
+    GLIndirectDrawBatch&                indirectBatch,
+    GLVirtualCommandBuffer&             output)
+{
+    GLDrawElementsArgs args;
+    GetGLDrawElementsArgs(records[first], args);
+
+    const GLintptr indirect = static_cast<GLintptr>(sizeof(DrawIndexedIndirectArguments) * indirectBatch.arguments.size());
+
+    auto cmd = output.AllocCommand<GLCmdMultiDrawElementsIndirect>(GLOpcodeMultiDrawElementsIndirect);
+    {
+        cmd->id         = indirectBatch.bufferID;
+        cmd->mode       = args.mode;
+        cmd->type       = args.type;
+        cmd->indirect   = reinterpret_cast<const GLvoid*>(indirect);
+        cmd->drawcount  = static_cast<GLsizei>(count);
+        cmd->stride     = 0;
+    }
+
+    /* Append tightly packed arguments of all merged draw commands */
+    const auto indexSize = GetGLIndexTypeSize(args.type);
+
+    for (std::size_t i = first, n = 0; n < count; ++i)
+    {
+        if (records[i].keep)
+        {
+            GetGLDrawElementsArgs(records[i], args);
+
+            DrawIndexedIndirectArguments drawArgs;
+            {
+                drawArgs.numIndices     = static_cast<std::uint32_t>(args.count);
+                drawArgs.numInstances   = static_cast<std::uint32_t>(args.instancecount);
+                drawArgs.firstIndex     = static_cast<std::uint32_t>(reinterpret_cast<GLintptr>(args.indices) / indexSize);
+                drawArgs.vertexOffset   = args.basevertex;
+                drawArgs.firstInstance  = args.baseinstance;
+            }
+            indirectBatch.arguments.push_back(drawArgs);
+            ++n;
+        }
+    }
+}
+
+static void EmitGLMultiDrawElementsBaseVertex(const std::vector<GLCommandRecord>& records, std::size_t first, std::size_t count, GLVirtualCommandBuffer& output)
+{
+    GLDrawElementsArgs args;
+    GetGLDrawElementsArgs(records[first], args);
+
+    auto cmd = output.AllocCommand<GLCmdMultiDrawElementsBaseVertex>(
+        GLOpcodeMultiDrawElementsBaseVertex,
+        (sizeof(GLsizei) + sizeof(const GLvoid*) + sizeof(GLint))*count
+    );
+    {
+        cmd->mode       = args.mode;
+        cmd->type       = args.type;
+        cmd->drawcount  = static_cast<GLsizei>(count);
+
+        auto counts         = reinterpret_cast<GLsizei*>(cmd + 1);
+        auto indices        = reinterpret_cast<const GLvoid**>(counts + count);
+        auto basevertices   = reinterpret_cast<GLint*>(indices + count);
+        for (std::size_t i = first, n = 0; n < count; ++i)
+        {
+            if (records[i].keep)
+            {
+                GetGLDrawElementsArgs(records[i], args);
+                counts[n]       = args.count;
+                indices[n]      = args.indices;
+                basevertices[n] = args.basevertex;
+                ++n;
+            }
+        }
+    }
+}
+
+// Returns the strategy to merge indexed draw commands with the available GL extensions.
+static GLDrawBatchMode GetGLDrawBatchMode()
+{
+    #ifdef LLGL_GLEXT_MULTI_DRAW_INDIRECT
+    if (HasExtension(GLExt::ARB_multi_draw_indirect))
+        return GLDrawBatchMode::MultiDrawIndirect;
+    #endif // /LLGL_GLEXT_MULTI_DRAW_INDIRECT
+
+    #ifdef GL_ARB_draw_elements_base_vertex
+    if (HasExtension(GLExt::ARB_draw_elements_base_vertex))
+        return GLDrawBatchMode::MultiDrawBaseVertex;
+    #endif // /GL_ARB_draw_elements_base_vertex
+
+    return GLDrawBatchMode::Disabled;
+}
+
+
+// Returns true if the input buffer contains at least one run of indexed draw commands that can be merged, without parsing it into records.
+static bool HasGLDrawElementsRun(const GLVirtualCommandBuffer& input, const GLDrawBatchMode batchMode)
+{
+    GLDrawElementsArgs prevArgs, args;
+    bool prevBatchable = false;
+
+    for (const auto& chunk : input)
+    {
+        auto pc     = chunk.data;
+        auto pcEnd  = chunk.data + chunk.size;
+
+        while (pc < pcEnd)
+        {
+            const GLOpcode opcode = *reinterpret_cast<const GLOpcode*>(pc);
+            pc += sizeof(GLOpcode);
+
+            const std::size_t size = GetGLCommandSize(opcode, pc);
+            const GLCommandRecord record{ opcode, pc, size, true };
+            pc += size;
+
+            /* Two consecutive indexed draw commands with the same primitive mode and index type form a run */
+            if (GetGLDrawElementsArgs(record, args) && IsGLDrawElementsBatchable(args, args.mode, args.type, batchMode))
+            {
+                if (prevBatchable && prevArgs.mode == args.mode && prevArgs.type == args.type)
+                    return true;
+                prevArgs        = args;
+                prevBatchable   = true;
+            }
+            else
+                prevBatchable = false;
+        }
+    }
+
+    return false;
+}
+
+// Returns the number of indexed draw commands that are merged into batches.
+static std::size_t CountGLDrawBatchArguments(const std::vector<GLCommandRecord>& records, const GLDrawBatchMode batchMode)
+{
+    std::size_t numArguments = 0;
+    for (std::size_t i = 0, next = 0; i < records.size(); i = next)
+    {
+        auto count = FindGLDrawElementsRun(records, i, batchMode, next);
+        if (count > 1)
+            numArguments += count;
+    }
+    return numArguments;
+}
+
+// Makes sure the indirect argument buffer can hold the specified number of bytes. The buffer grows geometrically, so it is rarely reallocated.
+static void ReserveGLIndirectArgumentBuffer(GLIndirectArgumentBuffer& indirectBuffer, GLsizeiptr size)
+{
+    if (indirectBuffer.buffer && indirectBuffer.capacity >= size)
+        return;
+
+    #ifdef GL_ARB_buffer_storage
+    const GLbitfield storageFlags = GL_DYNAMIC_STORAGE_BIT;
+    #else
+    const GLbitfield storageFlags = 0;
+    #endif // /GL_ARB_buffer_storage
+
+    indirectBuffer.capacity = std::max(size, indirectBuffer.capacity * 2);
+    indirectBuffer.buffer   = MakeUnique<GLBuffer>(BindFlags::IndirectBuffer);
+    indirectBuffer.buffer->BufferStorage(indirectBuffer.capacity, nullptr, storageFlags, GL_DYNAMIC_DRAW);
+}
+
+
+/* ----- Command emission ----- */
+
+static void EmitGLCommand(const GLCommandRecord& record, GLVirtualCommandBuffer& output)
+{
+    auto cmd = output.AllocRawCommand(record.opcode, record.size);
+    ::memcpy(cmd, record.cmd, record.size);
+}
+
+// Writes all kept commands into the output buffer and merges consecutive buffer and texture bindings into array bindings.
+static void EmitGLCommands(const std::vector<GLCommandRecord>& records, GLVirtualCommandBuffer& output)
+{
+    for (std::size_t i = 0; i < records.size();)
+    {
+        const auto& record = records[i];
+        if (!record.keep)
+        {
+            ++i;
+            continue;
+        }
+
+        std::size_t next = i + 1;
+
+        if (record.opcode == GLOpcodeBindBufferBase)
+        {
+            /* Merge consecutive buffer bindings into a single BindBuffersBase command */
+            auto count = FindGLBufferBaseRun(records, i, next);
+            if (count > 1)
+            {
+                EmitGLBuffersBase(records, i, count, output);
+                i = next;
+                continue;
+            }
+        }
+        #ifndef LLGL_GL_ENABLE_OPENGL2X
+        else if (record.opcode == GLOpcodeBindTexture)
+        {
+            /* Merge consecutive texture bindings into a single BindTextures command (GL 2.x sampler emulation requires GLTexture references) */
+            auto count = FindGLTextureRun(records, i, next);
+            if (count > 1)
+            {
+                EmitGLTextures(records, i, count, output);
+                i = next;
+                continue;
+            }
+        }
+        #endif // /LLGL_GL_ENABLE_OPENGL2X
+
+        /* Copy command as is */
+        EmitGLCommand(record, output);
+        i = next;
+    }
+}
+
+// Writes all commands into the output buffer and merges consecutive indexed draw commands into multi-draw commands.
+static void EmitGLDrawBatches(
+    const std::vector<GLCommandRecord>& records,
+    const GLDrawBatchMode               batchMode,
+    GLIndirectDrawBatch&                indirectBatch,
+    GLVirtualCommandBuffer&             output)
+{
+    for (std::size_t i = 0, next = 0; i < records.size(); i = next)
+    {
+        auto count = FindGLDrawElementsRun(records, i, batchMode, next);
+        if (count > 1)
+        {
+            if (batchMode == GLDrawBatchMode::MultiDrawIndirect)
+                EmitGLMultiDrawElementsIndirect(records, i, count, indirectBatch, output);
+            else
+                EmitGLMultiDrawElementsBaseVertex(records, i, count, output);
+        }
+        else
+        {
+            /* Copy command as is */
+            EmitGLCommand(records[i], output);
+        }
+    }
+}
+
+
+/* ----- Global functions ----- */
+
+void OptimizeGLVirtualCommandBuffer(const GLVirtualCommandBuffer& input, GLVirtualCommandBuffer& output)
+{
+    std::vector<GLCommandRecord> records;
+    ParseGLCommands(input, records);
+    EliminateRedundantGLCommands(records);
+    EmitGLCommands(records, output);
+}
+
+bool HasGLDrawCommandsToBatch(const GLVirtualCommandBuffer& input)
+{
+    const auto batchMode = GetGLDrawBatchMode();
+    if (batchMode == GLDrawBatchMode::Disabled)
+        return false;
+    return HasGLDrawElementsRun(input, batchMode);
+}
+
+void BatchGLDrawCommands(
+    const GLVirtualCommandBuffer&   input,
+    GLVirtualCommandBuffer&         output,
+    GLIndirectArgumentBuffer&       indirectBuffer)
+{
+    const auto batchMode = GetGLDrawBatchMode();
+
+    std::vector<GLCommandRecord> records;
+    ParseGLCommands(input, records);
+
+    /* Reserve the persistent buffer for the arguments of batched draw commands; its ID is written into the merged commands */
+    GLIndirectDrawBatch indirectBatch;
+
+    if (batchMode == GLDrawBatchMode::MultiDrawIndirect)
+    {
+        const auto numArguments = CountGLDrawBatchArguments(records, batchMode);
+        ReserveGLIndirectArgumentBuffer(indirectBuffer, static_cast<GLsizeiptr>(sizeof(DrawIndexedIndirectArguments) * numArguments));
+        indirectBatch.bufferID = indirectBuffer.buffer->GetID();
+        indirectBatch.arguments.reserve(numArguments);
+    }
+
+    EmitGLDrawBatches(records, batchMode, indirectBatch, output);
+
+    /* Upload arguments of batched draw commands; GL orders this update after all previously submitted commands that read the buffer */
+    if (!indirectBatch.arguments.empty())
+    {
+        indirectBuffer.buffer->BufferSubData(
+            0,
+            static_cast<GLsizeiptr>(sizeof(DrawIndexedIndirectArguments) * indirectBatch.arguments.size()),
+            indirectBatch.arguments.data()
+        );
+    }
+}
+
+#ifdef LLGL_DEBUG
+
+LLGL_EXPORT void GetGLCommandBufferOpcodes(const CommandBuffer& commandBuffer, std::vector<GLOpcode>& outOpcodes)
+{
+    auto& cmdBufferGL = LLGL_CAST(const GLDeferredCommandBuffer&, commandBuffer);
+
+    std::vector<GLCommandRecord> records;
+    ParseGLCommands(cmdBufferGL.GetVirtualCommandBuffer(), records);
+
+    outOpcodes.clear();
+    outOpcodes.reserve(records.size());
+    for (const auto& record : records)
+        outOpcodes.push_back(record.opcode);
+}
+
+#endif // /LLGL_DEBUG
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
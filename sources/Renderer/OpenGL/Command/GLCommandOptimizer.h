@@ -0,0 +1,63 @@
+/*
+ * GLCommandOptimizer.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_COMMAND_OPTIMIZER_H
+#define LLGL_GL_COMMAND_OPTIMIZER_H
+
+
+#include "GLDeferredCommandBuffer.h"
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+
+/*
+Rewrites the GL commands of the input virtual command buffer into the output virtual command buffer.
+Bindings that are redundant within the command stream are removed, viewport, scissor, and uniform updates
+that are overwritten before any draw or dispatch command are dropped, and consecutive buffer and texture bindings
+are merged into array bindings. The output command buffer must be empty.
+*/
+void OptimizeGLVirtualCommandBuffer(const GLVirtualCommandBuffer& input, GLVirtualCommandBuffer& output);
+
+/*
+Returns true if the input virtual command buffer contains consecutive indexed draw commands that can be merged by BatchGLDrawCommands.
+This only scans the command stream and does not allocate any memory, so it can be called for every encoded command buffer.
+*/
+bool HasGLDrawCommandsToBatch(const GLVirtualCommandBuffer& input);
+
+/*
+Rewrites the GL commands of the input virtual command buffer into the output virtual command buffer in a single linear pass,
+and merges consecutive indexed draw commands without any state change in between into a single glMultiDrawElementsIndirect command,
+or glMultiDrawElementsBaseVertex if ARB_multi_draw_indirect is not supported. The arguments of the merged indirect draw commands
+are uploaded to 'indirectBuffer', which is only reallocated if it is too small. Must only be called if HasGLDrawCommandsToBatch returned true.
+The output command buffer must be empty.
+*/
+void BatchGLDrawCommands(
+    const GLVirtualCommandBuffer&   input,
+    GLVirtualCommandBuffer&         output,
+    GLIndirectArgumentBuffer&       indirectBuffer
+);
+
+#ifdef LLGL_DEBUG
+
+// Stores the opcodes of all commands that are currently recorded in the specified deferred GL command buffer; used by Test_GLCommandOptimizer.
+LLGL_EXPORT void GetGLCommandBufferOpcodes(const CommandBuffer& commandBuffer, std::vector<GLOpcode>& outOpcodes);
+
+#endif // /LLGL_DEBUG
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -34,11 +34,14 @@ void GLCommandQueue::Submit(CommandBuffer& commandBuffer)
     Only deferred command buffers can be submitted multiple times (via GLDeferredCommandBuffer),
     otherwise the commands must be submitted immediately (via GLImmediateCommandBuffer).
     */
-    auto& cmdBufferGL = LLGL_CAST(const GLCommandBuffer&, commandBuffer);
+    auto& cmdBufferGL = LLGL_CAST(GLCommandBuffer&, commandBuffer);
     if (!cmdBufferGL.IsImmediateCmdBuffer())
     {
-        auto& deferredCmdBufferGL = LLGL_CAST(const GLDeferredCommandBuffer&, cmdBufferGL);
+        auto& deferredCmdBufferGL = LLGL_CAST(GLDeferredCommandBuffer&, cmdBufferGL);
         ExecuteGLDeferredCommandBuffer(deferredCmdBufferGL, stateMngr_);
+
+        /* Staged buffer updates have been copied, so their ring segments can be reused once the GPU is done with them */
+        deferredCmdBufferGL.ReleaseStagingReservation();
     }
 }
 
@@ -7,6 +7,7 @@
 
 #include "GLDeferredCommandBuffer.h"
 #include "GLCommand.h"
+#include "GLCommandOptimizer.h"
 #include <LLGL/StaticLimits.h>
 
 #include "../../TextureUtils.h"
@@ -17,6 +18,7 @@
 #include "../Ext/GLExtensionLoader.h"
 #include "../../CheckedCast.h"
 #include "../../../Core/Assertion.h"
+#include "../../../Core/Helper.h"
 
 #include "../Shader/GLShaderProgram.h"
 
@@ -53,13 +55,19 @@ GLDeferredCommandBuffer::GLDeferredCommandBuffer(long flags, std::size_t initial
 {
 }
 
+GLDeferredCommandBuffer::~GLDeferredCommandBuffer()
+{
+    ReleaseStagingReservation();
+}
+
 /* ----- Encoding ----- */
 
 void GLDeferredCommandBuffer::Begin()
 {
-    /* Reset internal command buffer */
+    /* Reset internal command buffer and discard staged data that has not been submitted */
     buffer_.Clear();
     boundShaderProgram_ = 0;
+    ReleaseStagingReservation();
 
     #ifdef LLGL_ENABLE_JIT_COMPILER
 
@@ -73,19 +81,29 @@ void GLDeferredCommandBuffer::Begin()
 
 void GLDeferredCommandBuffer::End()
 {
-    #ifdef LLGL_ENABLE_JIT_COMPILER
+    if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
+    {
+        /* Remove redundant commands only if command buffer will be submitted multiple times to amortize the cost */
+        OptimizeCommandBuffer();
+    }
+
+    /* Merge consecutive indexed draw commands into multi-draw commands for all command buffers */
+    BatchDrawCommands();
 
-    /* Generate native assembly only if command buffer will be submitted multiple times */
     if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
+    {
+        #ifdef LLGL_ENABLE_JIT_COMPILER
+
+        /* Generate native assembly only if command buffer will be submitted multiple times */
         executable_ = AssembleGLDeferredCommandBuffer(*this);
+        if (executable_)
+            return;
 
-    #else
+        #endif // /LLGL_ENABLE_JIT_COMPILER
 
-    /* Pack virtual command buffer if it has to be traversed multiple times */
-    if ((GetFlags() & CommandBufferFlags::MultiSubmit) != 0)
+        /* Pack virtual command buffer if it has to be traversed multiple times (or JIT assembly is not available) */
         buffer_.Pack();
-
-    #endif // /LLGL_ENABLE_JIT_COMPILER
+    }
 }
 
 void GLDeferredCommandBuffer::Execute(CommandBuffer& deferredCommandBuffer)
@@ -115,9 +133,29 @@ void GLDeferredCommandBuffer::UpdateBuffer(
     const void*     data,
     std::uint16_t   dataSize)
 {
+    auto& dstBufferGL = LLGL_CAST(GLBuffer&, dstBuffer);
+
+    if (IsPrimary() && (GetFlags() & CommandBufferFlags::MultiSubmit) == 0)
+    {
+        /* Write data into the staging ring right away if this command buffer is submitted only once, so it is not copied into the command stream first */
+        GLintptr readOffset = 0;
+        if (auto ringBuffer = GLStagingRingBuffer::Get().StageData(static_cast<GLsizeiptr>(dataSize), data, readOffset, stagingReservation_))
+        {
+            auto cmd = AllocCommand<GLCmdCopyBufferSubData>(GLOpcodeCopyBufferSubData);
+            {
+                cmd->writeBuffer    = &dstBufferGL;
+                cmd->readBuffer     = ringBuffer;
+                cmd->readOffset     = readOffset;
+                cmd->writeOffset    = static_cast<GLintptr>(dstOffset);
+                cmd->size           = static_cast<GLsizeiptr>(dataSize);
+            }
+            return;
+        }
+    }
+
     auto cmd = AllocCommand<GLCmdBufferSubData>(GLOpcodeBufferSubData, dataSize);
     {
-        cmd->buffer = LLGL_CAST(GLBuffer*, &dstBuffer);
+        cmd->buffer = &dstBufferGL;
         cmd->offset = static_cast<GLintptr>(dstOffset);
         cmd->size   = static_cast<GLsizeiptr>(dataSize);
         ::memcpy(cmd + 1, data, dataSize);
@@ -1005,6 +1043,11 @@ bool GLDeferredCommandBuffer::IsPrimary() const
     return ((GetFlags() & CommandBufferFlags::Secondary) == 0);
 }
 
+void GLDeferredCommandBuffer::ReleaseStagingReservation()
+{
+    GLStagingRingBuffer::Get().ReleaseReservation(stagingReservation_);
+}
+
 
 /*
  * ======= Private: =======
@@ -1084,6 +1127,24 @@ void GLDeferredCommandBuffer::BindGL2XSampler(const GL2XSampler& samplerGL2X, st
     }
 }
 
+void GLDeferredCommandBuffer::OptimizeCommandBuffer()
+{
+    GLVirtualCommandBuffer optimizedBuffer{ buffer_.Size() };
+    OptimizeGLVirtualCommandBuffer(buffer_, optimizedBuffer);
+    buffer_ = std::move(optimizedBuffer);
+}
+
+void GLDeferredCommandBuffer::BatchDrawCommands()
+{
+    /* Only rewrite the command buffer if there is anything to merge */
+    if (HasGLDrawCommandsToBatch(buffer_))
+    {
+        GLVirtualCommandBuffer batchedBuffer{ buffer_.Size() };
+        BatchGLDrawCommands(buffer_, batchedBuffer, indirectBuffer_);
+        buffer_ = std::move(batchedBuffer);
+    }
+}
+
 void GLDeferredCommandBuffer::AllocOpcode(const GLOpcode opcode)
 {
     buffer_.AllocOpcode(opcode);
@@ -12,6 +12,7 @@
 #include "GLCommandBuffer.h"
 #include "GLCommandOpcode.h"
 #include "../RenderState/GLState.h"
+#include "../Buffer/GLStagingRingBuffer.h"
 #include "../OpenGL.h"
 #include "../../VirtualCommandBuffer.h"
 #include <memory>
@@ -38,12 +39,20 @@ class GL2XSampler;
 
 using GLVirtualCommandBuffer = VirtualCommandBuffer<GLOpcode>;
 
+// Buffer for the arguments of merged indirect draw commands that is kept by each deferred command buffer and only reallocated when it must grow.
+struct GLIndirectArgumentBuffer
+{
+    std::unique_ptr<GLBuffer>   buffer;
+    GLsizeiptr                  capacity    = 0;
+};
+
 class GLDeferredCommandBuffer final : public GLCommandBuffer
 {
 
     public:
 
         GLDeferredCommandBuffer(long flags, std::size_t initialBufferSize = 1024);
+        ~GLDeferredCommandBuffer();
 
         /* ----- Encoding ----- */
 
@@ -225,6 +234,9 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         // Returns true if this is a primary command buffer.
         bool IsPrimary() const;
 
+        // Releases the staging ring segments that hold the data of buffer updates; must be called after this command buffer has been submitted.
+        void ReleaseStagingReservation();
+
         // Returns the internal command buffer as raw byte buffer.
         inline const GLVirtualCommandBuffer& GetVirtualCommandBuffer() const
         {
@@ -268,6 +280,12 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
         void BindSampler(const GLSampler& samplerGL, std::uint32_t slot);
         void BindGL2XSampler(const GL2XSampler& samplerGL2X, std::uint32_t slot);
 
+        /* Rewrites the recorded commands with the GL command optimizer */
+        void OptimizeCommandBuffer();
+
+        /* Merges consecutive indexed draw commands of the recorded commands into multi-draw commands */
+        void BatchDrawCommands();
+
         /* Allocates only an opcode for empty commands */
         void AllocOpcode(const GLOpcode opcode);
 
@@ -282,6 +300,8 @@ class GLDeferredCommandBuffer final : public GLCommandBuffer
 
         long                        flags_              = 0;
         GLVirtualCommandBuffer      buffer_;
+        GLIndirectArgumentBuffer    indirectBuffer_;    // Arguments of batched draw commands
+        GLStagingRingReservation    stagingReservation_;// Staging ring segments with the data of buffer updates
 
         #ifdef LLGL_ENABLE_JIT_COMPILER
         std::unique_ptr<JITProgram> executable_;
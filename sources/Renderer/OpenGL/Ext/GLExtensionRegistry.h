@@ -40,10 +40,12 @@ enum class GLExt
     ARB_instanced_arrays,               // GL 2.1
     ARB_internalformat_query,
     ARB_internalformat_query2,
+    ARB_map_buffer_range,               // GL 3.0
     ARB_multitexture,
     ARB_multi_bind,                     // GL 4.3
     ARB_multi_draw_indirect,
     ARB_occlusion_query,
+    ARB_parallel_shader_compile,
     ARB_pipeline_statistics_query,
     ARB_polygon_offset_clamp,
     ARB_program_interface_query,        // GL 4.2
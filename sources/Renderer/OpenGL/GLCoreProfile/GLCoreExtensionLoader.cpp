@@ -225,6 +225,7 @@ static bool Load_GL_ARB_draw_elements_base_vertex(bool usePlaceholder)
 {
     LOAD_GLPROC( glDrawElementsBaseVertex          );
     LOAD_GLPROC( glDrawElementsInstancedBaseVertex );
+    LOAD_GLPROC( glMultiDrawElementsBaseVertex     );
     return true;
 }
 
@@ -638,6 +639,13 @@ static bool Load_GL_ARB_buffer_storage(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_ARB_map_buffer_range(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMapBufferRange         );
+    LOAD_GLPROC( glFlushMappedBufferRange );
+    return true;
+}
+
 static bool Load_GL_ARB_copy_buffer(bool usePlaceholder)
 {
     LOAD_GLPROC( glCopyBufferSubData );
@@ -656,6 +664,12 @@ static bool Load_GL_ARB_polygon_offset_clamp(bool usePlaceholder)
     return true;
 }
 
+static bool Load_GL_ARB_parallel_shader_compile(bool usePlaceholder)
+{
+    LOAD_GLPROC( glMaxShaderCompilerThreadsARB );
+    return true;
+}
+
 static bool Load_GL_ARB_shader_image_load_store(bool usePlaceholder)
 {
     LOAD_GLPROC( glBindImageTexture );
@@ -878,6 +892,7 @@ static void IncludeDefaultCoreProfileExtensions(GLExtensionList& extensions)
         "GL_EXT_copy_texture",
         "GL_EXT_blend_func_separate",   // GL 2.0
         "GL_EXT_stencil_two_side",      // GL 2.0
+        "GL_ARB_map_buffer_range",      // GL 3.0
     };
     for (const auto& ext : coreProfileDefaultExtenions)
         extensions[ext] = false;
@@ -964,6 +979,7 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     ENABLE_GLEXT( EXT_transform_feedback           );
     ENABLE_GLEXT( ARB_sync                         );
     ENABLE_GLEXT( ARB_polygon_offset_clamp         );
+    ENABLE_GLEXT( ARB_map_buffer_range             );
     ENABLE_GLEXT( ARB_copy_buffer                  );
     ENABLE_GLEXT( ARB_draw_indirect                );
     ENABLE_GLEXT( ARB_multi_draw_indirect          );
@@ -1091,9 +1107,11 @@ void LoadAllExtensions(GLExtensionList& extensions, bool coreProfile)
     LOAD_GLEXT( ARB_texture_storage              );
     LOAD_GLEXT( ARB_texture_storage_multisample  );
     LOAD_GLEXT( ARB_buffer_storage               );
+    LOAD_GLEXT( ARB_map_buffer_range             );
     LOAD_GLEXT( ARB_copy_buffer                  );
     LOAD_GLEXT( ARB_copy_image                   );
     LOAD_GLEXT( ARB_polygon_offset_clamp         );
+    LOAD_GLEXT( ARB_parallel_shader_compile      );
     LOAD_GLEXT( ARB_shader_image_load_store      );
     LOAD_GLEXT( ARB_framebuffer_no_attachments   );
     LOAD_GLEXT( ARB_clear_buffer_object          );
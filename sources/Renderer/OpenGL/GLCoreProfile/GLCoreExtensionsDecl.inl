@@ -247,6 +247,7 @@ DECL_GLPROC(PFNGLDRAWELEMENTSINSTANCEDPROC,                         glDrawElemen
 
 DECL_GLPROC(PFNGLDRAWELEMENTSBASEVERTEXPROC,                        glDrawElementsBaseVertex,                       void,           (GLenum, GLsizei, GLenum, const void*, GLint));
 DECL_GLPROC(PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC,               glDrawElementsInstancedBaseVertex,              void,           (GLenum, GLsizei, GLenum, const void*, GLsizei, GLint));
+DECL_GLPROC(PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC,                   glMultiDrawElementsBaseVertex,                  void,           (GLenum, const GLsizei*, GLenum, const void* const*, GLsizei, const GLint*));
 
 /* GL_ARB_base_instance */
 
@@ -480,6 +481,11 @@ DECL_GLPROC(PFNGLTEXSTORAGE3DMULTISAMPLEPROC,                       glTexStorage
 
 DECL_GLPROC(PFNGLBUFFERSTORAGEPROC,                                 glBufferStorage,                                void,           (GLenum, GLsizeiptr, const void*, GLbitfield));
 
+/* GL_ARB_map_buffer_range */
+
+DECL_GLPROC(PFNGLMAPBUFFERRANGEPROC,                                glMapBufferRange,                               void*,          (GLenum, GLintptr, GLsizeiptr, GLbitfield));
+DECL_GLPROC(PFNGLFLUSHMAPPEDBUFFERRANGEPROC,                        glFlushMappedBufferRange,                       void,           (GLenum, GLintptr, GLsizeiptr));
+
 /* GL_ARB_copy_buffer */
 
 DECL_GLPROC(PFNGLCOPYBUFFERSUBDATAPROC,                             glCopyBufferSubData,                            void,           (GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr));
@@ -492,6 +498,10 @@ DECL_GLPROC(PFNGLCOPYIMAGESUBDATAPROC,                              glCopyImageS
 
 DECL_GLPROC(PFNGLPOLYGONOFFSETCLAMPPROC,                            glPolygonOffsetClamp,                           void,           (GLfloat, GLfloat, GLfloat));
 
+/* GL_ARB_parallel_shader_compile */
+
+DECL_GLPROC(PFNGLMAXSHADERCOMPILERTHREADSARBPROC,                   glMaxShaderCompilerThreadsARB,                  void,           (GLuint));
+
 /* GL_ARB_shader_image_load_store */
 
 DECL_GLPROC(PFNGLBINDIMAGETEXTUREPROC,                              glBindImageTexture,                             void,           (GLuint, GLuint, GLint, GLboolean, GLint, GLenum, GLenum));
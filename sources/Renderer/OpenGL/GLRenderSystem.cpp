@@ -17,6 +17,7 @@
 #include "GLCore.h"
 #include "Buffer/GLBufferWithVAO.h"
 #include "Buffer/GLBufferArrayWithVAO.h"
+#include "Buffer/GLStagingRingBuffer.h"
 #include "../CheckedCast.h"
 #include "../BufferUtils.h"
 #include "../TextureUtils.h"
@@ -27,6 +28,7 @@
 #include "Command/GLDeferredCommandBuffer.h"
 #include "RenderState/GLGraphicsPSO.h"
 #include "RenderState/GLComputePSO.h"
+#include "GLSerialization.h"
 
 
 namespace LLGL
@@ -58,6 +60,7 @@ GLRenderSystem::~GLRenderSystem()
     /* Clear all render state containers first, the rest will be deleted automatically */
     GLTextureViewPool::Get().Clear();
     GLMipGenerator::Get().Clear();
+    GLStagingRingBuffer::Get().Clear();
     GLStatePool::Get().Clear();
 }
 
@@ -115,7 +118,7 @@ void GLRenderSystem::Release(CommandBuffer& commandBuffer)
 
 /* ----- Buffers ------ */
 
-static GLbitfield GetGLBufferStorageFlags(long cpuAccessFlags)
+static GLbitfield GetGLBufferStorageFlags(const BufferDescriptor& desc)
 {
     #ifdef GL_ARB_buffer_storage
 
@@ -124,11 +127,15 @@ static GLbitfield GetGLBufferStorageFlags(long cpuAccessFlags)
     /* Allways enable dynamic storage, to enable usage of 'glBufferSubData' */
     flagsGL |= GL_DYNAMIC_STORAGE_BIT;
 
-    if ((cpuAccessFlags & CPUAccessFlags::Read) != 0)
+    if ((desc.cpuAccessFlags & CPUAccessFlags::Read) != 0)
         flagsGL |= GL_MAP_READ_BIT;
-    if ((cpuAccessFlags & CPUAccessFlags::Write) != 0)
+    if ((desc.cpuAccessFlags & CPUAccessFlags::Write) != 0)
         flagsGL |= GL_MAP_WRITE_BIT;
 
+    /* Prefer client memory for readback buffers, since they are only written by pixel pack operations and read by the CPU */
+    if (IsReadbackBuffer(desc))
+        flagsGL |= GL_CLIENT_STORAGE_BIT;
+
     return flagsGL;
 
     #else
@@ -138,9 +145,11 @@ static GLbitfield GetGLBufferStorageFlags(long cpuAccessFlags)
     #endif // /GL_ARB_buffer_storage
 }
 
-static GLenum GetGLBufferUsage(long miscFlags)
+static GLenum GetGLBufferUsage(const BufferDescriptor& desc)
 {
-    return ((miscFlags & MiscFlags::DynamicUsage) != 0 ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    if (IsReadbackBuffer(desc))
+        return GL_STREAM_READ;
+    return ((desc.miscFlags & MiscFlags::DynamicUsage) != 0 ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
 }
 
 static void GLBufferStorage(GLBuffer& bufferGL, const BufferDescriptor& desc, const void* initialData)
@@ -148,8 +157,8 @@ static void GLBufferStorage(GLBuffer& bufferGL, const BufferDescriptor& desc, co
     bufferGL.BufferStorage(
         static_cast<GLsizeiptr>(desc.size),
         initialData,
-        GetGLBufferStorageFlags(desc.cpuAccessFlags),
-        GetGLBufferUsage(desc.miscFlags)
+        GetGLBufferStorageFlags(desc),
+        GetGLBufferUsage(desc)
     );
 }
 
@@ -414,13 +423,13 @@ Shader* GLRenderSystem::CreateShader(const ShaderDescriptor& desc)
     }
 
     /* Make and return shader object */
-    return TakeOwnership(shaders_, MakeUnique<GLShader>(desc));
+    return TakeOwnership(shaders_, MakeUnique<GLShader>(desc, &programBinaryCache_));
 }
 
 ShaderProgram* GLRenderSystem::CreateShaderProgram(const ShaderProgramDescriptor& desc)
 {
     AssertCreateShaderProgram(desc);
-    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>(desc));
+    return TakeOwnership(shaderPrograms_, MakeUnique<GLShaderProgram>(desc, &programBinaryCache_));
 }
 
 void GLRenderSystem::Release(Shader& shader)
@@ -447,19 +456,28 @@ void GLRenderSystem::Release(PipelineLayout& pipelineLayout)
 
 /* ----- Pipeline States ----- */
 
-PipelineState* GLRenderSystem::CreatePipelineState(const Blob& /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
-    return nullptr;//TODO
+    /* Store program binary for subsequently created shader programs; a GL PSO cannot be restored without its descriptor */
+    Serialization::Deserializer reader{ serializedCache };
+    programBinaryCache_.ReadProgramBinary(reader);
+    return nullptr;
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<GLGraphicsPSO>(desc, GetRenderingCaps().limits));
+    auto pipelineState = TakeOwnership(pipelineStates_, MakeUnique<GLGraphicsPSO>(desc, GetRenderingCaps().limits));
+    if (serializedCache != nullptr)
+        *serializedCache = SerializeProgramBinary(desc.shaderProgram);
+    return pipelineState;
 }
 
-PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* GLRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<GLComputePSO>(desc));
+    auto pipelineState = TakeOwnership(pipelineStates_, MakeUnique<GLComputePSO>(desc));
+    if (serializedCache != nullptr)
+        *serializedCache = SerializeProgramBinary(desc.shaderProgram);
+    return pipelineState;
 }
 
 void GLRenderSystem::Release(PipelineState& pipelineState)
@@ -522,7 +540,14 @@ void GLRenderSystem::CreateGLContextDependentDevices(GLStateManager& stateManage
 
     /* Query renderer information and limits */
     QueryRendererInfo();
+    programBinaryCache_.Reset(GetRendererInfo());
     QueryRenderingCaps();
+
+    #ifdef GL_ARB_parallel_shader_compile
+    /* Let the driver compile shaders concurrently with as many threads as it supports */
+    if (HasExtension(GLExt::ARB_parallel_shader_compile))
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+    #endif
 }
 
 #ifdef GL_KHR_debug
@@ -593,6 +618,18 @@ void GLRenderSystem::QueryRenderingCaps()
     SetRenderingCaps(caps);
 }
 
+std::unique_ptr<Blob> GLRenderSystem::SerializeProgramBinary(const ShaderProgram* shaderProgram)
+{
+    if (shaderProgram != nullptr)
+    {
+        auto shaderProgramGL = LLGL_CAST(const GLShaderProgram*, shaderProgram);
+        Serialization::Serializer writer;
+        if (programBinaryCache_.WriteProgramBinary(writer, *shaderProgramGL))
+            return writer.Finalize();
+    }
+    return nullptr;
+}
+
 
 } // /namespace LLGL
 
@@ -23,6 +23,7 @@
 
 #include "Shader/GLShader.h"
 #include "Shader/GLShaderProgram.h"
+#include "Shader/GLProgramBinaryCache.h"
 
 #include "Texture/GLTexture.h"
 #include "Texture/GLSampler.h"
@@ -171,6 +172,9 @@ class GLRenderSystem final : public RenderSystem
 
         void ValidateGLTextureType(const TextureType type);
 
+        // Returns the serialized program binary of the specified shader program, or null if program binaries are not supported.
+        std::unique_ptr<Blob> SerializeProgramBinary(const ShaderProgram* shaderProgram);
+
     private:
 
         /* ----- Hardware object containers ----- */
@@ -197,6 +201,8 @@ class GLRenderSystem final : public RenderSystem
         HWObjectContainer<GLQueryHeap>          queryHeaps_;
         HWObjectContainer<GLFence>              fences_;
 
+        GLProgramBinaryCache                    programBinaryCache_;
+
         DebugCallback                           debugCallback_;
 
 };
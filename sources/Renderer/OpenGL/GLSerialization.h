@@ -0,0 +1,56 @@
+/*
+ * GLSerialization.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_SERIALIZATION_H
+#define LLGL_GL_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include <LLGL/RenderSystemFlags.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for OpenGL serialization.
+enum GLIdent : IdentType
+{
+    GLIdent_ReservedGL = (RendererID::OpenGL << 8),
+    GLIdent_ProgramBinaryHeader,    // GLProgramBinaryHeader
+    GLIdent_ProgramBinaryData,      // Data from glGetProgramBinary
+};
+
+
+/* ----- Structures ----- */
+
+// Identifies the driver, shader program, and binary format a serialized program binary was created with.
+struct GLProgramBinaryHeader
+{
+    std::uint64_t driverHash;
+    std::uint64_t programKey;
+    std::uint64_t shaderHashes[6];  // Source hashes of the vertex, tess-control, tess-evaluation, geometry, fragment, and compute shader (zero if unused)
+    std::uint32_t binaryFormat;
+};
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -74,6 +74,7 @@ LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawElementsInstancedBaseVertexBaseInstance )
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDrawElementsIndirect );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawArraysIndirect );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawElementsIndirect );
+LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdMultiDrawElementsBaseVertex );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDispatchCompute );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdDispatchComputeIndirect );
 LLGL_ASSERT_STDLAYOUT_STRUCT( GLCmdBindTexture );
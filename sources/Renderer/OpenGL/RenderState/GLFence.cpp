@@ -55,6 +55,10 @@ bool GLFence::Wait(GLuint64 timeout)
 {
     if (HasExtension(GLExt::ARB_sync))
     {
+        /* Fence has never been submitted */
+        if (!sync_)
+            return false;
+
         GLenum result = glClientWaitSync(sync_, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
         return (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED);
     }
@@ -0,0 +1,164 @@
+/*
+ * GLProgramBinaryCache.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "GLProgramBinaryCache.h"
+#include "GLShader.h"
+#include "GLShaderProgram.h"
+#include "../GLSerialization.h"
+#include "../Ext/GLExtensions.h"
+#include "../Ext/GLExtensionRegistry.h"
+#include "../../CheckedCast.h"
+#include "../../../Core/Helper.h"
+#include <LLGL/RenderSystemFlags.h>
+#include <LLGL/ShaderProgramFlags.h>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+static std::uint64_t HashString(const std::string& s, std::uint64_t hash)
+{
+    /* Include null terminator to separate consecutive strings */
+    return HashFNV1a(s.c_str(), s.size() + 1, hash);
+}
+
+static std::uint64_t GetShaderHash(const Shader* shader)
+{
+    if (shader != nullptr)
+        return LLGL_CAST(const GLShader*, shader)->GetSourceHash();
+    else
+        return 0;
+}
+
+void GLProgramBinaryCache::Reset(const RendererInfo& info)
+{
+    /* Identify driver by its vendor, renderer, and version strings */
+    driverHash_ = HashFNV1a(info.vendorName.c_str(), info.vendorName.size() + 1);
+    driverHash_ = HashString(info.deviceName, driverHash_);
+    driverHash_ = HashString(info.rendererName, driverHash_);
+    binaries_.clear();
+    shaderHashes_.clear();
+
+    /* Program binaries can only be used if the driver supports at least one binary format */
+    supported_ = false;
+    #ifdef GL_ARB_get_program_binary
+    if (HasExtension(GLExt::ARB_get_program_binary))
+    {
+        GLint numFormats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+        supported_ = (numFormats > 0);
+    }
+    #endif
+}
+
+void GLProgramBinaryCache::GetShaderHashes(const ShaderProgramDescriptor& desc, std::uint64_t* shaderHashes)
+{
+    shaderHashes[0] = GetShaderHash(desc.vertexShader);
+    shaderHashes[1] = GetShaderHash(desc.tessControlShader);
+    shaderHashes[2] = GetShaderHash(desc.tessEvaluationShader);
+    shaderHashes[3] = GetShaderHash(desc.geometryShader);
+    shaderHashes[4] = GetShaderHash(desc.fragmentShader);
+    shaderHashes[5] = GetShaderHash(desc.computeShader);
+}
+
+std::uint64_t GLProgramBinaryCache::GetProgramKey(const std::uint64_t* shaderHashes) const
+{
+    return HashFNV1a(shaderHashes, sizeof(std::uint64_t) * g_numProgramShaderHashes, driverHash_);
+}
+
+bool GLProgramBinaryCache::ContainsShader(std::uint64_t sourceHash) const
+{
+    return (shaderHashes_.find(sourceHash) != shaderHashes_.end());
+}
+
+bool GLProgramBinaryCache::LoadProgramBinary(GLuint program, std::uint64_t programKey) const
+{
+    #ifdef GL_ARB_get_program_binary
+    if (supported_)
+    {
+        auto it = binaries_.find(programKey);
+        if (it != binaries_.end())
+        {
+            /* Load binary; the driver may reject it after a driver update even if the version strings have not changed */
+            const auto& binary = it->second;
+            glProgramBinary(program, binary.format, binary.data.data(), static_cast<GLsizei>(binary.data.size()));
+
+            GLint status = 0;
+            glGetProgramiv(program, GL_LINK_STATUS, &status);
+            return (status != GL_FALSE);
+        }
+    }
+    #endif
+    return false;
+}
+
+bool GLProgramBinaryCache::WriteProgramBinary(Serialization::Serializer& writer, const GLShaderProgram& shaderProgram) const
+{
+    #ifdef GL_ARB_get_program_binary
+    if (supported_ && !shaderProgram.HasErrors())
+    {
+        /* Query program binary */
+        GLint binaryLength = 0;
+        glGetProgramiv(shaderProgram.GetID(), GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+        if (binaryLength <= 0)
+            return false;
+
+        std::vector<std::int8_t> data(static_cast<std::size_t>(binaryLength));
+        GLenum format = 0;
+        glGetProgramBinary(shaderProgram.GetID(), binaryLength, &binaryLength, &format, data.data());
+
+        /* Write header and data segments */
+        Serialization::GLProgramBinaryHeader header;
+        {
+            header.driverHash   = driverHash_;
+            header.programKey   = shaderProgram.GetProgramKey();
+            ::memcpy(header.shaderHashes, shaderProgram.GetShaderHashes(), sizeof(header.shaderHashes));
+            header.binaryFormat = static_cast<std::uint32_t>(format);
+        }
+        writer.WriteSegment(Serialization::GLIdent_ProgramBinaryHeader, &header, sizeof(header));
+        writer.WriteSegment(Serialization::GLIdent_ProgramBinaryData, data.data(), static_cast<std::size_t>(binaryLength));
+
+        return true;
+    }
+    #endif
+    return false;
+}
+
+bool GLProgramBinaryCache::ReadProgramBinary(Serialization::Deserializer& reader)
+{
+    /* Read and validate header segment */
+    Serialization::GLProgramBinaryHeader header;
+    reader.ReadSegment(Serialization::GLIdent_ProgramBinaryHeader, &header, sizeof(header));
+
+    if (!supported_ || header.driverHash != driverHash_)
+        return false;
+
+    /* Store binary data for subsequently created shader programs */
+    auto seg = reader.ReadSegment(Serialization::GLIdent_ProgramBinaryData);
+
+    auto& binary = binaries_[header.programKey];
+    binary.format = static_cast<GLenum>(header.binaryFormat);
+    binary.data.assign(seg.data, seg.data + seg.size);
+
+    /* Remember the shaders of this program, so they are not compiled before they are needed */
+    for (auto sourceHash : header.shaderHashes)
+    {
+        if (sourceHash != 0)
+            shaderHashes_.insert(sourceHash);
+    }
+
+    return true;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
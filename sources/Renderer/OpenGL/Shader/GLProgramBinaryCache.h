@@ -0,0 +1,99 @@
+/*
+ * GLProgramBinaryCache.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_GL_PROGRAM_BINARY_CACHE_H
+#define LLGL_GL_PROGRAM_BINARY_CACHE_H
+
+
+#include "../OpenGL.h"
+#include "../../Serialization.h"
+#include <cstdint>
+#include <map>
+#include <set>
+#include <vector>
+
+
+namespace LLGL
+{
+
+
+struct RendererInfo;
+struct ShaderProgramDescriptor;
+class GLShaderProgram;
+
+// Number of shader source hashes that identify a program binary, one for each shader stage.
+static const std::size_t g_numProgramShaderHashes = 6;
+
+/*
+Stores native program binaries (GL_ARB_get_program_binary) that have been restored from serialized pipeline caches.
+Each binary is keyed by a hash of the patched shader sources and the driver identity (vendor, renderer, and version strings),
+so binaries from a different driver never match and shader programs are linked from source as usual.
+*/
+class GLProgramBinaryCache
+{
+
+    public:
+
+        // Resets the driver identity and removes all binaries. Must be called with an active GL context.
+        void Reset(const RendererInfo& info);
+
+        // Returns true if program binaries can be retrieved and loaded with the current driver.
+        inline bool IsSupported() const
+        {
+            return supported_;
+        }
+
+        // Returns the source hashes of all shaders of the specified shader program, in the same order as GLProgramBinaryHeader::shaderHashes.
+        static void GetShaderHashes(const ShaderProgramDescriptor& desc, std::uint64_t* shaderHashes);
+
+        // Returns the key that is used to look up the binary of a shader program with the specified shader source hashes.
+        std::uint64_t GetProgramKey(const std::uint64_t* shaderHashes) const;
+
+        /*
+        Returns true if any cached program binary has been linked from a shader with the specified source hash.
+        Such a shader does not have to be compiled unless its program fails to load from the cache.
+        */
+        bool ContainsShader(std::uint64_t sourceHash) const;
+
+        /*
+        Loads the cached binary with the specified key into the program and returns true if the program was linked successfully.
+        Returns false if there is no such binary or the driver rejected it, in which case the program must be linked from its shaders.
+        */
+        bool LoadProgramBinary(GLuint program, std::uint64_t programKey) const;
+
+        // Writes the native binary of the specified shader program as serialized segments. Returns false if the binary is not available.
+        bool WriteProgramBinary(Serialization::Serializer& writer, const GLShaderProgram& shaderProgram) const;
+
+        // Reads a serialized program binary and stores it in this cache. Returns false if the binary was created with a different driver.
+        bool ReadProgramBinary(Serialization::Deserializer& reader);
+
+    private:
+
+        struct ProgramBinary
+        {
+            GLenum                      format  = 0;
+            std::vector<std::int8_t>    data;
+        };
+
+    private:
+
+        bool                                        supported_  = false;
+        std::uint64_t                               driverHash_ = 0;
+        std::map<std::uint64_t, ProgramBinary>      binaries_;
+        std::set<std::uint64_t>                     shaderHashes_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -7,6 +7,7 @@
 
 #include "GLShader.h"
 #include "GLShaderSourcePatcher.h"
+#include "GLProgramBinaryCache.h"
 #include "../GLObjectUtils.h"
 #include "../Ext/GLExtensions.h"
 #include "../Ext/GLExtensionRegistry.h"
@@ -17,13 +18,14 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <cstring>
 
 
 namespace LLGL
 {
 
 
-GLShader::GLShader(const ShaderDescriptor& desc) :
+GLShader::GLShader(const ShaderDescriptor& desc, const GLProgramBinaryCache* binaryCache) :
     Shader { desc.type }
 {
     /* Create shader and  */
@@ -33,6 +35,14 @@ GLShader::GLShader(const ShaderDescriptor& desc) :
     BuildVertexInputLayout(desc.vertex.inputAttribs.size(), desc.vertex.inputAttribs.data());
     BuildTransformFeedbackVaryings(desc.vertex.outputAttribs.size(), desc.vertex.outputAttribs.data());
     BuildFragmentOutputLayout(desc.fragment.outputAttribs.size(), desc.fragment.outputAttribs.data());
+    HashAttribs();
+
+    /*
+    Start compilation right away unless a cached program binary was linked from this shader.
+    Only the compile status is queried on demand, so the driver can compile multiple shaders concurrently.
+    */
+    if (binaryCache == nullptr || !binaryCache->IsSupported() || !binaryCache->ContainsShader(sourceHash_))
+        CompilePendingSource();
 }
 
 GLShader::~GLShader()
@@ -47,14 +57,26 @@ void GLShader::SetName(const char* name)
 
 bool GLShader::HasErrors() const
 {
+    CompilePendingSource();
     return !GLShader::GetCompileStatus(id_);
 }
 
 std::string GLShader::GetReport() const
 {
+    CompilePendingSource();
     return GLShader::GetGLShaderLog(id_);
 }
 
+void GLShader::CompilePendingSource() const
+{
+    if (compilePending_)
+    {
+        GLShader::CompileShaderSource(id_, pendingSource_.c_str());
+        compilePending_ = false;
+        std::string().swap(pendingSource_);
+    }
+}
+
 const GLShaderAttribute* GLShader::GetVertexAttribs() const
 {
     if (!shaderAttribs_.empty())
@@ -88,8 +110,7 @@ void GLShader::CompileShaderSource(GLuint shader, const char* source)
     glCompileShader(shader);
 }
 
-void GLShader::CompileShaderSourceWithOptions(
-    GLuint              shader,
+std::string GLShader::PatchShaderSource(
     const char*         source,
     const ShaderMacro*  defines,
     bool                pragmaOptimizeOff,
@@ -104,10 +125,10 @@ void GLShader::CompileShaderSourceWithOptions(
         if (pragmaOptimizeOff)
             patcher.AddPragmaDirective("optimize(off)");
         patcher.AddFinalVertexTransformStatements(vertexTransformStmt);
-        GLShader::CompileShaderSource(shader, patcher.GetSource());
+        return patcher.GetSource();
     }
     else
-        GLShader::CompileShaderSource(shader, source);
+        return source;
 }
 
 bool GLShader::GetCompileStatus(GLuint shader)
@@ -258,14 +279,17 @@ void GLShader::CompileSource(const ShaderDescriptor& shaderDesc)
     /* Add '#pragma optimize(off)'-directive to source if optimization is disabled */
     const bool pragmaOptimizeOff = ((shaderDesc.flags & ShaderCompileFlags::NoOptimization) != 0);
 
-    /* Get source code */
+    /* Get source code and keep the final source until it is compiled on demand */
     if (shaderDesc.sourceType == ShaderSourceType::CodeFile)
     {
         const std::string fileContent = ReadFileString(shaderDesc.source);
-        GLShader::CompileShaderSourceWithOptions(id_, fileContent.c_str(), shaderDesc.defines, pragmaOptimizeOff, vertexTransformStmt);
+        pendingSource_ = GLShader::PatchShaderSource(fileContent.c_str(), shaderDesc.defines, pragmaOptimizeOff, vertexTransformStmt);
     }
     else
-        GLShader::CompileShaderSourceWithOptions(id_, shaderDesc.source, shaderDesc.defines, pragmaOptimizeOff, vertexTransformStmt);
+        pendingSource_ = GLShader::PatchShaderSource(shaderDesc.source, shaderDesc.defines, pragmaOptimizeOff, vertexTransformStmt);
+
+    sourceHash_     = HashFNV1a(pendingSource_.data(), pendingSource_.size());
+    compilePending_ = true;
 }
 
 void GLShader::LoadBinary(const ShaderDescriptor& shaderDesc)
@@ -298,6 +322,9 @@ void GLShader::LoadBinary(const ShaderDescriptor& shaderDesc)
         /* Specialize for the default "main" function in a SPIR-V module  */
         const char* entryPoint = (shaderDesc.entryPoint == nullptr || *shaderDesc.entryPoint == '\0' ? "main" : shaderDesc.entryPoint);
         glSpecializeShader(id_, entryPoint, 0, nullptr, nullptr);
+
+        sourceHash_ = HashFNV1a(binaryBuffer, static_cast<std::size_t>(binaryLength));
+        sourceHash_ = HashFNV1a(entryPoint, std::strlen(entryPoint) + 1, sourceHash_);
     }
     else
     #endif
@@ -306,6 +333,22 @@ void GLShader::LoadBinary(const ShaderDescriptor& shaderDesc)
     }
 }
 
+void GLShader::HashAttribs()
+{
+    /* Include shader type and all attributes, since their bindings are part of a linked program binary */
+    const auto type = GetType();
+    sourceHash_ = HashFNV1a(&type, sizeof(type), sourceHash_);
+
+    for (const auto& attr : shaderAttribs_)
+    {
+        sourceHash_ = HashFNV1a(&(attr.index), sizeof(attr.index), sourceHash_);
+        sourceHash_ = HashFNV1a(attr.name, std::strlen(attr.name) + 1, sourceHash_);
+    }
+
+    for (const auto& varying : transformFeedbackVaryings_)
+        sourceHash_ = HashFNV1a(varying, std::strlen(varying) + 1, sourceHash_);
+}
+
 
 } // /namespace LLGL
 
@@ -12,12 +12,16 @@
 #include <LLGL/Shader.h>
 #include "../OpenGL.h"
 #include "../../../Core/LinearStringContainer.h"
+#include <cstdint>
+#include <string>
 
 
 namespace LLGL
 {
 
 
+class GLProgramBinaryCache;
+
 struct GLShaderAttribute
 {
     GLuint          index;
@@ -40,9 +44,11 @@ class GLShader final : public Shader
         // Compiles a native GL shader from source.
         static void CompileShaderSource(GLuint shader, const char* source);
 
-        // Compiles a native GL shader from source and adds the specified macro definitions at the top of the source but after the '#version'-directive.
-        static void CompileShaderSourceWithOptions(
-            GLuint              shader,
+        /*
+        Returns the shader source with the specified macro definitions at the top of the source but after the '#version'-directive,
+        and with the other optional patches applied.
+        */
+        static std::string PatchShaderSource(
             const char*         source,
             const ShaderMacro*  defines,
             bool                pragmaOptimizeOff   = false,
@@ -57,7 +63,11 @@ class GLShader final : public Shader
 
     public:
 
-        GLShader(const ShaderDescriptor& desc);
+        /*
+        Creates the shader and starts compiling its source, unless the program binary cache contains a program with this shader.
+        In that case, the source is only compiled if the program cannot be restored from the cache.
+        */
+        GLShader(const ShaderDescriptor& desc, const GLProgramBinaryCache* binaryCache = nullptr);
         ~GLShader();
 
         // Returns the native shader ID.
@@ -66,6 +76,12 @@ class GLShader final : public Shader
             return id_;
         }
 
+        /*
+        Compiles the shader source if that has not been done yet. Shaders that are part of a cached program binary are compiled lazily,
+        so that no compilation is necessary when their shader program is restored from the program binary cache.
+        */
+        void CompilePendingSource() const;
+
         // Returns the vertex input attributes:
         const GLShaderAttribute* GetVertexAttribs() const;
         std::size_t GetNumVertexAttribs() const;
@@ -80,6 +96,12 @@ class GLShader final : public Shader
             return transformFeedbackVaryings_;
         }
 
+        // Returns the hash of the patched source (or binary), the shader type, and the attribute bindings.
+        inline std::uint64_t GetSourceHash() const
+        {
+            return sourceHash_;
+        }
+
     private:
 
         void BuildShader(const ShaderDescriptor& shaderDesc);
@@ -91,9 +113,15 @@ class GLShader final : public Shader
         void CompileSource(const ShaderDescriptor& shaderDesc);
         void LoadBinary(const ShaderDescriptor& shaderDesc);
 
+        void HashAttribs();
+
     private:
 
         GLuint                          id_                         = 0;
+        std::uint64_t                   sourceHash_                 = 0;
+
+        mutable std::string             pendingSource_;
+        mutable bool                    compilePending_             = false;
 
         LinearStringContainer           shaderAttribNames_;
         std::vector<GLShaderAttribute>  shaderAttribs_;
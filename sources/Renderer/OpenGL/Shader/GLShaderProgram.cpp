@@ -8,6 +8,7 @@
 #include "GLShaderProgram.h"
 #include "GLShader.h"
 #include "GLShaderBindingLayout.h"
+#include "GLProgramBinaryCache.h"
 #include "../GLTypes.h"
 #include "../GLObjectUtils.h"
 #include "../RenderState/GLStateManager.h"
@@ -79,7 +80,7 @@ static SharedGLShader g_nullFragmentShader;
 
 #endif // /__APPLE__
 
-GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc) :
+GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc, const GLProgramBinaryCache* binaryCache) :
     id_ { glCreateProgram() }
 {
     /* Attach all specified shaders to this shader program */
@@ -107,43 +108,16 @@ GLShaderProgram::GLShaderProgram(const ShaderProgramDescriptor& desc) :
     }
     #endif
 
-    /* Build input layout for vertex shader */
-    if (auto vs = desc.vertexShader)
-    {
-        auto vsGL = LLGL_CAST(GLShader*, vs);
-        BindAttribLocations(vsGL->GetNumVertexAttribs(), vsGL->GetVertexAttribs());
-    }
-
-    /* Build output layout for fragment shader */
-    if (auto fs = desc.fragmentShader)
-    {
-        auto fsGL = LLGL_CAST(GLShader*, fs);
-        BindFragDataLocations(fsGL->GetNumFragmentAttribs(), fsGL->GetFragmentAttribs());
-    }
-
-    /* Build transform feedback varyings for vertex or geometry shader (latter one has higher order) */
-    GLShader* shaderWithVaryings = nullptr;
-
-    if (auto gs = desc.geometryShader)
-    {
-        auto gsGL = LLGL_CAST(GLShader*, gs);
-        if (!gsGL->GetTransformFeedbackVaryings().empty())
-            shaderWithVaryings = gsGL;
-    }
-    else if (auto vs = desc.vertexShader)
+    /* Try to restore program from cached binary, otherwise fall back to compiling and linking the shaders */
+    if (binaryCache != nullptr && binaryCache->IsSupported())
     {
-        auto vsGL = LLGL_CAST(GLShader*, vs);
-        if (!vsGL->GetTransformFeedbackVaryings().empty())
-            shaderWithVaryings = vsGL;
-    }
-
-    if (shaderWithVaryings != nullptr)
-    {
-        const auto& varyings = shaderWithVaryings->GetTransformFeedbackVaryings();
-        LinkProgram(varyings.size(), varyings.data());
+        GLProgramBinaryCache::GetShaderHashes(desc, shaderHashes_);
+        programKey_ = binaryCache->GetProgramKey(shaderHashes_);
+        if (!binaryCache->LoadProgramBinary(id_, programKey_))
+            BuildProgram(desc, true);
     }
     else
-        LinkProgram(0, nullptr);
+        BuildProgram(desc, false);
 }
 
 GLShaderProgram::~GLShaderProgram()
@@ -237,6 +211,70 @@ void GLShaderProgram::AttachShader(Shader* shader)
     }
 }
 
+void GLShaderProgram::CompilePendingShader(Shader* shader)
+{
+    if (shader != nullptr)
+    {
+        auto shaderGL = LLGL_CAST(GLShader*, shader);
+        shaderGL->CompilePendingSource();
+    }
+}
+
+void GLShaderProgram::BuildProgram(const ShaderProgramDescriptor& desc, bool binaryRetrievable)
+{
+    /* Compile all shaders that have not been compiled yet */
+    CompilePendingShader(desc.vertexShader);
+    CompilePendingShader(desc.tessControlShader);
+    CompilePendingShader(desc.tessEvaluationShader);
+    CompilePendingShader(desc.geometryShader);
+    CompilePendingShader(desc.fragmentShader);
+    CompilePendingShader(desc.computeShader);
+
+    #ifdef GL_ARB_get_program_binary
+    /* Hint the driver to keep the binary available after linking, so it can be serialized */
+    if (binaryRetrievable)
+        glProgramParameteri(id_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    #endif
+
+    /* Build input layout for vertex shader */
+    if (auto vs = desc.vertexShader)
+    {
+        auto vsGL = LLGL_CAST(GLShader*, vs);
+        BindAttribLocations(vsGL->GetNumVertexAttribs(), vsGL->GetVertexAttribs());
+    }
+
+    /* Build output layout for fragment shader */
+    if (auto fs = desc.fragmentShader)
+    {
+        auto fsGL = LLGL_CAST(GLShader*, fs);
+        BindFragDataLocations(fsGL->GetNumFragmentAttribs(), fsGL->GetFragmentAttribs());
+    }
+
+    /* Build transform feedback varyings for vertex or geometry shader (latter one has higher order) */
+    GLShader* shaderWithVaryings = nullptr;
+
+    if (auto gs = desc.geometryShader)
+    {
+        auto gsGL = LLGL_CAST(GLShader*, gs);
+        if (!gsGL->GetTransformFeedbackVaryings().empty())
+            shaderWithVaryings = gsGL;
+    }
+    else if (auto vs = desc.vertexShader)
+    {
+        auto vsGL = LLGL_CAST(GLShader*, vs);
+        if (!vsGL->GetTransformFeedbackVaryings().empty())
+            shaderWithVaryings = vsGL;
+    }
+
+    if (shaderWithVaryings != nullptr)
+    {
+        const auto& varyings = shaderWithVaryings->GetTransformFeedbackVaryings();
+        LinkProgram(varyings.size(), varyings.data());
+    }
+    else
+        LinkProgram(0, nullptr);
+}
+
 void GLShaderProgram::BindAttribLocations(std::size_t numVertexAttribs, const GLShaderAttribute* vertexAttribs)
 {
     /* Bind all vertex attribute locations */
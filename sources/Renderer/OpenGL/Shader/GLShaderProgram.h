@@ -11,7 +11,9 @@
 
 #include <LLGL/ShaderProgram.h>
 #include "GLShaderUniform.h"
+#include "GLProgramBinaryCache.h"
 #include "../OpenGL.h"
+#include <cstdint>
 
 
 namespace LLGL
@@ -36,7 +38,11 @@ class GLShaderProgram final : public ShaderProgram
 
     public:
 
-        GLShaderProgram(const ShaderProgramDescriptor& desc);
+        /*
+        Creates the shader program from the cached program binary if the cache has one that matches the specified shaders.
+        Otherwise, the program is linked from its shaders and marked as retrievable, so its binary can be serialized.
+        */
+        GLShaderProgram(const ShaderProgramDescriptor& desc, const GLProgramBinaryCache* binaryCache = nullptr);
         ~GLShaderProgram();
 
         /*
@@ -51,9 +57,23 @@ class GLShaderProgram final : public ShaderProgram
             return id_;
         }
 
+        // Returns the key to look up this shader program in the program binary cache, or zero if there is no cache.
+        inline std::uint64_t GetProgramKey() const
+        {
+            return programKey_;
+        }
+
+        // Returns the source hashes of the shaders this program was linked from, or zeros if there is no cache.
+        inline const std::uint64_t* GetShaderHashes() const
+        {
+            return shaderHashes_;
+        }
+
     private:
 
         void AttachShader(Shader* shader);
+        void CompilePendingShader(Shader* shader);
+        void BuildProgram(const ShaderProgramDescriptor& desc, bool binaryRetrievable);
         void BindAttribLocations(std::size_t numVertexAttribs, const GLShaderAttribute* vertexAttribs);
         void BindFragDataLocations(std::size_t numFragmentAttribs, const GLShaderAttribute* fragmentAttribs);
         void LinkProgram(std::size_t numVaryings, const char* const* varyings);
@@ -85,10 +105,12 @@ class GLShaderProgram final : public ShaderProgram
 
     private:
 
-        GLuint  id_                     = 0;
+        GLuint          id_                     = 0;
+        std::uint64_t   programKey_             = 0;
+        std::uint64_t   shaderHashes_[g_numProgramShaderHashes] = {};
 
         #ifdef __APPLE__
-        bool    hasNullFragmentShader_  = false;
+        bool            hasNullFragmentShader_  = false;
         #endif
 
     private:
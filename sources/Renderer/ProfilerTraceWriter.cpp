@@ -0,0 +1,158 @@
+/*
+ * ProfilerTraceWriter.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ProfilerTraceWriter.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+
+
+namespace LLGL
+{
+
+
+static std::uint64_t GetSteadyClockTime()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+// Writes the specified nanoseconds as microseconds with three decimal places, which is the time unit of the trace format.
+static void WriteMicroseconds(std::ostream& s, std::uint64_t nanoseconds)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%llu.%03u", static_cast<unsigned long long>(nanoseconds / 1000), static_cast<unsigned>(nanoseconds % 1000));
+    s << buf;
+}
+
+static void WriteEscapedString(std::ostream& s, const std::string& str)
+{
+    s << '\"';
+    for (char c : str)
+    {
+        switch (c)
+        {
+            case '\"':  s << "\\\"";    break;
+            case '\\':  s << "\\\\";    break;
+            case '\n':  s << "\\n";     break;
+            case '\t':  s << "\\t";     break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    s << buf;
+                }
+                else
+                    s << c;
+                break;
+        }
+    }
+    s << '\"';
+}
+
+ProfilerTraceWriter::ProfilerTraceWriter(const char* filename, std::size_t maxBufferedEvents) :
+    file_               { filename, std::ios::out | std::ios::binary },
+    origin_             { GetSteadyClockTime()                       },
+    maxBufferedEvents_  { std::max<std::size_t>(1, maxBufferedEvents)  }
+{
+    if (!file_.good())
+        throw std::runtime_error("failed to open trace file: " + std::string(filename));
+
+    events_.reserve(maxBufferedEvents_);
+
+    /* Write header and name of GPU timeline */
+    file_ << "{\"traceEvents\":[\n";
+    file_ << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << gpuThreadID << ",\"args\":{\"name\":\"GPU\"}}";
+}
+
+ProfilerTraceWriter::~ProfilerTraceWriter()
+{
+    Flush();
+    file_ << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+std::uint64_t ProfilerTraceWriter::Now() const
+{
+    return (GetSteadyClockTime() - origin_);
+}
+
+std::uint32_t ProfilerTraceWriter::GetCurrentThreadID()
+{
+    static std::atomic<std::uint32_t> g_threadCounter{ 0 };
+    thread_local std::uint32_t threadID = ++g_threadCounter;
+    return threadID;
+}
+
+void ProfilerTraceWriter::WriteEvent(ProfilerTraceEvent&& event)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    events_.emplace_back(std::move(event));
+    if (events_.size() >= maxBufferedEvents_)
+        FlushUnsynchronized();
+}
+
+void ProfilerTraceWriter::WriteCPUEvent(const char* name, const char* category, std::uint64_t startTime)
+{
+    ProfilerTraceEvent event;
+    {
+        event.name      = name;
+        event.category  = category;
+        event.timestamp = startTime;
+        event.duration  = Now() - startTime;
+        event.threadID  = GetCurrentThreadID();
+    }
+    WriteEvent(std::move(event));
+}
+
+std::uint64_t ProfilerTraceWriter::AllocGPURange(std::uint64_t earliestTime, std::uint64_t duration)
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    const auto startTime = std::max(earliestTime, gpuTimelineEnd_);
+    gpuTimelineEnd_ = startTime + duration;
+    return startTime;
+}
+
+void ProfilerTraceWriter::Flush()
+{
+    std::lock_guard<std::mutex> guard{ mutex_ };
+    FlushUnsynchronized();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ProfilerTraceWriter::FlushUnsynchronized()
+{
+    for (const auto& event : events_)
+        WriteEventJSON(event);
+    events_.clear();
+    file_.flush();
+}
+
+void ProfilerTraceWriter::WriteEventJSON(const ProfilerTraceEvent& event)
+{
+    /* Write complete event ("X") with begin time and duration; the header always contains a previous event */
+    file_ << ",\n{\"name\":";
+    WriteEscapedString(file_, event.name);
+    file_ << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"ts\":";
+    WriteMicroseconds(file_, event.timestamp);
+    file_ << ",\"dur\":";
+    WriteMicroseconds(file_, event.duration);
+    file_ << ",\"pid\":1,\"tid\":" << event.threadID << '}';
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
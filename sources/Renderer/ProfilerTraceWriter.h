@@ -0,0 +1,105 @@
+/*
+ * ProfilerTraceWriter.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_PROFILER_TRACE_WRITER_H
+#define LLGL_PROFILER_TRACE_WRITER_H
+
+
+#include <LLGL/ForwardDecls.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <mutex>
+
+
+namespace LLGL
+{
+
+
+// Trace event with a time range on a CPU thread or the GPU timeline.
+struct ProfilerTraceEvent
+{
+    std::string     name;
+    const char*     category    = "";
+    std::uint64_t   timestamp   = 0;    // Begin time (in nanoseconds) relative to the start of the trace capture.
+    std::uint64_t   duration    = 0;    // Duration (in nanoseconds).
+    std::uint32_t   threadID    = 0;    // Track ID; 0 is reserved for the GPU timeline.
+};
+
+/*
+Streams trace events to a file in the Chrome Trace Event Format (JSON),
+which can be opened with "chrome://tracing" or "ui.perfetto.dev".
+Events are buffered up to a maximum number and then written to the file, so the memory consumption is bounded for long captures.
+All functions are thread-safe.
+*/
+class ProfilerTraceWriter
+{
+
+    public:
+
+        // Track ID of the GPU timeline.
+        static const std::uint32_t gpuThreadID = 0;
+
+    public:
+
+        // Opens the trace file or throws std::runtime_error on failure.
+        ProfilerTraceWriter(const char* filename, std::size_t maxBufferedEvents);
+
+        // Writes all remaining events and closes the trace file.
+        ~ProfilerTraceWriter();
+
+        ProfilerTraceWriter(const ProfilerTraceWriter&) = delete;
+        ProfilerTraceWriter& operator = (const ProfilerTraceWriter&) = delete;
+
+        // Returns the current time (in nanoseconds) relative to the start of the trace capture.
+        std::uint64_t Now() const;
+
+        // Returns the track ID of the calling thread. IDs are assigned in the order threads first call this function, starting with 1.
+        static std::uint32_t GetCurrentThreadID();
+
+        // Adds the specified event and writes all buffered events to the file once the maximum number of buffered events has been reached.
+        void WriteEvent(ProfilerTraceEvent&& event);
+
+        // Adds an event for the calling thread that started at the specified time and ends now.
+        void WriteCPUEvent(const char* name, const char* category, std::uint64_t startTime);
+
+        /*
+        Reserves a range of the specified duration on the GPU timeline that does not start before 'earliestTime' and returns its begin time.
+        Consecutive ranges never overlap, since only elapsed times are known for GPU commands but not their actual begin timestamps.
+        */
+        std::uint64_t AllocGPURange(std::uint64_t earliestTime, std::uint64_t duration);
+
+        // Writes all buffered events to the file.
+        void Flush();
+
+    private:
+
+        void FlushUnsynchronized();
+        void WriteEventJSON(const ProfilerTraceEvent& event);
+
+    private:
+
+        std::ofstream                   file_;
+        std::uint64_t                   origin_             = 0;
+
+        std::mutex                      mutex_;
+        std::vector<ProfilerTraceEvent> events_;
+        std::size_t                     maxBufferedEvents_  = 0;
+        std::uint64_t                   gpuTimelineEnd_     = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -13,6 +13,7 @@
 #include <LLGL/StaticLimits.h>
 #include <LLGL/Log.h>
 #include "BuildID.h"
+#include "ShaderPermutationBuilder.h"
 
 #include <LLGL/RenderSystem.h>
 #include <array>
@@ -68,6 +69,8 @@ std::vector<std::string> RenderSystem::FindModules()
         "Direct3D11",
         "Direct3D12",
         #endif
+
+        "Null",
     };
 
     std::vector<std::string> modules;
@@ -240,6 +243,37 @@ void RenderSystem::SetConfiguration(const RenderSystemConfiguration& config)
     config_ = config;
 }
 
+std::vector<Shader*> RenderSystem::CreateShaderPermutations(const ShaderPermutationDescriptor& desc)
+{
+    AssertCreateShader(desc.shaderDesc);
+
+    /* Preprocess all permutations into unique variants */
+    ShaderPermutationBuilder builder{ desc };
+
+    /* Create one shader per unique variant; variants are compiled on the calling thread since the backends are not thread-safe */
+    std::vector<Shader*> variantShaders;
+    variantShaders.reserve(builder.GetNumVariants());
+
+    try
+    {
+        for (std::size_t i = 0; i < builder.GetNumVariants(); ++i)
+            variantShaders.push_back(CreateShader(builder.GetVariantDesc(i)));
+    }
+    catch (...)
+    {
+        for (auto shader : variantShaders)
+            Release(*shader);
+        throw;
+    }
+
+    /* Map permutations to their variant shaders */
+    std::vector<Shader*> shaders(desc.permutations.size());
+    for (std::size_t i = 0; i < shaders.size(); ++i)
+        shaders[i] = variantShaders[builder.GetVariantIndex(i)];
+
+    return shaders;
+}
+
 
 /*
  * ======= Protected: =======
@@ -8,12 +8,23 @@
 #include <LLGL/RenderingDebugger.h>
 #include <LLGL/Strings.h>
 #include <LLGL/Log.h>
+#include "CaptureWriter.h"
+#include "../Core/Helper.h"
+#include <stdexcept>
 
 
 namespace LLGL
 {
 
 
+RenderingDebugger::RenderingDebugger()
+{
+}
+
+RenderingDebugger::~RenderingDebugger()
+{
+}
+
 void RenderingDebugger::SetSource(const char* source)
 {
     source_ = (source != nullptr ? source : "");
@@ -60,6 +71,35 @@ void RenderingDebugger::PostWarning(const WarningType type, const std::string& m
     }
 }
 
+bool RenderingDebugger::BeginCapture(const char* filename)
+{
+    captureWriter_.reset();
+    try
+    {
+        captureWriter_ = MakeUnique<CaptureWriter>(filename);
+    }
+    catch (const std::runtime_error&)
+    {
+        return false;
+    }
+
+    /* Write all objects that are alive, so the capture can reference objects that were created before it began */
+    if (captureObjectSource_ != nullptr)
+        captureObjectSource_->CaptureLiveObjects(*captureWriter_);
+
+    return true;
+}
+
+void RenderingDebugger::EndCapture()
+{
+    captureWriter_.reset();
+}
+
+bool RenderingDebugger::IsCaptureEnabled() const
+{
+    return (captureWriter_ != nullptr);
+}
+
 
 /*
  * ====== Protected: =======
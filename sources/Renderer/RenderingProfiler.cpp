@@ -6,15 +6,95 @@
  */
 
 #include <LLGL/RenderingProfiler.h>
+#include "ProfilerTraceWriter.h"
+#include "../Core/Helper.h"
 #include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <atomic>
+#include <mutex>
 
 
 namespace LLGL
 {
 
 
+static const std::size_t g_numProfileValues = sizeof(FrameProfile::values) / sizeof(FrameProfile::values[0]);
+
+static_assert(
+    static_cast<std::size_t>(ProfileCounter::FenceSubmissions) < g_numProfileValues,
+    "ProfileCounter enumeration exceeds the number of values in FrameProfile"
+);
+
+/*
+Counters that are only written by a single thread, so they can be incremented with relaxed loads and stores instead of atomic read-modify-write operations.
+The reader never resets the counters but keeps a snapshot of the values it has already merged, and only merges the difference.
+*/
+struct ProfilerCounterShard
+{
+    std::thread::id                 threadID;
+    std::atomic<std::uint32_t>      values[g_numProfileValues];
+    std::uint32_t                   snapshot[g_numProfileValues];   // Only accessed by NextProfile
+    ProfilerCounterShard*           next;
+};
+
+// Counter shards of all threads and time records that have not been merged into the frame profile yet.
+struct RenderingProfiler::Pimpl
+{
+    const std::uint64_t                 id;
+    std::atomic<ProfilerCounterShard*>  shards;
+    std::mutex                          timeRecordsMutex;
+    std::vector<ProfileTimeRecord>      pendingTimeRecords;
+
+    Pimpl(std::uint64_t id);
+    ~Pimpl();
+
+    ProfilerCounterShard* GetThreadShard();
+};
+
+// Returns a unique ID for each profiler, so a thread-local cache cannot confuse a new profiler with a destroyed one at the same address.
+static std::uint64_t GenerateProfilerID()
+{
+    static std::atomic<std::uint64_t> g_profilerCounter{ 0 };
+    return ++g_profilerCounter;
+}
+
+static void AddToCounter(std::atomic<std::uint32_t>& counter, std::uint32_t value)
+{
+    /* Only the owning thread writes to this counter, so no read-modify-write operation is required */
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+RenderingProfiler::RenderingProfiler() :
+    pimpl_ { MakeUnique<Pimpl>(GenerateProfilerID()) }
+{
+}
+
+RenderingProfiler::~RenderingProfiler()
+{
+    // dummy
+}
+
 void RenderingProfiler::NextProfile(FrameProfile* outputProfile)
 {
+    /* Merge counters of all threads that have changed since the last call */
+    for (auto shard = pimpl_->shards.load(std::memory_order_acquire); shard != nullptr; shard = shard->next)
+    {
+        for (std::size_t i = 0; i < g_numProfileValues; ++i)
+        {
+            const auto value = shard->values[i].load(std::memory_order_relaxed);
+            frameProfile.values[i] += (value - shard->snapshot[i]);
+            shard->snapshot[i] = value;
+        }
+    }
+
+    /* Merge time records */
+    {
+        std::lock_guard<std::mutex> guard{ pimpl_->timeRecordsMutex };
+        frameProfile.timeRecords.insert(frameProfile.timeRecords.end(), pimpl_->pendingTimeRecords.begin(), pimpl_->pendingTimeRecords.end());
+        pimpl_->pendingTimeRecords.clear();
+    }
+
     /* Copy current counters to the output profile (if set) */
     if (outputProfile)
         *outputProfile = frameProfile;
@@ -25,7 +105,122 @@ void RenderingProfiler::NextProfile(FrameProfile* outputProfile)
 
 void RenderingProfiler::Accumulate(const FrameProfile& profile)
 {
-    frameProfile.Accumulate(profile);
+    /* Accumulate counters of the calling thread */
+    auto shard = pimpl_->GetThreadShard();
+    for (std::size_t i = 0; i < g_numProfileValues; ++i)
+    {
+        if (profile.values[i] != 0)
+            AddToCounter(shard->values[i], profile.values[i]);
+    }
+
+    /* Append time records */
+    if (!profile.timeRecords.empty())
+    {
+        std::lock_guard<std::mutex> guard{ pimpl_->timeRecordsMutex };
+        pimpl_->pendingTimeRecords.insert(pimpl_->pendingTimeRecords.end(), profile.timeRecords.begin(), profile.timeRecords.end());
+    }
+}
+
+void RenderingProfiler::Increment(const ProfileCounter counter, std::uint32_t value)
+{
+    /* Enumeration entries are declared in the same order as the counters in FrameProfile::values */
+    AddToCounter(pimpl_->GetThreadShard()->values[static_cast<std::size_t>(counter)], value);
+}
+
+bool RenderingProfiler::BeginTraceCapture(const char* filename, std::size_t maxBufferedEvents)
+{
+    traceWriter_.reset();
+    try
+    {
+        traceWriter_ = MakeUnique<ProfilerTraceWriter>(filename, maxBufferedEvents);
+    }
+    catch (const std::runtime_error&)
+    {
+        return false;
+    }
+    return true;
+}
+
+void RenderingProfiler::EndTraceCapture()
+{
+    traceWriter_.reset();
+}
+
+bool RenderingProfiler::IsTraceCaptureEnabled() const
+{
+    return (traceWriter_ != nullptr);
+}
+
+ProfilerTraceWriter* RenderingProfiler::GetTraceWriter() const
+{
+    return traceWriter_.get();
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+RenderingProfiler::Pimpl::Pimpl(std::uint64_t id) :
+    id     { id      },
+    shards { nullptr }
+{
+}
+
+RenderingProfiler::Pimpl::~Pimpl()
+{
+    for (auto shard = shards.load(); shard != nullptr;)
+    {
+        auto next = shard->next;
+        delete shard;
+        shard = next;
+    }
+}
+
+ProfilerCounterShard* RenderingProfiler::Pimpl::GetThreadShard()
+{
+    /* Look up shard in thread-local cache first, which usually hits since a thread rarely switches between profilers */
+    struct ShardCache
+    {
+        std::uint64_t           profilerID;
+        ProfilerCounterShard*   shard;
+    };
+    thread_local ShardCache g_shardCache = { 0, nullptr };
+
+    if (g_shardCache.profilerID == id)
+        return g_shardCache.shard;
+
+    /* Find shard of the calling thread in the list */
+    const auto threadID = std::this_thread::get_id();
+    auto head = shards.load(std::memory_order_acquire);
+
+    for (auto shard = head; shard != nullptr; shard = shard->next)
+    {
+        if (shard->threadID == threadID)
+        {
+            g_shardCache = { id, shard };
+            return shard;
+        }
+    }
+
+    /* Create new shard and insert it at the front of the list; shards are only released with the profiler */
+    auto shard = new ProfilerCounterShard();
+    {
+        shard->threadID = threadID;
+        for (std::size_t i = 0; i < g_numProfileValues; ++i)
+        {
+            shard->values[i].store(0, std::memory_order_relaxed);
+            shard->snapshot[i] = 0;
+        }
+        shard->next = head;
+    }
+    while (!shards.compare_exchange_weak(shard->next, shard, std::memory_order_release, std::memory_order_acquire))
+    {
+        // retry with updated head in shard->next
+    }
+
+    g_shardCache = { id, shard };
+    return shard;
 }
 
 
@@ -31,6 +31,8 @@ void SPIRVParser::Parse(const void* byteCode, std::size_t byteCodeSize)
     if (numWords < 5)
         throw std::invalid_argument("too few words in SPIR-V shader module");
 
+    numWords_ = numWords;
+
     /* Parse header */
     SPIRVHeader header;
     {
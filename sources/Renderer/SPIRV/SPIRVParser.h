@@ -46,6 +46,12 @@ class SPIRVParser
         // Returns true if the parsing process has finished.
         bool HasFinished() const;
 
+        // Returns the number of 32-bit words of the module that is currently parsed, including the header.
+        inline std::uint32_t GetNumWords() const
+        {
+            return numWords_;
+        }
+
     protected:
 
         // Callback function for the SPIR-V shader module header.
@@ -56,7 +62,8 @@ class SPIRVParser
 
     private:
 
-        bool finished_ = false;
+        bool            finished_   = false;
+        std::uint32_t   numWords_   = 0;
 
 };
 
@@ -7,7 +7,12 @@
 
 #include "SPIRVReflect.h"
 #include "../../Core/Helper.h"
+#include <LLGL/ThreadPool.h>
+#include <exception>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <cstring>
 
 
 namespace LLGL
@@ -42,11 +47,77 @@ bool SPIRVReflect::SpvType::RefersToType(const spv::Op opcodeType) const
     return (DereferencePtr(opcodeType) != nullptr);
 }
 
+void SPIRVReflect::ParseModules(
+    std::size_t             numModules,
+    const SPIRVModuleView*  modules,
+    SPIRVReflect*           outReflections,
+    ThreadPool*             threadPool)
+{
+    auto parseRange = [modules, outReflections](std::size_t begin, std::size_t end)
+    {
+        /* Parse all modules of this range before the first exception is re-thrown */
+        std::exception_ptr exception;
+        for (auto i = begin; i < end; ++i)
+        {
+            try
+            {
+                outReflections[i].Parse(modules[i].byteCode, modules[i].byteCodeSize);
+            }
+            catch (...)
+            {
+                if (!exception)
+                    exception = std::current_exception();
+            }
+        }
+        if (exception)
+            std::rethrow_exception(exception);
+    };
+
+    /* Each module is parsed into its own reflection object, so modules can be distributed individually */
+    if (threadPool != nullptr && numModules > 1)
+        threadPool->ParallelFor(numModules, 1, parseRange);
+    else
+        parseRange(0, numModules);
+}
+
+bool SPIRVReflect::FindPushConstantField(const char* name, std::uint32_t& outOffset, std::uint32_t& outSize) const
+{
+    if (pushConstantType_ == nullptr || name == nullptr)
+        return false;
+
+    const auto record = pushConstantType_->result;
+
+    /* Find field index by its name */
+    for (std::uint32_t i = 0; i < numFieldAnnotations_; ++i)
+    {
+        const auto& nameAnnotation = fieldAnnotations_[i];
+        if (nameAnnotation.record == record && nameAnnotation.name != nullptr && std::strcmp(nameAnnotation.name, name) == 0)
+        {
+            if (nameAnnotation.field >= pushConstantType_->numFields)
+                return false;
+
+            /* Find offset decoration of the same field */
+            for (std::uint32_t j = 0; j < numFieldAnnotations_; ++j)
+            {
+                const auto& offsetAnnotation = fieldAnnotations_[j];
+                if (offsetAnnotation.record == record && offsetAnnotation.field == nameAnnotation.field && offsetAnnotation.name == nullptr)
+                {
+                    outOffset   = offsetAnnotation.offset;
+                    outSize     = pushConstantType_->fieldTypes[nameAnnotation.field]->size;
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+
+    return false;
+}
+
 void SPIRVReflect::OnParseHeader(const SPIRVHeader& header)
 {
-    idBound_ = header.idBound;
-    if (idBound_ > 0)
-        names_.resize(idBound_);
+    SPIRVParser::OnParseHeader(header);
+    ResetTables(header.idBound, GetNumWords());
 }
 
 void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
@@ -56,9 +127,15 @@ void SPIRVReflect::OnParseInstruction(const SPIRVInstruction& instr)
         case spv::Op::OpName:
             OpName(instr);
             break;
+        case spv::Op::OpMemberName:
+            OpMemberName(instr);
+            break;
         case spv::Op::OpDecorate:
             OpDecorate(instr);
             break;
+        case spv::Op::OpMemberDecorate:
+            OpMemberDecorate(instr);
+            break;
         case spv::Op::OpTypeVoid:
         case spv::Op::OpTypeBool:
         case spv::Op::OpTypeInt:
@@ -92,6 +169,13 @@ void SPIRVReflect::OpName(const Instr& instr)
     SetName(instr.GetUInt32(0), instr.GetASCII(1));
 }
 
+void SPIRVReflect::OpMemberName(const Instr& instr)
+{
+    /* The structure ID of OpMemberName is reported as type ID by the instruction lookup */
+    auto& annotation = AppendFieldAnnotation(instr.type, instr.GetUInt32(0));
+    annotation.name = instr.GetASCII(1);
+}
+
 void SPIRVReflect::OpDecorate(const Instr& instr)
 {
     auto decoration = static_cast<spv::Decoration>(instr.GetUInt32(1));
@@ -100,6 +184,9 @@ void SPIRVReflect::OpDecorate(const Instr& instr)
         case spv::Decoration::Binding:
             OpDecorateBinding(instr);
             break;
+        case spv::Decoration::DescriptorSet:
+            OpDecorateDescriptorSet(instr);
+            break;
         case spv::Decoration::Location:
             OpDecorateLocation(instr);
             break;
@@ -111,35 +198,44 @@ void SPIRVReflect::OpDecorate(const Instr& instr)
     }
 }
 
+void SPIRVReflect::OpMemberDecorate(const Instr& instr)
+{
+    auto decoration = static_cast<spv::Decoration>(instr.GetUInt32(2));
+    if (decoration == spv::Decoration::Offset)
+    {
+        auto& annotation = AppendFieldAnnotation(instr.GetUInt32(0), instr.GetUInt32(1));
+        annotation.offset = instr.GetUInt32(3);
+    }
+}
+
 void SPIRVReflect::OpDecorateBinding(const Instr& instr)
 {
-    auto id         = instr.GetUInt32(0);
-    auto& variable  = uniforms_[id];
+    auto& variable = GetOrInitUniform(instr.GetUInt32(0));
+    variable.binding = instr.GetUInt32(2);
+}
 
-    variable.name       = GetName(id);
-    variable.binding    = instr.GetUInt32(2);
+void SPIRVReflect::OpDecorateDescriptorSet(const Instr& instr)
+{
+    auto& variable = GetOrInitUniform(instr.GetUInt32(0));
+    variable.set = instr.GetUInt32(2);
 }
 
 void SPIRVReflect::OpDecorateLocation(const Instr& instr)
 {
-    auto id         = instr.GetUInt32(0);
-    auto& variable  = varyings_[id];
-
-    variable.name       = GetName(id);
-    variable.location   = instr.GetUInt32(2);
+    auto& variable = GetOrInitVarying(instr.GetUInt32(0));
+    variable.location = instr.GetUInt32(2);
 }
 
 void SPIRVReflect::OpDecorateBuiltin(const Instr& instr)
 {
-    auto id         = instr.GetUInt32(0);
-    auto& variable  = varyings_[id];
-
-    variable.name       = GetName(id);
-    variable.builtin    = static_cast<spv::BuiltIn>(instr.GetUInt32(2));
+    auto& variable = GetOrInitVarying(instr.GetUInt32(0));
+    variable.builtin = static_cast<spv::BuiltIn>(instr.GetUInt32(2));
 }
 
 void SPIRVReflect::OpType(const Instr& instr)
 {
+    AssertIdBound(instr.result);
+
     /* Register type and store it as current type to operate on */
     auto& type = types_[instr.result];
     {
@@ -248,14 +344,32 @@ static void AccumulateSizeInVectorBoundary(std::uint32_t& size, std::uint32_t al
 
 void SPIRVReflect::OpTypeStruct(const Instr& instr, SpvType& type)
 {
-    type.fieldTypes.reserve(instr.numOperands);
+    /* Take field types from the pool, which cannot overflow since each field is an operand word of the module */
+    if (numFieldTypes_ + instr.numOperands > maxFieldTypes_)
+        throw std::runtime_error("too many record fields in SPIR-V shader module");
+
+    auto fieldTypes = fieldTypes_ + numFieldTypes_;
+    numFieldTypes_ += instr.numOperands;
+
     for (std::uint32_t i = 0; i < instr.numOperands; ++i)
     {
         auto fieldType = FindType(instr.GetUInt32(i));
-        type.fieldTypes.push_back(fieldType);
+        fieldTypes[i] = fieldType;
         AccumulateSizeInVectorBoundary(type.size, 16, fieldType->size);
     }
-    type.size = GetAlignedSize(type.size, 16u);
+
+    type.numFields  = instr.numOperands;
+    type.fieldTypes = fieldTypes;
+
+    /* Register record with its padding to the next vector boundary */
+    auto& record = records_[instr.result];
+    {
+        record.id       = instr.result;
+        record.name     = type.name;
+        record.size     = GetAlignedSize(type.size, 16u);
+        record.padding  = record.size - type.size;
+    }
+    type.size = record.size;
 }
 
 void SPIRVReflect::OpTypeOpaque(const Instr& instr, SpvType& type)
@@ -291,7 +405,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
         case spv::StorageClass::UniformConstant:
         //case spv::StorageClass::PushConstant:
         {
-            auto& var = uniforms_[instr.result];
+            auto& var = GetOrInitUniform(instr.result);
             {
                 var.type = FindType(instr.type);
                 if (auto structType = var.type->DereferencePtr(spv::Op::OpTypeStruct))
@@ -308,7 +422,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
         case spv::StorageClass::Input:
         {
-            auto& var = varyings_[instr.result];
+            auto& var = GetOrInitVarying(instr.result);
             {
                 var.type    = FindType(instr.type);
                 var.input   = true;
@@ -318,7 +432,7 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
         case spv::StorageClass::Output:
         {
-            auto& var = varyings_[instr.result];
+            auto& var = GetOrInitVarying(instr.result);
             {
                 var.type    = FindType(instr.type);
                 var.input   = false;
@@ -326,6 +440,13 @@ void SPIRVReflect::OpVariable(const Instr& instr)
         }
         break;
 
+        case spv::StorageClass::PushConstant:
+        {
+            /* Only store the record type; there can be at most one push constant block per entry point */
+            pushConstantType_ = FindType(instr.type)->DereferencePtr(spv::Op::OpTypeStruct);
+        }
+        break;
+
         default:
         break;
     }
@@ -333,6 +454,8 @@ void SPIRVReflect::OpVariable(const Instr& instr)
 
 void SPIRVReflect::OpConstant(const Instr& instr)
 {
+    AssertIdBound(instr.result);
+
     auto& val = constants_[instr.result];
     {
         val.type = FindType(instr.type);
@@ -356,6 +479,67 @@ void SPIRVReflect::OpConstant(const Instr& instr)
     }
 }
 
+// Reserves an array of the specified type within the arena and returns its offset.
+template <typename T>
+static std::size_t ReserveArenaArray(std::size_t& arenaSize, std::size_t count)
+{
+    const auto offset = GetAlignedSize(arenaSize, alignof(T));
+    arenaSize = offset + sizeof(T) * count;
+    return offset;
+}
+
+// Default initializes the specified array within the arena and returns a pointer to its first element.
+template <typename T>
+static T* InitArenaArray(char* arena, std::size_t offset, std::size_t count)
+{
+    static_assert(std::is_trivially_destructible<T>::value, "SPIR-V reflection tables must be trivially destructible");
+    auto first = reinterpret_cast<T*>(arena + offset);
+    for (std::size_t i = 0; i < count; ++i)
+        new (first + i) T();
+    return first;
+}
+
+void SPIRVReflect::ResetTables(std::uint32_t idBound, std::uint32_t numWords)
+{
+    /* Determine layout of all tables within the arena */
+    std::size_t arenaSize = 0;
+
+    const auto namesOffset          = ReserveArenaArray<const char*         >(arenaSize, idBound     );
+    const auto typesOffset          = ReserveArenaArray<SpvType             >(arenaSize, idBound     );
+    const auto constantsOffset      = ReserveArenaArray<SpvConstant         >(arenaSize, idBound     );
+    const auto recordsOffset        = ReserveArenaArray<SpvRecord           >(arenaSize, idBound     );
+    const auto uniformsOffset       = ReserveArenaArray<SpvUniform          >(arenaSize, idBound     );
+    const auto varyingsOffset       = ReserveArenaArray<SpvVarying          >(arenaSize, idBound     );
+    const auto fieldTypesOffset     = ReserveArenaArray<const SpvType*      >(arenaSize, numWords    );
+    const auto annotationsOffset    = ReserveArenaArray<SpvFieldAnnotation  >(arenaSize, numWords / 4);
+
+    /* Only allocate a new arena if the previous one is too small */
+    if (arenaSize > arenaSize_)
+    {
+        arena_      = std::unique_ptr<char[]>(new char[arenaSize]);
+        arenaSize_  = arenaSize;
+    }
+
+    /* Initialize tables; the pools of field types and field annotations are filled on demand */
+    auto arena = arena_.get();
+
+    idBound_        = idBound;
+    names_          = InitArenaArray<const char*>(arena, namesOffset, idBound);
+    types_          = InitArenaArray<SpvType    >(arena, typesOffset, idBound);
+    constants_      = InitArenaArray<SpvConstant>(arena, constantsOffset, idBound);
+    records_        = InitArenaArray<SpvRecord  >(arena, recordsOffset, idBound);
+    uniforms_       = InitArenaArray<SpvUniform >(arena, uniformsOffset, idBound);
+    varyings_       = InitArenaArray<SpvVarying >(arena, varyingsOffset, idBound);
+    fieldTypes_     = reinterpret_cast<const SpvType**>(arena + fieldTypesOffset);
+    numFieldTypes_  = 0;
+    maxFieldTypes_  = numWords;
+
+    fieldAnnotations_       = reinterpret_cast<SpvFieldAnnotation*>(arena + annotationsOffset);
+    numFieldAnnotations_    = 0;
+    maxFieldAnnotations_    = numWords / 4;
+    pushConstantType_       = nullptr;
+}
+
 void SPIRVReflect::SetName(spv::Id id, const char* name)
 {
     AssertIdBound(id);
@@ -379,20 +563,55 @@ void SPIRVReflect::AssertIdBound(spv::Id id) const
     }
 }
 
+SPIRVReflect::SpvUniform& SPIRVReflect::GetOrInitUniform(spv::Id id)
+{
+    AssertIdBound(id);
+    auto& variable = uniforms_[id];
+    if (variable.id == 0)
+    {
+        variable.id     = id;
+        variable.name   = names_[id];
+    }
+    return variable;
+}
+
+SPIRVReflect::SpvVarying& SPIRVReflect::GetOrInitVarying(spv::Id id)
+{
+    AssertIdBound(id);
+    auto& variable = varyings_[id];
+    if (variable.id == 0)
+    {
+        variable.id     = id;
+        variable.name   = names_[id];
+    }
+    return variable;
+}
+
+SPIRVReflect::SpvFieldAnnotation& SPIRVReflect::AppendFieldAnnotation(spv::Id record, std::uint32_t field)
+{
+    if (numFieldAnnotations_ == maxFieldAnnotations_)
+        throw std::runtime_error("too many record field annotations in SPIR-V shader module");
+
+    auto annotation = new (&fieldAnnotations_[numFieldAnnotations_++]) SpvFieldAnnotation{};
+    {
+        annotation->record  = record;
+        annotation->field   = field;
+    }
+    return *annotation;
+}
+
 const SPIRVReflect::SpvType* SPIRVReflect::FindType(spv::Id id) const
 {
-    auto it = types_.find(id);
-    if (it == types_.end())
+    if (id >= idBound_ || types_[id].result == 0)
         throw std::runtime_error("cannot find SPIR-V OpType* instruction with result ID %" + std::to_string(id));
-    return &(it->second);
+    return &(types_[id]);
 }
 
 const SPIRVReflect::SpvConstant* SPIRVReflect::FindConstant(spv::Id id) const
 {
-    auto it = constants_.find(id);
-    if (it == constants_.end())
+    if (id >= idBound_ || constants_[id].type == nullptr)
         throw std::runtime_error("cannot find SPIR-V OpConstant instruction with with result ID %" + std::to_string(id));
-    return &(it->second);
+    return &(constants_[id]);
 }
 
 
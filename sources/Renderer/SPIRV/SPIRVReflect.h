@@ -10,15 +10,31 @@
 
 
 #include "SPIRVParser.h"
-#include <vector>
-#include <map>
+#include <cstddef>
+#include <iterator>
+#include <memory>
 
 
 namespace LLGL
 {
 
 
-// SPIR-V shader module parser.
+class ThreadPool;
+
+// Byte code of a SPIR-V module for SPIRVReflect::ParseModules.
+struct SPIRVModuleView
+{
+    const void*     byteCode;
+    std::size_t     byteCodeSize;
+};
+
+/*
+SPIR-V shader module parser.
+All types, constants, and variables are stored in dense tables that are indexed by their ID number,
+which are allocated as a single arena from the ID-bound of the module header. The arena is kept for subsequent calls to Parse,
+so reflecting modules with the same or a smaller ID-bound does not allocate memory.
+All names refer to the byte code, i.e. the byte code must outlive the reflection.
+*/
 class SPIRVReflect final : public SPIRVParser
 {
 
@@ -31,21 +47,22 @@ class SPIRVReflect final : public SPIRVParser
             const SpvType* DereferencePtr(const spv::Op opcodeType) const;
             bool RefersToType(const spv::Op opcodeType) const;
 
-            spv::Op                     opcode      = spv::Op::Max;             // Opcode for this type (e.g. spv::Op::OpTypeFloat).
-            spv::Id                     result      = 0;                        // Result ID of this type.
-            spv::StorageClass           storage     = spv::StorageClass::Max;   // Storage class of this type. By default spv::StorageClass::Max.
-            const char*                 name        = nullptr;                  // Name of this type (only for structures).
-            const SpvType*              baseType    = nullptr;                  // Reference to the base type, or null if there is no base type.
-            std::uint32_t               elements    = 0;                        // Number of elements for the base type, or 0 if there is no base type.
-            std::uint32_t               size        = 0;                        // Size (in bytes) of this type, or 0 if this is an OpTypeVoid type.
-            bool                        sign        = false;                    // Specifies whether or not this is a signed type (only for OpTypeInt).
-            std::vector<const SpvType*> fieldTypes;                             // List of types of each record field.
+            spv::Op                 opcode      = spv::Op::Max;             // Opcode for this type (e.g. spv::Op::OpTypeFloat).
+            spv::Id                 result      = 0;                        // Result ID of this type, or 0 if the table entry is unused.
+            spv::StorageClass       storage     = spv::StorageClass::Max;   // Storage class of this type. By default spv::StorageClass::Max.
+            const char*             name        = nullptr;                  // Name of this type (only for structures).
+            const SpvType*          baseType    = nullptr;                  // Reference to the base type, or null if there is no base type.
+            std::uint32_t           elements    = 0;                        // Number of elements for the base type, or 0 if there is no base type.
+            std::uint32_t           size        = 0;                        // Size (in bytes) of this type, or 0 if this is an OpTypeVoid type.
+            bool                    sign        = false;                    // Specifies whether or not this is a signed type (only for OpTypeInt).
+            std::uint32_t           numFields   = 0;                        // Number of record fields (only for OpTypeStruct).
+            const SpvType* const*   fieldTypes  = nullptr;                  // Array of types of each record field (only for OpTypeStruct).
         };
 
         // SPIRV-V scalar constants.
         struct SpvConstant
         {
-            const SpvType*      type    = nullptr;
+            const SpvType*      type    = nullptr;  // Type of this constant, or null if the table entry is unused.
             union
             {
                 float           f32;
@@ -60,6 +77,7 @@ class SPIRVReflect final : public SPIRVParser
         // SPIR-V structures (a.k.a. records).
         struct SpvRecord
         {
+            spv::Id         id      = 0;        // Result ID of the OpTypeStruct instruction, or 0 if the table entry is unused.
             const char*     name    = nullptr;
             std::uint32_t   size    = 0;
             std::uint32_t   padding = 0;
@@ -68,6 +86,7 @@ class SPIRVReflect final : public SPIRVParser
         // Global uniform objects.
         struct SpvUniform
         {
+            spv::Id         id      = 0;        // Result ID of the variable, or 0 if the table entry is unused.
             const char*     name    = nullptr;
             const SpvType*  type    = nullptr;
             std::uint32_t   set     = 0;        // Descriptor set
@@ -75,9 +94,19 @@ class SPIRVReflect final : public SPIRVParser
             std::uint32_t   size    = 0;        // Size (in bytes) of the uniform.
         };
 
+        // Annotation of a record field, i.e. either its name (OpMemberName) or its byte offset (OpMemberDecorate with Offset decoration).
+        struct SpvFieldAnnotation
+        {
+            spv::Id         record  = 0;        // Result ID of the OpTypeStruct instruction.
+            std::uint32_t   field   = 0;        // Index of the record field.
+            const char*     name    = nullptr;  // Name of the field, or null if this annotation specifies the offset.
+            std::uint32_t   offset  = 0;        // Byte offset of the field within its record (only if 'name' is null).
+        };
+
         // Module varyings, i.e. either input or output attributes.
         struct SpvVarying
         {
+            spv::Id         id          = 0;                    // Result ID of the variable, or 0 if the table entry is unused.
             const char*     name        = nullptr;
             spv::BuiltIn    builtin     = spv::BuiltIn::Max;    // Optional built-in type
             const SpvType*  type        = nullptr;
@@ -85,23 +114,143 @@ class SPIRVReflect final : public SPIRVParser
             bool            input       = false;
         };
 
+        // Read-only view of an ID-indexed table that only iterates over the used entries in ascending order of their IDs.
+        template <typename T>
+        class IdTable
+        {
+
+            public:
+
+                class Iterator
+                {
+
+                    public:
+
+                        using iterator_category = std::forward_iterator_tag;
+                        using difference_type   = std::ptrdiff_t;
+                        using value_type        = T;
+                        using pointer           = const T*;
+                        using reference         = const T&;
+
+                    public:
+
+                        Iterator(const T* entry, const T* end) :
+                            entry_ { entry },
+                            end_   { end   }
+                        {
+                            SkipUnused();
+                        }
+
+                        bool operator == (const Iterator& rhs) const
+                        {
+                            return (entry_ == rhs.entry_);
+                        }
+
+                        bool operator != (const Iterator& rhs) const
+                        {
+                            return (entry_ != rhs.entry_);
+                        }
+
+                        Iterator& operator ++ ()
+                        {
+                            ++entry_;
+                            SkipUnused();
+                            return *this;
+                        }
+
+                        reference operator * () const
+                        {
+                            return *entry_;
+                        }
+
+                        pointer operator -> () const
+                        {
+                            return entry_;
+                        }
+
+                    private:
+
+                        void SkipUnused()
+                        {
+                            while (entry_ != end_ && entry_->id == 0)
+                                ++entry_;
+                        }
+
+                    private:
+
+                        const T* entry_ = nullptr;
+                        const T* end_   = nullptr;
+
+                };
+
+            public:
+
+                IdTable(const T* entries, std::uint32_t idBound) :
+                    entries_ { entries },
+                    idBound_ { idBound }
+                {
+                }
+
+                Iterator begin() const
+                {
+                    return Iterator{ entries_, entries_ + idBound_ };
+                }
+
+                Iterator end() const
+                {
+                    return Iterator{ entries_ + idBound_, entries_ + idBound_ };
+                }
+
+                // Returns the entry with the specified ID, or null if there is no such entry.
+                const T* Find(spv::Id id) const
+                {
+                    return (id < idBound_ && entries_[id].id != 0 ? &(entries_[id]) : nullptr);
+                }
+
+            private:
+
+                const T*        entries_ = nullptr;
+                std::uint32_t   idBound_ = 0;
+
+        };
+
     public:
 
-        inline const std::map<spv::Id, SpvRecord>& GetRecords() const
+        inline IdTable<SpvRecord> GetRecords() const
         {
-            return records_;
+            return IdTable<SpvRecord>{ records_, idBound_ };
         }
 
-        inline const std::map<spv::Id, SpvUniform>& GetUniforms() const
+        inline IdTable<SpvUniform> GetUniforms() const
         {
-            return uniforms_;
+            return IdTable<SpvUniform>{ uniforms_, idBound_ };
         }
 
-        inline const std::map<spv::Id, SpvVarying>& GetVaryings() const
+        inline IdTable<SpvVarying> GetVaryings() const
         {
-            return varyings_;
+            return IdTable<SpvVarying>{ varyings_, idBound_ };
         }
 
+        /*
+        Finds the field with the specified name in the push constant block of this module and returns its byte offset and size.
+        Returns false if the module has no push constant block or the block has no field with that name.
+        */
+        bool FindPushConstantField(const char* name, std::uint32_t& outOffset, std::uint32_t& outSize) const;
+
+    public:
+
+        /*
+        Parses all specified modules into the respective output reflections and distributes the work over the thread pool.
+        If 'threadPool' is null, all modules are parsed on the calling thread. If parsing any module fails,
+        the first exception is re-thrown after all modules have been processed.
+        */
+        static void ParseModules(
+            std::size_t             numModules,
+            const SPIRVModuleView*  modules,
+            SPIRVReflect*           outReflections,
+            ThreadPool*             threadPool          = nullptr
+        );
+
     private:
 
         using Instr = SPIRVInstruction;
@@ -110,8 +259,11 @@ class SPIRVReflect final : public SPIRVParser
         void OnParseInstruction(const SPIRVInstruction& instr) override;
 
         void OpName(const Instr& instr);
+        void OpMemberName(const Instr& instr);
         void OpDecorate(const Instr& instr);
+        void OpMemberDecorate(const Instr& instr);
         void OpDecorateBinding(const Instr& instr);
+        void OpDecorateDescriptorSet(const Instr& instr);
         void OpDecorateLocation(const Instr& instr);
         void OpDecorateBuiltin(const Instr& instr);
         void OpType(const Instr& instr);
@@ -135,24 +287,43 @@ class SPIRVReflect final : public SPIRVParser
 
     private:
 
+        // Allocates the arena for the specified ID-bound and number of words (if necessary) and resets all tables.
+        void ResetTables(std::uint32_t idBound, std::uint32_t numWords);
+
         void SetName(spv::Id id, const char* name);
         const char* GetName(spv::Id id) const;
 
         void AssertIdBound(spv::Id id) const;
 
+        SpvUniform& GetOrInitUniform(spv::Id id);
+        SpvVarying& GetOrInitVarying(spv::Id id);
+        SpvFieldAnnotation& AppendFieldAnnotation(spv::Id record, std::uint32_t field);
+
         const SpvType* FindType(spv::Id id) const;
         const SpvConstant* FindConstant(spv::Id id) const;
 
     private:
 
-        std::uint32_t                   idBound_    = 0;
-        std::vector<const char*>        names_;
+        std::unique_ptr<char[]>     arena_;
+        std::size_t                 arenaSize_      = 0;
+
+        std::uint32_t               idBound_        = 0;
+        const char**                names_          = nullptr;
+        SpvType*                    types_          = nullptr;
+        SpvConstant*                constants_      = nullptr;
+        SpvRecord*                  records_        = nullptr;
+        SpvUniform*                 uniforms_       = nullptr;
+        SpvVarying*                 varyings_       = nullptr;
+
+        const SpvType**             fieldTypes_     = nullptr;  // Pool of record field types; a module cannot have more field operands than words.
+        std::uint32_t               numFieldTypes_  = 0;
+        std::uint32_t               maxFieldTypes_  = 0;
+
+        SpvFieldAnnotation*         fieldAnnotations_       = nullptr;  // Pool of field annotations; each annotation instruction has at least four words.
+        std::uint32_t               numFieldAnnotations_    = 0;
+        std::uint32_t               maxFieldAnnotations_    = 0;
 
-        std::map<spv::Id, SpvType>      types_;
-        std::map<spv::Id, SpvConstant>  constants_;
-        std::map<spv::Id, SpvRecord>    records_;
-        std::map<spv::Id, SpvUniform>   uniforms_;
-        std::map<spv::Id, SpvVarying>   varyings_;
+        const SpvType*              pushConstantType_       = nullptr;  // Record type of the push constant block, or null if there is none.
 
 };
 
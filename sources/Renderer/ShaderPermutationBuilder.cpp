@@ -0,0 +1,271 @@
+/*
+ * ShaderPermutationBuilder.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "ShaderPermutationBuilder.h"
+#include "../Core/Helper.h"
+#include "../Core/ImageUtils.h"
+#include <LLGL/ThreadPool.h>
+#include <unordered_map>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+
+namespace LLGL
+{
+
+
+static bool IsIdentifierStart(char c)
+{
+    return ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_');
+}
+
+static bool IsIdentifierChar(char c)
+{
+    return (IsIdentifierStart(c) || (c >= '0' && c <= '9'));
+}
+
+// Calls the specified function for each identifier token in the range [s, end).
+template <typename TFunc>
+static void ForEachIdentifier(const char* s, const char* end, TFunc func)
+{
+    while (s != end)
+    {
+        if (IsIdentifierStart(*s))
+        {
+            const char* start = s;
+            while (s != end && IsIdentifierChar(*s))
+                ++s;
+            func(start, static_cast<std::size_t>(s - start));
+        }
+        else if (*s >= '0' && *s <= '9')
+        {
+            /* Skip numeric literals including suffixes (e.g. "1.0f") */
+            while (s != end && IsIdentifierChar(*s))
+                ++s;
+        }
+        else
+            ++s;
+    }
+}
+
+ShaderPermutationBuilder::ShaderPermutationBuilder(const ShaderPermutationDescriptor& desc) :
+    baseDesc_ { desc.shaderDesc }
+{
+    if (!IsShaderSourceCode(baseDesc_.sourceType))
+        throw std::invalid_argument("cannot create shader permutations from a source that is not high-level shader code");
+
+    LoadSource();
+    ScanIdentifiers();
+
+    /* Reduce each permutation to its canonical macro list */
+    const auto numPermutations = desc.permutations.size();
+    std::vector<Variant> permutationVariants(numPermutations);
+
+    auto threadCount = desc.threadCount;
+    if (auto threadPool = GetThreadPoolForThreadCount(threadCount))
+    {
+        threadPool->ParallelFor(
+            numPermutations,
+            std::max<std::size_t>(1, numPermutations / (threadCount * 4)),
+            [&](std::size_t begin, std::size_t end)
+            {
+                for (auto i = begin; i < end; ++i)
+                    permutationVariants[i] = MakeVariant(desc.permutations[i]);
+            }
+        );
+    }
+    else
+    {
+        for (std::size_t i = 0; i < numPermutations; ++i)
+            permutationVariants[i] = MakeVariant(desc.permutations[i]);
+    }
+
+    /* Merge permutations with equal macro lists into unique variants in order of their first occurrence */
+    std::unordered_multimap<std::uint64_t, std::size_t> hashedVariants;
+    hashedVariants.reserve(numPermutations);
+    permutationVariants_.reserve(numPermutations);
+
+    for (auto& variant : permutationVariants)
+    {
+        std::size_t variantIndex = variants_.size();
+
+        auto range = hashedVariants.equal_range(variant.hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (variants_[it->second].key == variant.key)
+            {
+                variantIndex = it->second;
+                break;
+            }
+        }
+
+        if (variantIndex == variants_.size())
+        {
+            hashedVariants.insert({ variant.hash, variantIndex });
+            variants_.push_back(std::move(variant));
+        }
+
+        permutationVariants_.push_back(variantIndex);
+    }
+}
+
+ShaderDescriptor ShaderPermutationBuilder::GetVariantDesc(std::size_t variant) const
+{
+    ShaderDescriptor variantDesc = baseDesc_;
+    {
+        /* Pass the already loaded source code, unless the file is required to resolve include directives */
+        if (variantDesc.sourceType == ShaderSourceType::CodeFile && pruneMacros_)
+        {
+            variantDesc.sourceType  = ShaderSourceType::CodeString;
+            variantDesc.source      = source_.c_str();
+            variantDesc.sourceSize  = source_.size();
+        }
+        variantDesc.defines = variants_[variant].macros.data();
+    }
+    return variantDesc;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void ShaderPermutationBuilder::LoadSource()
+{
+    if (baseDesc_.sourceType == ShaderSourceType::CodeFile)
+        source_ = ReadFileString(baseDesc_.source);
+    else if (baseDesc_.sourceSize > 0)
+        source_ = std::string(baseDesc_.source, baseDesc_.sourceSize);
+    else
+        source_ = std::string(baseDesc_.source);
+}
+
+void ShaderPermutationBuilder::ScanIdentifiers()
+{
+    ForEachIdentifier(
+        source_.data(),
+        source_.data() + source_.size(),
+        [this](const char* ident, std::size_t len)
+        {
+            identifiers_.insert(std::string(ident, len));
+        }
+    );
+
+    /* Macros might be referenced by included files, which are not scanned */
+    pruneMacros_ = (identifiers_.find("include") == identifiers_.end());
+}
+
+bool ShaderPermutationBuilder::IsIdentifierReferenced(const std::string& ident) const
+{
+    return (!pruneMacros_ || identifiers_.find(ident) != identifiers_.end());
+}
+
+ShaderPermutationBuilder::Variant ShaderPermutationBuilder::MakeVariant(const ShaderMacro* permutation) const
+{
+    Variant variant;
+
+    /* Gather base macros followed by permutation macros */
+    std::vector<ShaderMacro> macros;
+
+    if (auto defines = baseDesc_.defines)
+    {
+        for (; defines->name != nullptr; ++defines)
+            macros.push_back(*defines);
+    }
+    if (auto defines = permutation)
+    {
+        for (; defines->name != nullptr; ++defines)
+            macros.push_back(*defines);
+    }
+
+    /* Sort macros by name and keep only the last definition of each name */
+    std::stable_sort(
+        macros.begin(),
+        macros.end(),
+        [](const ShaderMacro& lhs, const ShaderMacro& rhs)
+        {
+            return (std::strcmp(lhs.name, rhs.name) < 0);
+        }
+    );
+
+    std::vector<ShaderMacro> uniqueMacros;
+    uniqueMacros.reserve(macros.size());
+
+    for (std::size_t i = 0; i < macros.size(); ++i)
+    {
+        if (i + 1 < macros.size() && std::strcmp(macros[i].name, macros[i + 1].name) == 0)
+            continue;
+        uniqueMacros.push_back(macros[i]);
+    }
+
+    /* Keep macros that are referenced by the source or by the definition of another kept macro */
+    std::vector<bool> referenced(uniqueMacros.size(), false);
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (std::size_t i = 0; i < uniqueMacros.size(); ++i)
+        {
+            if (referenced[i])
+                continue;
+
+            bool isReferenced = IsIdentifierReferenced(uniqueMacros[i].name);
+
+            for (std::size_t j = 0; j < uniqueMacros.size() && !isReferenced; ++j)
+            {
+                if (!referenced[j] || uniqueMacros[j].definition == nullptr)
+                    continue;
+                const char* definition = uniqueMacros[j].definition;
+                ForEachIdentifier(
+                    definition,
+                    definition + std::strlen(definition),
+                    [&](const char* ident, std::size_t len)
+                    {
+                        if (std::strlen(uniqueMacros[i].name) == len && std::strncmp(uniqueMacros[i].name, ident, len) == 0)
+                            isReferenced = true;
+                    }
+                );
+            }
+
+            if (isReferenced)
+            {
+                referenced[i]   = true;
+                changed         = true;
+            }
+        }
+    }
+
+    /* Build canonical key and null-terminated macro list */
+    for (std::size_t i = 0; i < uniqueMacros.size(); ++i)
+    {
+        if (!referenced[i])
+            continue;
+
+        const auto& macro = uniqueMacros[i];
+        variant.macros.push_back(macro);
+
+        variant.key += macro.name;
+        if (macro.definition != nullptr)
+        {
+            variant.key += '=';
+            variant.key += macro.definition;
+        }
+        variant.key += '\n';
+    }
+
+    variant.macros.push_back(ShaderMacro{});
+    variant.hash = HashFNV1a(variant.key.data(), variant.key.size());
+
+    return variant;
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
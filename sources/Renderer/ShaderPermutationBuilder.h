@@ -0,0 +1,89 @@
+/*
+ * ShaderPermutationBuilder.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_SHADER_PERMUTATION_BUILDER_H
+#define LLGL_SHADER_PERMUTATION_BUILDER_H
+
+
+#include <LLGL/ShaderFlags.h>
+#include <unordered_set>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+/*
+Preprocesses all permutations of a ShaderPermutationDescriptor into unique shader variants.
+Each permutation is reduced to a canonical macro list (sorted by name, last definition wins, unreferenced macros removed),
+which is then hashed to merge permutations that would compile to the same shader.
+All macros still point to the strings of the permutation descriptor, i.e. the descriptor must outlive this builder.
+*/
+class ShaderPermutationBuilder
+{
+
+    public:
+
+        ShaderPermutationBuilder(const ShaderPermutationDescriptor& desc);
+
+        // Returns the number of unique shader variants.
+        inline std::size_t GetNumVariants() const
+        {
+            return variants_.size();
+        }
+
+        // Returns the index of the unique variant that the specified permutation refers to.
+        inline std::size_t GetVariantIndex(std::size_t permutation) const
+        {
+            return permutationVariants_[permutation];
+        }
+
+        // Returns the shader descriptor of the specified variant. The descriptor refers to memory of this builder.
+        ShaderDescriptor GetVariantDesc(std::size_t variant) const;
+
+    private:
+
+        // Canonical form of a permutation.
+        struct Variant
+        {
+            std::vector<ShaderMacro>    macros;     // Null-terminated macro list.
+            std::string                 key;        // Canonical string of all macro definitions.
+            std::uint64_t               hash = 0;
+        };
+
+    private:
+
+        void LoadSource();
+        void ScanIdentifiers();
+
+        bool IsIdentifierReferenced(const std::string& ident) const;
+        Variant MakeVariant(const ShaderMacro* permutation) const;
+
+    private:
+
+        ShaderDescriptor                baseDesc_;
+        std::string                     source_;
+        std::unordered_set<std::string> identifiers_;
+        bool                            pruneMacros_            = true;
+
+        std::vector<Variant>            variants_;
+        std::vector<std::size_t>        permutationVariants_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -90,6 +90,18 @@ namespace ModuleMetal
 
 #endif // /LLGL_BUILD_RENDERER_METAL
 
+#ifdef LLGL_BUILD_RENDERER_NULL
+
+namespace ModuleNull
+{
+    extern int GetRendererID();
+    extern const char* GetModuleName();
+    extern const char* GetRendererName();
+    extern RenderSystem* AllocRenderSystem(const LLGL::RenderSystemDescriptor* renderSystemDesc);
+};
+
+#endif // /LLGL_BUILD_RENDERER_NULL
+
 
 namespace StaticModule
 {
@@ -117,6 +129,9 @@ std::vector<std::string> GetStaticModules()
         #ifdef LLGL_BUILD_RENDERER_DIRECT3D12
         ModuleDirect3D12::GetModuleName(),
         #endif
+        #ifdef LLGL_BUILD_RENDERER_NULL
+        ModuleNull::GetModuleName(),
+        #endif
     };
 }
 
@@ -150,6 +165,10 @@ const char* GetRendererName(const std::string& moduleName)
     LLGL_GET_RENDERER_NAME(ModuleDirect3D12);
     #endif
 
+    #ifdef LLGL_BUILD_RENDERER_NULL
+    LLGL_GET_RENDERER_NAME(ModuleNull);
+    #endif
+
     #undef LLGL_GET_RENDERER_NAME
 
     return nullptr;
@@ -185,6 +204,10 @@ int GetRendererID(const std::string& moduleName)
     LLGL_GET_RENDERER_ID(ModuleDirect3D12);
     #endif
 
+    #ifdef LLGL_BUILD_RENDERER_NULL
+    LLGL_GET_RENDERER_ID(ModuleNull);
+    #endif
+
     #undef LLGL_GET_RENDERER_ID
 
     return RendererID::Undefined;
@@ -220,6 +243,10 @@ RenderSystem* AllocRenderSystem(const RenderSystemDescriptor& renderSystemDesc)
     LLGL_ALLOC_RENDER_SYSTEM(ModuleDirect3D12);
     #endif
 
+    #ifdef LLGL_BUILD_RENDERER_NULL
+    LLGL_ALLOC_RENDER_SYSTEM(ModuleNull);
+    #endif
+
     #undef LLGL_ALLOC_RENDER_SYSTEM
 
     return nullptr;
@@ -10,6 +10,7 @@
 
 
 #include "../Core/Assertion.h"
+#include "VirtualCommandBufferPool.h"
 #include <cstddef>
 #include <algorithm>
 #include <iterator>
@@ -133,17 +134,13 @@ class VirtualCommandBuffer
         // Takes the ownership of the specified virtual command buffer memory.
         VirtualCommandBuffer(VirtualCommandBuffer&& rhs)
         {
-            std::swap(first_, rhs.first_);
-            std::swap(current_, rhs.current_);
-            std::swap(size_, rhs.size_);
+            Swap(rhs);
         }
 
         // Takes the ownership of the specified virtual command buffer memory.
         VirtualCommandBuffer& operator = (VirtualCommandBuffer&& rhs)
         {
-            std::swap(first_, rhs.first_);
-            std::swap(current_, rhs.current_);
-            std::swap(size_, rhs.size_);
+            Swap(rhs);
             return *this;
         }
 
@@ -235,6 +232,14 @@ class VirtualCommandBuffer
             return reinterpret_cast<TCommand*>(data + sizeof(opcode));
         }
 
+        // Allocates a new command with the specified opcode and size (in bytes) and returns a raw pointer to the command data.
+        void* AllocRawCommand(const TOpcode opcode, std::size_t size)
+        {
+            char* data = AllocData(sizeof(opcode) + size);
+            *reinterpret_cast<TOpcode*>(data) = opcode;
+            return (data + sizeof(opcode));
+        }
+
     public:
 
         // STL compatible function to return the constant iterator to the first memory chunk.
@@ -263,26 +268,35 @@ class VirtualCommandBuffer
 
     private:
 
-        // Allocates a new memory chunk of the specified capacity plus sizeof(Chunk).
+        // Swaps all memory chunks and bookkeeping with the specified virtual command buffer.
+        void Swap(VirtualCommandBuffer& rhs)
+        {
+            std::swap(first_, rhs.first_);
+            std::swap(current_, rhs.current_);
+            std::swap(biggest_, rhs.biggest_);
+            std::swap(capacity_, rhs.capacity_);
+            std::swap(size_, rhs.size_);
+            std::swap(initialCapacity_, rhs.initialCapacity_);
+        }
+
+        // Allocates a new memory chunk of at least the specified capacity plus sizeof(Chunk) from the shared chunk pool.
         static Chunk* AllocChunk(std::size_t capacity, Chunk* next = nullptr)
         {
-            Chunk* chunk = reinterpret_cast<Chunk*>(::new std::uint8_t[sizeof(Chunk) + capacity]);
+            std::size_t allocatedSize = 0;
+            Chunk* chunk = reinterpret_cast<Chunk*>(AllocVirtualCommandBufferChunk(sizeof(Chunk) + capacity, allocatedSize));
             {
-                chunk->capacity = capacity;
+                chunk->capacity = allocatedSize - sizeof(Chunk);
                 chunk->size     = 0;
                 chunk->next     = next;
             }
             return chunk;
         }
 
-        // Deletes the specified memory chunk.
+        // Returns the specified memory chunk to the shared chunk pool.
         static void FreeChunk(Chunk* chunk)
         {
             if (chunk != nullptr)
-            {
-                std::uint8_t* buf = reinterpret_cast<std::uint8_t*>(chunk);
-                delete [] buf;
-            }
+                FreeVirtualCommandBufferChunk(chunk, sizeof(Chunk) + chunk->capacity);
         }
 
         // Returns a raw pointer to the beginning of the chunk data.
@@ -310,8 +324,8 @@ class VirtualCommandBuffer
         {
             current_->next = VirtualCommandBuffer::AllocChunk(capacity, next);
             current_ = current_->next;
-            capacity_ += capacity;
-            if (biggest_ == nullptr || capacity > biggest_->capacity)
+            capacity_ += current_->capacity;
+            if (biggest_ == nullptr || current_->capacity > biggest_->capacity)
                 biggest_ = current_;
         }
 
@@ -351,7 +365,7 @@ class VirtualCommandBuffer
                 first_      = VirtualCommandBuffer::AllocChunk(capacity);
                 current_    = first_;
                 biggest_    = first_;
-                capacity_   = capacity;
+                capacity_   = first_->capacity;
             }
         }
 
@@ -429,7 +443,7 @@ class VirtualCommandBuffer
             first_      = chunk;
             current_    = chunk;
             biggest_    = chunk;
-            capacity_   = chunk->size;
+            capacity_   = chunk->capacity;
         }
 
         // Packs the entire virtual command buffer into a new single memory chunk.
@@ -454,7 +468,7 @@ class VirtualCommandBuffer
             first_      = chunk;
             current_    = chunk;
             biggest_    = chunk;
-            capacity_   = chunk->size;
+            capacity_   = chunk->capacity;
         }
 
     private:
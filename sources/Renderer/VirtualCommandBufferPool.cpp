@@ -0,0 +1,435 @@
+/*
+ * VirtualCommandBufferPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VirtualCommandBufferPool.h"
+#include <LLGL/CommandBufferFlags.h>
+#include <atomic>
+#include <algorithm>
+#include <new>
+
+
+namespace LLGL
+{
+
+
+/* ----- Size classes ----- */
+
+// Size classes are powers of two from 256 bytes up to 1 MB.
+static const std::size_t g_minSizeClassShift    = 8;
+static const std::size_t g_numSizeClasses       = 13;
+
+// Maximum number of bytes a thread caches per size class, and the lower and upper bound for the number of cached blocks.
+static const std::size_t g_maxCachedBytes       = (1u << 20);
+static const std::size_t g_minCachedBlocks      = 2;
+static const std::size_t g_maxCachedBlocks      = 64;
+
+// Maximum number of bytes the global pool holds per size class, and the lower and upper bound for the number of queued blocks.
+static const std::size_t g_maxQueuedBytes       = (8u << 20);
+static const std::size_t g_minQueuedBlocks      = 16;
+static const std::size_t g_maxQueuedBlocks      = 256;
+
+static std::size_t GetSizeClassBlockSize(std::size_t sizeClass)
+{
+    return (std::size_t(1) << (g_minSizeClassShift + sizeClass));
+}
+
+// Returns the smallest size class whose blocks can hold the specified size, or g_numSizeClasses if the size is too large.
+static std::size_t FindSizeClass(std::size_t size)
+{
+    std::size_t sizeClass = 0;
+    while (sizeClass < g_numSizeClasses && GetSizeClassBlockSize(sizeClass) < size)
+        ++sizeClass;
+    return sizeClass;
+}
+
+static std::size_t GetMaxCachedBlocks(std::size_t sizeClass)
+{
+    return std::max(g_minCachedBlocks, std::min(g_maxCachedBlocks, g_maxCachedBytes / GetSizeClassBlockSize(sizeClass)));
+}
+
+static std::size_t GetMaxQueuedBlocks(std::size_t sizeClass)
+{
+    return std::max(g_minQueuedBlocks, std::min(g_maxQueuedBlocks, g_maxQueuedBytes / GetSizeClassBlockSize(sizeClass)));
+}
+
+
+/* ----- Global pool ----- */
+
+// Header of an unused block; it overlaps with the beginning of the block memory.
+struct FreeBlock
+{
+    FreeBlock* next;
+};
+
+/*
+Bounded multi-producer/multi-consumer queue of free blocks without locks: Each cell has a sequence number that tells
+producers and consumers whether the cell is ready to be written or read for the current position, which also avoids the ABA problem.
+*/
+class FreeBlockQueue
+{
+
+    public:
+
+        FreeBlockQueue(const FreeBlockQueue&) = delete;
+        FreeBlockQueue& operator = (const FreeBlockQueue&) = delete;
+
+        FreeBlockQueue() :
+            enqueuePos_ { 0 },
+            dequeuePos_ { 0 }
+        {
+            for (std::size_t i = 0; i < g_maxQueuedBlocks; ++i)
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        // Initializes the capacity of this queue; must be a power of two and not greater than g_maxQueuedBlocks.
+        void SetCapacity(std::size_t capacity)
+        {
+            mask_ = capacity - 1;
+        }
+
+        // Returns false if the queue is full.
+        bool Push(FreeBlock* block)
+        {
+            Cell* cell = nullptr;
+            std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &cells_[pos & mask_];
+                const auto seq  = cell->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                if (diff == 0)
+                {
+                    if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return false;
+                else
+                    pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+            cell->block = block;
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Returns null if the queue is empty.
+        FreeBlock* Pop()
+        {
+            Cell* cell = nullptr;
+            std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                cell = &cells_[pos & mask_];
+                const auto seq  = cell->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                        break;
+                }
+                else if (diff < 0)
+                    return nullptr;
+                else
+                    pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+            FreeBlock* block = cell->block;
+            cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+            return block;
+        }
+
+    private:
+
+        struct Cell
+        {
+            std::atomic<std::size_t>    sequence;
+            FreeBlock*                  block;
+        };
+
+    private:
+
+        Cell                        cells_[g_maxQueuedBlocks];
+        std::size_t                 mask_       = 0;
+        std::atomic<std::size_t>    enqueuePos_;
+        std::atomic<std::size_t>    dequeuePos_;
+
+};
+
+class VirtualCommandBufferPool
+{
+
+    public:
+
+        VirtualCommandBufferPool()
+        {
+            for (std::size_t sizeClass = 0; sizeClass < g_numSizeClasses; ++sizeClass)
+                freeQueues_[sizeClass].SetCapacity(GetMaxQueuedBlocks(sizeClass));
+        }
+
+        VirtualCommandBufferPool(const VirtualCommandBufferPool&) = delete;
+        VirtualCommandBufferPool& operator = (const VirtualCommandBufferPool&) = delete;
+
+        ~VirtualCommandBufferPool()
+        {
+            Trim();
+        }
+
+        // Allocates a new block from the heap.
+        void* AllocHeapBlock(std::size_t size)
+        {
+            void* ptr = ::operator new(size);
+            numHeapAllocations_.fetch_add(1, std::memory_order_relaxed);
+            reservedMemory_.fetch_add(size, std::memory_order_relaxed);
+            return ptr;
+        }
+
+        // Returns the block to the heap.
+        void FreeHeapBlock(void* ptr, std::size_t size)
+        {
+            ::operator delete(ptr);
+            numHeapDeallocations_.fetch_add(1, std::memory_order_relaxed);
+            reservedMemory_.fetch_sub(size, std::memory_order_relaxed);
+        }
+
+        // Returns a block of the specified size class from the global queue, or null if the queue is empty.
+        FreeBlock* PopBlock(std::size_t sizeClass)
+        {
+            return freeQueues_[sizeClass].Pop();
+        }
+
+        // Moves the block to the global queue of the specified size class, or returns it to the heap if the queue is full.
+        void PushBlock(std::size_t sizeClass, FreeBlock* block)
+        {
+            if (!freeQueues_[sizeClass].Push(block))
+                FreeHeapBlock(block, GetSizeClassBlockSize(sizeClass));
+        }
+
+        void TrackAlloc(std::size_t size, bool recycled)
+        {
+            if (recycled)
+                numPoolAllocations_.fetch_add(1, std::memory_order_relaxed);
+            usedMemory_.fetch_add(size, std::memory_order_relaxed);
+        }
+
+        void TrackFree(std::size_t size)
+        {
+            usedMemory_.fetch_sub(size, std::memory_order_relaxed);
+        }
+
+        // Returns all blocks of the global queues to the heap.
+        void Trim()
+        {
+            for (std::size_t sizeClass = 0; sizeClass < g_numSizeClasses; ++sizeClass)
+            {
+                const auto blockSize = GetSizeClassBlockSize(sizeClass);
+                while (FreeBlock* block = freeQueues_[sizeClass].Pop())
+                    FreeHeapBlock(block, blockSize);
+            }
+        }
+
+        CommandBufferMemoryStatistics GetStatistics() const
+        {
+            CommandBufferMemoryStatistics stats;
+            {
+                stats.numHeapAllocations    = numHeapAllocations_.load(std::memory_order_relaxed);
+                stats.numHeapDeallocations  = numHeapDeallocations_.load(std::memory_order_relaxed);
+                stats.numPoolAllocations    = numPoolAllocations_.load(std::memory_order_relaxed);
+                stats.reservedMemory        = reservedMemory_.load(std::memory_order_relaxed);
+                stats.usedMemory            = usedMemory_.load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+
+    private:
+
+        FreeBlockQueue              freeQueues_[g_numSizeClasses];
+
+        std::atomic<std::uint64_t>  numHeapAllocations_     { 0 };
+        std::atomic<std::uint64_t>  numHeapDeallocations_   { 0 };
+        std::atomic<std::uint64_t>  numPoolAllocations_     { 0 };
+        std::atomic<std::uint64_t>  reservedMemory_         { 0 };
+        std::atomic<std::uint64_t>  usedMemory_             { 0 };
+
+};
+
+static VirtualCommandBufferPool& GetVirtualCommandBufferPool()
+{
+    static VirtualCommandBufferPool instance;
+    return instance;
+}
+
+
+/* ----- Thread cache ----- */
+
+/*
+Per-thread cache of free blocks for each size class. The cache is refilled from the global queue when it runs empty,
+and half of it is moved to the global queue when it is full. All cached blocks are moved to the global pool when the thread exits.
+*/
+class ThreadChunkCache
+{
+
+    public:
+
+        ThreadChunkCache() :
+            pool_ { GetVirtualCommandBufferPool() }
+        {
+        }
+
+        ThreadChunkCache(const ThreadChunkCache&) = delete;
+        ThreadChunkCache& operator = (const ThreadChunkCache&) = delete;
+
+        ~ThreadChunkCache()
+        {
+            Flush();
+        }
+
+        // Returns a cached block or null if there is neither a block in this cache nor in the global queue.
+        FreeBlock* Pop(std::size_t sizeClass)
+        {
+            auto& bin = bins_[sizeClass];
+            if (bin.first == nullptr)
+                Refill(sizeClass);
+
+            FreeBlock* block = bin.first;
+            if (block != nullptr)
+            {
+                bin.first = block->next;
+                --bin.count;
+            }
+            return block;
+        }
+
+        void Push(std::size_t sizeClass, FreeBlock* block)
+        {
+            auto& bin = bins_[sizeClass];
+            if (bin.count >= GetMaxCachedBlocks(sizeClass))
+                ReleaseBlocks(sizeClass, bin.count / 2);
+
+            block->next = bin.first;
+            bin.first   = block;
+            ++bin.count;
+        }
+
+        // Moves all cached blocks of this thread to the global pool.
+        void Flush()
+        {
+            for (std::size_t sizeClass = 0; sizeClass < g_numSizeClasses; ++sizeClass)
+                ReleaseBlocks(sizeClass, bins_[sizeClass].count);
+        }
+
+    private:
+
+        struct Bin
+        {
+            FreeBlock*  first   = nullptr;
+            std::size_t count   = 0;
+        };
+
+    private:
+
+        // Takes up to a quarter of the cache capacity from the global queue, so that other threads are not starved.
+        void Refill(std::size_t sizeClass)
+        {
+            auto& bin = bins_[sizeClass];
+            const auto maxCount = std::max(std::size_t(1), GetMaxCachedBlocks(sizeClass) / 4);
+            while (bin.count < maxCount)
+            {
+                FreeBlock* block = pool_.PopBlock(sizeClass);
+                if (block == nullptr)
+                    break;
+                block->next = bin.first;
+                bin.first   = block;
+                ++bin.count;
+            }
+        }
+
+        // Moves the first 'count' blocks of the specified bin to the global pool.
+        void ReleaseBlocks(std::size_t sizeClass, std::size_t count)
+        {
+            auto& bin = bins_[sizeClass];
+            for (; count > 0 && bin.first != nullptr; --count)
+            {
+                FreeBlock* block = bin.first;
+                bin.first = block->next;
+                --bin.count;
+                pool_.PushBlock(sizeClass, block);
+            }
+        }
+
+    private:
+
+        VirtualCommandBufferPool&   pool_;
+        Bin                         bins_[g_numSizeClasses];
+
+};
+
+static ThreadChunkCache& GetThreadChunkCache()
+{
+    static thread_local ThreadChunkCache instance;
+    return instance;
+}
+
+
+/* ----- Functions ----- */
+
+LLGL_EXPORT void* AllocVirtualCommandBufferChunk(std::size_t size, std::size_t& allocatedSize)
+{
+    auto& pool = GetVirtualCommandBufferPool();
+
+    const auto sizeClass = FindSizeClass(size);
+    if (sizeClass < g_numSizeClasses)
+    {
+        /* Recycle block from thread cache or global free list */
+        allocatedSize = GetSizeClassBlockSize(sizeClass);
+        if (FreeBlock* block = GetThreadChunkCache().Pop(sizeClass))
+        {
+            pool.TrackAlloc(allocatedSize, true);
+            return block;
+        }
+    }
+    else
+    {
+        /* Allocate oversized blocks with their exact size */
+        allocatedSize = size;
+    }
+
+    void* ptr = pool.AllocHeapBlock(allocatedSize);
+    pool.TrackAlloc(allocatedSize, false);
+    return ptr;
+}
+
+LLGL_EXPORT void FreeVirtualCommandBufferChunk(void* ptr, std::size_t allocatedSize)
+{
+    if (ptr == nullptr)
+        return;
+
+    auto& pool = GetVirtualCommandBufferPool();
+    pool.TrackFree(allocatedSize);
+
+    const auto sizeClass = FindSizeClass(allocatedSize);
+    if (sizeClass < g_numSizeClasses && GetSizeClassBlockSize(sizeClass) == allocatedSize)
+        GetThreadChunkCache().Push(sizeClass, reinterpret_cast<FreeBlock*>(ptr));
+    else
+        pool.FreeHeapBlock(ptr, allocatedSize);
+}
+
+LLGL_EXPORT CommandBufferMemoryStatistics GetCommandBufferMemoryStatistics()
+{
+    return GetVirtualCommandBufferPool().GetStatistics();
+}
+
+LLGL_EXPORT void TrimCommandBufferMemoryPool()
+{
+    GetThreadChunkCache().Flush();
+    GetVirtualCommandBufferPool().Trim();
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,38 @@
+/*
+ * VirtualCommandBufferPool.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VIRTUAL_COMMAND_BUFFER_POOL_H
+#define LLGL_VIRTUAL_COMMAND_BUFFER_POOL_H
+
+
+#include <LLGL/Export.h>
+#include <cstddef>
+
+
+namespace LLGL
+{
+
+
+/*
+Allocates a memory block of at least 'size' bytes for a virtual command buffer chunk and returns the actual size of the block in 'allocatedSize'.
+Blocks are recycled through a process-wide pool with power-of-two size classes; each thread keeps a small cache per size class
+and exchanges blocks with global queues that work without locks. Blocks that exceed the largest size class are allocated from the heap directly.
+*/
+LLGL_EXPORT void* AllocVirtualCommandBufferChunk(std::size_t size, std::size_t& allocatedSize);
+
+// Returns the memory block to the pool. 'allocatedSize' must be the value that was returned by AllocVirtualCommandBufferChunk.
+LLGL_EXPORT void FreeVirtualCommandBufferChunk(void* ptr, std::size_t allocatedSize);
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
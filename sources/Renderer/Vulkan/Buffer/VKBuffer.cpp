@@ -10,6 +10,8 @@
 #include "../VKTypes.h"
 #include "../Ext/VKExtensions.h"
 #include "../Ext/VKExtensionRegistry.h"
+#include "../../BufferUtils.h"
+#include <algorithm>
 
 
 namespace LLGL
@@ -52,10 +54,11 @@ static VkBufferUsageFlags GetVkBufferUsageFlags(const BufferDescriptor& desc)
 }
 
 VKBuffer::VKBuffer(const VKPtr<VkDevice>& device, const BufferDescriptor& desc) :
-    Buffer            { desc.bindFlags },
-    bufferObj_        { device         },
-    bufferObjStaging_ { device         },
-    size_             { desc.size      }
+    Buffer            { desc.bindFlags         },
+    bufferObj_        { device                 },
+    bufferObjStaging_ { device                 },
+    size_             { desc.size              },
+    readback_         { IsReadbackBuffer(desc) }
 {
     if ((desc.bindFlags & BindFlags::IndexBuffer) != 0)
         indexType_ = VKTypes::ToVkIndexType(desc.format);
@@ -101,12 +104,38 @@ void VKBuffer::TakeStagingBuffer(VKDeviceBuffer&& deviceBuffer)
 void* VKBuffer::Map(VkDevice device, const CPUAccess access)
 {
     mappedCPUAccess_ = access;
-    return bufferObjStaging_.Map(device);
+    if (readback_)
+        return bufferObj_.Map(device);
+    else
+        return bufferObjStaging_.Map(device);
 }
 
 void VKBuffer::Unmap(VkDevice device)
 {
-    bufferObjStaging_.Unmap(device);
+    if (readback_)
+        bufferObj_.Unmap(device);
+    else
+        bufferObjStaging_.Unmap(device);
+}
+
+void VKBuffer::InvalidateStagingRange(VkDeviceSize offset, VkDeviceSize size)
+{
+    if (HasInvalidStagingRange())
+    {
+        invalidStagingBegin_    = std::min(invalidStagingBegin_, offset);
+        invalidStagingEnd_      = std::max(invalidStagingEnd_, offset + size);
+    }
+    else
+    {
+        invalidStagingBegin_    = offset;
+        invalidStagingEnd_      = offset + size;
+    }
+}
+
+void VKBuffer::ValidateStagingRange()
+{
+    invalidStagingBegin_    = 0;
+    invalidStagingEnd_      = 0;
 }
 
 
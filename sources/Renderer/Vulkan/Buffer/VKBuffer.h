@@ -35,6 +35,12 @@ class VKBuffer : public Buffer
         void* Map(VkDevice device, const CPUAccess access);
         void Unmap(VkDevice device);
 
+        // Marks the specified range of the staging buffer as outdated, i.e. the GPU local buffer has been updated without it.
+        void InvalidateStagingRange(VkDeviceSize offset, VkDeviceSize size);
+
+        // Marks the entire staging buffer as up to date.
+        void ValidateStagingRange();
+
         // Returns the device buffer object.
         inline VKDeviceBuffer& GetDeviceBuffer()
         {
@@ -77,6 +83,42 @@ class VKBuffer : public Buffer
             return indexType_;
         }
 
+        // Returns true if this is a readback buffer, i.e. the primary buffer is host visible and has no staging buffer.
+        inline bool IsReadback() const
+        {
+            return readback_;
+        }
+
+        // Sets the ID of the upload batch that most recently accessed the staging buffer on the GPU.
+        inline void SetStagingBatchID(std::uint64_t batchID)
+        {
+            stagingBatchID_ = batchID;
+        }
+
+        // Returns the ID of the upload batch that most recently accessed the staging buffer on the GPU.
+        inline std::uint64_t GetStagingBatchID() const
+        {
+            return stagingBatchID_;
+        }
+
+        // Returns true if a range of the staging buffer is outdated.
+        inline bool HasInvalidStagingRange() const
+        {
+            return (invalidStagingBegin_ < invalidStagingEnd_);
+        }
+
+        // Returns the start offset of the outdated staging buffer range.
+        inline VkDeviceSize GetInvalidStagingOffset() const
+        {
+            return invalidStagingBegin_;
+        }
+
+        // Returns the size of the outdated staging buffer range.
+        inline VkDeviceSize GetInvalidStagingSize() const
+        {
+            return (invalidStagingEnd_ - invalidStagingBegin_);
+        }
+
     private:
 
         VKDeviceBuffer  bufferObj_;
@@ -86,6 +128,11 @@ class VKBuffer : public Buffer
         CPUAccess       mappedCPUAccess_    = CPUAccess::ReadOnly;
 
         VkIndexType     indexType_          = VK_INDEX_TYPE_MAX_ENUM;
+        bool            readback_           = false;
+
+        std::uint64_t   stagingBatchID_         = 0;
+        VkDeviceSize    invalidStagingBegin_    = 0;
+        VkDeviceSize    invalidStagingEnd_      = 0;
 
 };
 
@@ -11,6 +11,7 @@
 
 #include "VKDeviceMemoryRegion.h"
 #include "../VKPtr.h"
+#include "../../../Core/TLSFAllocator.h"
 #include <vulkan/vulkan.h>
 #include <cstdint>
 #include <vector>
@@ -29,10 +30,10 @@ namespace LLGL
 struct VKDeviceMemoryDetails
 {
     std::size_t     numChunks               = 0;
-    std::size_t     numBlocks               = 0;
-    std::size_t     numFragments            = 0;
-    VkDeviceSize    maxNewBlockSize         = 0;
-    VkDeviceSize    maxFragmentedBlockSize  = 0;
+    std::size_t     numBlocks               = 0;    // Number of allocated blocks.
+    std::size_t     numFragments            = 0;    // Number of free ranges.
+    VkDeviceSize    maxNewBlockSize         = 0;    // Maximal size of the free ranges at the end of each chunk.
+    VkDeviceSize    maxFragmentedBlockSize  = 0;    // Maximal size of all free ranges.
 };
 
 // An instance of this class holds a single VkDeviceMemory allocation chunk.
@@ -52,7 +53,10 @@ class VKDeviceMemory
         void* Map(VkDevice device, VkDeviceSize offset, VkDeviceSize size);
         void Unmap(VkDevice device);
 
-        // Tries to allocate a new block within this device memory chunk, and returns null of failure.
+        /*
+        Tries to allocate a new block within this device memory chunk, and returns null of failure.
+        If 'reduceFragmentation' is true, the smallest free range of the request's size class is preferred.
+        */
         VKDeviceMemoryRegion* Allocate(VkDeviceSize size, VkDeviceSize alignment, bool reduceFragmentation = false);
 
         // Releases the specified block within this device memory chunk.
@@ -94,48 +98,12 @@ class VKDeviceMemory
 
     private:
 
-        // Returns the next offset after the last block.
-        VkDeviceSize GetNextOffset() const;
-
-        // Makes a new device memory block.
-        std::unique_ptr<VKDeviceMemoryRegion> MakeUniqueBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
-
-        // Allocates a new block.
-        VKDeviceMemoryRegion* AllocAndAppendBlock(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
-
-        // Inserts the specified region into the main block list by insertion-sort.
-        VKDeviceMemoryRegion* InsertBlock(std::unique_ptr<VKDeviceMemoryRegion>&& region);
-
-        // Tries to find a fragmented block that can be reused.
-        VKDeviceMemoryRegion* FindReusableBlock(VkDeviceSize alignedSize, VkDeviceSize alignment);
-
-        // Updates the maximal size of fragmanted blocks.
-        void UpdateMaxFragmentedBlockSize();
-
-        // Inserts the specified region into the fragmented block list by insertion-sort.
-        void InsertBlockToFragmentsSorted(std::unique_ptr<VKDeviceMemoryRegion>&& region);
-
-        // Inserts the specified region into the fragmented block list at the specified position and merges it with surrounding blocks if possible.
-        void InsertBlockToFragmentsAt(std::unique_ptr<VKDeviceMemoryRegion>&& region, std::size_t position);
-
-        // Merges the two fragmented blocks and records the maximal fragmented block size.
-        bool MergeFragmentedBlockWith(VKDeviceMemoryRegion& region, VKDeviceMemoryRegion& appendixRegion);
-
-        // Returns the offset after the specified fragmented block.
-        VkDeviceSize GetFragmentBlockOffsetEnd(std::size_t position) const;
-
-        // Increases the maximal fragmented block size.
-        void IncMaxFragmentedBlockSize(VkDeviceSize size);
-
         VKPtr<VkDeviceMemory>                               deviceMemory_;
-        VkDeviceSize                                        size_                   = 0;
-        std::uint32_t                                       memoryTypeIndex_        = 0;
-
-        VkDeviceSize                                        maxNewBlockSize_        = 0;
-        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  blocks_;
+        VkDeviceSize                                        size_               = 0;
+        std::uint32_t                                       memoryTypeIndex_    = 0;
 
-        VkDeviceSize                                        maxFragmentedBlockSize_ = 0;
-        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  fragmentedBlocks_;
+        TLSFAllocator                                       allocator_;
+        std::vector<std::unique_ptr<VKDeviceMemoryRegion>>  regions_;           // Indexed by the allocator's block handles
 
 };
 
@@ -25,6 +25,7 @@ VKDeviceMemoryManager::VKDeviceMemoryManager(
     minAllocationSize_   { minAllocationSize   },
     reduceFragmentation_ { reduceFragmentation }
 {
+    chunkSets_.resize(memoryProperties.memoryTypeCount);
 }
 
 VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
@@ -35,12 +36,16 @@ VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
 {
     const auto alignedSize      = GetAlignedSize(size, alignment);
     const auto memoryTypeIndex  = FindMemoryType(memoryTypeBits, properties);
-    const auto allocationSize   = std::max(minAllocationSize_, alignedSize);
 
-    if (auto chunk = FindOrAllocChunk(allocationSize, memoryTypeIndex, alignedSize))
-        return chunk->Allocate(size, alignment);
-    else
-        return nullptr;
+    /* Try to allocate region in an existing chunk */
+    if (auto region = AllocFromChunks(size, alignment, memoryTypeIndex))
+        return region;
+
+    /* Allocate new chunk; its first region always starts at offset 0, so no alignment padding is required */
+    const auto allocationSize = std::max(minAllocationSize_, alignedSize);
+    auto chunk = AllocChunk(allocationSize, memoryTypeIndex);
+
+    return AllocFromChunk(*chunk, size, alignment);
 }
 
 VKDeviceMemoryRegion* VKDeviceMemoryManager::Allocate(
@@ -62,11 +67,13 @@ void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
         if (auto chunk = region->GetParentChunk())
         {
             /* Release block in chunk */
+            const auto prevMaxAllocationSize = chunk->GetMaxAllocationSize();
             chunk->Release(region);
 
             /* Release chunk if it's empty */
             if (chunk->IsEmpty())
             {
+                chunkSets_[chunk->GetMemoryTypeIndex()].erase({ prevMaxAllocationSize, chunk });
                 RemoveFromListIf(
                     chunks_,
                     [chunk](std::unique_ptr<VKDeviceMemory>& entry)
@@ -75,6 +82,8 @@ void VKDeviceMemoryManager::Release(VKDeviceMemoryRegion* region)
                     }
                 );
             }
+            else
+                UpdateChunkEntry(*chunk, prevMaxAllocationSize);
         }
     }
 }
@@ -129,20 +138,55 @@ std::uint32_t VKDeviceMemoryManager::FindMemoryType(std::uint32_t memoryTypeBits
 
 VKDeviceMemory* VKDeviceMemoryManager::AllocChunk(VkDeviceSize size, std::uint32_t memoryTypeIndex)
 {
-    return TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
+    auto chunk = TakeOwnership(chunks_, MakeUnique<VKDeviceMemory>(device_, size, memoryTypeIndex));
+    chunkSets_[memoryTypeIndex].insert({ chunk->GetMaxAllocationSize(), chunk });
+    return chunk;
 }
 
-VKDeviceMemory* VKDeviceMemoryManager::FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize)
+VKDeviceMemoryRegion* VKDeviceMemoryManager::AllocFromChunks(VkDeviceSize size, VkDeviceSize alignment, std::uint32_t memoryTypeIndex)
 {
-    /* Search for a suitable chunk */
-    for (const auto& chunk : chunks_)
+    const auto  alignedSize = GetAlignedSize(size, alignment);
+    const auto& chunkSet    = chunkSets_[memoryTypeIndex];
+
+    /* Search for the chunk with the smallest maximal allocation size that fits */
+    auto it = chunkSet.lower_bound({ alignedSize, nullptr });
+    if (it == chunkSet.end())
+        return nullptr;
+
+    if (auto region = AllocFromChunk(*it->second, size, alignment))
+        return region;
+
+    /* Search for a chunk that fits the request with the worst case alignment padding */
+    if (alignment > 1)
     {
-        if (chunk->GetMaxAllocationSize() >= minFreeBlockSize && chunk->GetMemoryTypeIndex() == memoryTypeIndex)
-            return chunk.get();
+        it = chunkSet.lower_bound({ alignedSize + alignment - 1, nullptr });
+        if (it != chunkSet.end())
+            return AllocFromChunk(*it->second, size, alignment);
     }
 
-    /* Allocate new chunk */
-    return AllocChunk(allocationSize, memoryTypeIndex);
+    return nullptr;
+}
+
+VKDeviceMemoryRegion* VKDeviceMemoryManager::AllocFromChunk(VKDeviceMemory& chunk, VkDeviceSize size, VkDeviceSize alignment)
+{
+    const auto prevMaxAllocationSize = chunk.GetMaxAllocationSize();
+
+    auto region = chunk.Allocate(size, alignment, reduceFragmentation_);
+    if (region)
+        UpdateChunkEntry(chunk, prevMaxAllocationSize);
+
+    return region;
+}
+
+void VKDeviceMemoryManager::UpdateChunkEntry(VKDeviceMemory& chunk, VkDeviceSize prevMaxAllocationSize)
+{
+    const auto maxAllocationSize = chunk.GetMaxAllocationSize();
+    if (maxAllocationSize != prevMaxAllocationSize)
+    {
+        auto& chunkSet = chunkSets_[chunk.GetMemoryTypeIndex()];
+        chunkSet.erase({ prevMaxAllocationSize, &chunk });
+        chunkSet.insert({ maxAllocationSize, &chunk });
+    }
 }
 
 
@@ -16,6 +16,8 @@
 #include "VKDeviceMemoryRegion.h"
 #include <vector>
 #include <memory>
+#include <set>
+#include <utility>
 
 
 namespace LLGL
@@ -83,11 +85,20 @@ class VKDeviceMemoryManager
         // Allocates a new VkDeviceMemory chunk of the specified size and memory type.
         VKDeviceMemory* AllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex);
 
-        // Finds a suitable device memory chunk or allocates a new one.
-        VKDeviceMemory* FindOrAllocChunk(VkDeviceSize allocationSize, std::uint32_t memoryTypeIndex, VkDeviceSize minFreeBlockSize);
+        // Tries to allocate a region in one of the existing chunks of the specified memory type.
+        VKDeviceMemoryRegion* AllocFromChunks(VkDeviceSize size, VkDeviceSize alignment, std::uint32_t memoryTypeIndex);
+
+        // Tries to allocate a region in the specified chunk and updates its entry in the chunk set.
+        VKDeviceMemoryRegion* AllocFromChunk(VKDeviceMemory& chunk, VkDeviceSize size, VkDeviceSize alignment);
+
+        // Updates the entry of the specified chunk after its maximal allocation size has changed.
+        void UpdateChunkEntry(VKDeviceMemory& chunk, VkDeviceSize prevMaxAllocationSize);
 
     private:
 
+        // Chunks of a single memory type, sorted by their maximal allocation size.
+        using VKDeviceMemorySet = std::set<std::pair<VkDeviceSize, VKDeviceMemory*>>;
+
         const VKPtr<VkDevice>&                          device_;
         VkPhysicalDeviceMemoryProperties                memoryProperties_;
 
@@ -95,6 +106,7 @@ class VKDeviceMemoryManager
         bool                                            reduceFragmentation_    = false;
 
         std::vector<std::unique_ptr<VKDeviceMemory>>    chunks_;
+        std::vector<VKDeviceMemorySet>                  chunkSets_;             // Indexed by memory type index
 
 };
 
@@ -14,11 +14,12 @@ namespace LLGL
 {
 
 
-VKDeviceMemoryRegion::VKDeviceMemoryRegion(VKDeviceMemory* deviceMemory, VkDeviceSize alignedSize, VkDeviceSize alignedOffset, std::uint32_t memoryTypeIndex) :
+VKDeviceMemoryRegion::VKDeviceMemoryRegion(VKDeviceMemory* deviceMemory, VkDeviceSize alignedSize, VkDeviceSize alignedOffset, std::uint32_t memoryTypeIndex, std::uint32_t block) :
     deviceMemory_    { deviceMemory    },
     size_            { alignedSize     },
     offset_          { alignedOffset   },
-    memoryTypeIndex_ { memoryTypeIndex }
+    memoryTypeIndex_ { memoryTypeIndex },
+    block_           { block           }
 {
 }
 
@@ -33,39 +34,6 @@ void VKDeviceMemoryRegion::BindImage(VkDevice device, VkImage image)
 }
 
 
-/*
- * ======= Protected: =======
- */
-
-bool VKDeviceMemoryRegion::MergeWith(VKDeviceMemoryRegion& other)
-{
-    if (GetParentChunk() == other.GetParentChunk() && GetMemoryTypeIndex() == other.GetMemoryTypeIndex())
-    {
-        /* Check if this region is a direct lower part */
-        if (GetOffsetWithSize() == other.GetOffset())
-        {
-            size_ += other.GetSize();
-            return true;
-        }
-
-        /* Check if this region is a direct upper part */
-        if (other.GetOffsetWithSize() == GetOffset())
-        {
-            offset_ = other.GetOffset();
-            size_ += other.GetSize();
-            return true;
-        }
-    }
-    return false;
-}
-
-void VKDeviceMemoryRegion::MoveAt(VkDeviceSize alignedSize, VkDeviceSize alignedOffset)
-{
-    size_   = alignedSize;
-    offset_ = alignedOffset;
-}
-
-
 } // /namespace LLGL
 
 
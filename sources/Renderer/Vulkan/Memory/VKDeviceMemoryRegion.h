@@ -25,7 +25,7 @@ class VKDeviceMemoryRegion
 
     public:
 
-        VKDeviceMemoryRegion(VKDeviceMemory* deviceMemory, VkDeviceSize alignedSize, VkDeviceSize alignedOffset, std::uint32_t memoryTypeIndex);
+        VKDeviceMemoryRegion(VKDeviceMemory* deviceMemory, VkDeviceSize alignedSize, VkDeviceSize alignedOffset, std::uint32_t memoryTypeIndex, std::uint32_t block);
 
         // Binds the specified buffer to this memory region.
         void BindBuffer(VkDevice device, VkBuffer buffer);
@@ -67,11 +67,11 @@ class VKDeviceMemoryRegion
 
         friend class VKDeviceMemory;
 
-        // Tries to merge the specified region into this region, and returns true on success.
-        bool MergeWith(VKDeviceMemoryRegion& other);
-
-        // Sets the new size and offset.
-        void MoveAt(VkDeviceSize alignedSize, VkDeviceSize alignedOffset);
+        // Returns the block handle of the parent chunk's allocator.
+        inline std::uint32_t GetBlock() const
+        {
+            return block_;
+        }
 
     private:
 
@@ -79,6 +79,7 @@ class VKDeviceMemoryRegion
         VkDeviceSize    size_               = 0;
         VkDeviceSize    offset_             = 0;
         std::uint32_t   memoryTypeIndex_    = 0;
+        std::uint32_t   block_              = 0;
 
 };
 
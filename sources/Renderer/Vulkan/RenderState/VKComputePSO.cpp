@@ -21,15 +21,17 @@ namespace LLGL
 VKComputePSO::VKComputePSO(
     const VKPtr<VkDevice>&              device,
     const ComputePipelineDescriptor&    desc,
-    VkPipelineLayout                    defaultPipelineLayout)
+    VkPipelineLayout                    defaultPipelineLayout,
+    VkPipelineCache                     pipelineCache)
 :
-    VKPipelineState { device, VK_PIPELINE_BIND_POINT_COMPUTE }
+    VKPipelineState { device, VK_PIPELINE_BIND_POINT_COMPUTE, desc.pipelineLayout, defaultPipelineLayout }
 {
     /* Create Vulkan compute pipeline object */
     CreateVkPipeline(
         device,
-        GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout),
-        desc
+        GetVkPipelineLayout(),
+        desc,
+        pipelineCache
     );
 }
 
@@ -41,7 +43,8 @@ VKComputePSO::VKComputePSO(
 void VKComputePSO::CreateVkPipeline(
     VkDevice                            device,
     VkPipelineLayout                    pipelineLayout,
-    const ComputePipelineDescriptor&    desc)
+    const ComputePipelineDescriptor&    desc,
+    VkPipelineCache                     pipelineCache)
 {
     /* Get shader program object */
     auto shaderProgramVK = LLGL_CAST(const VKShaderProgram*, desc.shaderProgram);
@@ -67,7 +70,7 @@ void VKComputePSO::CreateVkPipeline(
         createInfo.basePipelineHandle   = VK_NULL_HANDLE;
         createInfo.basePipelineIndex    = 0;
     }
-    auto result = vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, GetVkPipelineAddress());
+    auto result = vkCreateComputePipelines(device, pipelineCache, 1, &createInfo, nullptr, GetVkPipelineAddress());
     VKThrowIfFailed(result, "failed to create Vulkan compute pipeline");
 }
 
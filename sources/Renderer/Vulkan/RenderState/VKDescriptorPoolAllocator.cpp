@@ -0,0 +1,310 @@
+/*
+ * VKDescriptorPoolAllocator.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKDescriptorPoolAllocator.h"
+#include "VKPipelineLayout.h"
+#include "../VKCore.h"
+#include <algorithm>
+
+
+namespace LLGL
+{
+
+
+// Number of descriptor sets of the first and the largest descriptor pool within a bucket.
+static const std::uint32_t g_minSetsPerPool = 32;
+static const std::uint32_t g_maxSetsPerPool = 1024;
+
+static const VkDescriptorType g_descriptorTypes[] =
+{
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+// Returns the size class exponent for the specified number of descriptors, i.e. 0 for none and (log2(n) + 1) otherwise (rounded up).
+static std::uint32_t GetSizeClassExponent(std::uint32_t count)
+{
+    std::uint32_t exponent = 0;
+    if (count > 0)
+    {
+        for (exponent = 1; (1u << (exponent - 1)) < count; ++exponent);
+    }
+    return exponent;
+}
+
+// Returns the number of descriptors of the specified type index for a descriptor set of the specified size class.
+static std::uint32_t GetSizeClassDescriptorCount(std::uint32_t sizeClass, int typeIndex)
+{
+    const auto exponent = ((sizeClass >> (typeIndex * 8)) & 0xFF);
+    return (exponent > 0 ? (1u << (exponent - 1)) : 0);
+}
+
+static int FindDescriptorTypeIndex(VkDescriptorType type)
+{
+    for (int i = 0; i < static_cast<int>(sizeof(g_descriptorTypes)/sizeof(g_descriptorTypes[0])); ++i)
+    {
+        if (g_descriptorTypes[i] == type)
+            return i;
+    }
+    return -1;
+}
+
+VKDescriptorPoolAllocator::Pool::Pool(const VKPtr<VkDevice>& device) :
+    descriptorPool { device, vkDestroyDescriptorPool }
+{
+}
+
+VKDescriptorPoolAllocator::VKDescriptorPoolAllocator(const VKPtr<VkDevice>& device) :
+    device_ { device }
+{
+}
+
+void VKDescriptorPoolAllocator::Allocate(
+    const VKPipelineLayout&     pipelineLayout,
+    std::uint32_t               numSets,
+    VKDescriptorSetAllocation&  outAllocation)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    auto& entry = GetOrCreateLayoutEntry(pipelineLayout);
+
+    outAllocation.setLayout = pipelineLayout.GetVkDescriptorSetLayout();
+    outAllocation.layoutID  = entry.id;
+    outAllocation.descriptorSets.clear();
+    outAllocation.descriptorSets.reserve(numSets);
+    outAllocation.poolIndices.clear();
+    outAllocation.poolIndices.reserve(numSets);
+
+    /* Reuse released descriptor sets of the same layout first */
+    for (; numSets > 0 && !entry.freeSets.empty(); --numSets)
+    {
+        outAllocation.descriptorSets.push_back(entry.freeSets.back().first);
+        outAllocation.poolIndices.push_back(entry.freeSets.back().second);
+        entry.freeSets.pop_back();
+    }
+
+    if (numSets > 0)
+    {
+        try
+        {
+            AllocateFromBucket(entry.sizeClass, outAllocation.setLayout, numSets, outAllocation);
+        }
+        catch (...)
+        {
+            /* Keep descriptor sets that have been allocated so far in the free-list */
+            for (std::size_t i = 0; i < outAllocation.descriptorSets.size(); ++i)
+                entry.freeSets.emplace_back(outAllocation.descriptorSets[i], outAllocation.poolIndices[i]);
+            outAllocation.descriptorSets.clear();
+            outAllocation.poolIndices.clear();
+            throw;
+        }
+    }
+}
+
+void VKDescriptorPoolAllocator::Release(VKDescriptorSetAllocation& allocation)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    std::vector<std::pair<VkDescriptorSet, std::uint32_t>> descriptorSets;
+    descriptorSets.reserve(allocation.descriptorSets.size());
+
+    for (std::size_t i = 0; i < allocation.descriptorSets.size(); ++i)
+        descriptorSets.emplace_back(allocation.descriptorSets[i], allocation.poolIndices[i]);
+
+    /* Move descriptor sets into free-list, or free them immediately if their set layout has already been released */
+    auto it = layouts_.find(allocation.setLayout);
+    if (it != layouts_.end() && it->second.id == allocation.layoutID)
+        it->second.freeSets.insert(it->second.freeSets.end(), descriptorSets.begin(), descriptorSets.end());
+    else
+        FreeDescriptorSets(descriptorSets);
+
+    allocation.descriptorSets.clear();
+    allocation.poolIndices.clear();
+}
+
+void VKDescriptorPoolAllocator::ReleaseSetLayout(VkDescriptorSetLayout setLayout)
+{
+    std::lock_guard<std::mutex> guard { mutex_ };
+
+    auto it = layouts_.find(setLayout);
+    if (it != layouts_.end())
+    {
+        FreeDescriptorSets(it->second.freeSets);
+        layouts_.erase(it);
+    }
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+VKDescriptorPoolAllocator::LayoutEntry& VKDescriptorPoolAllocator::GetOrCreateLayoutEntry(const VKPipelineLayout& pipelineLayout)
+{
+    auto& entry = layouts_[pipelineLayout.GetVkDescriptorSetLayout()];
+    if (entry.id == 0)
+    {
+        /* Accumulate number of descriptors per type */
+        std::uint32_t numDescriptors[NumDescriptorTypes] = {};
+
+        for (const auto& binding : pipelineLayout.GetBindings())
+        {
+            auto typeIndex = FindDescriptorTypeIndex(binding.descriptorType);
+            if (typeIndex >= 0)
+                numDescriptors[typeIndex] += binding.descriptorCount;
+        }
+
+        /* Determine size class with 8 bits for the exponent of each descriptor type */
+        entry.id = nextLayoutID_++;
+        for (int i = 0; i < NumDescriptorTypes; ++i)
+            entry.sizeClass |= (GetSizeClassExponent(numDescriptors[i]) << (i * 8));
+    }
+    return entry;
+}
+
+void VKDescriptorPoolAllocator::AllocateFromBucket(
+    std::uint32_t               sizeClass,
+    VkDescriptorSetLayout       setLayout,
+    std::uint32_t               numSets,
+    VKDescriptorSetAllocation&  outAllocation)
+{
+    auto& bucket = buckets_[sizeClass];
+
+    std::vector<VkDescriptorSetLayout> setLayouts;
+    bool reclaimed = false;
+
+    for (std::size_t i = 0; numSets > 0;)
+    {
+        /* Select next pool of this bucket; reclaim cached sets of other layouts once before a new pool is created */
+        std::uint32_t poolIndex = 0;
+
+        if (i < bucket.poolIndices.size())
+            poolIndex = bucket.poolIndices[i++];
+        else if (!reclaimed && ReclaimFreeSets(sizeClass))
+        {
+            reclaimed   = true;
+            i           = 0;
+            continue;
+        }
+        else
+        {
+            poolIndex = AppendPool(sizeClass, bucket);
+            ++i;
+        }
+
+        auto& pool = pools_[poolIndex];
+
+        const auto numPoolSets = std::min(numSets, pool.maxSets - pool.numSets);
+        if (numPoolSets == 0)
+            continue;
+
+        /* Allocate as many descriptor sets as possible from the selected pool */
+        setLayouts.assign(numPoolSets, setLayout);
+
+        const auto first = outAllocation.descriptorSets.size();
+        outAllocation.descriptorSets.resize(first + numPoolSets, VK_NULL_HANDLE);
+
+        VkDescriptorSetAllocateInfo allocInfo;
+        {
+            allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocInfo.pNext                 = nullptr;
+            allocInfo.descriptorPool        = pool.descriptorPool;
+            allocInfo.descriptorSetCount    = numPoolSets;
+            allocInfo.pSetLayouts           = setLayouts.data();
+        }
+        auto result = vkAllocateDescriptorSets(device_, &allocInfo, &(outAllocation.descriptorSets[first]));
+        if (result != VK_SUCCESS)
+            outAllocation.descriptorSets.resize(first);
+        VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
+
+        outAllocation.poolIndices.resize(first + numPoolSets, poolIndex);
+        pool.numSets    += numPoolSets;
+        numSets         -= numPoolSets;
+    }
+}
+
+std::uint32_t VKDescriptorPoolAllocator::AppendPool(std::uint32_t sizeClass, Bucket& bucket)
+{
+    Pool pool{ device_ };
+
+    /* Double the pool size with each new pool of this bucket */
+    if (bucket.nextMaxSets == 0)
+        bucket.nextMaxSets = g_minSetsPerPool;
+
+    pool.maxSets        = bucket.nextMaxSets;
+    bucket.nextMaxSets  = std::min(bucket.nextMaxSets * 2, g_maxSetsPerPool);
+
+    /* Initialize descriptor pool sizes for the size class of this bucket */
+    VkDescriptorPoolSize poolSizes[NumDescriptorTypes];
+    std::uint32_t numPoolSizes = 0;
+
+    for (int i = 0; i < NumDescriptorTypes; ++i)
+    {
+        if (auto descriptorCount = GetSizeClassDescriptorCount(sizeClass, i))
+        {
+            poolSizes[numPoolSizes].type            = g_descriptorTypes[i];
+            poolSizes[numPoolSizes].descriptorCount = descriptorCount * pool.maxSets;
+            ++numPoolSizes;
+        }
+    }
+
+    /* Create descriptor pool; all sets have the same size class, so freeing them individually does not fragment the pool */
+    VkDescriptorPoolCreateInfo poolCreateInfo;
+    {
+        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.pNext            = nullptr;
+        poolCreateInfo.flags            = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        poolCreateInfo.maxSets          = pool.maxSets;
+        poolCreateInfo.poolSizeCount    = numPoolSizes;
+        poolCreateInfo.pPoolSizes       = poolSizes;
+    }
+    auto result = vkCreateDescriptorPool(device_, &poolCreateInfo, nullptr, pool.descriptorPool.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool");
+
+    const auto poolIndex = static_cast<std::uint32_t>(pools_.size());
+    pools_.push_back(std::move(pool));
+    bucket.poolIndices.push_back(poolIndex);
+
+    return poolIndex;
+}
+
+bool VKDescriptorPoolAllocator::ReclaimFreeSets(std::uint32_t sizeClass)
+{
+    bool reclaimed = false;
+
+    for (auto& layout : layouts_)
+    {
+        auto& entry = layout.second;
+        if (entry.sizeClass == sizeClass && !entry.freeSets.empty())
+        {
+            FreeDescriptorSets(entry.freeSets);
+            entry.freeSets.clear();
+            reclaimed = true;
+        }
+    }
+
+    return reclaimed;
+}
+
+void VKDescriptorPoolAllocator::FreeDescriptorSets(const std::vector<std::pair<VkDescriptorSet, std::uint32_t>>& descriptorSets)
+{
+    for (const auto& descriptorSet : descriptorSets)
+    {
+        auto& pool = pools_[descriptorSet.second];
+        vkFreeDescriptorSets(device_, pool.descriptorPool, 1, &(descriptorSet.first));
+        --pool.numSets;
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
@@ -0,0 +1,146 @@
+/*
+ * VKDescriptorPoolAllocator.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_DESCRIPTOR_POOL_ALLOCATOR_H
+#define LLGL_VK_DESCRIPTOR_POOL_ALLOCATOR_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <unordered_map>
+#include <vector>
+#include <utility>
+#include <mutex>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class VKPipelineLayout;
+
+// Descriptor sets that have been allocated for a single descriptor set layout by VKDescriptorPoolAllocator.
+struct VKDescriptorSetAllocation
+{
+    VkDescriptorSetLayout           setLayout       = VK_NULL_HANDLE;
+    std::uint64_t                   layoutID        = 0;    // Allocator internal identifier to detect set layouts that have been released in the meantime.
+    std::vector<VkDescriptorSet>    descriptorSets;
+    std::vector<std::uint32_t>      poolIndices;            // Allocator internal index of the descriptor pool for each descriptor set.
+};
+
+/*
+Device-wide allocator for long-living descriptor sets, e.g. those of resource heaps.
+Descriptor pools are grouped into buckets of size classes, i.e. the number of descriptors per type of each descriptor set
+is rounded up to the next power of two, so all sets within a pool have the same size and freeing them cannot fragment the pool.
+Released descriptor sets are kept in a free-list for their descriptor set layout, so they can be reused without any Vulkan call.
+All functions are thread-safe.
+*/
+class VKDescriptorPoolAllocator
+{
+
+    public:
+
+        VKDescriptorPoolAllocator(const VKPtr<VkDevice>& device);
+
+        VKDescriptorPoolAllocator(const VKDescriptorPoolAllocator&) = delete;
+        VKDescriptorPoolAllocator& operator = (const VKDescriptorPoolAllocator&) = delete;
+
+        // Allocates the specified number of descriptor sets for the descriptor set layout of the specified pipeline layout.
+        void Allocate(
+            const VKPipelineLayout&     pipelineLayout,
+            std::uint32_t               numSets,
+            VKDescriptorSetAllocation&  outAllocation
+        );
+
+        // Moves all descriptor sets of the specified allocation into the free-list of their descriptor set layout.
+        void Release(VKDescriptorSetAllocation& allocation);
+
+        // Frees all cached descriptor sets of the specified descriptor set layout. This must be called before the layout is destroyed.
+        void ReleaseSetLayout(VkDescriptorSetLayout setLayout);
+
+    private:
+
+        // Descriptor types that are supported by pipeline layouts.
+        enum DescriptorTypeIndex
+        {
+            DescriptorTypeSampler = 0,
+            DescriptorTypeSampledImage,
+            DescriptorTypeUniformBuffer,
+            DescriptorTypeStorageBuffer,
+
+            NumDescriptorTypes,
+        };
+
+        // Native descriptor pool where each descriptor set has the size of its bucket's size class.
+        struct Pool
+        {
+            Pool(const VKPtr<VkDevice>& device);
+
+            VKPtr<VkDescriptorPool> descriptorPool;
+            std::uint32_t           maxSets         = 0;
+            std::uint32_t           numSets         = 0;
+        };
+
+        // Descriptor pools of a single size class.
+        struct Bucket
+        {
+            std::vector<std::uint32_t>  poolIndices;
+            std::uint32_t               nextMaxSets = 0;
+        };
+
+        // Free-list of descriptor sets for a single descriptor set layout.
+        struct LayoutEntry
+        {
+            std::uint64_t                                           id          = 0;
+            std::uint32_t                                           sizeClass   = 0;
+            std::vector<std::pair<VkDescriptorSet, std::uint32_t>>  freeSets;
+        };
+
+    private:
+
+        // Returns the entry for the specified set layout and creates it on first use.
+        LayoutEntry& GetOrCreateLayoutEntry(const VKPipelineLayout& pipelineLayout);
+
+        // Allocates the specified number of descriptor sets from the pools of the specified size class.
+        void AllocateFromBucket(
+            std::uint32_t               sizeClass,
+            VkDescriptorSetLayout       setLayout,
+            std::uint32_t               numSets,
+            VKDescriptorSetAllocation&  outAllocation
+        );
+
+        // Creates a new descriptor pool for the specified size class and returns its index.
+        std::uint32_t AppendPool(std::uint32_t sizeClass, Bucket& bucket);
+
+        // Frees the cached descriptor sets of all layouts with the specified size class. Returns true if any set has been freed.
+        bool ReclaimFreeSets(std::uint32_t sizeClass);
+
+        // Returns the specified descriptor sets to their native descriptor pools.
+        void FreeDescriptorSets(const std::vector<std::pair<VkDescriptorSet, std::uint32_t>>& descriptorSets);
+
+    private:
+
+        const VKPtr<VkDevice>&                                      device_;
+        std::mutex                                                  mutex_;
+
+        std::vector<Pool>                                           pools_;
+        std::unordered_map<std::uint32_t, Bucket>                   buckets_;       // Indexed by size class
+        std::unordered_map<VkDescriptorSetLayout, LayoutEntry>      layouts_;
+        std::uint64_t                                               nextLayoutID_   = 1;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
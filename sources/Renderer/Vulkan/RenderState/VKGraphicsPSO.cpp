@@ -27,9 +27,10 @@ VKGraphicsPSO::VKGraphicsPSO(
     VkPipelineLayout                    defaultPipelineLayout,
     const RenderPass*                   defaultRenderPass,
     const GraphicsPipelineDescriptor&   desc,
-    const VKGraphicsPipelineLimits&     limits)
+    const VKGraphicsPipelineLimits&     limits,
+    VkPipelineCache                     pipelineCache)
 :
-    VKPipelineState    { device, VK_PIPELINE_BIND_POINT_GRAPHICS },
+    VKPipelineState    { device, VK_PIPELINE_BIND_POINT_GRAPHICS, desc.pipelineLayout, defaultPipelineLayout },
     scissorEnabled_    { desc.rasterizer.scissorTestEnabled      },
     hasDynamicScissor_ { desc.scissors.empty()                   }
 {
@@ -39,10 +40,11 @@ VKGraphicsPSO::VKGraphicsPSO(
         auto renderPassVK = LLGL_CAST(const VKRenderPass*, renderPass);
         CreateVkPipeline(
             device,
-            GetVkPipelineLayoutOrDefault(desc.pipelineLayout, defaultPipelineLayout),
+            GetVkPipelineLayout(),
             *renderPassVK,
             limits,
-            desc
+            desc,
+            pipelineCache
         );
     }
     else
@@ -305,7 +307,8 @@ void VKGraphicsPSO::CreateVkPipeline(
     VkPipelineLayout                    pipelineLayout,
     const VKRenderPass&                 renderPass,
     const VKGraphicsPipelineLimits&     limits,
-    const GraphicsPipelineDescriptor&   desc)
+    const GraphicsPipelineDescriptor&   desc,
+    VkPipelineCache                     pipelineCache)
 {
     /* Get shader program object */
     auto shaderProgramVK = LLGL_CAST(const VKShaderProgram*, desc.shaderProgram);
@@ -382,7 +385,7 @@ void VKGraphicsPSO::CreateVkPipeline(
         createInfo.basePipelineHandle           = VK_NULL_HANDLE;
         createInfo.basePipelineIndex            = 0;
     }
-    auto result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, GetVkPipelineAddress());
+    auto result = vkCreateGraphicsPipelines(device, pipelineCache, 1, &createInfo, nullptr, GetVkPipelineAddress());
     VKThrowIfFailed(result, "failed to create Vulkan graphics pipeline");
 }
 
@@ -37,7 +37,8 @@ class VKGraphicsPSO final : public VKPipelineState
             VkPipelineLayout                    defaultPipelineLayout,
             const RenderPass*                   defaultRenderPass,
             const GraphicsPipelineDescriptor&   desc,
-            const VKGraphicsPipelineLimits&     limits
+            const VKGraphicsPipelineLimits&     limits,
+            VkPipelineCache                     pipelineCache   = VK_NULL_HANDLE
         );
 
         // Returns true if scissors are enabled.
@@ -59,7 +60,8 @@ class VKGraphicsPSO final : public VKPipelineState
             VkPipelineLayout                    pipelineLayout,
             const VKRenderPass&                 renderPass,
             const VKGraphicsPipelineLimits&     limits,
-            const GraphicsPipelineDescriptor&   desc
+            const GraphicsPipelineDescriptor&   desc,
+            VkPipelineCache                     pipelineCache
         );
 
     private:
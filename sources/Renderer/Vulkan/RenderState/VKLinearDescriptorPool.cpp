@@ -0,0 +1,168 @@
+/*
+ * VKLinearDescriptorPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKLinearDescriptorPool.h"
+#include "VKPipelineLayout.h"
+#include "../VKCore.h"
+#include <algorithm>
+#include <iterator>
+
+
+namespace LLGL
+{
+
+
+// Default number of descriptor sets and descriptors (per type) for each descriptor pool.
+static const std::uint32_t g_defaultMaxSetsPerChunk         = 256;
+static const std::uint32_t g_defaultMaxDescriptorsPerChunk  = 1024;
+
+static const VkDescriptorType g_descriptorTypes[] =
+{
+    VK_DESCRIPTOR_TYPE_SAMPLER,
+    VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+    VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+    VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+};
+
+VKLinearDescriptorPool::Chunk::Chunk(const VKPtr<VkDevice>& device) :
+    descriptorPool { device, vkDestroyDescriptorPool }
+{
+}
+
+bool VKLinearDescriptorPool::Chunk::CanAllocate(const std::uint32_t (&requiredDescriptors)[NumDescriptorTypes]) const
+{
+    if (numSets + 1 > maxSets)
+        return false;
+    for (int i = 0; i < NumDescriptorTypes; ++i)
+    {
+        if (numDescriptors[i] + requiredDescriptors[i] > maxDescriptors[i])
+            return false;
+    }
+    return true;
+}
+
+VKLinearDescriptorPool::VKLinearDescriptorPool(const VKPtr<VkDevice>& device) :
+    device_ { device }
+{
+}
+
+VkDescriptorSet VKLinearDescriptorPool::AllocateDescriptorSet(const VKPipelineLayout& pipelineLayout)
+{
+    /* Determine number of descriptors per type */
+    std::uint32_t requiredDescriptors[NumDescriptorTypes] = {};
+
+    for (const auto& binding : pipelineLayout.GetBindings())
+    {
+        switch (binding.descriptorType)
+        {
+            case VK_DESCRIPTOR_TYPE_SAMPLER:
+                requiredDescriptors[DescriptorTypeSampler] += binding.descriptorCount;
+                break;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                requiredDescriptors[DescriptorTypeSampledImage] += binding.descriptorCount;
+                break;
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                requiredDescriptors[DescriptorTypeUniformBuffer] += binding.descriptorCount;
+                break;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                requiredDescriptors[DescriptorTypeStorageBuffer] += binding.descriptorCount;
+                break;
+            default:
+                break;
+        }
+    }
+
+    /* Find next chunk with enough capacity; chunks before the current one are considered to be exhausted */
+    while (chunkIndex_ < chunks_.size() && !chunks_[chunkIndex_].CanAllocate(requiredDescriptors))
+        ++chunkIndex_;
+
+    if (chunkIndex_ == chunks_.size())
+        AppendChunk(requiredDescriptors);
+
+    auto& chunk = chunks_[chunkIndex_];
+
+    /* Allocate descriptor set from current chunk */
+    VkDescriptorSetLayout setLayout = pipelineLayout.GetVkDescriptorSetLayout();
+
+    VkDescriptorSetAllocateInfo allocInfo;
+    {
+        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.pNext                 = nullptr;
+        allocInfo.descriptorPool        = chunk.descriptorPool;
+        allocInfo.descriptorSetCount    = 1;
+        allocInfo.pSetLayouts           = &setLayout;
+    }
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+    auto result = vkAllocateDescriptorSets(device_, &allocInfo, &descriptorSet);
+    VKThrowIfFailed(result, "failed to allocate transient Vulkan descriptor set");
+
+    /* Update remaining capacity */
+    ++chunk.numSets;
+    for (int i = 0; i < NumDescriptorTypes; ++i)
+        chunk.numDescriptors[i] += requiredDescriptors[i];
+
+    return descriptorSet;
+}
+
+void VKLinearDescriptorPool::Reset()
+{
+    /* Reset all chunks that have been used since the last reset */
+    for (std::size_t i = 0; i <= chunkIndex_ && i < chunks_.size(); ++i)
+    {
+        auto& chunk = chunks_[i];
+        if (chunk.numSets > 0)
+        {
+            vkResetDescriptorPool(device_, chunk.descriptorPool, 0);
+            chunk.numSets = 0;
+            std::fill(std::begin(chunk.numDescriptors), std::end(chunk.numDescriptors), 0u);
+        }
+    }
+    chunkIndex_ = 0;
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKLinearDescriptorPool::AppendChunk(const std::uint32_t (&requiredDescriptors)[NumDescriptorTypes])
+{
+    Chunk chunk{ device_ };
+
+    /* Initialize descriptor pool sizes; enlarge them if a single descriptor set exceeds the default size */
+    VkDescriptorPoolSize poolSizes[NumDescriptorTypes];
+
+    chunk.maxSets = g_defaultMaxSetsPerChunk;
+    for (int i = 0; i < NumDescriptorTypes; ++i)
+    {
+        chunk.maxDescriptors[i]         = std::max(g_defaultMaxDescriptorsPerChunk, requiredDescriptors[i]);
+        poolSizes[i].type               = g_descriptorTypes[i];
+        poolSizes[i].descriptorCount    = chunk.maxDescriptors[i];
+    }
+
+    /* Create descriptor pool without VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, since sets are only released by resetting the pool */
+    VkDescriptorPoolCreateInfo poolCreateInfo;
+    {
+        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolCreateInfo.pNext            = nullptr;
+        poolCreateInfo.flags            = 0;
+        poolCreateInfo.maxSets          = chunk.maxSets;
+        poolCreateInfo.poolSizeCount    = NumDescriptorTypes;
+        poolCreateInfo.pPoolSizes       = poolSizes;
+    }
+    auto result = vkCreateDescriptorPool(device_, &poolCreateInfo, nullptr, chunk.descriptorPool.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool for transient descriptor sets");
+
+    chunks_.push_back(std::move(chunk));
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
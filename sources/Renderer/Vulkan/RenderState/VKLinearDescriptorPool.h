@@ -0,0 +1,90 @@
+/*
+ * VKLinearDescriptorPool.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_LINEAR_DESCRIPTOR_POOL_H
+#define LLGL_VK_LINEAR_DESCRIPTOR_POOL_H
+
+
+#include "../Vulkan.h"
+#include "../VKPtr.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+
+class VKPipelineLayout;
+
+/*
+Linear allocator for transient descriptor sets that are only valid until the command buffer they are recorded into has been executed.
+The descriptor sets are allocated from a growing list of descriptor pools which are all reset at once,
+i.e. there is one instance of this class for each native command buffer that is in flight.
+*/
+class VKLinearDescriptorPool
+{
+
+    public:
+
+        VKLinearDescriptorPool(const VKPtr<VkDevice>& device);
+
+        // Allocates a new descriptor set for the descriptor set layout of the specified pipeline layout.
+        VkDescriptorSet AllocateDescriptorSet(const VKPipelineLayout& pipelineLayout);
+
+        // Resets all descriptor pools. All previously allocated descriptor sets become invalid.
+        void Reset();
+
+    private:
+
+        // Descriptor types that are supported by pipeline layouts.
+        enum DescriptorTypeIndex
+        {
+            DescriptorTypeSampler = 0,
+            DescriptorTypeSampledImage,
+            DescriptorTypeUniformBuffer,
+            DescriptorTypeStorageBuffer,
+
+            NumDescriptorTypes,
+        };
+
+        // Native descriptor pool with the remaining capacity.
+        struct Chunk
+        {
+            Chunk(const VKPtr<VkDevice>& device);
+
+            VKPtr<VkDescriptorPool> descriptorPool;
+            std::uint32_t           maxSets                                 = 0;
+            std::uint32_t           maxDescriptors[NumDescriptorTypes]      = {};
+            std::uint32_t           numSets                                 = 0;
+            std::uint32_t           numDescriptors[NumDescriptorTypes]      = {};
+
+            bool CanAllocate(const std::uint32_t (&requiredDescriptors)[NumDescriptorTypes]) const;
+        };
+
+    private:
+
+        // Creates a new chunk that can hold at least the specified number of descriptors.
+        void AppendChunk(const std::uint32_t (&requiredDescriptors)[NumDescriptorTypes]);
+
+    private:
+
+        const VKPtr<VkDevice>&  device_;
+        std::vector<Chunk>      chunks_;
+        std::size_t             chunkIndex_ = 0;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
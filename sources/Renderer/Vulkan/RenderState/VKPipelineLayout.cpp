@@ -102,9 +102,16 @@ VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const Pipeline
     auto result = vkCreateDescriptorSetLayout(device, &descSetCreateInfo, nullptr, descriptorSetLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan descriptor set layout");
 
-    /* Create pipeline layout */
+    /* Create pipeline layout with push constant range for CommandBuffer::SetUniforms */
     VkDescriptorSetLayout setLayouts[] = { descriptorSetLayout_.Get() };
 
+    VkPushConstantRange pushConstantRange;
+    {
+        pushConstantRange.stageFlags    = VK_SHADER_STAGE_ALL;
+        pushConstantRange.offset        = 0;
+        pushConstantRange.size          = g_maxPushConstantsSize;
+    }
+
     VkPipelineLayoutCreateInfo layoutCreateInfo;
     {
         layoutCreateInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -112,8 +119,8 @@ VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const Pipeline
         layoutCreateInfo.flags                  = 0;
         layoutCreateInfo.setLayoutCount         = 1;
         layoutCreateInfo.pSetLayouts            = setLayouts;
-        layoutCreateInfo.pushConstantRangeCount = 0;
-        layoutCreateInfo.pPushConstantRanges    = nullptr;
+        layoutCreateInfo.pushConstantRangeCount = 1;
+        layoutCreateInfo.pPushConstantRanges    = &pushConstantRange;
     }
     result = vkCreatePipelineLayout(device, &layoutCreateInfo, nullptr, pipelineLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan pipeline layout");
@@ -126,7 +133,8 @@ VKPipelineLayout::VKPipelineLayout(const VKPtr<VkDevice>& device, const Pipeline
             {
                 desc.bindings[i].slot,
                 desc.bindings[i].stageFlags,
-                layoutBindings[i].descriptorType
+                layoutBindings[i].descriptorType,
+                layoutBindings[i].descriptorCount
             }
         );
     }
@@ -25,8 +25,15 @@ struct VKLayoutBinding
     std::uint32_t       dstBinding;
     long                stageFlags;
     VkDescriptorType    descriptorType;
+    std::uint32_t       descriptorCount;
 };
 
+/*
+Size (in bytes) of the push constant range that is shared by all shader stages of every pipeline layout.
+This is the minimum of 'VkPhysicalDeviceLimits::maxPushConstantsSize' that all Vulkan devices must support.
+*/
+static const std::uint32_t g_maxPushConstantsSize = 128;
+
 class VKPipelineLayout final : public PipelineLayout
 {
 
@@ -14,10 +14,19 @@ namespace LLGL
 {
 
 
-VKPipelineState::VKPipelineState(const VKPtr<VkDevice>& device, VkPipelineBindPoint bindPoint) :
-    pipeline_  { device, vkDestroyPipeline },
-    bindPoint_ { bindPoint                 }
+VKPipelineState::VKPipelineState(
+    const VKPtr<VkDevice>&  device,
+    VkPipelineBindPoint     bindPoint,
+    const PipelineLayout*   pipelineLayout,
+    VkPipelineLayout        defaultPipelineLayout)
+:
+    pipeline_         { device, vkDestroyPipeline                          },
+    bindPoint_        { bindPoint                                          },
+    pipelineLayout_   { LLGL_CAST(const VKPipelineLayout*, pipelineLayout) },
+    vkPipelineLayout_ { defaultPipelineLayout                              }
 {
+    if (pipelineLayout_ != nullptr)
+        vkPipelineLayout_ = pipelineLayout_->GetVkPipelineLayout();
 }
 
 
@@ -25,18 +34,6 @@ VKPipelineState::VKPipelineState(const VKPtr<VkDevice>& device, VkPipelineBindPo
  * ======= Protected: =======
  */
 
-VkPipelineLayout VKPipelineState::GetVkPipelineLayoutOrDefault(
-    const PipelineLayout*   pipelineLayout,
-    VkPipelineLayout        defaultPipelineLayout)
-{
-    if (pipelineLayout)
-    {
-        auto pipelineLayoutVK = LLGL_CAST(const VKPipelineLayout*, pipelineLayout);
-        return pipelineLayoutVK->GetVkPipelineLayout();
-    }
-    return defaultPipelineLayout;
-}
-
 VkPipeline* VKPipelineState::GetVkPipelineAddress()
 {
     return pipeline_.ReleaseAndGetAddressOf();
@@ -19,13 +19,19 @@ namespace LLGL
 
 
 class PipelineLayout;
+class VKPipelineLayout;
 
 class VKPipelineState : public PipelineState
 {
 
     public:
 
-        VKPipelineState(const VKPtr<VkDevice>& device, VkPipelineBindPoint bindPoint);
+        VKPipelineState(
+            const VKPtr<VkDevice>&  device,
+            VkPipelineBindPoint     bindPoint,
+            const PipelineLayout*   pipelineLayout,
+            VkPipelineLayout        defaultPipelineLayout
+        );
 
         // Returns the native PSO.
         inline VkPipeline GetVkPipeline() const
@@ -39,20 +45,29 @@ class VKPipelineState : public PipelineState
             return bindPoint_;
         }
 
-    protected:
+        // Returns the native pipeline layout this PSO was created with, i.e. either from the pipeline layout or the default layout.
+        inline VkPipelineLayout GetVkPipelineLayout() const
+        {
+            return vkPipelineLayout_;
+        }
 
-        static VkPipelineLayout GetVkPipelineLayoutOrDefault(
-            const PipelineLayout*   pipelineLayout,
-            VkPipelineLayout        defaultPipelineLayout
-        );
+        // Returns the pipeline layout this PSO was created with, or null if the default pipeline layout is used.
+        inline const VKPipelineLayout* GetPipelineLayout() const
+        {
+            return pipelineLayout_;
+        }
+
+    protected:
 
         // Releases the native PSO and returns its address.
         VkPipeline* GetVkPipelineAddress();
 
     private:
 
-        VKPtr<VkPipeline>   pipeline_;
-        VkPipelineBindPoint bindPoint_  = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        VKPtr<VkPipeline>       pipeline_;
+        VkPipelineBindPoint     bindPoint_          = VK_PIPELINE_BIND_POINT_MAX_ENUM;
+        const VKPipelineLayout* pipelineLayout_     = nullptr;
+        VkPipelineLayout        vkPipelineLayout_   = VK_NULL_HANDLE;
 
 };
 
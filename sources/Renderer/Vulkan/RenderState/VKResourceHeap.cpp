@@ -41,8 +41,12 @@ static VkPipelineBindPoint FindPipelineBindPoint(const VKPipelineLayout& pipelin
     return VK_PIPELINE_BIND_POINT_MAX_ENUM;
 }
 
-VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeapDescriptor& desc) :
-    descriptorPool_ { device, vkDestroyDescriptorPool }
+VKResourceHeap::VKResourceHeap(
+    const VKPtr<VkDevice>&          device,
+    VKDescriptorPoolAllocator&      descriptorPoolAllocator,
+    const ResourceHeapDescriptor&   desc)
+:
+    descriptorPoolAllocator_ { descriptorPoolAllocator }
 {
     /* Get pipeline layout object */
     auto pipelineLayoutVK = LLGL_CAST(VKPipelineLayout*, desc.pipelineLayout);
@@ -62,28 +66,33 @@ VKResourceHeap::VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeap
     if (numResourceViews % numBindings != 0)
         throw std::invalid_argument("failed to create resource heap because number of resource views is not a multiple of bindings in pipeline layou");
 
-    /* Pre-allocate descriptor sets */
-    const auto numDescriptorSets = (numResourceViews / numBindings);
-    descriptorSets_.resize(numDescriptorSets, VK_NULL_HANDLE);
-
-    /* Create resource descriptor pool */
-    CreateDescriptorPool(device, desc, bindings);
-
-    /* Create resource descriptor set for pipeline layout */
-    std::vector<VkDescriptorSetLayout> setLayouts;
-    setLayouts.resize(numDescriptorSets, pipelineLayoutVK->GetVkDescriptorSetLayout());
-    CreateDescriptorSets(device, static_cast<std::uint32_t>(numDescriptorSets), setLayouts.data());
+    /* Allocate descriptor sets from the shared descriptor pools */
+    const auto numDescriptorSets = static_cast<std::uint32_t>(numResourceViews / numBindings);
+    descriptorPoolAllocator_.Allocate(*pipelineLayoutVK, numDescriptorSets, descriptorSetAllocation_);
 
-    /* Update write descriptors in descriptor set */
-    UpdateDescriptorSets(device, desc, bindings);
+    try
+    {
+        /* Update write descriptors in descriptor set */
+        UpdateDescriptorSets(device, desc, bindings);
+    }
+    catch (...)
+    {
+        descriptorPoolAllocator_.Release(descriptorSetAllocation_);
+        throw;
+    }
 
     /* Create pipeline barrier for resource views that require it, e.g. those with storage binding flags */
     CreatePipelineBarrier(desc.resourceViews, pipelineLayoutVK->GetBindings());
 }
 
+VKResourceHeap::~VKResourceHeap()
+{
+    descriptorPoolAllocator_.Release(descriptorSetAllocation_);
+}
+
 std::uint32_t VKResourceHeap::GetNumDescriptorSets() const
 {
-    return static_cast<std::uint32_t>(descriptorSets_.size());
+    return static_cast<std::uint32_t>(descriptorSetAllocation_.descriptorSets.size());
 }
 
 void VKResourceHeap::InsertPipelineBarrier(VkCommandBuffer commandBuffer)
@@ -97,93 +106,6 @@ void VKResourceHeap::InsertPipelineBarrier(VkCommandBuffer commandBuffer)
  * ======= Private: =======
  */
 
-static std::uint32_t AccumDescriptorPoolSizes(
-    VkDescriptorType type,
-    std::vector<VkDescriptorPoolSize>::iterator it,
-    std::vector<VkDescriptorPoolSize>::iterator itEnd)
-{
-    std::uint32_t descriptorCount = it->descriptorCount;
-
-    for (++it; it != itEnd; ++it)
-    {
-        if (it->type == type)
-        {
-            descriptorCount += it->descriptorCount;
-            it->descriptorCount = 0;
-        }
-    }
-
-    return descriptorCount;
-}
-
-static void CompressDescriptorPoolSizes(std::vector<VkDescriptorPoolSize>& poolSizes)
-{
-    /* Accumulate all descriptors of the same type */
-    for (auto it = poolSizes.begin(); it != poolSizes.end(); ++it)
-        it->descriptorCount = AccumDescriptorPoolSizes(it->type, it, poolSizes.end());
-
-    /* Remove all remaining pool sizes with zero descriptors */
-    RemoveAllFromListIf(
-        poolSizes,
-        [](const VkDescriptorPoolSize& dps)
-        {
-            return (dps.descriptorCount == 0);
-        }
-    );
-}
-
-//TODO: enhance pool size accumulation
-void VKResourceHeap::CreateDescriptorPool(
-    const VKPtr<VkDevice>&              device,
-    const ResourceHeapDescriptor&       desc,
-    const std::vector<VKLayoutBinding>& bindings)
-{
-    /* Initialize descriptor pool sizes */
-    const auto numResourceViews = desc.resourceViews.size();
-    const auto numBindings      = bindings.size();
-
-    std::vector<VkDescriptorPoolSize> poolSizes(numResourceViews);
-    for (std::size_t i = 0; i < numResourceViews; ++i)
-    {
-        poolSizes[i].type               = bindings[i % numBindings].descriptorType;
-        poolSizes[i].descriptorCount    = 1;
-    }
-
-    /* Compress pool sizes by merging equal types with accumulated number of descriptors */
-    CompressDescriptorPoolSizes(poolSizes);
-
-    /* Create descriptor pool */
-    VkDescriptorPoolCreateInfo poolCreateInfo;
-    {
-        poolCreateInfo.sType            = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-        poolCreateInfo.pNext            = nullptr;
-        poolCreateInfo.flags            = 0;
-        poolCreateInfo.maxSets          = GetNumDescriptorSets();
-        poolCreateInfo.poolSizeCount    = static_cast<std::uint32_t>(poolSizes.size());
-        poolCreateInfo.pPoolSizes       = poolSizes.data();
-    }
-    auto result = vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, descriptorPool_.ReleaseAndGetAddressOf());
-    VKThrowIfFailed(result, "failed to create Vulkan descriptor pool");
-}
-
-void VKResourceHeap::CreateDescriptorSets(
-    const VKPtr<VkDevice>&          device,
-    std::uint32_t                   numSetLayouts,
-    const VkDescriptorSetLayout*    setLayouts)
-{
-    /* Allocate descriptor set */
-    VkDescriptorSetAllocateInfo allocInfo;
-    {
-        allocInfo.sType                 = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.pNext                 = nullptr;
-        allocInfo.descriptorPool        = descriptorPool_;
-        allocInfo.descriptorSetCount    = numSetLayouts;
-        allocInfo.pSetLayouts           = setLayouts;
-    }
-    auto result = vkAllocateDescriptorSets(device, &allocInfo, descriptorSets_.data());
-    VKThrowIfFailed(result, "failed to allocate Vulkan descriptor sets");
-}
-
 void VKResourceHeap::UpdateDescriptorSets(
     const VKPtr<VkDevice>&              device,
     const ResourceHeapDescriptor&       desc,
@@ -202,7 +124,7 @@ void VKResourceHeap::UpdateDescriptorSets(
         const auto descriptorType = binding.descriptorType;
 
         const auto& rvDesc = desc.resourceViews[i];
-        VkDescriptorSet descSet = descriptorSets_[i / numBindings];
+        VkDescriptorSet descSet = descriptorSetAllocation_.descriptorSets[i / numBindings];
 
         switch (descriptorType)
         {
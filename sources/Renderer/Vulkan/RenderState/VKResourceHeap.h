@@ -11,6 +11,7 @@
 
 #include <LLGL/ResourceHeap.h>
 #include "VKPipelineBarrier.h"
+#include "VKDescriptorPoolAllocator.h"
 #include "../Vulkan.h"
 #include "../VKPtr.h"
 #include <vector>
@@ -37,7 +38,12 @@ class VKResourceHeap final : public ResourceHeap
 
     public:
 
-        VKResourceHeap(const VKPtr<VkDevice>& device, const ResourceHeapDescriptor& desc);
+        VKResourceHeap(
+            const VKPtr<VkDevice>&          device,
+            VKDescriptorPoolAllocator&      descriptorPoolAllocator,
+            const ResourceHeapDescriptor&   desc
+        );
+        ~VKResourceHeap();
 
         // Inserts a pipeline barrier command into the command buffer if this resource heap requires it.
         void InsertPipelineBarrier(VkCommandBuffer commandBuffer);
@@ -48,16 +54,10 @@ class VKResourceHeap final : public ResourceHeap
             return pipelineLayout_;
         }
 
-        // Returns the native Vulkan descritpor pool.
-        inline VkDescriptorPool GetVkDescriptorPool() const
-        {
-            return descriptorPool_.Get();
-        }
-
         // Returns the list of native Vulkan descriptor sets.
         inline const std::vector<VkDescriptorSet>& GetVkDescriptorSets() const
         {
-            return descriptorSets_;
+            return descriptorSetAllocation_.descriptorSets;
         }
 
         /*
@@ -71,18 +71,6 @@ class VKResourceHeap final : public ResourceHeap
 
     private:
 
-        void CreateDescriptorPool(
-            const VKPtr<VkDevice>&              device,
-            const ResourceHeapDescriptor&       desc,
-            const std::vector<VKLayoutBinding>& bindings
-        );
-
-        void CreateDescriptorSets(
-            const VKPtr<VkDevice>&          device,
-            std::uint32_t                   numSetLayouts,
-            const VkDescriptorSetLayout*    setLayouts
-        );
-
         void UpdateDescriptorSets(
             const VKPtr<VkDevice>&              device,
             const ResourceHeapDescriptor&       desc,
@@ -128,8 +116,8 @@ class VKResourceHeap final : public ResourceHeap
 
         VkPipelineLayout                pipelineLayout_ = VK_NULL_HANDLE;
 
-        VKPtr<VkDescriptorPool>         descriptorPool_;
-        std::vector<VkDescriptorSet>    descriptorSets_;
+        VKDescriptorPoolAllocator&      descriptorPoolAllocator_;
+        VKDescriptorSetAllocation       descriptorSetAllocation_;
 
         std::vector<VKPtr<VkImageView>> imageViews_;
         //std::vector<VkBufferView>       bufferViews_;
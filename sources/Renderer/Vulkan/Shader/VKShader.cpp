@@ -329,9 +329,8 @@ bool VKShader::Reflect(ShaderReflection& reflection) const
     spvReflect.Parse(shaderModuleData_.data(), shaderModuleData_.size());
 
     /* Gather input/output attributes */
-    for (const auto& it : spvReflect.GetVaryings())
+    for (const auto& var : spvReflect.GetVaryings())
     {
-        const auto& var = it.second;
         if (GetType() == ShaderType::Vertex)
         {
             std::uint32_t numVectors = 1;
@@ -370,9 +369,8 @@ bool VKShader::Reflect(ShaderReflection& reflection) const
     }
 
     /* Gather resources */
-    for (const auto& it : spvReflect.GetUniforms())
+    for (const auto& var : spvReflect.GetUniforms())
     {
-        const auto& var = it.second;
         if (auto resource = FindOrAppendShaderResource(reflection, var))
             resource->binding.stageFlags |= ShaderTypeToStageFlags(GetType());
     }
@@ -399,6 +397,16 @@ bool VKShader::ReflectLocalSize(Extent3D& localSize) const
     return false;
 }
 
+bool VKShader::FindPushConstantField(const char* name, std::uint32_t& offset, std::uint32_t& size) const
+{
+    /* Parse shader module */
+    SPIRVReflect spvReflect;
+    spvReflect.Parse(shaderModuleData_.data(), shaderModuleData_.size());
+
+    /* Find field in push constant block by name */
+    return spvReflect.FindPushConstantField(name, offset, size);
+}
+
 #else
 
 bool VKShader::Reflect(ShaderReflection& /*reflection*/) const
@@ -411,6 +419,11 @@ bool VKShader::ReflectLocalSize(Extent3D& /*workGroupSize*/) const
     return false; // dummy
 }
 
+bool VKShader::FindPushConstantField(const char* /*name*/, std::uint32_t& /*offset*/, std::uint32_t& /*size*/) const
+{
+    return false; // dummy
+}
+
 #endif // /LLGL_ENABLE_SPIRV_REFLECT
 
 
@@ -41,6 +41,9 @@ class VKShader final : public Shader
         bool Reflect(ShaderReflection& reflection) const;
         bool ReflectLocalSize(Extent3D& localSize) const;
 
+        // Returns the byte offset and size of the specified field in the push constant block of this shader.
+        bool FindPushConstantField(const char* name, std::uint32_t& offset, std::uint32_t& size) const;
+
         // Returns the Vulkan shader module.
         inline const VKPtr<VkShaderModule>& GetShaderModule() const
         {
@@ -9,6 +9,7 @@
 #include "VKShader.h"
 #include "../../CheckedCast.h"
 #include "../VKTypes.h"
+#include "../RenderState/VKPipelineLayout.h"
 #include <LLGL/Log.h>
 #include <LLGL/VertexAttribute.h>
 #include <vector>
@@ -59,9 +60,24 @@ bool VKShaderProgram::Reflect(ShaderReflection& reflection) const
     return true;
 }
 
+/*
+Uniforms are mapped to the push constant range that all pipeline layouts share (see g_maxPushConstantsSize),
+so the uniform location is the byte offset of the field within the push constant block.
+*/
 UniformLocation VKShaderProgram::FindUniformLocation(const char* name) const
 {
-    return -1; //TODO
+    for (auto shader : shaders_)
+    {
+        std::uint32_t offset = 0, size = 0;
+        if (shader->FindPushConstantField(name, offset, size))
+        {
+            /* Reject fields that exceed the push constant range of the pipeline layouts */
+            if (offset + size > g_maxPushConstantsSize)
+                return -1;
+            return static_cast<UniformLocation>(offset);
+        }
+    }
+    return -1;
 }
 
 /* --- Extended functions --- */
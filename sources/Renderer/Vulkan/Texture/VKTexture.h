@@ -107,6 +107,12 @@ class VKTexture final : public Texture
             return imageWrapper_.GetMemoryRegion();
         }
 
+        // Returns the device image object.
+        inline VKDeviceImage& GetDeviceImage()
+        {
+            return imageWrapper_;
+        }
+
     private:
 
         void CreateImage(VkDevice device, const TextureDescriptor& desc);
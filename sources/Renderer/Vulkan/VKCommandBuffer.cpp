@@ -9,6 +9,7 @@
 #include "VKCommandQueue.h"
 #include "VKPhysicalDevice.h"
 #include "VKSwapChain.h"
+#include "VKUploadQueue.h"
 #include "VKTypes.h"
 #include "Ext/VKExtensionRegistry.h"
 #include "Ext/VKExtensions.h"
@@ -16,6 +17,7 @@
 #include "RenderState/VKGraphicsPSO.h"
 #include "RenderState/VKComputePSO.h"
 #include "RenderState/VKResourceHeap.h"
+#include "RenderState/VKPipelineLayout.h"
 #include "RenderState/VKPredicateQueryHeap.h"
 #include "Texture/VKSampler.h"
 #include "Texture/VKTexture.h"
@@ -26,6 +28,7 @@
 #include "../../Core/Exception.h"
 #include <LLGL/StaticLimits.h>
 #include <LLGL/TypeInfo.h>
+#include <algorithm>
 #include <cstddef>
 
 
@@ -55,11 +58,13 @@ VKCommandBuffer::VKCommandBuffer(
     const VKPhysicalDevice&         physicalDevice,
     VKDevice&                       device,
     VkQueue                         commandQueue,
+    VKUploadQueue&                  uploadQueue,
     const QueueFamilyIndices&       queueFamilyIndices,
     const CommandBufferDescriptor&  desc)
 :
     device_               { device                                  },
     commandQueue_         { commandQueue                            },
+    uploadQueue_          { uploadQueue                             },
     commandPool_          { device, vkDestroyCommandPool            },
     queuePresentFamily_   { queueFamilyIndices.presentFamily        },
     maxDrawIndirectCount_ { GetMaxDrawIndirectCount(physicalDevice) }
@@ -88,6 +93,7 @@ VKCommandBuffer::VKCommandBuffer(
     CreateCommandPool(queueFamilyIndices.graphicsFamily);
     CreateCommandBuffers(bufferCount);
     CreateRecordingFences(commandQueue, bufferCount);
+    CreateDescriptorPools(bufferCount);
 
     /* Acquire first native command buffer */
     AcquireNextBuffer();
@@ -114,6 +120,12 @@ void VKCommandBuffer::Begin()
     vkWaitForFences(device_, 1, &recordingFence_, VK_TRUE, UINT64_MAX);
     vkResetFences(device_, 1, &recordingFence_);
 
+    /* Recycle transient descriptor sets of the previous submission of this command buffer */
+    descriptorPoolList_[commandBufferIndex_].Reset();
+    ResetTransientResources();
+    boundPipelineLayout_    = nullptr;
+    boundVkPipelineLayout_  = VK_NULL_HANDLE;
+
     /* Begin recording of current command buffer */
     VkCommandBufferBeginInfo beginInfo;
     {
@@ -146,6 +158,7 @@ void VKCommandBuffer::End()
     /* Execute command buffer right after encoding for immediate command buffers */
     if (IsImmediateCmdBuffer())
     {
+        uploadQueue_.Flush();
         auto result = VKSubmitCommandBuffer(commandQueue_, commandBuffer_, GetQueueSubmitFence());
         VKThrowIfFailed(result, "failed to submit command buffer to Vulkan graphics queue");
     }
@@ -202,10 +215,14 @@ void VKCommandBuffer::CopyBuffer(
     {
         PauseRenderPass();
         vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), 1, &region);
+        RecordHostReadBarrier(dstBufferVK);
         ResumeRenderPass();
     }
     else
+    {
         vkCmdCopyBuffer(commandBuffer_, srcBufferVK.GetVkBuffer(), dstBufferVK.GetVkBuffer(), 1, &region);
+        RecordHostReadBarrier(dstBufferVK);
+    }
 }
 
 void VKCommandBuffer::CopyBufferFromTexture(
@@ -236,10 +253,14 @@ void VKCommandBuffer::CopyBufferFromTexture(
     {
         PauseRenderPass();
         device_.CopyImageToBuffer(commandBuffer_, srcTextureVK, dstBufferVK, region);
+        RecordHostReadBarrier(dstBufferVK);
         ResumeRenderPass();
     }
     else
+    {
         device_.CopyImageToBuffer(commandBuffer_, srcTextureVK, dstBufferVK, region);
+        RecordHostReadBarrier(dstBufferVK);
+    }
 }
 
 void VKCommandBuffer::FillBuffer(
@@ -500,25 +521,44 @@ void VKCommandBuffer::SetResourceHeap(
 
     /* Insert resource barrier into command buffer */
     resourceHeapVK.InsertPipelineBarrier(commandBuffer_);
+
+    /* Resource heap replaces the descriptor set of all previously set resources */
+    ResetTransientResources();
 }
 
+/*
+Resources are only recorded here and written into a transient descriptor set with the next draw or dispatch command,
+since the descriptor set layout depends on the pipeline state that might be set afterwards.
+*/
 void VKCommandBuffer::SetResource(
-    Resource&       /*resource*/,
-    std::uint32_t   /*slot*/,
+    Resource&       resource,
+    std::uint32_t   slot,
     long            /*bindFlags*/,
     long            /*stageFlags*/)
 {
-    // dummy
+    if (slot >= transientResources_.size())
+        transientResources_.resize(slot + 1, nullptr);
+    transientResources_[slot] = &resource;
+    transientDescriptorsDirty_ = true;
 }
 
 void VKCommandBuffer::ResetResourceSlots(
-    const ResourceType  /*resourceType*/,
-    std::uint32_t       /*firstSlot*/,
-    std::uint32_t       /*numSlots*/,
+    const ResourceType  resourceType,
+    std::uint32_t       firstSlot,
+    std::uint32_t       numSlots,
     long                /*bindFlags*/,
     long                /*stageFlags*/)
 {
-    // dummy
+    const auto lastSlot = std::min(static_cast<std::size_t>(firstSlot) + numSlots, transientResources_.size());
+    for (std::size_t slot = firstSlot; slot < lastSlot; ++slot)
+    {
+        auto& resource = transientResources_[slot];
+        if (resource != nullptr && resource->GetResourceType() == resourceType)
+        {
+            resource = nullptr;
+            transientDescriptorsDirty_ = true;
+        }
+    }
 }
 
 /* ----- Render Passes ----- */
@@ -713,6 +753,16 @@ void VKCommandBuffer::SetPipelineState(PipelineState& pipelineState)
     auto& pipelineStateVK = LLGL_CAST(VKPipelineState&, pipelineState);
     vkCmdBindPipeline(commandBuffer_, pipelineStateVK.GetBindPoint(), pipelineStateVK.GetVkPipeline());
 
+    /* Transient descriptor set must be rebound if the pipeline layout or binding point changes */
+    if (boundPipelineLayout_ != pipelineStateVK.GetPipelineLayout() || boundBindPoint_ != pipelineStateVK.GetBindPoint())
+    {
+        boundBindPoint_         = pipelineStateVK.GetBindPoint();
+        boundPipelineLayout_    = pipelineStateVK.GetPipelineLayout();
+        if (!transientResources_.empty())
+            transientDescriptorsDirty_ = true;
+    }
+    boundVkPipelineLayout_ = pipelineStateVK.GetVkPipelineLayout();
+
     /* Handle special case for graphics PSOs */
     if (pipelineStateVK.GetBindPoint() == VK_PIPELINE_BIND_POINT_GRAPHICS)
     {
@@ -749,13 +799,26 @@ void VKCommandBuffer::SetUniform(
     VKCommandBuffer::SetUniforms(location, 1, data, dataSize);
 }
 
+/*
+Uniforms are written into the push constant range that all pipeline layouts share (see g_maxPushConstantsSize),
+where the uniform location denotes the byte offset within that range. Since the uniforms are consecutive, 'count' is implied by 'dataSize'.
+*/
 void VKCommandBuffer::SetUniforms(
     UniformLocation location,
-    std::uint32_t   count,
+    std::uint32_t   /*count*/,
     const void*     data,
     std::uint32_t   dataSize)
 {
-    //TODO
+    /* Ignore invalid locations and updates that are not 4-byte aligned */
+    if (location < 0 || (location % 4) != 0 || dataSize == 0 || (dataSize % 4) != 0 || boundVkPipelineLayout_ == VK_NULL_HANDLE)
+        return;
+
+    /* Ignore updates that exceed the push constant range instead of writing a truncated value */
+    const auto offset = static_cast<std::uint32_t>(location);
+    if (offset > g_maxPushConstantsSize || dataSize > g_maxPushConstantsSize - offset)
+        return;
+
+    vkCmdPushConstants(commandBuffer_, boundVkPipelineLayout_, VK_SHADER_STAGE_ALL, offset, dataSize, data);
 }
 
 /* ----- Queries ----- */
@@ -881,52 +944,62 @@ void VKCommandBuffer::EndStreamOutput()
 
 void VKCommandBuffer::Draw(std::uint32_t numVertices, std::uint32_t firstVertex)
 {
+    FlushTransientDescriptorSet();
     vkCmdDraw(commandBuffer_, numVertices, 1, firstVertex, 0);
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex)
 {
+    FlushTransientDescriptorSet();
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, 0, 0);
 }
 
 void VKCommandBuffer::DrawIndexed(std::uint32_t numIndices, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    FlushTransientDescriptorSet();
     vkCmdDrawIndexed(commandBuffer_, numIndices, 1, firstIndex, vertexOffset, 0);
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances)
 {
+    FlushTransientDescriptorSet();
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, 0);
 }
 
 void VKCommandBuffer::DrawInstanced(std::uint32_t numVertices, std::uint32_t firstVertex, std::uint32_t numInstances, std::uint32_t firstInstance)
 {
+    FlushTransientDescriptorSet();
     vkCmdDraw(commandBuffer_, numVertices, numInstances, firstVertex, firstInstance);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex)
 {
+    FlushTransientDescriptorSet();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, 0, 0);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset)
 {
+    FlushTransientDescriptorSet();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, 0);
 }
 
 void VKCommandBuffer::DrawIndexedInstanced(std::uint32_t numIndices, std::uint32_t numInstances, std::uint32_t firstIndex, std::int32_t vertexOffset, std::uint32_t firstInstance)
 {
+    FlushTransientDescriptorSet();
     vkCmdDrawIndexed(commandBuffer_, numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    FlushTransientDescriptorSet();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    FlushTransientDescriptorSet();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (maxDrawIndirectCount_ < numCommands)
     {
@@ -945,12 +1018,14 @@ void VKCommandBuffer::DrawIndirect(Buffer& buffer, std::uint64_t offset, std::ui
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    FlushTransientDescriptorSet();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDrawIndexedIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset, 1, 0);
 }
 
 void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset, std::uint32_t numCommands, std::uint32_t stride)
 {
+    FlushTransientDescriptorSet();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     if (maxDrawIndirectCount_ < numCommands)
     {
@@ -971,11 +1046,13 @@ void VKCommandBuffer::DrawIndexedIndirect(Buffer& buffer, std::uint64_t offset,
 
 void VKCommandBuffer::Dispatch(std::uint32_t numWorkGroupsX, std::uint32_t numWorkGroupsY, std::uint32_t numWorkGroupsZ)
 {
+    FlushTransientDescriptorSet();
     vkCmdDispatch(commandBuffer_, numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
 }
 
 void VKCommandBuffer::DispatchIndirect(Buffer& buffer, std::uint64_t offset)
 {
+    FlushTransientDescriptorSet();
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
     vkCmdDispatchIndirect(commandBuffer_, bufferVK.GetVkBuffer(), offset);
 }
@@ -1075,6 +1152,13 @@ void VKCommandBuffer::CreateRecordingFences(VkQueue commandQueue, std::uint32_t
     }
 }
 
+void VKCommandBuffer::CreateDescriptorPools(std::uint32_t numPools)
+{
+    descriptorPoolList_.reserve(numPools);
+    for (std::uint32_t i = 0; i < numPools; ++i)
+        descriptorPoolList_.emplace_back(device_.GetVkDevice());
+}
+
 void VKCommandBuffer::ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments)
 {
     if (numAttachments > 0)
@@ -1177,6 +1261,35 @@ bool VKCommandBuffer::IsInsideRenderPass() const
     return (recordState_ == RecordState::InsideRenderPass);
 }
 
+void VKCommandBuffer::RecordHostReadBarrier(const VKBuffer& bufferVK)
+{
+    if (!bufferVK.IsReadback())
+        return;
+
+    /* Fences only make device writes available, so host reads of readback buffers require an explicit memory dependency */
+    VkBufferMemoryBarrier barrier;
+    {
+        barrier.sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+        barrier.pNext               = nullptr;
+        barrier.srcAccessMask       = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask       = VK_ACCESS_HOST_READ_BIT;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.buffer              = bufferVK.GetVkBuffer();
+        barrier.offset              = 0;
+        barrier.size                = VK_WHOLE_SIZE;
+    }
+    vkCmdPipelineBarrier(
+        commandBuffer_,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        0, nullptr,
+        1, &barrier,
+        0, nullptr
+    );
+}
+
 void VKCommandBuffer::AcquireNextBuffer()
 {
     commandBufferIndex_ = (commandBufferIndex_ + 1) % commandBufferList_.size();
@@ -1184,6 +1297,132 @@ void VKCommandBuffer::AcquireNextBuffer()
     recordingFence_     = recordingFenceList_[commandBufferIndex_].Get();
 }
 
+void VKCommandBuffer::ResetTransientResources()
+{
+    transientResources_.clear();
+    transientDescriptorsDirty_ = false;
+}
+
+// Fills the write descriptor for the specified resource if its type matches the descriptor type of the layout binding.
+static void FillTransientWriteDescriptor(
+    Resource&                   resource,
+    VkDescriptorSet             descSet,
+    const VKLayoutBinding&      binding,
+    VKWriteDescriptorContainer& container)
+{
+    VkDescriptorImageInfo*  imageInfo   = nullptr;
+    VkDescriptorBufferInfo* bufferInfo  = nullptr;
+
+    switch (binding.descriptorType)
+    {
+        case VK_DESCRIPTOR_TYPE_SAMPLER:
+        {
+            if (resource.GetResourceType() != ResourceType::Sampler)
+                return;
+            auto& samplerVK = LLGL_CAST(VKSampler&, resource);
+            imageInfo = container.NextImageInfo();
+            {
+                imageInfo->sampler          = samplerVK.GetVkSampler();
+                imageInfo->imageView        = VK_NULL_HANDLE;
+                imageInfo->imageLayout      = VK_IMAGE_LAYOUT_UNDEFINED;
+            }
+        }
+        break;
+
+        case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+        {
+            if (resource.GetResourceType() != ResourceType::Texture)
+                return;
+            auto& textureVK = LLGL_CAST(VKTexture&, resource);
+            imageInfo = container.NextImageInfo();
+            {
+                imageInfo->sampler          = VK_NULL_HANDLE;
+                imageInfo->imageView        = textureVK.GetVkImageView();
+                imageInfo->imageLayout      = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            }
+        }
+        break;
+
+        case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+        case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+        {
+            if (resource.GetResourceType() != ResourceType::Buffer)
+                return;
+            auto& bufferVK = LLGL_CAST(VKBuffer&, resource);
+            bufferInfo = container.NextBufferInfo();
+            {
+                bufferInfo->buffer          = bufferVK.GetVkBuffer();
+                bufferInfo->offset          = 0;
+                bufferInfo->range           = VK_WHOLE_SIZE;
+            }
+        }
+        break;
+
+        default:
+            return;
+    }
+
+    auto writeDesc = container.NextWriteDescriptor();
+    {
+        writeDesc->dstSet           = descSet;
+        writeDesc->dstBinding       = binding.dstBinding;
+        writeDesc->dstArrayElement  = 0;
+        writeDesc->descriptorCount  = 1;
+        writeDesc->descriptorType   = binding.descriptorType;
+        writeDesc->pImageInfo       = imageInfo;
+        writeDesc->pBufferInfo      = bufferInfo;
+        writeDesc->pTexelBufferView = nullptr;
+    }
+}
+
+void VKCommandBuffer::BindTransientDescriptorSet()
+{
+    transientDescriptorsDirty_ = false;
+
+    /* Default pipeline layout has no descriptor set layout */
+    if (boundPipelineLayout_ == nullptr || boundPipelineLayout_->GetBindings().empty())
+        return;
+
+    /* Allocate new descriptor set from the pool of the current native command buffer */
+    VkDescriptorSet descriptorSet = descriptorPoolList_[commandBufferIndex_].AllocateDescriptorSet(*boundPipelineLayout_);
+
+    /* Write descriptors for all layout bindings that have a resource assigned */
+    const auto& bindings = boundPipelineLayout_->GetBindings();
+    transientWriteDescriptors_.Reset(bindings.size());
+
+    for (const auto& binding : bindings)
+    {
+        if (binding.dstBinding < transientResources_.size())
+        {
+            if (auto resource = transientResources_[binding.dstBinding])
+                FillTransientWriteDescriptor(*resource, descriptorSet, binding, transientWriteDescriptors_);
+        }
+    }
+
+    if (transientWriteDescriptors_.numWriteDescriptors > 0)
+    {
+        vkUpdateDescriptorSets(
+            device_,
+            transientWriteDescriptors_.numWriteDescriptors,
+            transientWriteDescriptors_.writeDescriptors.data(),
+            0,
+            nullptr
+        );
+    }
+
+    /* Bind descriptor set to the pipeline that was set last */
+    vkCmdBindDescriptorSets(
+        commandBuffer_,
+        boundBindPoint_,
+        boundPipelineLayout_->GetVkPipelineLayout(),
+        0,
+        1,
+        &descriptorSet,
+        0,
+        nullptr
+    );
+}
+
 void VKCommandBuffer::ResetQueryPoolsInFlight()
 {
     for (std::size_t i = 0; i < numQueryHeapsInFlight_; ++i)
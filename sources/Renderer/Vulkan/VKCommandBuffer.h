@@ -13,6 +13,8 @@
 #include "Vulkan.h"
 #include "VKPtr.h"
 #include "VKCore.h"
+#include "VKContainers.h"
+#include "RenderState/VKLinearDescriptorPool.h"
 
 #include <vector>
 
@@ -21,11 +23,14 @@ namespace LLGL
 {
 
 
+class VKBuffer;
 class VKDevice;
 class VKPhysicalDevice;
 class VKResourceHeap;
 class VKRenderPass;
 class VKQueryHeap;
+class VKUploadQueue;
+class VKPipelineLayout;
 
 class VKCommandBuffer final : public CommandBuffer
 {
@@ -38,6 +43,7 @@ class VKCommandBuffer final : public CommandBuffer
             const VKPhysicalDevice&         physicalDevice,
             VKDevice&                       device,
             VkQueue                         commandQueue,
+            VKUploadQueue&                  uploadQueue,
             const QueueFamilyIndices&       queueFamilyIndices,
             const CommandBufferDescriptor&  desc
         );
@@ -259,6 +265,7 @@ class VKCommandBuffer final : public CommandBuffer
         void CreateCommandPool(std::uint32_t queueFamilyIndex);
         void CreateCommandBuffers(std::uint32_t bufferCount);
         void CreateRecordingFences(VkQueue commandQueue, std::uint32_t numFences);
+        void CreateDescriptorPools(std::uint32_t numPools);
 
         void ClearFramebufferAttachments(std::uint32_t numAttachments, const VkClearAttachment* attachments);
 
@@ -275,8 +282,24 @@ class VKCommandBuffer final : public CommandBuffer
 
         bool IsInsideRenderPass() const;
 
+        // Makes transfer writes into the specified buffer visible to the host if it is a readback buffer.
+        void RecordHostReadBarrier(const VKBuffer& bufferVK);
+
         void BindResourceHeap(VKResourceHeap& resourceHeapVK, VkPipelineBindPoint bindingPoint, std::uint32_t firstSet);
 
+        // Resets all resources that have been set with SetResource.
+        void ResetTransientResources();
+
+        // Allocates, writes, and binds a transient descriptor set for all resources that have been set with SetResource.
+        void BindTransientDescriptorSet();
+
+        // Binds a new transient descriptor set if the resource bindings have changed since the last draw or dispatch command.
+        inline void FlushTransientDescriptorSet()
+        {
+            if (transientDescriptorsDirty_)
+                BindTransientDescriptorSet();
+        }
+
         // Acquires the next native VkCommandBuffer object.
         void AcquireNextBuffer();
 
@@ -290,6 +313,7 @@ class VKCommandBuffer final : public CommandBuffer
         VKDevice&                       device_;
 
         VkQueue                         commandQueue_               = VK_NULL_HANDLE;
+        VKUploadQueue&                  uploadQueue_;
 
         VKPtr<VkCommandPool>            commandPool_;
 
@@ -300,6 +324,8 @@ class VKCommandBuffer final : public CommandBuffer
         std::vector<VKPtr<VkFence>>     recordingFenceList_;
         VkFence                         recordingFence_;
 
+        std::vector<VKLinearDescriptorPool> descriptorPoolList_;    // one transient descriptor pool for each native command buffer
+
         RecordState                     recordState_                = RecordState::Undefined;
 
         VkCommandBufferUsageFlags       usageFlags_                 = 0;
@@ -320,6 +346,14 @@ class VKCommandBuffer final : public CommandBuffer
 
         std::uint32_t                   maxDrawIndirectCount_       = 0;
 
+        VkPipelineBindPoint             boundBindPoint_             = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        const VKPipelineLayout*         boundPipelineLayout_        = nullptr;          // null if the default pipeline layout is bound
+        VkPipelineLayout                boundVkPipelineLayout_      = VK_NULL_HANDLE;
+
+        std::vector<Resource*>          transientResources_;                            // resources from SetResource, indexed by binding slot
+        bool                            transientDescriptorsDirty_  = false;
+        VKWriteDescriptorContainer      transientWriteDescriptors_;
+
         #if 1//TODO: optimize usage of query pools
         std::vector<VKQueryHeap*>       queryHeapsInFlight_;
         std::size_t                     numQueryHeapsInFlight_      = 0;
@@ -7,6 +7,7 @@
 
 #include "VKCommandQueue.h"
 #include "VKCommandBuffer.h"
+#include "VKUploadQueue.h"
 #include "RenderState/VKFence.h"
 #include "RenderState/VKQueryHeap.h"
 #include "../CheckedCast.h"
@@ -34,9 +35,10 @@ VkResult VKSubmitCommandBuffer(VkQueue commandQueue, VkCommandBuffer commandBuff
     return vkQueueSubmit(commandQueue, 1, &submitInfo, fence);
 }
 
-VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue) :
-    device_ { device },
-    native_ { queue  }
+VKCommandQueue::VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue, VKUploadQueue& uploadQueue) :
+    device_         { device      },
+    native_         { queue       },
+    uploadQueue_    { uploadQueue }
 {
 }
 
@@ -47,6 +49,9 @@ void VKCommandQueue::Submit(CommandBuffer& commandBuffer)
     auto& commandBufferVK = LLGL_CAST(VKCommandBuffer&, commandBuffer);
     if (!commandBufferVK.IsImmediateCmdBuffer())
     {
+        /* Submit pending resource uploads first, so they are visible to this command buffer */
+        uploadQueue_.Flush();
+
         auto result = VKSubmitCommandBuffer(
             native_,
             commandBufferVK.GetVkCommandBuffer(),
@@ -104,6 +109,7 @@ void VKCommandQueue::Submit(Fence& fence)
 {
     auto& fenceVK = LLGL_CAST(VKFence&, fence);
     fenceVK.Reset(device_);
+    uploadQueue_.Flush();
     vkQueueSubmit(native_, 0, nullptr, fenceVK.GetVkFence());
 }
 
@@ -115,6 +121,7 @@ bool VKCommandQueue::WaitFence(Fence& fence, std::uint64_t timeout)
 
 void VKCommandQueue::WaitIdle()
 {
+    uploadQueue_.Flush();
     vkQueueWaitIdle(native_);
 }
 
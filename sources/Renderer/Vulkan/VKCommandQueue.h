@@ -21,6 +21,7 @@ namespace LLGL
 
 
 class VKQueryHeap;
+class VKUploadQueue;
 
 // Helper function to submit the specified Vulkan command buffer to a command queue.
 VkResult VKSubmitCommandBuffer(VkQueue commandQueue, VkCommandBuffer commandBuffer, VkFence fence);
@@ -32,7 +33,7 @@ class VKCommandQueue final : public CommandQueue
 
         /* ----- Common ----- */
 
-        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue);
+        VKCommandQueue(const VKPtr<VkDevice>& device, VkQueue queue, VKUploadQueue& uploadQueue);
 
         /* ----- Command Buffers ----- */
 
@@ -79,8 +80,9 @@ class VKCommandQueue final : public CommandQueue
 
     private:
 
-        VkDevice    device_;
-        VkQueue     native_ = VK_NULL_HANDLE;
+        VkDevice        device_;
+        VkQueue         native_         = VK_NULL_HANDLE;
+        VKUploadQueue&  uploadQueue_;
 
 };
 
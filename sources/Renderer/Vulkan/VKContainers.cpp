@@ -23,6 +23,19 @@ VKWriteDescriptorContainer::VKWriteDescriptorContainer(std::size_t numResourceVi
 {
 }
 
+void VKWriteDescriptorContainer::Reset(std::size_t numResourceViewsMax)
+{
+    if (writeDescriptors.size() < numResourceViewsMax)
+    {
+        bufferInfos.resize(numResourceViewsMax);
+        imageInfos.resize(numResourceViewsMax);
+        writeDescriptors.resize(numResourceViewsMax);
+    }
+    numBufferInfos      = 0;
+    numImageInfos       = 0;
+    numWriteDescriptors = 0;
+}
+
 VkDescriptorBufferInfo* VKWriteDescriptorContainer::NextBufferInfo()
 {
     return &(bufferInfos[numBufferInfos++]);
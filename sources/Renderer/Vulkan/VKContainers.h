@@ -24,6 +24,9 @@ struct VKWriteDescriptorContainer
     VKWriteDescriptorContainer() = default;
     VKWriteDescriptorContainer(std::size_t numResourceViewsMax);
 
+    // Resets all counters and grows the containers to the specified number of resource views if necessary.
+    void Reset(std::size_t numResourceViewsMax);
+
     VkDescriptorBufferInfo* NextBufferInfo();
     VkDescriptorImageInfo* NextImageInfo();
     VkWriteDescriptorSet* NextWriteDescriptor();
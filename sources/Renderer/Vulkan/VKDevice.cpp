@@ -303,11 +303,12 @@ void VKDevice::CopyBufferToImage(
     VkFormat                    format,
     const VkOffset3D&           offset,
     const VkExtent3D&           extent,
-    const TextureSubresource&   subresource)
+    const TextureSubresource&   subresource,
+    VkDeviceSize                bufferOffset)
 {
     VkBufferImageCopy region;
     {
-        region.bufferOffset                     = 0;
+        region.bufferOffset                     = bufferOffset;
         region.bufferRowLength                  = 0;
         region.bufferImageHeight                = 0;
         region.imageSubresource.aspectMask      = GetImageAspectForVkFormat(format);
@@ -89,7 +89,7 @@ class VKDevice
             const VkImageCopy&  region
         );
 
-        // Copies the source buffer into the destination image (numMipLevels must be 1).
+        // Copies the source buffer, starting at 'bufferOffset', into the destination image (numMipLevels must be 1).
         void CopyBufferToImage(
             VkCommandBuffer             commandBuffer,
             VkBuffer                    srcBuffer,
@@ -97,7 +97,8 @@ class VKDevice
             VkFormat                    format,
             const VkOffset3D&           offset,
             const VkExtent3D&           extent,
-            const TextureSubresource&   subresource
+            const TextureSubresource&   subresource,
+            VkDeviceSize                bufferOffset = 0
         );
 
         void CopyBufferToImage(
@@ -141,6 +141,7 @@ static std::vector<Format> GetCompressedVKTextureFormatsS3TC()
         Format::BC3UNorm, Format::BC3UNorm_sRGB,
         Format::BC4UNorm, Format::BC4SNorm,
         Format::BC5UNorm, Format::BC5SNorm,
+        Format::BC7UNorm, Format::BC7UNorm_sRGB,
     };
 }
 
@@ -182,6 +183,7 @@ void VKPhysicalDevice::QueryDeviceProperties(
     caps.features.hasBufferViews                    = true;
     caps.features.hasSamplers                       = true;
     caps.features.hasConstantBuffers                = true;
+    caps.features.hasDirectResourceBinding          = true;
     caps.features.hasStorageBuffers                 = true;
     caps.features.hasUniforms                       = true;
     caps.features.hasGeometryShaders                = (features_.geometryShader != VK_FALSE);
@@ -18,6 +18,7 @@
 #include "VKCore.h"
 #include "VKTypes.h"
 #include "VKInitializers.h"
+#include "VKSerialization.h"
 #include "RenderState/VKPredicateQueryHeap.h"
 #include "RenderState/VKComputePSO.h"
 #include <LLGL/Log.h>
@@ -46,6 +47,13 @@ static void DestroyDebugReportCallbackEXT(VkInstance instance, VkDebugReportCall
         func(instance, callback, allocator);
 }
 
+// Returns the alignment for image data in a staging buffer, which must be a multiple of 4 and the texel block size
+static VkDeviceSize GetStagingImageDataAlignment(const Format format)
+{
+    const auto& formatAttribs = GetFormatAttribs(format);
+    return std::max<VkDeviceSize>(1, formatAttribs.bitSize / 8) * 4;
+}
+
 static VkBufferUsageFlags GetStagingVkBufferUsageFlags(long cpuAccessFlags)
 {
     if ((cpuAccessFlags & CPUAccessFlags::Write) != 0)
@@ -60,7 +68,8 @@ static VkBufferUsageFlags GetStagingVkBufferUsageFlags(long cpuAccessFlags)
 VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
     instance_              { vkDestroyInstance                        },
     debugReportCallback_   { instance_, DestroyDebugReportCallbackEXT },
-    defaultPipelineLayout_ { device_, vkDestroyPipelineLayout         }
+    defaultPipelineLayout_ { device_, vkDestroyPipelineLayout         },
+    pipelineCache_         { device_, vkDestroyPipelineCache          }
 {
     /* Extract optional renderer configuartion */
     auto rendererConfigVK = GetRendererConfiguration<RendererConfigurationVulkan>(renderSystemDesc);
@@ -76,6 +85,7 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
 
     /* Create default resources */
     CreateDefaultPipelineLayout();
+    CreatePipelineCache();
 
     /* Create device memory manager */
     deviceMemoryMngr_ = MakeUnique<VKDeviceMemoryManager>(
@@ -84,10 +94,24 @@ VKRenderSystem::VKRenderSystem(const RenderSystemDescriptor& renderSystemDesc) :
         (rendererConfigVK != nullptr ? rendererConfigVK->minDeviceMemoryAllocationSize : 1024*1024),
         (rendererConfigVK != nullptr ? rendererConfigVK->reduceDeviceMemoryFragmentation : false)
     );
+
+    /* Create upload queue for batched resource transfers */
+    uploadQueue_ = MakeUnique<VKUploadQueue>(
+        device_,
+        *deviceMemoryMngr_,
+        (rendererConfigVK != nullptr ? rendererConfigVK->stagingBufferSize : 16*1024*1024)
+    );
+
+    /* Create shared descriptor pool allocator for resource heaps */
+    descriptorPoolAllocator_ = MakeUnique<VKDescriptorPoolAllocator>(device_);
+
+    /* Create command queue interface */
+    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue(), *uploadQueue_);
 }
 
 VKRenderSystem::~VKRenderSystem()
 {
+    uploadQueue_->FlushAndWait();
     device_.WaitIdle();
 }
 
@@ -119,7 +143,7 @@ CommandBuffer* VKRenderSystem::CreateCommandBuffer(const CommandBufferDescriptor
 {
     return TakeOwnership(
         commandBuffers_,
-        MakeUnique<VKCommandBuffer>(physicalDevice_, device_, device_.GetVkQueue(), device_.GetQueueFamilyIndices(), desc)
+        MakeUnique<VKCommandBuffer>(physicalDevice_, device_, device_.GetVkQueue(), *uploadQueue_, device_.GetQueueFamilyIndices(), desc)
     );
 }
 
@@ -134,19 +158,24 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
 {
     AssertCreateBuffer(desc, static_cast<uint64_t>(std::numeric_limits<VkDeviceSize>::max()));
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        static_cast<VkDeviceSize>(desc.size),
-        GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
-    );
-
-    auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, desc.size);
-
     /* Create primary buffer object */
     auto buffer = TakeOwnership(buffers_, MakeUnique<VKBuffer>(device_, desc));
 
+    if (buffer->IsReadback())
+    {
+        /* Allocate host visible memory for readback buffers, so they can be mapped without an intermediate copy */
+        auto memoryRegion = deviceMemoryMngr_->Allocate(
+            buffer->GetDeviceBuffer().GetRequirements(),
+            (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+        );
+        buffer->BindMemoryRegion(device_, memoryRegion);
+
+        if (initialData != nullptr)
+            device_.WriteBuffer(buffer->GetDeviceBuffer(), initialData, static_cast<VkDeviceSize>(desc.size));
+
+        return buffer;
+    }
+
     /* Allocate device memory */
     auto memoryRegion = deviceMemoryMngr_->Allocate(
         buffer->GetDeviceBuffer().GetRequirements(),
@@ -154,18 +183,32 @@ Buffer* VKRenderSystem::CreateBuffer(const BufferDescriptor& desc, const void* i
     );
     buffer->BindMemoryRegion(device_, memoryRegion);
 
-    /* Copy staging buffer into hardware buffer */
-    device_.CopyBuffer(stagingBuffer.GetVkBuffer(), buffer->GetVkBuffer(), static_cast<VkDeviceSize>(desc.size));
-
     if (desc.cpuAccessFlags != 0 || (desc.miscFlags & MiscFlags::DynamicUsage) != 0)
     {
+        /* Create staging buffer for CPU access */
+        VkBufferCreateInfo stagingCreateInfo;
+        BuildVkBufferCreateInfo(
+            stagingCreateInfo,
+            static_cast<VkDeviceSize>(desc.size),
+            GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
+        );
+
+        auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, desc.size);
+
+        /* Copy staging buffer into hardware buffer with the next upload batch */
+        if (initialData != nullptr)
+        {
+            device_.CopyBuffer(uploadQueue_->GetCommandBuffer(), stagingBuffer.GetVkBuffer(), buffer->GetVkBuffer(), static_cast<VkDeviceSize>(desc.size));
+            buffer->SetStagingBatchID(uploadQueue_->GetRecordingBatchID());
+        }
+
         /* Store ownership of staging buffer */
         buffer->TakeStagingBuffer(std::move(stagingBuffer));
     }
-    else
+    else if (initialData != nullptr)
     {
-        /* Release staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        /* Copy initial data into hardware buffer with the next upload batch */
+        uploadQueue_->WriteBuffer(buffer->GetVkBuffer(), 0, initialData, static_cast<VkDeviceSize>(desc.size));
     }
 
     return buffer;
@@ -179,10 +222,13 @@ BufferArray* VKRenderSystem::CreateBufferArray(std::uint32_t numBuffers, Buffer*
 
 void VKRenderSystem::Release(Buffer& buffer)
 {
-    /* Release device memory regions for primary buffer and internal staging buffer, then release buffer object */
+    /*
+    Hand over primary buffer and internal staging buffer to the upload queue, which releases them once all pending transfers are completed,
+    then release buffer object
+    */
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
-    bufferVK.GetDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
-    bufferVK.GetStagingDeviceBuffer().ReleaseMemoryRegion(*deviceMemoryMngr_);
+    uploadQueue_->DeferRelease(std::move(bufferVK.GetDeviceBuffer()));
+    uploadQueue_->DeferRelease(std::move(bufferVK.GetStagingDeviceBuffer()));
     RemoveFromUniqueSet(buffers_, &buffer);
 }
 
@@ -195,31 +241,19 @@ void VKRenderSystem::WriteBuffer(Buffer& dstBuffer, std::uint64_t dstOffset, con
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, dstBuffer);
 
-    if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
-    {
-        /* Copy data to staging buffer memory */
-        device_.WriteBuffer(bufferVK.GetStagingDeviceBuffer(), data, dataSize, dstOffset);
+    /* Copy data into staging ring buffer and record copy command with the next upload batch */
+    uploadQueue_->WriteBuffer(bufferVK.GetVkBuffer(), dstOffset, data, dataSize);
 
-        /* Copy staging buffer into hardware buffer */
-        device_.CopyBuffer(bufferVK.GetStagingVkBuffer(), bufferVK.GetVkBuffer(), dataSize, dstOffset, dstOffset);
-    }
-    else
+    if (bufferVK.GetStagingVkBuffer() != VK_NULL_HANDLE)
     {
-        /* Create staging buffer */
-        VkBufferCreateInfo stagingCreateInfo;
-        BuildVkBufferCreateInfo(
-            stagingCreateInfo,
-            dataSize,
-            (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)
-        );
-
-        auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, data, dataSize);
-
-        /* Copy staging buffer into hardware buffer */
-        device_.CopyBuffer(stagingBuffer.GetVkBuffer(), bufferVK.GetVkBuffer(), dataSize, 0, dstOffset);
-
-        /* Release device memory region of staging buffer */
-        stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
+        /*
+        Keep internal staging buffer of CPU accessible buffers in sync. If a pending upload batch still accesses the staging buffer,
+        the range is only marked as outdated and refreshed the next time the buffer is mapped, to avoid waiting for the GPU here.
+        */
+        if (uploadQueue_->IsBatchCompleted(bufferVK.GetStagingBatchID()))
+            device_.WriteBuffer(bufferVK.GetStagingDeviceBuffer(), data, dataSize, dstOffset);
+        else
+            bufferVK.InvalidateStagingRange(dstOffset, dataSize);
     }
 }
 
@@ -227,11 +261,35 @@ void* VKRenderSystem::MapBuffer(Buffer& buffer, const CPUAccess access)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
+    /* Map readback buffer directly; the caller is responsible to wait for a fence after the copy commands */
+    if (bufferVK.IsReadback())
+        return bufferVK.Map(device_, access);
+
     if (auto stagingBuffer = bufferVK.GetStagingVkBuffer())
     {
-        /* Copy GPU local buffer into staging buffer for read accces */
-        if (access != CPUAccess::WriteOnly && access != CPUAccess::WriteDiscard)
-            device_.CopyBuffer(bufferVK.GetVkBuffer(), stagingBuffer, bufferVK.GetSize());
+        if (access == CPUAccess::ReadOnly || access == CPUAccess::ReadWrite)
+        {
+            /* Copy GPU local buffer into staging buffer for read access */
+            device_.CopyBuffer(uploadQueue_->GetCommandBuffer(), bufferVK.GetVkBuffer(), stagingBuffer, bufferVK.GetSize());
+            bufferVK.SetStagingBatchID(uploadQueue_->GetRecordingBatchID());
+            bufferVK.ValidateStagingRange();
+        }
+        else if (access == CPUAccess::WriteOnly && bufferVK.HasInvalidStagingRange())
+        {
+            /* Only refresh the outdated range, so the entire staging buffer is up to date when it is copied back on unmap */
+            const auto offset = bufferVK.GetInvalidStagingOffset();
+            device_.CopyBuffer(uploadQueue_->GetCommandBuffer(), bufferVK.GetVkBuffer(), stagingBuffer, bufferVK.GetInvalidStagingSize(), offset, offset);
+            bufferVK.SetStagingBatchID(uploadQueue_->GetRecordingBatchID());
+            bufferVK.ValidateStagingRange();
+        }
+        else if (access == CPUAccess::WriteDiscard)
+        {
+            /* Previous content is discarded, so the staging buffer is considered up to date */
+            bufferVK.ValidateStagingRange();
+        }
+
+        /* Wait only for the upload batch that last accessed the staging buffer before it is accessed by the host */
+        uploadQueue_->WaitForBatch(bufferVK.GetStagingBatchID());
 
         /* Map staging buffer */
         return bufferVK.Map(device_, access);
@@ -244,14 +302,23 @@ void VKRenderSystem::UnmapBuffer(Buffer& buffer)
 {
     auto& bufferVK = LLGL_CAST(VKBuffer&, buffer);
 
+    if (bufferVK.IsReadback())
+    {
+        bufferVK.Unmap(device_);
+        return;
+    }
+
     if (auto stagingBuffer = bufferVK.GetStagingVkBuffer())
     {
         /* Unmap staging buffer */
         bufferVK.Unmap(device_);
 
-        /* Copy staging buffer into GPU local buffer for write access */
+        /* Copy staging buffer into GPU local buffer for write access with the next upload batch */
         if (bufferVK.GetMappedCPUAccess() != CPUAccess::ReadOnly)
-            device_.CopyBuffer(stagingBuffer, bufferVK.GetVkBuffer(), bufferVK.GetSize());
+        {
+            device_.CopyBuffer(uploadQueue_->GetCommandBuffer(), stagingBuffer, bufferVK.GetVkBuffer(), bufferVK.GetSize());
+            bufferVK.SetStagingBatchID(uploadQueue_->GetRecordingBatchID());
+        }
     }
 }
 
@@ -314,21 +381,25 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
         initialData = intermediateData.get();
     }
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        initialDataSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT  // <-- TODO: support read/write mapping //GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
-    );
-
-    auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, initialData, initialDataSize);
-
     /* Create device texture */
     auto textureVK  = MakeUnique<VKTexture>(device_, *deviceMemoryMngr_, textureDesc);
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto cmdBuffer = device_.AllocCommandBuffer();
+    /* Copy initial data into staging ring buffer */
+    VkBuffer        stagingBuffer       = VK_NULL_HANDLE;
+    VkDeviceSize    stagingBufferOffset = 0;
+
+    if (initialData != nullptr)
+    {
+        stagingBuffer = uploadQueue_->StageData(
+            initialData,
+            initialDataSize,
+            GetStagingImageDataAlignment(textureDesc.format),
+            stagingBufferOffset
+        );
+    }
+
+    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state with the next upload batch */
+    auto cmdBuffer = uploadQueue_->GetCommandBuffer();
     {
         const TextureSubresource subresource{ 0, textureVK->GetNumArrayLayers(), 0, textureVK->GetNumMipLevels() };
 
@@ -341,15 +412,19 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
             subresource
         );
 
-        device_.CopyBufferToImage(
-            cmdBuffer,
-            stagingBuffer.GetVkBuffer(),
-            textureVK->GetVkImage(),
-            textureVK->GetVkFormat(),
-            VkOffset3D{ 0, 0, 0 },
-            textureVK->GetVkExtent(),
-            subresource
-        );
+        if (stagingBuffer != VK_NULL_HANDLE)
+        {
+            device_.CopyBufferToImage(
+                cmdBuffer,
+                stagingBuffer,
+                textureVK->GetVkImage(),
+                textureVK->GetVkFormat(),
+                VkOffset3D{ 0, 0, 0 },
+                textureVK->GetVkExtent(),
+                subresource,
+                stagingBufferOffset
+            );
+        }
 
         device_.TransitionImageLayout(
             cmdBuffer,
@@ -372,10 +447,6 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
             );
         }
     }
-    device_.FlushCommandBuffer(cmdBuffer);
-
-    /* Release staging buffer */
-    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
 
     /* Create image view for texture */
     textureVK->CreateInternalImageView(device_);
@@ -385,9 +456,9 @@ Texture* VKRenderSystem::CreateTexture(const TextureDescriptor& textureDesc, con
 
 void VKRenderSystem::Release(Texture& texture)
 {
-    /* Release device memory region, then release texture object */
+    /* Hand over device image to the upload queue, which releases it once all pending transfers are completed, then release texture object */
     auto& textureVK = LLGL_CAST(VKTexture&, texture);
-    deviceMemoryMngr_->Release(textureVK.GetMemoryRegion());
+    uploadQueue_->DeferRelease(std::move(textureVK.GetDeviceImage()));
     RemoveFromUniqueSet(textures_, &texture);
 }
 
@@ -438,18 +509,12 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
         imageData = imageDesc.data;
     }
 
-    /* Create staging buffer */
-    VkBufferCreateInfo stagingCreateInfo;
-    BuildVkBufferCreateInfo(
-        stagingCreateInfo,
-        imageDataSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT  // <-- TODO: support read/write mapping //GetStagingVkBufferUsageFlags(desc.cpuAccessFlags)
-    );
-
-    auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo, imageData, imageDataSize);
+    /* Copy image data into staging ring buffer */
+    VkDeviceSize stagingBufferOffset = 0;
+    auto stagingBuffer = uploadQueue_->StageData(imageData, imageDataSize, GetStagingImageDataAlignment(format), stagingBufferOffset);
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto cmdBuffer = device_.AllocCommandBuffer();
+    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state with the next upload batch */
+    auto cmdBuffer = uploadQueue_->GetCommandBuffer();
     {
         device_.TransitionImageLayout(
             cmdBuffer,
@@ -462,12 +527,13 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
 
         device_.CopyBufferToImage(
             cmdBuffer,
-            stagingBuffer.GetVkBuffer(),
+            stagingBuffer,
             image,
             textureVK.GetVkFormat(),
             VkOffset3D{ offset.x, offset.y, offset.z },
             VkExtent3D{ extent.width, extent.height, extent.depth },
-            subresource
+            subresource,
+            stagingBufferOffset
         );
 
         device_.TransitionImageLayout(
@@ -479,10 +545,6 @@ void VKRenderSystem::WriteTexture(Texture& texture, const TextureRegion& texture
             subresource
         );
     }
-    device_.FlushCommandBuffer(cmdBuffer);
-
-    /* Release staging buffer */
-    stagingBuffer.ReleaseMemoryRegion(*deviceMemoryMngr_);
 }
 
 void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureRegion, const DstImageDescriptor& imageDesc)
@@ -503,8 +565,8 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
     BuildVkBufferCreateInfo(stagingCreateInfo, imageDataSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
     auto stagingBuffer = CreateStagingBuffer(stagingCreateInfo);
 
-    /* Copy staging buffer into hardware texture, then transfer image into sampling-ready state */
-    auto cmdBuffer = device_.AllocCommandBuffer();
+    /* Copy hardware texture into staging buffer after all pending uploads, then transfer image into sampling-ready state */
+    auto cmdBuffer = uploadQueue_->GetCommandBuffer();
     {
         device_.TransitionImageLayout(
             cmdBuffer,
@@ -534,7 +596,7 @@ void VKRenderSystem::ReadTexture(Texture& texture, const TextureRegion& textureR
             textureRegion.subresource
         );
     }
-    device_.FlushCommandBuffer(cmdBuffer);
+    uploadQueue_->WaitForBatch(uploadQueue_->GetRecordingBatchID());
 
     /* Map staging buffer to CPU memory space */
     if (auto region = stagingBuffer.GetMemoryRegion())
@@ -569,7 +631,7 @@ void VKRenderSystem::Release(Sampler& sampler)
 
 ResourceHeap* VKRenderSystem::CreateResourceHeap(const ResourceHeapDescriptor& desc)
 {
-    return TakeOwnership(resourceHeaps_, MakeUnique<VKResourceHeap>(device_, desc));
+    return TakeOwnership(resourceHeaps_, MakeUnique<VKResourceHeap>(device_, *descriptorPoolAllocator_, desc));
 }
 
 void VKRenderSystem::Release(ResourceHeap& resourceHeap)
@@ -638,33 +700,52 @@ PipelineLayout* VKRenderSystem::CreatePipelineLayout(const PipelineLayoutDescrip
 
 void VKRenderSystem::Release(PipelineLayout& pipelineLayout)
 {
+    auto& pipelineLayoutVK = LLGL_CAST(VKPipelineLayout&, pipelineLayout);
+    descriptorPoolAllocator_->ReleaseSetLayout(pipelineLayoutVK.GetVkDescriptorSetLayout());
     RemoveFromUniqueSet(pipelineLayouts_, &pipelineLayout);
 }
 
 /* ----- Pipeline States ----- */
 
-PipelineState* VKRenderSystem::CreatePipelineState(const Blob& /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineState(const Blob& serializedCache)
 {
-    return nullptr;//TODO
+    /* Merge serialized cache into device-wide pipeline cache; Vulkan pipelines can't be restored without their descriptors */
+    Serialization::Deserializer reader{ serializedCache };
+    Serialization::VKReadPipelineCache(reader, device_, pipelineCache_, physicalDevice_.GetProperties());
+    return nullptr;
 }
 
-PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineState(const GraphicsPipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(
+    auto pipelineState = TakeOwnership(
         pipelineStates_,
         MakeUnique<VKGraphicsPSO>(
             device_,
             defaultPipelineLayout_,
             (!swapChains_.empty() ? (*swapChains_.begin())->GetRenderPass() : nullptr),
             desc,
-            gfxPipelineLimits_
+            gfxPipelineLimits_,
+            pipelineCache_
         )
     );
+
+    if (serializedCache != nullptr)
+        *serializedCache = SerializePipelineCache();
+
+    return pipelineState;
 }
 
-PipelineState* VKRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* /*serializedCache*/)
+PipelineState* VKRenderSystem::CreatePipelineState(const ComputePipelineDescriptor& desc, std::unique_ptr<Blob>* serializedCache)
 {
-    return TakeOwnership(pipelineStates_, MakeUnique<VKComputePSO>(device_, desc, defaultPipelineLayout_));
+    auto pipelineState = TakeOwnership(
+        pipelineStates_,
+        MakeUnique<VKComputePSO>(device_, desc, defaultPipelineLayout_, pipelineCache_)
+    );
+
+    if (serializedCache != nullptr)
+        *serializedCache = SerializePipelineCache();
+
+    return pipelineState;
 }
 
 void VKRenderSystem::Release(PipelineState& pipelineState)
@@ -866,23 +947,47 @@ void VKRenderSystem::CreateLogicalDevice()
     /* Create logical device with all supported physical device feature */
     device_ = physicalDevice_.CreateLogicalDevice();
 
-    /* Create command queue interface */
-    commandQueue_ = MakeUnique<VKCommandQueue>(device_, device_.GetVkQueue());
-
     /* Load Vulkan device extensions */
     VKLoadDeviceExtensions(device_, physicalDevice_.GetExtensionNames());
 }
 
 void VKRenderSystem::CreateDefaultPipelineLayout()
 {
+    /* Default pipeline layout has no descriptor sets, but the same push constant range as all other pipeline layouts */
+    VkPushConstantRange pushConstantRange;
+    {
+        pushConstantRange.stageFlags    = VK_SHADER_STAGE_ALL;
+        pushConstantRange.offset        = 0;
+        pushConstantRange.size          = g_maxPushConstantsSize;
+    }
+
     VkPipelineLayoutCreateInfo layoutCreateInfo = {};
     {
-        layoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutCreateInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutCreateInfo.pushConstantRangeCount = 1;
+        layoutCreateInfo.pPushConstantRanges    = &pushConstantRange;
     }
     auto result = vkCreatePipelineLayout(device_, &layoutCreateInfo, nullptr, defaultPipelineLayout_.ReleaseAndGetAddressOf());
     VKThrowIfFailed(result, "failed to create Vulkan default pipeline layout");
 }
 
+void VKRenderSystem::CreatePipelineCache()
+{
+    VkPipelineCacheCreateInfo cacheCreateInfo = {};
+    {
+        cacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    }
+    auto result = vkCreatePipelineCache(device_, &cacheCreateInfo, nullptr, pipelineCache_.ReleaseAndGetAddressOf());
+    VKThrowIfFailed(result, "failed to create Vulkan pipeline cache");
+}
+
+std::unique_ptr<Blob> VKRenderSystem::SerializePipelineCache()
+{
+    Serialization::Serializer writer;
+    Serialization::VKWritePipelineCache(writer, device_, pipelineCache_, physicalDevice_.GetProperties());
+    return writer.Finalize();
+}
+
 bool VKRenderSystem::IsLayerRequired(const char* name, const RendererConfigurationVulkan* config) const
 {
     if (config != nullptr)
@@ -15,6 +15,7 @@
 #include "../ContainerTypes.h"
 #include "Memory/VKDeviceMemoryManager.h"
 
+#include "VKUploadQueue.h"
 #include "VKCommandQueue.h"
 #include "VKCommandBuffer.h"
 #include "VKSwapChain.h"
@@ -160,6 +161,10 @@ class VKRenderSystem final : public RenderSystem
         void PickPhysicalDevice();
         void CreateLogicalDevice();
         void CreateDefaultPipelineLayout();
+        void CreatePipelineCache();
+
+        // Returns the device-wide pipeline cache as serialized blob.
+        std::unique_ptr<Blob> SerializePipelineCache();
 
         bool IsLayerRequired(const char* name, const RendererConfigurationVulkan* config) const;
         bool IsExtensionRequired(const std::string& name) const;
@@ -183,10 +188,13 @@ class VKRenderSystem final : public RenderSystem
 
         VKPtr<VkDebugReportCallbackEXT>         debugReportCallback_;
         VKPtr<VkPipelineLayout>                 defaultPipelineLayout_;
+        VKPtr<VkPipelineCache>                  pipelineCache_;
 
         bool                                    debugLayerEnabled_      = false;
 
-        std::unique_ptr<VKDeviceMemoryManager>  deviceMemoryMngr_;
+        std::unique_ptr<VKDeviceMemoryManager>      deviceMemoryMngr_;
+        std::unique_ptr<VKUploadQueue>              uploadQueue_;
+        std::unique_ptr<VKDescriptorPoolAllocator>  descriptorPoolAllocator_;
 
         VKGraphicsPipelineLimits                gfxPipelineLimits_;
 
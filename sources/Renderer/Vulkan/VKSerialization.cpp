@@ -0,0 +1,104 @@
+/*
+ * VKSerialization.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKSerialization.h"
+#include "VKCore.h"
+#include <cstring>
+#include <vector>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+VKPipelineCacheHeader VKGetPipelineCacheHeader(const VkPhysicalDeviceProperties& properties)
+{
+    VKPipelineCacheHeader header;
+    {
+        header.vendorID         = properties.vendorID;
+        header.deviceID         = properties.deviceID;
+        header.driverVersion    = properties.driverVersion;
+        std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, sizeof(header.pipelineCacheUUID));
+    }
+    return header;
+}
+
+bool VKIsPipelineCacheCompatible(const VKPipelineCacheHeader& header, const VkPhysicalDeviceProperties& properties)
+{
+    return
+    (
+        header.vendorID         == properties.vendorID      &&
+        header.deviceID         == properties.deviceID      &&
+        header.driverVersion    == properties.driverVersion &&
+        std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, sizeof(header.pipelineCacheUUID)) == 0
+    );
+}
+
+void VKWritePipelineCache(Serializer& writer, VkDevice device, VkPipelineCache pipelineCache, const VkPhysicalDeviceProperties& properties)
+{
+    /* Query pipeline cache data */
+    std::size_t dataSize = 0;
+    auto result = vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr);
+    VKThrowIfFailed(result, "failed to query size of Vulkan pipeline cache data");
+
+    std::vector<std::int8_t> data(dataSize);
+    if (dataSize > 0)
+    {
+        result = vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data());
+        VKThrowIfFailed(result, "failed to retrieve Vulkan pipeline cache data");
+    }
+
+    /* Write header and data segments */
+    const auto header = VKGetPipelineCacheHeader(properties);
+    writer.WriteSegment(VKIdent_PipelineCacheHeader, &header, sizeof(header));
+    writer.WriteSegment(VKIdent_PipelineCacheData, data.data(), dataSize);
+}
+
+bool VKReadPipelineCache(Deserializer& reader, VkDevice device, VkPipelineCache pipelineCache, const VkPhysicalDeviceProperties& properties)
+{
+    /* Read and validate header segment */
+    VKPipelineCacheHeader header;
+    reader.ReadSegment(VKIdent_PipelineCacheHeader, &header, sizeof(header));
+
+    if (!VKIsPipelineCacheCompatible(header, properties))
+        return false;
+
+    /* Create intermediate pipeline cache with the serialized data, then merge it into the destination cache */
+    auto seg = reader.ReadSegment(VKIdent_PipelineCacheData);
+    if (seg.size > 0)
+    {
+        VkPipelineCacheCreateInfo createInfo;
+        {
+            createInfo.sType            = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+            createInfo.pNext            = nullptr;
+            createInfo.flags            = 0;
+            createInfo.initialDataSize  = seg.size;
+            createInfo.pInitialData     = seg.data;
+        }
+        VkPipelineCache srcPipelineCache = VK_NULL_HANDLE;
+        auto result = vkCreatePipelineCache(device, &createInfo, nullptr, &srcPipelineCache);
+        VKThrowIfFailed(result, "failed to create Vulkan pipeline cache from serialized data");
+
+        result = vkMergePipelineCaches(device, pipelineCache, 1, &srcPipelineCache);
+        vkDestroyPipelineCache(device, srcPipelineCache, nullptr);
+        VKThrowIfFailed(result, "failed to merge Vulkan pipeline caches");
+    }
+
+    return true;
+}
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
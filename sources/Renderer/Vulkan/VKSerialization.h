@@ -0,0 +1,75 @@
+/*
+ * VKSerialization.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_SERIALIZATION_H
+#define LLGL_VK_SERIALIZATION_H
+
+
+#include "../Serialization.h"
+#include "Vulkan.h"
+#include <LLGL/RenderSystemFlags.h>
+#include <cstdint>
+
+
+namespace LLGL
+{
+
+namespace Serialization
+{
+
+
+/* ----- Enumerations ----- */
+
+// Segment identifiers for Vulkan serialization.
+enum VKIdent : IdentType
+{
+    VKIdent_ReservedVK = (RendererID::Vulkan << 8),
+    VKIdent_PipelineCacheHeader,    // VKPipelineCacheHeader
+    VKIdent_PipelineCacheData,      // Data from vkGetPipelineCacheData
+};
+
+
+/* ----- Structures ----- */
+
+// Identifies the physical device and driver a serialized pipeline cache was created with.
+struct VKPipelineCacheHeader
+{
+    std::uint32_t   vendorID;
+    std::uint32_t   deviceID;
+    std::uint32_t   driverVersion;
+    std::uint8_t    pipelineCacheUUID[VK_UUID_SIZE];
+};
+
+
+/* ----- Functions ----- */
+
+// Returns the pipeline cache header for the specified physical device properties.
+VKPipelineCacheHeader VKGetPipelineCacheHeader(const VkPhysicalDeviceProperties& properties);
+
+// Returns true if the specified pipeline cache header matches the physical device properties, i.e. the same device, driver version, and cache UUID.
+bool VKIsPipelineCacheCompatible(const VKPipelineCacheHeader& header, const VkPhysicalDeviceProperties& properties);
+
+// Writes the header and entire data of the specified pipeline cache as serialized segments.
+void VKWritePipelineCache(Serializer& writer, VkDevice device, VkPipelineCache pipelineCache, const VkPhysicalDeviceProperties& properties);
+
+/*
+Reads the header and data of a serialized pipeline cache and merges it into the specified pipeline cache.
+Returns false if the serialized cache was created with a different physical device or driver; the pipeline cache is not modified in that case.
+*/
+bool VKReadPipelineCache(Deserializer& reader, VkDevice device, VkPipelineCache pipelineCache, const VkPhysicalDeviceProperties& properties);
+
+
+} // /namespace Serialization
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
@@ -152,6 +152,8 @@ VkFormat Map(const Format format)
         case Format::BC4SNorm:          return VK_FORMAT_BC4_SNORM_BLOCK;
         case Format::BC5UNorm:          return VK_FORMAT_BC5_UNORM_BLOCK;
         case Format::BC5SNorm:          return VK_FORMAT_BC5_SNORM_BLOCK;
+        case Format::BC7UNorm:          return VK_FORMAT_BC7_UNORM_BLOCK;
+        case Format::BC7UNorm_sRGB:     return VK_FORMAT_BC7_SRGB_BLOCK;
     }
     MapFailed("Format", "VkFormat");
 }
@@ -531,6 +533,8 @@ Format Unmap(const VkFormat format)
         case VK_FORMAT_BC4_SNORM_BLOCK:             return Format::BC4SNorm;
         case VK_FORMAT_BC5_UNORM_BLOCK:             return Format::BC5UNorm;
         case VK_FORMAT_BC5_SNORM_BLOCK:             return Format::BC5SNorm;
+        case VK_FORMAT_BC7_UNORM_BLOCK:             return Format::BC7UNorm;
+        case VK_FORMAT_BC7_SRGB_BLOCK:              return Format::BC7UNorm_sRGB;
 
         default:                                    return Format::Undefined;
     }
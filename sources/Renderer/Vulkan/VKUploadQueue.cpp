@@ -0,0 +1,340 @@
+/*
+ * VKUploadQueue.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "VKUploadQueue.h"
+#include "VKDevice.h"
+#include "VKCommandQueue.h"
+#include "VKInitializers.h"
+#include "VKCore.h"
+#include "Memory/VKDeviceMemoryManager.h"
+#include "../../Core/Helper.h"
+
+
+namespace LLGL
+{
+
+
+// Returns the specified offset rounded up to the next multiple of the alignment (which is not required to be a power of two).
+static VkDeviceSize AlignUp(VkDeviceSize offset, VkDeviceSize alignment)
+{
+    return (alignment > 1 ? ((offset + alignment - 1) / alignment) * alignment : offset);
+}
+
+static VKDeviceBuffer CreateHostVisibleBuffer(const VKPtr<VkDevice>& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize size)
+{
+    VkBufferCreateInfo createInfo;
+    BuildVkBufferCreateInfo(createInfo, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    return VKDeviceBuffer
+    {
+        device,
+        createInfo,
+        deviceMemoryMngr,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+    };
+}
+
+VKUploadQueue::Batch::Batch(const VKPtr<VkDevice>& device) :
+    fence { device, vkDestroyFence }
+{
+}
+
+VKUploadQueue::VKUploadQueue(VKDevice& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize stagingBufferSize) :
+    device_             { device                                                                    },
+    deviceMemoryMngr_   { deviceMemoryMngr                                                          },
+    stagingBuffer_      { CreateHostVisibleBuffer(device.GetVkDevice(), deviceMemoryMngr, stagingBufferSize) },
+    stagingBufferSize_  { stagingBufferSize                                                         }
+{
+}
+
+VKUploadQueue::~VKUploadQueue()
+{
+    FlushAndWait();
+
+    /* Release command buffers of all pooled batches */
+    for (const auto& batch : freeBatches_)
+        vkFreeCommandBuffers(device_, device_.GetVkCommandPool(), 1, &(batch->commandBuffer));
+
+    stagingBuffer_.ReleaseMemoryRegion(deviceMemoryMngr_);
+}
+
+VkCommandBuffer VKUploadQueue::GetCommandBuffer()
+{
+    if (!recordingBatch_)
+        BeginBatch();
+    else if (recordingBatch_->hasCommands)
+        RecordTransferBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT);
+
+    recordingBatch_->hasCommands = true;
+
+    return recordingBatch_->commandBuffer;
+}
+
+VkBuffer VKUploadQueue::StageData(const void* data, VkDeviceSize dataSize, VkDeviceSize alignment, VkDeviceSize& outOffset)
+{
+    /* Reclaim ring buffer memory of completed batches */
+    RecycleCompletedBatches();
+
+    if (dataSize > stagingBufferSize_)
+    {
+        /* Copy data into dedicated staging buffer that lives as long as the current batch */
+        auto stagingBuffer = CreateHostVisibleBuffer(device_.GetVkDevice(), deviceMemoryMngr_, dataSize);
+        device_.WriteBuffer(stagingBuffer, data, dataSize);
+
+        if (!recordingBatch_)
+            BeginBatch();
+        recordingBatch_->dedicatedBuffers.emplace_back(std::move(stagingBuffer));
+
+        outOffset = 0;
+        return recordingBatch_->dedicatedBuffers.back().GetVkBuffer();
+    }
+    else
+    {
+        /* Copy data into ring buffer; this might submit the current batch if the ring buffer is full */
+        outOffset = AllocRingRange(dataSize, alignment);
+        device_.WriteBuffer(stagingBuffer_, data, dataSize, outOffset);
+
+        if (!recordingBatch_)
+            BeginBatch();
+        return stagingBuffer_.GetVkBuffer();
+    }
+}
+
+void VKUploadQueue::WriteBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize)
+{
+    if (dataSize > 0)
+    {
+        VkDeviceSize srcOffset = 0;
+        auto srcBuffer = StageData(data, dataSize, 4, srcOffset);
+        device_.CopyBuffer(GetCommandBuffer(), srcBuffer, dstBuffer, dataSize, srcOffset, dstOffset);
+    }
+}
+
+void VKUploadQueue::Flush()
+{
+    if (!recordingBatch_)
+        return;
+
+    auto cmdBuffer = recordingBatch_->commandBuffer;
+
+    /* Make all transfer writes of this batch visible to the host and all commands that are submitted afterwards */
+    RecordTransferBarrier(
+        (VK_PIPELINE_STAGE_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_HOST_BIT),
+        (VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT | VK_ACCESS_HOST_READ_BIT)
+    );
+
+    auto result = vkEndCommandBuffer(cmdBuffer);
+    VKThrowIfFailed(result, "failed to end recording Vulkan upload command buffer");
+
+    /* Submit batch and keep track of it until its fence is signaled */
+    result = VKSubmitCommandBuffer(device_.GetVkQueue(), cmdBuffer, recordingBatch_->fence);
+    VKThrowIfFailed(result, "failed to submit Vulkan upload command buffer");
+
+    recordingBatch_->ringEnd        = ringHead_;
+    recordingBatch_->hasCommands    = false;
+    batchesInFlight_.push_back(std::move(recordingBatch_));
+}
+
+void VKUploadQueue::FlushAndWait()
+{
+    Flush();
+    while (!batchesInFlight_.empty())
+    {
+        vkWaitForFences(device_, 1, &(batchesInFlight_.front()->fence), VK_TRUE, UINT64_MAX);
+        RecycleOldestBatch();
+    }
+}
+
+std::uint64_t VKUploadQueue::GetRecordingBatchID() const
+{
+    return (recordingBatch_ ? recordingBatch_->id : 0);
+}
+
+bool VKUploadQueue::IsBatchCompleted(std::uint64_t batchID)
+{
+    if (batchID > completedBatchID_)
+        RecycleCompletedBatches();
+    return (batchID <= completedBatchID_);
+}
+
+void VKUploadQueue::WaitForBatch(std::uint64_t batchID)
+{
+    if (batchID <= completedBatchID_)
+        return;
+
+    /* Submit current batch if it is the one to wait for */
+    if (recordingBatch_ && recordingBatch_->id <= batchID)
+        Flush();
+
+    /* Batches are submitted in order, so only the batches up to the specified one must be waited on */
+    while (!batchesInFlight_.empty() && batchesInFlight_.front()->id <= batchID)
+    {
+        vkWaitForFences(device_, 1, &(batchesInFlight_.front()->fence), VK_TRUE, UINT64_MAX);
+        RecycleOldestBatch();
+    }
+}
+
+void VKUploadQueue::DeferRelease(VKDeviceBuffer&& buffer)
+{
+    if (auto batch = GetLatestBatch())
+        batch->dedicatedBuffers.emplace_back(std::move(buffer));
+    else
+        buffer.ReleaseMemoryRegion(deviceMemoryMngr_);
+}
+
+void VKUploadQueue::DeferRelease(VKDeviceImage&& image)
+{
+    if (auto batch = GetLatestBatch())
+        batch->releasedImages.emplace_back(std::move(image));
+    else
+        image.ReleaseMemoryRegion(deviceMemoryMngr_);
+}
+
+
+/*
+ * ======= Private: =======
+ */
+
+void VKUploadQueue::BeginBatch()
+{
+    if (freeBatches_.empty())
+    {
+        /* Allocate new command buffer and fence */
+        auto batch = MakeUnique<Batch>(device_.GetVkDevice());
+        {
+            batch->commandBuffer = device_.AllocCommandBuffer(false);
+
+            VkFenceCreateInfo createInfo;
+            {
+                createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+                createInfo.pNext = nullptr;
+                createInfo.flags = 0;
+            }
+            auto result = vkCreateFence(device_, &createInfo, nullptr, batch->fence.ReleaseAndGetAddressOf());
+            VKThrowIfFailed(result, "failed to create Vulkan fence");
+        }
+        recordingBatch_ = std::move(batch);
+    }
+    else
+    {
+        /* Reuse command buffer and fence from pool */
+        recordingBatch_ = std::move(freeBatches_.back());
+        freeBatches_.pop_back();
+    }
+
+    recordingBatch_->id = nextBatchID_++;
+
+    /* Begin recording; the command pool allows to implicitly reset the command buffer */
+    VkCommandBufferBeginInfo beginInfo;
+    {
+        beginInfo.sType             = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.pNext             = nullptr;
+        beginInfo.flags             = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo  = nullptr;
+    }
+    auto result = vkBeginCommandBuffer(recordingBatch_->commandBuffer, &beginInfo);
+    VKThrowIfFailed(result, "failed to begin recording Vulkan upload command buffer");
+}
+
+void VKUploadQueue::RecordTransferBarrier(VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask)
+{
+    VkMemoryBarrier barrier;
+    {
+        barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.pNext           = nullptr;
+        barrier.srcAccessMask   = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask   = dstAccessMask;
+    }
+    vkCmdPipelineBarrier(
+        recordingBatch_->commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        dstStageMask,
+        0,
+        1, &barrier,
+        0, nullptr,
+        0, nullptr
+    );
+}
+
+void VKUploadQueue::RecycleOldestBatch()
+{
+    auto batch = std::move(batchesInFlight_.front());
+    batchesInFlight_.pop_front();
+
+    /* Release staging memory and all deferred resources of this batch */
+    ringTail_           = batch->ringEnd;
+    completedBatchID_   = batch->id;
+
+    for (auto& buffer : batch->dedicatedBuffers)
+        buffer.ReleaseMemoryRegion(deviceMemoryMngr_);
+    batch->dedicatedBuffers.clear();
+
+    for (auto& image : batch->releasedImages)
+        image.ReleaseMemoryRegion(deviceMemoryMngr_);
+    batch->releasedImages.clear();
+
+    vkResetFences(device_, 1, &(batch->fence));
+
+    freeBatches_.push_back(std::move(batch));
+}
+
+VKUploadQueue::Batch* VKUploadQueue::GetLatestBatch()
+{
+    if (recordingBatch_)
+        return recordingBatch_.get();
+    if (!batchesInFlight_.empty())
+        return batchesInFlight_.back().get();
+    return nullptr;
+}
+
+void VKUploadQueue::RecycleCompletedBatches()
+{
+    while (!batchesInFlight_.empty() && vkGetFenceStatus(device_, batchesInFlight_.front()->fence) == VK_SUCCESS)
+        RecycleOldestBatch();
+}
+
+VkDeviceSize VKUploadQueue::AllocRingRange(VkDeviceSize size, VkDeviceSize alignment)
+{
+    for (;;)
+    {
+        if (!recordingBatch_ && batchesInFlight_.empty())
+        {
+            /* Ring buffer is unused, so start at its beginning to avoid wrapping around */
+            ringHead_ = 0;
+            ringTail_ = 0;
+        }
+
+        /* Align offset within the ring buffer and wrap around if the range does not fit at the end */
+        const auto headOffset   = ringHead_ % stagingBufferSize_;
+        auto       offset       = AlignUp(headOffset, alignment);
+
+        if (offset + size > stagingBufferSize_)
+            offset = stagingBufferSize_;
+
+        const auto rangeStart   = ringHead_ + (offset - headOffset);
+        const auto rangeEnd     = rangeStart + size;
+
+        if (rangeEnd - ringTail_ <= stagingBufferSize_)
+        {
+            ringHead_ = rangeEnd;
+            return (rangeStart % stagingBufferSize_);
+        }
+
+        /* Ring buffer is full: submit current batch and wait for the oldest batch to release its memory */
+        if (batchesInFlight_.empty())
+            Flush();
+
+        vkWaitForFences(device_, 1, &(batchesInFlight_.front()->fence), VK_TRUE, UINT64_MAX);
+        RecycleOldestBatch();
+    }
+}
+
+
+} // /namespace LLGL
+
+
+
+// ================================================================================
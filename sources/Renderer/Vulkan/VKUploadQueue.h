@@ -0,0 +1,150 @@
+/*
+ * VKUploadQueue.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_VK_UPLOAD_QUEUE_H
+#define LLGL_VK_UPLOAD_QUEUE_H
+
+
+#include "Vulkan.h"
+#include "VKPtr.h"
+#include "Buffer/VKDeviceBuffer.h"
+#include "Texture/VKDeviceImage.h"
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <memory>
+
+
+namespace LLGL
+{
+
+
+class VKDevice;
+class VKDeviceMemoryManager;
+
+/*
+Batches resource uploads into a shared transfer command buffer instead of submitting and waiting for each of them.
+Source data is copied into a host-visible staging ring buffer and the recorded copy commands are submitted once per flush.
+Each submitted batch is tracked by a fence from a pool; its staging memory is reclaimed when the fence has been signaled.
+Batches are identified by monotonically increasing IDs, so callers can wait for the specific batch that last used a resource.
+All batches are submitted to the graphics queue and end with a global memory barrier,
+so the resources can be used by every command buffer that is submitted after the batch.
+*/
+class VKUploadQueue
+{
+
+    public:
+
+        VKUploadQueue(VKDevice& device, VKDeviceMemoryManager& deviceMemoryMngr, VkDeviceSize stagingBufferSize);
+        ~VKUploadQueue();
+
+        VKUploadQueue(const VKUploadQueue&) = delete;
+        VKUploadQueue& operator = (const VKUploadQueue&) = delete;
+
+        /*
+        Returns the command buffer of the current batch to record a new transfer operation. A new batch is started if there is none.
+        If commands have already been recorded into this batch, a barrier is inserted so that transfers to the same resource are executed in order.
+        */
+        VkCommandBuffer GetCommandBuffer();
+
+        /*
+        Copies the specified data into the staging ring buffer and returns the staging buffer that holds the data.
+        The offset of the data within the staging buffer is a multiple of 'alignment' and is written to 'outOffset'.
+        Data that exceeds the size of the ring buffer is copied into a dedicated staging buffer that is released with the current batch.
+        */
+        VkBuffer StageData(const void* data, VkDeviceSize dataSize, VkDeviceSize alignment, VkDeviceSize& outOffset);
+
+        // Copies the specified data into the staging ring buffer and records a copy command into the destination buffer.
+        void WriteBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize dataSize);
+
+        // Submits the current batch to the graphics queue without waiting for its completion.
+        void Flush();
+
+        // Submits the current batch and blocks until all batches have been completed.
+        void FlushAndWait();
+
+        // Returns the ID of the batch that is currently recorded, or zero if there is none.
+        std::uint64_t GetRecordingBatchID() const;
+
+        // Returns true if the batch with the specified ID has been completed. Batch ID zero is always completed.
+        bool IsBatchCompleted(std::uint64_t batchID);
+
+        // Submits the current batch if necessary and blocks until the batch with the specified ID has been completed.
+        void WaitForBatch(std::uint64_t batchID);
+
+        /*
+        Releases the specified buffer or image after all batches that have been recorded so far have been completed.
+        If no batch is pending, the object is released immediately.
+        */
+        void DeferRelease(VKDeviceBuffer&& buffer);
+        void DeferRelease(VKDeviceImage&& image);
+
+    private:
+
+        struct Batch
+        {
+            Batch(const VKPtr<VkDevice>& device);
+
+            VkCommandBuffer             commandBuffer   = VK_NULL_HANDLE;
+            VKPtr<VkFence>              fence;
+            std::uint64_t               id              = 0;
+            std::uint64_t               ringEnd         = 0;
+            bool                        hasCommands     = false;
+            std::vector<VKDeviceBuffer> dedicatedBuffers;
+            std::vector<VKDeviceImage>  releasedImages;
+        };
+
+    private:
+
+        // Starts recording a new batch with a command buffer and fence from the pool.
+        void BeginBatch();
+
+        // Records a global memory barrier from the transfer stage to the specified stages.
+        void RecordTransferBarrier(VkPipelineStageFlags dstStageMask, VkAccessFlags dstAccessMask);
+
+        // Releases the staging memory of the oldest batch in flight and moves it back into the pool.
+        void RecycleOldestBatch();
+
+        // Returns the most recent batch, i.e. the recording batch or the last batch in flight, or null if there is none.
+        Batch* GetLatestBatch();
+
+        // Recycles all batches whose fences have been signaled.
+        void RecycleCompletedBatches();
+
+        // Allocates a range in the staging ring buffer and blocks until older batches have released enough memory.
+        VkDeviceSize AllocRingRange(VkDeviceSize size, VkDeviceSize alignment);
+
+    private:
+
+        VKDevice&                           device_;
+        VKDeviceMemoryManager&              deviceMemoryMngr_;
+
+        VKDeviceBuffer                      stagingBuffer_;
+        VkDeviceSize                        stagingBufferSize_  = 0;
+
+        // Positions in the ring buffer (in bytes) that are increased monotonically; the offset is taken modulo the ring size.
+        std::uint64_t                       ringHead_           = 0;
+        std::uint64_t                       ringTail_           = 0;
+
+        std::uint64_t                       nextBatchID_        = 1;
+        std::uint64_t                       completedBatchID_   = 0;
+
+        std::unique_ptr<Batch>              recordingBatch_;
+        std::deque<std::unique_ptr<Batch>>  batchesInFlight_;
+        std::vector<std::unique_ptr<Batch>> freeBatches_;
+
+};
+
+
+} // /namespace LLGL
+
+
+#endif
+
+
+
+// ================================================================================
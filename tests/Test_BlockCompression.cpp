@@ -0,0 +1,230 @@
+/*
+ * Test_BlockCompression.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ImageFlags.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+
+using LLGL::ImageFormat;
+using LLGL::DataType;
+using LLGL::BlockCompressionQuality;
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("BlockCompression test failed: " + info);
+}
+
+// Test case for a compressed format with the maximum RMSE (on the scale of 8-bit components) for each quality level.
+struct CompressionTestCase
+{
+    const char*     name;
+    ImageFormat     format;
+    DataType        dataType;
+    double          maxErrorFast;
+    double          maxErrorHigh;
+};
+
+/*
+Generates a test image with smooth gradients, noise, and hard edges that cross the 4x4 blocks in the specified uncompressed format.
+The extent is not a multiple of the block size, so partial blocks at the border are covered as well.
+*/
+static std::vector<std::int8_t> GenerateImage(const LLGL::Extent3D& extent, std::uint32_t numComponents, bool isSigned)
+{
+    std::vector<std::int8_t> image(extent.width * extent.height * numComponents);
+
+    std::mt19937 rng{ 2468u };
+    std::uniform_int_distribution<int> noise{ -6, 6 };
+
+    for (std::uint32_t y = 0; y < extent.height; ++y)
+    {
+        for (std::uint32_t x = 0; x < extent.width; ++x)
+        {
+            const bool edge = ((((x + 2) / 8) + ((y + 2) / 8)) % 4 == 0);
+
+            for (std::uint32_t c = 0; c < numComponents; ++c)
+            {
+                /* Different gradient direction for each component, inverted in the regions with hard edges */
+                int value = static_cast<int>(128.0 + 100.0 * std::sin(0.11 * (c + 1) * x + 0.07 * (4 - c) * y));
+                if (c == 3)
+                    value = static_cast<int>(x * 255 / extent.width);
+                if (edge)
+                    value = 255 - value;
+
+                value = std::max(0, std::min(255, value + noise(rng)));
+
+                /* Signed components are in the range [-127, 127], since -128 and -127 are equivalent in signed normalized formats */
+                if (isSigned)
+                    value = std::max(-127, value - 128);
+
+                image[(y * extent.width + x) * numComponents + c] = static_cast<std::int8_t>(value);
+            }
+        }
+    }
+
+    return image;
+}
+
+// Returns the root mean squared error between the two images.
+static double ComputeRMSE(const std::vector<std::int8_t>& a, const std::vector<std::int8_t>& b, bool isSigned)
+{
+    double sum = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        const double x = (isSigned ? static_cast<double>(a[i]) : static_cast<double>(static_cast<std::uint8_t>(a[i])));
+        const double y = (isSigned ? static_cast<double>(b[i]) : static_cast<double>(static_cast<std::uint8_t>(b[i])));
+        sum += (x - y) * (x - y);
+    }
+    return std::sqrt(sum / static_cast<double>(a.size()));
+}
+
+// Compresses the image and decompresses it again, and returns the RMSE between the original and the decompressed image.
+static double CompressRoundtrip(
+    ImageFormat                         format,
+    ImageFormat                         uncompressedFormat,
+    DataType                            dataType,
+    const std::vector<std::int8_t>&     image,
+    const LLGL::Extent3D&               extent,
+    BlockCompressionQuality             quality)
+{
+    std::vector<char> compressed(LLGL::GetImageBufferSize(format, dataType, extent));
+
+    LLGL::CompressImageBuffer(
+        LLGL::SrcImageDescriptor{ uncompressedFormat, dataType, image.data(), image.size() },
+        extent,
+        LLGL::DstImageDescriptor{ format, dataType, compressed.data(), compressed.size() },
+        quality
+    );
+
+    std::vector<std::int8_t> decompressed(image.size());
+
+    const bool converted = LLGL::ConvertImageBuffer(
+        LLGL::SrcImageDescriptor{ format, dataType, compressed.data(), compressed.size() },
+        LLGL::DstImageDescriptor{ uncompressedFormat, dataType, decompressed.data(), decompressed.size() },
+        extent
+    );
+    Check(converted, "decompression of compressed image did not convert anything");
+
+    return ComputeRMSE(image, decompressed, dataType == DataType::Int8);
+}
+
+static ImageFormat GetUncompressedFormat(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::BC4:  return ImageFormat::R;
+        case ImageFormat::BC5:  return ImageFormat::RG;
+        default:                return ImageFormat::RGBA;
+    }
+}
+
+static void TestCompressionError(const CompressionTestCase& testCase, const LLGL::Extent3D& extent)
+{
+    const auto uncompressedFormat   = GetUncompressedFormat(testCase.format);
+    const auto numComponents        = LLGL::ImageFormatSize(uncompressedFormat);
+    const bool isSigned             = (testCase.dataType == DataType::Int8);
+
+    auto image = GenerateImage(extent, numComponents, isSigned);
+
+    /* BC1 stores only 1-bit alpha, so the image must be opaque */
+    if (testCase.format == ImageFormat::BC1)
+    {
+        for (std::size_t i = 3; i < image.size(); i += 4)
+            image[i] = static_cast<std::int8_t>(0xFF);
+    }
+
+    const double errorFast = CompressRoundtrip(testCase.format, uncompressedFormat, testCase.dataType, image, extent, BlockCompressionQuality::Fast);
+    const double errorHigh = CompressRoundtrip(testCase.format, uncompressedFormat, testCase.dataType, image, extent, BlockCompressionQuality::High);
+
+    const std::string info = std::string(testCase.name) + " (" + std::to_string(extent.width) + "x" + std::to_string(extent.height) + ")";
+
+    Check(errorFast <= testCase.maxErrorFast, info + ": RMSE of fast quality is " + std::to_string(errorFast) + " but must not exceed " + std::to_string(testCase.maxErrorFast));
+    Check(errorHigh <= testCase.maxErrorHigh, info + ": RMSE of high quality is " + std::to_string(errorHigh) + " but must not exceed " + std::to_string(testCase.maxErrorHigh));
+    Check(errorHigh <= errorFast + 0.01, info + ": RMSE of high quality (" + std::to_string(errorHigh) + ") is larger than of fast quality (" + std::to_string(errorFast) + ")");
+}
+
+static void TestCompressionErrors()
+{
+    const CompressionTestCase testCases[] =
+    {
+        //  name            format              dataType            fast    high
+        {   "BC1",          ImageFormat::BC1,   DataType::UInt8,    16.0,   14.5 },
+        {   "BC2",          ImageFormat::BC2,   DataType::UInt8,    16.0,   14.5 },
+        {   "BC3",          ImageFormat::BC3,   DataType::UInt8,    16.0,   14.5 },
+        {   "BC4 UNorm",    ImageFormat::BC4,   DataType::UInt8,    5.75,   4.75 },
+        {   "BC4 SNorm",    ImageFormat::BC4,   DataType::Int8,     5.75,   4.75 },
+        {   "BC5 UNorm",    ImageFormat::BC5,   DataType::UInt8,    5.75,   5.0  },
+        {   "BC5 SNorm",    ImageFormat::BC5,   DataType::Int8,     5.75,   5.0  },
+        {   "BC7",          ImageFormat::BC7,   DataType::UInt8,    13.5,   8.0  },
+    };
+
+    for (const auto& testCase : testCases)
+    {
+        TestCompressionError(testCase, LLGL::Extent3D{ 64, 64, 1 });
+        TestCompressionError(testCase, LLGL::Extent3D{ 61, 37, 1 });
+    }
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+// Compresses an image of a single color, which must be reproduced up to the precision of the endpoints of each format
+static void TestSolidColor()
+{
+    const LLGL::Extent3D extent{ 13, 7, 1 };
+
+    const CompressionTestCase testCases[] =
+    {
+        //  name            format              dataType            fast    high
+        {   "BC1",          ImageFormat::BC1,   DataType::UInt8,    2.5,    2.5 },
+        {   "BC2",          ImageFormat::BC2,   DataType::UInt8,    2.5,    2.5 },
+        {   "BC3",          ImageFormat::BC3,   DataType::UInt8,    2.5,    2.5 },
+        {   "BC4",          ImageFormat::BC4,   DataType::UInt8,    0.0,    0.0 },
+        {   "BC5",          ImageFormat::BC5,   DataType::UInt8,    0.0,    0.0 },
+        {   "BC7",          ImageFormat::BC7,   DataType::UInt8,    1.0,    0.5 },
+    };
+
+    for (const auto& testCase : testCases)
+    {
+        const auto uncompressedFormat   = GetUncompressedFormat(testCase.format);
+        const auto numComponents        = LLGL::ImageFormatSize(uncompressedFormat);
+
+        std::vector<std::int8_t> image(extent.width * extent.height * numComponents);
+        for (std::size_t i = 0; i < image.size(); ++i)
+            image[i] = static_cast<std::int8_t>(i % numComponents == 3 ? 0xFF : 0x40 + 0x30 * (i % numComponents));
+
+        const double errorFast = CompressRoundtrip(testCase.format, uncompressedFormat, testCase.dataType, image, extent, BlockCompressionQuality::Fast);
+        const double errorHigh = CompressRoundtrip(testCase.format, uncompressedFormat, testCase.dataType, image, extent, BlockCompressionQuality::High);
+
+        Check(errorFast <= testCase.maxErrorFast, std::string(testCase.name) + ": RMSE of solid color with fast quality is " + std::to_string(errorFast));
+        Check(errorHigh <= testCase.maxErrorHigh, std::string(testCase.name) + ": RMSE of solid color with high quality is " + std::to_string(errorHigh));
+    }
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        TestCompressionErrors();
+        TestSolidColor();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+/*
+ * Test_Float16.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Core/Float16Compressor.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("Float16 test failed: " + info);
+}
+
+static std::uint32_t FloatToBits(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float BitsToFloat(std::uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+static std::string ToHex(std::uint32_t value)
+{
+    std::stringstream s;
+    s << "0x" << std::hex << std::setw(8) << std::setfill('0') << value;
+    return s.str();
+}
+
+// Decompresses all 65536 16-bit floats with the batch function and compares them bit by bit against the scalar function
+static void TestDecompressExhaustive()
+{
+    std::vector<std::uint16_t> src(65536);
+    for (std::size_t i = 0; i < src.size(); ++i)
+        src[i] = static_cast<std::uint16_t>(i);
+
+    /* Use unaligned begin offsets, so each value is also converted in a different vector lane and in the scalar tail loop */
+    for (std::size_t offset = 0; offset < 8; ++offset)
+    {
+        const std::size_t count = src.size() - offset;
+
+        std::vector<float> dst(count);
+        LLGL::DecompressFloat16Array(src.data() + offset, dst.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto value    = src[offset + i];
+            const auto actual   = FloatToBits(dst[i]);
+            const auto expected = FloatToBits(LLGL::DecompressFloat16(value));
+            Check(
+                actual == expected,
+                "decompression of " + ToHex(value) + " at offset " + std::to_string(offset) + " is " + ToHex(actual) + " but expected " + ToHex(expected)
+            );
+        }
+    }
+
+    /* Compressing a decompressed value must yield the original value again (except for NaN payloads) */
+    for (std::uint32_t i = 0; i < 65536; ++i)
+    {
+        const auto value = static_cast<std::uint16_t>(i);
+        if ((value & 0x7fff) > 0x7c00)
+            continue;
+
+        const auto actual = LLGL::CompressFloat16(LLGL::DecompressFloat16(value));
+        Check(actual == value, "roundtrip of " + ToHex(value) + " is " + ToHex(actual));
+    }
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+// Returns a list of 32-bit floats with special values, values around the limits of 16-bit floats, and random values
+static std::vector<float> GenerateCompressionInput(std::size_t numRandomValues)
+{
+    std::vector<std::uint32_t> bits
+    {
+        0x00000000, // +0
+        0x80000000, // -0
+        0x7f800000, // +Inf
+        0xff800000, // -Inf
+        0x7fc00000, // quiet NaN
+        0xffc00000, // negative quiet NaN
+        0x7f800001, // signaling NaN with smallest payload
+        0x7fbfffff, // signaling NaN with largest payload
+        0x7f802000, // NaN with payload in the upper bits of the 16-bit mantissa
+        0x00000001, // smallest 32-bit denormal
+        0x007fffff, // largest 32-bit denormal
+        0x00800000, // smallest 32-bit normal
+        0x33800000, // smallest 16-bit denormal (2^-24)
+        0x337fffff, // just below smallest 16-bit denormal
+        0x387fc000, // largest 16-bit denormal
+        0x38800000, // smallest 16-bit normal (2^-14)
+        0x387fffff, // just below smallest 16-bit normal
+        0x477fe000, // largest 16-bit normal (65504)
+        0x477fe001, // just above largest 16-bit normal
+        0x477fefff, // just below halfway between largest 16-bit normal and 2^16
+        0x477ff000, // halfway between largest 16-bit normal and 2^16
+        0x47800000, // 2^16
+        0x7f7fffff, // largest 32-bit normal
+        0x3f800000, // 1.0
+        0x3f801000, // tie between 1.0 and the next 16-bit float
+        0x3f803000, // tie between the first and second 16-bit float after 1.0
+        0x3c001000, // tie of a normal 16-bit float
+        0x33c00000, // tie between the smallest and second smallest 16-bit denormal
+        0x34200000, // tie between two 16-bit denormals
+    };
+
+    std::mt19937 rng{ 4321u };
+
+    for (std::size_t i = 0; i < numRandomValues; ++i)
+    {
+        const std::uint32_t sign = (rng() & 1u) << 31;
+
+        switch (i % 6)
+        {
+            case 0:
+                /* Any bit pattern, including NaNs and infinities */
+                bits.push_back(rng());
+                break;
+            case 1:
+                /* Normal 16-bit range with exponents in [-14, 15] */
+                bits.push_back(sign | ((113u + rng() % 30u) << 23) | (rng() & 0x007fffffu));
+                break;
+            case 2:
+                /* 16-bit denormal range with exponents in [-25, -15] */
+                bits.push_back(sign | ((102u + rng() % 11u) << 23) | (rng() & 0x007fffffu));
+                break;
+            case 3:
+                /* Exact ties: the first bit below the 16-bit mantissa is set and all following bits are cleared */
+                bits.push_back(sign | ((113u + rng() % 30u) << 23) | (rng() & 0x007fe000u) | 0x00001000u);
+                break;
+            case 4:
+                /* NaNs with random payloads */
+                bits.push_back(sign | 0x7f800000u | ((rng() & 0x007fffffu) | 1u));
+                break;
+            case 5:
+                /* Values that exceed the 16-bit range */
+                bits.push_back(sign | ((143u + rng() % 112u) << 23) | (rng() & 0x007fffffu));
+                break;
+        }
+    }
+
+    std::vector<float> values(bits.size());
+    for (std::size_t i = 0; i < bits.size(); ++i)
+        values[i] = BitsToFloat(bits[i]);
+
+    return values;
+}
+
+// Compresses random 32-bit floats with the batch function and compares them bit by bit against the scalar function
+static void TestCompressRandomized()
+{
+    /* Shuffle the input several times, so special values are mixed with others in the same vector */
+    auto shuffled = GenerateCompressionInput(600000);
+    std::mt19937 rng{ 8765u };
+
+    for (int pass = 0; pass < 4; ++pass)
+    {
+        const std::size_t offset = static_cast<std::size_t>(pass) * 3;
+        const std::size_t count = shuffled.size() - offset;
+
+        std::vector<std::uint16_t> dst(count);
+        LLGL::CompressFloat16Array(shuffled.data() + offset, dst.data(), count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto value    = shuffled[offset + i];
+            const auto expected = LLGL::CompressFloat16(value);
+            Check(
+                dst[i] == expected,
+                "compression of " + ToHex(FloatToBits(value)) + " at offset " + std::to_string(offset) + " is " +
+                ToHex(dst[i]) + " but expected " + ToHex(expected)
+            );
+        }
+
+        std::shuffle(shuffled.begin(), shuffled.end(), rng);
+    }
+
+    /* Check the semantics of the scalar function for the special values: NaN and Inf are preserved and ties are truncated */
+    Check(LLGL::CompressFloat16(BitsToFloat(0x7f800000)) == 0x7c00, "compression of +Inf");
+    Check(LLGL::CompressFloat16(BitsToFloat(0xff800000)) == 0xfc00, "compression of -Inf");
+    Check((LLGL::CompressFloat16(BitsToFloat(0x7fc00000)) & 0x7fff) > 0x7c00, "compression of quiet NaN");
+    Check((LLGL::CompressFloat16(BitsToFloat(0x7f800001)) & 0x7fff) > 0x7c00, "compression of signaling NaN");
+    Check(LLGL::CompressFloat16(BitsToFloat(0x477fe000)) == 0x7bff, "compression of largest 16-bit normal");
+    Check(LLGL::CompressFloat16(BitsToFloat(0x33800000)) == 0x0001, "compression of smallest 16-bit denormal");
+    Check(LLGL::CompressFloat16(BitsToFloat(0x337fffff)) == 0x0000, "compression of value below smallest 16-bit denormal");
+    Check(LLGL::CompressFloat16(BitsToFloat(0x3f801000)) == 0x3c00, "compression of tie after 1.0");
+    Check(LLGL::CompressFloat16(BitsToFloat(0xbf801000)) == 0xbc00, "compression of tie after -1.0");
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        TestDecompressExhaustive();
+        TestCompressRandomized();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,213 @@
+/*
+ * Test_GLCommandOptimizer.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include "../sources/Renderer/OpenGL/Command/GLCommandOpcode.h"
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+#ifdef LLGL_DEBUG
+
+namespace LLGL
+{
+LLGL_EXPORT void GetGLCommandBufferOpcodes(const CommandBuffer& commandBuffer, std::vector<GLOpcode>& outOpcodes);
+}
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("check failed: " + info);
+}
+
+static std::string OpcodeSequenceToString(const std::vector<LLGL::GLOpcode>& opcodes)
+{
+    std::string s;
+    for (auto opcode : opcodes)
+    {
+        if (!s.empty())
+            s += ", ";
+        s += std::to_string(static_cast<int>(opcode));
+    }
+    return "{ " + s + " }";
+}
+
+static void CheckOpcodeSequence(const LLGL::CommandBuffer& commands, const std::vector<LLGL::GLOpcode>& expected, const std::string& info)
+{
+    std::vector<LLGL::GLOpcode> opcodes;
+    LLGL::GetGLCommandBufferOpcodes(commands, opcodes);
+
+    Check(
+        opcodes == expected,
+        info + ": expected opcodes " + OpcodeSequenceToString(expected) + " but got " + OpcodeSequenceToString(opcodes)
+    );
+}
+
+// Records redundant bindings, overwritten state updates, and bindings of consecutive slots, and verifies the optimized command stream
+static void TestRedundantCommands(LLGL::RenderSystem& renderer)
+{
+    // Create two constant buffers and two textures to bind them to consecutive slots
+    LLGL::BufferDescriptor bufferDesc;
+    {
+        bufferDesc.size         = 64;
+        bufferDesc.bindFlags    = LLGL::BindFlags::ConstantBuffer;
+    }
+    auto constantBuffer0 = renderer.CreateBuffer(bufferDesc);
+    auto constantBuffer1 = renderer.CreateBuffer(bufferDesc);
+
+    LLGL::TextureDescriptor textureDesc;
+    {
+        textureDesc.type        = LLGL::TextureType::Texture2D;
+        textureDesc.bindFlags   = LLGL::BindFlags::Sampled;
+        textureDesc.miscFlags   = 0;
+        textureDesc.format      = LLGL::Format::RGBA8UNorm;
+        textureDesc.extent      = { 4, 4, 1 };
+    }
+    auto texture0 = renderer.CreateTexture(textureDesc);
+    auto texture1 = renderer.CreateTexture(textureDesc);
+
+    const float colorA[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+    const float colorB[4] = { 0.0f, 1.0f, 0.0f, 1.0f };
+
+    // Record commands; they are never submitted, so no pipeline state is required
+    auto commands = renderer.CreateCommandBuffer(LLGL::CommandBufferDescriptor{ LLGL::CommandBufferFlags::MultiSubmit });
+
+    commands->Begin();
+    {
+        // Buffer bindings of consecutive slots with a redundant one in between
+        commands->SetResource(*constantBuffer0, 0, LLGL::BindFlags::ConstantBuffer);
+        commands->SetResource(*constantBuffer1, 1, LLGL::BindFlags::ConstantBuffer);
+        commands->SetResource(*constantBuffer0, 0, LLGL::BindFlags::ConstantBuffer);
+
+        // Texture bindings of consecutive slots followed by a redundant one
+        commands->SetResource(*texture0, 0, LLGL::BindFlags::Sampled);
+        commands->SetResource(*texture1, 1, LLGL::BindFlags::Sampled);
+        commands->SetResource(*texture1, 1, LLGL::BindFlags::Sampled);
+
+        // Back-to-back state updates of which only the last ones must remain
+        commands->SetViewport(LLGL::Viewport{ 0.0f, 0.0f, 64.0f, 64.0f });
+        commands->SetViewport(LLGL::Viewport{ 0.0f, 0.0f, 32.0f, 32.0f });
+        commands->SetScissor(LLGL::Scissor{ 0, 0, 64, 64 });
+        commands->SetScissor(LLGL::Scissor{ 0, 0, 32, 32 });
+        commands->SetUniform(0, colorA, sizeof(colorA));
+        commands->SetUniform(0, colorB, sizeof(colorB));
+        commands->Draw(3, 0);
+
+        // Bindings and viewport are unchanged by the draw command, so they are redundant, but the uniform update is not
+        commands->SetResource(*constantBuffer0, 0, LLGL::BindFlags::ConstantBuffer);
+        commands->SetResource(*texture0, 0, LLGL::BindFlags::Sampled);
+        commands->SetViewport(LLGL::Viewport{ 0.0f, 0.0f, 32.0f, 32.0f });
+        commands->SetUniform(0, colorA, sizeof(colorA));
+        commands->Draw(3, 0);
+    }
+    commands->End();
+
+    const std::vector<LLGL::GLOpcode> expected
+    {
+        LLGL::GLOpcodeBindBuffersBase,
+        #ifdef LLGL_GL_ENABLE_OPENGL2X
+        LLGL::GLOpcodeBindTexture,
+        LLGL::GLOpcodeBindTexture,
+        #else
+        LLGL::GLOpcodeBindTextures,
+        #endif
+        LLGL::GLOpcodeViewport,
+        LLGL::GLOpcodeScissor,
+        LLGL::GLOpcodeSetUniforms,
+        LLGL::GLOpcodeDrawArrays,
+        LLGL::GLOpcodeSetUniforms,
+        LLGL::GLOpcodeDrawArrays,
+    };
+    CheckOpcodeSequence(*commands, expected, "redundant commands");
+
+    renderer.Release(*commands);
+    renderer.Release(*texture1);
+    renderer.Release(*texture0);
+    renderer.Release(*constantBuffer1);
+    renderer.Release(*constantBuffer0);
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+// Records consecutive indexed draw commands into a command buffer that is submitted only once and verifies that they are merged without removing redundant commands
+static void TestDrawBatching(LLGL::RenderSystem& renderer)
+{
+    const std::uint32_t indices[] = { 0, 1, 2, 2, 1, 3 };
+
+    LLGL::BufferDescriptor indexBufferDesc;
+    {
+        indexBufferDesc.size        = sizeof(indices);
+        indexBufferDesc.bindFlags   = LLGL::BindFlags::IndexBuffer;
+        indexBufferDesc.format      = LLGL::Format::R32UInt;
+    }
+    auto indexBuffer = renderer.CreateBuffer(indexBufferDesc, indices);
+
+    auto commands = renderer.CreateCommandBuffer();
+
+    commands->Begin();
+    {
+        commands->SetIndexBuffer(*indexBuffer);
+        commands->SetViewport(LLGL::Viewport{ 0.0f, 0.0f, 64.0f, 64.0f });
+        commands->SetViewport(LLGL::Viewport{ 0.0f, 0.0f, 32.0f, 32.0f });
+        commands->DrawIndexed(3, 0);
+        commands->DrawIndexed(3, 3);
+    }
+    commands->End();
+
+    // Draw commands are merged into either glMultiDrawElementsIndirect or glMultiDrawElementsBaseVertex depending on the GL extensions
+    std::vector<LLGL::GLOpcode> opcodes;
+    LLGL::GetGLCommandBufferOpcodes(*commands, opcodes);
+
+    Check(opcodes.size() == 4, "draw batching: expected 4 commands but got " + std::to_string(opcodes.size()));
+    Check(opcodes[0] == LLGL::GLOpcodeBindElementArrayBufferToVAO, "draw batching: index buffer binding");
+    Check(opcodes[1] == LLGL::GLOpcodeViewport && opcodes[2] == LLGL::GLOpcodeViewport, "draw batching: redundant viewports must be kept");
+    Check(
+        opcodes[3] == LLGL::GLOpcodeMultiDrawElementsIndirect || opcodes[3] == LLGL::GLOpcodeMultiDrawElementsBaseVertex,
+        "draw batching: merged draw command"
+    );
+
+    renderer.Release(*commands);
+    renderer.Release(*indexBuffer);
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        auto renderer = LLGL::RenderSystem::Load("OpenGL");
+
+        // Create swap chain to get a GL context
+        LLGL::SwapChainDescriptor swapChainDesc;
+        swapChainDesc.resolution = { 320, 240 };
+        renderer->CreateSwapChain(swapChainDesc);
+
+        TestRedundantCommands(*renderer);
+        TestDrawBatching(*renderer);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+#else // LLGL_DEBUG
+
+int main()
+{
+    std::cerr << "Test_GLCommandOptimizer requires a debug build of LLGL" << std::endl;
+    return 0;
+}
+
+#endif // /LLGL_DEBUG
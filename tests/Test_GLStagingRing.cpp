@@ -0,0 +1,218 @@
+/*
+ * Test_GLStagingRing.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include "../sources/Renderer/OpenGL/Command/GLCommandOpcode.h"
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+#ifdef LLGL_DEBUG
+
+namespace LLGL
+{
+LLGL_EXPORT void GetGLCommandBufferOpcodes(const CommandBuffer& commandBuffer, std::vector<GLOpcode>& outOpcodes);
+}
+
+// Size (in bytes) of each buffer update; this is close to the maximum of CommandBuffer::UpdateBuffer, so a few updates fill an entire ring segment.
+static const std::uint16_t g_updateSize = 65532;
+
+// Number of updates that exceed the entire staging ring of 4 segments with 1 MiB each.
+static const std::uint32_t g_numUpdatesPerRing = (4u << 20) / g_updateSize + 1;
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("GLStagingRing test failed: " + info);
+}
+
+static std::vector<std::uint32_t> GeneratePattern(std::uint32_t seed)
+{
+    std::vector<std::uint32_t> pattern(g_updateSize / sizeof(std::uint32_t));
+    for (std::size_t i = 0; i < pattern.size(); ++i)
+        pattern[i] = seed * 0x9E3779B9u + static_cast<std::uint32_t>(i);
+    return pattern;
+}
+
+// Returns true if the buffer update of the specified command buffer has been staged in the ring instead of being stored in the command stream.
+static bool IsUpdateStaged(const LLGL::CommandBuffer& commands)
+{
+    std::vector<LLGL::GLOpcode> opcodes;
+    LLGL::GetGLCommandBufferOpcodes(commands, opcodes);
+
+    Check(opcodes.size() == 1, "expected 1 command but got " + std::to_string(opcodes.size()));
+    Check(
+        opcodes[0] == LLGL::GLOpcodeCopyBufferSubData || opcodes[0] == LLGL::GLOpcodeBufferSubData,
+        "expected buffer update command but got opcode " + std::to_string(static_cast<int>(opcodes[0]))
+    );
+
+    return (opcodes[0] == LLGL::GLOpcodeCopyBufferSubData);
+}
+
+static LLGL::Buffer* CreateDstBuffer(LLGL::RenderSystem& renderer, std::uint32_t numRegions)
+{
+    LLGL::BufferDescriptor bufferDesc;
+    {
+        bufferDesc.size             = static_cast<std::uint64_t>(g_updateSize) * numRegions;
+        bufferDesc.bindFlags        = LLGL::BindFlags::CopyDst;
+        bufferDesc.cpuAccessFlags   = LLGL::CPUAccessFlags::Read;
+    }
+    return renderer.CreateBuffer(bufferDesc);
+}
+
+static void CheckRegion(LLGL::RenderSystem& renderer, LLGL::Buffer& buffer, std::uint32_t region, const std::vector<std::uint32_t>& expected, const std::string& info)
+{
+    auto data = static_cast<const std::uint32_t*>(renderer.MapBuffer(buffer, LLGL::CPUAccess::ReadOnly));
+    Check(data != nullptr, info + ": failed to map buffer");
+
+    const auto regionData = data + region * expected.size();
+    bool equal = true;
+    for (std::size_t i = 0; i < expected.size() && equal; ++i)
+        equal = (regionData[i] == expected[i]);
+
+    renderer.UnmapBuffer(buffer);
+
+    Check(equal, info + ": content of region " + std::to_string(region) + " does not match the update");
+}
+
+/*
+Submits one-shot command buffers with buffer updates until the staging ring has wrapped around several times.
+Each segment is released after submission, so its fence must be reused and no update may fall back to the command stream.
+*/
+static void TestRingWrap(LLGL::RenderSystem& renderer, bool& isStagingSupported)
+{
+    const std::uint32_t numRounds = 3;
+
+    auto dstBuffer  = CreateDstBuffer(renderer, g_numUpdatesPerRing);
+    auto commands   = renderer.CreateCommandBuffer();
+    auto queue      = renderer.GetCommandQueue();
+
+    for (std::uint32_t round = 0; round < numRounds; ++round)
+    {
+        for (std::uint32_t region = 0; region < g_numUpdatesPerRing; ++region)
+        {
+            const auto pattern = GeneratePattern(round * g_numUpdatesPerRing + region);
+
+            commands->Begin();
+            {
+                commands->UpdateBuffer(*dstBuffer, static_cast<std::uint64_t>(region) * g_updateSize, pattern.data(), g_updateSize);
+            }
+            commands->End();
+
+            /* Staging is only available with GL_ARB_buffer_storage, GL_ARB_sync, and GL_ARB_copy_buffer */
+            const bool isStaged = IsUpdateStaged(*commands);
+            if (round == 0 && region == 0)
+                isStagingSupported = isStaged;
+            else
+                Check(isStaged == isStagingSupported, "update " + std::to_string(region) + " in round " + std::to_string(round) + " fell back to the command stream");
+
+            queue->Submit(*commands);
+        }
+
+        for (std::uint32_t region = 0; region < g_numUpdatesPerRing; ++region)
+            CheckRegion(renderer, *dstBuffer, region, GeneratePattern(round * g_numUpdatesPerRing + region), "round " + std::to_string(round));
+    }
+
+    renderer.Release(*commands);
+    renderer.Release(*dstBuffer);
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+/*
+Records a buffer update that is not submitted until more data than the entire ring has been written by immediate buffer writes.
+The held segment must not be overwritten, and command buffers that are re-recorded without submission must release their segments.
+*/
+static void TestPendingReservation(LLGL::RenderSystem& renderer, bool isStagingSupported)
+{
+    auto dstBuffer      = CreateDstBuffer(renderer, 1);
+    auto scratchBuffer  = CreateDstBuffer(renderer, 1);
+    auto commands       = renderer.CreateCommandBuffer();
+    auto queue          = renderer.GetCommandQueue();
+
+    const auto pattern = GeneratePattern(0xABCDu);
+
+    commands->Begin();
+    {
+        commands->UpdateBuffer(*dstBuffer, 0, pattern.data(), g_updateSize);
+    }
+    commands->End();
+
+    Check(IsUpdateStaged(*commands) == isStagingSupported, "pending update was not staged");
+
+    /* Immediate writes must fall back to glBufferSubData once they reach the held segment */
+    for (std::uint32_t i = 0; i < 2 * g_numUpdatesPerRing; ++i)
+    {
+        const auto scratchPattern = GeneratePattern(i);
+        renderer.WriteBuffer(*scratchBuffer, 0, scratchPattern.data(), g_updateSize);
+    }
+
+    CheckRegion(renderer, *scratchBuffer, 0, GeneratePattern(2 * g_numUpdatesPerRing - 1), "immediate writes");
+
+    queue->Submit(*commands);
+    CheckRegion(renderer, *dstBuffer, 0, pattern, "pending update");
+
+    /* Command buffers that are recorded again without being submitted must not hold their segments */
+    for (std::uint32_t i = 0; i < 2 * g_numUpdatesPerRing; ++i)
+    {
+        const auto discardedPattern = GeneratePattern(i);
+
+        commands->Begin();
+        {
+            commands->UpdateBuffer(*dstBuffer, 0, discardedPattern.data(), g_updateSize);
+        }
+        commands->End();
+
+        Check(IsUpdateStaged(*commands) == isStagingSupported, "discarded update " + std::to_string(i) + " fell back to the command stream");
+    }
+
+    renderer.Release(*commands);
+    renderer.Release(*scratchBuffer);
+    renderer.Release(*dstBuffer);
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        auto renderer = LLGL::RenderSystem::Load("OpenGL");
+
+        // Create swap chain to get a GL context
+        LLGL::SwapChainDescriptor swapChainDesc;
+        swapChainDesc.resolution = { 320, 240 };
+        renderer->CreateSwapChain(swapChainDesc);
+
+        bool isStagingSupported = false;
+        TestRingWrap(*renderer, isStagingSupported);
+        TestPendingReservation(*renderer, isStagingSupported);
+
+        if (!isStagingSupported)
+            std::cout << "staging ring is not supported; only the fallback path was tested" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+#else // LLGL_DEBUG
+
+int main()
+{
+    std::cerr << "Test_GLStagingRing requires a debug build of LLGL" << std::endl;
+    return 0;
+}
+
+#endif // /LLGL_DEBUG
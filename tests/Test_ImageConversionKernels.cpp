@@ -0,0 +1,164 @@
+/*
+ * Test_ImageConversionKernels.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Core/ImageConversionKernels.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+
+using LLGL::DataType;
+using LLGL::DataTypeConversionKernel;
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("ImageConversionKernels test failed: " + info);
+}
+
+// Scalar reference conversions of the generic image conversion in "ImageFlags.cpp"
+static float ReferenceUInt8ToFloat32(std::uint8_t value)
+{
+    return static_cast<float>(static_cast<double>(value) / 255.0);
+}
+
+static std::uint8_t ReferenceFloat32ToUInt8(float value)
+{
+    return static_cast<std::uint8_t>(static_cast<double>(value) * 255.0);
+}
+
+static bool IsBitIdentical(float a, float b)
+{
+    return (std::memcmp(&a, &b, sizeof(float)) == 0);
+}
+
+/*
+Returns the ranges [idxBegin, idxEnd) the kernels are tested with. Their lengths cover all remainders of the vector widths (4, 8, and 16 elements),
+and their begin offsets are not aligned, so both the vectorized loop and the scalar tail loop are exercised.
+*/
+static std::vector<std::pair<std::size_t, std::size_t>> GetTestRanges()
+{
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+
+    for (std::size_t offset = 0; offset < 4; ++offset)
+    {
+        for (std::size_t count = 0; count <= 67; ++count)
+            ranges.push_back({ offset, offset + count });
+        for (std::size_t count : { 255, 256, 1000, 1023 })
+            ranges.push_back({ offset, offset + count });
+    }
+
+    return ranges;
+}
+
+static std::string RangeToString(const std::pair<std::size_t, std::size_t>& range)
+{
+    return "[" + std::to_string(range.first) + ", " + std::to_string(range.second) + ")";
+}
+
+static void TestUInt8ToFloat32()
+{
+    auto kernel = LLGL::FindDataTypeConversionKernel(DataType::UInt8, DataType::Float32);
+    Check(kernel != nullptr, "missing UInt8 to Float32 kernel");
+
+    /* Fill source with all 256 values repeatedly, followed by random values */
+    const std::size_t numElements = 1100;
+
+    std::vector<std::uint8_t> src(numElements);
+    std::mt19937 rng{ 1234u };
+    for (std::size_t i = 0; i < numElements; ++i)
+        src[i] = static_cast<std::uint8_t>(i < 512 ? i : rng());
+
+    for (const auto& range : GetTestRanges())
+    {
+        /* Initialize destination with a sentinel value to detect writes outside of the range */
+        const float sentinel = -1.0f;
+        std::vector<float> dst(numElements, sentinel);
+
+        kernel(src.data(), dst.data(), range.first, range.second);
+
+        for (std::size_t i = 0; i < numElements; ++i)
+        {
+            const auto expected = (i >= range.first && i < range.second ? ReferenceUInt8ToFloat32(src[i]) : sentinel);
+            Check(
+                IsBitIdentical(dst[i], expected),
+                "UInt8 to Float32 in range " + RangeToString(range) + ": element " + std::to_string(i) +
+                " (" + std::to_string(src[i]) + ") is " + std::to_string(dst[i]) + " but expected " + std::to_string(expected)
+            );
+        }
+    }
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+static void TestFloat32ToUInt8()
+{
+    auto kernel = LLGL::FindDataTypeConversionKernel(DataType::Float32, DataType::UInt8);
+    Check(kernel != nullptr, "missing Float32 to UInt8 kernel");
+
+    /* Fill source with the exact quotients (x / 255) and their direct neighbors, where truncation is most sensitive, followed by random values in [0, 1] */
+    std::vector<float> src;
+
+    for (int x = 0; x <= 255; ++x)
+    {
+        const auto value = static_cast<float>(x) / 255.0f;
+        src.push_back(value);
+        if (x > 0)
+            src.push_back(std::nextafter(value, 0.0f));
+        if (x < 255)
+            src.push_back(std::nextafter(value, 1.0f));
+    }
+
+    std::mt19937 rng{ 5678u };
+    std::uniform_real_distribution<float> distrib{ 0.0f, 1.0f };
+    while (src.size() < 1100)
+        src.push_back(distrib(rng));
+
+    const std::size_t numElements = src.size();
+
+    for (const auto& range : GetTestRanges())
+    {
+        /* Initialize destination with a sentinel value to detect writes outside of the range */
+        const std::uint8_t sentinel = 0xCD;
+        std::vector<std::uint8_t> dst(numElements, sentinel);
+
+        kernel(src.data(), dst.data(), range.first, range.second);
+
+        for (std::size_t i = 0; i < numElements; ++i)
+        {
+            const auto expected = (i >= range.first && i < range.second ? ReferenceFloat32ToUInt8(src[i]) : sentinel);
+            Check(
+                dst[i] == expected,
+                "Float32 to UInt8 in range " + RangeToString(range) + ": element " + std::to_string(i) +
+                " (" + std::to_string(src[i]) + ") is " + std::to_string(dst[i]) + " but expected " + std::to_string(expected)
+            );
+        }
+    }
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        TestUInt8ToFloat32();
+        TestFloat32ToUInt8();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
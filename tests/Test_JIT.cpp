@@ -6,25 +6,207 @@
  */
 
 #include <LLGL/LLGL.h>
+#include <cstdint>
+#include <vector>
 
 
-#if defined LLGL_ENABLE_JIT_COMPILER && defined LLGL_DEBUG
+#if defined LLGL_ENABLE_JIT_COMPILER
 
+#ifdef LLGL_DEBUG
 namespace LLGL
 {
 LLGL_EXPORT void TestJIT1();
 }
+#endif // /LLGL_DEBUG
 
+// Resources of the test scene that is rendered with both the JIT compiled and the interpreted command buffer
+struct TestScene
+{
+    LLGL::RenderSystem*     renderer        = nullptr;
+    LLGL::Texture*          targetTexture   = nullptr;
+    LLGL::RenderTarget*     renderTarget    = nullptr;
+    LLGL::PipelineState*    pipeline        = nullptr;
+    LLGL::Buffer*           vertexBuffer    = nullptr;
+    LLGL::UniformLocation   colorLocation   = 0;
+};
+
+static const std::uint32_t g_targetSize = 64;
+
+static TestScene CreateTestScene(LLGL::RenderSystem* renderer)
+{
+    TestScene scene;
+    scene.renderer = renderer;
+
+    // Create render target with a single color attachment
+    LLGL::TextureDescriptor texDesc;
+    {
+        texDesc.type        = LLGL::TextureType::Texture2D;
+        texDesc.bindFlags   = LLGL::BindFlags::ColorAttachment;
+        texDesc.miscFlags   = 0;
+        texDesc.format      = LLGL::Format::RGBA8UNorm;
+        texDesc.extent      = { g_targetSize, g_targetSize, 1 };
+    }
+    scene.targetTexture = renderer->CreateTexture(texDesc);
+
+    LLGL::RenderTargetDescriptor renderTargetDesc;
+    {
+        renderTargetDesc.resolution     = { g_targetSize, g_targetSize };
+        renderTargetDesc.attachments    = { LLGL::AttachmentDescriptor{ LLGL::AttachmentType::Color, scene.targetTexture } };
+    }
+    scene.renderTarget = renderer->CreateRenderTarget(renderTargetDesc);
+
+    // Create vertex buffer for a single triangle
+    LLGL::VertexFormat vertexFormat;
+    vertexFormat.AppendAttribute({ "position", LLGL::Format::RG32Float });
+
+    const float vertices[] = { -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f };
+
+    LLGL::BufferDescriptor vertexBufferDesc;
+    {
+        vertexBufferDesc.size           = sizeof(vertices);
+        vertexBufferDesc.bindFlags      = LLGL::BindFlags::VertexBuffer;
+        vertexBufferDesc.vertexAttribs  = vertexFormat.attributes;
+    }
+    scene.vertexBuffer = renderer->CreateBuffer(vertexBufferDesc, vertices);
+
+    // Create shader program with a uniform color
+    LLGL::ShaderDescriptor vertShaderDesc;
+    {
+        vertShaderDesc.type                 = LLGL::ShaderType::Vertex;
+        vertShaderDesc.source               = "#version 130\nin vec2 position;\nvoid main() { gl_Position = vec4(position, 0.0, 1.0); }\n";
+        vertShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+        vertShaderDesc.vertex.inputAttribs  = vertexFormat.attributes;
+    }
+    LLGL::ShaderDescriptor fragShaderDesc;
+    {
+        fragShaderDesc.type                 = LLGL::ShaderType::Fragment;
+        fragShaderDesc.source               = "#version 130\nuniform vec4 color;\nout vec4 fragColor;\nvoid main() { fragColor = color; }\n";
+        fragShaderDesc.sourceType           = LLGL::ShaderSourceType::CodeString;
+    }
+    LLGL::ShaderProgramDescriptor shaderProgramDesc;
+    {
+        shaderProgramDesc.vertexShader      = renderer->CreateShader(vertShaderDesc);
+        shaderProgramDesc.fragmentShader    = renderer->CreateShader(fragShaderDesc);
+    }
+    auto shaderProgram = renderer->CreateShaderProgram(shaderProgramDesc);
+
+    if (shaderProgram->HasErrors())
+        throw std::runtime_error(shaderProgram->GetReport());
+
+    scene.colorLocation = shaderProgram->FindUniformLocation("color");
+
+    // Create graphics pipeline
+    LLGL::GraphicsPipelineDescriptor pipelineDesc;
+    {
+        pipelineDesc.shaderProgram          = shaderProgram;
+        pipelineDesc.renderPass             = scene.renderTarget->GetRenderPass();
+        pipelineDesc.primitiveTopology      = LLGL::PrimitiveTopology::TriangleList;
+    }
+    scene.pipeline = renderer->CreatePipelineState(pipelineDesc);
+
+    return scene;
+}
+
+// Records the same commands for both execution modes; the redundant state changes are intended to exercise the command stream optimizer as well
+static void RecordTestCommands(LLGL::CommandBuffer& commands, const TestScene& scene)
+{
+    const float colorA[4] = { 1.0f, 0.0f, 0.0f, 1.0f };
+    const float colorB[4] = { 0.0f, 1.0f, 0.5f, 1.0f };
+    const float size = static_cast<float>(g_targetSize);
+
+    commands.Begin();
+    {
+        commands.BeginRenderPass(*scene.renderTarget);
+        {
+            commands.SetViewport(LLGL::Viewport{ 0.0f, 0.0f, size, size });
+            commands.Clear(LLGL::ClearFlags::Color, LLGL::ClearValue{ LLGL::ColorRGBAf{ 0.2f, 0.4f, 0.6f, 1.0f } });
+
+            commands.SetPipelineState(*scene.pipeline);
+            commands.SetVertexBuffer(*scene.vertexBuffer);
+
+            // Left half
+            commands.SetViewport(LLGL::Viewport{ 0.0f, 0.0f, size, size });
+            commands.SetViewport(LLGL::Viewport{ 0.0f, 0.0f, size*0.5f, size });
+            commands.SetUniform(scene.colorLocation, colorB, sizeof(colorB));
+            commands.SetUniform(scene.colorLocation, colorA, sizeof(colorA));
+            commands.Draw(3, 0);
+
+            // Right half
+            commands.SetPipelineState(*scene.pipeline);
+            commands.SetVertexBuffer(*scene.vertexBuffer);
+            commands.SetViewport(LLGL::Viewport{ size*0.5f, 0.0f, size*0.5f, size });
+            commands.SetUniform(scene.colorLocation, colorB, sizeof(colorB));
+            commands.Draw(3, 0);
+        }
+        commands.EndRenderPass();
+    }
+    commands.End();
+}
+
+static std::vector<std::uint8_t> RenderTestScene(const TestScene& scene, long commandBufferFlags, int numSubmissions)
+{
+    auto renderer = scene.renderer;
+    auto commandQueue = renderer->GetCommandQueue();
+
+    auto commands = renderer->CreateCommandBuffer(LLGL::CommandBufferDescriptor{ commandBufferFlags });
+    RecordTestCommands(*commands, scene);
+
+    for (int i = 0; i < numSubmissions; ++i)
+        commandQueue->Submit(*commands);
+
+    commandQueue->WaitIdle();
+
+    // Read back color attachment
+    std::vector<std::uint8_t> image(g_targetSize*g_targetSize*4, 0);
+
+    LLGL::DstImageDescriptor imageDesc{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, image.data(), image.size() };
+    renderer->ReadTexture(*scene.targetTexture, LLGL::TextureRegion{ LLGL::Offset3D{}, LLGL::Extent3D{ g_targetSize, g_targetSize, 1 } }, imageDesc);
+
+    renderer->Release(*commands);
+
+    return image;
+}
+
+// Renders the test scene with a JIT compiled command buffer (multi-submit) and an interpreted one and compares the results
+static void CompareJITWithInterpreter()
+{
+    auto renderer = LLGL::RenderSystem::Load("OpenGL");
+
+    LLGL::SwapChainDescriptor swapChainDesc;
+    swapChainDesc.resolution = { 320, 240 };
+    renderer->CreateSwapChain(swapChainDesc);
+
+    auto scene = CreateTestScene(renderer.get());
+
+    auto imageInterpreted   = RenderTestScene(scene, 0, 1);
+    auto imageJIT           = RenderTestScene(scene, LLGL::CommandBufferFlags::MultiSubmit, 2);
+
+    std::size_t numMismatches = 0;
+    for (std::size_t i = 0; i < imageJIT.size(); ++i)
+    {
+        if (imageJIT[i] != imageInterpreted[i])
+            ++numMismatches;
+    }
+
+    if (numMismatches > 0)
+        throw std::runtime_error("JIT compiled command buffer differs from interpreted command buffer in " + std::to_string(numMismatches) + " bytes");
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
 
 int main()
 {
     try
     {
+        #ifdef LLGL_DEBUG
         LLGL::TestJIT1();
+        #endif
+        CompareJITWithInterpreter();
     }
     catch (const std::exception& e)
     {
         std::cerr << e.what() << std::endl;
+        return 1;
     }
 
     return 0;
@@ -0,0 +1,147 @@
+/*
+ * Test_Readback.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+/*
+Runs without a GPU with the Null renderer or against Mesa's software rasterizer, e.g.:
+./Test_Readback Null
+LIBGL_ALWAYS_SOFTWARE=1 ./Test_Readback OpenGL
+*/
+
+static int g_numFailures = 0;
+
+static void Check(bool condition, const char* info)
+{
+    if (!condition)
+    {
+        std::cerr << "FAILED: " << info << std::endl;
+        ++g_numFailures;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load render system module
+        const char* rendererModule = (argc > 1 ? argv[1] : "OpenGL");
+        auto renderer = LLGL::RenderSystem::Load(rendererModule);
+
+        std::cout << "LLGL Renderer: " << renderer->GetName() << std::endl;
+
+        // Create swap-chain for the GL context
+        LLGL::SwapChainDescriptor swapChainDesc;
+        swapChainDesc.resolution = { 64, 64 };
+        renderer->CreateSwapChain(swapChainDesc);
+
+        auto cmdQueue = renderer->GetCommandQueue();
+        auto cmdBuffer = renderer->CreateCommandBuffer();
+
+        // Create source texture with a unique value for each texel
+        const std::uint32_t textureSize = 4;
+
+        std::uint32_t texels[textureSize * textureSize];
+        for (std::uint32_t i = 0; i < textureSize * textureSize; ++i)
+            texels[i] = 0xFF000000u | (i * 0x00010203u);
+
+        LLGL::TextureDescriptor texDesc;
+        {
+            texDesc.type        = LLGL::TextureType::Texture2D;
+            texDesc.bindFlags   = LLGL::BindFlags::Sampled | LLGL::BindFlags::CopySrc;
+            texDesc.format      = LLGL::Format::RGBA8UNorm;
+            texDesc.extent      = { textureSize, textureSize, 1 };
+            texDesc.mipLevels   = 1;
+        }
+        LLGL::SrcImageDescriptor srcImageDesc;
+        {
+            srcImageDesc.format     = LLGL::ImageFormat::RGBA;
+            srcImageDesc.dataType   = LLGL::DataType::UInt8;
+            srcImageDesc.data       = texels;
+            srcImageDesc.dataSize   = sizeof(texels);
+        }
+        auto texture = renderer->CreateTexture(texDesc, &srcImageDesc);
+
+        // Create readback buffer: only CPU read access and copy destination
+        LLGL::BufferDescriptor bufferDesc;
+        {
+            bufferDesc.size             = sizeof(texels);
+            bufferDesc.bindFlags        = LLGL::BindFlags::CopyDst;
+            bufferDesc.cpuAccessFlags   = LLGL::CPUAccessFlags::Read;
+        }
+        auto readbackBuffer = renderer->CreateBuffer(bufferDesc);
+
+        auto fence = renderer->CreateFence();
+
+        // Fence must not be signaled before it has been submitted
+        Check(!cmdQueue->QueryFence(*fence), "fence must not be signaled before submission");
+
+        // Record texture readback into command buffer and submit fence right after it
+        cmdBuffer->Begin();
+        {
+            LLGL::TextureRegion region;
+            {
+                region.subresource.numMipLevels = 1;
+                region.extent                   = texDesc.extent;
+            }
+            cmdBuffer->CopyBufferFromTexture(*readbackBuffer, 0, *texture, region);
+        }
+        cmdBuffer->End();
+
+        cmdQueue->Submit(*cmdBuffer);
+        cmdQueue->Submit(*fence);
+
+        // Poll fence without blocking, as an application would do once per frame
+        bool signaled = false;
+        for (int i = 0; i < 1000 && !signaled; ++i)
+        {
+            signaled = cmdQueue->QueryFence(*fence);
+            if (!signaled)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        Check(signaled, "fence must be signaled after readback has completed");
+
+        // Map readback buffer and compare with source texels
+        if (auto data = static_cast<const std::uint32_t*>(renderer->MapBuffer(*readbackBuffer, LLGL::CPUAccess::ReadOnly)))
+        {
+            bool equal = true;
+            for (std::uint32_t i = 0; i < textureSize * textureSize; ++i)
+                equal = equal && (data[i] == texels[i]);
+            Check(equal, "readback buffer must contain texture data");
+            renderer->UnmapBuffer(*readbackBuffer);
+        }
+        else
+            Check(false, "failed to map readback buffer");
+
+        renderer->Release(*fence);
+        renderer->Release(*readbackBuffer);
+        renderer->Release(*texture);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_numFailures > 0)
+    {
+        std::cerr << g_numFailures << " test(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All tests passed" << std::endl;
+
+    return 0;
+}
+
+
+
+// ================================================================================
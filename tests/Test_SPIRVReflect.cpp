@@ -0,0 +1,228 @@
+/*
+ * Test_SPIRVReflect.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Renderer/SPIRV/SPIRVReflect.h"
+#include <LLGL/ThreadPool.h>
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstring>
+
+
+using LLGL::SPIRVReflect;
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("SPIRVReflect test failed: " + info);
+}
+
+static std::vector<char> ReadModule(const std::string& filename)
+{
+    std::ifstream file{ filename, std::ios::in | std::ios::binary };
+    if (!file.good())
+        throw std::runtime_error("failed to read SPIR-V module: " + filename);
+
+    return std::vector<char>
+    {
+        (std::istreambuf_iterator<char>(file)),
+        (std::istreambuf_iterator<char>())
+    };
+}
+
+static bool IsName(const char* name, const char* expected)
+{
+    return (name != nullptr && std::strcmp(name, expected) == 0);
+}
+
+static const SPIRVReflect::SpvUniform& FindUniform(const SPIRVReflect& reflect, const char* name)
+{
+    for (const auto& uniform : reflect.GetUniforms())
+    {
+        if (IsName(uniform.name, name))
+            return uniform;
+    }
+    throw std::runtime_error("SPIRVReflect test failed: missing uniform '" + std::string(name) + "'");
+}
+
+static const SPIRVReflect::SpvRecord& FindRecord(const SPIRVReflect& reflect, const char* name)
+{
+    for (const auto& record : reflect.GetRecords())
+    {
+        if (IsName(record.name, name))
+            return record;
+    }
+    throw std::runtime_error("SPIRVReflect test failed: missing record '" + std::string(name) + "'");
+}
+
+static void CheckUniform(const SPIRVReflect& reflect, const char* name, std::uint32_t set, std::uint32_t binding)
+{
+    const auto& uniform = FindUniform(reflect, name);
+    Check(uniform.set == set, "descriptor set of uniform '" + std::string(name) + "'");
+    Check(uniform.binding == binding, "binding of uniform '" + std::string(name) + "'");
+    Check(uniform.type != nullptr, "type of uniform '" + std::string(name) + "'");
+}
+
+static void CheckRecord(const SPIRVReflect& reflect, const char* name, std::uint32_t size)
+{
+    const auto& record = FindRecord(reflect, name);
+    Check(record.size == size, "size of record '" + std::string(name) + "' is " + std::to_string(record.size));
+    Check(record.padding == 0, "padding of record '" + std::string(name) + "'");
+}
+
+// Checks the reflection of "Shaders/SpirvReflectTest.comp" against its GLSL source
+static void CheckComputeShaderReflection(const SPIRVReflect& reflect)
+{
+    // Uniform buffer, storage buffer, separate texture and sampler, storage image, and array of combined texture-samplers
+    CheckUniform(reflect, "constBuffer",            0, 1);
+    CheckUniform(reflect, "outBuffer",              0, 2);
+    CheckUniform(reflect, "colorMap",               0, 3);
+    CheckUniform(reflect, "colorMapOut",            0, 4);
+    CheckUniform(reflect, "linearSampler",          0, 5);
+    CheckUniform(reflect, "combinedTexSamplers",    0, 6);
+
+    std::size_t numUniforms = 0;
+    for (const auto& uniform : reflect.GetUniforms())
+    {
+        (void)uniform;
+        ++numUniforms;
+    }
+    Check(numUniforms == 6, "expected 6 uniforms but got " + std::to_string(numUniforms));
+
+    const auto& constBuffer = FindUniform(reflect, "constBuffer");
+    Check(constBuffer.size == 16, "size of uniform buffer 'constBuffer'");
+
+    auto constBufferType = constBuffer.type->DereferencePtr(spv::Op::OpTypeStruct);
+    Check(constBufferType != nullptr && constBufferType->numFields == 2, "fields of uniform buffer 'constBuffer'");
+    for (std::uint32_t i = 0; i < constBufferType->numFields; ++i)
+    {
+        auto fieldType = constBufferType->fieldTypes[i];
+        Check(fieldType->opcode == spv::Op::OpTypeVector && fieldType->elements == 2, "type of field " + std::to_string(i) + " in 'constBuffer'");
+    }
+
+    auto samplerArray = FindUniform(reflect, "combinedTexSamplers").type->DereferencePtr(spv::Op::OpTypeArray);
+    Check(samplerArray != nullptr && samplerArray->elements == 2, "array size of 'combinedTexSamplers'");
+
+    // Records of the uniform buffer, the storage buffer with a runtime array, and the push constants
+    CheckRecord(reflect, "constBuffer",     16);
+    CheckRecord(reflect, "outBuffer",       0);
+    CheckRecord(reflect, "pushConstants",   16);
+
+    // Fields of the push constant block, but not of other records
+    std::uint32_t pushConstantOffset = ~0u, pushConstantSize = 0;
+    Check(reflect.FindPushConstantField("diffuseColor", pushConstantOffset, pushConstantSize), "missing push constant 'diffuseColor'");
+    Check(pushConstantOffset == 0 && pushConstantSize == 16, "offset and size of push constant 'diffuseColor'");
+    Check(!reflect.FindPushConstantField("blendFactors", pushConstantOffset, pushConstantSize), "field of uniform buffer found as push constant");
+
+    // Built-in input varyings of the compute shader
+    std::size_t numInputs = 0;
+    bool hasGlobalInvocationID = false;
+    bool hasLocalInvocationIndex = false;
+
+    for (const auto& varying : reflect.GetVaryings())
+    {
+        if (!varying.input)
+            continue;
+
+        ++numInputs;
+        if (varying.builtin == spv::BuiltIn::GlobalInvocationId)
+        {
+            Check(IsName(varying.name, "gl_GlobalInvocationID"), "name of varying 'gl_GlobalInvocationID'");
+            auto vectorType = varying.type->DereferencePtr(spv::Op::OpTypeVector);
+            Check(vectorType != nullptr && vectorType->elements == 3, "type of varying 'gl_GlobalInvocationID'");
+            hasGlobalInvocationID = true;
+        }
+        else if (varying.builtin == spv::BuiltIn::LocalInvocationIndex)
+        {
+            Check(IsName(varying.name, "gl_LocalInvocationIndex"), "name of varying 'gl_LocalInvocationIndex'");
+            Check(varying.type->RefersToType(spv::Op::OpTypeInt), "type of varying 'gl_LocalInvocationIndex'");
+            hasLocalInvocationIndex = true;
+        }
+    }
+
+    Check(numInputs == 2, "expected 2 input varyings but got " + std::to_string(numInputs));
+    Check(hasGlobalInvocationID, "missing varying 'gl_GlobalInvocationID'");
+    Check(hasLocalInvocationIndex, "missing varying 'gl_LocalInvocationIndex'");
+}
+
+static void TestParse(const std::vector<char>& byteCode)
+{
+    SPIRVReflect reflect;
+    reflect.Parse(byteCode.data(), byteCode.size());
+    CheckComputeShaderReflection(reflect);
+
+    // Parse again into the same reflection to check that the reused tables are reset
+    reflect.Parse(byteCode.data(), byteCode.size());
+    CheckComputeShaderReflection(reflect);
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+static void TestParseModules(const std::vector<char>& byteCode, LLGL::ThreadPool* threadPool)
+{
+    const std::size_t numModules = 16;
+
+    std::vector<LLGL::SPIRVModuleView> modules(numModules, LLGL::SPIRVModuleView{ byteCode.data(), byteCode.size() });
+    std::vector<SPIRVReflect> reflections(numModules);
+
+    SPIRVReflect::ParseModules(numModules, modules.data(), reflections.data(), threadPool);
+
+    for (const auto& reflect : reflections)
+        CheckComputeShaderReflection(reflect);
+
+    // An invalid module must not prevent the other modules from being parsed, and its error must be re-thrown afterwards
+    modules[numModules/2].byteCodeSize = 4;
+
+    std::vector<SPIRVReflect> partialReflections(numModules);
+    bool exceptionThrown = false;
+
+    try
+    {
+        SPIRVReflect::ParseModules(numModules, modules.data(), partialReflections.data(), threadPool);
+    }
+    catch (const std::invalid_argument&)
+    {
+        exceptionThrown = true;
+    }
+
+    Check(exceptionThrown, "invalid module in ParseModules did not throw");
+
+    for (std::size_t i = 0; i < numModules; ++i)
+    {
+        if (i != numModules/2)
+            CheckComputeShaderReflection(partialReflections[i]);
+    }
+
+    std::cout << __FUNCTION__ << "(" << (threadPool != nullptr ? "thread pool" : "calling thread") << "): passed" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        const std::string filename = (argc > 1 ? argv[1] : "Shaders/SpirvReflectTest.comp.spv");
+        const auto byteCode = ReadModule(filename);
+
+        TestParse(byteCode);
+
+        TestParseModules(byteCode, nullptr);
+
+        // Use a fixed number of worker threads, so the modules are distributed even on single-core machines
+        auto threadPool = LLGL::ThreadPool::Create(4);
+        TestParseModules(byteCode, threadPool.get());
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
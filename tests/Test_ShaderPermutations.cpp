@@ -0,0 +1,160 @@
+/*
+ * Test_ShaderPermutations.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include <iostream>
+#include <set>
+
+/*
+Runs against Mesa's software rasterizer without a GPU, e.g.:
+LIBGL_ALWAYS_SOFTWARE=1 ./Test_ShaderPermutations OpenGL
+*/
+
+static const char* g_fragmentShaderSource =
+    "#version 330 core\n"
+    "\n"
+    "out vec4 fragColor;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    #if ENABLE_FOG\n"
+    "    fragColor = vec4(FOG_COLOR, 1.0);\n"
+    "    #elif ENABLE_LIGHTING\n"
+    "    fragColor = vec4(vec3(LIGHT_INTENSITY), 1.0);\n"
+    "    #else\n"
+    "    fragColor = vec4(1.0);\n"
+    "    #endif\n"
+    "}\n"
+;
+
+static int g_numFailures = 0;
+
+static void Check(bool condition, const char* info)
+{
+    if (!condition)
+    {
+        std::cerr << "FAILED: " << info << std::endl;
+        ++g_numFailures;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // Load render system module
+        const char* rendererModule = (argc > 1 ? argv[1] : "OpenGL");
+        auto renderer = LLGL::RenderSystem::Load(rendererModule);
+
+        std::cout << "LLGL Renderer: " << renderer->GetName() << std::endl;
+
+        // Create swap-chain for the GL context
+        LLGL::SwapChainDescriptor swapChainDesc;
+        swapChainDesc.resolution = { 64, 64 };
+        renderer->CreateSwapChain(swapChainDesc);
+
+        // Define macro permutations
+        const LLGL::ShaderMacro baseMacros[] =
+        {
+            { "FOG_COLOR", "vec3(0.5)" },
+            { nullptr }
+        };
+
+        const LLGL::ShaderMacro permutationFog[] =
+        {
+            { "ENABLE_FOG", "1" },
+            { nullptr }
+        };
+
+        const LLGL::ShaderMacro permutationFogUnused[] =
+        {
+            { "UNUSED_MACRO", "1" },    // Not referenced by the shader source
+            { "ENABLE_FOG", "1" },
+            { nullptr }
+        };
+
+        const LLGL::ShaderMacro permutationLighting[] =
+        {
+            { "ENABLE_LIGHTING", "1" },
+            { "LIGHT_INTENSITY", "0.25" },
+            { nullptr }
+        };
+
+        const LLGL::ShaderMacro permutationLightingRedefined[] =
+        {
+            { "LIGHT_INTENSITY", "0.75" },
+            { "ENABLE_LIGHTING", "1" },
+            { "LIGHT_INTENSITY", "0.25" },  // Last definition wins
+            { nullptr }
+        };
+
+        LLGL::ShaderPermutationDescriptor permutationDesc;
+        {
+            permutationDesc.shaderDesc.type         = LLGL::ShaderType::Fragment;
+            permutationDesc.shaderDesc.source       = g_fragmentShaderSource;
+            permutationDesc.shaderDesc.sourceType   = LLGL::ShaderSourceType::CodeString;
+            permutationDesc.shaderDesc.defines      = baseMacros;
+            permutationDesc.permutations            =
+            {
+                permutationFog,
+                nullptr,
+                permutationLighting,
+                permutationFogUnused,
+                permutationLightingRedefined,
+                nullptr,
+            };
+            permutationDesc.threadCount             = LLGL::Constants::maxThreadCount;
+        }
+
+        // Create shader permutations
+        auto shaders = renderer->CreateShaderPermutations(permutationDesc);
+
+        Check(shaders.size() == permutationDesc.permutations.size(), "number of shaders must match number of permutations");
+        Check(shaders[0] == shaders[3], "permutations that only differ in unreferenced macros must share the same shader");
+        Check(shaders[2] == shaders[4], "permutations that only differ in redefined macros must share the same shader");
+        Check(shaders[1] == shaders[5], "equal permutations must share the same shader");
+        Check(shaders[0] != shaders[1] && shaders[0] != shaders[2] && shaders[1] != shaders[2], "different permutations must have different shaders");
+
+        // Check compilation of all unique shaders
+        std::set<LLGL::Shader*> uniqueShaders(shaders.begin(), shaders.end());
+        Check(uniqueShaders.size() == 3, "expected 3 unique shaders");
+
+        for (auto shader : uniqueShaders)
+        {
+            if (shader->HasErrors())
+            {
+                std::cerr << shader->GetReport() << std::endl;
+                Check(false, "shader permutation failed to compile");
+            }
+        }
+
+        std::cout << shaders.size() << " permutations -> " << uniqueShaders.size() << " unique shaders" << std::endl;
+
+        // Release each unique shader once
+        for (auto shader : uniqueShaders)
+            renderer->Release(*shader);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    if (g_numFailures > 0)
+    {
+        std::cerr << g_numFailures << " test(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "All tests passed" << std::endl;
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,234 @@
+/*
+ * Test_TLSFAllocator.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Core/TLSFAllocator.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+
+using LLGL::TLSFAllocator;
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("TLSFAllocator test failed: " + info);
+}
+
+// Walks all blocks in address order and checks that they cover the entire range, that no two free ranges are adjacent, and that the statistics match
+static void ValidateAllocator(const TLSFAllocator& alloc)
+{
+    std::uint64_t   offset          = 0;
+    std::uint64_t   allocatedSize   = 0;
+    std::uint64_t   maxFreeSize     = 0;
+    std::uint64_t   tailFreeSize    = 0;
+    std::size_t     numAllocated    = 0;
+    std::size_t     numFree         = 0;
+    bool            prevFree        = false;
+
+    for (auto block = alloc.GetFirstBlock(); block != TLSFAllocator::invalidBlock; block = alloc.GetNextBlock(block))
+    {
+        Check(alloc.GetOffset(block) == offset, "gap or overlap at offset " + std::to_string(offset));
+        Check(alloc.GetSize(block) > 0, "empty block at offset " + std::to_string(offset));
+
+        if (alloc.IsFree(block))
+        {
+            Check(!prevFree, "adjacent free ranges at offset " + std::to_string(offset));
+            maxFreeSize = std::max(maxFreeSize, alloc.GetSize(block));
+            tailFreeSize = alloc.GetSize(block);
+            ++numFree;
+        }
+        else
+        {
+            allocatedSize += alloc.GetSize(block);
+            tailFreeSize = 0;
+            ++numAllocated;
+        }
+
+        prevFree = alloc.IsFree(block);
+        offset += alloc.GetSize(block);
+    }
+
+    Check(offset == alloc.GetTotalSize(), "blocks do not cover the entire range");
+    Check(numAllocated == alloc.GetNumAllocatedBlocks(), "number of allocated blocks mismatch");
+    Check(numFree == alloc.GetNumFreeRanges(), "number of free ranges mismatch");
+    Check(allocatedSize == alloc.GetAllocatedSize(), "allocated size mismatch");
+    Check(maxFreeSize == alloc.GetMaxFreeRangeSize(), "maximal free range size mismatch");
+    Check(tailFreeSize == alloc.GetTailFreeRangeSize(), "tail free range size mismatch");
+}
+
+static void TestBasics()
+{
+    TLSFAllocator alloc(1024);
+    ValidateAllocator(alloc);
+
+    /* Allocate three consecutive blocks */
+    auto a = alloc.Allocate(100);
+    auto b = alloc.Allocate(200, 256);
+    auto c = alloc.Allocate(50);
+    Check(a != TLSFAllocator::invalidBlock && b != TLSFAllocator::invalidBlock && c != TLSFAllocator::invalidBlock, "basic allocation");
+    Check(alloc.GetOffset(b) % 256 == 0, "alignment of second block");
+    ValidateAllocator(alloc);
+
+    /* Too large requests must fail */
+    Check(alloc.Allocate(1024) == TLSFAllocator::invalidBlock, "oversized allocation");
+    Check(alloc.Allocate(0) == TLSFAllocator::invalidBlock, "empty allocation");
+    Check(alloc.Allocate(16, 3) == TLSFAllocator::invalidBlock, "non-power-of-two alignment");
+
+    /* Release all blocks in different order; all ranges must be merged into a single one */
+    alloc.Release(b);
+    ValidateAllocator(alloc);
+    alloc.Release(a);
+    ValidateAllocator(alloc);
+    alloc.Release(c);
+    ValidateAllocator(alloc);
+
+    Check(alloc.GetNumFreeRanges() == 1 && alloc.GetMaxFreeRangeSize() == 1024, "merging of free ranges");
+
+    /* Entire range must be available again */
+    auto d = alloc.Allocate(1024);
+    Check(d != TLSFAllocator::invalidBlock && alloc.GetOffset(d) == 0, "allocation of entire range");
+    Check(alloc.GetMaxFreeRangeSize() == 0 && alloc.GetTailFreeRangeSize() == 0, "exhausted range");
+    alloc.Release(d);
+    ValidateAllocator(alloc);
+}
+
+static void TestBestFit()
+{
+    TLSFAllocator alloc(4096);
+
+    /* Create holes of 96 and 64 bytes: [A:64][hole:96][B:64][hole:64][C:64][.....] */
+    auto a      = alloc.Allocate(64);
+    auto hole0  = alloc.Allocate(96);
+    auto b      = alloc.Allocate(64);
+    auto hole1  = alloc.Allocate(64);
+    auto c      = alloc.Allocate(64);
+    alloc.Release(hole0);
+    alloc.Release(hole1);
+    ValidateAllocator(alloc);
+
+    /* Best fit must pick the smaller hole */
+    auto d = alloc.Allocate(64, 1, true);
+    Check(alloc.GetOffset(d) == 64 + 96 + 64, "best fit allocation");
+    ValidateAllocator(alloc);
+
+    alloc.Release(a);
+    alloc.Release(b);
+    alloc.Release(c);
+    alloc.Release(d);
+    ValidateAllocator(alloc);
+    Check(alloc.GetNumFreeRanges() == 1, "merging after best fit allocation");
+}
+
+static void TestRandom(std::uint64_t size, std::size_t numIterations, std::uint32_t seed)
+{
+    TLSFAllocator alloc(size);
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<std::uint64_t> sizeDist(1, size / 64);
+    std::uniform_int_distribution<std::uint32_t> alignDist(0, 12);
+
+    std::vector<std::uint32_t> blocks;
+
+    for (std::size_t i = 0; i < numIterations; ++i)
+    {
+        if (blocks.empty() || rng() % 3 != 0)
+        {
+            const auto blockSize    = sizeDist(rng);
+            const auto alignment    = (1ull << alignDist(rng));
+            const auto block        = alloc.Allocate(blockSize, alignment, (rng() % 2 == 0));
+
+            if (block != TLSFAllocator::invalidBlock)
+            {
+                Check(alloc.GetSize(block) == blockSize, "size of random allocation");
+                Check(alloc.GetOffset(block) % alignment == 0, "alignment of random allocation");
+                blocks.push_back(block);
+            }
+            else
+            {
+                /* Allocation may only fail if there is no range that could hold the worst case padding */
+                Check(alloc.GetMaxFreeRangeSize() < blockSize + alignment - 1, "random allocation failed although a large enough range is available");
+            }
+        }
+        else
+        {
+            const auto index = rng() % blocks.size();
+            alloc.Release(blocks[index]);
+            blocks[index] = blocks.back();
+            blocks.pop_back();
+        }
+
+        if (i % 64 == 0)
+            ValidateAllocator(alloc);
+    }
+
+    for (auto block : blocks)
+        alloc.Release(block);
+
+    ValidateAllocator(alloc);
+    Check(alloc.GetNumFreeRanges() == 1 && alloc.GetNumAllocatedBlocks() == 0, "release of all random allocations");
+}
+
+// Measures allocation and release time with a growing number of live blocks; the time per operation should stay flat
+static void MeasurePerformance()
+{
+    for (std::size_t numBlocks : { 1000u, 10000u, 100000u })
+    {
+        TLSFAllocator alloc(numBlocks * 1024);
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<std::uint64_t> sizeDist(1, 1024);
+
+        std::vector<std::uint32_t> blocks;
+        blocks.reserve(numBlocks);
+
+        const auto startTime = std::chrono::high_resolution_clock::now();
+
+        for (std::size_t i = 0; i < numBlocks; ++i)
+            blocks.push_back(alloc.Allocate(sizeDist(rng), 256));
+
+        /* Release every other block to fragment the range, then refill the holes */
+        for (std::size_t i = 0; i < numBlocks; i += 2)
+            alloc.Release(blocks[i]);
+        for (std::size_t i = 0; i < numBlocks; i += 2)
+            blocks[i] = alloc.Allocate(sizeDist(rng), 256);
+
+        for (auto block : blocks)
+            alloc.Release(block);
+
+        const auto endTime = std::chrono::high_resolution_clock::now();
+        const auto duration = std::chrono::duration<double, std::nano>(endTime - startTime).count();
+        const auto numOps = static_cast<double>(numBlocks * 3);
+
+        std::cout << "  " << numBlocks << " blocks: " << (duration / numOps) << " ns per operation" << std::endl;
+    }
+}
+
+int main()
+{
+    try
+    {
+        TestBasics();
+        TestBestFit();
+        TestRandom(1024*1024, 20000, 1);
+        TestRandom(64*1024*1024, 20000, 2);
+        TestRandom(4096, 20000, 3);
+        std::cout << "TLSFAllocator: passed" << std::endl;
+        MeasurePerformance();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,211 @@
+/*
+ * Test_ThreadPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/ThreadPool.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+
+
+using LLGL::ThreadPool;
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("ThreadPool test failed: " + info);
+}
+
+// Checks that each element has been visited exactly once
+static void CheckVisits(const std::vector<std::atomic<unsigned>>& visits, const std::string& info)
+{
+    for (std::size_t i = 0; i < visits.size(); ++i)
+    {
+        const auto n = visits[i].load();
+        Check(n == 1, info + ": element " + std::to_string(i) + " visited " + std::to_string(n) + " times");
+    }
+}
+
+// Processes ranges of various sizes with various chunk sizes, including ranges that are not a multiple of the chunk size
+static void TestCoverage(ThreadPool& pool)
+{
+    const std::size_t counts[]      = { 0, 1, 2, 7, 64, 1000, 1023 };
+    const std::size_t chunkSizes[]  = { 0, 1, 3, 16, 1000, 2000 };
+
+    for (auto count : counts)
+    {
+        for (auto chunkSize : chunkSizes)
+        {
+            const std::string info = "count=" + std::to_string(count) + ", chunkSize=" + std::to_string(chunkSize);
+
+            std::vector<std::atomic<unsigned>> visits(count);
+            std::atomic<bool> invalidRange{ false };
+
+            pool.ParallelFor(
+                count,
+                chunkSize,
+                [&](std::size_t begin, std::size_t end)
+                {
+                    if (begin >= end || end > count || (chunkSize > 0 && end - begin > chunkSize))
+                        invalidRange = true;
+                    for (auto i = begin; i < end && i < count; ++i)
+                        ++visits[i];
+                }
+            );
+
+            Check(!invalidRange, info + ": invalid range passed to task");
+            CheckVisits(visits, info);
+        }
+    }
+}
+
+// Calls ParallelFor recursively from within the tasks of another ParallelFor
+static void TestNestedSubmissions(ThreadPool& pool)
+{
+    const std::size_t numOuter = 8;
+    const std::size_t numInner = 100;
+
+    std::vector<std::atomic<unsigned>> visits(numOuter * numInner);
+
+    pool.ParallelFor(
+        numOuter,
+        1,
+        [&](std::size_t begin, std::size_t end)
+        {
+            for (auto i = begin; i < end; ++i)
+            {
+                pool.ParallelFor(
+                    numInner,
+                    7,
+                    [&visits, i, numInner](std::size_t innerBegin, std::size_t innerEnd)
+                    {
+                        for (auto j = innerBegin; j < innerEnd; ++j)
+                            ++visits[i * numInner + j];
+                    }
+                );
+            }
+        }
+    );
+
+    CheckVisits(visits, "nested ParallelFor");
+}
+
+// Calls ParallelFor from several external threads at the same time
+static void TestConcurrentSubmissions(ThreadPool& pool)
+{
+    const std::size_t numThreads    = 4;
+    const std::size_t numRepeats    = 50;
+    const std::size_t count         = 500;
+
+    std::vector<std::vector<std::atomic<unsigned>>> visits(numThreads);
+    for (auto& threadVisits : visits)
+        threadVisits = std::vector<std::atomic<unsigned>>(count * numRepeats);
+
+    std::vector<std::thread> threads;
+    std::atomic<bool> failed{ false };
+
+    for (std::size_t t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back(
+            [&pool, &visits, &failed, t]()
+            {
+                try
+                {
+                    for (std::size_t r = 0; r < numRepeats; ++r)
+                    {
+                        pool.ParallelFor(
+                            count,
+                            13,
+                            [&visits, t, r](std::size_t begin, std::size_t end)
+                            {
+                                for (auto i = begin; i < end; ++i)
+                                    ++visits[t][r * count + i];
+                            }
+                        );
+                    }
+                }
+                catch (...)
+                {
+                    failed = true;
+                }
+            }
+        );
+    }
+
+    for (auto& thread : threads)
+        thread.join();
+
+    Check(!failed, "concurrent ParallelFor threw an exception");
+
+    for (std::size_t t = 0; t < numThreads; ++t)
+        CheckVisits(visits[t], "concurrent ParallelFor on thread " + std::to_string(t));
+}
+
+// Throws an exception in one chunk and checks that all other chunks are processed before it is re-thrown
+static void TestExceptions(ThreadPool& pool)
+{
+    const std::size_t count = 256;
+
+    std::vector<std::atomic<unsigned>> visits(count);
+    bool exceptionThrown = false;
+
+    try
+    {
+        pool.ParallelFor(
+            count,
+            1,
+            [&visits](std::size_t begin, std::size_t end)
+            {
+                for (auto i = begin; i < end; ++i)
+                {
+                    ++visits[i];
+                    if (i == count/2)
+                        throw std::out_of_range("expected exception");
+                }
+            }
+        );
+    }
+    catch (const std::out_of_range&)
+    {
+        exceptionThrown = true;
+    }
+
+    Check(exceptionThrown, "exception was not re-thrown by ParallelFor");
+    CheckVisits(visits, "ParallelFor with exception");
+}
+
+static void TestThreadPool(std::size_t threadCount)
+{
+    auto pool = ThreadPool::Create(threadCount);
+
+    TestCoverage(*pool);
+    TestNestedSubmissions(*pool);
+    TestConcurrentSubmissions(*pool);
+    TestExceptions(*pool);
+
+    std::cout << __FUNCTION__ << "(" << pool->GetThreadCount() << " worker threads): passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        TestThreadPool(0);
+        TestThreadPool(1);
+        TestThreadPool(4);
+        TestThreadPool(LLGL::Constants::maxThreadCount);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,278 @@
+/*
+ * Test_VirtualCommandBufferPool.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "../sources/Renderer/VirtualCommandBufferPool.h"
+#include <LLGL/CommandBufferFlags.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <set>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <random>
+#include <cstdint>
+#include <cstring>
+
+
+static void Check(bool condition, const std::string& info)
+{
+    if (!condition)
+        throw std::runtime_error("VirtualCommandBufferPool test failed: " + info);
+}
+
+// Memory block that is currently handed out by the pool, filled with a pattern that is unique to its allocation.
+struct Allocation
+{
+    std::uint8_t*   ptr;
+    std::size_t     size;
+    std::uint8_t    pattern;
+};
+
+/*
+Registry of all blocks that are currently handed out by the pool. A block must never be handed out again before it has been released,
+and the memory ranges of two blocks must never overlap.
+*/
+class AllocationRegistry
+{
+
+    public:
+
+        void Insert(const Allocation& alloc)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+
+            /* Check for overlap with the next and previous block that is currently in use */
+            auto next = ranges_.lower_bound({ alloc.ptr, 0 });
+            if (next != ranges_.end())
+            {
+                if (next->first == alloc.ptr)
+                    failed_ = "block was handed out twice";
+                else if (next->first < alloc.ptr + alloc.size)
+                    failed_ = "block overlaps with the next block in use";
+            }
+            if (next != ranges_.begin())
+            {
+                auto prev = std::prev(next);
+                if (prev->first + prev->second > alloc.ptr)
+                    failed_ = "block overlaps with the previous block in use";
+            }
+
+            ranges_.insert({ alloc.ptr, alloc.size });
+        }
+
+        void Erase(const Allocation& alloc)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            if (ranges_.erase({ alloc.ptr, alloc.size }) != 1)
+                failed_ = "block was released without being in use";
+        }
+
+        std::string GetFailure()
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            return failed_;
+        }
+
+    private:
+
+        std::mutex                                      mutex_;
+        std::set<std::pair<std::uint8_t*, std::size_t>> ranges_;
+        std::string                                     failed_;
+
+};
+
+// Queue of blocks that are released by another thread than the one that allocated them.
+class ExchangeQueue
+{
+
+    public:
+
+        void Push(const Allocation& alloc)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            allocs_.push_back(alloc);
+        }
+
+        bool Pop(Allocation& alloc)
+        {
+            std::lock_guard<std::mutex> guard{ mutex_ };
+            if (allocs_.empty())
+                return false;
+            alloc = allocs_.back();
+            allocs_.pop_back();
+            return true;
+        }
+
+    private:
+
+        std::mutex              mutex_;
+        std::vector<Allocation> allocs_;
+
+};
+
+static std::size_t GenerateChunkSize(std::mt19937& rng)
+{
+    /* Mostly small chunks of various size classes, and a few oversized chunks that bypass the pool */
+    const auto n = rng() % 100;
+    if (n < 60)
+        return 16 + rng() % 1024;
+    if (n < 95)
+        return 1024 + rng() % (64u << 10);
+    if (n < 99)
+        return (64u << 10) + rng() % (1u << 20);
+    return (1u << 20) + 1 + rng() % (1u << 20);
+}
+
+static Allocation Acquire(AllocationRegistry& registry, std::mt19937& rng)
+{
+    const auto size = GenerateChunkSize(rng);
+
+    std::size_t allocatedSize = 0;
+    auto ptr = static_cast<std::uint8_t*>(LLGL::AllocVirtualCommandBufferChunk(size, allocatedSize));
+
+    if (ptr == nullptr || allocatedSize < size)
+        throw std::runtime_error("invalid chunk allocation of " + std::to_string(size) + " bytes");
+
+    Allocation alloc{ ptr, allocatedSize, static_cast<std::uint8_t>(rng()) };
+    registry.Insert(alloc);
+
+    /* Write pattern into the entire block, so that concurrent use of the same memory is detected on release */
+    std::memset(ptr, alloc.pattern, alloc.size);
+
+    return alloc;
+}
+
+static void Release(AllocationRegistry& registry, const Allocation& alloc)
+{
+    for (std::size_t i = 0; i < alloc.size; ++i)
+    {
+        if (alloc.ptr[i] != alloc.pattern)
+            throw std::runtime_error("block was modified while in use");
+    }
+
+    registry.Erase(alloc);
+    LLGL::FreeVirtualCommandBufferChunk(alloc.ptr, alloc.size);
+}
+
+// Allocates and releases chunks in random order, and releases chunks that have been allocated by other threads.
+static void StressThread(AllocationRegistry& registry, ExchangeQueue& exchange, unsigned seed, std::size_t numIterations)
+{
+    const std::size_t maxAllocsInUse = 64;
+
+    std::mt19937 rng{ seed };
+    std::vector<Allocation> allocs;
+
+    for (std::size_t i = 0; i < numIterations; ++i)
+    {
+        const auto n = rng() % 8;
+        if ((n < 4 && allocs.size() < maxAllocsInUse) || allocs.empty())
+        {
+            allocs.push_back(Acquire(registry, rng));
+        }
+        else if (n < 7)
+        {
+            const auto idx = rng() % allocs.size();
+            Release(registry, allocs[idx]);
+            allocs[idx] = allocs.back();
+            allocs.pop_back();
+        }
+        else
+        {
+            /* Pass one chunk to another thread and release one chunk of another thread */
+            exchange.Push(allocs.back());
+            allocs.pop_back();
+
+            Allocation alloc;
+            if (exchange.Pop(alloc))
+                Release(registry, alloc);
+        }
+    }
+
+    for (const auto& alloc : allocs)
+        Release(registry, alloc);
+}
+
+static void TestConcurrentAcquireRelease()
+{
+    const std::size_t numThreads    = 8;
+    const std::size_t numRounds     = 4;
+    const std::size_t numIterations = 2000;
+
+    const auto usedMemoryBefore = LLGL::GetCommandBufferMemoryStatistics().usedMemory;
+
+    AllocationRegistry  registry;
+    ExchangeQueue       exchange;
+
+    /* Start new threads in each round, so that the thread caches are flushed into the global pool when the threads exit */
+    for (std::size_t round = 0; round < numRounds; ++round)
+    {
+        std::vector<std::thread> threads;
+        std::string failure;
+        std::mutex failureMutex;
+
+        for (std::size_t t = 0; t < numThreads; ++t)
+        {
+            threads.emplace_back(
+                [&, t]()
+                {
+                    try
+                    {
+                        StressThread(registry, exchange, static_cast<unsigned>(round * numThreads + t + 1), numIterations);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::lock_guard<std::mutex> guard{ failureMutex };
+                        failure = e.what();
+                    }
+                }
+            );
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        Check(failure.empty(), "round " + std::to_string(round) + ": " + failure);
+        Check(registry.GetFailure().empty(), "round " + std::to_string(round) + ": " + registry.GetFailure());
+
+        /* Release the chunks that have been passed to other threads but were not released by them */
+        Allocation alloc;
+        while (exchange.Pop(alloc))
+            Release(registry, alloc);
+    }
+
+    Check(registry.GetFailure().empty(), registry.GetFailure());
+
+    const auto usedMemoryAfter = LLGL::GetCommandBufferMemoryStatistics().usedMemory;
+    Check(usedMemoryAfter == usedMemoryBefore, "used memory is " + std::to_string(usedMemoryAfter) + " bytes after all chunks have been released");
+
+    /* All blocks must be returned to the heap when the pool is trimmed */
+    LLGL::TrimCommandBufferMemoryPool();
+
+    const auto stats = LLGL::GetCommandBufferMemoryStatistics();
+    Check(stats.numHeapAllocations == stats.numHeapDeallocations, "heap allocations and deallocations do not match after trimming the pool");
+    Check(stats.reservedMemory == 0, "reserved memory is " + std::to_string(stats.reservedMemory) + " bytes after trimming the pool");
+    Check(stats.numPoolAllocations > 0, "no chunks have been recycled");
+
+    std::cout << __FUNCTION__ << ": passed" << std::endl;
+}
+
+int main()
+{
+    try
+    {
+        TestConcurrentAcquireRelease();
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,292 @@
+/*
+ * BenchmarkCommands.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BenchmarkSuites.h"
+#include <LLGL/LLGL.h>
+#include "../../sources/Renderer/VirtualCommandBuffer.h"
+#include "../../sources/Renderer/VirtualCommandBufferPool.h"
+#ifdef LLGL_ENABLE_JIT_COMPILER
+#   include "../../sources/JIT/JITCompiler.h"
+#   include "../../sources/JIT/JITProgram.h"
+#endif
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace LLGLBenchmark
+{
+
+
+/*
+ * VirtualCommandBuffer
+ */
+
+enum BenchmarkOpcode : std::uint8_t
+{
+    BenchmarkOpcodeSmall = 1,
+    BenchmarkOpcodeLarge,
+};
+
+struct BenchmarkCmdSmall
+{
+    std::uint32_t values[4];
+};
+
+struct BenchmarkCmdLarge
+{
+    std::uint32_t values[32];
+};
+
+using BenchmarkCommandBuffer = LLGL::VirtualCommandBuffer<BenchmarkOpcode>;
+
+// Number of commands that are recorded into each virtual command buffer.
+static const std::size_t g_numCommands = 1024;
+
+// Records a mix of small and large commands, similar to a frame with state changes and draw calls.
+static void RecordBenchmarkCommands(BenchmarkCommandBuffer& buffer)
+{
+    for (std::size_t i = 0; i < g_numCommands; ++i)
+    {
+        if (i % 4 == 3)
+        {
+            auto cmd = buffer.AllocCommand<BenchmarkCmdLarge>(BenchmarkOpcodeLarge, 64);
+            cmd->values[0] = static_cast<std::uint32_t>(i);
+        }
+        else
+        {
+            auto cmd = buffer.AllocCommand<BenchmarkCmdSmall>(BenchmarkOpcodeSmall);
+            cmd->values[0] = static_cast<std::uint32_t>(i);
+        }
+    }
+}
+
+static void RunVirtualCommandBufferBenchmarks(BenchmarkHarness& harness)
+{
+    /* Allocate a new buffer for each recording, so every chunk goes through the chunk pool */
+    harness.Run(
+        "VirtualCommandBuffer.Record",
+        []()
+        {
+            BenchmarkCommandBuffer buffer;
+            RecordBenchmarkCommands(buffer);
+            DoNotOptimize(&buffer);
+        }
+    );
+
+    /* Re-use the chunks of a cleared buffer, which is the steady state of a command buffer that is re-recorded every frame */
+    BenchmarkCommandBuffer reusedBuffer;
+    harness.Run(
+        "VirtualCommandBuffer.RecordReused",
+        [&reusedBuffer]()
+        {
+            reusedBuffer.Clear();
+            RecordBenchmarkCommands(reusedBuffer);
+            DoNotOptimize(&reusedBuffer);
+        }
+    );
+
+    harness.Run(
+        "VirtualCommandBuffer.RecordAndPack",
+        []()
+        {
+            BenchmarkCommandBuffer buffer;
+            RecordBenchmarkCommands(buffer);
+            buffer.Pack();
+            DoNotOptimize(&buffer);
+        }
+    );
+
+    /* Allocate and free chunks of all size classes directly from the pool */
+    harness.Run(
+        "VirtualCommandBuffer.ChunkPool",
+        []()
+        {
+            void*       ptrs[8];
+            std::size_t sizes[8];
+            for (std::size_t i = 0; i < 8; ++i)
+                ptrs[i] = LLGL::AllocVirtualCommandBufferChunk(std::size_t(128) << i, sizes[i]);
+            for (std::size_t i = 0; i < 8; ++i)
+                LLGL::FreeVirtualCommandBufferChunk(ptrs[i], sizes[i]);
+            DoNotOptimize(ptrs);
+        }
+    );
+}
+
+
+/*
+ * Command buffer recording
+ */
+
+// Number of draw calls that are recorded into each command buffer.
+static const std::uint32_t g_numDrawCalls = 256;
+
+// Records a typical frame into the specified command buffer. No pipeline state is bound, since the commands are only recorded but never submitted.
+static void RecordFrameCommands(LLGL::CommandBuffer& cmdBuffer, LLGL::Buffer& vertexBuffer, LLGL::Buffer& indexBuffer, LLGL::Buffer& constantBuffer)
+{
+    const float constants[16] = {};
+
+    cmdBuffer.Begin();
+    {
+        cmdBuffer.UpdateBuffer(constantBuffer, 0, constants, sizeof(constants));
+        cmdBuffer.SetViewport(LLGL::Viewport{ 0.0f, 0.0f, 256.0f, 256.0f });
+        cmdBuffer.SetScissor(LLGL::Scissor{ 0, 0, 256, 256 });
+        cmdBuffer.SetVertexBuffer(vertexBuffer);
+        cmdBuffer.SetIndexBuffer(indexBuffer);
+        for (std::uint32_t i = 0; i < g_numDrawCalls; ++i)
+        {
+            if (i % 16 == 0)
+                cmdBuffer.SetBlendFactor(LLGL::ColorRGBAf{ 1.0f, 1.0f, 1.0f, static_cast<float>(i) / g_numDrawCalls });
+            if (i % 2 == 0)
+                cmdBuffer.Draw(3, i * 3);
+            else
+                cmdBuffer.DrawIndexed(6, i * 6);
+        }
+    }
+    cmdBuffer.End();
+}
+
+// Records the same command stream with the specified renderer module, or skips the benchmark if the module is not available.
+static void RunCommandRecordingBenchmark(BenchmarkHarness& harness, const std::string& moduleName)
+{
+    const std::string name          = "CommandBuffer.Record." + moduleName;
+    const std::string nameMulti     = name + ".MultiSubmit";
+
+    if (!harness.IsEnabled(name) && !harness.IsEnabled(nameMulti))
+        return;
+
+    /* Load render system; a context (and for OpenGL a display) is required, so report the reason if this fails */
+    std::unique_ptr<LLGL::RenderSystem> renderer;
+    try
+    {
+        renderer = LLGL::RenderSystem::Load(moduleName);
+
+        LLGL::SwapChainDescriptor swapChainDesc;
+        {
+            swapChainDesc.resolution = { 256, 256 };
+        }
+        renderer->CreateSwapChain(swapChainDesc);
+    }
+    catch (const std::exception& e)
+    {
+        if (renderer)
+            LLGL::RenderSystem::Unload(std::move(renderer));
+        harness.Skip(name, e.what());
+        harness.Skip(nameMulti, e.what());
+        return;
+    }
+
+    LLGL::BufferDescriptor vertexBufferDesc;
+    {
+        vertexBufferDesc.size       = 4096;
+        vertexBufferDesc.bindFlags  = LLGL::BindFlags::VertexBuffer;
+    }
+    auto vertexBuffer = renderer->CreateBuffer(vertexBufferDesc);
+
+    LLGL::BufferDescriptor indexBufferDesc;
+    {
+        indexBufferDesc.size        = 4096;
+        indexBufferDesc.bindFlags   = LLGL::BindFlags::IndexBuffer;
+        indexBufferDesc.format      = LLGL::Format::R16UInt;
+    }
+    auto indexBuffer = renderer->CreateBuffer(indexBufferDesc);
+
+    LLGL::BufferDescriptor constantBufferDesc;
+    {
+        constantBufferDesc.size         = 256;
+        constantBufferDesc.bindFlags    = LLGL::BindFlags::ConstantBuffer;
+    }
+    auto constantBuffer = renderer->CreateBuffer(constantBufferDesc);
+
+    /* Deferred command buffer that is re-recorded every frame */
+    auto cmdBuffer = renderer->CreateCommandBuffer();
+    harness.Run(
+        name,
+        [&]()
+        {
+            RecordFrameCommands(*cmdBuffer, *vertexBuffer, *indexBuffer, *constantBuffer);
+        }
+    );
+
+    /* Multi-submit command buffers are optimized (and JIT compiled if enabled) at the end of recording */
+    auto cmdBufferMulti = renderer->CreateCommandBuffer(LLGL::CommandBufferFlags::MultiSubmit);
+    harness.Run(
+        nameMulti,
+        [&]()
+        {
+            RecordFrameCommands(*cmdBufferMulti, *vertexBuffer, *indexBuffer, *constantBuffer);
+        }
+    );
+
+    LLGL::RenderSystem::Unload(std::move(renderer));
+}
+
+
+/*
+ * JIT compiler
+ */
+
+#ifdef LLGL_ENABLE_JIT_COMPILER
+
+static void BenchmarkJITCallee(void* /*context*/, std::uint32_t /*value*/)
+{
+    // dummy
+}
+
+static void RunJITBenchmarks(BenchmarkHarness& harness)
+{
+    if (!LLGL::JITCompiler::Create())
+    {
+        harness.Skip("JITCompiler.Assemble", "JIT compiler is not supported for this architecture");
+        return;
+    }
+
+    /* Assemble a program with one function call per command, as the GL backend does for each recorded command */
+    harness.Run(
+        "JITCompiler.Assemble",
+        []()
+        {
+            auto compiler = LLGL::JITCompiler::Create();
+            compiler->EntryPointVarArgs({ LLGL::JIT::ArgType::Ptr });
+            compiler->Begin();
+            {
+                for (std::uint32_t i = 0; i < g_numCommands; ++i)
+                {
+                    compiler->PushVarArg(0);
+                    compiler->PushDWord(i);
+                    compiler->FuncCall(reinterpret_cast<const void*>(BenchmarkJITCallee));
+                }
+            }
+            compiler->End();
+            auto program = compiler->FlushProgram();
+            DoNotOptimize(program.get());
+        }
+    );
+}
+
+#endif // /LLGL_ENABLE_JIT_COMPILER
+
+void RunCommandBenchmarks(BenchmarkHarness& harness)
+{
+    RunVirtualCommandBufferBenchmarks(harness);
+    RunCommandRecordingBenchmark(harness, "OpenGL");
+    RunCommandRecordingBenchmark(harness, "Null");
+    #ifdef LLGL_ENABLE_JIT_COMPILER
+    RunJITBenchmarks(harness);
+    #else
+    harness.Skip("JITCompiler.Assemble", "LLGL was not compiled with LLGL_ENABLE_JIT_COMPILER");
+    #endif
+}
+
+
+} // /namespace LLGLBenchmark
+
+
+
+// ================================================================================
@@ -0,0 +1,233 @@
+/*
+ * BenchmarkHarness.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BenchmarkHarness.h"
+#include <LLGL/Version.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+
+
+namespace LLGLBenchmark
+{
+
+
+using Clock = std::chrono::steady_clock;
+
+// Runs the benchmark function the specified number of times and returns the elapsed time in nanoseconds.
+static double MeasureBatch(const std::function<void()>& func, std::size_t iterations)
+{
+    const auto startTime = Clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+        func();
+    const auto endTime = Clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count());
+}
+
+// Returns the percentile of the sorted samples with linear interpolation between the closest ranks.
+static double Percentile(const std::vector<double>& sortedSamples, double percentile)
+{
+    if (sortedSamples.empty())
+        return 0.0;
+    const auto rank     = percentile * static_cast<double>(sortedSamples.size() - 1);
+    const auto lower    = static_cast<std::size_t>(std::floor(rank));
+    const auto upper    = std::min(lower + 1, sortedSamples.size() - 1);
+    const auto frac     = rank - static_cast<double>(lower);
+    return (sortedSamples[lower] + (sortedSamples[upper] - sortedSamples[lower]) * frac);
+}
+
+BenchmarkHarness::BenchmarkHarness(const BenchmarkConfig& config) :
+    config_ { config }
+{
+}
+
+void BenchmarkHarness::Run(const std::string& name, const std::function<void()>& func, std::uint64_t bytesPerIteration)
+{
+    if (!IsEnabled(name))
+        return;
+
+    /* Calibrate number of iterations per sample, so each sample takes at least the minimal sample time */
+    const auto minSampleTimeNS = config_.minSampleTime * 1.0e9;
+
+    std::size_t iterations = 1;
+    for (;;)
+    {
+        const auto elapsed = MeasureBatch(func, iterations);
+        if (elapsed >= minSampleTimeNS || iterations >= (1u << 24))
+            break;
+        if (elapsed <= 0.0)
+            iterations *= 10;
+        else
+            iterations = std::max(iterations + 1, static_cast<std::size_t>(static_cast<double>(iterations) * minSampleTimeNS * 1.2 / elapsed));
+    }
+
+    /* Warm up caches and allocators */
+    for (std::size_t i = 0; i < config_.numWarmups; ++i)
+        MeasureBatch(func, iterations);
+
+    /* Take samples with the time per iteration */
+    std::vector<double> samples(std::max<std::size_t>(1u, config_.numSamples));
+    for (auto& sample : samples)
+        sample = MeasureBatch(func, iterations) / static_cast<double>(iterations);
+
+    std::sort(samples.begin(), samples.end());
+
+    /* Summarize samples */
+    BenchmarkResult result;
+    {
+        result.name                 = name;
+        result.iterationsPerSample  = iterations;
+        result.numSamples           = samples.size();
+        result.min                  = samples.front();
+        result.max                  = samples.back();
+        result.mean                 = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+        result.p50                  = Percentile(samples, 0.50);
+        result.p90                  = Percentile(samples, 0.90);
+        result.p99                  = Percentile(samples, 0.99);
+        result.bytesPerIteration    = bytesPerIteration;
+
+        double variance = 0.0;
+        for (auto sample : samples)
+            variance += (sample - result.mean) * (sample - result.mean);
+        result.stddev = std::sqrt(variance / static_cast<double>(samples.size()));
+    }
+    results_.push_back(result);
+}
+
+void BenchmarkHarness::Skip(const std::string& name, const std::string& reason)
+{
+    if (IsEnabled(name))
+        skipped_.push_back({ name, reason });
+}
+
+bool BenchmarkHarness::IsEnabled(const std::string& name) const
+{
+    return (config_.filter.empty() || name.find(config_.filter) != std::string::npos);
+}
+
+// Writes the specified string as JSON string literal.
+static void WriteJSONString(std::ostream& stream, const std::string& str)
+{
+    stream << '\"';
+    for (auto chr : str)
+    {
+        switch (chr)
+        {
+            case '\"': stream << "\\\""; break;
+            case '\\': stream << "\\\\"; break;
+            case '\n': stream << "\\n"; break;
+            case '\t': stream << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(chr) < 0x20)
+                    stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(chr) << std::dec << std::setfill(' ');
+                else
+                    stream << chr;
+                break;
+        }
+    }
+    stream << '\"';
+}
+
+void BenchmarkHarness::WriteJSON(std::ostream& stream) const
+{
+    const auto prevPrecision = stream.precision(6);
+    stream << std::fixed;
+
+    stream << "{\n";
+    stream << "  \"version\": ";
+    WriteJSONString(stream, LLGL::Version::GetString());
+    stream << ",\n";
+    stream << "  \"versionID\": " << LLGL::Version::GetID() << ",\n";
+    stream << "  \"config\": { \"warmups\": " << config_.numWarmups << ", \"samples\": " << config_.numSamples << ", \"minSampleTime\": " << config_.minSampleTime << " },\n";
+    stream << "  \"unit\": \"ns\",\n";
+
+    stream << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results_.size(); ++i)
+    {
+        const auto& result = results_[i];
+        stream << (i > 0 ? ",\n" : "\n") << "    { \"name\": ";
+        WriteJSONString(stream, result.name);
+        stream << ", \"iterations\": " << result.iterationsPerSample;
+        stream << ", \"samples\": " << result.numSamples;
+        stream << ", \"min\": " << result.min;
+        stream << ", \"p50\": " << result.p50;
+        stream << ", \"p90\": " << result.p90;
+        stream << ", \"p99\": " << result.p99;
+        stream << ", \"max\": " << result.max;
+        stream << ", \"mean\": " << result.mean;
+        stream << ", \"stddev\": " << result.stddev;
+        if (result.bytesPerIteration > 0)
+            stream << ", \"bytes\": " << result.bytesPerIteration;
+        stream << " }";
+    }
+    stream << (results_.empty() ? "],\n" : "\n  ],\n");
+
+    stream << "  \"skipped\": [";
+    for (std::size_t i = 0; i < skipped_.size(); ++i)
+    {
+        stream << (i > 0 ? ",\n" : "\n") << "    { \"name\": ";
+        WriteJSONString(stream, skipped_[i].name);
+        stream << ", \"reason\": ";
+        WriteJSONString(stream, skipped_[i].reason);
+        stream << " }";
+    }
+    stream << (skipped_.empty() ? "]\n" : "\n  ]\n");
+    stream << "}\n";
+
+    stream.unsetf(std::ios::floatfield);
+    stream.precision(prevPrecision);
+}
+
+void BenchmarkHarness::WriteSummary(std::ostream& stream) const
+{
+    /* Determine width of name column */
+    std::size_t nameWidth = 4;
+    for (const auto& result : results_)
+        nameWidth = std::max(nameWidth, result.name.size());
+
+    const auto prevPrecision = stream.precision(1);
+    stream << std::fixed;
+
+    stream << std::left << std::setw(static_cast<int>(nameWidth)) << "Name" << std::right;
+    stream << std::setw(14) << "p50 [ns]" << std::setw(14) << "p90 [ns]" << std::setw(14) << "p99 [ns]" << std::setw(12) << "MiB/s" << '\n';
+
+    for (const auto& result : results_)
+    {
+        stream << std::left << std::setw(static_cast<int>(nameWidth)) << result.name << std::right;
+        stream << std::setw(14) << result.p50 << std::setw(14) << result.p90 << std::setw(14) << result.p99;
+        if (result.bytesPerIteration > 0 && result.p50 > 0.0)
+            stream << std::setw(12) << (static_cast<double>(result.bytesPerIteration) / (result.p50 * 1.0e-9) / (1024.0 * 1024.0));
+        stream << '\n';
+    }
+
+    for (const auto& skip : skipped_)
+        stream << std::left << std::setw(static_cast<int>(nameWidth)) << skip.name << std::right << "  skipped: " << skip.reason << '\n';
+
+    stream.unsetf(std::ios::floatfield);
+    stream.precision(prevPrecision);
+}
+
+void DoNotOptimize(const void* value)
+{
+    #if defined __GNUC__ || defined __clang__
+    /* Pass pointer to an empty assembly block that clobbers memory, so the compiler must assume the pointed-to data is read */
+    __asm__ __volatile__ ("" : : "r" (value) : "memory");
+    #else
+    /* This function is defined out of line, so the compiler must assume the value escapes through the volatile storage */
+    static const void* volatile sink = nullptr;
+    sink = value;
+    #endif
+}
+
+
+} // /namespace LLGLBenchmark
+
+
+
+// ================================================================================
@@ -0,0 +1,110 @@
+/*
+ * BenchmarkHarness.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BENCHMARK_HARNESS_H
+#define LLGL_BENCHMARK_HARNESS_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+
+namespace LLGLBenchmark
+{
+
+
+// Configuration for all benchmarks of a single run.
+struct BenchmarkConfig
+{
+    std::size_t numWarmups          = 3;        // Number of samples that are taken and discarded before measuring.
+    std::size_t numSamples          = 30;       // Number of measured samples for each benchmark.
+    double      minSampleTime       = 0.0005;   // Minimal duration (in seconds) of each sample; short benchmarks are repeated within a sample to reach this.
+    std::string filter;                         // Only benchmarks whose name contains this string are run.
+};
+
+// Statistics of a single benchmark. All times are in nanoseconds per iteration.
+struct BenchmarkResult
+{
+    std::string     name;
+    std::size_t     iterationsPerSample = 0;
+    std::size_t     numSamples          = 0;
+    double          min                 = 0.0;
+    double          max                 = 0.0;
+    double          mean                = 0.0;
+    double          stddev              = 0.0;
+    double          p50                 = 0.0;
+    double          p90                 = 0.0;
+    double          p99                 = 0.0;
+    std::uint64_t   bytesPerIteration   = 0;    // Optional number of bytes processed per iteration to report throughput, or 0.
+};
+
+// Benchmark that was not run, e.g. because it requires a feature that is not available.
+struct BenchmarkSkip
+{
+    std::string name;
+    std::string reason;
+};
+
+/*
+Standardized harness for micro-benchmarks: Each benchmark is calibrated and warmed up first,
+then sampled multiple times, and the per-iteration times are summarized with percentiles.
+*/
+class BenchmarkHarness
+{
+
+    public:
+
+        BenchmarkHarness(const BenchmarkConfig& config);
+
+        /*
+        Runs the specified benchmark function unless it is excluded by the filter.
+        If 'bytesPerIteration' is non-zero, the result also reports the throughput.
+        */
+        void Run(const std::string& name, const std::function<void()>& func, std::uint64_t bytesPerIteration = 0);
+
+        // Records the specified benchmark as skipped unless it is excluded by the filter.
+        void Skip(const std::string& name, const std::string& reason);
+
+        // Returns true if the specified benchmark name passes the filter.
+        bool IsEnabled(const std::string& name) const;
+
+        // Writes all results as JSON document to the specified stream.
+        void WriteJSON(std::ostream& stream) const;
+
+        // Writes a human readable table of all results to the specified stream.
+        void WriteSummary(std::ostream& stream) const;
+
+        // Returns the results of all benchmarks that have been run so far.
+        inline const std::vector<BenchmarkResult>& GetResults() const
+        {
+            return results_;
+        }
+
+    private:
+
+        BenchmarkConfig                 config_;
+        std::vector<BenchmarkResult>    results_;
+        std::vector<BenchmarkSkip>      skipped_;
+
+};
+
+// Prevents the compiler from optimizing away the computation of the specified value.
+void DoNotOptimize(const void* value);
+
+
+} // /namespace LLGLBenchmark
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,327 @@
+/*
+ * BenchmarkImage.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BenchmarkSuites.h"
+#include <LLGL/ImageFlags.h>
+#include <LLGL/Format.h>
+#include <LLGL/Constants.h>
+#include "../../sources/Core/ImageUtils.h"
+#include "../../sources/Core/Float16Compressor.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace LLGLBenchmark
+{
+
+
+// Edge length of the square test images.
+static const std::uint32_t g_imageSize = 256;
+
+struct ImageFormatEntry
+{
+    LLGL::ImageFormat   format;
+    const char*         name;
+};
+
+struct DataTypeEntry
+{
+    LLGL::DataType      dataType;
+    const char*         name;
+};
+
+// All uncompressed color formats that are supported by ConvertImageBuffer.
+static const ImageFormatEntry g_colorFormats[] =
+{
+    { LLGL::ImageFormat::Alpha, "Alpha" },
+    { LLGL::ImageFormat::R,     "R"     },
+    { LLGL::ImageFormat::RG,    "RG"    },
+    { LLGL::ImageFormat::RGB,   "RGB"   },
+    { LLGL::ImageFormat::BGR,   "BGR"   },
+    { LLGL::ImageFormat::RGBA,  "RGBA"  },
+    { LLGL::ImageFormat::BGRA,  "BGRA"  },
+    { LLGL::ImageFormat::ARGB,  "ARGB"  },
+    { LLGL::ImageFormat::ABGR,  "ABGR"  },
+};
+
+// All data types that are supported by ConvertImageBuffer.
+static const DataTypeEntry g_dataTypes[] =
+{
+    { LLGL::DataType::Int8,     "Int8"    },
+    { LLGL::DataType::UInt8,    "UInt8"   },
+    { LLGL::DataType::Int16,    "Int16"   },
+    { LLGL::DataType::UInt16,   "UInt16"  },
+    { LLGL::DataType::Int32,    "Int32"   },
+    { LLGL::DataType::UInt32,   "UInt32"  },
+    { LLGL::DataType::Float16,  "Float16" },
+    { LLGL::DataType::Float32,  "Float32" },
+    { LLGL::DataType::Float64,  "Float64" },
+};
+
+// Returns a buffer of the specified size with a deterministic pseudo random byte pattern.
+static std::vector<char> GenerateBytes(std::size_t size)
+{
+    std::vector<char> data(size);
+    std::uint32_t state = 0x12345678u;
+    for (auto& byte : data)
+    {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<char>(state >> 24);
+    }
+    return data;
+}
+
+// Returns a buffer with valid floating-point values in the range [0, 1] for the specified data type, so conversions do not hit NaN or denormal paths.
+static std::vector<char> GenerateImage(LLGL::ImageFormat format, LLGL::DataType dataType, const LLGL::Extent3D& extent)
+{
+    const auto size = LLGL::GetImageBufferSize(format, dataType, extent);
+    if (dataType == LLGL::DataType::Float16 || dataType == LLGL::DataType::Float32 || dataType == LLGL::DataType::Float64)
+    {
+        const auto bytes        = GenerateBytes(size);
+        const auto numElements  = size / LLGL::DataTypeSize(dataType);
+        std::vector<char> data(size);
+        for (std::size_t i = 0; i < numElements; ++i)
+        {
+            const auto value = static_cast<float>(static_cast<unsigned char>(bytes[i])) / 255.0f;
+            switch (dataType)
+            {
+                case LLGL::DataType::Float16:
+                    reinterpret_cast<std::uint16_t*>(data.data())[i] = LLGL::CompressFloat16(value);
+                    break;
+                case LLGL::DataType::Float32:
+                    reinterpret_cast<float*>(data.data())[i] = value;
+                    break;
+                default:
+                    reinterpret_cast<double*>(data.data())[i] = static_cast<double>(value);
+                    break;
+            }
+        }
+        return data;
+    }
+    return GenerateBytes(size);
+}
+
+static void RunConvertImageBenchmarks(BenchmarkHarness& harness)
+{
+    const LLGL::Extent3D extent{ g_imageSize, g_imageSize, 1 };
+
+    const auto refFormat    = LLGL::ImageFormat::RGBA;
+    const auto refDataType  = LLGL::DataType::UInt8;
+
+    auto refImage = GenerateImage(refFormat, refDataType, extent);
+
+    for (const auto& formatEntry : g_colorFormats)
+    {
+        for (const auto& dataTypeEntry : g_dataTypes)
+        {
+            const auto format   = formatEntry.format;
+            const auto dataType = dataTypeEntry.dataType;
+
+            if (format == refFormat && dataType == refDataType)
+                continue;
+
+            const std::string pairName = std::string(formatEntry.name) + "/" + dataTypeEntry.name;
+            const auto imageSize = LLGL::GetImageBufferSize(format, dataType, extent);
+
+            /* Convert from each format/type pair into the reference format, which is the typical texture upload path */
+            const std::string srcName = "ConvertImageBuffer." + pairName + "->RGBA/UInt8";
+            if (harness.IsEnabled(srcName))
+            {
+                auto srcImage = GenerateImage(format, dataType, extent);
+                std::vector<char> dstImage(refImage.size());
+
+                const LLGL::SrcImageDescriptor srcDesc{ format, dataType, srcImage.data(), srcImage.size() };
+                const LLGL::DstImageDescriptor dstDesc{ refFormat, refDataType, dstImage.data(), dstImage.size() };
+
+                harness.Run(
+                    srcName,
+                    [&]()
+                    {
+                        LLGL::ConvertImageBuffer(srcDesc, dstDesc);
+                        DoNotOptimize(dstImage.data());
+                    },
+                    imageSize
+                );
+            }
+
+            /* Convert from the reference format into each format/type pair, which is the typical texture read-back path */
+            const std::string dstName = "ConvertImageBuffer.RGBA/UInt8->" + pairName;
+            if (harness.IsEnabled(dstName))
+            {
+                std::vector<char> dstImage(imageSize);
+
+                const LLGL::SrcImageDescriptor srcDesc{ refFormat, refDataType, refImage.data(), refImage.size() };
+                const LLGL::DstImageDescriptor dstDesc{ format, dataType, dstImage.data(), dstImage.size() };
+
+                harness.Run(
+                    dstName,
+                    [&]()
+                    {
+                        LLGL::ConvertImageBuffer(srcDesc, dstDesc);
+                        DoNotOptimize(dstImage.data());
+                    },
+                    imageSize
+                );
+            }
+        }
+    }
+
+    /* Multi-threaded conversion of the most common upload path */
+    const std::string mtName = "ConvertImageBuffer.RGB/UInt8->RGBA/UInt8.MaxThreads";
+    if (harness.IsEnabled(mtName))
+    {
+        auto srcImage = GenerateImage(LLGL::ImageFormat::RGB, LLGL::DataType::UInt8, extent);
+        std::vector<char> dstImage(refImage.size());
+
+        const LLGL::SrcImageDescriptor srcDesc{ LLGL::ImageFormat::RGB, LLGL::DataType::UInt8, srcImage.data(), srcImage.size() };
+        const LLGL::DstImageDescriptor dstDesc{ refFormat, refDataType, dstImage.data(), dstImage.size() };
+
+        harness.Run(
+            mtName,
+            [&]()
+            {
+                LLGL::ConvertImageBuffer(srcDesc, dstDesc, LLGL::Constants::maxThreadCount);
+                DoNotOptimize(dstImage.data());
+            },
+            srcImage.size()
+        );
+    }
+}
+
+static void RunCopyImageBenchmarks(BenchmarkHarness& harness)
+{
+    /* Copy the inner region of a 3D image; CopyImageBufferRegion takes strides in pixels and BitBlit in bytes */
+    const LLGL::Extent3D    imageExtent { 128, 128, 16 };
+    const LLGL::Extent3D    copyExtent  { 96, 96, 12 };
+    const LLGL::Offset3D    copyOffset  { 16, 16, 2 };
+    const std::uint32_t     bpp         = 4;
+    const std::uint32_t     rowStride   = imageExtent.width * bpp;
+    const std::uint32_t     depthStride = rowStride * imageExtent.height;
+    const std::uint64_t     copySize    = static_cast<std::uint64_t>(copyExtent.width) * copyExtent.height * copyExtent.depth * bpp;
+
+    auto srcImage = GenerateBytes(depthStride * imageExtent.depth);
+    std::vector<char> dstImage(srcImage.size());
+
+    harness.Run(
+        "CopyImageBufferRegion.RGBA/UInt8.3D",
+        [&]()
+        {
+            LLGL::CopyImageBufferRegion(
+                LLGL::DstImageDescriptor{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, dstImage.data(), dstImage.size() },
+                copyOffset,
+                imageExtent.width,
+                imageExtent.width * imageExtent.height,
+                LLGL::SrcImageDescriptor{ LLGL::ImageFormat::RGBA, LLGL::DataType::UInt8, srcImage.data(), srcImage.size() },
+                copyOffset,
+                imageExtent.width,
+                imageExtent.width * imageExtent.height,
+                copyExtent
+            );
+            DoNotOptimize(dstImage.data());
+        },
+        copySize
+    );
+
+    harness.Run(
+        "BitBlit.Strided",
+        [&]()
+        {
+            LLGL::BitBlit(
+                copyExtent,
+                bpp,
+                dstImage.data() + copyOffset.z * depthStride + copyOffset.y * rowStride + copyOffset.x * bpp,
+                rowStride,
+                depthStride,
+                srcImage.data() + copyOffset.z * depthStride + copyOffset.y * rowStride + copyOffset.x * bpp,
+                rowStride,
+                depthStride
+            );
+            DoNotOptimize(dstImage.data());
+        },
+        copySize
+    );
+
+    /* Tightly packed images are copied with a single memcpy */
+    harness.Run(
+        "BitBlit.Packed",
+        [&]()
+        {
+            LLGL::BitBlit(imageExtent, bpp, dstImage.data(), rowStride, depthStride, srcImage.data(), rowStride, depthStride);
+            DoNotOptimize(dstImage.data());
+        },
+        srcImage.size()
+    );
+}
+
+static void RunFloat16Benchmarks(BenchmarkHarness& harness)
+{
+    const std::size_t numElements = 64 * 1024;
+
+    std::vector<float> floats(numElements);
+    for (std::size_t i = 0; i < numElements; ++i)
+        floats[i] = static_cast<float>(i % 4096) * 0.125f - 256.0f;
+
+    std::vector<std::uint16_t> halfs(numElements);
+    LLGL::CompressFloat16Array(floats.data(), halfs.data(), numElements);
+
+    harness.Run(
+        "Float16.Compress",
+        [&]()
+        {
+            for (std::size_t i = 0; i < numElements; ++i)
+                halfs[i] = LLGL::CompressFloat16(floats[i]);
+            DoNotOptimize(halfs.data());
+        },
+        numElements * sizeof(float)
+    );
+
+    harness.Run(
+        "Float16.Decompress",
+        [&]()
+        {
+            for (std::size_t i = 0; i < numElements; ++i)
+                floats[i] = LLGL::DecompressFloat16(halfs[i]);
+            DoNotOptimize(floats.data());
+        },
+        numElements * sizeof(std::uint16_t)
+    );
+
+    harness.Run(
+        "Float16.CompressArray",
+        [&]()
+        {
+            LLGL::CompressFloat16Array(floats.data(), halfs.data(), numElements);
+            DoNotOptimize(halfs.data());
+        },
+        numElements * sizeof(float)
+    );
+
+    harness.Run(
+        "Float16.DecompressArray",
+        [&]()
+        {
+            LLGL::DecompressFloat16Array(halfs.data(), floats.data(), numElements);
+            DoNotOptimize(floats.data());
+        },
+        numElements * sizeof(std::uint16_t)
+    );
+}
+
+void RunImageBenchmarks(BenchmarkHarness& harness)
+{
+    RunConvertImageBenchmarks(harness);
+    RunCopyImageBenchmarks(harness);
+    RunFloat16Benchmarks(harness);
+}
+
+
+} // /namespace LLGLBenchmark
+
+
+
+// ================================================================================
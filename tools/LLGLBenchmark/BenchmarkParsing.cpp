@@ -0,0 +1,204 @@
+/*
+ * BenchmarkParsing.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BenchmarkSuites.h"
+#include <LLGL/ThreadPool.h>
+#ifdef LLGL_ENABLE_UTILITY
+#   include <LLGL/Utility.h>
+#endif
+#include "../../sources/Renderer/Serialization.h"
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+#   include "../../sources/Renderer/SPIRV/SPIRVReflect.h"
+#endif
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+namespace LLGLBenchmark
+{
+
+
+#ifdef LLGL_ENABLE_SPIRV_REFLECT
+
+static void RunSPIRVReflectBenchmarks(BenchmarkHarness& harness, const std::string& spirvFilename)
+{
+    const std::string name = "SPIRVReflect.Parse";
+    if (!harness.IsEnabled(name))
+        return;
+
+    /* Read SPIR-V module into memory, so file I/O does not distort the timings */
+    std::ifstream file{ spirvFilename, std::ios::in | std::ios::binary };
+    if (!file.good())
+    {
+        harness.Skip(name, "failed to read SPIR-V module: " + spirvFilename);
+        return;
+    }
+
+    const std::vector<char> byteCode
+    {
+        (std::istreambuf_iterator<char>(file)),
+        (std::istreambuf_iterator<char>())
+    };
+
+    try
+    {
+        LLGL::SPIRVReflect reflect;
+        reflect.Parse(byteCode.data(), byteCode.size());
+    }
+    catch (const std::exception& e)
+    {
+        harness.Skip(name, e.what());
+        return;
+    }
+
+    harness.Run(
+        name,
+        [&byteCode]()
+        {
+            LLGL::SPIRVReflect reflect;
+            reflect.Parse(byteCode.data(), byteCode.size());
+            DoNotOptimize(&reflect);
+        },
+        byteCode.size()
+    );
+
+    /* Re-use the reflection tables of the previous module */
+    LLGL::SPIRVReflect reusedReflect;
+    harness.Run(
+        "SPIRVReflect.ParseReused",
+        [&byteCode, &reusedReflect]()
+        {
+            reusedReflect.Parse(byteCode.data(), byteCode.size());
+            DoNotOptimize(&reusedReflect);
+        },
+        byteCode.size()
+    );
+
+    /* Reflect a batch of modules at once, as done for shader permutations */
+    const std::size_t numModules = 64;
+
+    std::vector<LLGL::SPIRVModuleView>  modules(numModules, LLGL::SPIRVModuleView{ byteCode.data(), byteCode.size() });
+    std::vector<LLGL::SPIRVReflect>     reflections(numModules);
+    auto                                threadPool  = LLGL::ThreadPool::Create();
+
+    harness.Run(
+        "SPIRVReflect.ParseModules",
+        [&]()
+        {
+            LLGL::SPIRVReflect::ParseModules(numModules, modules.data(), reflections.data(), threadPool.get());
+            DoNotOptimize(reflections.data());
+        },
+        byteCode.size() * numModules
+    );
+}
+
+#endif // /LLGL_ENABLE_SPIRV_REFLECT
+
+#ifdef LLGL_ENABLE_UTILITY
+
+static void RunPipelineLayoutBenchmarks(BenchmarkHarness& harness)
+{
+    /* Short signature as used by most examples */
+    harness.Run(
+        "PipelineLayoutDesc.Short",
+        []()
+        {
+            auto layoutDesc = LLGL::PipelineLayoutDesc("cbuffer(0):vert:frag, texture(1):frag, sampler(2):frag");
+            DoNotOptimize(layoutDesc.bindings.data());
+        }
+    );
+
+    /* Long signature with names, arrays, and multiple slots per binding point */
+    harness.Run(
+        "PipelineLayoutDesc.Long",
+        []()
+        {
+            auto layoutDesc = LLGL::PipelineLayoutDesc(
+                "cbuffer(Scene@0, Material@1, Lights@2):vert:frag,"
+                "buffer(Instances@3[4]):vert,"
+                "rwbuffer(Particles@4, Counters@5):comp,"
+                "texture(ColorMap@6, NormalMap@7, SpecularMap@8, ShadowMaps@9[4]):frag,"
+                "rwtexture(Output@10):comp,"
+                "sampler(LinearSampler@11, ShadowSampler@12):frag,"
+            );
+            DoNotOptimize(layoutDesc.bindings.data());
+        }
+    );
+}
+
+#endif // /LLGL_ENABLE_UTILITY
+
+static void RunSerializerBenchmarks(BenchmarkHarness& harness)
+{
+    using namespace LLGL::Serialization;
+
+    /* Round-trip of many small segments, similar to a serialized pipeline state */
+    const std::size_t   numSegments = 256;
+    const char          payload[48] = "LLGL serialization benchmark payload";
+
+    harness.Run(
+        "Serializer.RoundTrip",
+        [&payload]()
+        {
+            Serializer writer;
+            for (std::size_t i = 0; i < numSegments; ++i)
+            {
+                writer.Begin(static_cast<IdentType>(i + 1));
+                {
+                    writer.WriteTyped(static_cast<std::uint32_t>(i));
+                    writer.Write(payload, sizeof(payload));
+                    writer.WriteCString("name");
+                }
+                writer.End();
+            }
+            auto blob = writer.Finalize();
+
+            Deserializer reader{ *blob };
+            std::uint32_t   index       = 0;
+            char            data[sizeof(payload)];
+            for (std::size_t i = 0; i < numSegments; ++i)
+            {
+                reader.Begin(static_cast<IdentType>(i + 1));
+                {
+                    reader.ReadTyped(index);
+                    reader.Read(data, sizeof(data));
+                    DoNotOptimize(reader.ReadCString());
+                }
+                reader.End();
+            }
+            DoNotOptimize(data);
+        },
+        numSegments * (sizeof(std::uint32_t) + sizeof(payload) + 5)
+    );
+}
+
+void RunParsingBenchmarks(BenchmarkHarness& harness, const std::string& spirvFilename)
+{
+    #ifdef LLGL_ENABLE_SPIRV_REFLECT
+    RunSPIRVReflectBenchmarks(harness, spirvFilename);
+    #else
+    (void)spirvFilename;
+    harness.Skip("SPIRVReflect.Parse", "LLGL was not compiled with LLGL_ENABLE_SPIRV_REFLECT");
+    #endif
+    #ifdef LLGL_ENABLE_UTILITY
+    RunPipelineLayoutBenchmarks(harness);
+    #else
+    harness.Skip("PipelineLayoutDesc", "LLGL was not compiled with LLGL_ENABLE_UTILITY");
+    #endif
+    RunSerializerBenchmarks(harness);
+}
+
+
+} // /namespace LLGLBenchmark
+
+
+
+// ================================================================================
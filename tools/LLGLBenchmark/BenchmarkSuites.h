@@ -0,0 +1,37 @@
+/*
+ * BenchmarkSuites.h
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#ifndef LLGL_BENCHMARK_SUITES_H
+#define LLGL_BENCHMARK_SUITES_H
+
+
+#include "BenchmarkHarness.h"
+#include <string>
+
+
+namespace LLGLBenchmark
+{
+
+
+// Image conversion and copy: ConvertImageBuffer, CopyImageBufferRegion, BitBlit, and Float16 conversion.
+void RunImageBenchmarks(BenchmarkHarness& harness);
+
+// Command recording: VirtualCommandBuffer allocation and Pack, deferred command buffer recording, and the JIT assembler.
+void RunCommandBenchmarks(BenchmarkHarness& harness);
+
+// Parsing: SPIR-V reflection of the specified module file, pipeline layout signatures, and Serializer round-trips.
+void RunParsingBenchmarks(BenchmarkHarness& harness, const std::string& spirvFilename);
+
+
+} // /namespace LLGLBenchmark
+
+
+#endif
+
+
+
+// ================================================================================
@@ -0,0 +1,116 @@
+/*
+ * LLGLBenchmark.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include "BenchmarkHarness.h"
+#include "BenchmarkSuites.h"
+#include <LLGL/Version.h>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+
+using namespace LLGLBenchmark;
+
+/*
+Runs the micro-benchmarks of LLGL's CPU-side hot paths and writes the statistics as JSON,
+so the results of different LLGL versions can be compared to catch performance regressions.
+Usage: LLGLBenchmark [--json FILE] [--filter NAME] [--samples N] [--warmups N] [--min-time SECONDS] [--spirv FILE]
+*/
+
+struct ToolConfig
+{
+    BenchmarkConfig benchmark;
+    std::string     jsonFilename;
+    std::string     spirvFilename   = "tests/Shaders/SpirvReflectTest.comp.spv";
+};
+
+static void PrintUsage()
+{
+    std::cerr << "usage: LLGLBenchmark [--json FILE] [--filter NAME] [--samples N] [--warmups N] [--min-time SECONDS] [--spirv FILE]" << std::endl;
+    std::cerr << "  --json FILE         write results as JSON to FILE ('-' for standard output)" << std::endl;
+    std::cerr << "  --filter NAME       only run benchmarks whose name contains NAME" << std::endl;
+    std::cerr << "  --samples N         number of measured samples per benchmark (default: 30)" << std::endl;
+    std::cerr << "  --warmups N         number of discarded samples per benchmark (default: 3)" << std::endl;
+    std::cerr << "  --min-time SECONDS  minimal duration of each sample (default: 0.0005)" << std::endl;
+    std::cerr << "  --spirv FILE        SPIR-V module for the reflection benchmark (default: tests/Shaders/SpirvReflectTest.comp.spv)" << std::endl;
+}
+
+// Parses the command line arguments and returns false if they are invalid.
+static bool ParseArgs(int argc, char* argv[], ToolConfig& config)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc)
+            return false;
+
+        const std::string value = argv[++i];
+        if (arg == "--json")
+            config.jsonFilename = value;
+        else if (arg == "--filter")
+            config.benchmark.filter = value;
+        else if (arg == "--samples")
+            config.benchmark.numSamples = static_cast<std::size_t>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (arg == "--warmups")
+            config.benchmark.numWarmups = static_cast<std::size_t>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (arg == "--min-time")
+            config.benchmark.minSampleTime = std::strtod(value.c_str(), nullptr);
+        else if (arg == "--spirv")
+            config.spirvFilename = value;
+        else
+            return false;
+    }
+    return (config.benchmark.numSamples > 0);
+}
+
+int main(int argc, char* argv[])
+{
+    /* Parse command line arguments */
+    ToolConfig config;
+    if (!ParseArgs(argc, argv, config))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    try
+    {
+        std::cerr << "LLGL " << LLGL::Version::GetString() << std::endl;
+
+        BenchmarkHarness harness { config.benchmark };
+        RunImageBenchmarks(harness);
+        RunCommandBenchmarks(harness);
+        RunParsingBenchmarks(harness, config.spirvFilename);
+
+        /* Print summary to the error stream, so the JSON document can be written to the standard output */
+        harness.WriteSummary(std::cerr);
+
+        if (config.jsonFilename == "-")
+            harness.WriteJSON(std::cout);
+        else if (!config.jsonFilename.empty())
+        {
+            std::ofstream file { config.jsonFilename };
+            if (!file.good())
+                throw std::runtime_error("failed to write file: " + config.jsonFilename);
+            harness.WriteJSON(file);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
@@ -0,0 +1,1074 @@
+/*
+ * LLGLReplay.cpp
+ *
+ * This file is part of the "LLGL" project (Copyright (c) 2015-2019 by Lukas Hermanns)
+ * See "LICENSE.txt" for license information.
+ */
+
+#include <LLGL/LLGL.h>
+#include "../../sources/Renderer/CaptureFormat.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+using namespace LLGL::Serialization;
+
+/*
+Re-executes a capture file that was recorded with LLGL::RenderingDebugger::BeginCapture.
+Usage: LLGLReplay CAPTURE_FILE [MODULE] [--timing]
+*/
+
+struct ReplayConfig
+{
+    std::string filename;
+    std::string moduleName  = "OpenGL";
+    bool        timingOnly  = false;
+};
+
+struct ReplayObject
+{
+    CaptureIdent                kind;
+    LLGL::RenderSystemChild*    object;
+};
+
+class CaptureReplayer
+{
+
+    public:
+
+        CaptureReplayer(const ReplayConfig& config) :
+            config_ { config }
+        {
+        }
+
+        ~CaptureReplayer()
+        {
+            ReleaseAll();
+        }
+
+        // Reads all chunks of the capture file into memory, so file I/O does not distort the timings.
+        void LoadFile()
+        {
+            std::ifstream file { config_.filename, std::ios::in | std::ios::binary };
+            if (!file.good())
+                throw std::runtime_error("failed to open capture file: " + config_.filename);
+
+            CaptureFileHeader header;
+            file.read(reinterpret_cast<char*>(&header), sizeof(header));
+            if (!file.good() || !IsCaptureFileHeaderCompatible(header))
+                throw std::runtime_error("capture file is incompatible with this version of LLGL or platform: " + config_.filename);
+
+            std::uint64_t chunkSize = 0;
+            while (file.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize)))
+            {
+                std::vector<char> chunk(static_cast<std::size_t>(chunkSize));
+                if (!file.read(chunk.data(), static_cast<std::streamsize>(chunkSize)))
+                    throw std::runtime_error("unexpected end of capture file: " + config_.filename);
+                chunks_.push_back(std::move(chunk));
+            }
+        }
+
+        // Replays all chunks and prints the CPU time of each frame. Returns false if the capture contains chunks but no frame was replayed.
+        bool Run()
+        {
+            renderer_       = LLGL::RenderSystem::Load(config_.moduleName);
+            commandQueue_   = renderer_->GetCommandQueue();
+            timer_          = LLGL::Timer::Create();
+
+            std::cout << "replay " << chunks_.size() << " chunk(s) with renderer: " << renderer_->GetName() << std::endl;
+
+            timer_->Start();
+            for (const auto& chunk : chunks_)
+            {
+                Deserializer reader { chunk.data(), chunk.size() };
+                for (auto seg = reader.Begin(); seg.ident != 0; seg = reader.Begin())
+                {
+                    if (!ReplaySegment(reader, static_cast<CaptureIdent>(seg.ident)))
+                        return true;
+                    reader.End();
+                }
+            }
+
+            PrintSummary();
+
+            return (chunks_.empty() || !frameTimes_.empty());
+        }
+
+    private:
+
+        /* ----- Reading ----- */
+
+        template <typename T>
+        T Read(Deserializer& reader)
+        {
+            T value;
+            reader.ReadTyped(value);
+            return value;
+        }
+
+        long ReadFlags(Deserializer& reader)
+        {
+            return static_cast<long>(Read<std::int64_t>(reader));
+        }
+
+        // Reads a data block into the scratch buffer and returns its size.
+        std::size_t ReadData(Deserializer& reader, std::vector<char>& data)
+        {
+            const auto size = static_cast<std::size_t>(Read<std::uint64_t>(reader));
+            data.resize(size);
+            if (size > 0)
+                reader.Read(data.data(), size);
+            return size;
+        }
+
+        void ReadAttributes(Deserializer& reader, std::vector<LLGL::VertexAttribute>& attribs)
+        {
+            attribs.resize(Read<std::uint32_t>(reader));
+            for (auto& attrib : attribs)
+            {
+                const auto src = Read<CaptureVertexAttribute>(reader);
+                attrib.name             = reader.ReadCString();
+                attrib.format           = static_cast<LLGL::Format>(src.format);
+                attrib.location         = src.location;
+                attrib.semanticIndex    = src.semanticIndex;
+                attrib.systemValue      = static_cast<LLGL::SystemValue>(src.systemValue);
+                attrib.slot             = src.slot;
+                attrib.offset           = src.offset;
+                attrib.stride           = src.stride;
+                attrib.instanceDivisor  = src.instanceDivisor;
+            }
+        }
+
+        void ReadAttributes(Deserializer& reader, std::vector<LLGL::FragmentAttribute>& attribs)
+        {
+            attribs.resize(Read<std::uint32_t>(reader));
+            for (auto& attrib : attribs)
+            {
+                const auto src = Read<CaptureVertexAttribute>(reader);
+                attrib.name         = reader.ReadCString();
+                attrib.format       = static_cast<LLGL::Format>(src.format);
+                attrib.location     = src.location;
+                attrib.systemValue  = static_cast<LLGL::SystemValue>(src.systemValue);
+            }
+        }
+
+        /* ----- Objects ----- */
+
+        void Register(CaptureObjectID id, CaptureIdent kind, LLGL::RenderSystemChild* object)
+        {
+            if (id != 0 && object != nullptr)
+                objects_[id] = { kind, object };
+        }
+
+        // Returns the object with the specified ID, or null if the ID is zero or unknown.
+        template <typename T>
+        T* Get(CaptureObjectID id)
+        {
+            if (id != 0)
+            {
+                auto it = objects_.find(id);
+                if (it != objects_.end())
+                    return static_cast<T*>(it->second.object);
+                Warn("reference to unknown object ID " + std::to_string(id));
+            }
+            return nullptr;
+        }
+
+        template <typename T>
+        T* Get(Deserializer& reader)
+        {
+            return Get<T>(Read<CaptureObjectID>(reader));
+        }
+
+        void ReleaseObject(const ReplayObject& entry)
+        {
+            switch (entry.kind)
+            {
+                case CaptureIdent_CreateSwapChain:
+                {
+                    auto swapChain = static_cast<LLGL::SwapChain*>(entry.object);
+
+                    /* Unregister render pass of the swap-chain, which is owned by the swap-chain */
+                    for (auto it = objects_.begin(); it != objects_.end();)
+                    {
+                        if (it->second.object == swapChain->GetRenderPass())
+                            it = objects_.erase(it);
+                        else
+                            ++it;
+                    }
+
+                    renderer_->Release(*swapChain);
+                }
+                break;
+
+                case CaptureIdent_CreateCommandBuffer:
+                    renderer_->Release(*static_cast<LLGL::CommandBuffer*>(entry.object));
+                    break;
+                case CaptureIdent_CreateBuffer:
+                    renderer_->Release(*static_cast<LLGL::Buffer*>(entry.object));
+                    break;
+                case CaptureIdent_CreateBufferArray:
+                    renderer_->Release(*static_cast<LLGL::BufferArray*>(entry.object));
+                    break;
+                case CaptureIdent_CreateTexture:
+                    renderer_->Release(*static_cast<LLGL::Texture*>(entry.object));
+                    break;
+                case CaptureIdent_CreateSampler:
+                    renderer_->Release(*static_cast<LLGL::Sampler*>(entry.object));
+                    break;
+                case CaptureIdent_CreateResourceHeap:
+                    renderer_->Release(*static_cast<LLGL::ResourceHeap*>(entry.object));
+                    break;
+                case CaptureIdent_CreateRenderPass:
+                    renderer_->Release(*static_cast<LLGL::RenderPass*>(entry.object));
+                    break;
+                case CaptureIdent_CreateRenderTarget:
+                    renderer_->Release(*static_cast<LLGL::RenderTarget*>(entry.object));
+                    break;
+                case CaptureIdent_CreateShader:
+                    renderer_->Release(*static_cast<LLGL::Shader*>(entry.object));
+                    break;
+                case CaptureIdent_CreateShaderProgram:
+                    renderer_->Release(*static_cast<LLGL::ShaderProgram*>(entry.object));
+                    break;
+                case CaptureIdent_CreatePipelineLayout:
+                    renderer_->Release(*static_cast<LLGL::PipelineLayout*>(entry.object));
+                    break;
+                case CaptureIdent_CreateGraphicsPipeline:
+                case CaptureIdent_CreateComputePipeline:
+                    renderer_->Release(*static_cast<LLGL::PipelineState*>(entry.object));
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        void Release(CaptureObjectID id)
+        {
+            auto it = objects_.find(id);
+            if (it != objects_.end())
+            {
+                const auto entry = it->second;
+                objects_.erase(it);
+                ReleaseObject(entry);
+            }
+        }
+
+        void ReleaseAll()
+        {
+            /* Release swap-chains last, since other objects might still refer to their render passes */
+            while (!objects_.empty())
+            {
+                auto it = std::find_if(
+                    objects_.begin(), objects_.end(),
+                    [](const std::pair<const CaptureObjectID, ReplayObject>& entry)
+                    {
+                        return (entry.second.kind != CaptureIdent_CreateSwapChain);
+                    }
+                );
+                if (it == objects_.end())
+                    it = objects_.begin();
+                Release(it->first);
+            }
+        }
+
+        /* ----- Replay ----- */
+
+        void Warn(const std::string& msg)
+        {
+            std::cerr << "warning: " << msg << std::endl;
+        }
+
+        // Replays the current segment and returns false if the replay is meant to be stopped.
+        bool ReplaySegment(Deserializer& reader, CaptureIdent ident)
+        {
+            switch (ident)
+            {
+                case CaptureIdent_CreateSwapChain:          ReplayCreateSwapChain(reader);          break;
+                case CaptureIdent_CreateCommandBuffer:      ReplayCreateCommandBuffer(reader);      break;
+                case CaptureIdent_CreateBuffer:             ReplayCreateBuffer(reader);             break;
+                case CaptureIdent_CreateBufferArray:        ReplayCreateBufferArray(reader);        break;
+                case CaptureIdent_CreateTexture:            ReplayCreateTexture(reader);            break;
+                case CaptureIdent_CreateSampler:            ReplayCreateSampler(reader);            break;
+                case CaptureIdent_CreateResourceHeap:       ReplayCreateResourceHeap(reader);       break;
+                case CaptureIdent_CreateRenderPass:         ReplayCreateRenderPass(reader);         break;
+                case CaptureIdent_CreateRenderTarget:       ReplayCreateRenderTarget(reader);       break;
+                case CaptureIdent_CreateShader:             ReplayCreateShader(reader);             break;
+                case CaptureIdent_CreateShaderProgram:      ReplayCreateShaderProgram(reader);      break;
+                case CaptureIdent_CreatePipelineLayout:     ReplayCreatePipelineLayout(reader);     break;
+                case CaptureIdent_CreateGraphicsPipeline:   ReplayCreateGraphicsPipeline(reader);   break;
+                case CaptureIdent_CreateComputePipeline:    ReplayCreateComputePipeline(reader);    break;
+                case CaptureIdent_Release:                  Release(Read<CaptureObjectID>(reader)); break;
+                case CaptureIdent_WriteBuffer:              ReplayWriteBuffer(reader);              break;
+                case CaptureIdent_WriteTexture:             ReplayWriteTexture(reader);             break;
+                case CaptureIdent_Submit:                   ReplaySubmit(reader);                   break;
+                case CaptureIdent_Present:                  return ReplayPresent(reader);
+                default:
+                {
+                    if (auto cmdBuffer = Get<LLGL::CommandBuffer>(reader))
+                        ReplayCommand(reader, ident, *cmdBuffer);
+                    else
+                        Warn("skipped command 0x" + ToHexString(ident) + " of unknown command buffer");
+                }
+                break;
+            }
+            return true;
+        }
+
+        void ReplayCreateSwapChain(Deserializer& reader)
+        {
+            const auto id           = Read<CaptureObjectID>(reader);
+            const auto renderPassID = Read<CaptureObjectID>(reader);
+            auto swapChainDesc      = Read<LLGL::SwapChainDescriptor>(reader);
+
+            auto swapChain = renderer_->CreateSwapChain(swapChainDesc);
+            swapChain->SetVsyncInterval(config_.timingOnly ? 0 : 1);
+
+            auto& window = static_cast<LLGL::Window&>(swapChain->GetSurface());
+            window.SetTitle(L"LLGLReplay ( " + std::wstring(config_.filename.begin(), config_.filename.end()) + L" )");
+            window.Show();
+
+            Register(id, CaptureIdent_CreateSwapChain, swapChain);
+            Register(renderPassID, CaptureIdent_ReservedCapture, const_cast<LLGL::RenderPass*>(swapChain->GetRenderPass()));
+        }
+
+        void ReplayCreateCommandBuffer(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            LLGL::CommandBufferDescriptor cmdBufferDesc;
+            {
+                cmdBufferDesc.flags             = ReadFlags(reader);
+                cmdBufferDesc.numNativeBuffers  = Read<std::uint32_t>(reader);
+            }
+            Register(id, CaptureIdent_CreateCommandBuffer, renderer_->CreateCommandBuffer(cmdBufferDesc));
+        }
+
+        void ReplayCreateBuffer(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            LLGL::BufferDescriptor bufferDesc;
+            {
+                bufferDesc.size             = Read<std::uint64_t>(reader);
+                bufferDesc.stride           = Read<std::uint32_t>(reader);
+                bufferDesc.format           = Read<LLGL::Format>(reader);
+                bufferDesc.bindFlags        = ReadFlags(reader);
+                bufferDesc.cpuAccessFlags   = ReadFlags(reader);
+                bufferDesc.miscFlags        = ReadFlags(reader);
+                ReadAttributes(reader, bufferDesc.vertexAttribs);
+            }
+            const auto dataSize = ReadData(reader, scratch_);
+            Register(id, CaptureIdent_CreateBuffer, renderer_->CreateBuffer(bufferDesc, (dataSize > 0 ? scratch_.data() : nullptr)));
+        }
+
+        void ReplayCreateBufferArray(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            std::vector<LLGL::Buffer*> buffers(Read<std::uint32_t>(reader));
+            for (auto& buffer : buffers)
+            {
+                buffer = Get<LLGL::Buffer>(reader);
+                if (buffer == nullptr)
+                    return Warn("skipped buffer array with unknown buffer");
+            }
+            Register(id, CaptureIdent_CreateBufferArray, renderer_->CreateBufferArray(static_cast<std::uint32_t>(buffers.size()), buffers.data()));
+        }
+
+        void ReplayCreateTexture(Deserializer& reader)
+        {
+            const auto id           = Read<CaptureObjectID>(reader);
+            const auto textureDesc  = Read<LLGL::TextureDescriptor>(reader);
+
+            if (Read<std::uint8_t>(reader) != 0)
+            {
+                LLGL::SrcImageDescriptor imageDesc;
+                {
+                    imageDesc.format    = Read<LLGL::ImageFormat>(reader);
+                    imageDesc.dataType  = Read<LLGL::DataType>(reader);
+                    imageDesc.dataSize  = ReadData(reader, scratch_);
+                    imageDesc.data      = scratch_.data();
+                }
+                Register(id, CaptureIdent_CreateTexture, renderer_->CreateTexture(textureDesc, &imageDesc));
+            }
+            else
+                Register(id, CaptureIdent_CreateTexture, renderer_->CreateTexture(textureDesc));
+        }
+
+        void ReplayCreateSampler(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            Register(id, CaptureIdent_CreateSampler, renderer_->CreateSampler(Read<LLGL::SamplerDescriptor>(reader)));
+        }
+
+        void ReplayCreateResourceHeap(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            LLGL::ResourceHeapDescriptor resourceHeapDesc;
+            {
+                resourceHeapDesc.pipelineLayout = Get<LLGL::PipelineLayout>(reader);
+                resourceHeapDesc.resourceViews.resize(Read<std::uint32_t>(reader));
+                for (auto& resourceView : resourceHeapDesc.resourceViews)
+                {
+                    resourceView.resource       = Get<LLGL::Resource>(reader);
+                    resourceView.textureView    = Read<LLGL::TextureViewDescriptor>(reader);
+                    resourceView.bufferView     = Read<LLGL::BufferViewDescriptor>(reader);
+                    if (resourceView.resource == nullptr)
+                        return Warn("skipped resource heap with unknown resource");
+                }
+            }
+            Register(id, CaptureIdent_CreateResourceHeap, renderer_->CreateResourceHeap(resourceHeapDesc));
+        }
+
+        void ReplayCreateRenderPass(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            LLGL::RenderPassDescriptor renderPassDesc;
+            {
+                renderPassDesc.colorAttachments.resize(Read<std::uint32_t>(reader));
+                for (auto& attachment : renderPassDesc.colorAttachments)
+                    attachment = Read<LLGL::AttachmentFormatDescriptor>(reader);
+                renderPassDesc.depthAttachment      = Read<LLGL::AttachmentFormatDescriptor>(reader);
+                renderPassDesc.stencilAttachment    = Read<LLGL::AttachmentFormatDescriptor>(reader);
+                renderPassDesc.samples              = Read<std::uint32_t>(reader);
+            }
+            Register(id, CaptureIdent_CreateRenderPass, renderer_->CreateRenderPass(renderPassDesc));
+        }
+
+        void ReplayCreateRenderTarget(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            LLGL::RenderTargetDescriptor renderTargetDesc;
+            {
+                renderTargetDesc.renderPass             = Get<LLGL::RenderPass>(reader);
+                renderTargetDesc.resolution             = Read<LLGL::Extent2D>(reader);
+                renderTargetDesc.samples                = Read<std::uint32_t>(reader);
+                renderTargetDesc.customMultiSampling    = Read<bool>(reader);
+                renderTargetDesc.attachments.resize(Read<std::uint32_t>(reader));
+                for (auto& attachment : renderTargetDesc.attachments)
+                {
+                    attachment.type         = Read<LLGL::AttachmentType>(reader);
+                    attachment.texture      = Get<LLGL::Texture>(reader);
+                    attachment.mipLevel     = Read<std::uint32_t>(reader);
+                    attachment.arrayLayer   = Read<std::uint32_t>(reader);
+                }
+            }
+            Register(id, CaptureIdent_CreateRenderTarget, renderer_->CreateRenderTarget(renderTargetDesc));
+        }
+
+        void ReplayCreateShader(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+
+            LLGL::ShaderDescriptor shaderDesc;
+            shaderDesc.type         = Read<LLGL::ShaderType>(reader);
+            shaderDesc.sourceType   = Read<LLGL::ShaderSourceType>(reader);
+            shaderDesc.flags        = ReadFlags(reader);
+
+            /* Append null terminator, since source code strings are passed as C strings */
+            shaderDesc.sourceSize   = ReadData(reader, scratch_);
+            scratch_.push_back('\0');
+            shaderDesc.source       = scratch_.data();
+
+            shaderDesc.entryPoint   = reader.ReadCString();
+            shaderDesc.profile      = reader.ReadCString();
+
+            /* Read macro definitions and terminate them with an empty entry */
+            std::vector<LLGL::ShaderMacro> defines(Read<std::uint32_t>(reader));
+            for (auto& macro : defines)
+            {
+                macro.name          = reader.ReadCString();
+                macro.definition    = reader.ReadCString();
+            }
+            if (!defines.empty())
+            {
+                defines.push_back({});
+                shaderDesc.defines = defines.data();
+            }
+
+            ReadAttributes(reader, shaderDesc.vertex.inputAttribs);
+            ReadAttributes(reader, shaderDesc.vertex.outputAttribs);
+            ReadAttributes(reader, shaderDesc.fragment.outputAttribs);
+            shaderDesc.compute.workGroupSize = Read<LLGL::Extent3D>(reader);
+
+            auto shader = renderer_->CreateShader(shaderDesc);
+            if (shader->HasErrors())
+                Warn("shader " + std::to_string(id) + " has errors:\n" + shader->GetReport());
+
+            Register(id, CaptureIdent_CreateShader, shader);
+        }
+
+        void ReplayCreateShaderProgram(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            LLGL::ShaderProgramDescriptor shaderProgramDesc;
+            {
+                shaderProgramDesc.vertexShader          = Get<LLGL::Shader>(reader);
+                shaderProgramDesc.tessControlShader     = Get<LLGL::Shader>(reader);
+                shaderProgramDesc.tessEvaluationShader  = Get<LLGL::Shader>(reader);
+                shaderProgramDesc.geometryShader        = Get<LLGL::Shader>(reader);
+                shaderProgramDesc.fragmentShader        = Get<LLGL::Shader>(reader);
+                shaderProgramDesc.computeShader         = Get<LLGL::Shader>(reader);
+            }
+            auto shaderProgram = renderer_->CreateShaderProgram(shaderProgramDesc);
+            if (shaderProgram->HasErrors())
+                Warn("shader program " + std::to_string(id) + " has errors:\n" + shaderProgram->GetReport());
+
+            Register(id, CaptureIdent_CreateShaderProgram, shaderProgram);
+        }
+
+        void ReplayCreatePipelineLayout(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            LLGL::PipelineLayoutDescriptor pipelineLayoutDesc;
+            {
+                pipelineLayoutDesc.bindings.resize(Read<std::uint32_t>(reader));
+                for (auto& binding : pipelineLayoutDesc.bindings)
+                {
+                    binding.name        = reader.ReadCString();
+                    binding.type        = Read<LLGL::ResourceType>(reader);
+                    binding.bindFlags   = ReadFlags(reader);
+                    binding.stageFlags  = ReadFlags(reader);
+                    binding.slot        = Read<std::uint32_t>(reader);
+                    binding.arraySize   = Read<std::uint32_t>(reader);
+                }
+            }
+            Register(id, CaptureIdent_CreatePipelineLayout, renderer_->CreatePipelineLayout(pipelineLayoutDesc));
+        }
+
+        void ReplayCreateGraphicsPipeline(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            LLGL::GraphicsPipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.pipelineLayout     = Get<LLGL::PipelineLayout>(reader);
+                pipelineDesc.shaderProgram      = Get<LLGL::ShaderProgram>(reader);
+                pipelineDesc.renderPass         = Get<LLGL::RenderPass>(reader);
+                pipelineDesc.primitiveTopology  = Read<LLGL::PrimitiveTopology>(reader);
+
+                pipelineDesc.viewports.resize(Read<std::uint32_t>(reader));
+                for (auto& viewport : pipelineDesc.viewports)
+                    viewport = Read<LLGL::Viewport>(reader);
+
+                pipelineDesc.scissors.resize(Read<std::uint32_t>(reader));
+                for (auto& scissor : pipelineDesc.scissors)
+                    scissor = Read<LLGL::Scissor>(reader);
+
+                pipelineDesc.depth          = Read<LLGL::DepthDescriptor>(reader);
+                pipelineDesc.stencil        = Read<LLGL::StencilDescriptor>(reader);
+                pipelineDesc.rasterizer     = Read<LLGL::RasterizerDescriptor>(reader);
+                pipelineDesc.blend          = Read<LLGL::BlendDescriptor>(reader);
+                pipelineDesc.tessellation   = Read<LLGL::TessellationDescriptor>(reader);
+            }
+            if (pipelineDesc.shaderProgram == nullptr)
+                return Warn("skipped graphics pipeline " + std::to_string(id) + " with unknown shader program");
+
+            Register(id, CaptureIdent_CreateGraphicsPipeline, renderer_->CreatePipelineState(pipelineDesc));
+        }
+
+        void ReplayCreateComputePipeline(Deserializer& reader)
+        {
+            const auto id = Read<CaptureObjectID>(reader);
+            LLGL::ComputePipelineDescriptor pipelineDesc;
+            {
+                pipelineDesc.pipelineLayout = Get<LLGL::PipelineLayout>(reader);
+                pipelineDesc.shaderProgram  = Get<LLGL::ShaderProgram>(reader);
+            }
+            if (pipelineDesc.shaderProgram == nullptr)
+                return Warn("skipped compute pipeline " + std::to_string(id) + " with unknown shader program");
+
+            Register(id, CaptureIdent_CreateComputePipeline, renderer_->CreatePipelineState(pipelineDesc));
+        }
+
+        void ReplayWriteBuffer(Deserializer& reader)
+        {
+            auto        buffer      = Get<LLGL::Buffer>(reader);
+            const auto  dstOffset   = Read<std::uint64_t>(reader);
+            const auto  dataSize    = ReadData(reader, scratch_);
+            if (buffer != nullptr)
+                renderer_->WriteBuffer(*buffer, dstOffset, scratch_.data(), dataSize);
+        }
+
+        void ReplayWriteTexture(Deserializer& reader)
+        {
+            auto        texture     = Get<LLGL::Texture>(reader);
+            const auto  region      = Read<LLGL::TextureRegion>(reader);
+            LLGL::SrcImageDescriptor imageDesc;
+            {
+                imageDesc.format    = Read<LLGL::ImageFormat>(reader);
+                imageDesc.dataType  = Read<LLGL::DataType>(reader);
+                imageDesc.dataSize  = ReadData(reader, scratch_);
+                imageDesc.data      = scratch_.data();
+            }
+            if (texture != nullptr)
+                renderer_->WriteTexture(*texture, region, imageDesc);
+        }
+
+        void ReplaySubmit(Deserializer& reader)
+        {
+            if (auto cmdBuffer = Get<LLGL::CommandBuffer>(reader))
+                commandQueue_->Submit(*cmdBuffer);
+        }
+
+        bool ReplayPresent(Deserializer& reader)
+        {
+            auto swapChain = Get<LLGL::SwapChain>(reader);
+            if (swapChain == nullptr)
+                return true;
+
+            swapChain->Present();
+
+            /* Measure CPU time of this frame */
+            const auto ticks = timer_->Stop();
+            frameTimes_.push_back(static_cast<double>(ticks) * 1000.0 / static_cast<double>(timer_->GetFrequency()));
+            if (!config_.timingOnly)
+                std::cout << "frame " << frameTimes_.size() << ": " << frameTimes_.back() << " ms" << std::endl;
+
+            /* Process window events after the measurement, so user interaction is not included in the timings */
+            const bool proceed = swapChain->GetSurface().ProcessEvents();
+            timer_->Start();
+            return proceed;
+        }
+
+        void ReplayCommand(Deserializer& reader, CaptureIdent ident, LLGL::CommandBuffer& cmdBuffer)
+        {
+            switch (ident)
+            {
+                case CaptureIdent_Begin:
+                {
+                    cmdBuffer.Begin();
+                }
+                break;
+
+                case CaptureIdent_End:
+                {
+                    cmdBuffer.End();
+                }
+                break;
+
+                case CaptureIdent_Execute:
+                {
+                    if (auto deferredCmdBuffer = Get<LLGL::CommandBuffer>(reader))
+                        cmdBuffer.Execute(*deferredCmdBuffer);
+                }
+                break;
+
+                case CaptureIdent_UpdateBuffer:
+                {
+                    auto        buffer      = Get<LLGL::Buffer>(reader);
+                    const auto  dstOffset   = Read<std::uint64_t>(reader);
+                    const auto  dataSize    = ReadData(reader, scratch_);
+                    if (buffer != nullptr)
+                        cmdBuffer.UpdateBuffer(*buffer, dstOffset, scratch_.data(), static_cast<std::uint16_t>(dataSize));
+                }
+                break;
+
+                case CaptureIdent_CopyBuffer:
+                {
+                    auto        dstBuffer   = Get<LLGL::Buffer>(reader);
+                    const auto  dstOffset   = Read<std::uint64_t>(reader);
+                    auto        srcBuffer   = Get<LLGL::Buffer>(reader);
+                    const auto  srcOffset   = Read<std::uint64_t>(reader);
+                    const auto  size        = Read<std::uint64_t>(reader);
+                    if (dstBuffer != nullptr && srcBuffer != nullptr)
+                        cmdBuffer.CopyBuffer(*dstBuffer, dstOffset, *srcBuffer, srcOffset, size);
+                }
+                break;
+
+                case CaptureIdent_FillBuffer:
+                {
+                    auto        buffer      = Get<LLGL::Buffer>(reader);
+                    const auto  dstOffset   = Read<std::uint64_t>(reader);
+                    const auto  value       = Read<std::uint32_t>(reader);
+                    const auto  fillSize    = Read<std::uint64_t>(reader);
+                    if (buffer != nullptr)
+                        cmdBuffer.FillBuffer(*buffer, dstOffset, value, fillSize);
+                }
+                break;
+
+                case CaptureIdent_CopyTexture:
+                {
+                    auto        dstTexture  = Get<LLGL::Texture>(reader);
+                    const auto  dstLocation = Read<LLGL::TextureLocation>(reader);
+                    auto        srcTexture  = Get<LLGL::Texture>(reader);
+                    const auto  srcLocation = Read<LLGL::TextureLocation>(reader);
+                    const auto  extent      = Read<LLGL::Extent3D>(reader);
+                    if (dstTexture != nullptr && srcTexture != nullptr)
+                        cmdBuffer.CopyTexture(*dstTexture, dstLocation, *srcTexture, srcLocation, extent);
+                }
+                break;
+
+                case CaptureIdent_GenerateMips:
+                {
+                    auto texture = Get<LLGL::Texture>(reader);
+                    if (Read<std::uint8_t>(reader) != 0)
+                    {
+                        const auto subresource = Read<LLGL::TextureSubresource>(reader);
+                        if (texture != nullptr)
+                            cmdBuffer.GenerateMips(*texture, subresource);
+                    }
+                    else if (texture != nullptr)
+                        cmdBuffer.GenerateMips(*texture);
+                }
+                break;
+
+                case CaptureIdent_SetViewports:
+                {
+                    const auto dataSize = ReadData(reader, scratch_);
+                    cmdBuffer.SetViewports(
+                        static_cast<std::uint32_t>(dataSize / sizeof(LLGL::Viewport)),
+                        reinterpret_cast<const LLGL::Viewport*>(scratch_.data())
+                    );
+                }
+                break;
+
+                case CaptureIdent_SetScissors:
+                {
+                    const auto dataSize = ReadData(reader, scratch_);
+                    cmdBuffer.SetScissors(
+                        static_cast<std::uint32_t>(dataSize / sizeof(LLGL::Scissor)),
+                        reinterpret_cast<const LLGL::Scissor*>(scratch_.data())
+                    );
+                }
+                break;
+
+                case CaptureIdent_SetVertexBuffer:
+                {
+                    if (auto buffer = Get<LLGL::Buffer>(reader))
+                        cmdBuffer.SetVertexBuffer(*buffer);
+                }
+                break;
+
+                case CaptureIdent_SetVertexBufferArray:
+                {
+                    if (auto bufferArray = Get<LLGL::BufferArray>(reader))
+                        cmdBuffer.SetVertexBufferArray(*bufferArray);
+                }
+                break;
+
+                case CaptureIdent_SetIndexBuffer:
+                {
+                    auto        buffer  = Get<LLGL::Buffer>(reader);
+                    const auto  format  = Read<LLGL::Format>(reader);
+                    const auto  offset  = Read<std::uint64_t>(reader);
+                    if (buffer != nullptr)
+                    {
+                        if (format == LLGL::Format::Undefined)
+                            cmdBuffer.SetIndexBuffer(*buffer);
+                        else
+                            cmdBuffer.SetIndexBuffer(*buffer, format, offset);
+                    }
+                }
+                break;
+
+                case CaptureIdent_SetResourceHeap:
+                {
+                    auto        resourceHeap    = Get<LLGL::ResourceHeap>(reader);
+                    const auto  firstSet        = Read<std::uint32_t>(reader);
+                    const auto  bindPoint       = Read<LLGL::PipelineBindPoint>(reader);
+                    if (resourceHeap != nullptr)
+                        cmdBuffer.SetResourceHeap(*resourceHeap, firstSet, bindPoint);
+                }
+                break;
+
+                case CaptureIdent_SetResource:
+                {
+                    auto        resource    = Get<LLGL::Resource>(reader);
+                    const auto  slot        = Read<std::uint32_t>(reader);
+                    const auto  bindFlags   = ReadFlags(reader);
+                    const auto  stageFlags  = ReadFlags(reader);
+                    if (resource != nullptr)
+                        cmdBuffer.SetResource(*resource, slot, bindFlags, stageFlags);
+                }
+                break;
+
+                case CaptureIdent_ResetResourceSlots:
+                {
+                    const auto  resourceType    = Read<LLGL::ResourceType>(reader);
+                    const auto  firstSlot       = Read<std::uint32_t>(reader);
+                    const auto  numSlots        = Read<std::uint32_t>(reader);
+                    const auto  bindFlags       = ReadFlags(reader);
+                    const auto  stageFlags      = ReadFlags(reader);
+                    cmdBuffer.ResetResourceSlots(resourceType, firstSlot, numSlots, bindFlags, stageFlags);
+                }
+                break;
+
+                case CaptureIdent_BeginRenderPass:
+                {
+                    auto        renderTarget    = Get<LLGL::RenderTarget>(reader);
+                    auto        renderPass      = Get<LLGL::RenderPass>(reader);
+                    const auto  dataSize        = ReadData(reader, scratch_);
+                    if (renderTarget != nullptr)
+                    {
+                        cmdBuffer.BeginRenderPass(
+                            *renderTarget,
+                            renderPass,
+                            static_cast<std::uint32_t>(dataSize / sizeof(LLGL::ClearValue)),
+                            reinterpret_cast<const LLGL::ClearValue*>(scratch_.data())
+                        );
+                    }
+                }
+                break;
+
+                case CaptureIdent_EndRenderPass:
+                {
+                    cmdBuffer.EndRenderPass();
+                }
+                break;
+
+                case CaptureIdent_Clear:
+                {
+                    const auto flags        = ReadFlags(reader);
+                    const auto clearValue   = Read<LLGL::ClearValue>(reader);
+                    cmdBuffer.Clear(flags, clearValue);
+                }
+                break;
+
+                case CaptureIdent_ClearAttachments:
+                {
+                    const auto dataSize = ReadData(reader, scratch_);
+                    cmdBuffer.ClearAttachments(
+                        static_cast<std::uint32_t>(dataSize / sizeof(LLGL::AttachmentClear)),
+                        reinterpret_cast<const LLGL::AttachmentClear*>(scratch_.data())
+                    );
+                }
+                break;
+
+                case CaptureIdent_SetPipelineState:
+                {
+                    if (auto pipelineState = Get<LLGL::PipelineState>(reader))
+                        cmdBuffer.SetPipelineState(*pipelineState);
+                }
+                break;
+
+                case CaptureIdent_SetBlendFactor:
+                {
+                    cmdBuffer.SetBlendFactor(Read<LLGL::ColorRGBAf>(reader));
+                }
+                break;
+
+                case CaptureIdent_SetStencilReference:
+                {
+                    const auto reference    = Read<std::uint32_t>(reader);
+                    const auto stencilFace  = Read<LLGL::StencilFace>(reader);
+                    cmdBuffer.SetStencilReference(reference, stencilFace);
+                }
+                break;
+
+                case CaptureIdent_SetUniforms:
+                {
+                    const auto location = Read<LLGL::UniformLocation>(reader);
+                    const auto count    = Read<std::uint32_t>(reader);
+                    const auto dataSize = ReadData(reader, scratch_);
+                    cmdBuffer.SetUniforms(location, count, scratch_.data(), static_cast<std::uint32_t>(dataSize));
+                }
+                break;
+
+                case CaptureIdent_Draw:
+                {
+                    const auto numVertices      = Read<std::uint32_t>(reader);
+                    const auto firstVertex      = Read<std::uint32_t>(reader);
+                    const auto numInstances     = Read<std::uint32_t>(reader);
+                    const auto firstInstance    = Read<std::uint32_t>(reader);
+
+                    /* Select the same overload the application used, since backends might implement them differently */
+                    if (firstInstance != 0)
+                        cmdBuffer.DrawInstanced(numVertices, firstVertex, numInstances, firstInstance);
+                    else if (numInstances != 1)
+                        cmdBuffer.DrawInstanced(numVertices, firstVertex, numInstances);
+                    else
+                        cmdBuffer.Draw(numVertices, firstVertex);
+                }
+                break;
+
+                case CaptureIdent_DrawIndexed:
+                {
+                    const auto numIndices       = Read<std::uint32_t>(reader);
+                    const auto firstIndex       = Read<std::uint32_t>(reader);
+                    const auto vertexOffset     = Read<std::int32_t>(reader);
+                    const auto numInstances     = Read<std::uint32_t>(reader);
+                    const auto firstInstance    = Read<std::uint32_t>(reader);
+
+                    if (firstInstance != 0)
+                        cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset, firstInstance);
+                    else if (numInstances != 1)
+                        cmdBuffer.DrawIndexedInstanced(numIndices, numInstances, firstIndex, vertexOffset);
+                    else if (vertexOffset != 0)
+                        cmdBuffer.DrawIndexed(numIndices, firstIndex, vertexOffset);
+                    else
+                        cmdBuffer.DrawIndexed(numIndices, firstIndex);
+                }
+                break;
+
+                case CaptureIdent_DrawIndirect:
+                case CaptureIdent_DrawIndexedIndirect:
+                {
+                    auto        buffer      = Get<LLGL::Buffer>(reader);
+                    const auto  offset      = Read<std::uint64_t>(reader);
+                    const auto  numCommands = Read<std::uint32_t>(reader);
+                    const auto  stride      = Read<std::uint32_t>(reader);
+                    if (buffer != nullptr)
+                    {
+                        const bool singleCommand = (numCommands == 1 && stride == 0);
+                        if (ident == CaptureIdent_DrawIndirect)
+                        {
+                            if (singleCommand)
+                                cmdBuffer.DrawIndirect(*buffer, offset);
+                            else
+                                cmdBuffer.DrawIndirect(*buffer, offset, numCommands, stride);
+                        }
+                        else
+                        {
+                            if (singleCommand)
+                                cmdBuffer.DrawIndexedIndirect(*buffer, offset);
+                            else
+                                cmdBuffer.DrawIndexedIndirect(*buffer, offset, numCommands, stride);
+                        }
+                    }
+                }
+                break;
+
+                case CaptureIdent_Dispatch:
+                {
+                    const auto numWorkGroupsX = Read<std::uint32_t>(reader);
+                    const auto numWorkGroupsY = Read<std::uint32_t>(reader);
+                    const auto numWorkGroupsZ = Read<std::uint32_t>(reader);
+                    cmdBuffer.Dispatch(numWorkGroupsX, numWorkGroupsY, numWorkGroupsZ);
+                }
+                break;
+
+                case CaptureIdent_DispatchIndirect:
+                {
+                    auto        buffer = Get<LLGL::Buffer>(reader);
+                    const auto  offset = Read<std::uint64_t>(reader);
+                    if (buffer != nullptr)
+                        cmdBuffer.DispatchIndirect(*buffer, offset);
+                }
+                break;
+
+                case CaptureIdent_PushDebugGroup:
+                {
+                    cmdBuffer.PushDebugGroup(reader.ReadCString());
+                }
+                break;
+
+                case CaptureIdent_PopDebugGroup:
+                {
+                    cmdBuffer.PopDebugGroup();
+                }
+                break;
+
+                default:
+                {
+                    Warn("skipped unknown segment 0x" + ToHexString(ident));
+                }
+                break;
+            }
+        }
+
+        /* ----- Output ----- */
+
+        static std::string ToHexString(std::uint32_t value)
+        {
+            static const char* digits = "0123456789ABCDEF";
+            std::string s(8, '0');
+            for (int i = 7; i >= 0; --i, value >>= 4)
+                s[i] = digits[value & 0xF];
+            return s;
+        }
+
+        void PrintSummary()
+        {
+            if (frameTimes_.empty())
+            {
+                std::cout << "no frames replayed" << std::endl;
+                return;
+            }
+
+            /* Ignore the first frame for the statistics if there are more, since it commonly contains all resource creations */
+            auto first = frameTimes_.begin();
+            if (frameTimes_.size() > 1)
+                ++first;
+
+            double sum = 0.0;
+            for (auto it = first; it != frameTimes_.end(); ++it)
+                sum += *it;
+
+            const auto minmax = std::minmax_element(first, frameTimes_.end());
+
+            std::cout << "replayed " << frameTimes_.size() << " frame(s); first frame: " << frameTimes_.front() << " ms" << std::endl;
+            std::cout << "CPU time per frame: avg = " << (sum / static_cast<double>(std::distance(first, frameTimes_.end())))
+                      << " ms, min = " << *minmax.first << " ms, max = " << *minmax.second << " ms" << std::endl;
+        }
+
+    private:
+
+        ReplayConfig                                        config_;
+        std::vector<std::vector<char>>                      chunks_;
+
+        std::unique_ptr<LLGL::RenderSystem>                 renderer_;
+        LLGL::CommandQueue*                                 commandQueue_   = nullptr;
+        std::unordered_map<CaptureObjectID, ReplayObject>   objects_;
+        std::vector<char>                                   scratch_;
+
+        std::unique_ptr<LLGL::Timer>                        timer_;
+        std::vector<double>                                 frameTimes_;
+
+};
+
+int main(int argc, char* argv[])
+{
+    /* Parse command line arguments */
+    ReplayConfig config;
+    bool hasModule = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--timing")
+            config.timingOnly = true;
+        else if (config.filename.empty())
+            config.filename = arg;
+        else if (!hasModule)
+        {
+            config.moduleName   = arg;
+            hasModule           = true;
+        }
+    }
+
+    if (config.filename.empty())
+    {
+        std::cerr << "usage: LLGLReplay CAPTURE_FILE [MODULE] [--timing]" << std::endl;
+        std::cerr << "  CAPTURE_FILE    capture file recorded with LLGL::RenderingDebugger::BeginCapture" << std::endl;
+        std::cerr << "  MODULE          render system module to replay with (default: OpenGL)" << std::endl;
+        std::cerr << "  --timing        disable V-sync and only print the timing summary" << std::endl;
+        return 1;
+    }
+
+    try
+    {
+        CaptureReplayer replayer { config };
+        replayer.LoadFile();
+        if (!replayer.Run())
+        {
+            std::cerr << "capture contains no replayable frame: " << config.filename << std::endl;
+            return 1;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+
+
+// ================================================================================
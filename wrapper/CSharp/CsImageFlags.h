@@ -44,6 +44,7 @@ public enum class ImageFormat
     BC3,
     BC4,
     BC5,
+    BC7,
 };
 
 